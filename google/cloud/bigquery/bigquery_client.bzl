@@ -20,7 +20,9 @@ bigquery_client_hdrs = [
     "client.h",
     "connection.h",
     "connection_options.h",
+    "internal/avro_batch_decoder.h",
     "internal/connection_impl.h",
+    "internal/parallel_read_result_source.h",
     "internal/storage_stub.h",
     "internal/stream_reader.h",
     "internal/streaming_read_result_source.h",
@@ -35,7 +37,9 @@ bigquery_client_hdrs = [
 bigquery_client_srcs = [
     "client.cc",
     "connection_options.cc",
+    "internal/avro_batch_decoder.cc",
     "internal/connection_impl.cc",
+    "internal/parallel_read_result_source.cc",
     "internal/storage_stub.cc",
     "internal/streaming_read_result_source.cc",
     "read_stream.cc",
@@ -17,5 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 bigquery_client_unit_tests = [
+    "internal/avro_batch_decoder_test.cc",
     "internal/connection_impl_test.cc",
+    "internal/parallel_read_result_source_test.cc",
 ]
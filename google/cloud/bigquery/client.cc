@@ -37,10 +37,14 @@ ReadResult Client::Read(ReadStream const& read_stream) {
   return conn_->Read(read_stream);
 }
 
+ReadResult Client::Read(std::vector<ReadStream> const& read_streams) {
+  return conn_->Read(read_streams);
+}
+
 StatusOr<std::vector<ReadStream>> Client::ParallelRead(
     std::string const& parent_project_id, std::string const& table,
-    std::vector<std::string> const& columns) {
-  return conn_->ParallelRead(parent_project_id, table, columns);
+    std::vector<std::string> const& columns, DataFormat format) {
+  return conn_->ParallelRead(parent_project_id, table, columns, format);
 }
 
 std::shared_ptr<Connection> MakeConnection(ConnectionOptions const& options) {
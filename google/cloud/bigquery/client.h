@@ -62,6 +62,17 @@ class Client {
   // `ParallelRead()` for more information.
   ReadResult Read(ReadStream const& read_stream);
 
+  // Performs a single merged read over several `ReadStream`s returned by
+  // `bigquery::Client::ParallelRead()`.
+  //
+  // The streams are read concurrently, one reader per stream, and their
+  // rows are delivered through the returned `ReadResult` in no particular
+  // order. Slow streams may be split on the server while the read is in
+  // progress to keep all readers busy. To bound the parallelism (and the
+  // number of connections), pass a subset of the streams and read the rest
+  // in another call or another process.
+  ReadResult Read(std::vector<ReadStream> const& read_streams);
+
   // Creates one or more `ReadStream`s that can be used to read data from a
   // table in parallel.
   //
@@ -72,9 +83,13 @@ class Client {
   // guaranteed to produce the same distribution or order of rows.
   //
   // After 24 hours, all `ReadStreams` created will stop working.
+  //
+  // @p format selects the wire format of the row blocks; see `DataFormat`
+  // for the trade-offs.
   StatusOr<std::vector<ReadStream>> ParallelRead(
       std::string const& parent_project_id, std::string const& table,
-      std::vector<std::string> const& columns = {});
+      std::vector<std::string> const& columns = {},
+      DataFormat format = DataFormat::kAvro);
 
  private:
   std::shared_ptr<Connection> conn_;
@@ -26,15 +26,31 @@ namespace google {
 namespace cloud {
 namespace bigquery {
 inline namespace BIGQUERY_CLIENT_NS {
+// The wire format for the row blocks of a read session.
+//
+// `kAvro` delivers Avro binary row blocks, which the client can decode
+// into columnar buffers (see `internal::DecodeAvroRows()`). `kArrow`
+// asks the server for Arrow record batches, which are already columnar
+// and need no row-by-row decode on the client.
+enum class DataFormat {
+  kAvro,
+  kArrow,
+};
+
 class Connection {
  public:
   virtual ~Connection() = default;
 
   virtual ReadResult Read(ReadStream const& read_stream) = 0;
 
+  // Reads all of @p read_streams concurrently, merging their rows into a
+  // single `ReadResult`.
+  virtual ReadResult Read(std::vector<ReadStream> const& read_streams) = 0;
+
   virtual StatusOr<std::vector<ReadStream>> ParallelRead(
       std::string const& parent_project_id, std::string const& table,
-      std::vector<std::string> const& columns) = 0;
+      std::vector<std::string> const& columns,
+      DataFormat format = DataFormat::kAvro) = 0;
 };
 
 }  // namespace BIGQUERY_CLIENT_NS
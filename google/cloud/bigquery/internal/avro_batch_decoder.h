@@ -0,0 +1,93 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_AVRO_BATCH_DECODER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_AVRO_BATCH_DECODER_H
+
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace internal {
+
+// The Avro primitive types produced by the BigQuery Storage API for flat
+// table reads. Complex types (records, unions, arrays) are not decoded,
+// consumers that need them should request the Arrow format instead.
+enum class AvroType {
+  kBoolean,
+  kInt,
+  kLong,
+  kFloat,
+  kDouble,
+  kString,
+  kBytes,
+};
+
+// One column of a decoded batch. A batch decodes into one contiguous
+// buffer per column, not one object per cell: downstream aggregation and
+// export pipelines consume whole columns, and a columnar layout decodes
+// into cache-friendly sequential appends.
+struct Column {
+  std::string name;
+  AvroType type;
+
+  // The values for `kBoolean`, `kInt`, and `kLong` columns.
+  std::vector<std::int64_t> int64_values;
+  // The values for `kFloat` and `kDouble` columns.
+  std::vector<double> double_values;
+  // The values for `kString` and `kBytes` columns: all cells concatenated
+  // in `data`, with `offsets[i]` and `offsets[i + 1]` delimiting cell `i`.
+  // `offsets` has one more element than the batch has rows.
+  std::string data;
+  std::vector<std::size_t> offsets;
+};
+
+// A decoded batch of rows in columnar form.
+struct ColumnarBatch {
+  std::int64_t row_count = 0;
+  std::vector<Column> columns;
+};
+
+// The name and type of each field of the rows to decode, in Avro schema
+// order. This is the (tiny) subset of the session's Avro schema the
+// decoder needs; parsing the full JSON schema is left to the caller.
+struct AvroFieldSchema {
+  std::string name;
+  AvroType type;
+};
+
+// Decodes a block of Avro binary-encoded rows into columnar buffers.
+//
+// @p serialized_binary_rows is the `AvroRows.serialized_binary_rows`
+// payload of a `ReadRowsResponse`: @p row_count rows, each a sequence of
+// the fields described by @p schema in Avro binary encoding. Returns
+// `kInvalidArgument` if the payload is truncated, malformed, or has
+// trailing bytes.
+StatusOr<ColumnarBatch> DecodeAvroRows(
+    std::string const& serialized_binary_rows, std::int64_t row_count,
+    std::vector<AvroFieldSchema> const& schema);
+
+}  // namespace internal
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_AVRO_BATCH_DECODER_H
@@ -0,0 +1,174 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/internal/avro_batch_decoder.h"
+#include <gmock/gmock.h>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Appends the Avro zigzag varint encoding of @p value to @p out.
+void AppendVarint(std::string* out, std::int64_t value) {
+  auto v = (static_cast<std::uint64_t>(value) << 1) ^
+           static_cast<std::uint64_t>(value >> 63);
+  do {
+    auto byte = static_cast<unsigned char>(v & 0x7f);
+    v >>= 7;
+    if (v != 0) byte |= 0x80;
+    out->push_back(static_cast<char>(byte));
+  } while (v != 0);
+}
+
+void AppendDouble(std::string* out, double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, 8);
+  for (int i = 0; i != 8; ++i) {
+    out->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+void AppendFloat(std::string* out, float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, 4);
+  for (int i = 0; i != 4; ++i) {
+    out->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+  }
+}
+
+void AppendString(std::string* out, std::string const& value) {
+  AppendVarint(out, static_cast<std::int64_t>(value.size()));
+  out->append(value);
+}
+
+TEST(AvroBatchDecoderTest, DecodesMultipleColumns) {
+  std::vector<AvroFieldSchema> schema = {{"id", AvroType::kLong},
+                                         {"name", AvroType::kString},
+                                         {"score", AvroType::kDouble},
+                                         {"active", AvroType::kBoolean}};
+  std::string payload;
+  // Row 0.
+  AppendVarint(&payload, 42);
+  AppendString(&payload, "alice");
+  AppendDouble(&payload, 1.5);
+  payload.push_back(1);
+  // Row 1.
+  AppendVarint(&payload, -7);
+  AppendString(&payload, "");
+  AppendDouble(&payload, -2.25);
+  payload.push_back(0);
+
+  auto batch = DecodeAvroRows(payload, 2, schema);
+  ASSERT_TRUE(batch.ok()) << batch.status();
+  EXPECT_EQ(2, batch->row_count);
+  ASSERT_EQ(4U, batch->columns.size());
+
+  EXPECT_EQ("id", batch->columns[0].name);
+  EXPECT_THAT(batch->columns[0].int64_values, ElementsAre(42, -7));
+
+  EXPECT_EQ("name", batch->columns[1].name);
+  EXPECT_EQ("alice", batch->columns[1].data);
+  EXPECT_THAT(batch->columns[1].offsets, ElementsAre(0U, 5U, 5U));
+
+  EXPECT_EQ("score", batch->columns[2].name);
+  EXPECT_THAT(batch->columns[2].double_values, ElementsAre(1.5, -2.25));
+
+  EXPECT_EQ("active", batch->columns[3].name);
+  EXPECT_THAT(batch->columns[3].int64_values, ElementsAre(1, 0));
+}
+
+TEST(AvroBatchDecoderTest, DecodesFloatAndInt) {
+  std::vector<AvroFieldSchema> schema = {{"f", AvroType::kFloat},
+                                         {"i", AvroType::kInt}};
+  std::string payload;
+  AppendFloat(&payload, 0.5F);
+  AppendVarint(&payload, 123456);
+
+  auto batch = DecodeAvroRows(payload, 1, schema);
+  ASSERT_TRUE(batch.ok()) << batch.status();
+  EXPECT_THAT(batch->columns[0].double_values, ElementsAre(0.5));
+  EXPECT_THAT(batch->columns[1].int64_values, ElementsAre(123456));
+}
+
+TEST(AvroBatchDecoderTest, DecodesLargeVarints) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kLong}};
+  std::string payload;
+  auto const big = std::int64_t{1} << 62;
+  AppendVarint(&payload, big);
+  AppendVarint(&payload, -big);
+
+  auto batch = DecodeAvroRows(payload, 2, schema);
+  ASSERT_TRUE(batch.ok()) << batch.status();
+  EXPECT_THAT(batch->columns[0].int64_values, ElementsAre(big, -big));
+}
+
+TEST(AvroBatchDecoderTest, DecodesEmptyBatch) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kLong}};
+  auto batch = DecodeAvroRows("", 0, schema);
+  ASSERT_TRUE(batch.ok()) << batch.status();
+  EXPECT_EQ(0, batch->row_count);
+  EXPECT_TRUE(batch->columns[0].int64_values.empty());
+}
+
+TEST(AvroBatchDecoderTest, RejectsTruncatedVarint) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kLong}};
+  std::string payload = "\x80";  // continuation bit set, no next byte
+  auto batch = DecodeAvroRows(payload, 1, schema);
+  EXPECT_EQ(StatusCode::kInvalidArgument, batch.status().code());
+}
+
+TEST(AvroBatchDecoderTest, RejectsTruncatedString) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kString}};
+  std::string payload;
+  AppendVarint(&payload, 100);  // length 100, but no bytes follow
+  auto batch = DecodeAvroRows(payload, 1, schema);
+  EXPECT_EQ(StatusCode::kInvalidArgument, batch.status().code());
+}
+
+TEST(AvroBatchDecoderTest, RejectsBadBoolean) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kBoolean}};
+  std::string payload = "\x02";
+  auto batch = DecodeAvroRows(payload, 1, schema);
+  EXPECT_EQ(StatusCode::kInvalidArgument, batch.status().code());
+}
+
+TEST(AvroBatchDecoderTest, RejectsTrailingBytes) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kLong}};
+  std::string payload;
+  AppendVarint(&payload, 1);
+  payload.push_back(0);  // one byte past the last row
+  auto batch = DecodeAvroRows(payload, 1, schema);
+  EXPECT_EQ(StatusCode::kInvalidArgument, batch.status().code());
+}
+
+TEST(AvroBatchDecoderTest, RejectsOverlongVarint) {
+  std::vector<AvroFieldSchema> schema = {{"v", AvroType::kLong}};
+  std::string payload(10, '\x80');
+  payload.push_back('\x01');
+  auto batch = DecodeAvroRows(payload, 1, schema);
+  EXPECT_EQ(StatusCode::kInvalidArgument, batch.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
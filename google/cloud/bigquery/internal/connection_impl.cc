@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigquery/internal/connection_impl.h"
+#include "google/cloud/bigquery/internal/parallel_read_result_source.h"
 #include "google/cloud/bigquery/internal/storage_stub.h"
 #include "google/cloud/bigquery/internal/streaming_read_result_source.h"
 #include "google/cloud/bigquery/version.h"
@@ -66,13 +67,19 @@ ReadResult ConnectionImpl::Read(ReadStream const& read_stream) {
   return ReadResult(std::move(source));
 }
 
+ReadResult ConnectionImpl::Read(std::vector<ReadStream> const& read_streams) {
+  auto source = std::unique_ptr<ParallelReadResultSource>(
+      new ParallelReadResultSource(read_stub_, read_streams));
+  return ReadResult(std::move(source));
+}
+
 // TODO(aryann) - convert all TODO entries to use GitHub issues.
 // TODO(aryann) - follow Google Style Guide wrt to default arguments and virtual
 //     functions.
 StatusOr<std::vector<ReadStream>> ConnectionImpl::ParallelRead(
     std::string const& parent_project_id, std::string const& table,
-    std::vector<std::string> const& columns) {
-  auto response = NewReadSession(parent_project_id, table, columns);
+    std::vector<std::string> const& columns, DataFormat format) {
+  auto response = NewReadSession(parent_project_id, table, columns, format);
   if (!response.ok()) {
     return response.status();
   }
@@ -87,7 +94,7 @@ StatusOr<std::vector<ReadStream>> ConnectionImpl::ParallelRead(
 
 StatusOr<bigquerystorage_proto::ReadSession> ConnectionImpl::NewReadSession(
     std::string const& parent_project_id, std::string const& table,
-    std::vector<std::string> const& columns) {
+    std::vector<std::string> const& columns, DataFormat format) {
   auto parts = StrSplit<':'>(table);
   if (parts.size() != 2) {
     return Status(
@@ -112,6 +119,9 @@ StatusOr<bigquerystorage_proto::ReadSession> ConnectionImpl::NewReadSession(
   for (std::string const& column : columns) {
     request.mutable_read_options()->add_selected_fields(column);
   }
+  request.set_format(format == DataFormat::kArrow
+                         ? bigquerystorage_proto::ARROW
+                         : bigquerystorage_proto::AVRO);
 
   return read_stub_->CreateReadSession(request);
 }
@@ -35,9 +35,12 @@ class ConnectionImpl : public Connection {
  public:
   ReadResult Read(ReadStream const& read_stream) override;
 
+  ReadResult Read(std::vector<ReadStream> const& read_streams) override;
+
   StatusOr<std::vector<ReadStream>> ParallelRead(
       std::string const& parent_project_id, std::string const& table,
-      std::vector<std::string> const& columns) override;
+      std::vector<std::string> const& columns,
+      DataFormat format = DataFormat::kAvro) override;
 
  private:
   friend std::shared_ptr<ConnectionImpl> MakeConnection(
@@ -47,7 +50,7 @@ class ConnectionImpl : public Connection {
   google::cloud::StatusOr<
       google::cloud::bigquery::storage::v1beta1::ReadSession>
   NewReadSession(std::string const& parent_project_id, std::string const& table,
-                 std::vector<std::string> const& columns = {});
+                 std::vector<std::string> const& columns, DataFormat format);
 
   std::shared_ptr<StorageStub> read_stub_;
 };
@@ -98,6 +98,8 @@ TEST(ConnectionImplTest, ParallelReadRpcSuccess) {
             EXPECT_THAT(request.read_options().selected_fields(0), Eq("col-0"));
             EXPECT_THAT(request.read_options().selected_fields(1), Eq("col-1"));
 
+            EXPECT_THAT(request.format(), Eq(bigquerystorage_proto::AVRO));
+
             bigquerystorage_proto::ReadSession response;
             std::string const text = R"pb(
               name: "my-session"
@@ -118,6 +120,28 @@ TEST(ConnectionImplTest, ParallelReadRpcSuccess) {
                                           MakeReadStream("stream-2")));
 }
 
+TEST(ConnectionImplTest, ParallelReadArrowFormat) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  auto conn = MakeConnection(mock);
+  EXPECT_CALL(*mock, CreateReadSession(_))
+      .WillOnce(
+          [](bigquerystorage_proto::CreateReadSessionRequest const& request)
+              -> StatusOr<bigquerystorage_proto::ReadSession> {
+            EXPECT_THAT(request.format(), Eq(bigquerystorage_proto::ARROW));
+
+            bigquerystorage_proto::ReadSession response;
+            response.set_name("my-session");
+            response.add_streams()->set_name("stream-0");
+            return response;
+          });
+
+  StatusOr<std::vector<ReadStream>> result =
+      conn->ParallelRead("my-parent-project", "my-project:my-dataset.my-table",
+                         {}, DataFormat::kArrow);
+  EXPECT_THAT(result.ok(), IsTrue());
+  EXPECT_THAT(result.value(), ElementsAre(MakeReadStream("stream-0")));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace BIGQUERY_CLIENT_NS
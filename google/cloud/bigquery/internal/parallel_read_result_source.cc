@@ -0,0 +1,187 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/internal/parallel_read_result_source.h"
+#include "google/cloud/bigquery/row.h"
+#include "google/cloud/bigquery/version.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace internal {
+
+namespace bigquerystorage_proto = ::google::cloud::bigquery::storage::v1beta1;
+
+namespace {
+// Do not bother splitting a straggler with less than this fraction of its
+// data left, the split RPC and new stream setup would cost more than they
+// save.
+double constexpr kMinRemainderToSplit = 0.25;
+}  // namespace
+
+std::size_t constexpr ParallelReadResultSource::kNoStream;
+
+ParallelReadResultSource::ParallelReadResultSource(
+    std::shared_ptr<StorageStub> stub, std::vector<ReadStream> const& streams)
+    : stub_(std::move(stub)),
+      // A couple of buffered responses per stream is enough to decouple the
+      // readers from the consumer; more would just use memory.
+      queue_(2 * (std::max)(streams.size(), std::size_t(1))),
+      active_workers_(streams.size()) {
+  states_.reserve(streams.size());
+  for (auto const& stream : streams) {
+    StreamState state;
+    state.name = stream.stream_name();
+    states_.push_back(std::move(state));
+  }
+  workers_.reserve(states_.size());
+  for (std::size_t i = 0; i != states_.size(); ++i) {
+    workers_.emplace_back([this, i] { ReaderLoop(i); });
+  }
+  if (workers_.empty()) queue_.Shutdown();
+}
+
+ParallelReadResultSource::~ParallelReadResultSource() {
+  shutdown_.store(true);
+  // Unblocks readers waiting to push and makes pending `Push()` calls
+  // drop their argument.
+  queue_.Shutdown();
+  for (auto& worker : workers_) worker.join();
+}
+
+void ParallelReadResultSource::ReaderLoop(std::size_t index) {
+  while (index != kNoStream && !shutdown_.load()) {
+    if (!ReadStreamAt(index)) break;
+    MarkFinished(index);
+    index = NextStream();
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  if (--active_workers_ == 0) {
+    lk.unlock();
+    // The last reader to finish wakes up the consumer.
+    queue_.Shutdown();
+  }
+}
+
+bool ParallelReadResultSource::ReadStreamAt(std::size_t index) {
+  bigquerystorage_proto::ReadRowsRequest request;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    request.mutable_read_position()->mutable_stream()->set_name(
+        states_[index].name);
+  }
+  auto reader = stub_->ReadRows(request);
+  while (!shutdown_.load()) {
+    auto next = reader->NextValue();
+    if (!next.ok()) {
+      StatusOr<Chunk> error(next.status());
+      queue_.Push(std::move(error));
+      MarkFinished(index);
+      return false;
+    }
+    if (!next.value()) return true;  // end of stream
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      states_[index].fraction =
+          next.value()->status().progress().at_response_end();
+    }
+    Chunk chunk;
+    chunk.stream_index = index;
+    chunk.response = *std::move(next.value());
+    queue_.Push(StatusOr<Chunk>(std::move(chunk)));
+  }
+  return true;
+}
+
+void ParallelReadResultSource::MarkFinished(std::size_t index) {
+  std::lock_guard<std::mutex> lk(mu_);
+  states_[index].fraction = 1.0;
+  states_[index].active = false;
+}
+
+std::size_t ParallelReadResultSource::NextStream() {
+  std::unique_lock<std::mutex> lk(mu_);
+  // At most one split at a time; a second idle reader will find work (or
+  // not) once the pool of streams reflects the first split.
+  if (splitting_ || shutdown_.load()) return kNoStream;
+
+  // The straggler is the active stream with the most data left.
+  auto best = states_.end();
+  for (auto it = states_.begin(); it != states_.end(); ++it) {
+    if (!it->active) continue;
+    if (best == states_.end() || it->fraction < best->fraction) best = it;
+  }
+  if (best == states_.end()) return kNoStream;
+  if (1.0 - best->fraction < kMinRemainderToSplit) return kNoStream;
+
+  // Split off the back half of the straggler's remaining data. The
+  // straggler's reader is unaffected, its stream just ends earlier.
+  bigquerystorage_proto::SplitReadStreamRequest request;
+  request.mutable_original_stream()->set_name(best->name);
+  request.set_fraction(
+      static_cast<float>(best->fraction + (1.0 - best->fraction) / 2));
+
+  splitting_ = true;
+  lk.unlock();
+  auto response = stub_->SplitReadStream(request);
+  lk.lock();
+  splitting_ = false;
+
+  // Splitting is best effort, a reader that cannot get more work exits.
+  if (!response.ok()) return kNoStream;
+
+  StreamState state;
+  state.name = response->remainder_stream().name();
+  states_.push_back(std::move(state));
+  return states_.size() - 1;
+}
+
+double ParallelReadResultSource::FractionConsumed() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (states_.empty()) return 1.0;
+  double total = 0;
+  for (auto const& state : states_) total += state.fraction;
+  return total / static_cast<double>(states_.size());
+}
+
+StatusOr<absl::optional<Row>> ParallelReadResultSource::NextRow() {
+  if (!error_.ok()) return error_;
+  while (!curr_ || offset_in_curr_response_ == curr_->response.row_count()) {
+    auto chunk = queue_.Pop();
+    if (!chunk) return absl::optional<Row>();  // all streams are done
+    if (!chunk->ok()) {
+      // Fail fast: report the first error and stop the other readers.
+      error_ = chunk->status();
+      shutdown_.store(true);
+      queue_.Shutdown();
+      return error_;
+    }
+    curr_ = std::move(**chunk);
+    offset_in_curr_response_ = 0;
+  }
+
+  // TODO(#18): just like the single-stream source, return dummy `Row`
+  // objects until Apache Arrow is available to parse the data.
+  ++offset_in_curr_response_;
+  ++offset_;
+  return absl::optional<Row>(Row());
+}
+
+}  // namespace internal
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,132 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_PARALLEL_READ_RESULT_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_PARALLEL_READ_RESULT_SOURCE_H
+
+#include "google/cloud/bigquery/internal/storage_stub.h"
+#include "google/cloud/bigquery/read_result.h"
+#include "google/cloud/bigquery/read_stream.h"
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/internal/bounded_queue.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <google/cloud/bigquery/storage/v1beta1/storage.pb.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace internal {
+
+// A `ReadResultSource` that reads many session streams in parallel.
+//
+// A read session assigns rows to its streams lazily, so a single
+// `ReadStream` only ever uses one connection's worth of bandwidth. This
+// source starts one reader thread per stream; the threads push the server
+// responses into a bounded queue and the (single) consumer drains rows
+// from whichever stream produced data first. The queue bound provides
+// backpressure: readers that get far ahead of the consumer block instead
+// of buffering the whole table in memory.
+//
+// When a reader exhausts its stream while another stream still has a
+// large remainder, the idle thread splits the straggler with
+// `SplitReadStream()` and reads the split-off remainder itself. The
+// original reader is unaffected, its stream simply ends at the split
+// point. This keeps all threads busy even when the server's row
+// distribution is skewed.
+//
+// Rows are delivered in no particular order, which `ReadResult` already
+// documents for parallel reads.
+class ParallelReadResultSource : public ReadResultSource {
+ public:
+  ParallelReadResultSource(std::shared_ptr<StorageStub> stub,
+                           std::vector<ReadStream> const& streams);
+
+  // Stops the readers and joins the threads. A reader blocked on the
+  // server may delay destruction until its current read returns.
+  ~ParallelReadResultSource() override;
+
+  StatusOr<absl::optional<Row>> NextRow() override;
+  std::size_t CurrentOffset() override { return offset_; }
+  double FractionConsumed() override;
+
+ private:
+  // One response, tagged with the stream it came from so the progress
+  // accounting can attribute it.
+  struct Chunk {
+    std::size_t stream_index;
+    google::cloud::bigquery::storage::v1beta1::ReadRowsResponse response;
+  };
+
+  // The progress of one stream. `fraction` is the server-reported
+  // progress in [0, 1]; finished streams are set to 1.0 so
+  // `FractionConsumed()` can simply average.
+  struct StreamState {
+    std::string name;
+    double fraction = 0;
+    bool active = true;
+  };
+
+  static std::size_t constexpr kNoStream = static_cast<std::size_t>(-1);
+
+  // The body of each reader thread: read the stream at @p index, then keep
+  // adopting straggler remainders until no work is left.
+  void ReaderLoop(std::size_t index);
+
+  // Read the stream at @p index to completion, pushing its responses into
+  // the queue. Returns false if the stream failed (the error has been
+  // pushed and this thread should exit).
+  bool ReadStreamAt(std::size_t index);
+
+  // Pick up more work for an idle reader: split the stream with the most
+  // data left and return the index of the remainder, or `kNoStream` when
+  // nothing is worth splitting.
+  std::size_t NextStream();
+
+  void MarkFinished(std::size_t index);
+
+  std::shared_ptr<StorageStub> stub_;
+  google::cloud::internal::BoundedQueue<StatusOr<Chunk>> queue_;
+  std::atomic<bool> shutdown_{false};
+
+  std::mutex mu_;
+  std::vector<StreamState> states_;  // GUARDED_BY(mu_)
+  // Like `CommonClient::resizing_`: set while a thread holds no lock but
+  // is performing a split RPC, so only one split happens at a time.
+  bool splitting_ = false;  // GUARDED_BY(mu_)
+  std::size_t active_workers_;  // GUARDED_BY(mu_)
+
+  std::vector<std::thread> workers_;
+
+  // Consumer-side state; `NextRow()` is called from a single thread.
+  absl::optional<Chunk> curr_;
+  std::int64_t offset_in_curr_response_ = 0;
+  std::size_t offset_ = 0;
+  Status error_;
+};
+
+}  // namespace internal
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGQUERY_INTERNAL_PARALLEL_READ_RESULT_SOURCE_H
@@ -0,0 +1,212 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigquery/internal/parallel_read_result_source.h"
+#include "google/cloud/bigquery/read_stream.h"
+#include "google/cloud/bigquery/testing/mock_storage_stub.h"
+#include "google/cloud/bigquery/version.h"
+#include "google/cloud/status_or.h"
+#include <gmock/gmock.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigquery {
+inline namespace BIGQUERY_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace bigquerystorage_proto = ::google::cloud::bigquery::storage::v1beta1;
+
+using ::google::cloud::Status;
+using ::google::cloud::StatusCode;
+using ::google::cloud::StatusOr;
+using ::testing::_;
+
+using ReadRowsResponse = bigquerystorage_proto::ReadRowsResponse;
+using ReaderResult = StatusOr<absl::optional<ReadRowsResponse>>;
+
+// A `StreamReader` that performs one scripted action per `NextValue()`
+// call and ends the stream when the script runs out.
+class FakeStreamReader : public StreamReader<ReadRowsResponse> {
+ public:
+  explicit FakeStreamReader(std::vector<std::function<ReaderResult()>> actions)
+      : actions_(std::move(actions)) {}
+
+  ReaderResult NextValue() override {
+    if (index_ >= actions_.size()) {
+      return ReaderResult(absl::optional<ReadRowsResponse>{});
+    }
+    return actions_[index_++]();
+  }
+
+ private:
+  std::vector<std::function<ReaderResult()>> actions_;
+  std::size_t index_ = 0;
+};
+
+std::function<ReaderResult()> RespondWith(std::int64_t row_count,
+                                          double at_response_end) {
+  return [row_count, at_response_end]() -> ReaderResult {
+    ReadRowsResponse response;
+    response.set_row_count(row_count);
+    response.mutable_status()->mutable_progress()->set_at_response_end(
+        static_cast<float>(at_response_end));
+    return ReaderResult(absl::optional<ReadRowsResponse>(std::move(response)));
+  };
+}
+
+std::function<ReaderResult()> FailWith(Status status) {
+  return [status]() -> ReaderResult { return status; };
+}
+
+std::unique_ptr<FakeStreamReader> MakeFakeReader(
+    std::vector<std::function<ReaderResult()>> actions) {
+  return std::unique_ptr<FakeStreamReader>(
+      new FakeStreamReader(std::move(actions)));
+}
+
+std::size_t CountRows(ParallelReadResultSource& source) {
+  std::size_t count = 0;
+  for (;;) {
+    auto row = source.NextRow();
+    EXPECT_TRUE(row.ok());
+    if (!row.ok() || !row.value()) return count;
+    ++count;
+  }
+}
+
+TEST(ParallelReadResultSourceTest, MergesAllStreams) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  EXPECT_CALL(*mock, ReadRows(_))
+      .Times(2)
+      .WillRepeatedly(
+          [](bigquerystorage_proto::ReadRowsRequest const& request) {
+            auto const& name = request.read_position().stream().name();
+            if (name == "stream-0") {
+              return MakeFakeReader({RespondWith(2, 0.5), RespondWith(3, 1.0)});
+            }
+            EXPECT_EQ("stream-1", name);
+            return MakeFakeReader({RespondWith(5, 1.0)});
+          });
+  // A reader that goes idle before the other stream reports progress may
+  // probe for a split; a failed split is benign, so just reject them all.
+  EXPECT_CALL(*mock, SplitReadStream(_))
+      .Times(::testing::AnyNumber())
+      .WillRepeatedly([](bigquerystorage_proto::SplitReadStreamRequest const&)
+                          -> StatusOr<
+                              bigquerystorage_proto::SplitReadStreamResponse> {
+        return Status(StatusCode::kFailedPrecondition, "not splittable");
+      });
+
+  std::vector<ReadStream> streams = {MakeReadStream("stream-0"),
+                                     MakeReadStream("stream-1")};
+  ParallelReadResultSource source(mock, streams);
+  EXPECT_EQ(10U, CountRows(source));
+  EXPECT_EQ(10U, source.CurrentOffset());
+  EXPECT_DOUBLE_EQ(1.0, source.FractionConsumed());
+}
+
+TEST(ParallelReadResultSourceTest, EmptyStreamList) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  ParallelReadResultSource source(mock, {});
+  auto row = source.NextRow();
+  ASSERT_TRUE(row.ok());
+  EXPECT_FALSE(row.value().has_value());
+}
+
+TEST(ParallelReadResultSourceTest, ReportsFirstError) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  EXPECT_CALL(*mock, ReadRows(_))
+      .WillOnce([](bigquerystorage_proto::ReadRowsRequest const&) {
+        return MakeFakeReader(
+            {RespondWith(2, 0.5),
+             FailWith(Status(StatusCode::kUnavailable, "stream broke"))});
+      });
+
+  std::vector<ReadStream> streams = {MakeReadStream("stream-0")};
+  ParallelReadResultSource source(mock, streams);
+  for (int i = 0; i != 2; ++i) {
+    auto row = source.NextRow();
+    ASSERT_TRUE(row.ok());
+    EXPECT_TRUE(row.value().has_value());
+  }
+  auto row = source.NextRow();
+  EXPECT_EQ(StatusCode::kUnavailable, row.status().code());
+  EXPECT_EQ("stream broke", row.status().message());
+  // The error is sticky.
+  row = source.NextRow();
+  EXPECT_EQ(StatusCode::kUnavailable, row.status().code());
+}
+
+TEST(ParallelReadResultSourceTest, SplitsStraggler) {
+  auto mock = std::make_shared<bigquery_testing::MockStorageStub>();
+  // `stream-0` produces nothing until the straggler split happens, so the
+  // reader of `stream-1` reliably goes idle while `stream-0` still has all
+  // of its data left.
+  auto split_done = std::make_shared<std::promise<void>>();
+  auto split_future =
+      std::make_shared<std::shared_future<void>>(split_done->get_future());
+  EXPECT_CALL(*mock, ReadRows(_))
+      .Times(3)
+      .WillRepeatedly([split_future](
+                          bigquerystorage_proto::ReadRowsRequest const&
+                              request) {
+        auto const& name = request.read_position().stream().name();
+        if (name == "stream-0") {
+          auto wait = *split_future;
+          return MakeFakeReader({[wait]() -> ReaderResult {
+            wait.wait();
+            return ReaderResult(absl::optional<ReadRowsResponse>{});
+          }});
+        }
+        if (name == "stream-1") return MakeFakeReader({});
+        EXPECT_EQ("stream-0-remainder", name);
+        return MakeFakeReader({RespondWith(3, 1.0)});
+      });
+  EXPECT_CALL(*mock, SplitReadStream(_))
+      .WillOnce(
+          [split_done](bigquerystorage_proto::SplitReadStreamRequest const&
+                           request)
+              -> StatusOr<bigquerystorage_proto::SplitReadStreamResponse> {
+            EXPECT_EQ("stream-0", request.original_stream().name());
+            bigquerystorage_proto::SplitReadStreamResponse response;
+            response.mutable_primary_stream()->set_name("stream-0");
+            response.mutable_remainder_stream()->set_name(
+                "stream-0-remainder");
+            split_done->set_value();
+            return response;
+          })
+      .WillRepeatedly([](bigquerystorage_proto::SplitReadStreamRequest const&)
+                          -> StatusOr<
+                              bigquerystorage_proto::SplitReadStreamResponse> {
+        return Status(StatusCode::kFailedPrecondition, "already split");
+      });
+
+  std::vector<ReadStream> streams = {MakeReadStream("stream-0"),
+                                     MakeReadStream("stream-1")};
+  ParallelReadResultSource source(mock, streams);
+  EXPECT_EQ(3U, CountRows(source));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGQUERY_CLIENT_NS
+}  // namespace bigquery
+}  // namespace cloud
+}  // namespace google
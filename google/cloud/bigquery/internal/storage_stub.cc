@@ -78,6 +78,10 @@ class DefaultStorageStub : public StorageStub {
   std::unique_ptr<StreamReader<bigquerystorage_proto::ReadRowsResponse>>
   ReadRows(bigquerystorage_proto::ReadRowsRequest const& request) override;
 
+  google::cloud::StatusOr<bigquerystorage_proto::SplitReadStreamResponse>
+  SplitReadStream(
+      bigquerystorage_proto::SplitReadStreamRequest const& request) override;
+
  private:
   std::unique_ptr<bigquerystorage_proto::BigQueryStorage::StubInterface>
       grpc_stub_;
@@ -135,6 +139,24 @@ DefaultStorageStub::ReadRows(
           std::move(client_context), std::move(stream)));
 }
 
+google::cloud::StatusOr<bigquerystorage_proto::SplitReadStreamResponse>
+DefaultStorageStub::SplitReadStream(
+    bigquerystorage_proto::SplitReadStreamRequest const& request) {
+  bigquerystorage_proto::SplitReadStreamResponse response;
+  grpc::ClientContext client_context;
+
+  std::string routing_header = "original_stream.name=";
+  routing_header += request.original_stream().name();
+  client_context.AddMetadata(kRoutingHeader, routing_header);
+
+  grpc::Status grpc_status =
+      grpc_stub_->SplitReadStream(&client_context, request, &response);
+  if (!grpc_status.ok()) {
+    return MakeStatusFromRpcError(grpc_status);
+  }
+  return response;
+}
+
 }  // namespace
 
 std::shared_ptr<StorageStub> MakeDefaultStorageStub(
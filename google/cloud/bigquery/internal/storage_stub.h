@@ -47,6 +47,13 @@ class StorageStub {
   ReadRows(google::cloud::bigquery::storage::v1beta1::ReadRowsRequest const&
                request) = 0;
 
+  // Sends a SplitReadStream RPC.
+  virtual google::cloud::StatusOr<
+      google::cloud::bigquery::storage::v1beta1::SplitReadStreamResponse>
+  SplitReadStream(
+      google::cloud::bigquery::storage::v1beta1::SplitReadStreamRequest const&
+          request) = 0;
+
  protected:
   StorageStub() = default;
 };
@@ -39,6 +39,13 @@ class MockStorageStub : public google::cloud::bigquery::internal::StorageStub {
       std::unique_ptr<bigquery::internal::StreamReader<
           google::cloud::bigquery::storage::v1beta1::ReadRowsResponse>>(
           google::cloud::bigquery::storage::v1beta1::ReadRowsRequest const&));
+
+  MOCK_METHOD1(
+      SplitReadStream,
+      google::cloud::StatusOr<
+          google::cloud::bigquery::storage::v1beta1::SplitReadStreamResponse>(
+          google::cloud::bigquery::storage::v1beta1::
+              SplitReadStreamRequest const&));
 };
 
 }  // namespace BIGQUERY_CLIENT_NS
@@ -0,0 +1,104 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/arena_bulk_mutation.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <google/protobuf/text_format.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+
+/// @test Verify that cells land in the request exactly as with SetCell().
+TEST(ArenaBulkMutationTest, SetCell) {
+  bigtable::ArenaBulkMutation mut;
+  mut.AddRow("foo")
+      .SetCell("family", "c1", 1234_ms, "v1")
+      .SetCell("family", "c2", "server-time")
+      .SetCell("family", "c3", 2345_ms, std::int64_t(42));
+  mut.AddRow("bar").Append(bigtable::DeleteFromRow());
+  EXPECT_FALSE(mut.empty());
+  EXPECT_EQ(2U, mut.size());
+
+  auto request = std::move(mut).ReleaseRequest();
+  ASSERT_TRUE(request);
+  EXPECT_NE(nullptr, request->GetArena());
+
+  btproto::MutateRowsRequest expected;
+  std::string expected_text = R"""(
+      entries: {
+        row_key: "foo"
+        mutations: {
+          set_cell: {
+            family_name: "family"
+            column_qualifier: "c1"
+            timestamp_micros: 1234000
+            value: "v1"
+          }
+        }
+        mutations: {
+          set_cell: {
+            family_name: "family"
+            column_qualifier: "c2"
+            timestamp_micros: -1
+            value: "server-time"
+          }
+        }
+        mutations: {
+          set_cell: {
+            family_name: "family"
+            column_qualifier: "c3"
+            timestamp_micros: 2345000
+            value: "\000\000\000\000\000\000\000\052"
+          }
+        }
+      }
+      entries: {
+        row_key: "bar"
+        mutations: { delete_from_row: { } }
+      }
+  )""";
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(expected_text,
+                                                            &expected));
+  std::string delta;
+  google::protobuf::util::MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(expected, *request)) << delta;
+}
+
+/// @test Verify that an empty mutation produces an empty request.
+TEST(ArenaBulkMutationTest, Empty) {
+  bigtable::ArenaBulkMutation mut;
+  EXPECT_TRUE(mut.empty());
+  EXPECT_EQ(0U, mut.size());
+  auto request = std::move(mut).ReleaseRequest();
+  ASSERT_TRUE(request);
+  EXPECT_EQ(0, request->entries_size());
+}
+
+/// @test Verify that the request (and its arena) outlive the mutation.
+TEST(ArenaBulkMutationTest, RequestOutlivesMutation) {
+  std::shared_ptr<btproto::MutateRowsRequest> request;
+  {
+    bigtable::ArenaBulkMutation mut;
+    mut.AddRow("foo").SetCell("fam", "col", 0_ms, "value");
+    request = std::move(mut).ReleaseRequest();
+  }
+  ASSERT_EQ(1, request->entries_size());
+  EXPECT_EQ("foo", request->entries(0).row_key());
+  EXPECT_EQ("value", request->entries(0).mutations(0).set_cell().value());
+}
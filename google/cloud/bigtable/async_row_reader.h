@@ -32,12 +32,54 @@
 #include "google/cloud/status_or.h"
 #include "absl/types/optional.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <queue>
 
 namespace google {
 namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Limit how far `Table::AsyncReadRows` reads ahead of the application.
+ *
+ * By default the client asks the server for more data only after the
+ * application has consumed all the rows received so far. High-throughput
+ * applications may want to overlap the network transfers with their own
+ * processing; raising these limits allows the client to hold up to
+ * `max_ready_rows` unacknowledged rows (but no more than roughly
+ * `max_ready_bytes` of row data) before it stops reading from the server.
+ * The row delivered in the last callback counts against the window until the
+ * application asks for the next one.
+ */
+struct AsyncReadRowsFlowControl {
+  AsyncReadRowsFlowControl()
+      : max_ready_rows(1), max_ready_bytes(8 * 1024 * 1024UL) {}
+
+  /// Maximum number of rows received but not yet acknowledged by the
+  /// application.
+  AsyncReadRowsFlowControl& SetMaxReadyRows(std::size_t max_ready_rows_arg) {
+    max_ready_rows = max_ready_rows_arg;
+    return *this;
+  }
+
+  /**
+   * Maximum (approximate) size of the rows received but not yet acknowledged
+   * by the application.
+   *
+   * A single row larger than this limit is still buffered, otherwise large
+   * rows would stall the scan.
+   */
+  AsyncReadRowsFlowControl& SetMaxReadyBytes(std::size_t max_ready_bytes_arg) {
+    max_ready_bytes = max_ready_bytes_arg;
+    return *this;
+  }
+
+  std::size_t max_ready_rows;
+  std::size_t max_ready_bytes;
+};
+
 /**
  * Objects of this class represent the state of reading rows via AsyncReadRows.
  *
@@ -76,13 +118,15 @@ class AsyncRowReader : public std::enable_shared_from_this<
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
       // NOLINTNEXTLINE(performance-unnecessary-value-param) TODO(#4112)
       MetadataUpdatePolicy metadata_update_policy,
-      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory) {
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      AsyncReadRowsFlowControl flow_control) {
     std::shared_ptr<AsyncRowReader> res(new AsyncRowReader(
         std::move(cq), std::move(client), std::move(app_profile_id),
         std::move(table_name), std::move(on_row), std::move(on_finish),
         std::move(row_set), rows_limit, std::move(filter),
         std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
-        std::move(metadata_update_policy), std::move(parser_factory)));
+        std::move(metadata_update_policy), std::move(parser_factory),
+        flow_control));
     res->MakeRequest();
     return res;
   }
@@ -94,7 +138,8 @@ class AsyncRowReader : public std::enable_shared_from_this<
       Filter filter, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
       MetadataUpdatePolicy metadata_update_policy,
-      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory)
+      std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+      AsyncReadRowsFlowControl flow_control)
       : cq_(std::move(cq)),
         client_(std::move(client)),
         app_profile_id_(std::move(app_profile_id)),
@@ -108,26 +153,34 @@ class AsyncRowReader : public std::enable_shared_from_this<
         rpc_backoff_policy_(std::move(rpc_backoff_policy)),
         metadata_update_policy_(std::move(metadata_update_policy)),
         parser_factory_(std::move(parser_factory)),
+        flow_control_(flow_control),
         rows_count_(0),
+        ready_bytes_(0),
+        user_row_bytes_(0),
+        user_is_ready_(true),
         whole_op_finished_(),
+        cancelled_(),
         recursion_level_() {}
 
   void MakeRequest() {
-    status_ = Status();
     google::bigtable::v2::ReadRowsRequest request;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      status_ = Status();
 
-    request.set_app_profile_id(app_profile_id_);
-    request.set_table_name(table_name_);
-    auto row_set_proto = row_set_.as_proto();
-    request.mutable_rows()->Swap(&row_set_proto);
+      request.set_app_profile_id(app_profile_id_);
+      request.set_table_name(table_name_);
+      auto row_set_proto = row_set_.as_proto();
+      request.mutable_rows()->Swap(&row_set_proto);
 
-    auto filter_proto = filter_.as_proto();
-    request.mutable_filter()->Swap(&filter_proto);
+      auto filter_proto = filter_.as_proto();
+      request.mutable_filter()->Swap(&filter_proto);
 
-    if (rows_limit_ != NO_ROWS_LIMIT) {
-      request.set_rows_limit(rows_limit_ - rows_count_);
+      if (rows_limit_ != NO_ROWS_LIMIT) {
+        request.set_rows_limit(rows_limit_ - rows_count_);
+      }
+      parser_ = parser_factory_->Create();
     }
-    parser_ = parser_factory_->Create();
 
     auto context = absl::make_unique<grpc::ClientContext>();
     rpc_retry_policy_->Setup(*context);
@@ -153,7 +206,15 @@ class AsyncRowReader : public std::enable_shared_from_this<
    * Called when the user asks for more rows via satisfying the future returned
    * from the row callback.
    */
-  void UserWantsRows() { TryGiveRowToUser(); }
+  void UserWantsRows() {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      user_is_ready_ = true;
+      ready_bytes_ -= (std::min)(ready_bytes_, user_row_bytes_);
+      user_row_bytes_ = 0;
+    }
+    TryGiveRowToUser();
+  }
 
   /**
    * Attempt to call a user callback.
@@ -175,39 +236,70 @@ class AsyncRowReader : public std::enable_shared_from_this<
     // indicates it should cap this stack usage to below 100K. Default stack
     // size is usually 1MB.
     struct CountFrame {
-      explicit CountFrame(int& cntr) : cntr(++cntr){};
+      explicit CountFrame(std::atomic<int>& cntr) : cntr(cntr) { ++cntr; }
       ~CountFrame() { --cntr; }
-      int& cntr;
+      std::atomic<int>& cntr;
     };
     CountFrame frame(recursion_level_);
 
-    if (ready_rows_.empty()) {
-      if (whole_op_finished_) {
-        // The scan is finished for good, there will be no more rows.
-        on_finish_(status_);
-        return;
-      }
-      if (!continue_reading_) {
-        // TODO(#1402): replace with GCP_ASSERT(continue_reading_);
-        Terminate(
-            "No rows are ready and we can't continue reading. This is a bug, "
-            "please report it at "
-            "https://github.com/googleapis/google-cloud-cpp/issues/new");
+    absl::optional<Row> row;
+    absl::optional<promise<bool>> continue_reading;
+    bool finished = false;
+    Status status;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (ready_rows_.empty()) {
+        if (whole_op_finished_) {
+          if (!user_is_ready_ && !cancelled_) {
+            // The user is still processing a row; deliver the final status
+            // when they ask for the next one.
+            return;
+          }
+          // The scan is finished for good, there will be no more rows.
+          finished = true;
+          status = status_;
+        } else {
+          // No rows are ready. If the stream is waiting for an
+          // acknowledgement, release it; otherwise the lower layers are
+          // already fetching more data.
+          continue_reading = std::move(continue_reading_);
+          continue_reading_.reset();
+        }
+      } else {
+        if (!user_is_ready_) {
+          // The user has not finished processing the previous row; they will
+          // ask for this one via `UserWantsRows()`.
+          return;
+        }
+        // Yay! We have something to give to the user and they want it.
+        user_is_ready_ = false;
+        row.emplace(std::move(ready_rows_.front()));
+        ready_rows_.pop();
+        // The row still counts against the flow control window until the
+        // user acknowledges it in `UserWantsRows()`.
+        user_row_bytes_ = EstimateRowSize(*row);
+        if (continue_reading_ && HasRoomForMoreRows()) {
+          // Popping the row opened room in the flow control window, resume
+          // the stream while the user processes this row.
+          continue_reading = std::move(continue_reading_);
+          continue_reading_.reset();
+        }
       }
-      // No rows, but we can fetch some.
-      auto continue_reading = std::move(continue_reading_);
-      continue_reading_.reset();
+    }
+    if (continue_reading) {
       continue_reading->set_value(true);
+    }
+    if (finished) {
+      on_finish_(status);
+      return;
+    }
+    if (!row) {
       return;
     }
-
-    // Yay! We have something to give to the user and they want it.
-    auto row = std::move(ready_rows_.front());
-    ready_rows_.pop();
 
     auto self = this->shared_from_this();
     bool const break_recursion = recursion_level_ >= 100;
-    on_row_(std::move(row)).then([self, break_recursion](future<bool> fut) {
+    on_row_(*std::move(row)).then([self, break_recursion](future<bool> fut) {
       bool should_cancel;
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
       try {
@@ -244,36 +336,56 @@ class AsyncRowReader : public std::enable_shared_from_this<
       google::bigtable::v2::ReadRowsResponse const& response) {
     // assert(!whole_op_finished_);
     // assert(!continue_reading_);
-    // assert(status_.ok());
-    status_ = ConsumeResponse(std::move(response));
-    // We've processed the response.
-    //
-    // If there were errors (e.g. malformed response from the server), we should
-    // interrupt this stream. Interrupting it will yield lower layers calling
-    // `OnStreamFinished` with a status unrelated to the real reason, so we
-    // store the actual reason in status_ and proceed exactly the
-    // same way as if the stream was broken for other reasons.
-    //
-    // Even if status_ is not OK, we might have consumed some rows,
-    // but, don't give them to the user yet. We want to keep the invariant that
-    // either the user doesn't hold a `future<>` when we're fetching more rows.
-    // Retries (successful or not) will do it. Improving this behavior makes
-    // little sense because parser errors are very unexpected and probably not
-    // retriable anyway.
-
-    if (status_.ok()) {
-      continue_reading_.emplace(promise<bool>());
-      auto res = continue_reading_->get_future();
-      TryGiveRowToUser();
-      return res;
+    future<bool> res;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (cancelled_) {
+        // The user cancelled the scan while this response was in flight,
+        // interrupt the stream.
+        return make_ready_future<bool>(false);
+      }
+      status_ = ConsumeResponse(std::move(response));
+      // We've processed the response.
+      //
+      // If there were errors (e.g. malformed response from the server), we
+      // should interrupt this stream. Interrupting it will yield lower layers
+      // calling `OnStreamFinished` with a status unrelated to the real reason,
+      // so we store the actual reason in status_ and proceed exactly the
+      // same way as if the stream was broken for other reasons.
+      //
+      // Even if status_ is not OK, we might have consumed some rows, but,
+      // don't give them to the user yet. Retries (successful or not) will do
+      // it. Improving this behavior makes little sense because parser errors
+      // are very unexpected and probably not retriable anyway.
+      if (!status_.ok()) {
+        return make_ready_future<bool>(false);
+      }
+      if (HasRoomForMoreRows()) {
+        // There is room in the flow control window, keep the stream going
+        // while the user processes the rows received so far.
+        res = make_ready_future<bool>(true);
+      } else {
+        continue_reading_.emplace(promise<bool>());
+        res = continue_reading_->get_future();
+      }
     }
-    return make_ready_future<bool>(false);
+    TryGiveRowToUser();
+    return res;
   }
 
   /// Called when the whole stream finishes.
   // NOLINTNEXTLINE(performance-unnecessary-value-param)
   void OnStreamFinished(Status status) {
     // assert(!continue_reading_);
+    std::unique_lock<std::mutex> lk(mu_);
+    if (cancelled_) {
+      // The user cancelled the scan; `status_` already holds the
+      // cancellation status and there is nothing to retry.
+      whole_op_finished_ = true;
+      lk.unlock();
+      TryGiveRowToUser();
+      return;
+    }
     if (status_.ok()) {
       status_ = std::move(status);
     }
@@ -307,6 +419,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
     if (status_.ok()) {
       // We've successfully finished the scan.
       whole_op_finished_ = true;
+      lk.unlock();
       TryGiveRowToUser();
       return;
     }
@@ -314,42 +427,52 @@ class AsyncRowReader : public std::enable_shared_from_this<
     if (!rpc_retry_policy_->OnFailure(status_)) {
       // Can't retry.
       whole_op_finished_ = true;
+      lk.unlock();
       TryGiveRowToUser();
       return;
     }
+    auto delay = rpc_backoff_policy_->OnCompletion(status_);
+    lk.unlock();
     auto self = this->shared_from_this();
-    cq_.MakeRelativeTimer(rpc_backoff_policy_->OnCompletion(status_))
-        .then([self](future<StatusOr<std::chrono::system_clock::time_point>>
-                         result) {
-          if (auto tp = result.get()) {
+    cq_.MakeRelativeTimer(delay).then(
+        [self](future<StatusOr<std::chrono::system_clock::time_point>>
+                   result) {
+          std::unique_lock<std::mutex> lk(self->mu_);
+          if (result.get() && !self->cancelled_) {
+            lk.unlock();
             self->MakeRequest();
-          } else {
-            self->whole_op_finished_ = true;
-            self->TryGiveRowToUser();
+            return;
           }
+          self->whole_op_finished_ = true;
+          lk.unlock();
+          self->TryGiveRowToUser();
         });
   }
 
   /// User satisfied the future returned from the row callback with false.
   void Cancel(std::string const& reason) {
+    std::unique_lock<std::mutex> lk(mu_);
     ready_rows_ = std::queue<Row>();
+    ready_bytes_ = 0;
+    user_row_bytes_ = 0;
+    cancelled_ = true;
     auto continue_reading = std::move(continue_reading_);
     continue_reading_.reset();
-    Status status(StatusCode::kCancelled, reason);
+    status_ = Status(StatusCode::kCancelled, reason);
+    lk.unlock();
     if (!continue_reading) {
-      // If we're not in the middle of the stream fire some user callbacks, but
-      // also override the overall status.
-      // assert(whole_op_finished_);
-      status_ = std::move(status);
+      // Either the whole operation is finished, or the lower layers have a
+      // read in flight; in the latter case `OnDataReceived()` will interrupt
+      // the stream.
       TryGiveRowToUser();
       return;
     }
     // If we are in the middle of the stream, cancel the stream.
-    status_ = std::move(status);
     continue_reading->set_value(false);
   }
 
   /// Process everything that is accumulated in the parser.
+  /// Requires `mu_` to be held.
   Status DrainParser() {
     grpc::Status status;
     while (parser_->HasNext()) {
@@ -359,12 +482,42 @@ class AsyncRowReader : public std::enable_shared_from_this<
       }
       ++rows_count_;
       last_read_row_key_ = std::string(parsed_row.row_key());
+      ready_bytes_ += EstimateRowSize(parsed_row);
       ready_rows_.emplace(std::move(parsed_row));
     }
     return Status();
   }
 
+  /**
+   * Return true if the flow control window allows fetching more data.
+   *
+   * Requires `mu_` to be held. The row handed to the user but not yet
+   * acknowledged counts against the window; with the default window of one
+   * row this reduces to the historical behavior of fetching more data only
+   * after all the received rows are delivered.
+   */
+  bool HasRoomForMoreRows() const {
+    auto const held_rows = ready_rows_.size() + (user_is_ready_ ? 0 : 1);
+    // Treat a window of zero as one, it would stall the scan otherwise.
+    auto const max_rows =
+        (std::max<std::size_t>)(flow_control_.max_ready_rows, 1);
+    auto const max_bytes =
+        (std::max<std::size_t>)(flow_control_.max_ready_bytes, 1);
+    return held_rows < max_rows && ready_bytes_ < max_bytes;
+  }
+
+  /// A rough estimate of the memory occupied by a row in the ready queue.
+  static std::size_t EstimateRowSize(Row const& row) {
+    std::size_t size = row.row_key().size();
+    for (auto const& cell : row.cells()) {
+      size += cell.row_key().size() + cell.family_name().size() +
+              cell.column_qualifier().size() + cell.value().size();
+    }
+    return size;
+  }
+
   /// Parse the data from the response.
+  /// Requires `mu_` to be held.
   Status ConsumeResponse(google::bigtable::v2::ReadRowsResponse response) {
     for (auto& chunk : *response.mutable_chunks()) {
       grpc::Status status;
@@ -397,12 +550,21 @@ class AsyncRowReader : public std::enable_shared_from_this<
   MetadataUpdatePolicy metadata_update_policy_;
   std::unique_ptr<internal::ReadRowsParserFactory> parser_factory_;
   std::unique_ptr<internal::ReadRowsParser> parser_;
+  /// How far ahead of the user the stream is allowed to read.
+  AsyncReadRowsFlowControl flow_control_;
   /// Number of rows read so far, used to set row_limit in retries.
   std::int64_t rows_count_;
   /// Holds the last read row key, for retries.
   std::string last_read_row_key_;
   /// The queue of rows which we already received but no one has asked for them.
   std::queue<Row> ready_rows_;
+  /// Estimated total size of the rows received but not yet acknowledged by
+  /// the user, including the row handed to them in the last callback.
+  std::size_t ready_bytes_;
+  /// Estimated size of the row handed to the user in the last callback.
+  std::size_t user_row_bytes_;
+  /// Whether the user is ready to receive the next row callback.
+  bool user_is_ready_;
   /**
    * The promise to the underlying stream to either continue reading or cancel.
    *
@@ -415,6 +577,8 @@ class AsyncRowReader : public std::enable_shared_from_this<
   absl::optional<promise<bool>> continue_reading_;
   /// The final status of the operation.
   bool whole_op_finished_;
+  /// The user cancelled the operation, do not deliver or fetch more rows.
+  bool cancelled_;
   /**
    * The status of the last retry attempt_.
    *
@@ -424,7 +588,7 @@ class AsyncRowReader : public std::enable_shared_from_this<
    */
   Status status_;
   /// Tracks the level of recursion of TryGiveRowToUser
-  int recursion_level_;
+  std::atomic<int> recursion_level_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -97,7 +97,9 @@ class TableAsyncReadRowsTest : public bigtable::testing::TableTestFixture {
   }
 
   // Start Table::AsyncReadRows.
-  void ReadRows(int row_limit = RowReader::NO_ROWS_LIMIT) {
+  void ReadRows(int row_limit = RowReader::NO_ROWS_LIMIT,
+                AsyncReadRowsFlowControl flow_control =
+                    AsyncReadRowsFlowControl()) {
     table_.AsyncReadRows(
         cq_,
         [this](Row const& row) {
@@ -112,7 +114,7 @@ class TableAsyncReadRowsTest : public bigtable::testing::TableTestFixture {
         [this](Status const& stream_status) {
           stream_status_promise_.set_value(stream_status);
         },
-        RowSet(), row_limit, Filter::PassAllFilter());
+        RowSet(), row_limit, Filter::PassAllFilter(), flow_control);
   }
 
   /// Expect a row whose row key is equal to this function's argument.
@@ -388,6 +390,136 @@ TEST_F(TableAsyncReadRowsTest, MultipleChunksImmediatelySatisfied) {
   ASSERT_EQ(0U, cq_impl_->size());
 }
 
+/// @test Verify that the stream reads ahead within the flow control window.
+TEST_F(TableAsyncReadRowsTest, ReadAheadWithinFlowControlWindow) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r1"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      })
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r2"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish(_, _)).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  ExpectRow("r1");
+  ExpectRow("r2");
+  ReadRows(RowReader::NO_ROWS_LIMIT,
+           AsyncReadRowsFlowControl().SetMaxReadyRows(3));
+
+  EXPECT_TRUE(reader_started_[0]);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+
+  EXPECT_TRUE(Unsatisfied(row_futures_[0]));
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  row_futures_[0].get();
+
+  // The first row has not been acknowledged, yet the flow control window has
+  // room, so the stream should be fetching more data.
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+
+  // The second row is buffered until the user asks for it.
+  EXPECT_TRUE(Unsatisfied(row_futures_[1]));
+  ASSERT_EQ(1U, cq_impl_->size());
+
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  // The stream is finished, but the user hasn't consumed the buffered row, so
+  // the final status should not be delivered yet.
+  EXPECT_TRUE(Unsatisfied(stream_status_future_));
+
+  promises_from_user_cb_[0].set_value(true);
+  row_futures_[1].get();
+
+  EXPECT_TRUE(Unsatisfied(stream_status_future_));
+  promises_from_user_cb_[1].set_value(true);
+
+  auto stream_status = stream_status_future_.get();
+  ASSERT_STATUS_OK(stream_status);
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
+/// @test Verify that the flow control byte limit stops the read-ahead.
+TEST_F(TableAsyncReadRowsTest, ReadAheadRespectsByteLimit) {
+  auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
+
+  EXPECT_CALL(stream, Read(_, _))
+      .WillOnce([](btproto::ReadRowsResponse* r, void*) {
+        *r = bigtable::testing::ReadRowsResponseFromString(
+            R"(
+                chunks {
+                  row_key: "r1"
+                  family_name { value: "fam" }
+                  qualifier { value: "col" }
+                  timestamp_micros: 42000
+                  value: "value"
+                  commit_row: true
+                })");
+      })
+      .RetiresOnSaturation();
+  EXPECT_CALL(stream, Finish(_, _)).WillOnce([](grpc::Status* status, void*) {
+    *status = grpc::Status::OK;
+  });
+
+  ExpectRow("r1");
+  // A large row count limit, but a byte limit smaller than any row.
+  ReadRows(RowReader::NO_ROWS_LIMIT,
+           AsyncReadRowsFlowControl().SetMaxReadyRows(10).SetMaxReadyBytes(1));
+
+  EXPECT_TRUE(reader_started_[0]);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Finish Start()
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(true);  // Return data
+  row_futures_[0].get();
+
+  // The unacknowledged row exceeds the byte limit, so the stream should not
+  // be fetching more data.
+  ASSERT_EQ(0U, cq_impl_->size());
+  promises_from_user_cb_[0].set_value(true);
+
+  ASSERT_EQ(1U, cq_impl_->size());
+  cq_impl_->SimulateCompletion(false);  // Finish stream
+  ASSERT_EQ(1U, cq_impl_->size());
+  EXPECT_TRUE(Unsatisfied(stream_status_future_));
+  cq_impl_->SimulateCompletion(true);  // Finish Finish()
+
+  auto stream_status = stream_status_future_.get();
+  ASSERT_STATUS_OK(stream_status);
+  ASSERT_EQ(0U, cq_impl_->size());
+}
+
 /// @test Verify that a single row can span mutiple responses.
 TEST_F(TableAsyncReadRowsTest, ResponseInMultipleChunks) {
   auto& stream = AddReader([](btproto::ReadRowsRequest const&) {});
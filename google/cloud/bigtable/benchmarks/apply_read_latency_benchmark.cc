@@ -54,6 +54,13 @@
  *     random, then perform the operation, record the latency and whether the
  *     operation was successful.
  *
+ * The latencies are accumulated in streaming histograms
+ * (`LatencyHistogram`), not as individual samples, so the memory footprint
+ * is constant regardless of the run length or the operation rate. While
+ * the test runs, a snapshot of the current interval (p50, p99, p99.9, max)
+ * is printed every `kIntervalReportPeriod`, so long runs show how the tail
+ * latencies evolve over time.
+ *
  * The test then waits for all the threads to finish and:
  *
  * - Collects the results from all the threads.
@@ -76,28 +83,33 @@ namespace {
 
 namespace bigtable = google::cloud::bigtable;
 using bigtable::benchmarks::Benchmark;
-using bigtable::benchmarks::BenchmarkResult;
 using bigtable::benchmarks::FormatDuration;
+using bigtable::benchmarks::IntervalLatencyReporter;
 using bigtable::benchmarks::kColumnFamily;
 using bigtable::benchmarks::kNumFields;
+using bigtable::benchmarks::LatencyHistogram;
 using bigtable::benchmarks::MakeBenchmarkSetup;
 using bigtable::benchmarks::MakeRandomMutation;
 using bigtable::benchmarks::OperationResult;
 
 struct LatencyBenchmarkResult {
-  BenchmarkResult apply_results;
-  BenchmarkResult read_results;
+  LatencyHistogram apply_histogram;
+  LatencyHistogram read_histogram;
 };
 
 /// Run an iteration of the test.
 google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
     bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
-    std::string const& table_id, std::chrono::seconds test_duration);
+    std::string const& table_id, std::chrono::seconds test_duration,
+    IntervalLatencyReporter& apply_reporter,
+    IntervalLatencyReporter& read_reporter);
 
 //@{
 /// @name Test constants.  Defined as requirements in the original bug (#189).
 /// How many times does each thread report progress.
 constexpr int kBenchmarkProgressMarks = 4;
+/// How often to print a snapshot of the current interval latencies.
+constexpr std::chrono::seconds kIntervalReportPeriod(60);
 //@}
 
 }  // anonymous namespace
@@ -125,6 +137,10 @@ int main(int argc, char* argv[]) {
   auto data_client = benchmark.MakeDataClient();
   // Start the threads running the latency test.
   std::cout << "Running Latency Benchmark " << std::flush;
+  IntervalLatencyReporter apply_reporter(std::cout, "Apply()",
+                                         kIntervalReportPeriod);
+  IntervalLatencyReporter read_reporter(std::cout, "ReadRow()",
+                                        kIntervalReportPeriod);
   auto latency_test_start = std::chrono::steady_clock::now();
   std::vector<std::future<google::cloud::StatusOr<LatencyBenchmarkResult>>>
       tasks;
@@ -136,53 +152,57 @@ int main(int argc, char* argv[]) {
     }
     tasks.emplace_back(std::async(launch_policy, RunBenchmark,
                                   std::ref(benchmark), setup->app_profile_id(),
-                                  setup->table_id(), setup->test_duration()));
+                                  setup->table_id(), setup->test_duration(),
+                                  std::ref(apply_reporter),
+                                  std::ref(read_reporter)));
   }
 
   // Wait for the threads and combine all the results.
   LatencyBenchmarkResult combined{};
   int count = 0;
-  auto append = [](LatencyBenchmarkResult& destination,
-                   LatencyBenchmarkResult const& source) {
-    auto append_ops = [](BenchmarkResult& d, BenchmarkResult const& s) {
-      d.row_count += s.row_count;
-      d.operations.insert(d.operations.end(), s.operations.begin(),
-                          s.operations.end());
-    };
-    append_ops(destination.apply_results, source.apply_results);
-    append_ops(destination.read_results, source.read_results);
-  };
   for (auto& future : tasks) {
     auto result = future.get();
     if (!result) {
       std::cerr << "Standard exception raised by task[" << count
                 << "]: " << result.status() << "\n";
     } else {
-      append(combined, *result);
+      combined.apply_histogram.Merge(result->apply_histogram);
+      combined.read_histogram.Merge(result->read_histogram);
     }
     ++count;
   }
   auto latency_test_elapsed =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - latency_test_start);
-  combined.apply_results.elapsed = latency_test_elapsed;
-  combined.read_results.elapsed = latency_test_elapsed;
   std::cout << " DONE. Elapsed=" << FormatDuration(latency_test_elapsed)
-            << ", Ops=" << combined.apply_results.operations.size()
-            << ", Rows=" << combined.apply_results.row_count << "\n";
+            << ", Ops="
+            << combined.apply_histogram.count() +
+                   combined.read_histogram.count()
+            << ", Rows=" << combined.apply_histogram.count() << "\n";
 
   Benchmark::PrintLatencyResult(std::cout, "perf", "Apply()",
-                                combined.apply_results);
+                                combined.apply_histogram,
+                                latency_test_elapsed);
   Benchmark::PrintLatencyResult(std::cout, "perf", "ReadRow()",
-                                combined.read_results);
+                                combined.read_histogram, latency_test_elapsed);
 
   std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << "\n";
   benchmark.PrintResultCsv(std::cout, "perf", "BulkApply()", "Latency",
                            *populate_results);
-  benchmark.PrintResultCsv(std::cout, "perf", "Apply()", "Latency",
-                           combined.apply_results);
-  benchmark.PrintResultCsv(std::cout, "perf", "ReadRow()", "Latency",
-                           combined.read_results);
+  benchmark.PrintResultJson(std::cout, "perf", "BulkApply()", "Latency",
+                            *populate_results);
+
+  // Report the per-operation-type histograms, including the error counts
+  // and in a machine-friendly format.
+  std::cout << Benchmark::HistogramCsvHeader() << "\n";
+  benchmark.PrintHistogramCsv(std::cout, "perf", "Apply()", "Latency",
+                              combined.apply_histogram);
+  benchmark.PrintHistogramCsv(std::cout, "perf", "ReadRow()", "Latency",
+                              combined.read_histogram);
+  benchmark.PrintHistogramJson(std::cout, "perf", "Apply()", "Latency",
+                               combined.apply_histogram);
+  benchmark.PrintHistogramJson(std::cout, "perf", "ReadRow()", "Latency",
+                               combined.read_histogram);
 
   benchmark.DeleteTable();
 
@@ -215,7 +235,9 @@ OperationResult RunOneReadRow(bigtable::Table& table, std::string row_key) {
 
 google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
     bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
-    std::string const& table_id, std::chrono::seconds test_duration) {
+    std::string const& table_id, std::chrono::seconds test_duration,
+    IntervalLatencyReporter& apply_reporter,
+    IntervalLatencyReporter& read_reporter) {
   LatencyBenchmarkResult result = {};
 
   auto data_client = benchmark.MakeDataClient();
@@ -236,15 +258,15 @@ google::cloud::StatusOr<LatencyBenchmarkResult> RunBenchmark(
       if (!op_result.status.ok()) {
         return op_result.status;
       }
-      result.apply_results.operations.emplace_back(op_result);
-      ++result.apply_results.row_count;
+      result.apply_histogram.Record(op_result.status, op_result.latency);
+      apply_reporter.Record(op_result.status, op_result.latency);
     } else {
       auto op_result = RunOneReadRow(table, row_key);
       if (!op_result.status.ok()) {
         return op_result.status;
       }
-      result.read_results.operations.emplace_back(op_result);
-      ++result.read_results.row_count;
+      result.read_histogram.Record(op_result.status, op_result.latency);
+      read_reporter.Record(op_result.status, op_result.latency);
     }
     if (now >= mark) {
       std::cout << "." << std::flush;
@@ -0,0 +1,336 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <sstream>
+
+/**
+ * @file
+ *
+ * Measure the throughput ceiling of the asynchronous APIs:
+ * `bigtable::Table::AsyncBulkApply()` and `bigtable::Table::AsyncReadRows()`.
+ *
+ * This benchmark measures how many asynchronous operations the client can
+ * sustain when many requests are kept in flight, and how much client CPU
+ * each operation costs. The benchmark:
+ *
+ * - Creates a table with 10,000,000 rows, each row with a single column
+ *   family. The column family contains 10 columns, each column filled with
+ *   a random 100 byte string.
+ * - The name of the table starts with `async`, followed by random
+ *   characters. If there is a collision on the table name the benchmark
+ *   aborts immediately.
+ * - The benchmark populates the table during an initial phase and reports
+ *   the throughput of this bulk upload phase.
+ *
+ * After successfully uploading the initial data, the benchmark runs two
+ * phases, each for S seconds, serviced by T threads running a shared
+ * `CompletionQueue` event loop:
+ *
+ * - The `AsyncBulkApply()` flood: keep T * P `AsyncBulkApply()` requests in
+ *   flight, each request mutating 1,000 random rows. When a request
+ *   completes, record its latency and start another one.
+ * - The `AsyncReadRows()` scans: keep T * P asynchronous scans in flight,
+ *   each scan reading 1,000 rows starting at a random key. When a scan
+ *   completes, record its latency and start another one.
+ *
+ * The benchmark measures the process CPU time around each phase and
+ * reports, in addition to the usual latency results, the client CPU cost
+ * per operation and per row. The test then:
+ *
+ * - Reports the results, including p0 (minimum), p50, p90, p95, p99, p99.9,
+ *   and p100 (maximum) latencies.
+ * - Deletes the table.
+ * - Reports the same results in CSV format to make analysis easier.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local gRPC server that implements the Cloud Bigtable APIs used by the
+ * benchmark.  If this parameter is not used the benchmark uses the default
+ * configuration, that is, a production instance of Cloud Bigtable unless the
+ * CLOUD_BIGTABLE_EMULATOR environment variable is set.
+ */
+
+/// Helper functions and types for the async_throughput_benchmark.
+namespace {
+
+namespace bigtable = google::cloud::bigtable;
+using bigtable::benchmarks::Benchmark;
+using bigtable::benchmarks::BenchmarkResult;
+using bigtable::benchmarks::FormatDuration;
+using bigtable::benchmarks::kBulkSize;
+using bigtable::benchmarks::kColumnFamily;
+using bigtable::benchmarks::kNumFields;
+using bigtable::benchmarks::MakeBenchmarkSetup;
+using bigtable::benchmarks::MakeRandomMutation;
+
+/// The number of rows read by each asynchronous scan.
+constexpr std::int64_t kScanRowsLimit = 1000;
+
+/**
+ * The CPU time consumed by the process, across all its threads.
+ *
+ * `std::clock()` measures processor time, not wall-clock time, which is
+ * what we want: the benchmark reports the client-side CPU cost of each
+ * asynchronous operation.
+ */
+std::chrono::microseconds ProcessCpuTime() {
+  auto const seconds =
+      static_cast<double>(std::clock()) / static_cast<double>(CLOCKS_PER_SEC);
+  return std::chrono::microseconds(
+      static_cast<std::chrono::microseconds::rep>(seconds * 1000000.0));
+}
+
+/// Print the client CPU cost of a phase.
+void PrintCpuCost(std::ostream& os, std::string const& operation,
+                  std::chrono::microseconds cpu,
+                  BenchmarkResult const& result) {
+  if (result.operations.empty() || result.row_count == 0) {
+    return;
+  }
+  os << "# " << operation << " client CPU: " << FormatDuration(cpu)
+     << " total, "
+     << static_cast<double>(cpu.count()) /
+            static_cast<double>(result.operations.size())
+     << " us/op, "
+     << static_cast<double>(cpu.count()) /
+            static_cast<double>(result.row_count)
+     << " us/row\n";
+}
+
+/**
+ * Run the asynchronous phases of the benchmark.
+ *
+ * Both phases follow the same pattern: keep a fixed number of asynchronous
+ * operations in flight, starting a new one whenever one completes, until
+ * the deadline passes and the last operation drains.
+ */
+class AsyncThroughputBenchmark {
+ public:
+  AsyncThroughputBenchmark(bigtable::benchmarks::Benchmark& benchmark,
+                           std::string const& app_profile_id,
+                           std::string const& table_id, int cq_thread_count)
+      : benchmark_(benchmark),
+        table_(benchmark_.MakeDataClient(), app_profile_id, table_id),
+        generator_(std::random_device{}()) {
+    for (int i = 0; i != cq_thread_count; ++i) {
+      cq_threads_.emplace_back([this] { cq_.Run(); });
+    }
+  }
+
+  ~AsyncThroughputBenchmark() {
+    cq_.Shutdown();
+    for (auto& t : cq_threads_) {
+      t.join();
+    }
+  }
+
+  /// Run the `AsyncBulkApply()` flood phase.
+  BenchmarkResult RunBulkApplyFlood(std::chrono::seconds test_duration,
+                                    int request_count) {
+    return RunPhase([this] { StartOneBulkApply(); }, test_duration,
+                    request_count);
+  }
+
+  /// Run the `AsyncReadRows()` scan phase.
+  BenchmarkResult RunScans(std::chrono::seconds test_duration,
+                           int request_count) {
+    return RunPhase([this] { StartOneScan(); }, test_duration, request_count);
+  }
+
+ private:
+  BenchmarkResult RunPhase(std::function<void()> launch,
+                           std::chrono::seconds test_duration,
+                           int request_count) {
+    auto const start = std::chrono::steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      results_ = BenchmarkResult{};
+      launch_ = std::move(launch);
+      deadline_ = start + test_duration;
+    }
+    for (int i = 0; i != request_count; ++i) {
+      launch_();
+    }
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return outstanding_requests_ == 0; });
+    results_.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return std::move(results_);
+  }
+
+  void StartOneBulkApply() {
+    using google::cloud::future;
+    bigtable::BulkMutation bulk;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      ++outstanding_requests_;
+      for (long i = 0; i != kBulkSize; ++i) {  // NOLINT(google-runtime-int)
+        bigtable::SingleRowMutation mutation(
+            benchmark_.MakeRandomKey(generator_));
+        for (int f = 0; f != kNumFields; ++f) {
+          mutation.emplace_back(MakeRandomMutation(generator_, f));
+        }
+        bulk.emplace_back(std::move(mutation));
+      }
+    }
+    auto request_start = std::chrono::steady_clock::now();
+    table_.AsyncBulkApply(std::move(bulk), cq_)
+        .then([this, request_start](
+                  future<std::vector<bigtable::FailedMutation>> f) {
+          auto failures = f.get();
+          auto status = failures.empty() ? google::cloud::Status()
+                                         : failures.front().status();
+          OnOperationDone(
+              request_start, std::move(status),
+              kBulkSize - static_cast<long>(  // NOLINT(google-runtime-int)
+                              failures.size()));
+        });
+  }
+
+  void StartOneScan() {
+    auto row_key = [this] {
+      std::lock_guard<std::mutex> lk(mu_);
+      ++outstanding_requests_;
+      return benchmark_.MakeRandomKey(generator_);
+    }();
+    auto request_start = std::chrono::steady_clock::now();
+    table_.AsyncReadRows(
+        cq_,
+        [this](bigtable::Row const&) {
+          {
+            std::lock_guard<std::mutex> lk(mu_);
+            ++results_.row_count;
+          }
+          return google::cloud::make_ready_future(true);
+        },
+        [this, request_start](google::cloud::Status const& status) {
+          // The rows are counted as they arrive, only the operation itself
+          // needs recording here.
+          OnOperationDone(request_start, status, 0);
+        },
+        bigtable::RowSet(bigtable::RowRange::StartingAt(std::move(row_key))),
+        kScanRowsLimit,
+        bigtable::Filter::ColumnRangeClosed(kColumnFamily, "field0",
+                                            "field9"));
+  }
+
+  void OnOperationDone(std::chrono::steady_clock::time_point request_start,
+                       google::cloud::Status status,
+                       long row_count) {  // NOLINT(google-runtime-int)
+    auto now = std::chrono::steady_clock::now();
+    auto usecs = std::chrono::duration_cast<std::chrono::microseconds>(
+        now - request_start);
+
+    std::unique_lock<std::mutex> lk(mu_);
+    --outstanding_requests_;
+    results_.operations.push_back({std::move(status), usecs});
+    results_.row_count += row_count;
+    if (now < deadline_) {
+      lk.unlock();
+      launch_();
+      return;
+    }
+    if (outstanding_requests_ == 0) {
+      cv_.notify_all();
+    }
+  }
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  google::cloud::CompletionQueue cq_;
+  std::vector<std::thread> cq_threads_;
+  bigtable::benchmarks::Benchmark& benchmark_;
+  bigtable::Table table_;
+  google::cloud::internal::DefaultPRNG generator_;
+  std::function<void()> launch_;
+  int outstanding_requests_ = 0;
+  BenchmarkResult results_;
+  std::chrono::steady_clock::time_point deadline_;
+};
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  auto setup = MakeBenchmarkSetup("async", argc, argv);
+  if (!setup) {
+    std::cerr << setup.status() << "\n";
+    return -1;
+  }
+
+  Benchmark benchmark(*setup);
+
+  // Create and populate the table for the benchmark.
+  benchmark.CreateTable();
+  auto populate_results = benchmark.PopulateTable();
+  if (!populate_results) {
+    std::cerr << populate_results.status() << "\n";
+    return 1;
+  }
+  Benchmark::PrintThroughputResult(std::cout, "async", "Upload",
+                                   *populate_results);
+
+  AsyncThroughputBenchmark async_benchmark(
+      benchmark, setup->app_profile_id(), setup->table_id(),
+      setup->thread_count());
+  auto const request_count = setup->thread_count() * setup->parallel_requests();
+
+  std::cout << "# Running AsyncBulkApply() Throughput Benchmark\n";
+  auto cpu_start = ProcessCpuTime();
+  auto bulk_apply_results =
+      async_benchmark.RunBulkApplyFlood(setup->test_duration(), request_count);
+  auto const bulk_apply_cpu = ProcessCpuTime() - cpu_start;
+  std::cout << "# DONE. Elapsed=" << FormatDuration(bulk_apply_results.elapsed)
+            << ", Ops=" << bulk_apply_results.operations.size()
+            << ", Rows=" << bulk_apply_results.row_count << "\n";
+
+  std::cout << "# Running AsyncReadRows() Throughput Benchmark\n";
+  cpu_start = ProcessCpuTime();
+  auto scan_results =
+      async_benchmark.RunScans(setup->test_duration(), request_count);
+  auto const scan_cpu = ProcessCpuTime() - cpu_start;
+  std::cout << "# DONE. Elapsed=" << FormatDuration(scan_results.elapsed)
+            << ", Ops=" << scan_results.operations.size()
+            << ", Rows=" << scan_results.row_count << "\n";
+
+  Benchmark::PrintLatencyResult(std::cout, "async", "AsyncBulkApply()",
+                                bulk_apply_results);
+  Benchmark::PrintLatencyResult(std::cout, "async", "AsyncReadRows()",
+                                scan_results);
+  PrintCpuCost(std::cout, "AsyncBulkApply()", bulk_apply_cpu,
+               bulk_apply_results);
+  PrintCpuCost(std::cout, "AsyncReadRows()", scan_cpu, scan_results);
+
+  std::cout << bigtable::benchmarks::Benchmark::ResultsCsvHeader() << "\n";
+  benchmark.PrintResultCsv(std::cout, "async", "BulkApply()", "Latency",
+                           *populate_results);
+  benchmark.PrintResultCsv(std::cout, "async", "AsyncBulkApply()", "Latency",
+                           bulk_apply_results);
+  benchmark.PrintResultCsv(std::cout, "async", "AsyncReadRows()", "Latency",
+                           scan_results);
+  benchmark.PrintResultJson(std::cout, "async", "BulkApply()", "Latency",
+                            *populate_results);
+  benchmark.PrintResultJson(std::cout, "async", "AsyncBulkApply()", "Latency",
+                            bulk_apply_results);
+  benchmark.PrintResultJson(std::cout, "async", "AsyncReadRows()", "Latency",
+                            scan_results);
+
+  benchmark.DeleteTable();
+  return 0;
+}
@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
 #include "google/cloud/bigtable/benchmarks/random_mutation.h"
 #include "google/cloud/bigtable/table_admin.h"
+#include "google/cloud/testing_util/benchmark_result.h"
 #include <future>
 #include <iomanip>
 #include <sstream>
@@ -184,6 +185,28 @@ void Benchmark::PrintLatencyResult(std::ostream& os,
   os << "\n";
 }
 
+void Benchmark::PrintLatencyResult(std::ostream& os,
+                                   std::string const& test_name,
+                                   std::string const& operation,
+                                   LatencyHistogram const& histogram,
+                                   std::chrono::milliseconds elapsed) {
+  if (histogram.count() == 0) {
+    os << "# Test=" << test_name << ", " << operation << " no results\n";
+    return;
+  }
+  auto ops_throughput = 1000 * histogram.count() /
+                        static_cast<std::uint64_t>(elapsed.count());
+  os << "# Test=" << test_name << ", " << operation
+     << " Throughput = " << ops_throughput << " ops/s, Latency: ";
+  char const* sep = "";
+  for (double p : kResultPercentiles) {
+    os << sep << "p" << std::setprecision(3) << p << "=" << std::setprecision(2)
+       << FormatDuration(histogram.Percentile(p));
+    sep = ", ";
+  }
+  os << "\n";
+}
+
 std::string Benchmark::ResultsCsvHeader() {
   return "name,start,op.name,measurement,nsamples,min,p50,p90,p95,p99,p99.9,max"
          ",units,throughput.rows,throughput.ops,notes";
@@ -219,6 +242,108 @@ void Benchmark::PrintResultCsv(std::ostream& os, std::string const& test_name,
      << setup_.notes() << "\n";
 }
 
+void Benchmark::PrintResultJson(std::ostream& os,
+                                std::string const& test_name,
+                                std::string const& op_name,
+                                std::string const& measurement,
+                                BenchmarkResult const& result) const {
+  testing_util::BenchmarkResult r;
+  r.benchmark = test_name + "/" + op_name + "/" + measurement;
+  r.unit = "us";
+  r.environment = testing_util::BenchmarkEnvironment();
+  r.environment["start"] = setup_.start_time();
+  r.environment["notes"] = setup_.notes();
+  r.samples.reserve(result.operations.size());
+  for (auto const& op : result.operations) {
+    if (!op.status.ok()) continue;
+    r.samples.push_back(static_cast<double>(op.latency.count()));
+  }
+  if (result.elapsed.count() != 0) {
+    r.throughput = 1000.0 * static_cast<double>(result.row_count) /
+                   static_cast<double>(result.elapsed.count());
+  }
+  os << testing_util::FormatBenchmarkResultAsJson(r) << "\n";
+}
+
+std::string Benchmark::HistogramCsvHeader() {
+  return "name,start,op.name,measurement,nsamples,errors,min,p50,p90,p95,p99"
+         ",p99.9,max,units,notes";
+}
+
+void Benchmark::PrintHistogramCsv(std::ostream& os,
+                                  std::string const& test_name,
+                                  std::string const& op_name,
+                                  std::string const& measurement,
+                                  LatencyHistogram const& histogram) const {
+  if (histogram.count() == 0) {
+    os << "# Test=" << test_name << ", " << op_name << " no results\n";
+    return;
+  }
+  os << test_name << "," << setup_.start_time() << "," << op_name << ","
+     << measurement << "," << histogram.count() << ","
+     << histogram.error_count();
+  for (double p : kResultPercentiles) {
+    os << "," << histogram.Percentile(p).count();
+  }
+  os << ",us," << setup_.notes() << "\n";
+}
+
+void Benchmark::PrintHistogramJson(std::ostream& os,
+                                   std::string const& test_name,
+                                   std::string const& op_name,
+                                   std::string const& measurement,
+                                   LatencyHistogram const& histogram) const {
+  if (histogram.count() == 0) {
+    os << "# Test=" << test_name << ", " << op_name << " no results\n";
+    return;
+  }
+  os << R"({"name":")" << test_name << R"(","start":")" << setup_.start_time()
+     << R"(","op.name":")" << op_name << R"(","measurement":")" << measurement
+     << R"(","nsamples":)" << histogram.count()  //
+     << R"(,"errors":)" << histogram.error_count()
+     << R"(,"min":)" << histogram.min().count();
+  for (double p : kResultPercentiles) {
+    if (p == 0 || p == 100) {
+      continue;
+    }
+    os << R"(,"p)" << p << R"(":)" << histogram.Percentile(p).count();
+  }
+  os << R"(,"max":)" << histogram.max().count()  //
+     << R"(,"units":"us","notes":")" << setup_.notes() << "\"}\n";
+}
+
+LatencyHistogram MakeLatencyHistogram(BenchmarkResult const& result) {
+  LatencyHistogram histogram;
+  for (auto const& op : result.operations) {
+    histogram.Record(op.status, op.latency);
+  }
+  return histogram;
+}
+
+IntervalLatencyReporter::IntervalLatencyReporter(std::ostream& os,
+                                                 std::string operation,
+                                                 std::chrono::seconds interval)
+    : os_(os),
+      operation_(std::move(operation)),
+      interval_(interval),
+      next_report_(std::chrono::steady_clock::now() + interval_) {}
+
+void IntervalLatencyReporter::Record(google::cloud::Status const& status,
+                                     std::chrono::microseconds latency) {
+  std::lock_guard<std::mutex> lk(mu_);
+  current_.Record(status, latency);
+  auto const now = std::chrono::steady_clock::now();
+  if (now < next_report_) return;
+  os_ << "# interval " << operation_ << " count=" << current_.count()
+      << " errors=" << current_.error_count()
+      << " p50=" << FormatDuration(current_.Percentile(50))
+      << " p99=" << FormatDuration(current_.Percentile(99))
+      << " p99.9=" << FormatDuration(current_.Percentile(99.9))
+      << " max=" << FormatDuration(current_.max()) << "\n";
+  current_ = LatencyHistogram();
+  next_report_ = now + interval_;
+}
+
 int Benchmark::create_table_count() const {
   if (!server_) {
     return 0;
@@ -16,12 +16,14 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_BENCHMARK_H
 
 #include "google/cloud/bigtable/benchmarks/embedded_server.h"
+#include "google/cloud/bigtable/benchmarks/latency_histogram.h"
 #include "google/cloud/bigtable/benchmarks/setup.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/internal/random.h"
 #include "google/cloud/status_or.h"
 #include <chrono>
 #include <deque>
+#include <mutex>
 #include <thread>
 
 namespace google {
@@ -91,6 +93,13 @@ class Benchmark {
                                  std::string const& operation,
                                  BenchmarkResult& result);
 
+  /// Print the result of a latency test accumulated in a streaming
+  /// histogram, in human readable form.
+  static void PrintLatencyResult(std::ostream& os, std::string const& test_name,
+                                 std::string const& operation,
+                                 LatencyHistogram const& histogram,
+                                 std::chrono::milliseconds elapsed);
+
   /// Return the header for CSV results.
   static std::string ResultsCsvHeader();
 
@@ -100,6 +109,28 @@ class Benchmark {
                       std::string const& measurement,
                       BenchmarkResult& result) const;
 
+  /// Print the result of a benchmark as a single JSON line in the shared
+  /// `testing_util::BenchmarkResult` schema, for the regression harness.
+  void PrintResultJson(std::ostream& os, std::string const& test_name,
+                       std::string const& op_name,
+                       std::string const& measurement,
+                       BenchmarkResult const& result) const;
+
+  /// Return the header for histogram CSV results.
+  static std::string HistogramCsvHeader();
+
+  /// Print a latency histogram as a CSV line.
+  void PrintHistogramCsv(std::ostream& os, std::string const& test_name,
+                         std::string const& op_name,
+                         std::string const& measurement,
+                         LatencyHistogram const& histogram) const;
+
+  /// Print a latency histogram as a single-line JSON object.
+  void PrintHistogramJson(std::ostream& os, std::string const& test_name,
+                          std::string const& op_name,
+                          std::string const& measurement,
+                          LatencyHistogram const& histogram) const;
+
   //@{
   /**
    * @name Embedded server counter accessors.
@@ -137,6 +168,38 @@ class Benchmark {
   std::thread server_thread_;
 };
 
+/// Aggregate the operations in @p result into a latency histogram.
+LatencyHistogram MakeLatencyHistogram(BenchmarkResult const& result);
+
+/**
+ * Record latencies from all the threads of a benchmark and periodically
+ * print the percentiles of the current interval.
+ *
+ * The final report aggregates the whole run, which averages away transient
+ * artifacts: channel refreshes, server-side maintenance, and similar events
+ * only show up in the tail of the interval where they happened. This class
+ * prints a snapshot (as a `#` comment line) every @p interval and then
+ * starts a new histogram, so long runs show the evolution of p99 and p99.9
+ * over time while using constant memory.
+ */
+class IntervalLatencyReporter {
+ public:
+  IntervalLatencyReporter(std::ostream& os, std::string operation,
+                          std::chrono::seconds interval);
+
+  /// Record one sample, printing a snapshot when the interval expires.
+  void Record(google::cloud::Status const& status,
+              std::chrono::microseconds latency);
+
+ private:
+  std::ostream& os_;
+  std::string operation_;
+  std::chrono::steady_clock::duration interval_;
+  std::mutex mu_;
+  std::chrono::steady_clock::time_point next_report_;  // GUARDED_BY(mu_)
+  LatencyHistogram current_;                           // GUARDED_BY(mu_)
+};
+
 /// Helper class to pretty print durations.
 struct FormatDuration {
   template <typename Rep, typename Period>
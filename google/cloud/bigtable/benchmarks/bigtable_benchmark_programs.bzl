@@ -18,7 +18,9 @@
 
 bigtable_benchmark_programs = [
     "apply_read_latency_benchmark.cc",
+    "async_throughput_benchmark.cc",
     "endurance_benchmark.cc",
+    "parser_decode_benchmark.cc",
     "read_sync_vs_async_benchmark.cc",
     "scan_throughput_benchmark.cc",
 ]
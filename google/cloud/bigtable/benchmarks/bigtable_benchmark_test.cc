@@ -19,7 +19,9 @@
 
 using ::google::cloud::bigtable::benchmarks::Benchmark;
 using ::google::cloud::bigtable::benchmarks::BenchmarkResult;
+using ::google::cloud::bigtable::benchmarks::IntervalLatencyReporter;
 using ::google::cloud::bigtable::benchmarks::kBulkSize;
+using ::google::cloud::bigtable::benchmarks::LatencyHistogram;
 using ::google::cloud::bigtable::benchmarks::MakeBenchmarkSetup;
 using ::google::cloud::bigtable::benchmarks::OperationResult;
 using ::testing::HasSubstr;
@@ -161,6 +163,47 @@ TEST(BenchmarkTest, PrintLatencyResult) {
   EXPECT_THAT(output, HasSubstr("p100=10.000ms"));
 }
 
+TEST(BenchmarkTest, PrintLatencyResultHistogram) {
+  LatencyHistogram histogram;
+  for (int count = 0; count != 100; ++count) {
+    histogram.Record(google::cloud::Status{},
+                     std::chrono::microseconds((count + 1) * 100));
+  }
+
+  std::ostringstream os;
+  Benchmark::PrintLatencyResult(os, "foo", "bar", histogram,
+                                std::chrono::milliseconds(1000));
+  std::string output = os.str();
+
+  // We do not want a change detector test, so the following assertions are
+  // fairly minimal.
+
+  // The output includes "XX ops/s" where XX is the operations count.
+  EXPECT_THAT(output, HasSubstr("100 ops/s"));
+
+  // The minimum and maximum are exact even in the histogram.
+  EXPECT_THAT(output, HasSubstr("p0=100.000us"));
+  EXPECT_THAT(output, HasSubstr("p100=10.000ms"));
+}
+
+TEST(BenchmarkTest, IntervalLatencyReporter) {
+  std::ostringstream os;
+  // With a zero interval every sample prints a snapshot.
+  IntervalLatencyReporter reporter(os, "Op()", std::chrono::seconds(0));
+  reporter.Record(google::cloud::Status{}, std::chrono::microseconds(100));
+  std::string output = os.str();
+
+  EXPECT_THAT(output, HasSubstr("# interval Op()"));
+  EXPECT_THAT(output, HasSubstr("count=1"));
+  EXPECT_THAT(output, HasSubstr("errors=0"));
+  EXPECT_THAT(output, HasSubstr("p99.9="));
+
+  // The snapshot resets the interval histogram.
+  os.str("");
+  reporter.Record(google::cloud::Status{}, std::chrono::microseconds(200));
+  EXPECT_THAT(os.str(), HasSubstr("count=1"));
+}
+
 TEST(BenchmarkTest, PrintCsv) {
   char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7};
   int argc = sizeof(argv) / sizeof(argv[0]);
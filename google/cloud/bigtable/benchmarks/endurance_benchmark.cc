@@ -13,10 +13,13 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/benchmarks/memory_sampler.h"
 #include "google/cloud/bigtable/benchmarks/random_mutation.h"
+#include <atomic>
 #include <future>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 /**
  * @file
@@ -59,14 +62,16 @@ namespace bigtable = google::cloud::bigtable;
 using bigtable::benchmarks::Benchmark;
 using bigtable::benchmarks::BenchmarkResult;
 using bigtable::benchmarks::FormatDuration;
+using bigtable::benchmarks::LatencyHistogram;
 using bigtable::benchmarks::kColumnFamily;
 using bigtable::benchmarks::kNumFields;
 using bigtable::benchmarks::MakeBenchmarkSetup;
 using bigtable::benchmarks::MakeRandomMutation;
+using bigtable::benchmarks::MemorySampler;
 using bigtable::benchmarks::OperationResult;
 
-/// Run an iteration of the test, returns the number of operations.
-google::cloud::StatusOr<long> RunBenchmark(  // NOLINT(google-runtime-int)
+/// Run an iteration of the test, returns the latency histogram.
+google::cloud::StatusOr<LatencyHistogram> RunBenchmark(
     bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
     std::string const& table_id, std::chrono::seconds test_duration);
 
@@ -80,14 +85,39 @@ int main(int argc, char* argv[]) {
   }
 
   Benchmark benchmark(*setup);
+
+  // Sample the process memory during the run; a multi-hour session is long
+  // enough for a slow leak to show up as a non-zero growth trend.
+  MemorySampler memory_sampler;
+  auto const program_start = std::chrono::steady_clock::now();
+  auto elapsed_ms = [program_start] {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - program_start);
+  };
+  memory_sampler.Sample(elapsed_ms());
+
   // Create and populate the table for the benchmark.
   benchmark.CreateTable();
+  // The setup is a distinct allocation phase, bracket it with samples so
+  // its cost does not pollute the steady-state trend.
+  memory_sampler.Sample(elapsed_ms());
+
+  std::atomic<bool> sampling_done(false);
+  std::thread memory_sampler_thread(
+      [&memory_sampler, &sampling_done, &elapsed_ms] {
+        while (!sampling_done.load()) {
+          memory_sampler.Sample(elapsed_ms());
+          // Check for shutdown more often than we sample.
+          for (int i = 0; i != 10 && !sampling_done.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+          }
+        }
+      });
 
   // Start the threads running the latency test.
   std::cout << "# Running Endurance Benchmark:\n";
   auto latency_test_start = std::chrono::steady_clock::now();
-  // NOLINTNEXTLINE(google-runtime-int)
-  std::vector<std::future<google::cloud::StatusOr<long>>> tasks;
+  std::vector<std::future<google::cloud::StatusOr<LatencyHistogram>>> tasks;
   for (int i = 0; i != setup->thread_count(); ++i) {
     auto launch_policy = std::launch::async;
     if (setup->thread_count() == 1) {
@@ -99,8 +129,10 @@ int main(int argc, char* argv[]) {
                                   setup->table_id(), setup->test_duration()));
   }
 
-  // Wait for the threads and combine all the results.
-  long combined = 0;  // NOLINT(google-runtime-int)
+  // Wait for the threads and combine all the results. The full run has far
+  // too many samples to sort, merging the per-thread histograms makes a
+  // combined latency report affordable.
+  LatencyHistogram combined;
   int count = 0;
   for (auto& future : tasks) {
     auto result = future.get();
@@ -108,16 +140,45 @@ int main(int argc, char* argv[]) {
       std::cerr << "Error returned by task[" << count
                 << "]: " << result.status() << "\n";
     } else {
-      combined += *result;
+      combined.Merge(*result);
     }
     ++count;
   }
   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - latency_test_start);
-  auto throughput = 1000.0 * static_cast<double>(combined) / elapsed.count();
+  auto throughput =
+      1000.0 * static_cast<double>(combined.count()) / elapsed.count();
   std::cout << "# DONE. Elapsed=" << FormatDuration(elapsed)
-            << ", Ops=" << combined << ", Throughput: " << throughput
+            << ", Ops=" << combined.count() << ", Throughput: " << throughput
             << " ops/sec\n";
+  if (combined.count() != 0) {
+    std::cout << Benchmark::HistogramCsvHeader() << "\n";
+    benchmark.PrintHistogramCsv(std::cout, "long", "Op", "Latency", combined);
+    benchmark.PrintHistogramJson(std::cout, "long", "Op", "Latency", combined);
+  }
+
+  sampling_done.store(true);
+  memory_sampler_thread.join();
+  memory_sampler.Sample(elapsed_ms());
+  auto const memory_samples = memory_sampler.Samples();
+  if (memory_samples.size() >= 2) {
+    // The second sample was taken right after the table was populated, the
+    // difference against the first is the cost of the setup phase.
+    std::cout << "# Memory setup phase: rss +"
+              << (memory_samples[1].rss_bytes - memory_samples[0].rss_bytes)
+              << " bytes, heap +"
+              << (memory_samples[1].heap_bytes - memory_samples[0].heap_bytes)
+              << " bytes\n";
+    auto const& last = memory_samples.back();
+    std::cout << "# Memory at end: rss=" << last.rss_bytes
+              << " bytes, heap=" << last.heap_bytes << " bytes\n";
+    std::cout << "# Memory growth trend: rss="
+              << memory_sampler.RssGrowthBytesPerSecond()
+              << " bytes/sec, heap="
+              << memory_sampler.HeapGrowthBytesPerSecond() << " bytes/sec\n";
+  }
+  std::cout << MemorySampler::CsvHeader() << "\n";
+  memory_sampler.PrintCsv(std::cout, "long");
 
   benchmark.DeleteTable();
   return 0;
@@ -151,7 +212,7 @@ OperationResult RunOneReadRow(bigtable::Table& table,
   return Benchmark::TimeOperation(std::move(op));
 }
 
-google::cloud::StatusOr<long> RunBenchmark(  // NOLINT(google-runtime-int)
+google::cloud::StatusOr<LatencyHistogram> RunBenchmark(
     bigtable::benchmarks::Benchmark& benchmark, std::string app_profile_id,
     std::string const& table_id, std::chrono::seconds test_duration) {
   BenchmarkResult partial = {};
@@ -190,8 +251,7 @@ google::cloud::StatusOr<long> RunBenchmark(  // NOLINT(google-runtime-int)
   std::ostringstream msg;
   Benchmark::PrintLatencyResult(msg, "long", "Partial::Op", partial);
   std::cout << msg.str() << std::flush;
-  // NOLINTNEXTLINE(google-runtime-int)
-  return static_cast<long>(partial.operations.size());
+  return bigtable::benchmarks::MakeLatencyHistogram(partial);
 }
 
 }  // anonymous namespace
@@ -0,0 +1,117 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+namespace {
+
+// Each power of two is split into 2^kLog2SubBuckets linear sub-buckets.
+int constexpr kLog2SubBuckets = 4;
+std::int64_t constexpr kSubBuckets = 1 << kLog2SubBuckets;
+
+// Latencies are measured in microseconds and fit in 62 bits with room to
+// spare, this bounds the bucket count.
+std::size_t constexpr kBucketCount = (62 - kLog2SubBuckets + 1) * kSubBuckets;
+
+std::size_t BucketIndex(std::int64_t value) {
+  if (value < 0) {
+    return 0;
+  }
+  if (value < kSubBuckets) {
+    return static_cast<std::size_t>(value);
+  }
+  int log2 = 0;
+  for (auto v = value; v > 1; v >>= 1) {
+    ++log2;
+  }
+  auto const sub = (value >> (log2 - kLog2SubBuckets)) & (kSubBuckets - 1);
+  return static_cast<std::size_t>((log2 - kLog2SubBuckets + 1) * kSubBuckets +
+                                  sub);
+}
+
+/// The midpoint of the values mapped to the bucket at @p index.
+std::int64_t BucketMidpoint(std::size_t index) {
+  auto const i = static_cast<std::int64_t>(index);
+  auto const tier = i / kSubBuckets;
+  if (tier == 0) {
+    return i;
+  }
+  auto const log2 = tier + kLog2SubBuckets - 1;
+  auto const sub = i % kSubBuckets;
+  auto const width = std::int64_t(1) << (log2 - kLog2SubBuckets);
+  auto const lower = (std::int64_t(1) << log2) + sub * width;
+  return lower + width / 2;
+}
+
+}  // anonymous namespace
+
+LatencyHistogram::LatencyHistogram()
+    : buckets_(kBucketCount),
+      count_(0),
+      error_count_(0),
+      min_((std::numeric_limits<std::chrono::microseconds::rep>::max)()),
+      max_(0) {}
+
+void LatencyHistogram::Record(std::chrono::microseconds latency) {
+  ++buckets_[BucketIndex(latency.count())];
+  ++count_;
+  min_ = (std::min)(min_, latency);
+  max_ = (std::max)(max_, latency);
+}
+
+void LatencyHistogram::Merge(LatencyHistogram const& other) {
+  for (std::size_t i = 0; i != buckets_.size(); ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  error_count_ += other.error_count_;
+  min_ = (std::min)(min_, other.min_);
+  max_ = (std::max)(max_, other.max_);
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(
+    double percentile) const {
+  // The same convention as the sorted-sample reports: the percentile is the
+  // sample at the (rounded) scaled rank.
+  auto const rank = static_cast<std::uint64_t>(
+      std::round(static_cast<double>(count_ - 1) * percentile / 100.0));
+  // The extreme ranks are tracked exactly, do not approximate them.
+  if (rank == 0) {
+    return min_;
+  }
+  if (rank >= count_ - 1) {
+    return max_;
+  }
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i != buckets_.size(); ++i) {
+    seen += buckets_[i];
+    if (seen > rank) {
+      auto const value = std::chrono::microseconds(BucketMidpoint(i));
+      return (std::min)((std::max)(value, min_), max_);
+    }
+  }
+  return max_;
+}
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
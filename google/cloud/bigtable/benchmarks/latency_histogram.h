@@ -0,0 +1,90 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_LATENCY_HISTOGRAM_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_LATENCY_HISTOGRAM_H
+
+#include "google/cloud/status.h"
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+namespace benchmarks {
+/**
+ * A streaming histogram of operation latencies.
+ *
+ * The reports computed their percentiles by sorting all the samples, which
+ * requires keeping (and shuffling) every sample. This class instead counts
+ * samples in fixed, log-scale buckets: each power of two is divided into 16
+ * linear sub-buckets, so any percentile is off by at most ~6% of its value,
+ * which is far below the run-to-run noise of the benchmarks. Recording is
+ * O(1), histograms from different threads (or operation types) can be
+ * merged, and the memory footprint is constant.
+ */
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  /// Record one sample.
+  void Record(std::chrono::microseconds latency);
+
+  /// Record one sample and keep track of failed operations.
+  void Record(google::cloud::Status const& status,
+              std::chrono::microseconds latency) {
+    if (!status.ok()) {
+      ++error_count_;
+    }
+    Record(latency);
+  }
+
+  /// Add all the samples in @p other to this histogram.
+  void Merge(LatencyHistogram const& other);
+
+  /// The number of samples recorded.
+  std::uint64_t count() const { return count_; }
+
+  /// The number of samples recorded with a failing status.
+  std::uint64_t error_count() const { return error_count_; }
+
+  /// The smallest sample, exact.
+  std::chrono::microseconds min() const { return min_; }
+
+  /// The largest sample, exact.
+  std::chrono::microseconds max() const { return max_; }
+
+  /**
+   * Estimate the @p percentile (in the [0, 100] range) of the samples.
+   *
+   * Returns the midpoint of the bucket holding the percentile, clamped to
+   * the exact minimum and maximum. The histogram must not be empty.
+   */
+  std::chrono::microseconds Percentile(double percentile) const;
+
+ private:
+  std::vector<std::uint64_t> buckets_;
+  std::uint64_t count_;
+  std::uint64_t error_count_;
+  std::chrono::microseconds min_;
+  std::chrono::microseconds max_;
+};
+
+}  // namespace benchmarks
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_LATENCY_HISTOGRAM_H
@@ -0,0 +1,129 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/memory_sampler.h"
+#include <fstream>
+#if defined(__linux__)
+#include <unistd.h>
+#endif  // __linux__
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif  // __GLIBC__
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace benchmarks {
+namespace {
+
+std::int64_t CurrentRss() {
+#if defined(__linux__)
+  // The second field of /proc/self/statm is the resident set size in pages.
+  std::ifstream statm("/proc/self/statm");
+  std::int64_t size;
+  std::int64_t resident;
+  if (!(statm >> size >> resident)) {
+    return 0;
+  }
+  return resident * sysconf(_SC_PAGESIZE);
+#else
+  return 0;
+#endif  // __linux__
+}
+
+std::int64_t CurrentHeap() {
+#if defined(__GLIBC__)
+  // `mallinfo()` reports `int` fields, which wrap for heaps over 2GiB; the
+  // growth *trend* survives the wrap as long as samples are frequent
+  // relative to the allocation rate, which is all this benchmark needs.
+  auto const info = mallinfo();
+  return static_cast<std::int64_t>(info.uordblks) +
+         static_cast<std::int64_t>(info.hblkhd);
+#else
+  return 0;
+#endif  // __GLIBC__
+}
+
+/// The least-squares slope of (elapsed, value) in bytes per second.
+double Slope(std::vector<MemorySample> const& samples,
+             std::int64_t MemorySample::*field) {
+  if (samples.size() < 2) {
+    return 0;
+  }
+  double sx = 0;
+  double sy = 0;
+  double sxx = 0;
+  double sxy = 0;
+  for (auto const& s : samples) {
+    auto const x = static_cast<double>(s.elapsed.count()) / 1000.0;
+    auto const y = static_cast<double>(s.*field);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+  }
+  auto const n = static_cast<double>(samples.size());
+  auto const d = n * sxx - sx * sx;
+  if (d == 0) {
+    return 0;
+  }
+  return (n * sxy - sx * sy) / d;
+}
+
+}  // anonymous namespace
+
+MemorySample CaptureMemorySample(std::chrono::milliseconds elapsed) {
+  return MemorySample{elapsed, CurrentRss(), CurrentHeap()};
+}
+
+void MemorySampler::Sample(std::chrono::milliseconds elapsed) {
+  Record(CaptureMemorySample(elapsed));
+}
+
+void MemorySampler::Record(MemorySample sample) {
+  std::lock_guard<std::mutex> lk(mu_);
+  samples_.push_back(sample);
+}
+
+std::vector<MemorySample> MemorySampler::Samples() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return samples_;
+}
+
+double MemorySampler::RssGrowthBytesPerSecond() const {
+  return Slope(Samples(), &MemorySample::rss_bytes);
+}
+
+double MemorySampler::HeapGrowthBytesPerSecond() const {
+  return Slope(Samples(), &MemorySample::heap_bytes);
+}
+
+std::string MemorySampler::CsvHeader() {
+  return "name,measurement,elapsed_ms,rss_bytes,heap_bytes";
+}
+
+void MemorySampler::PrintCsv(std::ostream& os,
+                             std::string const& test_name) const {
+  for (auto const& s : Samples()) {
+    os << test_name << ",Memory," << s.elapsed.count() << "," << s.rss_bytes
+       << "," << s.heap_bytes << "\n";
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
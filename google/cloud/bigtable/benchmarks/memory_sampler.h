@@ -0,0 +1,92 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_MEMORY_SAMPLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_MEMORY_SAMPLER_H
+
+#include "google/cloud/bigtable/version.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace benchmarks {
+
+/// A point-in-time measurement of the process memory usage.
+struct MemorySample {
+  /// Time since the start of the benchmark.
+  std::chrono::milliseconds elapsed;
+  /// Resident set size, 0 if the platform provides no source for it.
+  std::int64_t rss_bytes;
+  /// Bytes in use by the allocator, 0 if the platform provides no source.
+  std::int64_t heap_bytes;
+};
+
+/// Measure the current memory usage of the process.
+MemorySample CaptureMemorySample(std::chrono::milliseconds elapsed);
+
+/**
+ * Accumulate memory samples over a benchmark run and report the trend.
+ *
+ * Long running benchmarks sample the process memory periodically; at the
+ * end of the run the growth rate — the least-squares slope of the samples —
+ * separates a process that reached a steady state from one that leaks
+ * slowly. A slow leak takes hours to be visible in absolute numbers, which
+ * is exactly what the endurance benchmark has.
+ *
+ * All member functions are thread-safe.
+ */
+class MemorySampler {
+ public:
+  MemorySampler() = default;
+
+  /// Capture and record a sample taken @p elapsed into the run.
+  void Sample(std::chrono::milliseconds elapsed);
+
+  /// Record an externally captured sample, mostly used in tests.
+  void Record(MemorySample sample);
+
+  /// Return a copy of the samples recorded so far.
+  std::vector<MemorySample> Samples() const;
+
+  /// The least-squares slope of RSS vs. time, in bytes per second.
+  double RssGrowthBytesPerSecond() const;
+
+  /// The least-squares slope of heap usage vs. time, in bytes per second.
+  double HeapGrowthBytesPerSecond() const;
+
+  /// The CSV header for `PrintCsv()`.
+  static std::string CsvHeader();
+
+  /// Print the samples in CSV format, one line per sample.
+  void PrintCsv(std::ostream& os, std::string const& test_name) const;
+
+ private:
+  mutable std::mutex mu_;
+  std::vector<MemorySample> samples_;
+};
+
+}  // namespace benchmarks
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_BENCHMARKS_MEMORY_SAMPLER_H
@@ -0,0 +1,63 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/memory_sampler.h"
+#include <gmock/gmock.h>
+
+using ::google::cloud::bigtable::benchmarks::MemorySample;
+using ::google::cloud::bigtable::benchmarks::MemorySampler;
+
+/// @test Verify that samples are recorded in order.
+TEST(MemorySamplerTest, RecordsSamples) {
+  MemorySampler sampler;
+  sampler.Record(MemorySample{std::chrono::milliseconds(0), 1000, 500});
+  sampler.Record(MemorySample{std::chrono::milliseconds(1000), 2000, 700});
+
+  auto samples = sampler.Samples();
+  ASSERT_EQ(2U, samples.size());
+  EXPECT_EQ(1000, samples[0].rss_bytes);
+  EXPECT_EQ(2000, samples[1].rss_bytes);
+}
+
+/// @test Verify the growth trend of a perfectly linear series.
+TEST(MemorySamplerTest, LinearGrowthTrend) {
+  MemorySampler sampler;
+  // RSS grows by 100 bytes per second, the heap is flat.
+  for (int i = 0; i != 10; ++i) {
+    sampler.Record(MemorySample{std::chrono::milliseconds(i * 1000),
+                                10000 + i * 100, 5000});
+  }
+  EXPECT_NEAR(100.0, sampler.RssGrowthBytesPerSecond(), 0.001);
+  EXPECT_NEAR(0.0, sampler.HeapGrowthBytesPerSecond(), 0.001);
+}
+
+/// @test Verify that too few samples yield a zero trend.
+TEST(MemorySamplerTest, TooFewSamples) {
+  MemorySampler sampler;
+  EXPECT_EQ(0.0, sampler.RssGrowthBytesPerSecond());
+  sampler.Record(MemorySample{std::chrono::milliseconds(0), 1000, 500});
+  EXPECT_EQ(0.0, sampler.RssGrowthBytesPerSecond());
+}
+
+/// @test Verify that capturing a sample works on this platform.
+TEST(MemorySamplerTest, CaptureSample) {
+  MemorySampler sampler;
+  sampler.Sample(std::chrono::milliseconds(0));
+  auto samples = sampler.Samples();
+  ASSERT_EQ(1U, samples.size());
+  // The values are 0 on platforms without a source for them, just verify
+  // nothing went negative.
+  EXPECT_LE(0, samples[0].rss_bytes);
+  EXPECT_LE(0, samples[0].heap_bytes);
+}
@@ -0,0 +1,236 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/benchmarks/benchmark.h"
+#include "google/cloud/bigtable/internal/readrowsparser.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the decode throughput of the ReadRows chunk parser.
+ *
+ * The other benchmarks in this directory measure the end-to-end cost of the
+ * API, against production or against the embedded server, where the gRPC
+ * stack dominates. Nothing isolates the client-side decode path, so parser
+ * regressions hide inside the noise of much larger numbers. This benchmark
+ * replays canned chunk streams directly through
+ * `bigtable::internal::ReadRowsParser` and reports cells and bytes decoded
+ * per second.
+ *
+ * The streams exercise the chunk shapes from the conformance tests, but at
+ * scale:
+ * - "point": one row per chunk, each with its own key, family, column and a
+ *   small value, as produced by point reads.
+ * - "wide": rows of 100 cells where the family and column are carried over
+ *   between chunks, as produced by scans of wide rows.
+ * - "large-cell": 16 KiB values split over 4 KiB chunks using the
+ *   `value_size` continuation, as produced by blob reads.
+ *
+ * The benchmark takes no flags except an optional duration (in seconds) per
+ * shape, it needs neither a Cloud Bigtable instance nor the embedded server.
+ */
+namespace {
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = ::google::bigtable::v2;
+using bigtable::benchmarks::FormatDuration;
+
+auto constexpr kDefaultTestDuration = std::chrono::seconds(5);
+int constexpr kPointRows = 100000;
+int constexpr kWideRows = 1000;
+int constexpr kCellsPerWideRow = 100;
+int constexpr kLargeCellRows = 1000;
+int constexpr kLargeCellSize = 16 * 1024;
+int constexpr kLargeCellChunkSize = 4 * 1024;
+
+/// A canned stream of chunks and the totals it decodes to.
+struct StreamShape {
+  std::string name;
+  std::vector<btproto::ReadRowsResponse_CellChunk> chunks;
+  std::size_t cell_count = 0;
+  std::size_t byte_count = 0;
+};
+
+/// The results of replaying one shape for the test duration.
+struct DecodeResult {
+  std::chrono::nanoseconds elapsed;
+  std::size_t streams = 0;
+  std::size_t cell_count = 0;
+  std::size_t byte_count = 0;
+};
+
+std::string RowKey(int n) {
+  std::ostringstream os;
+  os << "user" << std::setw(8) << std::setfill('0') << n;
+  return os.str();
+}
+
+void FinalizeShape(StreamShape& shape) {
+  for (auto const& chunk : shape.chunks) {
+    shape.byte_count += chunk.ByteSizeLong();
+  }
+}
+
+StreamShape MakePointShape() {
+  StreamShape shape;
+  shape.name = "point";
+  for (int i = 0; i != kPointRows; ++i) {
+    btproto::ReadRowsResponse_CellChunk chunk;
+    chunk.set_row_key(RowKey(i));
+    chunk.mutable_family_name()->set_value("cf");
+    chunk.mutable_qualifier()->set_value("col");
+    chunk.set_timestamp_micros(42000);
+    chunk.set_value(std::string(64, 'v'));
+    chunk.set_commit_row(true);
+    shape.chunks.push_back(std::move(chunk));
+    ++shape.cell_count;
+  }
+  FinalizeShape(shape);
+  return shape;
+}
+
+StreamShape MakeWideShape() {
+  StreamShape shape;
+  shape.name = "wide";
+  for (int i = 0; i != kWideRows; ++i) {
+    for (int c = 0; c != kCellsPerWideRow; ++c) {
+      btproto::ReadRowsResponse_CellChunk chunk;
+      if (c == 0) {
+        chunk.set_row_key(RowKey(i));
+        chunk.mutable_family_name()->set_value("cf");
+      }
+      // The family is carried over from the previous chunk, only the column
+      // changes with every cell.
+      std::ostringstream os;
+      os << "col" << std::setw(2) << std::setfill('0') << c;
+      chunk.mutable_qualifier()->set_value(os.str());
+      chunk.set_timestamp_micros(42000);
+      chunk.set_value(std::string(64, 'v'));
+      if (c == kCellsPerWideRow - 1) {
+        chunk.set_commit_row(true);
+      }
+      shape.chunks.push_back(std::move(chunk));
+      ++shape.cell_count;
+    }
+  }
+  FinalizeShape(shape);
+  return shape;
+}
+
+StreamShape MakeLargeCellShape() {
+  StreamShape shape;
+  shape.name = "large-cell";
+  for (int i = 0; i != kLargeCellRows; ++i) {
+    for (int offset = 0; offset != kLargeCellSize;
+         offset += kLargeCellChunkSize) {
+      btproto::ReadRowsResponse_CellChunk chunk;
+      if (offset == 0) {
+        chunk.set_row_key(RowKey(i));
+        chunk.mutable_family_name()->set_value("cf");
+        chunk.mutable_qualifier()->set_value("col");
+        chunk.set_timestamp_micros(42000);
+      }
+      chunk.set_value(std::string(kLargeCellChunkSize, 'v'));
+      auto const remaining = kLargeCellSize - offset - kLargeCellChunkSize;
+      chunk.set_value_size(remaining == 0 ? 0 : kLargeCellSize);
+      if (remaining == 0) {
+        chunk.set_commit_row(true);
+      }
+      shape.chunks.push_back(std::move(chunk));
+    }
+    ++shape.cell_count;
+  }
+  FinalizeShape(shape);
+  return shape;
+}
+
+/// Replay @p shape through new parsers until @p test_duration has elapsed.
+DecodeResult RunShape(StreamShape const& shape,
+                      std::chrono::seconds test_duration) {
+  DecodeResult result{};
+  auto const start = std::chrono::steady_clock::now();
+  auto const deadline = start + test_duration;
+  while (std::chrono::steady_clock::now() < deadline) {
+    bigtable::internal::ReadRowsParser parser;
+    grpc::Status status;
+    for (auto const& chunk : shape.chunks) {
+      // `HandleChunk()` consumes its argument, the copy made here is part of
+      // the real decode path too, where each chunk arrives in a fresh
+      // response proto.
+      parser.HandleChunk(chunk, status);
+      if (!status.ok()) break;
+      if (parser.HasNext()) {
+        bigtable::Row row = parser.Next(status);
+        result.cell_count += row.cells().size();
+      }
+    }
+    if (status.ok()) parser.HandleEndOfStream(status);
+    if (!status.ok()) {
+      std::cerr << "Parser error replaying shape " << shape.name << ": "
+                << status.error_message() << "\n";
+      std::exit(1);
+    }
+    result.byte_count += shape.byte_count;
+    ++result.streams;
+  }
+  result.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  return result;
+}
+
+void PrintResult(std::string const& name, DecodeResult const& result) {
+  auto const elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(result.elapsed);
+  if (elapsed_us.count() == 0) return;
+  auto const cells_per_second =
+      1000000.0 * static_cast<double>(result.cell_count) /
+      static_cast<double>(elapsed_us.count());
+  auto const mib_per_second =
+      1000000.0 * static_cast<double>(result.byte_count) /
+      static_cast<double>(elapsed_us.count()) / (1024 * 1024);
+  std::cout << "# Decode(" << name << ") streams=" << result.streams
+            << ", cells=" << result.cell_count
+            << ", elapsed=" << FormatDuration(result.elapsed) << ", "
+            << std::fixed << std::setprecision(0) << cells_per_second
+            << " cells/s, " << std::setprecision(2) << mib_per_second
+            << " MiB/s\n";
+  std::cout.unsetf(std::ios::fixed);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  auto test_duration = kDefaultTestDuration;
+  if (argc >= 2) {
+    test_duration = std::chrono::seconds(std::stoi(argv[1]));
+  }
+
+  std::vector<StreamShape> shapes;
+  shapes.push_back(MakePointShape());
+  shapes.push_back(MakeWideShape());
+  shapes.push_back(MakeLargeCellShape());
+
+  for (auto const& shape : shapes) {
+    std::cout << "# Running decode benchmark [" << shape.name << "]"
+              << std::endl;
+    auto result = RunShape(shape, test_duration);
+    PrintResult(shape.name, result);
+  }
+  return 0;
+}
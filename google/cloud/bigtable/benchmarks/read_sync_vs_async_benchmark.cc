@@ -224,6 +224,12 @@ int main(int argc, char* argv[]) {
                            async_results);
   benchmark.PrintResultCsv(std::cout, "perf", "ReadRow()", "Latency",
                            sync_results);
+  benchmark.PrintResultJson(std::cout, "perf", "BulkApply()", "Latency",
+                            *populate_results);
+  benchmark.PrintResultJson(std::cout, "perf", "AsyncReadRow()", "Latency",
+                            async_results);
+  benchmark.PrintResultJson(std::cout, "perf", "ReadRow()", "Latency",
+                            sync_results);
 
   benchmark.DeleteTable();
   cq.Shutdown();
@@ -115,6 +115,23 @@ int main(int argc, char* argv[]) {
     benchmark.PrintResultCsv(std::cout, "scant", kv.first, "IterationTime",
                              kv.second);
   }
+  benchmark.PrintResultJson(std::cout, "scant", "BulkApply()", "Latency",
+                            *populate_results);
+  for (auto const& kv : results_by_size) {
+    benchmark.PrintResultJson(std::cout, "scant", kv.first, "IterationTime",
+                              kv.second);
+  }
+
+  // Also report one histogram per scan size, including the error counts and
+  // in a machine-friendly format.
+  std::cout << Benchmark::HistogramCsvHeader() << "\n";
+  for (auto const& kv : results_by_size) {
+    auto histogram = bigtable::benchmarks::MakeLatencyHistogram(kv.second);
+    benchmark.PrintHistogramCsv(std::cout, "scant", kv.first, "IterationTime",
+                                histogram);
+    benchmark.PrintHistogramJson(std::cout, "scant", kv.first, "IterationTime",
+                                 histogram);
+  }
 
   benchmark.DeleteTable();
 
@@ -19,13 +19,16 @@
 bigtable_client_hdrs = [
     "admin_client.h",
     "app_profile_config.h",
+    "arena_bulk_mutation.h",
     "async_row_reader.h",
     "cell.h",
+    "check_and_mutate_batcher.h",
     "client_options.h",
     "cluster_config.h",
     "cluster_list_responses.h",
     "column_family.h",
     "completion_queue.h",
+    "counter_column_view.h",
     "data_client.h",
     "expr.h",
     "filters.h",
@@ -48,6 +51,7 @@ bigtable_client_hdrs = [
     "internal/common_client.h",
     "internal/conjunction.h",
     "internal/google_bytes_traits.h",
+    "internal/prefetching_read_rows_reader.h",
     "internal/prefix_range_end.h",
     "internal/readrowsparser.h",
     "internal/rowreaderiterator.h",
@@ -56,10 +60,15 @@ bigtable_client_hdrs = [
     "internal/unary_client_utils.h",
     "metadata_update_policy.h",
     "mutation_batcher.h",
+    "mutation_byte_budget.h",
     "mutations.h",
+    "parallel_row_reader.h",
+    "precompiled_filter.h",
     "polling_policy.h",
+    "read_modify_write_batcher.h",
     "read_modify_write_rule.h",
     "row.h",
+    "row_interval_set.h",
     "row_key.h",
     "row_key_sample.h",
     "row_range.h",
@@ -67,6 +76,7 @@ bigtable_client_hdrs = [
     "row_set.h",
     "rpc_backoff_policy.h",
     "rpc_retry_policy.h",
+    "sample_row_keys_cache.h",
     "table.h",
     "table_admin.h",
     "table_config.h",
@@ -77,8 +87,10 @@ bigtable_client_hdrs = [
 bigtable_client_srcs = [
     "admin_client.cc",
     "app_profile_config.cc",
+    "check_and_mutate_batcher.cc",
     "client_options.cc",
     "cluster_config.cc",
+    "counter_column_view.cc",
     "data_client.cc",
     "expr.cc",
     "iam_binding.cc",
@@ -92,18 +104,25 @@ bigtable_client_srcs = [
     "internal/bulk_mutator.cc",
     "internal/common_client.cc",
     "internal/google_bytes_traits.cc",
+    "internal/prefetching_read_rows_reader.cc",
     "internal/prefix_range_end.cc",
     "internal/readrowsparser.cc",
     "internal/rowreaderiterator.cc",
     "metadata_update_policy.cc",
     "mutation_batcher.cc",
+    "mutation_byte_budget.cc",
     "mutations.cc",
+    "parallel_row_reader.cc",
+    "precompiled_filter.cc",
     "polling_policy.cc",
+    "read_modify_write_batcher.cc",
+    "row_interval_set.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
     "rpc_backoff_policy.cc",
     "rpc_retry_policy.cc",
+    "sample_row_keys_cache.cc",
     "table.cc",
     "table_admin.cc",
     "table_config.cc",
@@ -19,6 +19,7 @@
 bigtable_client_unit_tests = [
     "admin_client_test.cc",
     "app_profile_config_test.cc",
+    "arena_bulk_mutation_test.cc",
     "async_list_app_profiles_test.cc",
     "async_list_clusters_test.cc",
     "async_list_instances_test.cc",
@@ -26,9 +27,11 @@ bigtable_client_unit_tests = [
     "async_row_reader_test.cc",
     "bigtable_version_test.cc",
     "cell_test.cc",
+    "check_and_mutate_batcher_test.cc",
     "client_options_test.cc",
     "cluster_config_test.cc",
     "column_family_test.cc",
+    "counter_column_view_test.cc",
     "data_client_test.cc",
     "expr_test.cc",
     "filters_test.cc",
@@ -44,19 +47,27 @@ bigtable_client_unit_tests = [
     "internal/async_retry_multi_page_test.cc",
     "internal/async_retry_unary_rpc_and_poll_test.cc",
     "internal/bulk_mutator_test.cc",
+    "internal/common_client_test.cc",
     "internal/google_bytes_traits_test.cc",
+    "internal/prefetching_read_rows_reader_test.cc",
     "internal/prefix_range_end_test.cc",
     "metadata_update_policy_test.cc",
     "mutation_batcher_test.cc",
+    "mutation_byte_budget_test.cc",
     "mutations_test.cc",
+    "parallel_row_reader_test.cc",
+    "precompiled_filter_test.cc",
     "polling_policy_test.cc",
+    "read_modify_write_batcher_test.cc",
     "read_modify_write_rule_test.cc",
+    "row_interval_set_test.cc",
     "row_range_test.cc",
     "row_reader_test.cc",
     "row_set_test.cc",
     "row_test.cc",
     "rpc_backoff_policy_test.cc",
     "rpc_retry_policy_test.cc",
+    "sample_row_keys_cache_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
     "table_bulk_apply_test.cc",
@@ -20,6 +20,7 @@
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/status_or.h"
 #include <chrono>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -31,6 +32,10 @@ class Cell;
 struct Mutation;
 Mutation SetCell(Cell);
 
+namespace internal {
+class ReadRowsParser;
+}  // namespace internal
+
 /**
  * Defines the type for column qualifiers.
  *
@@ -99,8 +104,9 @@ class Cell {
   Cell(KeyType&& row_key, std::string family_name,
        ColumnType&& column_qualifier, std::int64_t timestamp, ValueType&& value,
        std::vector<std::string> labels)
-      : row_key_(std::forward<KeyType>(row_key)),
-        family_name_(std::move(family_name)),
+      : row_key_(
+            std::make_shared<RowKeyType>(std::forward<KeyType>(row_key))),
+        family_name_(std::make_shared<std::string>(std::move(family_name))),
         column_qualifier_(std::forward<ColumnType>(column_qualifier)),
         timestamp_(timestamp),
         value_(std::forward<ValueType>(value)),
@@ -129,11 +135,11 @@ class Cell {
 
   /// Return the row key this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  RowKeyType const& row_key() const { return row_key_; }
+  RowKeyType const& row_key() const { return *row_key_; }
 
   /// Return the family this cell belongs to. The returned value is not valid
   /// after this object is deleted.
-  std::string const& family_name() const { return family_name_; }
+  std::string const& family_name() const { return *family_name_; }
 
   /// Return the column this cell belongs to. The returned value is not valid
   /// after this object is deleted.
@@ -169,14 +175,36 @@ class Cell {
   std::vector<std::string> const& labels() const { return labels_; }
 
  private:
-  RowKeyType row_key_;
-  std::string family_name_;
+  /**
+   * Create a cell from components shared with other cells.
+   *
+   * The ReadRows parser uses this constructor to share a single copy of the
+   * row key across all the cells in a row, and a single copy of each column
+   * family name across all the cells in a table scan.
+   */
+  Cell(std::shared_ptr<RowKeyType const> row_key,
+       std::shared_ptr<std::string const> family_name,
+       ColumnQualifierType column_qualifier, std::int64_t timestamp,
+       CellValueType value, std::vector<std::string> labels)
+      : row_key_(std::move(row_key)),
+        family_name_(std::move(family_name)),
+        column_qualifier_(std::move(column_qualifier)),
+        timestamp_(timestamp),
+        value_(std::move(value)),
+        labels_(std::move(labels)) {}
+
+  // The row key and family name are shared between cells, see the private
+  // constructor. Sharing is invisible to the applications because the
+  // pointees are immutable.
+  std::shared_ptr<RowKeyType const> row_key_;
+  std::shared_ptr<std::string const> family_name_;
   ColumnQualifierType column_qualifier_;
   std::int64_t timestamp_;
   CellValueType value_;
   std::vector<std::string> labels_;
 
   friend Mutation SetCell(Cell);
+  friend class internal::ReadRowsParser;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -0,0 +1,124 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/check_and_mutate_batcher.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+namespace {
+// The CheckAndMutateRow RPC serializes per row on the server, so unlike bulk
+// mutations there is little benefit in very high concurrency; 16 outstanding
+// requests keep several channels busy without overwhelming the service.
+std::size_t const kDefaultMaxOutstandingRequests = 16;
+}  // namespace
+
+CheckAndMutateBatcher::Options::Options()
+    : max_outstanding_requests(kDefaultMaxOutstandingRequests) {}
+
+std::pair<future<void>, future<StatusOr<MutationBranch>>>
+CheckAndMutateBatcher::AsyncCheckAndMutateRow(
+    CompletionQueue& cq, std::string row_key, Filter filter,
+    std::vector<Mutation> true_mutations,
+    std::vector<Mutation> false_mutations) {
+  AdmissionPromise admission_promise;
+  CompletionPromise completion_promise;
+  auto res = std::make_pair(admission_promise.get_future(),
+                            completion_promise.get_future());
+
+  std::unique_lock<std::mutex> lk(mu_);
+  ++num_requests_pending_;
+  pending_requests_.push(PendingRequest{
+      std::move(row_key), std::move(filter), std::move(true_mutations),
+      std::move(false_mutations), std::move(completion_promise),
+      std::move(admission_promise)});
+  StartPendingRequests(cq, lk);
+  return res;
+}
+
+future<void> CheckAndMutateBatcher::AsyncWaitForNoPendingRequests() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (num_requests_pending_ == 0 && num_outstanding_requests_ == 0) {
+    return make_ready_future();
+  }
+  no_more_pending_promises_.emplace_back();
+  return no_more_pending_promises_.back().get_future();
+}
+
+future<StatusOr<MutationBranch>>
+CheckAndMutateBatcher::AsyncCheckAndMutateRowImpl(
+    Table& table, CompletionQueue& cq, std::string row_key, Filter filter,
+    std::vector<Mutation> true_mutations,
+    std::vector<Mutation> false_mutations) {
+  return table.AsyncCheckAndMutateRow(std::move(row_key), std::move(filter),
+                                      std::move(true_mutations),
+                                      std::move(false_mutations), cq);
+}
+
+void CheckAndMutateBatcher::StartPendingRequests(
+    CompletionQueue& cq, std::unique_lock<std::mutex>& lk) {
+  std::vector<PendingRequest> to_start;
+  while (!pending_requests_.empty() &&
+         num_outstanding_requests_ < options_.max_outstanding_requests) {
+    to_start.emplace_back(std::move(pending_requests_.front()));
+    pending_requests_.pop();
+    ++num_outstanding_requests_;
+  }
+  lk.unlock();
+  // Satisfy the admission promises and start the RPCs with the lock
+  // released; user-installed continuations may call back into this object.
+  for (auto& request : to_start) {
+    request.admission_promise.set_value();
+    auto completion_promise = std::make_shared<CompletionPromise>(
+        std::move(request.completion_promise));
+    auto self = this;
+    AsyncCheckAndMutateRowImpl(table_, cq, std::move(request.row_key),
+                               std::move(request.filter),
+                               std::move(request.true_mutations),
+                               std::move(request.false_mutations))
+        .then([self, completion_promise,
+               cq](future<StatusOr<MutationBranch>> branch) mutable {
+          completion_promise->set_value(branch.get());
+          self->OnRequestDone(cq);
+        });
+  }
+}
+
+void CheckAndMutateBatcher::OnRequestDone(CompletionQueue& cq) {
+  std::unique_lock<std::mutex> lk(mu_);
+  --num_outstanding_requests_;
+  --num_requests_pending_;
+  if (!pending_requests_.empty()) {
+    StartPendingRequests(cq, lk);
+    return;
+  }
+  std::vector<NoMorePendingPromise> no_more_pending_promises;
+  if (num_requests_pending_ == 0 && num_outstanding_requests_ == 0) {
+    // We should wait not only on num_requests_pending_ being zero but also on
+    // num_outstanding_requests_ because we want to allow the user to shut
+    // down the completion queue after this promise is fulfilled.
+    no_more_pending_promises.swap(no_more_pending_promises_);
+  }
+  lk.unlock();
+  for (auto& promise : no_more_pending_promises) {
+    promise.set_value();
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,202 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHECK_AND_MUTATE_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHECK_AND_MUTATE_BATCHER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <mutex>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Objects of this class execute many conditional mutations concurrently.
+ *
+ * Unlike `MutateRows`, the `CheckAndMutateRow` RPC has no bulk form, so the
+ * only way to increase the throughput of conditional mutations is to keep
+ * many RPCs in flight. This class helps in doing so with the same ergonomics
+ * as `MutationBatcher`: submit conditional mutations with
+ * `AsyncCheckAndMutateRow()` and the batcher keeps a bounded number of them
+ * outstanding, queuing the rest.
+ *
+ * This class also offers an easy-to-use flow control mechanism to avoid
+ * unbounded growth in its internal buffers.
+ *
+ * Applications must provide a `CompletionQueue` to (asynchronously) execute
+ * these operations. The application is responsible of executing the
+ * `CompletionQueue` event loop in one or more threads.
+ */
+class CheckAndMutateBatcher {
+ public:
+  /// Configuration for `CheckAndMutateBatcher`.
+  struct Options {
+    Options();
+
+    /// There will be no more RPCs outstanding (except for retries) than this.
+    Options& SetMaxOutstandingRequests(
+        std::size_t max_outstanding_requests_arg) {
+      max_outstanding_requests = max_outstanding_requests_arg;
+      return *this;
+    }
+
+    std::size_t max_outstanding_requests;
+  };
+
+  explicit CheckAndMutateBatcher(Table table, Options options = Options())
+      : table_(std::move(table)),
+        options_(options),
+        num_outstanding_requests_(),
+        num_requests_pending_() {}
+
+  virtual ~CheckAndMutateBatcher() = default;
+
+  /**
+   * Asynchronously perform a conditional mutation.
+   *
+   * The operation is started immediately if fewer than
+   * `Options::max_outstanding_requests` operations are in flight, and is
+   * queued otherwise.
+   *
+   * @param cq the completion queue that will execute the asynchronous
+   *    calls, the application must ensure that one or more threads are
+   *    blocked on `cq.Run()`.
+   * @param row_key the row to conditionally modify.
+   * @param filter the condition, depending on which the mutation will be
+   *    performed.
+   * @param true_mutations the mutations performed if @p filter is true.
+   * @param false_mutations the mutations performed if @p filter is false.
+   *
+   * @return *admission* and *completion* futures
+   *
+   * The *completion* future reports the branch taken (or the error) once the
+   * operation completes.
+   *
+   * The *admission* future should be used for flow control. In order to
+   * bound the memory used by `CheckAndMutateBatcher`, one should not submit
+   * more operations before the *admission* future is satisfied, it becomes
+   * satisfied when the operation is sent to the service. Note that while the
+   * future is often already satisfied when the function returns,
+   * applications should not assume that this is always the case.
+   *
+   * This quasi-synchronous example shows the intended use:
+   * @code
+   * bigtable::CheckAndMutateBatcher batcher(bigtable::Table(...args...));
+   * bigtable::CompletionQueue cq;
+   * std::thread cq_runner([]() { cq.Run(); });
+   *
+   * while (HasMoreOperations()) {
+   *   auto admission_completion = batcher.AsyncCheckAndMutateRow(
+   *       cq, RowKey(), Condition(), TrueMutations(), FalseMutations());
+   *   auto& admission_future = admission_completion.first;
+   *   auto& completion_future = admission_completion.second;
+   *   completion_future.then(
+   *       [](bigtable::future<StatusOr<bigtable::MutationBranch>> branch) {
+   *         // handle the operation's completion asynchronously
+   *       });
+   *   // Potentially slow down submission not to make buffers in
+   *   // CheckAndMutateBatcher grow unbounded.
+   *   admission_future.get();
+   * }
+   * // Wait for all operations to complete
+   * batcher.AsyncWaitForNoPendingRequests().get();
+   * cq.Shutdown();
+   * cq_runner.join();
+   * @endcode
+   */
+  std::pair<future<void>, future<StatusOr<MutationBranch>>>
+  AsyncCheckAndMutateRow(CompletionQueue& cq, std::string row_key,
+                         Filter filter, std::vector<Mutation> true_mutations,
+                         std::vector<Mutation> false_mutations);
+
+  /**
+   * Asynchronously wait until all submitted operations complete.
+   *
+   * @return a future which will be satisfied once all operations submitted
+   *     before calling this function finish; if there are no such operations,
+   *     the returned future is already satisfied.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+ protected:
+  // Wrap calling the underlying operation in a virtual function to ease
+  // testing.
+  virtual future<StatusOr<MutationBranch>> AsyncCheckAndMutateRowImpl(
+      Table& table, CompletionQueue& cq, std::string row_key, Filter filter,
+      std::vector<Mutation> true_mutations,
+      std::vector<Mutation> false_mutations);
+
+ private:
+  using CompletionPromise = promise<StatusOr<MutationBranch>>;
+  using AdmissionPromise = promise<void>;
+  using NoMorePendingPromise = promise<void>;
+
+  /// A conditional mutation waiting for an execution slot.
+  struct PendingRequest {
+    std::string row_key;
+    Filter filter;
+    std::vector<Mutation> true_mutations;
+    std::vector<Mutation> false_mutations;
+    CompletionPromise completion_promise;
+    AdmissionPromise admission_promise;
+  };
+
+  /**
+   * Start as many pending operations as the outstanding limit allows.
+   *
+   * Satisfies the admission promises of the started operations. Unlocks
+   * `lk`.
+   */
+  void StartPendingRequests(CompletionQueue& cq,
+                            std::unique_lock<std::mutex>& lk);
+
+  /// Handle the completion of one operation.
+  void OnRequestDone(CompletionQueue& cq);
+
+  std::mutex mu_;
+  Table table_;
+  Options options_;
+
+  /// Number of RPCs sent but not completed.
+  std::size_t num_outstanding_requests_;
+  /// Number of uncompleted operations (including not yet started).
+  std::size_t num_requests_pending_;
+
+  /// The operations waiting for an execution slot.
+  std::queue<PendingRequest> pending_requests_;
+
+  /**
+   * The list of promises made to this point.
+   *
+   * These promises are satisfied as part of calling
+   * `AsyncWaitForNoPendingRequests()`.
+   */
+  std::vector<NoMorePendingPromise> no_more_pending_promises_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_CHECK_AND_MUTATE_BATCHER_H
@@ -0,0 +1,143 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/check_and_mutate_batcher.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/**
+ * A `CheckAndMutateBatcher` whose underlying operations are completed by
+ * hand.
+ *
+ * Each started operation takes a promise from `operation_promises_`; the
+ * tests control when (and with what result) the operations complete.
+ */
+class CheckAndMutateBatcherForTest : public CheckAndMutateBatcher {
+ public:
+  using CheckAndMutateBatcher::CheckAndMutateBatcher;
+
+  std::size_t num_started_operations() const {
+    return num_started_operations_;
+  }
+
+  /// Complete the oldest still-running operation with @p result.
+  void CompleteOldestOperation(StatusOr<MutationBranch> result) {
+    ASSERT_FALSE(operation_promises_.empty());
+    auto promise = std::move(operation_promises_.front());
+    operation_promises_.pop_front();
+    promise.set_value(std::move(result));
+  }
+
+ protected:
+  future<StatusOr<MutationBranch>> AsyncCheckAndMutateRowImpl(
+      Table&, CompletionQueue&, std::string, Filter, std::vector<Mutation>,
+      std::vector<Mutation>) override {
+    ++num_started_operations_;
+    operation_promises_.emplace_back();
+    return operation_promises_.back().get_future();
+  }
+
+ private:
+  std::size_t num_started_operations_ = 0;
+  std::deque<promise<StatusOr<MutationBranch>>> operation_promises_;
+};
+
+using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
+
+class CheckAndMutateBatcherTest
+    : public bigtable::testing::TableTestFixture {
+ protected:
+  std::pair<future<void>, future<StatusOr<MutationBranch>>> Submit(
+      CheckAndMutateBatcher& batcher) {
+    return batcher.AsyncCheckAndMutateRow(
+        cq_, "row", Filter::PassAllFilter(),
+        {SetCell("fam", "col", 0_ms, "it was true")},
+        {SetCell("fam", "col", 0_ms, "it was false")});
+  }
+
+  CompletionQueue cq_;
+};
+
+TEST_F(CheckAndMutateBatcherTest, CompletionResultsAreDelivered) {
+  CheckAndMutateBatcherForTest batcher(table_);
+
+  auto op1 = Submit(batcher);
+  auto op2 = Submit(batcher);
+  EXPECT_EQ(2U, batcher.num_started_operations());
+
+  batcher.CompleteOldestOperation(MutationBranch::kPredicateMatched);
+  batcher.CompleteOldestOperation(
+      Status(StatusCode::kPermissionDenied, "oh no"));
+
+  auto r1 = op1.second.get();
+  ASSERT_STATUS_OK(r1);
+  EXPECT_EQ(MutationBranch::kPredicateMatched, *r1);
+  auto r2 = op2.second.get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, r2.status().code());
+}
+
+TEST_F(CheckAndMutateBatcherTest, MaxOutstandingRequestsIsEnforced) {
+  CheckAndMutateBatcherForTest batcher(
+      table_,
+      CheckAndMutateBatcher::Options().SetMaxOutstandingRequests(2));
+
+  auto op1 = Submit(batcher);
+  auto op2 = Submit(batcher);
+  auto op3 = Submit(batcher);
+  // The first two operations are started and admitted, the third is queued.
+  EXPECT_EQ(2U, batcher.num_started_operations());
+  EXPECT_TRUE(op1.first.is_ready());
+  EXPECT_TRUE(op2.first.is_ready());
+  EXPECT_FALSE(op3.first.is_ready());
+
+  // Completing one operation frees a slot for the queued one.
+  batcher.CompleteOldestOperation(MutationBranch::kPredicateNotMatched);
+  EXPECT_EQ(3U, batcher.num_started_operations());
+  EXPECT_TRUE(op3.first.is_ready());
+
+  batcher.CompleteOldestOperation(MutationBranch::kPredicateNotMatched);
+  batcher.CompleteOldestOperation(MutationBranch::kPredicateNotMatched);
+}
+
+TEST_F(CheckAndMutateBatcherTest, AsyncWaitForNoPendingRequests) {
+  CheckAndMutateBatcherForTest batcher(table_);
+
+  // With no operations submitted the returned future is already satisfied.
+  EXPECT_TRUE(batcher.AsyncWaitForNoPendingRequests().is_ready());
+
+  auto op1 = Submit(batcher);
+  auto op2 = Submit(batcher);
+  auto no_more_pending = batcher.AsyncWaitForNoPendingRequests();
+  EXPECT_FALSE(no_more_pending.is_ready());
+
+  batcher.CompleteOldestOperation(MutationBranch::kPredicateMatched);
+  EXPECT_FALSE(no_more_pending.is_ready());
+  batcher.CompleteOldestOperation(MutationBranch::kPredicateMatched);
+  EXPECT_TRUE(no_more_pending.is_ready());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
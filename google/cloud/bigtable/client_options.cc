@@ -79,8 +79,11 @@ inline std::size_t CalculateDefaultConnectionPoolSize() {
 ClientOptions::ClientOptions(std::shared_ptr<grpc::ChannelCredentials> creds)
     : credentials_(std::move(creds)),
       connection_pool_size_(CalculateDefaultConnectionPoolSize()),
+      max_connection_pool_size_(0),
+      channel_affinity_(false),
       data_endpoint_("bigtable.googleapis.com"),
       admin_endpoint_("bigtableadmin.googleapis.com"),
+      read_rows_compression_algorithm_(GRPC_COMPRESS_NONE),
       instance_admin_endpoint_("bigtableadmin.googleapis.com") {
   static std::string const kUserAgentPrefix = UserAgentPrefix();
   channel_arguments_.SetUserAgentPrefix(kUserAgentPrefix);
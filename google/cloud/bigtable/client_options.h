@@ -123,6 +123,49 @@ class ClientOptions {
 
   std::size_t connection_pool_size() const { return connection_pool_size_; }
 
+  /**
+   * Set the maximum size of the connection pool for dynamic resizing.
+   *
+   * By default the connection pool has the fixed size configured with
+   * `set_connection_pool_size()`. Setting a larger maximum lets the client
+   * grow the pool — up to this limit — while every channel is busy, and
+   * shrink it back to the configured size when the load subsides.
+   *
+   * Specifying 0 for @p size (the default) disables resizing.
+   */
+  ClientOptions& set_max_connection_pool_size(std::size_t size) {
+    max_connection_pool_size_ = size;
+    return *this;
+  }
+
+  /// Return the maximum size of the connection pool, 0 if resizing is
+  /// disabled.
+  std::size_t max_connection_pool_size() const {
+    return max_connection_pool_size_;
+  }
+
+  /**
+   * Enable thread-to-channel affinity in the connection pool.
+   *
+   * By default each RPC uses the next channel in the pool, round-robin.
+   * That spreads the load well, but on hosts with many cores it also makes
+   * every thread touch every channel, bouncing the channel state between
+   * CPU caches. With affinity enabled each application thread sticks to one
+   * channel of the pool (rotating to the next one only occasionally, so a
+   * thread imbalance does not overload a single channel).
+   *
+   * This is most useful for applications with many long-lived worker
+   * threads; applications with few threads or short-lived ones should keep
+   * the default.
+   */
+  ClientOptions& set_channel_affinity(bool enabled) {
+    channel_affinity_ = enabled;
+    return *this;
+  }
+
+  /// Return whether thread-to-channel affinity is enabled.
+  bool channel_affinity() const { return channel_affinity_; }
+
   /// Return the current credentials.
   std::shared_ptr<grpc::ChannelCredentials> credentials() const {
     return credentials_;
@@ -157,6 +200,28 @@ class ClientOptions {
     channel_arguments_.SetCompressionAlgorithm(algorithm);
   }
 
+  /**
+   * Set the per-call compression algorithm for `ReadRows()` calls.
+   *
+   * Unlike `SetCompressionAlgorithm()` this only affects the `ReadRows`
+   * streaming RPCs, where the bulk of the data transfer happens. The call
+   * advertises the algorithm to the service, which uses it to compress the
+   * responses; scanned values often compress very well, so this can
+   * substantially reduce the bytes on the wire (at some CPU cost on both
+   * sides). Decompression happens inside gRPC, concurrently with the
+   * library parsing previously delivered messages.
+   *
+   * The default (`GRPC_COMPRESS_NONE`) leaves the calls unchanged.
+   */
+  void SetReadRowsCompressionAlgorithm(grpc_compression_algorithm algorithm) {
+    read_rows_compression_algorithm_ = algorithm;
+  }
+
+  /// Return the per-call compression algorithm for `ReadRows()` calls.
+  grpc_compression_algorithm read_rows_compression_algorithm() const {
+    return read_rows_compression_algorithm_;
+  }
+
   /**
    * Set the grpclb fallback timeout with the timestamp @p fallback_timeout
    * for the channel.
@@ -307,8 +372,11 @@ class ClientOptions {
   grpc::ChannelArguments channel_arguments_;
   std::string connection_pool_name_;
   std::size_t connection_pool_size_;
+  std::size_t max_connection_pool_size_;
+  bool channel_affinity_;
   std::string data_endpoint_;
   std::string admin_endpoint_;
+  grpc_compression_algorithm read_rows_compression_algorithm_;
   // The endpoint for instance admin operations, in most scenarios this should
   // have the same value as `admin_endpoint_`. The most common exception is
   // testing, where the emulator for instance admin operations may be different
@@ -240,6 +240,15 @@ TEST(ClientOptionsTest, EditAdminEndpoint) {
       ClientOptionsTestTraits::InstanceAdminEndpoint(client_options_object));
 }
 
+TEST(ClientOptionsTest, SetReadRowsCompressionAlgorithm) {
+  bigtable::ClientOptions client_options_object;
+  EXPECT_EQ(GRPC_COMPRESS_NONE,
+            client_options_object.read_rows_compression_algorithm());
+  client_options_object.SetReadRowsCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+  EXPECT_EQ(GRPC_COMPRESS_GZIP,
+            client_options_object.read_rows_compression_algorithm());
+}
+
 TEST(ClientOptionsTest, EditCredentials) {
   bigtable::ClientOptions client_options_object;
   client_options_object =
@@ -271,6 +280,24 @@ TEST(ClientOptionsTest, ResetToDefaultConnectionPoolSize) {
   EXPECT_LE(1UL, returned.connection_pool_size());
 }
 
+TEST(ClientOptionsTest, EditMaxConnectionPoolSize) {
+  bigtable::ClientOptions client_options_object;
+  // Resizing is disabled by default.
+  EXPECT_EQ(0UL, client_options_object.max_connection_pool_size());
+  auto& returned = client_options_object.set_max_connection_pool_size(42);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(42UL, returned.max_connection_pool_size());
+}
+
+TEST(ClientOptionsTest, EditChannelAffinity) {
+  bigtable::ClientOptions client_options_object;
+  // Affinity is disabled by default.
+  EXPECT_FALSE(client_options_object.channel_affinity());
+  auto& returned = client_options_object.set_channel_affinity(true);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_TRUE(returned.channel_affinity());
+}
+
 TEST(ClientOptionsTest, SetGrpclbFallbackTimeoutMS) {
   // Test milliseconds are set properly to channel_arguments
   bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
@@ -0,0 +1,97 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COUNTER_COLUMN_VIEW_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COUNTER_COLUMN_VIEW_H
+
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Batch-decode the 64-bit counter cells of one column.
+ *
+ * Time-series applications often store big-endian 64-bit counters (the
+ * format used by `ReadModifyWriteRule::IncrementAmount()`) and aggregate
+ * millions of them per query. Decoding each cell through
+ * `Cell::decode_big_endian_integer<std::int64_t>()` builds a `StatusOr<>`
+ * per cell, which dominates the cost of such scans after parsing.
+ *
+ * This class decodes all the matching cells of a row in one pass: a single
+ * length check per cell and a fixed-width byte swap that compilers reduce
+ * to a `bswap` instruction. Construct the view once per query and call
+ * `Append()` for each row of the scan to accumulate the counters into a
+ * single vector:
+ *
+ * @code
+ * bigtable::CounterColumnView view("stats", "clicks");
+ * std::vector<std::int64_t> counters;
+ * for (StatusOr<bigtable::Row> const& row : table.ReadRows(...)) {
+ *   if (!row) break;
+ *   auto status = view.Append(*row, counters);
+ *   if (!status.ok()) break;
+ * }
+ * @endcode
+ */
+class CounterColumnView {
+ public:
+  CounterColumnView(std::string family_name,
+                    ColumnQualifierType column_qualifier)
+      : family_name_(std::move(family_name)),
+        column_qualifier_(std::move(column_qualifier)) {}
+
+  /**
+   * Append the decoded counters of this column in @p row to @p values.
+   *
+   * The cells are appended in the order they appear in the row, i.e. most
+   * recent timestamp first. Returns `kInvalidArgument` if a matching cell
+   * is not exactly 8 bytes long; @p values then contains the cells decoded
+   * before the malformed one.
+   */
+  Status Append(Row const& row, std::vector<std::int64_t>& values) const;
+
+  /// Decode the counters of this column in @p row into a new vector.
+  StatusOr<std::vector<std::int64_t>> Decode(Row const& row) const {
+    std::vector<std::int64_t> values;
+    auto status = Append(row, values);
+    if (!status.ok()) {
+      return status;
+    }
+    return values;
+  }
+
+  std::string const& family_name() const { return family_name_; }
+  ColumnQualifierType const& column_qualifier() const {
+    return column_qualifier_;
+  }
+
+ private:
+  std::string family_name_;
+  ColumnQualifierType column_qualifier_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_COUNTER_COLUMN_VIEW_H
@@ -0,0 +1,69 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/counter_column_view.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+using ::google::cloud::StatusCode;
+using ::testing::ElementsAre;
+
+/// @test Verify decoding the counter cells of one column, in order.
+TEST(CounterColumnViewTest, DecodesMatchingCells) {
+  bigtable::Row row(
+      "r1", {bigtable::Cell("r1", "stats", "clicks", 42, std::int64_t{7}),
+             bigtable::Cell("r1", "stats", "views", 42, std::int64_t{1000}),
+             bigtable::Cell("r1", "other", "clicks", 42, std::int64_t{2000}),
+             bigtable::Cell("r1", "stats", "clicks", 41, std::int64_t{-3})});
+
+  bigtable::CounterColumnView view("stats", "clicks");
+  auto values = view.Decode(row);
+  ASSERT_STATUS_OK(values);
+  EXPECT_THAT(*values, ElementsAre(7, -3));
+}
+
+/// @test Verify that Append() accumulates across rows.
+TEST(CounterColumnViewTest, AppendAccumulates) {
+  bigtable::Row r1(
+      "r1", {bigtable::Cell("r1", "stats", "clicks", 0, std::int64_t{1})});
+  bigtable::Row r2(
+      "r2", {bigtable::Cell("r2", "stats", "clicks", 0, std::int64_t{2})});
+
+  bigtable::CounterColumnView view("stats", "clicks");
+  std::vector<std::int64_t> values;
+  ASSERT_STATUS_OK(view.Append(r1, values));
+  ASSERT_STATUS_OK(view.Append(r2, values));
+  EXPECT_THAT(values, ElementsAre(1, 2));
+}
+
+/// @test Verify that cells of the wrong width are an error.
+TEST(CounterColumnViewTest, MalformedCellIsAnError) {
+  bigtable::Row row("r1", {bigtable::Cell("r1", "stats", "clicks", 0, "bad")});
+
+  bigtable::CounterColumnView view("stats", "clicks");
+  auto values = view.Decode(row);
+  EXPECT_EQ(StatusCode::kInvalidArgument, values.status().code());
+}
+
+/// @test Verify that a row without matching cells decodes to nothing.
+TEST(CounterColumnViewTest, NoMatchingCells) {
+  bigtable::Row row(
+      "r1", {bigtable::Cell("r1", "other", "clicks", 0, std::int64_t{1})});
+
+  bigtable::CounterColumnView view("stats", "clicks");
+  auto values = view.Decode(row);
+  ASSERT_STATUS_OK(values);
+  EXPECT_TRUE(values->empty());
+}
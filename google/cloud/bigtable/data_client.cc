@@ -45,6 +45,8 @@ class DefaultDataClient : public DataClient {
                     ClientOptions options)
       : project_(std::move(project)),
         instance_(std::move(instance)),
+        read_rows_compression_algorithm_(
+            options.read_rows_compression_algorithm()),
         impl_(std::move(options)) {}
 
   DefaultDataClient(std::string project, std::string instance)
@@ -106,6 +108,7 @@ class DefaultDataClient : public DataClient {
   std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
   ReadRows(grpc::ClientContext* context,
            btproto::ReadRowsRequest const& request) override {
+    SetupReadRowsContext(context);
     return impl_.Stub()->ReadRows(context, request);
   }
 
@@ -113,6 +116,7 @@ class DefaultDataClient : public DataClient {
   AsyncReadRows(grpc::ClientContext* context,
                 const google::bigtable::v2::ReadRowsRequest& request,
                 grpc::CompletionQueue* cq, void* tag) override {
+    SetupReadRowsContext(context);
     return impl_.Stub()->AsyncReadRows(context, request, cq, tag);
   }
 
@@ -121,6 +125,7 @@ class DefaultDataClient : public DataClient {
   PrepareAsyncReadRows(::grpc::ClientContext* context,
                        const ::google::bigtable::v2::ReadRowsRequest& request,
                        ::grpc::CompletionQueue* cq) override {
+    SetupReadRowsContext(context);
     return impl_.Stub()->PrepareAsyncReadRows(context, request, cq);
   }
 
@@ -160,8 +165,16 @@ class DefaultDataClient : public DataClient {
   }
 
  private:
+  /// Apply the `ReadRows`-specific call settings to @p context.
+  void SetupReadRowsContext(grpc::ClientContext* context) {
+    if (read_rows_compression_algorithm_ != GRPC_COMPRESS_NONE) {
+      context->set_compression_algorithm(read_rows_compression_algorithm_);
+    }
+  }
+
   std::string project_;
   std::string instance_;
+  grpc_compression_algorithm read_rows_compression_algorithm_;
   Impl impl_;
 };
 
@@ -689,6 +689,9 @@ class Filter {
   /// An empty filter, discards all data.
   Filter() = default;
 
+  // `PrecompiledFilter` creates `Filter` objects from their serialized form.
+  friend class PrecompiledFilter;
+
  private:
   google::bigtable::v2::RowFilter filter_;
 };
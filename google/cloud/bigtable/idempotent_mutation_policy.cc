@@ -43,6 +43,12 @@ bool SafeIdempotentMutationPolicy::is_idempotent(
   return false;
 }
 
+absl::optional<bool> SafeIdempotentMutationPolicy::classify_precomputed(
+    bool all_idempotent) {
+  // The precomputed bit follows exactly the rules of this policy.
+  return all_idempotent;
+}
+
 std::unique_ptr<IdempotentMutationPolicy> AlwaysRetryMutationPolicy::clone()
     const {
   return std::unique_ptr<IdempotentMutationPolicy>(
@@ -59,6 +65,10 @@ bool AlwaysRetryMutationPolicy::is_idempotent(
   return true;
 }
 
+absl::optional<bool> AlwaysRetryMutationPolicy::classify_precomputed(bool) {
+  return true;
+}
+
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
 }  // namespace cloud
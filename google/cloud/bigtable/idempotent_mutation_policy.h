@@ -17,6 +17,7 @@
 
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/version.h"
+#include "absl/types/optional.h"
 #include <memory>
 
 namespace google {
@@ -40,6 +41,24 @@ class IdempotentMutationPolicy {
   /// Return true if a conditional mutation is idempotent
   virtual bool is_idempotent(
       google::bigtable::v2::CheckAndMutateRowRequest const&) = 0;
+
+  /**
+   * Classify a whole row mutation from its precomputed idempotency bit.
+   *
+   * `SingleRowMutation` computes, as mutations are added to it, whether
+   * they are all idempotent under the `SafeIdempotentMutationPolicy` rules;
+   * see `SingleRowMutation::all_idempotent()`. Policies whose decision is a
+   * function of that test can override this function to classify a whole
+   * row mutation in O(1), so `Table::BulkApply()` skips the per-mutation
+   * proto inspection when it builds its retry state.
+   *
+   * The default implementation returns an empty optional, which makes the
+   * caller fall back to inspecting each mutation through
+   * `is_idempotent(google::bigtable::v2::Mutation const&)`.
+   */
+  virtual absl::optional<bool> classify_precomputed(bool /*all_idempotent*/) {
+    return absl::nullopt;
+  }
 };
 
 /// Return an instance of the default IdempotentMutationPolicy.
@@ -60,6 +79,7 @@ class SafeIdempotentMutationPolicy : public IdempotentMutationPolicy {
   bool is_idempotent(google::bigtable::v2::Mutation const&) override;
   bool is_idempotent(
       google::bigtable::v2::CheckAndMutateRowRequest const&) override;
+  absl::optional<bool> classify_precomputed(bool all_idempotent) override;
 };
 
 /**
@@ -80,6 +100,7 @@ class AlwaysRetryMutationPolicy : public IdempotentMutationPolicy {
   bool is_idempotent(google::bigtable::v2::Mutation const&) override;
   bool is_idempotent(
       google::bigtable::v2::CheckAndMutateRowRequest const&) override;
+  absl::optional<bool> classify_precomputed(bool all_idempotent) override;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
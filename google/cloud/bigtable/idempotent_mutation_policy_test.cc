@@ -47,3 +47,13 @@ TEST(IdempotentMutationPolicyTest, AlwaysRetry) {
   EXPECT_TRUE(clone->is_idempotent(bigtable::SetCell("f", "c", "v").op));
   EXPECT_TRUE(clone->is_idempotent(bigtable::SetCell("f", "c", 10_ms, "v").op));
 }
+
+/// @test Verify the O(1) classification from precomputed bits.
+TEST(IdempotentMutationPolicyTest, ClassifyPrecomputed) {
+  auto safe = bigtable::DefaultIdempotentMutationPolicy();
+  EXPECT_EQ(absl::make_optional(true), safe->classify_precomputed(true));
+  EXPECT_EQ(absl::make_optional(false), safe->classify_precomputed(false));
+
+  bigtable::AlwaysRetryMutationPolicy always;
+  EXPECT_EQ(absl::make_optional(true), always.classify_precomputed(false));
+}
@@ -28,15 +28,56 @@ future<std::vector<FailedMutation>> AsyncRetryBulkApply::Create(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut) {
+    BulkMutation mut, std::shared_ptr<MutationByteBudget> budget) {
   std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
       std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
       idempotent_policy, std::move(metadata_update_policy), std::move(client),
-      app_profile_id, table_name, std::move(mut)));
+      app_profile_id, table_name, std::move(mut), std::move(budget)));
   bulk_apply->StartIterationIfNeeded(std::move(cq));
   return bulk_apply->promise_.get_future();
 }
 
+future<std::vector<FailedMutation>> AsyncRetryBulkApply::Create(
+    CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    IdempotentMutationPolicy& idempotent_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::shared_ptr<bigtable::DataClient> client,
+    std::string const& app_profile_id, std::string const& table_name,
+    ArenaBulkMutation mut, std::shared_ptr<MutationByteBudget> budget) {
+  std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
+      std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+      idempotent_policy, std::move(metadata_update_policy), std::move(client),
+      app_profile_id, table_name, std::move(mut), std::move(budget)));
+  bulk_apply->StartIterationIfNeeded(std::move(cq));
+  return bulk_apply->promise_.get_future();
+}
+
+std::vector<future<Status>> AsyncRetryBulkApply::CreatePerMutation(
+    CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    IdempotentMutationPolicy& idempotent_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::shared_ptr<bigtable::DataClient> client,
+    std::string const& app_profile_id, std::string const& table_name,
+    BulkMutation mut, std::shared_ptr<MutationByteBudget> budget) {
+  auto const count = mut.size();
+  std::shared_ptr<AsyncRetryBulkApply> bulk_apply(new AsyncRetryBulkApply(
+      std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
+      idempotent_policy, std::move(metadata_update_policy), std::move(client),
+      app_profile_id, table_name, std::move(mut), std::move(budget)));
+  bulk_apply->mutation_promises_.resize(count);
+  bulk_apply->satisfied_.resize(count, false);
+  std::vector<future<Status>> result;
+  result.reserve(count);
+  for (auto& p : bulk_apply->mutation_promises_) {
+    result.push_back(p.get_future());
+  }
+  // Get the futures before starting, the operation may complete inline.
+  bulk_apply->StartIterationIfNeeded(std::move(cq));
+  return result;
+}
+
 AsyncRetryBulkApply::AsyncRetryBulkApply(
     std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
     std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
@@ -44,12 +85,30 @@ AsyncRetryBulkApply::AsyncRetryBulkApply(
     MetadataUpdatePolicy metadata_update_policy,
     std::shared_ptr<bigtable::DataClient> client,
     std::string const& app_profile_id, std::string const& table_name,
-    BulkMutation mut)
+    BulkMutation mut, std::shared_ptr<MutationByteBudget> budget)
     : rpc_retry_policy_(std::move(rpc_retry_policy)),
       rpc_backoff_policy_(std::move(rpc_backoff_policy)),
       metadata_update_policy_(std::move(metadata_update_policy)),
       client_(std::move(client)),
-      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
+      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+      budget_(std::move(budget)),
+      acquired_bytes_(0) {}
+
+AsyncRetryBulkApply::AsyncRetryBulkApply(
+    std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+    IdempotentMutationPolicy& idempotent_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::shared_ptr<bigtable::DataClient> client,
+    std::string const& app_profile_id, std::string const& table_name,
+    ArenaBulkMutation mut, std::shared_ptr<MutationByteBudget> budget)
+    : rpc_retry_policy_(std::move(rpc_retry_policy)),
+      rpc_backoff_policy_(std::move(rpc_backoff_policy)),
+      metadata_update_policy_(std::move(metadata_update_policy)),
+      client_(std::move(client)),
+      state_(app_profile_id, table_name, idempotent_policy, std::move(mut)),
+      budget_(std::move(budget)),
+      acquired_bytes_(0) {}
 
 void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
   if (!state_.HasPendingMutations()) {
@@ -57,10 +116,30 @@ void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
     // in the case of the retry policy begin expired we hit this point because
     // the mutations are no longer "pending", they are all resolved with a
     // error status.
-    promise_.set_value(std::move(state_).OnRetryDone());
+    auto failures = std::move(state_).OnRetryDone();
+    for (auto const& f : failures) {
+      SatisfyMutation(f.original_index(), f.status());
+    }
+    promise_.set_value(std::move(failures));
+    return;
+  }
+
+  if (!budget_) {
+    StartIteration(std::move(cq));
     return;
   }
+  // Wait for the budget to admit this attempt. The pending mutations shrink
+  // as attempts partially succeed, so each retry asks only for the bytes it
+  // actually re-sends.
+  acquired_bytes_ = state_.PendingBytes();
+  auto self = shared_from_this();
+  budget_->AsyncAcquire(acquired_bytes_)
+      .then([self, cq](future<void>) mutable {
+        self->StartIteration(std::move(cq));
+      });
+}
 
+void AsyncRetryBulkApply::StartIteration(CompletionQueue cq) {
   auto context = absl::make_unique<grpc::ClientContext>();
   rpc_retry_policy_->Setup(*context);
   rpc_backoff_policy_->Setup(*context);
@@ -83,14 +162,40 @@ void AsyncRetryBulkApply::StartIterationIfNeeded(CompletionQueue cq) {
 
 void AsyncRetryBulkApply::OnRead(
     google::bigtable::v2::MutateRowsResponse response) {
-  state_.OnRead(response);
+  auto successes = state_.OnRead(response);
+  for (auto index : successes) {
+    SatisfyMutation(index, Status());
+  }
 }
 
 void AsyncRetryBulkApply::OnFinish(CompletionQueue cq, Status status) {
+  if (budget_) {
+    budget_->Release(acquired_bytes_);
+    acquired_bytes_ = 0;
+  }
   state_.OnFinish(std::move(status));
+  if (!mutation_promises_.empty()) {
+    // Report permanent failures without waiting for the retry loop to end,
+    // they will not change in later attempts.
+    for (auto& f : state_.ConsumeAccumulatedFailures()) {
+      SatisfyMutation(f.original_index(), f.status());
+    }
+  }
   StartIterationIfNeeded(std::move(cq));
 }
 
+void AsyncRetryBulkApply::SatisfyMutation(int original_index, Status status) {
+  if (mutation_promises_.empty()) {
+    return;
+  }
+  auto const i = static_cast<std::size_t>(original_index);
+  if (i >= mutation_promises_.size() || satisfied_[i]) {
+    return;
+  }
+  satisfied_[i] = true;
+  mutation_promises_[i].set_value(std::move(status));
+}
+
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -20,6 +20,7 @@
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/bigtable/internal/async_retry_op.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/mutation_byte_budget.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/invoke_result.h"
 #include "absl/memory/memory.h"
@@ -36,6 +37,11 @@ namespace internal {
  * retry loops: only those mutations that are idempotent and had a transient
  * failure can be retried, and the result for each mutation arrives in a stream.
  * This class implements that retry loop.
+ *
+ * When a `MutationByteBudget` is provided each attempt (including each
+ * retry) acquires its serialized size from the budget before it is sent and
+ * releases it when the attempt finishes. This paces retries across all the
+ * operations sharing the budget.
  */
 class AsyncRetryBulkApply
     : public std::enable_shared_from_this<AsyncRetryBulkApply> {
@@ -47,7 +53,38 @@ class AsyncRetryBulkApply
       MetadataUpdatePolicy metadata_update_policy,
       std::shared_ptr<bigtable::DataClient> client,
       std::string const& app_profile_id, std::string const& table_name,
-      BulkMutation mut);
+      BulkMutation mut,
+      std::shared_ptr<MutationByteBudget> budget = nullptr);
+
+  static future<std::vector<FailedMutation>> Create(
+      CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      IdempotentMutationPolicy& idempotent_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::shared_ptr<bigtable::DataClient> client,
+      std::string const& app_profile_id, std::string const& table_name,
+      ArenaBulkMutation mut,
+      std::shared_ptr<MutationByteBudget> budget = nullptr);
+
+  /**
+   * Start the operation and return one `future<Status>` per mutation.
+   *
+   * The futures are in the same order as the mutations in @p mut. Each one
+   * is satisfied as soon as the outcome of its mutation is known: successes
+   * and permanent failures are reported as the entry results stream back,
+   * while the batch (and any retries) are still in flight. Mutations whose
+   * final state is never confirmed are completed when the retry loop gives
+   * up, with the status of the last attempt.
+   */
+  static std::vector<future<Status>> CreatePerMutation(
+      CompletionQueue cq, std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+      IdempotentMutationPolicy& idempotent_policy,
+      MetadataUpdatePolicy metadata_update_policy,
+      std::shared_ptr<bigtable::DataClient> client,
+      std::string const& app_profile_id, std::string const& table_name,
+      BulkMutation mut,
+      std::shared_ptr<MutationByteBudget> budget = nullptr);
 
  private:
   AsyncRetryBulkApply(std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
@@ -56,19 +93,42 @@ class AsyncRetryBulkApply
                       MetadataUpdatePolicy metadata_update_policy,
                       std::shared_ptr<bigtable::DataClient> client,
                       std::string const& app_profile_id,
-                      std::string const& table_name, BulkMutation mut);
+                      std::string const& table_name, BulkMutation mut,
+                      std::shared_ptr<MutationByteBudget> budget);
+
+  AsyncRetryBulkApply(std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+                      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+                      IdempotentMutationPolicy& idempotent_policy,
+                      MetadataUpdatePolicy metadata_update_policy,
+                      std::shared_ptr<bigtable::DataClient> client,
+                      std::string const& app_profile_id,
+                      std::string const& table_name, ArenaBulkMutation mut,
+                      std::shared_ptr<MutationByteBudget> budget);
 
   void StartIterationIfNeeded(CompletionQueue cq);
+  void StartIteration(CompletionQueue cq);
 
   void OnRead(google::bigtable::v2::MutateRowsResponse response);
   void OnFinish(CompletionQueue cq, google::cloud::Status status);
 
+  /// In per-mutation mode, satisfy the future for one mutation (only once).
+  void SatisfyMutation(int original_index, Status status);
+
   std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
   std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<bigtable::DataClient> client_;
   BulkMutatorState state_;
+  /// If set, each attempt is paced through this budget.
+  std::shared_ptr<MutationByteBudget> budget_;
+  /// The bytes acquired from `budget_` for the attempt in progress.
+  std::size_t acquired_bytes_;
   promise<std::vector<FailedMutation>> promise_;
+  /// One promise per mutation (by original index), only in per-mutation
+  /// mode; empty otherwise.
+  std::vector<promise<Status>> mutation_promises_;
+  /// Which promises in `mutation_promises_` have been satisfied already.
+  std::vector<bool> satisfied_;
 };
 
 }  // namespace internal
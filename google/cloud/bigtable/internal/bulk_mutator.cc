@@ -16,6 +16,7 @@
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/log.h"
+#include "absl/types/optional.h"
 #include <numeric>
 
 namespace google {
@@ -29,48 +30,74 @@ namespace btproto = google::bigtable::v2;
 BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
                                    std::string const& table_name,
                                    IdempotentMutationPolicy& idempotent_policy,
-                                   BulkMutation mut) {
-  // Every time the client library calls MakeOneRequest(), the data in the
-  // "pending_*" variables initializes the next request.  So in the constructor
-  // we start by putting the data on the "pending_*" variables.
-  // Move the mutations to the "pending" request proto, this is a zero copy
+                                   BulkMutation mut)
+    : mutations_(std::make_shared<btproto::MutateRowsRequest>()) {
+  // The precomputed bits are cleared by MoveTo(), copy them first.
+  auto const precomputed_idempotency = mut.entry_idempotency();
+  // Move the mutations to the request proto, this is a zero copy
   // optimization.
-  mut.MoveTo(&pending_mutations_);
-  pending_mutations_.set_app_profile_id(app_profile_id);
-  pending_mutations_.set_table_name(table_name);
+  mut.MoveTo(mutations_.get());
+  Initialize(app_profile_id, table_name, idempotent_policy,
+             precomputed_idempotency);
+}
+
+BulkMutatorState::BulkMutatorState(std::string const& app_profile_id,
+                                   std::string const& table_name,
+                                   IdempotentMutationPolicy& idempotent_policy,
+                                   ArenaBulkMutation mut)
+    : mutations_(std::move(mut).ReleaseRequest()) {
+  // `ArenaBulkMutation` builds the protos in place and does not track the
+  // idempotency of its entries; classify them by inspection.
+  Initialize(app_profile_id, table_name, idempotent_policy,
+             std::vector<bool>{});
+}
+
+void BulkMutatorState::Initialize(
+    std::string const& app_profile_id, std::string const& table_name,
+    IdempotentMutationPolicy& idempotent_policy,
+    std::vector<bool> const& precomputed_idempotency) {
+  mutations_->set_app_profile_id(app_profile_id);
+  mutations_->set_table_name(table_name);
 
   // As we receive successful responses, we shrink the size of the request (only
   // those pending are resent).  But if any fails we want to report their index
   // in the original sequence provided by the user. This vector maps from the
   // index in the current sequence of mutations to the index in the original
   // sequence of mutations.
-  pending_annotations_.reserve(pending_mutations_.entries_size());
+  annotations_.reserve(mutations_->entries_size());
 
   // We save the idempotency of each mutation, to be used later as we decide if
   // they should be retried or not.
   int index = 0;
-  for (auto const& e : pending_mutations_.entries()) {
-    // This is a giant && across all the mutations for each row.
-    auto r = std::all_of(e.mutations().begin(), e.mutations().end(),
-                         [&idempotent_policy](btproto::Mutation const& m) {
-                           return idempotent_policy.is_idempotent(m);
-                         });
-    pending_annotations_.push_back(Annotations{index++, r, false});
+  for (auto const& e : mutations_->entries()) {
+    // Prefer the bit computed when the mutation was built, if the policy can
+    // interpret it; this avoids walking the mutation protos again.
+    absl::optional<bool> precomputed;
+    auto const i = static_cast<std::size_t>(index);
+    if (i < precomputed_idempotency.size()) {
+      precomputed =
+          idempotent_policy.classify_precomputed(precomputed_idempotency[i]);
+    }
+    bool r;
+    if (precomputed.has_value()) {
+      r = *precomputed;
+    } else {
+      // This is a giant && across all the mutations for each row.
+      r = std::all_of(e.mutations().begin(), e.mutations().end(),
+                      [&idempotent_policy](btproto::Mutation const& m) {
+                        return idempotent_policy.is_idempotent(m);
+                      });
+    }
+    annotations_.push_back(Annotations{index++, r, false, false});
   }
 }
 
 google::bigtable::v2::MutateRowsRequest const& BulkMutatorState::BeforeStart() {
-  mutations_.Swap(&pending_mutations_);
-  annotations_.swap(pending_annotations_);
   for (auto& a : annotations_) {
     a.has_mutation_result = false;
+    a.retry = false;
   }
-  pending_mutations_ = {};
-  pending_mutations_.set_app_profile_id(mutations_.app_profile_id());
-  pending_mutations_.set_table_name(mutations_.table_name());
-  pending_annotations_ = {};
-
-  return mutations_;
+  return *mutations_;
 }
 
 std::vector<int> BulkMutatorState::OnRead(
@@ -102,14 +129,11 @@ std::vector<int> BulkMutatorState::OnRead(
       res.push_back(annotation.original_index);
       continue;
     }
-    auto& original = *mutations_.mutable_entries(static_cast<int>(index));
     // Failed responses are handled according to the current policies.
     if (SafeGrpcRetry::IsTransientFailure(code) && annotation.is_idempotent) {
-      // Retryable requests are saved in the pending mutations, along with the
-      // mapping from their index in pending_mutations_ to the original
-      // vector and other miscellanea.
-      pending_mutations_.add_entries()->Swap(&original);
-      pending_annotations_.push_back(annotation);
+      // Retryable requests stay in `mutations_` as-is; they are marked so
+      // that `RemoveResolvedMutations()` keeps them for the next attempt.
+      annotation.retry = true;
     } else {
       // Failures are saved for reporting, notice that we avoid copying, and
       // we use the original index in the first request, not the one where it
@@ -124,19 +148,14 @@ std::vector<int> BulkMutatorState::OnRead(
 void BulkMutatorState::OnFinish(google::cloud::Status finish_status) {
   last_status_ = std::move(finish_status);
 
-  int index = 0;
-  for (auto const& annotation : annotations_) {
+  for (auto& annotation : annotations_) {
     if (annotation.has_mutation_result) {
-      ++index;
       continue;
     }
     // If there are any mutations with unknown state, they need to be handled.
-    auto& original = *mutations_.mutable_entries(index);
     if (annotation.is_idempotent) {
-      // If the mutation was retryable, move it to the pending mutations to try
-      // again, along with their index.
-      pending_mutations_.add_entries()->Swap(&original);
-      pending_annotations_.push_back(annotation);
+      // If the mutation was retryable, keep it to try again.
+      annotation.retry = true;
     } else {
       if (last_status_.ok()) {
         google::cloud::Status status(
@@ -152,8 +171,29 @@ void BulkMutatorState::OnFinish(google::cloud::Status finish_status) {
             FailedMutation(last_status_, annotation.original_index));
       }
     }
-    ++index;
   }
+  RemoveResolvedMutations();
+}
+
+void BulkMutatorState::RemoveResolvedMutations() {
+  // Compact the request in place: keep the entries marked for retry,
+  // preserving their order, and drop the rest. The surviving entries are
+  // never copied or reserialized, `SwapElements()` just swaps pointers.
+  auto& entries = *mutations_->mutable_entries();
+  int dest = 0;
+  for (int i = 0; i != entries.size(); ++i) {
+    if (!annotations_[static_cast<std::size_t>(i)].retry) {
+      continue;
+    }
+    if (i != dest) {
+      entries.SwapElements(i, dest);
+      annotations_[static_cast<std::size_t>(dest)] =
+          annotations_[static_cast<std::size_t>(i)];
+    }
+    ++dest;
+  }
+  entries.DeleteSubrange(dest, entries.size() - dest);
+  annotations_.resize(static_cast<std::size_t>(dest));
 }
 
 std::vector<FailedMutation> BulkMutatorState::ConsumeAccumulatedFailures() {
@@ -165,9 +205,8 @@ std::vector<FailedMutation> BulkMutatorState::ConsumeAccumulatedFailures() {
 std::vector<FailedMutation> BulkMutatorState::OnRetryDone() && {
   std::vector<FailedMutation> result(std::move(failures_));
 
-  auto size = pending_mutations_.mutable_entries()->size();
-  for (int idx = 0; idx != size; idx++) {
-    int original_index = pending_annotations_[idx].original_index;
+  for (auto const& annotation : annotations_) {
+    int original_index = annotation.original_index;
     if (last_status_.ok()) {
       google::cloud::Status status(
           google::cloud::StatusCode::kInternal,
@@ -190,6 +229,12 @@ BulkMutator::BulkMutator(std::string const& app_profile_id,
                          BulkMutation mut)
     : state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
 
+BulkMutator::BulkMutator(std::string const& app_profile_id,
+                         std::string const& table_name,
+                         IdempotentMutationPolicy& idempotent_policy,
+                         ArenaBulkMutation mut)
+    : state_(app_profile_id, table_name, idempotent_policy, std::move(mut)) {}
+
 grpc::Status BulkMutator::MakeOneRequest(bigtable::DataClient& client,
                                          grpc::ClientContext& client_context) {
   // Send the request to the server.
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_BULK_MUTATOR_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_BULK_MUTATOR_H
 
+#include "google/cloud/bigtable/arena_bulk_mutation.h"
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
@@ -34,9 +35,15 @@ class BulkMutatorState {
                    IdempotentMutationPolicy& idempotent_policy,
                    BulkMutation mut);
 
-  bool HasPendingMutations() const {
-    return pending_mutations_.entries_size() != 0;
-  }
+  BulkMutatorState(std::string const& app_profile_id,
+                   std::string const& table_name,
+                   IdempotentMutationPolicy& idempotent_policy,
+                   ArenaBulkMutation mut);
+
+  bool HasPendingMutations() const { return mutations_->entries_size() != 0; }
+
+  /// The serialized size of the pending mutations, to size pacing budgets.
+  std::size_t PendingBytes() const { return mutations_->ByteSizeLong(); }
 
   /// Returns the Request parameter for the next MutateRows() RPC.
   google::bigtable::v2::MutateRowsRequest const& BeforeStart();
@@ -65,8 +72,30 @@ class BulkMutatorState {
   std::vector<FailedMutation> OnRetryDone() &&;
 
  private:
-  /// The current request proto.
-  google::bigtable::v2::MutateRowsRequest mutations_;
+  /// The part of construction common to both forms of the mutations.
+  void Initialize(std::string const& app_profile_id,
+                  std::string const& table_name,
+                  IdempotentMutationPolicy& idempotent_policy,
+                  std::vector<bool> const& precomputed_idempotency);
+
+  /**
+   * Remove the entries that succeeded or failed permanently.
+   *
+   * After this call the request contains only the mutations for the next
+   * attempt, still in their original relative order. The surviving entries
+   * are moved in place, never copied or reserialized.
+   */
+  void RemoveResolvedMutations();
+
+  /**
+   * The request proto.
+   *
+   * Entries resolved in previous attempts have been removed, the remaining
+   * entries are retried as-is. The shared pointer may alias an arena (for
+   * requests built with `ArenaBulkMutation`), keeping it alive for the
+   * duration of the operation.
+   */
+  std::shared_ptr<google::bigtable::v2::MutateRowsRequest> mutations_;
 
   /**
    * The status of the last MutateRows() RPC
@@ -98,16 +127,12 @@ class BulkMutatorState {
     bool is_idempotent;
     /// Set to `false` if the result is unknown.
     bool has_mutation_result;
+    /// The mutation failed transiently, keep it for the next attempt.
+    bool retry;
   };
 
-  /// The annotations about the current bulk request.
+  /// The annotations for `mutations_`, in the same order as its entries.
   std::vector<Annotations> annotations_;
-
-  /// Accumulate mutations for the next request.
-  google::bigtable::v2::MutateRowsRequest pending_mutations_;
-
-  /// Accumulate annotations for the next request.
-  std::vector<Annotations> pending_annotations_;
 };
 
 /// Keep the state in the Table::BulkApply() member function.
@@ -116,6 +141,10 @@ class BulkMutator {
   BulkMutator(std::string const& app_profile_id, std::string const& table_name,
               IdempotentMutationPolicy& idempotent_policy, BulkMutation mut);
 
+  BulkMutator(std::string const& app_profile_id, std::string const& table_name,
+              IdempotentMutationPolicy& idempotent_policy,
+              ArenaBulkMutation mut);
+
   /// Return true if there are pending mutations in the mutator
   bool HasPendingMutations() const { return state_.HasPendingMutations(); }
 
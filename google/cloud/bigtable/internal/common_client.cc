@@ -19,18 +19,23 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t id) {
+  auto args = options.channel_arguments();
+  if (!options.connection_pool_name().empty()) {
+    args.SetString("cbt-c++/connection-pool-name",
+                   options.connection_pool_name());
+  }
+  args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(id));
+  return grpc::CreateCustomChannel(endpoint, options.credentials(), args);
+}
+
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options) {
   std::vector<std::shared_ptr<grpc::Channel>> result;
   for (std::size_t i = 0; i != options.connection_pool_size(); ++i) {
-    auto args = options.channel_arguments();
-    if (!options.connection_pool_name().empty()) {
-      args.SetString("cbt-c++/connection-pool-name",
-                     options.connection_pool_name());
-    }
-    args.SetInt("cbt-c++/connection-pool-id", static_cast<int>(i));
-    result.push_back(
-        grpc::CreateCustomChannel(endpoint, options.credentials(), args));
+    result.push_back(CreateChannel(endpoint, options, i));
   }
   return result;
 }
@@ -17,7 +17,13 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/metrics.h"
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -25,6 +31,16 @@ namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
+/**
+ * Create a single grpc::Channel based on the client options.
+ *
+ * The @p id becomes a channel attribute, gRPC opens one socket per
+ * destination+attributes combo, so distinct ids create distinct sockets.
+ */
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    std::size_t id);
+
 /// Create a pool of grpc::Channel objects based on the client options.
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options);
@@ -54,7 +70,24 @@ class CommonClient {
   //@}
 
   explicit CommonClient(bigtable::ClientOptions options)
-      : options_(std::move(options)), current_index_(0) {}
+      : options_(std::move(options)),
+        current_index_(0),
+        next_channel_id_(0),
+        resizing_(false),
+        grow_events_(0),
+        shrink_events_(0) {}
+
+  /// Load and resizing metrics for the connection pool.
+  struct PoolMetrics {
+    /// Number of channels currently in the pool.
+    std::size_t pool_size;
+    /// RPCs currently holding a lease on a stub, see `OutstandingLeases()`.
+    std::size_t outstanding_rpcs;
+    /// Number of times the pool grew.
+    std::size_t grow_events;
+    /// Number of times the pool shrank.
+    std::size_t shrink_events;
+  };
 
   /**
    * Reset the channel and stub.
@@ -66,13 +99,17 @@ class CommonClient {
   void reset() {
     std::lock_guard<std::mutex> lk(mu_);
     stubs_.clear();
+    channel_rpcs_.clear();
   }
 
   /// Return the next Stub to make a call.
   StubPtr Stub() {
     std::unique_lock<std::mutex> lk(mu_);
     CheckConnections(lk);
-    auto stub = stubs_[GetIndex()];
+    MaybeResize(lk);
+    auto const index = GetIndex();
+    channel_rpcs_[index]->Increment();
+    auto stub = stubs_[index];
     return stub;
   }
 
@@ -80,10 +117,68 @@ class CommonClient {
   ChannelPtr Channel() {
     std::unique_lock<std::mutex> lk(mu_);
     CheckConnections(lk);
-    auto channel = channels_[GetIndex()];
+    MaybeResize(lk);
+    auto const index = GetIndex();
+    channel_rpcs_[index]->Increment();
+    auto channel = channels_[index];
     return channel;
   }
 
+  /// Return a snapshot of the pool load and resizing metrics.
+  PoolMetrics pool_metrics() {
+    std::lock_guard<std::mutex> lk(mu_);
+    PoolMetrics metrics{};
+    metrics.pool_size = stubs_.size();
+    for (auto const& stub : stubs_) {
+      metrics.outstanding_rpcs += OutstandingLeases(stub);
+    }
+    metrics.grow_events = grow_events_;
+    metrics.shrink_events = shrink_events_;
+    return metrics;
+  }
+
+  /**
+   * Replace the connection pool without disrupting requests in progress.
+   *
+   * Channels should be rotated before the server closes long-lived
+   * connections, but naively recreating the pool sends requests to channels
+   * that are still connecting. This function creates the replacement pool
+   * and warms it up — waiting up to @p warmup_timeout for each channel to
+   * become ready — before any lock is taken; requests keep landing on the
+   * current pool in the meantime. The new pool is then published in a single
+   * swap under the lock.
+   *
+   * The old channels are not closed explicitly. Requests in progress share
+   * ownership of their stub and channel, so they complete on the old
+   * connections and drain them naturally.
+   */
+  void RefreshChannels(
+      std::chrono::milliseconds warmup_timeout = std::chrono::seconds(30)) {
+    auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
+    auto const deadline = std::chrono::system_clock::now() + warmup_timeout;
+    for (auto const& channel : channels) {
+      // Start connecting and wait until the channel is ready. A channel that
+      // fails to connect in time is published anyway, gRPC retries the
+      // connection when the channel is first used.
+      channel->WaitForConnected(deadline);
+    }
+    auto stubs = CreateStubs(channels);
+    std::vector<ChannelPtr> old_channels;
+    std::vector<StubPtr> old_stubs;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      old_channels.swap(channels_);
+      old_stubs.swap(stubs_);
+      channels_ = std::move(channels);
+      stubs_ = std::move(stubs);
+      current_index_ = 0;
+      next_channel_id_ = channels_.size();
+      SyncChannelCounters();
+    }
+    // The old pool is released here, outside the lock, because the last
+    // reference to a channel may trigger (comparatively slow) cleanups.
+  }
+
  private:
   /// Make sure the connections exit, and create them if needed.
   void CheckConnections(std::unique_lock<std::mutex>& lk) {
@@ -102,16 +197,14 @@ class CommonClient {
     // create one socket per element in the pool.
     lk.unlock();
     auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
-    std::vector<StubPtr> tmp;
-    std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
-                   [](std::shared_ptr<grpc::Channel> ch) {
-                     return Interface::NewStub(ch);
-                   });
+    auto tmp = CreateStubs(channels);
     lk.lock();
     if (stubs_.empty()) {
       channels.swap(channels_);
       tmp.swap(stubs_);
       current_index_ = 0;
+      next_channel_id_ = channels_.size();
+      SyncChannelCounters();
     } else {
       // Some other thread created the pool and saved it in `stubs_`. The work
       // in this thread was superfluous. We release the lock while clearing the
@@ -123,8 +216,98 @@ class CommonClient {
     }
   }
 
+  /**
+   * Estimate the number of RPCs using @p stub.
+   *
+   * `Stub()` returns a shared pointer, and callers hold it for (at least the
+   * start of) their RPC, so the use count — minus the reference in `stubs_`
+   * — approximates the number of outstanding calls on the channel. The
+   * count is inherently racy, which is acceptable for a load signal.
+   */
+  static std::size_t OutstandingLeases(StubPtr const& stub) {
+    auto const count = stub.use_count();
+    return count > 1 ? static_cast<std::size_t>(count - 1) : 0;
+  }
+
+  /**
+   * Grow or shrink the pool based on the current load.
+   *
+   * Does nothing unless `ClientOptions::set_max_connection_pool_size()`
+   * enabled resizing. The pool grows (one channel at a time) while every
+   * channel has two or more outstanding calls, and shrinks back towards the
+   * configured size when fewer than one in four channels is in use. The gap
+   * between the two thresholds provides hysteresis, without it the pool
+   * would oscillate around the current load.
+   *
+   * Requires `lk` to be held, may release and reacquire it.
+   */
+  void MaybeResize(std::unique_lock<std::mutex>& lk) {
+    auto const max_size = options_.max_connection_pool_size();
+    if (max_size == 0 || resizing_ || stubs_.empty()) {
+      return;
+    }
+    std::size_t total = 0;
+    std::size_t min_outstanding = (std::numeric_limits<std::size_t>::max)();
+    for (auto const& stub : stubs_) {
+      auto const outstanding = OutstandingLeases(stub);
+      total += outstanding;
+      min_outstanding = (std::min)(min_outstanding, outstanding);
+    }
+    if (min_outstanding >= 2 && stubs_.size() < max_size) {
+      resizing_ = true;
+      auto const id = next_channel_id_++;
+      // Release the lock while creating the channel, see the comments in
+      // CheckConnections(). `resizing_` keeps other threads from resizing
+      // concurrently.
+      lk.unlock();
+      auto channel = CreateChannel(Traits::Endpoint(options_), options_, id);
+      auto stub = Interface::NewStub(channel);
+      lk.lock();
+      channels_.push_back(std::move(channel));
+      stubs_.push_back(std::move(stub));
+      SyncChannelCounters();
+      ++grow_events_;
+      resizing_ = false;
+      return;
+    }
+    if (stubs_.size() > options_.connection_pool_size() &&
+        total * 4 <= stubs_.size()) {
+      resizing_ = true;
+      auto channel = std::move(channels_.back());
+      channels_.pop_back();
+      auto stub = std::move(stubs_.back());
+      stubs_.pop_back();
+      if (current_index_ >= stubs_.size()) {
+        current_index_ = 0;
+      }
+      SyncChannelCounters();
+      ++shrink_events_;
+      // Release the removed channel outside the lock; calls in progress
+      // share ownership and drain it naturally.
+      lk.unlock();
+      stub.reset();
+      channel.reset();
+      lk.lock();
+      resizing_ = false;
+    }
+  }
+
+  /// Create the stubs for a pool of channels.
+  static std::vector<StubPtr> CreateStubs(
+      std::vector<ChannelPtr> const& channels) {
+    std::vector<StubPtr> stubs;
+    std::transform(channels.begin(), channels.end(), std::back_inserter(stubs),
+                   [](std::shared_ptr<grpc::Channel> ch) {
+                     return Interface::NewStub(ch);
+                   });
+    return stubs;
+  }
+
   /// Get the current index for round-robin over connections.
   std::size_t GetIndex() {
+    if (options_.channel_affinity()) {
+      return AffinityIndex();
+    }
     std::size_t current = current_index_++;
     // Round robin through the connections.
     if (current_index_ >= stubs_.size()) {
@@ -133,12 +316,61 @@ class CommonClient {
     return current;
   }
 
+  /**
+   * Map the calling thread to one channel of the pool.
+   *
+   * Each thread receives a distinct ordinal on its first call and then uses
+   * the channel at `ordinal % pool_size`. A channel's state stays in the
+   * caches of the cores running the (few) threads bound to it, instead of
+   * bouncing between all the cores as it does under round-robin. The binding
+   * rotates to the next channel every `kRotationPeriod` calls, which slowly
+   * evens out any imbalance in per-thread traffic without giving up the
+   * locality. Changes in the pool size reshuffle the bindings, that is rare
+   * enough not to matter.
+   */
+  std::size_t AffinityIndex() {
+    std::size_t constexpr kRotationPeriod = 1024;
+    static std::atomic<std::size_t> ordinals(0);
+    thread_local std::size_t const ordinal = ordinals++;
+    thread_local std::size_t calls = 0;
+    return (ordinal + calls++ / kRotationPeriod) % stubs_.size();
+  }
+
+  /**
+   * Keep `channel_rpcs_` aligned with `stubs_`.
+   *
+   * Each position of the pool gets a counter in the process-wide metrics
+   * registry, named by the position so the per-channel spread of traffic is
+   * visible in a snapshot. Registry metrics live for the whole process, so
+   * the cached pointers stay valid across pool refreshes, and all the
+   * clients in a process aggregate into the same counters.
+   *
+   * Requires `mu_` to be held.
+   */
+  void SyncChannelCounters() {
+    auto& registry = google::cloud::internal::MetricsRegistry::Instance();
+    for (auto i = channel_rpcs_.size(); i < stubs_.size(); ++i) {
+      channel_rpcs_.push_back(&registry.Counter(
+          "bigtable.pool.channel." + std::to_string(i) + ".rpcs"));
+    }
+    channel_rpcs_.resize(stubs_.size());
+  }
+
  private:
   std::mutex mu_;
   ClientOptions options_;
   std::vector<ChannelPtr> channels_;
   std::vector<StubPtr> stubs_;
+  /// Per-position RPC counters, parallel to `stubs_`.
+  std::vector<google::cloud::internal::MetricCounter*> channel_rpcs_;
   std::size_t current_index_;
+  /// The attribute for the next dynamically created channel, never reused so
+  /// each channel gets its own socket.
+  std::size_t next_channel_id_;
+  /// A resize is in progress (possibly with `mu_` released).
+  bool resizing_;
+  std::size_t grow_events_;
+  std::size_t shrink_events_;
 };
 
 }  // namespace internal
@@ -0,0 +1,118 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/common_client.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = ::google::bigtable::v2;
+
+namespace {
+
+struct TestTraits {
+  static std::string const& Endpoint(bigtable::ClientOptions& options) {
+    return options.data_endpoint();
+  }
+};
+
+using CommonClientForTest =
+    bigtable::internal::CommonClient<TestTraits, btproto::Bigtable>;
+
+bigtable::ClientOptions TestOptions() {
+  // The tests do not contact the endpoint, any address works.
+  return bigtable::ClientOptions(grpc::InsecureChannelCredentials())
+      .set_data_endpoint("localhost:1")
+      .set_connection_pool_size(2);
+}
+
+TEST(CommonClientTest, RefreshReplacesThePool) {
+  CommonClientForTest client(TestOptions());
+
+  auto stub = client.Stub();
+  auto channel = client.Channel();
+  ASSERT_TRUE(stub);
+  ASSERT_TRUE(channel);
+
+  // Use a minimal warmup timeout, the endpoint is not reachable and the test
+  // should not wait for it.
+  client.RefreshChannels(std::chrono::milliseconds(1));
+
+  // The pool is new, but the old stub and channel remain usable for calls
+  // that were in progress during the refresh.
+  EXPECT_NE(stub.get(), client.Stub().get());
+  EXPECT_NE(channel.get(), client.Channel().get());
+  EXPECT_TRUE(stub);
+  EXPECT_TRUE(channel);
+}
+
+TEST(CommonClientTest, NoResizingByDefault) {
+  CommonClientForTest client(TestOptions().set_connection_pool_size(1));
+  auto s1 = client.Stub();
+  auto s2 = client.Stub();
+  auto s3 = client.Stub();
+  auto metrics = client.pool_metrics();
+  EXPECT_EQ(1U, metrics.pool_size);
+  EXPECT_EQ(0U, metrics.grow_events);
+  EXPECT_EQ(0U, metrics.shrink_events);
+}
+
+TEST(CommonClientTest, GrowsAndShrinksWithinBounds) {
+  auto options = TestOptions().set_connection_pool_size(1);
+  options.set_max_connection_pool_size(3);
+  CommonClientForTest client(options);
+
+  // Holding the result of `Stub()` counts as an outstanding call.
+  auto s1 = client.Stub();
+  auto s2 = client.Stub();
+  EXPECT_EQ(s1.get(), s2.get());
+  auto metrics = client.pool_metrics();
+  EXPECT_EQ(1U, metrics.pool_size);
+  EXPECT_EQ(2U, metrics.outstanding_rpcs);
+
+  // With two outstanding calls on every channel the pool grows.
+  auto s3 = client.Stub();
+  metrics = client.pool_metrics();
+  EXPECT_EQ(2U, metrics.pool_size);
+  EXPECT_EQ(1U, metrics.grow_events);
+
+  // Releasing the calls lets the pool shrink back to the configured size.
+  s1.reset();
+  s2.reset();
+  s3.reset();
+  client.Stub();
+  metrics = client.pool_metrics();
+  EXPECT_EQ(1U, metrics.pool_size);
+  EXPECT_EQ(1U, metrics.shrink_events);
+}
+
+TEST(CommonClientTest, ChannelAffinityIsStablePerThread) {
+  CommonClientForTest client(TestOptions().set_channel_affinity(true));
+
+  // Under round-robin consecutive calls alternate between the two channels
+  // of the pool; with affinity this thread keeps hitting the same one.
+  auto stub = client.Stub();
+  for (int i = 0; i != 10; ++i) {
+    EXPECT_EQ(stub.get(), client.Stub().get());
+  }
+}
+
+TEST(CommonClientTest, RefreshBeforeFirstUseCreatesThePool) {
+  CommonClientForTest client(TestOptions());
+  client.RefreshChannels(std::chrono::milliseconds(1));
+  EXPECT_TRUE(client.Stub());
+  EXPECT_TRUE(client.Channel());
+}
+
+}  // anonymous namespace
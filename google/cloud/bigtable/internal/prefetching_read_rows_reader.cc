@@ -0,0 +1,100 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/prefetching_read_rows_reader.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+std::size_t constexpr PrefetchingReadRowsReader::kDefaultQueueDepth;
+
+PrefetchingReadRowsReader::PrefetchingReadRowsReader(
+    std::unique_ptr<
+        grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
+        stream,
+    std::size_t queue_depth)
+    : stream_(std::move(stream)), queue_depth_(queue_depth) {
+  reader_ = std::thread([this] { ReadLoop(); });
+}
+
+PrefetchingReadRowsReader::~PrefetchingReadRowsReader() { Shutdown(); }
+
+bool PrefetchingReadRowsReader::Read(
+    google::bigtable::v2::ReadRowsResponse* response) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return stream_done_ || !ready_.empty(); });
+  if (ready_.empty()) return false;
+  *response = std::move(ready_.front());
+  ready_.pop_front();
+  lk.unlock();
+  // There is room in the queue again, wake up the background thread.
+  cv_.notify_all();
+  return true;
+}
+
+grpc::Status PrefetchingReadRowsReader::Finish() {
+  Shutdown();
+  return stream_->Finish();
+}
+
+bool PrefetchingReadRowsReader::NextMessageSize(std::uint32_t* sz) {
+  // Only meaningful between messages; callers that use this cannot benefit
+  // from prefetching, and `RowReader` does not call it.
+  return stream_->NextMessageSize(sz);
+}
+
+void PrefetchingReadRowsReader::WaitForInitialMetadata() {
+  stream_->WaitForInitialMetadata();
+}
+
+void PrefetchingReadRowsReader::ReadLoop() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk,
+               [this] { return shutdown_ || ready_.size() < queue_depth_; });
+      if (shutdown_) return;
+    }
+    google::bigtable::v2::ReadRowsResponse response;
+    bool const ok = stream_->Read(&response);
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!ok) {
+      stream_done_ = true;
+      lk.unlock();
+      cv_.notify_all();
+      return;
+    }
+    ready_.push_back(std::move(response));
+    lk.unlock();
+    cv_.notify_all();
+  }
+}
+
+void PrefetchingReadRowsReader::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  if (reader_.joinable()) reader_.join();
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,97 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PREFETCHING_READ_ROWS_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PREFETCHING_READ_ROWS_READER_H
+
+#include "google/cloud/bigtable/version.h"
+#include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <grpcpp/grpcpp.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * A `ReadRows` stream that reads ahead of its caller.
+ *
+ * `RowReader` reads a response, parses its chunks, and hands rows to the
+ * application strictly in sequence, so while the application processes a
+ * row nobody is waiting on the network. This decorator runs `Read()` on a
+ * background thread and keeps a small, bounded queue of responses ready,
+ * overlapping the transfer of the next batch with the parsing of the
+ * current one.
+ *
+ * As with the stream it wraps, the caller must either read until `Read()`
+ * returns `false` or cancel the `grpc::ClientContext` associated with the
+ * stream before destroying this object, otherwise the destructor blocks
+ * waiting for the `Read()` the background thread has in flight.
+ *
+ * `Read()` and `Finish()` synchronize with the background thread, but are
+ * not safe to call concurrently with each other.
+ */
+class PrefetchingReadRowsReader : public grpc::ClientReaderInterface<
+                                      google::bigtable::v2::ReadRowsResponse> {
+ public:
+  /// How many responses are buffered ahead of the caller.
+  static std::size_t constexpr kDefaultQueueDepth = 2;
+
+  explicit PrefetchingReadRowsReader(
+      std::unique_ptr<
+          grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
+          stream,
+      std::size_t queue_depth = kDefaultQueueDepth);
+
+  ~PrefetchingReadRowsReader() override;
+
+  bool Read(google::bigtable::v2::ReadRowsResponse* response) override;
+  grpc::Status Finish() override;
+  bool NextMessageSize(std::uint32_t* sz) override;
+  void WaitForInitialMetadata() override;
+
+ private:
+  /// The body of the background thread.
+  void ReadLoop();
+  /// Wake up and join the background thread.
+  void Shutdown();
+
+  std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
+      stream_;
+  std::size_t queue_depth_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  /// Responses read ahead of the caller, protected by `mu_`.
+  std::deque<google::bigtable::v2::ReadRowsResponse> ready_;
+  /// `stream_->Read()` returned `false`, protected by `mu_`.
+  bool stream_done_ = false;
+  /// Tells the background thread to stop reading, protected by `mu_`.
+  bool shutdown_ = false;
+
+  std::thread reader_;
+};
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PREFETCHING_READ_ROWS_READER_H
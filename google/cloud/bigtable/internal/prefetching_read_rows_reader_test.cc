@@ -0,0 +1,98 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/prefetching_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include <gmock/gmock.h>
+#include <future>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using google::bigtable::v2::ReadRowsResponse;
+using google::cloud::bigtable::testing::MockReadRowsReader;
+using testing::_;
+using testing::DoAll;
+using testing::Return;
+using testing::SetArgPointee;
+
+ReadRowsResponse MakeResponse(std::string last_scanned_row_key) {
+  ReadRowsResponse response;
+  response.set_last_scanned_row_key(std::move(last_scanned_row_key));
+  return response;
+}
+
+TEST(PrefetchingReadRowsReaderTest, DeliversResponsesInOrder) {
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(MakeResponse("r1")), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<0>(MakeResponse("r2")), Return(true)))
+      .WillOnce(DoAll(SetArgPointee<0>(MakeResponse("r3")), Return(true)))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "fail")));
+
+  PrefetchingReadRowsReader reader(stream->AsUniqueMocked());
+  ReadRowsResponse response;
+  for (auto const* expected : {"r1", "r2", "r3"}) {
+    ASSERT_TRUE(reader.Read(&response));
+    EXPECT_EQ(expected, response.last_scanned_row_key());
+  }
+  EXPECT_FALSE(reader.Read(&response));
+  auto status = reader.Finish();
+  EXPECT_EQ(grpc::StatusCode::INTERNAL, status.error_code());
+  EXPECT_EQ("fail", status.error_message());
+}
+
+TEST(PrefetchingReadRowsReaderTest, ReadsAheadOfCaller) {
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  std::promise<void> first_read;
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce([&first_read](ReadRowsResponse*) {
+        first_read.set_value();
+        return true;
+      })
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  PrefetchingReadRowsReader reader(stream->AsUniqueMocked());
+  // The background thread issues Read() calls without any Read() on our part.
+  first_read.get_future().get();
+  ReadRowsResponse response;
+  EXPECT_TRUE(reader.Read(&response));
+  EXPECT_FALSE(reader.Read(&response));
+  EXPECT_TRUE(reader.Finish().ok());
+}
+
+TEST(PrefetchingReadRowsReaderTest, DestructorJoinsWithoutFinish) {
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(MakeResponse("r1")), Return(true)))
+      .WillOnce(Return(false));
+
+  // The test verifies this does not deadlock (or leak the thread) even
+  // though neither Read() nor Finish() are ever called.
+  PrefetchingReadRowsReader reader(stream->AsUniqueMocked());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
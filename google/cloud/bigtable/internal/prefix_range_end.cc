@@ -21,20 +21,25 @@ inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 
 std::string PrefixRangeEnd(std::string const& key) {
+  std::string result = key;
+  PrefixRangeEndInPlace(result);
+  return result;
+}
+
+void PrefixRangeEndInPlace(std::string& key) {
   auto pos = key.find_last_not_of('\xFF');
   if (pos == std::string::npos) {
     // If key is all \xFF then any sequence higher than key starts with the
     // same number of \xFF.  So the end of the range is +infinity, which is
     // represented by the empty string.
-    return std::string();
+    key.clear();
+    return;
   }
   // Generally just take the last byte and increment by 1, but if there are
   // trailing \xFF byte we need to turn those into zeroes and increment the last
   // byte that is not a \xFF.
-  std::string result = key;
-  std::fill(std::begin(result) + pos + 1, std::end(result), '\0');
-  result[pos]++;
-  return result;
+  std::fill(std::begin(key) + pos + 1, std::end(key), '\0');
+  key[pos]++;
 }
 
 }  // namespace internal
@@ -33,6 +33,16 @@ namespace internal {
  */
 std::string PrefixRangeEnd(std::string const& key);
 
+/**
+ * Compute the end of the prefix range for @p key in place.
+ *
+ * Overwrites @p key with the end of its prefix range, without allocating a
+ * new buffer. Callers that construct many ranges --- such as the scan
+ * sharder --- use this form to avoid a temporary string per range. An empty
+ * result means the range extends to +infinity.
+ */
+void PrefixRangeEndInPlace(std::string& key);
+
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -35,3 +35,18 @@ TEST(PrefixRangeEndTest, MostlyFFs) {
   auto actual = bigtable::internal::PrefixRangeEnd(std::string(mostly_ff, 3));
   EXPECT_EQ(std::string(expected, 3), actual);
 }
+
+TEST(PrefixRangeEndTest, InPlace) {
+  // This test assumes ASCII.
+  std::string key = "foo/";
+  bigtable::internal::PrefixRangeEndInPlace(key);
+  EXPECT_EQ("foo0", key);
+
+  key = std::string("\xA0\xFF\xFF", 3);
+  bigtable::internal::PrefixRangeEndInPlace(key);
+  EXPECT_EQ(std::string("\xA1\x00\x00", 3), key);
+
+  key = std::string("\xFF\xFF\xFF", 3);
+  bigtable::internal::PrefixRangeEndInPlace(key);
+  EXPECT_EQ("", key);
+}
@@ -45,6 +45,16 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
     swap(*chunk.mutable_row_key(), cell_.row);
   }
 
+  // When a cell completes, its column is moved into the new `Cell` instead
+  // of copied. Restore it from that cell if this chunk reuses it. The family
+  // is never moved, cells reference an interned copy, see `families_`.
+  if (cell_strings_moved_) {
+    if (!chunk.has_qualifier()) {
+      cell_.column = cells_.back().column_qualifier();
+    }
+    cell_strings_moved_ = false;
+  }
+
   if (chunk.has_family_name()) {
     if (!chunk.has_qualifier()) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -62,12 +72,33 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
 
   if (cell_first_chunk_) {
     cell_.timestamp = chunk.timestamp_micros();
+    // A positive `value_size` on the first chunk is the total size of a
+    // cell split across chunks; large enough cells stream to the sink
+    // instead of accumulating, see `CellValueSink`.
+    streaming_cell_ =
+        value_sink_ && chunk.value_size() > 0 &&
+        static_cast<std::size_t>(chunk.value_size()) >= large_cell_threshold_;
+    if (streaming_cell_) {
+      // The fragments repeat the row key; the first cell of a row carries
+      // it in `cell_.row`, later cells leave it empty and share `row_key_`.
+      streaming_row_key_ = cell_.row;
+      if (streaming_row_key_.empty() && row_key_) {
+        streaming_row_key_ = *row_key_;
+      }
+    }
   }
 
   std::move(chunk.mutable_labels()->begin(), chunk.mutable_labels()->end(),
             std::back_inserter(cell_.labels));
 
-  if (cell_first_chunk_) {
+  if (streaming_cell_) {
+    // Hand the fragment to the sink instead of accumulating it; the `Cell`
+    // emitted into the row keeps an empty value.
+    value_sink_(CellValueFragment{streaming_row_key_, cell_.family,
+                                  cell_.column, cell_.timestamp,
+                                  std::move(*chunk.mutable_value()),
+                                  chunk.value_size() == 0});
+  } else if (cell_first_chunk_) {
     // Most common case, move the value
     using std::swap;
     swap(*chunk.mutable_value(), cell_.value);
@@ -79,7 +110,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
 
   // This is a hint we get about the total size, use it to save some memory
   // allocations.
-  if (chunk.value_size() > 0) {
+  if (!streaming_cell_ && chunk.value_size() > 0) {
     internal::ReserveCellValue(cell_.value,
                                static_cast<std::size_t>(chunk.value_size()));
   }
@@ -92,21 +123,25 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                               "Missing row key at last chunk in cell");
         return;
       }
-      row_key_ = cell_.row;
-    } else {
-      if (row_key_ != cell_.row) {
-        status = grpc::Status(grpc::StatusCode::INTERNAL,
-                              "Different row key in cell chunk");
-        return;
-      }
+      row_key_ = std::make_shared<RowKeyType>(std::move(cell_.row));
+    } else if (!cell_.row.empty() && *row_key_ != cell_.row) {
+      // `cell_.row` is only set when a chunk explicitly carried a row key,
+      // chunks that continue the current row leave it empty.
+      status = grpc::Status(grpc::StatusCode::INTERNAL,
+                            "Different row key in cell chunk");
+      return;
     }
+    cell_.row.clear();
     cells_.emplace_back(MovePartialToCell());
     cell_first_chunk_ = true;
+    cell_strings_moved_ = true;
+    streaming_cell_ = false;
   }
 
   if (chunk.reset_row()) {
     cells_.clear();
     cell_ = {};
+    cell_strings_moved_ = false;
     if (!cell_first_chunk_) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Reset row with an unfinished cell");
@@ -123,8 +158,15 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "Commit row missing the row key");
       return;
     }
+    if (cell_strings_moved_) {
+      // The next row may continue with the same column, but the committed
+      // cells are about to be given away; copy it back now. This is one copy
+      // per row instead of one per cell.
+      cell_.column = cells_.back().column_qualifier();
+      cell_strings_moved_ = false;
+    }
     row_ready_ = true;
-    last_seen_row_key_ = row_key_;
+    last_seen_row_key_ = *row_key_;
     cell_.row.clear();
   }
 }
@@ -160,19 +202,40 @@ Row ReadRowsParser::Next(grpc::Status& status) {
   }
   row_ready_ = false;
 
-  Row row(std::move(row_key_), std::move(cells_));
-  row_key_.clear();
+  // The cells share ownership of the row key, the `Row` gets its own copy.
+  Row row(*row_key_, std::move(cells_));
+  cells_.clear();
 
   return row;
 }
 
 Cell ReadRowsParser::MovePartialToCell() {
-  // The row, family, and column are explicitly copied because the
-  // ReadRows v2 may reuse them in future chunks. See the CellChunk
-  // message comments in bigtable.proto.
-  Cell cell(cell_.row, cell_.family, cell_.column, cell_.timestamp,
-            std::move(cell_.value), std::move(cell_.labels));
+  // Look up the interned copy of the family name, creating one on the first
+  // use of each family. Tables have a handful of families, a linear search
+  // beats any fancier data structure at this size. The name itself stays in
+  // `cell_.family` because later chunks may reuse it.
+  std::shared_ptr<std::string const> family;
+  for (auto const& interned : families_) {
+    if (*interned == cell_.family) {
+      family = interned;
+      break;
+    }
+  }
+  if (!family) {
+    family = std::make_shared<std::string>(cell_.family);
+    families_.push_back(family);
+  }
+
+  // The ReadRows v2 protocol may reuse the column in future chunks, but
+  // copying it for every cell is wasteful when it changes with (almost)
+  // every cell, as it does in many workloads. Move it into the cell and copy
+  // it back only if a chunk actually reuses it, see `cell_strings_moved_`.
+  // The row key is shared by every cell in the row.
+  Cell cell(row_key_, std::move(family), std::move(cell_.column),
+            cell_.timestamp, std::move(cell_.value), std::move(cell_.labels));
+  cell_.column.clear();
   cell_.value.clear();
+  cell_.labels.clear();
   return cell;
 }
 }  // namespace internal
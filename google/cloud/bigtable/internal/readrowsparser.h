@@ -20,6 +20,10 @@
 #include "google/cloud/bigtable/version.h"
 #include "absl/memory/memory.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace google {
@@ -27,6 +31,33 @@ namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
+/**
+ * A fragment of a chunked cell value, delivered as it arrives.
+ *
+ * Cells larger than a single `ReadRows` response are split into multiple
+ * chunks by the service. A `CellValueSink` receives each fragment as it is
+ * parsed, so the application never holds more than one fragment of the
+ * value in memory. The metadata fields repeat on every fragment of a cell.
+ */
+struct CellValueFragment {
+  RowKeyType row_key;
+  std::string family_name;
+  ColumnQualifierType column_qualifier;
+  std::int64_t timestamp;
+  /// The bytes of this fragment, in row order within the cell.
+  std::string value;
+  /// True on the last fragment of the cell.
+  bool last_fragment;
+};
+
+/**
+ * Receives the fragments of large cell values.
+ *
+ * The sink is called from the thread driving the parser, before the row
+ * containing the cell becomes available.
+ */
+using CellValueSink = std::function<void(CellValueFragment)>;
+
 /**
  * Transforms a stream of chunks as returned by the ReadRows streaming
  * RPC into a sequence of rows.
@@ -51,7 +82,21 @@ namespace internal {
  */
 class ReadRowsParser {
  public:
-  ReadRowsParser() : row_key_(""), last_seen_row_key_("") {}
+  ReadRowsParser() : last_seen_row_key_("") {}
+
+  /**
+   * Create a parser that streams large cell values to @p value_sink.
+   *
+   * A cell whose first chunk announces a total value size of at least
+   * @p large_cell_threshold bytes is not accumulated; its value is handed
+   * to @p value_sink one fragment at a time instead, and the `Cell` emitted
+   * into the row carries an empty value. Cells below the threshold, and
+   * cells that fit in a single chunk, are unaffected.
+   */
+  ReadRowsParser(CellValueSink value_sink, std::size_t large_cell_threshold)
+      : last_seen_row_key_(""),
+        value_sink_(std::move(value_sink)),
+        large_cell_threshold_(large_cell_threshold) {}
 
   virtual ~ReadRowsParser() = default;
 
@@ -105,14 +150,20 @@ class ReadRowsParser {
   /**
    * Moves partial results into a Cell class.
    *
-   * Also helps handle string ownership correctly. The value is moved
-   * when converting to a result cell, but the key, family and column
-   * are copied, because they are possibly reused by following cells.
+   * Also helps handle string ownership correctly. The column and value are
+   * moved when converting to a result cell. The row key and the family name
+   * are shared: every cell in the row holds a reference to the same row key,
+   * and every cell in the stream holds a reference to the interned copy of
+   * its family name (see `families_`).
    */
   Cell MovePartialToCell();
 
-  /// Row key for the current row.
-  RowKeyType row_key_;
+  /// Row key for the current row, shared by all the cells in the row.
+  std::shared_ptr<RowKeyType const> row_key_;
+
+  /// Interned family names. Tables have a handful of families, every cell
+  /// holds a reference to one of these entries instead of its own copy.
+  std::vector<std::shared_ptr<std::string const>> families_;
 
   /// Parsed cells of a yet unfinished row.
   std::vector<Cell> cells_;
@@ -123,6 +174,10 @@ class ReadRowsParser {
   /// Stores partial fields.
   ParseCell cell_;
 
+  /// The column of `cell_` was moved into the last element of `cells_`; it
+  /// must be copied back if a chunk reuses it.
+  bool cell_strings_moved_{false};
+
   /// Set when a row is ready.
   RowKeyType last_seen_row_key_;
 
@@ -131,6 +186,18 @@ class ReadRowsParser {
 
   /// Have we received the end of stream call?
   bool end_of_stream_{false};
+
+  /// Receives the fragments of large cell values, may be empty.
+  CellValueSink value_sink_;
+
+  /// Cells at least this large stream to `value_sink_`.
+  std::size_t large_cell_threshold_{0};
+
+  /// Is the current cell being streamed to `value_sink_`?
+  bool streaming_cell_{false};
+
+  /// The row key of the cell being streamed, repeated on every fragment.
+  RowKeyType streaming_row_key_;
 };
 
 /// Factory for creating parser instances, defined for testability.
@@ -143,6 +210,31 @@ class ReadRowsParserFactory {
     return absl::make_unique<ReadRowsParser>();
   }
 };
+
+/**
+ * Creates parsers that stream large cell values to a sink.
+ *
+ * Pass an instance to the `RowReader` constructor to read tables with
+ * multi-MB cells in bounded memory: cells at least @p large_cell_threshold
+ * bytes reach the application as a sequence of `CellValueFragment` calls
+ * instead of a contiguous value.
+ */
+class StreamingReadRowsParserFactory : public ReadRowsParserFactory {
+ public:
+  StreamingReadRowsParserFactory(CellValueSink value_sink,
+                                 std::size_t large_cell_threshold)
+      : value_sink_(std::move(value_sink)),
+        large_cell_threshold_(large_cell_threshold) {}
+
+  std::unique_ptr<ReadRowsParser> Create() override {
+    return absl::make_unique<ReadRowsParser>(value_sink_,
+                                             large_cell_threshold_);
+  }
+
+ private:
+  CellValueSink value_sink_;
+  std::size_t large_cell_threshold_;
+};
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -96,6 +96,108 @@ TEST(ReadRowsParserTest, SingleChunkSucceeds) {
   EXPECT_TRUE(status.ok());
 }
 
+TEST(ReadRowsParserTest, FamilyAndQualifierContinueAcrossRows) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  ReadRowsResponse_CellChunk chunk;
+  std::string chunk1 = R"(
+    row_key: "RK_1"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    value: "V_1"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto row1 = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+
+  // The second row omits the family and qualifier, they continue from the
+  // previous chunk even across the row boundary.
+  std::string chunk2 = R"(
+    row_key: "RK_2"
+    timestamp_micros: 42
+    value: "V_2"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk2, &chunk));
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto row2 = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, row2.cells().size());
+  auto cell_it = row2.cells().begin();
+  EXPECT_EQ("RK_2", cell_it->row_key());
+  EXPECT_EQ("F", cell_it->family_name());
+  EXPECT_EQ("C", cell_it->column_qualifier());
+  EXPECT_EQ("V_2", cell_it->value());
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(ReadRowsParserTest, CellsShareRowKeyAndFamilyStorage) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  ReadRowsResponse_CellChunk chunk;
+  std::string chunk1 = R"(
+    row_key: "RK_1"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    value: "V_1"
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  std::string chunk2 = R"(
+    qualifier: < value: "C2">
+    timestamp_micros: 42
+    value: "V_2"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk2, &chunk));
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto row1 = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(2U, row1.cells().size());
+
+  // The cells in a row share a single copy of the row key and of the family
+  // name, instead of each cell holding its own.
+  EXPECT_EQ(&row1.cells()[0].row_key(), &row1.cells()[1].row_key());
+  EXPECT_EQ(&row1.cells()[0].family_name(), &row1.cells()[1].family_name());
+
+  // Family names are interned for the whole stream, the next row references
+  // the same copy even though its chunk names the family explicitly.
+  std::string chunk3 = R"(
+    row_key: "RK_2"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    value: "V_3"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk3, &chunk));
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  auto row2 = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, row2.cells().size());
+  EXPECT_EQ(&row1.cells()[0].family_name(), &row2.cells()[0].family_name());
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
 TEST(ReadRowsParserTest, NextAfterEndOfStreamSucceeds) {
   using google::protobuf::TextFormat;
   ReadRowsParser parser;
@@ -133,6 +235,155 @@ TEST(ReadRowsParserTest, NextWithNoDataThrows) {
   EXPECT_FALSE(status.ok());
 }
 
+TEST(ReadRowsParserTest, StreamingSinkReceivesLargeCellFragments) {
+  using google::cloud::bigtable::internal::CellValueFragment;
+  using google::protobuf::TextFormat;
+  std::vector<CellValueFragment> fragments;
+  ReadRowsParser parser(
+      [&fragments](CellValueFragment f) { fragments.push_back(std::move(f)); },
+      8);
+  ReadRowsResponse_CellChunk chunk;
+  // The first chunk of a split cell announces the total value size, the
+  // last chunk sets it to zero.
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    value: "part1-"
+    value_size: 11
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  std::string chunk2 = R"(
+    value: "part2"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk2, &chunk));
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+
+  ASSERT_EQ(2U, fragments.size());
+  EXPECT_EQ("RK", fragments[0].row_key);
+  EXPECT_EQ("F", fragments[0].family_name);
+  EXPECT_EQ("C", fragments[0].column_qualifier);
+  EXPECT_EQ(42, fragments[0].timestamp);
+  EXPECT_EQ("part1-", fragments[0].value);
+  EXPECT_FALSE(fragments[0].last_fragment);
+  EXPECT_EQ("RK", fragments[1].row_key);
+  EXPECT_EQ("part2", fragments[1].value);
+  EXPECT_TRUE(fragments[1].last_fragment);
+
+  // The cell in the row is a placeholder, its value went to the sink.
+  ASSERT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ("", row.cells()[0].value());
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(ReadRowsParserTest, StreamingSinkIgnoresSmallCells) {
+  using google::cloud::bigtable::internal::CellValueFragment;
+  using google::protobuf::TextFormat;
+  std::vector<CellValueFragment> fragments;
+  ReadRowsParser parser(
+      [&fragments](CellValueFragment f) { fragments.push_back(std::move(f)); },
+      1024);
+  ReadRowsResponse_CellChunk chunk;
+  // A split cell below the threshold accumulates as usual.
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    value: "part1-"
+    value_size: 11
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  std::string chunk2 = R"(
+    value: "part2"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk2, &chunk));
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+
+  EXPECT_TRUE(fragments.empty());
+  ASSERT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ("part1-part2", row.cells()[0].value());
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(ReadRowsParserTest, StreamingSinkSharesRowKeyMidRow) {
+  using google::cloud::bigtable::internal::CellValueFragment;
+  using google::cloud::bigtable::internal::StreamingReadRowsParserFactory;
+  using google::protobuf::TextFormat;
+  std::vector<CellValueFragment> fragments;
+  StreamingReadRowsParserFactory factory(
+      [&fragments](CellValueFragment f) { fragments.push_back(std::move(f)); },
+      8);
+  auto parser = factory.Create();
+  ReadRowsResponse_CellChunk chunk;
+  // A small cell completes first, so the large cell's fragments take their
+  // row key from the row in progress rather than from their own chunks.
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C1">
+    timestamp_micros: 42
+    value: "V"
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  parser->HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  std::string chunk2 = R"(
+    qualifier: < value: "C2">
+    timestamp_micros: 42
+    value: "part1-"
+    value_size: 11
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk2, &chunk));
+  parser->HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  std::string chunk3 = R"(
+    value: "part2"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk3, &chunk));
+  parser->HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+
+  ASSERT_EQ(2U, fragments.size());
+  EXPECT_EQ("RK", fragments[0].row_key);
+  EXPECT_EQ("C2", fragments[0].column_qualifier);
+  EXPECT_EQ("RK", fragments[1].row_key);
+  EXPECT_TRUE(fragments[1].last_fragment);
+
+  ASSERT_TRUE(parser->HasNext());
+  auto row = parser->Next(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(2U, row.cells().size());
+  EXPECT_EQ("V", row.cells()[0].value());
+  EXPECT_EQ("", row.cells()[1].value());
+
+  parser->HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
 // **** Acceptance tests helpers ****
 
 namespace google {
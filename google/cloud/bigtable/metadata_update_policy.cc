@@ -38,6 +38,19 @@ MetadataParamTypes const MetadataParamTypes::INSTANCE_NAME("instance.name");
 // NOLINTNEXTLINE(readability-identifier-naming)
 MetadataParamTypes const MetadataParamTypes::BACKUP_NAME("backup.name");
 
+namespace {
+// The value is invariant for the lifetime of the process, computing it once
+// saves several allocations every time a policy is created.
+std::string const& ApiClientHeader() {
+  static std::string const kHeader =
+      "gl-cpp/" + google::cloud::internal::CompilerId() + "-" +
+      google::cloud::internal::CompilerVersion() + "-" +
+      google::cloud::internal::CompilerFeatures() + "-" +
+      google::cloud::internal::LanguageVersion() + " gccl/" + version_string();
+  return kHeader;
+}
+}  // anonymous namespace
+
 MetadataUpdatePolicy::MetadataUpdatePolicy(
     std::string const& resource_name,
     MetadataParamTypes const& metadata_param_type) {
@@ -45,17 +58,16 @@ MetadataUpdatePolicy::MetadataUpdatePolicy(
   value += "=";
   value += resource_name;
   value_ = std::move(value);
-  std::string api_client_header =
-      "gl-cpp/" + google::cloud::internal::CompilerId() + "-" +
-      google::cloud::internal::CompilerVersion() + "-" +
-      google::cloud::internal::CompilerFeatures() + "-" +
-      google::cloud::internal::LanguageVersion() + " gccl/" + version_string();
-  api_client_header_ = std::move(api_client_header);
+  api_client_header_ = ApiClientHeader();
 }
 
 void MetadataUpdatePolicy::Setup(grpc::ClientContext& context) const {
-  context.AddMetadata(std::string("x-goog-request-params"), value());
-  context.AddMetadata(std::string("x-goog-api-client"), api_client_header());
+  // `Setup()` runs on every RPC, avoid rebuilding the (invariant) header
+  // names on each call.
+  static std::string const kRequestParamsKey = "x-goog-request-params";
+  static std::string const kApiClientKey = "x-goog-api-client";
+  context.AddMetadata(kRequestParamsKey, value());
+  context.AddMetadata(kApiClientKey, api_client_header());
 }
 
 }  // namespace BIGTABLE_CLIENT_NS
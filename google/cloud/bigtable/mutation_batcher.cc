@@ -31,12 +31,17 @@ auto constexpr kDefaultMaxSizePerBatch =
 auto constexpr kDefaultMaxBatches = 8;
 auto constexpr kDefaultMaxOutstandingSize =
     kDefaultMaxSizePerBatch * kDefaultMaxBatches;
+// The additive step in `AdaptLimits()` is this fraction of the configured
+// limit, so recovering from a halving takes about 8 well-behaved batches.
+auto constexpr kAdaptiveIncreaseFraction = 16;
 
 MutationBatcher::Options::Options()
     : max_mutations_per_batch(kBigtableMutationLimit),
       max_size_per_batch(kDefaultMaxSizePerBatch),
       max_batches(kDefaultMaxBatches),
-      max_outstanding_size(kDefaultMaxOutstandingSize) {}
+      max_outstanding_size(kDefaultMaxOutstandingSize),
+      target_batch_latency(0),
+      flush_window(0) {}
 
 std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     CompletionQueue& cq, SingleRowMutation mut) {
@@ -127,23 +132,49 @@ grpc::Status MutationBatcher::IsValid(PendingSingleRowMutation& mut) const {
 }
 
 bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
-  return outstanding_size_ + mut.request_size <=
-             options_.max_outstanding_size &&
-         cur_batch_->requests_size + mut.request_size <=
-             options_.max_size_per_batch &&
+  if (outstanding_size_ + mut.request_size > options_.max_outstanding_size) {
+    return false;
+  }
+  // An empty batch accepts any valid mutation, even if the adaptive limits
+  // dropped below its size; otherwise large mutations could starve.
+  if (cur_batch_->num_mutations == 0) {
+    return true;
+  }
+  return cur_batch_->requests_size + mut.request_size <=
+             effective_max_size_per_batch_ &&
          cur_batch_->num_mutations + mut.num_mutations <=
-             options_.max_mutations_per_batch;
+             effective_max_mutations_per_batch_;
 }
 
 future<std::vector<FailedMutation>> MutationBatcher::AsyncBulkApplyImpl(
     Table& table, BulkMutation&& mut, CompletionQueue& cq) {
+  if (options_.byte_budget) {
+    return table.AsyncBulkApply(std::move(mut), options_.byte_budget, cq);
+  }
   return table.AsyncBulkApply(std::move(mut), cq);
 }
 
 bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
+  return FlushImpl(std::move(cq), /*ignore_flush_window=*/false);
+}
+
+bool MutationBatcher::FlushImpl(CompletionQueue cq, bool ignore_flush_window) {
   if (cur_batch_->num_mutations > 0 &&
-      num_outstanding_batches_ < options_.max_batches) {
+      num_outstanding_batches_ < effective_max_batches_) {
+    bool const batch_is_full =
+        cur_batch_->num_mutations >= effective_max_mutations_per_batch_ ||
+        cur_batch_->requests_size >= effective_max_size_per_batch_;
+    if (!ignore_flush_window && !batch_is_full &&
+        options_.flush_window != std::chrono::milliseconds::zero() &&
+        pending_mutations_.empty()) {
+      // The batch still has room --- and nothing is waiting for it to drain
+      // --- so hold it back and let concurrent mutations coalesce into it.
+      // The timer sends whatever accumulated when the window expires.
+      ScheduleFlushTimer(cq);
+      return false;
+    }
     ++num_outstanding_batches_;
+    cur_batch_->sent_time = Now();
 
     auto batch = std::make_shared<Batch>();
     cur_batch_.swap(batch);
@@ -173,6 +204,44 @@ bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
   return false;
 }
 
+void MutationBatcher::ScheduleFlushTimer(CompletionQueue& cq) {
+  if (flush_timer_armed_) {
+    return;
+  }
+  flush_timer_armed_ = true;
+  auto batch = cur_batch_;
+  cq.MakeRelativeTimer(options_.flush_window)
+      .then([this, cq, batch](
+                future<StatusOr<std::chrono::system_clock::time_point>>
+                    result) mutable {
+        result.get();
+        // Like in `FlushImpl()`, calling back into the batcher directly
+        // could deadlock: the timer future may be satisfied while `mu_` is
+        // held, running this continuation inline.
+        struct Functor {
+          void operator()(CompletionQueue& cq) {
+            self->OnFlushTimer(cq, std::move(batch));
+          }
+
+          MutationBatcher* self;
+          std::shared_ptr<Batch> batch;
+        };
+        cq.RunAsync(Functor{this, std::move(batch)});
+      });
+}
+
+void MutationBatcher::OnFlushTimer(CompletionQueue cq,
+                                   std::shared_ptr<Batch> batch) {
+  std::unique_lock<std::mutex> lk(mu_);
+  flush_timer_armed_ = false;
+  if (batch != cur_batch_) {
+    // The batch the timer was armed for filled up and was already sent.
+    return;
+  }
+  FlushImpl(cq, /*ignore_flush_window=*/true);
+  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+}
+
 void MutationBatcher::OnBulkApplyDone(
     CompletionQueue cq, MutationBatcher::Batch batch,
     std::vector<FailedMutation> const& failed) {
@@ -207,9 +276,40 @@ void MutationBatcher::OnBulkApplyDone(
   outstanding_size_ -= batch.requests_size;
   num_requests_pending_ -= num_mutations;
   num_outstanding_batches_--;
+  AdaptLimits(Now() - batch.sent_time);
   SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
 }
 
+void MutationBatcher::AdaptLimits(std::chrono::steady_clock::duration latency) {
+  if (options_.target_batch_latency == std::chrono::milliseconds::zero()) {
+    return;
+  }
+  if (latency > options_.target_batch_latency) {
+    // Multiplicative decrease: the service (or the network) is slower than
+    // we want, cut the batch size in half and lower the concurrency.
+    effective_max_mutations_per_batch_ =
+        (std::max<std::size_t>)(effective_max_mutations_per_batch_ / 2, 1);
+    effective_max_size_per_batch_ =
+        (std::max<std::size_t>)(effective_max_size_per_batch_ / 2, 1);
+    effective_max_batches_ =
+        (std::max<std::size_t>)(effective_max_batches_ - 1, 1);
+    return;
+  }
+  // Additive increase, back towards the configured limits.
+  effective_max_mutations_per_batch_ = (std::min)(
+      effective_max_mutations_per_batch_ +
+          (std::max<std::size_t>)(
+              options_.max_mutations_per_batch / kAdaptiveIncreaseFraction, 1),
+      options_.max_mutations_per_batch);
+  effective_max_size_per_batch_ = (std::min)(
+      effective_max_size_per_batch_ +
+          (std::max<std::size_t>)(
+              options_.max_size_per_batch / kAdaptiveIncreaseFraction, 1),
+      options_.max_size_per_batch);
+  effective_max_batches_ =
+      (std::min)(effective_max_batches_ + 1, options_.max_batches);
+}
+
 std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
     CompletionQueue& cq) {
   // Defer satisfying promises until we release the lock.
@@ -17,12 +17,14 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/mutation_byte_budget.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/status.h"
 #include "absl/memory/memory.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -79,18 +81,79 @@ class MutationBatcher {
       return *this;
     }
 
+    /**
+     * Try to keep the latency of each `MutateRows` RPC at this value.
+     *
+     * When set to a non-zero value, the batcher adjusts the effective batch
+     * size and number of outstanding batches (within the limits above) to
+     * the observed latency of completed batches: the limits grow additively
+     * while batches complete under the target and are cut in half when they
+     * do not (AIMD). This is useful when the load the service can sustain
+     * varies over time, where any static tuning is either too conservative
+     * at off-peak times or overloads the service at peak times.
+     *
+     * The default (zero) disables the adjustment, the configured limits are
+     * used unchanged.
+     */
+    Options& SetTargetBatchLatency(
+        std::chrono::milliseconds target_batch_latency_arg) {
+      target_batch_latency = target_batch_latency_arg;
+      return *this;
+    }
+
+    /**
+     * Coalesce mutations for up to this long before sending a batch.
+     *
+     * By default the batcher sends the accumulated batch as soon as an RPC
+     * slot is available, so with few concurrent callers every mutation
+     * becomes its own `MutateRows` RPC. With a non-zero window, a batch
+     * that still has room is held back for up to this long, giving
+     * concurrent `AsyncApply()` calls (and batched `Table::Apply()` calls,
+     * see `Table::EnableApplyBatching()`) a chance to coalesce into fewer,
+     * larger RPCs. A batch that fills up, or that blocks flow-controlled
+     * mutations, is still sent immediately.
+     *
+     * The default (zero) preserves the previous behavior.
+     */
+    Options& SetFlushWindow(std::chrono::milliseconds flush_window_arg) {
+      flush_window = flush_window_arg;
+      return *this;
+    }
+
+    /**
+     * Pace `MutateRows` attempts through a budget shared between batchers.
+     *
+     * All the batchers sharing the budget keep the total serialized size of
+     * their in-flight `MutateRows` attempts --- including retries --- under
+     * the budget's limit, and are admitted in FIFO order. See
+     * `MutationByteBudget` for the motivation.
+     *
+     * The default (none) applies no cross-batcher limit.
+     */
+    Options& SetByteBudget(std::shared_ptr<MutationByteBudget> budget_arg) {
+      byte_budget = std::move(budget_arg);
+      return *this;
+    }
+
     std::size_t max_mutations_per_batch;
     std::size_t max_size_per_batch;
     std::size_t max_batches;
     std::size_t max_outstanding_size;
+    std::chrono::milliseconds target_batch_latency;
+    std::chrono::milliseconds flush_window;
+    std::shared_ptr<MutationByteBudget> byte_budget;
   };
 
   explicit MutationBatcher(Table table, Options options = Options())
       : table_(std::move(table)),
         options_(options),
+        effective_max_mutations_per_batch_(options.max_mutations_per_batch),
+        effective_max_size_per_batch_(options.max_size_per_batch),
+        effective_max_batches_(options.max_batches),
         num_outstanding_batches_(),
         outstanding_size_(),
         num_requests_pending_(),
+        flush_timer_armed_(false),
         cur_batch_(std::make_shared<Batch>()) {}
 
   virtual ~MutationBatcher() = default;
@@ -163,6 +226,11 @@ class MutationBatcher {
   virtual future<std::vector<FailedMutation>> AsyncBulkApplyImpl(
       Table& table, BulkMutation&& mut, CompletionQueue& cq);
 
+  // Wrap reading the clock in a virtual function to ease testing.
+  virtual std::chrono::steady_clock::time_point Now() const {
+    return std::chrono::steady_clock::now();
+  }
+
  private:
   using CompletionPromise = promise<Status>;
   using AdmissionPromise = promise<void>;
@@ -222,6 +290,8 @@ class MutationBatcher {
     size_t requests_size{};
     BulkMutation requests;
     std::vector<MutationData> mutation_data;
+    /// When the batch was sent, to measure the `MutateRows` latency.
+    std::chrono::steady_clock::time_point sent_time;
   };
 
   /// Check if a mutation doesn't exceed allowed limits.
@@ -251,10 +321,32 @@ class MutationBatcher {
    */
   bool FlushIfPossible(CompletionQueue cq);
 
+  /**
+   * Implementation of `FlushIfPossible()`.
+   *
+   * When @p ignore_flush_window is false and `Options::flush_window` is
+   * set, a batch that still has room is deferred: a timer is scheduled to
+   * flush it when the window expires. The flush-timer callback passes true
+   * to send whatever accumulated.
+   */
+  bool FlushImpl(CompletionQueue cq, bool ignore_flush_window);
+
+  /// Arm the flush-window timer for the current batch, if not armed yet.
+  void ScheduleFlushTimer(CompletionQueue& cq);
+
+  /// Flush @p batch if it is still accumulating when its window expires.
+  void OnFlushTimer(CompletionQueue cq, std::shared_ptr<Batch> batch);
+
   /// Handle a completed batch.
   void OnBulkApplyDone(CompletionQueue cq, MutationBatcher::Batch batch,
                        std::vector<FailedMutation> const& failed);
 
+  /**
+   * Adjust the effective batch limits given the latency of a completed
+   * batch (AIMD). A noop unless `Options::target_batch_latency` is set.
+   */
+  void AdaptLimits(std::chrono::steady_clock::duration latency);
+
   /**
    * Try to move mutations waiting in `pending_mutations_` to the currently
    * constructed batch.
@@ -279,12 +371,25 @@ class MutationBatcher {
   Table table_;
   Options options_;
 
+  /**
+   * The limits currently applied when accumulating and sending batches.
+   *
+   * These start at the configured limits and stay there unless
+   * `Options::target_batch_latency` is set, in which case `AdaptLimits()`
+   * moves them between 1 and the configured limits.
+   */
+  size_t effective_max_mutations_per_batch_;
+  size_t effective_max_size_per_batch_;
+  size_t effective_max_batches_;
+
   /// Num batches sent but not completed.
   size_t num_outstanding_batches_;
   /// Size of admitted but uncompleted mutations.
   size_t outstanding_size_;
   // Number of uncompleted SingleRowMutations (including not admitted).
   size_t num_requests_pending_;
+  /// Is a flush-window timer armed for the current batch?
+  bool flush_timer_armed_;
 
   /// Currently contructed batch of mutations.
   std::shared_ptr<Batch> cur_batch_;
@@ -262,6 +262,20 @@ TEST(OptionsTest, Trivial) {
   ASSERT_EQ(4, opt.max_outstanding_size);
 }
 
+TEST(OptionsTest, FlushWindow) {
+  MutationBatcher::Options opt;
+  EXPECT_EQ(std::chrono::milliseconds::zero(), opt.flush_window);
+  opt.SetFlushWindow(std::chrono::milliseconds(5));
+  EXPECT_EQ(std::chrono::milliseconds(5), opt.flush_window);
+}
+
+TEST(OptionsTest, TargetBatchLatency) {
+  MutationBatcher::Options opt;
+  EXPECT_EQ(std::chrono::milliseconds::zero(), opt.target_batch_latency);
+  opt.SetTargetBatchLatency(std::chrono::milliseconds(250));
+  EXPECT_EQ(std::chrono::milliseconds(250), opt.target_batch_latency);
+}
+
 TEST_F(MutationBatcherTest, TrivialTest) {
   std::vector<SingleRowMutation> mutations(
       {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
@@ -316,6 +330,57 @@ TEST_F(MutationBatcherTest, BatchIsFlushedImmediately) {
   EXPECT_EQ(0, NumOperationsOutstanding());
 }
 
+TEST_F(MutationBatcherTest, FlushWindowCoalescesMutations) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetFlushWindow(std::chrono::milliseconds(5))));
+
+  ExpectInteraction(
+      {Exchange({mutations[0], mutations[1]}, {ResultPiece({0, 1}, {}, {})})});
+
+  auto state = ApplyMany(mutations.begin(), mutations.end());
+  EXPECT_TRUE(state.AllAdmitted());
+  EXPECT_TRUE(state.NoneCompleted());
+  // Nothing was sent yet, the only outstanding operation is the
+  // flush-window timer; both mutations accumulate in one batch.
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishTimer();
+  // The timer hands the flush over to `RunAsync`.
+  cq_impl_->SimulateCompletion(true);
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state.AllCompleted());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+TEST_F(MutationBatcherTest, FlushWindowDoesNotDelayFullBatches) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options()
+                  .SetMaxMutationsPerBatch(1)
+                  .SetFlushWindow(std::chrono::milliseconds(5))));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({0}, {}, {})})});
+
+  auto state = Apply(mutations[0]);
+  EXPECT_TRUE(state->admitted);
+  EXPECT_FALSE(state->completed);
+  // The batch reached its mutation limit, so it was sent without waiting
+  // for the flush window; there is no timer, just the RPC.
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+
+  EXPECT_TRUE(state->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
 class MutationBatcherBoolParamTest : public MutationBatcherTest,
                                      public WithParamInterface<bool> {};
 
@@ -741,6 +806,84 @@ TEST_F(MutationBatcherTest, ApplyCompletesImmediately) {
   EXPECT_EQ(0, NumOperationsOutstanding());
 }
 
+TEST_F(MutationBatcherTest, SlowBatchesShrinkAdaptiveLimits) {
+  class FakeClockBatcher : public MutationBatcher {
+   public:
+    FakeClockBatcher(Table table, Options options)
+        : MutationBatcher(std::move(table), options),
+          now_(std::chrono::steady_clock::now()) {}
+
+    void AdvanceTime(std::chrono::milliseconds d) { now_ += d; }
+
+   protected:
+    std::chrono::steady_clock::time_point Now() const override { return now_; }
+
+   private:
+    std::chrono::steady_clock::time_point now_;
+  };
+
+  auto* batcher_raw = new FakeClockBatcher(
+      table_, MutationBatcher::Options()
+                  .SetMaxMutationsPerBatch(4)
+                  .SetMaxSizePerBatch(2000)
+                  .SetMaxBatches(1)
+                  .SetMaxOutstandingSize(4000)
+                  .SetTargetBatchLatency(std::chrono::milliseconds(10)));
+  batcher_.reset(batcher_raw);
+
+  std::vector<SingleRowMutation> mutations;
+  for (int i = 0; i != 8; ++i) {
+    mutations.emplace_back(SingleRowMutation(
+        "foo" + std::to_string(i), {bt::SetCell("fam", "col", 0_ms, "baz")}));
+  }
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[1], mutations[2], mutations[3], mutations[4]},
+                {ResultPiece({0, 1, 2, 3}, {}, {})}),
+       Exchange({mutations[5], mutations[6]}, {ResultPiece({0, 1}, {}, {})}),
+       Exchange({mutations[7]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  EXPECT_TRUE(state0->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // These fill the next batch to the configured limit of 4 mutations.
+  auto admitted = ApplyMany(mutations.begin() + 1, mutations.begin() + 5);
+  EXPECT_TRUE(admitted.AllAdmitted());
+  auto pending = ApplyMany(mutations.begin() + 5, mutations.end());
+  EXPECT_TRUE(pending.NoneAdmitted());
+
+  // The first batch takes much longer than the target latency, so the
+  // batcher halves the mutations-per-batch limit (4 -> 2).
+  batcher_raw->AdvanceTime(std::chrono::milliseconds(100));
+  FinishSingleItemStream();  // [m0]
+  EXPECT_TRUE(state0->completed);
+  // The already accumulated batch is sent as-is, but only two of the
+  // mutations waiting for admission fit in the batch after it.
+  EXPECT_TRUE(pending.states_[0]->admitted);
+  EXPECT_TRUE(pending.states_[1]->admitted);
+  EXPECT_FALSE(pending.states_[2]->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // Another slow batch halves the limit again (2 -> 1), so the last
+  // mutation does not join the two already accumulated.
+  batcher_raw->AdvanceTime(std::chrono::milliseconds(100));
+  FinishSingleItemStream();  // [m1, m2, m3, m4]
+  EXPECT_TRUE(admitted.AllCompleted());
+  EXPECT_TRUE(pending.states_[2]->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  batcher_raw->AdvanceTime(std::chrono::milliseconds(100));
+  FinishSingleItemStream();  // [m5, m6]
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  batcher_raw->AdvanceTime(std::chrono::milliseconds(100));
+  FinishSingleItemStream();  // [m7]
+  EXPECT_TRUE(pending.AllCompleted());
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
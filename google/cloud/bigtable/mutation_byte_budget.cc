@@ -0,0 +1,71 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_byte_budget.h"
+#include <algorithm>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+MutationByteBudget::MutationByteBudget(std::size_t max_outstanding_bytes)
+    // Guard against a zero budget, it would stall every operation using it.
+    : max_outstanding_bytes_((std::max<std::size_t>)(max_outstanding_bytes, 1)),
+      outstanding_bytes_(0) {}
+
+future<void> MutationByteBudget::AsyncAcquire(std::size_t bytes) {
+  bytes = (std::min)(bytes, max_outstanding_bytes_);
+  std::unique_lock<std::mutex> lk(mu_);
+  // Grant immediately only when nobody is already waiting, otherwise small
+  // requests would continuously overtake (and starve) large ones.
+  if (waiters_.empty() &&
+      outstanding_bytes_ + bytes <= max_outstanding_bytes_) {
+    outstanding_bytes_ += bytes;
+    return make_ready_future();
+  }
+  waiters_.push(Waiter{bytes, promise<void>()});
+  return waiters_.back().granted.get_future();
+}
+
+void MutationByteBudget::Release(std::size_t bytes) {
+  bytes = (std::min)(bytes, max_outstanding_bytes_);
+  std::vector<promise<void>> granted;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    outstanding_bytes_ -= (std::min)(bytes, outstanding_bytes_);
+    while (!waiters_.empty() && outstanding_bytes_ + waiters_.front().bytes <=
+                                    max_outstanding_bytes_) {
+      outstanding_bytes_ += waiters_.front().bytes;
+      granted.emplace_back(std::move(waiters_.front().granted));
+      waiters_.pop();
+    }
+  }
+  // Satisfy the promises after releasing the lock, the continuations may
+  // call back into this object.
+  for (auto& p : granted) {
+    p.set_value();
+  }
+}
+
+std::size_t MutationByteBudget::outstanding_bytes() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  return outstanding_bytes_;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,95 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BYTE_BUDGET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BYTE_BUDGET_H
+
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include <cstddef>
+#include <mutex>
+#include <queue>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A budget of outstanding `MutateRows` bytes, shared between operations.
+ *
+ * A `MutationBatcher` bounds the mutations outstanding in a single batcher,
+ * but an application with many batchers (e.g. one per table) has no bound on
+ * their aggregate. The problem is most visible with retries: when the
+ * service asks many outstanding batches to back off at once (say after a
+ * tablet split), their retry timers expire close together and the combined
+ * burst can be several times the steady-state send rate, triggering further
+ * pushback.
+ *
+ * Objects of this class put a global limit on those bytes. Create a single
+ * budget, share it (via `std::shared_ptr`) between the batchers using
+ * `MutationBatcher::Options::SetByteBudget()`, and every `MutateRows`
+ * attempt --- including each retry --- waits until the budget admits its
+ * serialized size before it is sent. The budget is granted in FIFO order,
+ * so the operations sharing it are admitted fairly, and a retry burst
+ * drains at the configured pace instead of all at once.
+ *
+ * This class is thread-safe.
+ */
+class MutationByteBudget {
+ public:
+  /// Create a budget admitting up to @p max_outstanding_bytes at a time.
+  explicit MutationByteBudget(std::size_t max_outstanding_bytes);
+
+  /**
+   * Acquire @p bytes from the budget.
+   *
+   * The returned future is satisfied once the bytes are granted; grants are
+   * made in request order. Requests larger than the whole budget are clamped
+   * to it (and are therefore granted only when the budget is idle), so they
+   * are paced rather than rejected.
+   */
+  future<void> AsyncAcquire(std::size_t bytes);
+
+  /**
+   * Return @p bytes to the budget, waking up waiters as they fit.
+   *
+   * Pass the same value given to `AsyncAcquire()`, the clamping applied
+   * there is applied here too.
+   */
+  void Release(std::size_t bytes);
+
+  /// The configured limit.
+  std::size_t max_outstanding_bytes() const { return max_outstanding_bytes_; }
+
+  /// The bytes currently acquired.
+  std::size_t outstanding_bytes() const;
+
+ private:
+  struct Waiter {
+    std::size_t bytes;
+    promise<void> granted;
+  };
+
+  std::size_t const max_outstanding_bytes_;
+  mutable std::mutex mu_;
+  std::size_t outstanding_bytes_;
+  std::queue<Waiter> waiters_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_BYTE_BUDGET_H
@@ -0,0 +1,78 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_byte_budget.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+TEST(MutationByteBudgetTest, GrantsImmediatelyWhenIdle) {
+  MutationByteBudget budget(100);
+  EXPECT_EQ(100U, budget.max_outstanding_bytes());
+  auto fut = budget.AsyncAcquire(60);
+  EXPECT_TRUE(fut.is_ready());
+  EXPECT_EQ(60U, budget.outstanding_bytes());
+  budget.Release(60);
+  EXPECT_EQ(0U, budget.outstanding_bytes());
+}
+
+TEST(MutationByteBudgetTest, GrantsAreFifo) {
+  MutationByteBudget budget(100);
+  auto first = budget.AsyncAcquire(60);
+  EXPECT_TRUE(first.is_ready());
+  auto second = budget.AsyncAcquire(60);
+  EXPECT_FALSE(second.is_ready());
+  // The third request would fit, but it should not overtake the second -
+  // otherwise small requests could starve large ones.
+  auto third = budget.AsyncAcquire(10);
+  EXPECT_FALSE(third.is_ready());
+
+  budget.Release(60);
+  EXPECT_TRUE(second.is_ready());
+  EXPECT_TRUE(third.is_ready());
+  EXPECT_EQ(70U, budget.outstanding_bytes());
+}
+
+TEST(MutationByteBudgetTest, OversizedRequestsAreClamped) {
+  MutationByteBudget budget(100);
+  // Larger than the whole budget, granted while the budget is idle.
+  auto oversized = budget.AsyncAcquire(1000);
+  EXPECT_TRUE(oversized.is_ready());
+  EXPECT_EQ(100U, budget.outstanding_bytes());
+
+  auto waiting = budget.AsyncAcquire(1);
+  EXPECT_FALSE(waiting.is_ready());
+  // Releasing with the original size applies the same clamping.
+  budget.Release(1000);
+  EXPECT_TRUE(waiting.is_ready());
+  EXPECT_EQ(1U, budget.outstanding_bytes());
+}
+
+TEST(MutationByteBudgetTest, ZeroLimitDoesNotStall) {
+  MutationByteBudget budget(0);
+  auto fut = budget.AsyncAcquire(10);
+  EXPECT_TRUE(fut.is_ready());
+  budget.Release(10);
+  EXPECT_EQ(0U, budget.outstanding_bytes());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -28,6 +28,7 @@
 #include <grpcpp/grpcpp.h>
 #include <chrono>
 #include <type_traits>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -51,7 +52,12 @@ struct Mutation {
  */
 constexpr std::int64_t ServerSetTimestamp() { return -1; }
 
-/// Create a mutation to set a cell value.
+/**
+ * Create a mutation to set a cell value.
+ *
+ * Pass rvalues (e.g. `std::move(value)`) for @p column and @p value to
+ * transfer the buffers into the mutation without copying them.
+ */
 template <typename ColumnType, typename ValueType>
 Mutation SetCell(std::string family, ColumnType&& column,
                  std::chrono::milliseconds timestamp, ValueType&& value) {
@@ -307,6 +313,7 @@ class SingleRowMutation {
   SingleRowMutation(RowKey&& row_key, std::initializer_list<Mutation> list) {
     request_.set_row_key(std::forward<RowKey>(row_key));
     for (auto&& i : list) {
+      UpdateIdempotency(i.op);
       *request_.add_mutations() = i.op;
     }
   }
@@ -331,14 +338,22 @@ class SingleRowMutation {
     using std::swap;
     swap(*request_.mutable_row_key(), *entry.mutable_row_key());
     swap(*request_.mutable_mutations(), *entry.mutable_mutations());
+    for (auto const& m : request_.mutations()) {
+      UpdateIdempotency(m);
+    }
   }
 
   /// Create a row mutation from gRPC proto
   explicit SingleRowMutation(::google::bigtable::v2::MutateRowRequest request)
-      : request_(std::move(request)) {}
+      : request_(std::move(request)) {
+    for (auto const& m : request_.mutations()) {
+      UpdateIdempotency(m);
+    }
+  }
 
   // Add a mutation at the end.
   SingleRowMutation& emplace_back(Mutation mut) {
+    UpdateIdempotency(mut.op);
     *request_.add_mutations() = std::move(mut.op);
     return *this;
   }
@@ -346,6 +361,16 @@ class SingleRowMutation {
   // Get the row key.
   RowKeyType const& row_key() const { return request_.row_key(); }
 
+  /**
+   * Return whether all the mutations in this object are idempotent.
+   *
+   * The bit is maintained as mutations are added, so retry loops can use it
+   * without re-inspecting each mutation. It follows the
+   * `SafeIdempotentMutationPolicy` rules: only a `SetCell()` where the
+   * server picks the timestamp is considered non-idempotent.
+   */
+  bool all_idempotent() const { return all_idempotent_; }
+
   friend class Table;
 
   SingleRowMutation(SingleRowMutation&&) = default;
@@ -366,7 +391,10 @@ class SingleRowMutation {
   }
 
   /// Remove the contents of the mutation.
-  void Clear() { request_.Clear(); }
+  void Clear() {
+    request_.Clear();
+    all_idempotent_ = true;
+  }
 
  private:
   /// Add multiple mutations to single row
@@ -378,8 +406,17 @@ class SingleRowMutation {
 
   void emplace_many(Mutation m) { emplace_back(std::move(m)); }
 
+  /// Maintain the precomputed idempotency bit as mutations are added.
+  void UpdateIdempotency(::google::bigtable::v2::Mutation const& m) {
+    if (m.has_set_cell() &&
+        m.set_cell().timestamp_micros() == ServerSetTimestamp()) {
+      all_idempotent_ = false;
+    }
+  }
+
  private:
   ::google::bigtable::v2::MutateRowRequest request_;
+  bool all_idempotent_ = true;
 };
 
 /**
@@ -507,6 +544,7 @@ class BulkMutation {
 
   // Add a mutation to the batch.
   BulkMutation& emplace_back(SingleRowMutation mut) {
+    entry_idempotency_.push_back(mut.all_idempotent());
     mut.MoveTo(request_.add_entries());
     return *this;
   }
@@ -519,6 +557,7 @@ class BulkMutation {
 
   // Add a mutation to the batch.
   BulkMutation& push_back(SingleRowMutation mut) {
+    entry_idempotency_.push_back(mut.all_idempotent());
     mut.MoveTo(request_.add_entries());
     return *this;
   }
@@ -527,6 +566,18 @@ class BulkMutation {
   void MoveTo(google::bigtable::v2::MutateRowsRequest* request) {
     request_.Swap(request);
     request_ = {};
+    entry_idempotency_.clear();
+  }
+
+  /**
+   * Return the precomputed idempotency of each mutation in this set.
+   *
+   * One element per mutation, in the same order as the entries; see
+   * `SingleRowMutation::all_idempotent()`. `BulkApply()` uses these bits to
+   * classify the mutations without walking their protos again.
+   */
+  std::vector<bool> const& entry_idempotency() const {
+    return entry_idempotency_;
   }
 
   /// Return true if there are no mutations in this set.
@@ -551,6 +602,7 @@ class BulkMutation {
 
  private:
   google::bigtable::v2::MutateRowsRequest request_;
+  std::vector<bool> entry_idempotency_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -22,6 +22,7 @@
 namespace bigtable = ::google::cloud::bigtable;
 using ::google::cloud::testing_util::chrono_literals::operator"" _ms;
 using ::google::cloud::testing_util::chrono_literals::operator"" _us;
+using ::testing::ElementsAre;
 
 /// @test Verify that SetCell() works as expected.
 TEST(MutationsTest, SetCell) {
@@ -263,6 +264,36 @@ TEST(MutationsTest, SingleRowMutationSingleVariadic) {
   EXPECT_EQ(row_key, entry.row_key());
 }
 
+/// @test Verify that SingleRowMutation precomputes its idempotency.
+TEST(MutationsTest, SingleRowMutationIdempotency) {
+  bigtable::SingleRowMutation idempotent(
+      "r1", bigtable::SetCell("family", "c1", 1_ms, "V1000"),
+      bigtable::DeleteFromFamily("family"));
+  EXPECT_TRUE(idempotent.all_idempotent());
+
+  // A SetCell() where the server picks the timestamp is not idempotent.
+  bigtable::SingleRowMutation mut("r2");
+  EXPECT_TRUE(mut.all_idempotent());
+  mut.emplace_back(bigtable::SetCell("family", "c1", "V1000"));
+  EXPECT_FALSE(mut.all_idempotent());
+  mut.Clear();
+  EXPECT_TRUE(mut.all_idempotent());
+}
+
+/// @test Verify that BulkMutation carries the per-entry idempotency bits.
+TEST(MutationsTest, BulkMutationEntryIdempotency) {
+  bigtable::BulkMutation mut(
+      bigtable::SingleRowMutation(
+          "r1", bigtable::SetCell("family", "c1", 1_ms, "V1000")),
+      bigtable::SingleRowMutation(
+          "r2", bigtable::SetCell("family", "c1", "V2000")));
+  EXPECT_THAT(mut.entry_idempotency(), ElementsAre(true, false));
+
+  google::bigtable::v2::MutateRowsRequest request;
+  mut.MoveTo(&request);
+  EXPECT_TRUE(mut.entry_idempotency().empty());
+}
+
 /// @test Verify that SingleRowMutation::Clear() works.
 TEST(MutationsTest, SingleRowMutationClear) {
   std::string const row_key = "row-key-1";
@@ -0,0 +1,240 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/parallel_row_reader.h"
+#include "google/cloud/bigtable/row_interval_set.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+ParallelRowReader::Options::Options()
+    : queue_depth(128), preserve_order(true), ordering_window(1) {
+  // One stream per core by default, mirroring the sizing of the default
+  // connection pool. `hardware_concurrency()` may return zero if the value
+  // is not computable.
+  std::size_t const cpu_count = std::thread::hardware_concurrency();
+  max_streams = cpu_count != 0 ? cpu_count : 4;
+}
+
+ParallelRowReader::ParallelRowReader(Table table, RowSet row_set, Filter filter,
+                                     Options options)
+    : table_(std::move(table)),
+      row_set_(std::move(row_set)),
+      filter_(std::move(filter)),
+      options_(options),
+      started_(false),
+      shutdown_(false),
+      error_delivered_(false),
+      scan_pos_(0),
+      deliver_pos_(0),
+      active_workers_(0) {
+  // Guard against nonsensical settings, they would stall the scan.
+  if (options_.max_streams == 0) {
+    options_.max_streams = 1;
+  }
+  if (options_.queue_depth == 0) {
+    options_.queue_depth = 1;
+  }
+  if (options_.ordering_window == 0) {
+    options_.ordering_window = 1;
+  }
+}
+
+ParallelRowReader::~ParallelRowReader() { Cancel(); }
+
+void ParallelRowReader::Cancel() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  producer_cv_.notify_all();
+  consumer_cv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+void ParallelRowReader::Start() {
+  // Only the thread calling `Next()` reaches this function, no locking is
+  // needed for `started_` or for `shards_` until the workers exist.
+  if (started_) {
+    return;
+  }
+  started_ = true;
+
+  auto samples = options_.sample_cache ? options_.sample_cache->Samples()
+                                       : table_.SampleRows();
+  if (!samples) {
+    std::unique_lock<std::mutex> lk(mu_);
+    status_ = std::move(samples).status();
+    return;
+  }
+
+  // Normalize the request into sorted, disjoint intervals. This coalesces
+  // any redundant entries (so they are not sent once per shard) and makes
+  // each per-shard intersection below cheap even for very large sets.
+  RowIntervalSet intervals;
+  auto const& proto = row_set_.as_proto();
+  if (proto.row_keys().empty() && proto.row_ranges().empty()) {
+    // A default constructed RowSet means "all rows".
+    intervals.Append(RowRange::InfiniteRange());
+  } else {
+    for (auto const& key : proto.row_keys()) {
+      intervals.Append(key);
+    }
+    for (auto const& r : proto.row_ranges()) {
+      intervals.Append(RowRange(r));
+    }
+  }
+
+  // Create one shard per sampled split point. This is typically far more
+  // shards than streams; the workers claim them dynamically, which keeps all
+  // the streams busy even when some shards are much slower than others.
+  std::string prev;
+  for (auto const& sample : *samples) {
+    if (sample.row_key.empty()) {
+      continue;
+    }
+    // `prev` is about to be replaced, move it into the range start bound.
+    auto shard = intervals.Intersect(
+        RowRange::RightOpen(std::move(prev), sample.row_key));
+    if (!shard.IsEmpty()) {
+      shards_.emplace_back(shard.AsRowSet());
+    }
+    prev = sample.row_key;
+  }
+  // The remainder of the key space; when there are no samples at all this is
+  // the whole request and the scan degrades to a single stream.
+  auto last = intervals.Intersect(RowRange::RightOpen(std::move(prev), ""));
+  if (!last.IsEmpty()) {
+    shards_.emplace_back(last.AsRowSet());
+  }
+
+  auto const worker_count = (std::min)(options_.max_streams, shards_.size());
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    active_workers_ = worker_count;
+  }
+  for (std::size_t i = 0; i != worker_count; ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+void ParallelRowReader::WorkerLoop() {
+  for (;;) {
+    std::size_t idx;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (shutdown_ || !status_.ok() || scan_pos_ >= shards_.size()) {
+        break;
+      }
+      idx = scan_pos_++;
+    }
+    auto reader = table_.ReadRows(shards_[idx].row_set, filter_);
+    for (auto& row : reader) {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (!row) {
+        if (status_.ok()) {
+          status_ = row.status();
+        }
+        // An aborted stream suggests the table topology changed, make sure
+        // the next scan plans its shards from fresh samples.
+        if (options_.sample_cache &&
+            row.status().code() == StatusCode::kAborted) {
+          options_.sample_cache->Invalidate();
+        }
+        break;
+      }
+      producer_cv_.wait(lk, [this, idx] {
+        return shutdown_ || !status_.ok() ||
+               shards_[idx].rows.size() < options_.queue_depth;
+      });
+      if (shutdown_ || !status_.ok()) {
+        break;
+      }
+      shards_[idx].rows.push(*std::move(row));
+      lk.unlock();
+      consumer_cv_.notify_one();
+    }
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      shards_[idx].done = true;
+    }
+    consumer_cv_.notify_one();
+  }
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    --active_workers_;
+  }
+  consumer_cv_.notify_all();
+}
+
+absl::optional<StatusOr<Row>> ParallelRowReader::Next() {
+  Start();
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    if (shutdown_) {
+      return absl::nullopt;
+    }
+    if (!status_.ok()) {
+      if (error_delivered_) {
+        return absl::nullopt;
+      }
+      error_delivered_ = true;
+      // The scan is abandoned on the first error, stop the workers and
+      // discard any buffered rows.
+      shutdown_ = true;
+      auto status = status_;
+      lk.unlock();
+      producer_cv_.notify_all();
+      return StatusOr<Row>(std::move(status));
+    }
+    // Skip the shards that have been fully delivered.
+    while (deliver_pos_ != shards_.size() && shards_[deliver_pos_].done &&
+           shards_[deliver_pos_].rows.empty()) {
+      ++deliver_pos_;
+    }
+    if (deliver_pos_ == shards_.size()) {
+      return absl::nullopt;
+    }
+    // Strict ordering is a window of one, unordered delivery an unbounded
+    // window; anything in between delivers approximately in order.
+    auto const window = options_.preserve_order ? options_.ordering_window
+                                                : shards_.size();
+    auto const end = (std::min)(shards_.size(), deliver_pos_ + window);
+    for (std::size_t i = deliver_pos_; i != end; ++i) {
+      auto& shard = shards_[i];
+      if (shard.rows.empty()) {
+        continue;
+      }
+      auto row = std::move(shard.rows.front());
+      shard.rows.pop();
+      lk.unlock();
+      producer_cv_.notify_all();
+      return StatusOr<Row>(std::move(row));
+    }
+    consumer_cv_.wait(lk);
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
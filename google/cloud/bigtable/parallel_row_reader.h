@@ -0,0 +1,226 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_ROW_READER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_ROW_READER_H
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/sample_row_keys_cache.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Read the rows of a table using multiple streams in parallel.
+ *
+ * The scan is split into shards on the boundaries returned by
+ * `Table::SampleRows()` and up to `Options::max_streams` shards are read
+ * concurrently, each one using its own `Table::ReadRows()` stream. Workers
+ * claim the next unscanned shard as they finish their current one, so a few
+ * slow shards do not leave the remaining streams idle.
+ *
+ * Rows are delivered through `Next()`, by default in row key order. Delivery
+ * in row key order may have to wait for the shard holding the next key while
+ * other shards buffer rows (each shard buffers at most
+ * `Options::queue_depth` rows). Applications that do not need ordering can
+ * use `Options::SetPreserveOrder(false)` to receive rows as soon as any
+ * shard produces them; rows within a shard are always in order. In between,
+ * `Options::SetOrderingWindow()` delivers rows approximately in order: rows
+ * may come from any of the next few shards, so one slow shard does not
+ * block delivery until everything ahead of it has been consumed.
+ *
+ * @par Example
+ * @code
+ * bigtable::ParallelRowReader reader(
+ *     table, bigtable::RowSet(), bigtable::Filter::PassAllFilter());
+ * while (auto row = reader.Next()) {
+ *   if (!*row) {
+ *     std::cerr << "scan failed: " << row->status() << "\n";
+ *     break;
+ *   }
+ *   Process(**row);
+ * }
+ * @endcode
+ *
+ * @par Thread safety
+ * Only one thread may call `Next()` at a time. The object owns background
+ * threads; the destructor stops the scan and joins them, though it may have
+ * to wait for reads already in flight.
+ */
+class ParallelRowReader {
+ public:
+  /// Configuration for a `ParallelRowReader`.
+  struct Options {
+    Options();
+
+    /// Maximum number of `Table::ReadRows()` streams running concurrently.
+    Options& SetMaxStreams(std::size_t max_streams_arg) {
+      max_streams = max_streams_arg;
+      return *this;
+    }
+
+    /// Maximum number of rows buffered per shard waiting for delivery.
+    Options& SetQueueDepth(std::size_t queue_depth_arg) {
+      queue_depth = queue_depth_arg;
+      return *this;
+    }
+
+    /**
+     * Whether to deliver the rows in row key order.
+     *
+     * Set to `false` to deliver the rows as the shards produce them, which
+     * avoids waiting on a slow shard when the application does not care
+     * about ordering.
+     */
+    Options& SetPreserveOrder(bool preserve_order_arg) {
+      preserve_order = preserve_order_arg;
+      return *this;
+    }
+
+    /**
+     * Deliver the rows approximately in row key order.
+     *
+     * With a window of `n` the rows may be delivered from the first `n`
+     * shards (in row key order) that still have undelivered rows, always
+     * preferring the lowest-keyed shard with a row available. The default
+     * of 1 is strict row key order; larger windows keep delivering while
+     * the lowest-keyed shard is slow, at the cost of rows arriving at most
+     * `n - 1` shards ahead of strict order. A value of 0 is treated as 1.
+     * Ignored when `preserve_order` is `false`, which is equivalent to an
+     * unbounded window.
+     */
+    Options& SetOrderingWindow(std::size_t ordering_window_arg) {
+      ordering_window = ordering_window_arg;
+      return *this;
+    }
+
+    /**
+     * Plan the shards from a (shared) cache of row key samples.
+     *
+     * By default each scan calls `Table::SampleRows()` before it can start,
+     * a full RPC round trip. Applications issuing sharded scans frequently
+     * should share a `SampleRowKeysCache` between them so planning is
+     * instant. The reader invalidates the cache when a stream fails with
+     * `kAborted`, which suggests the table topology changed.
+     */
+    Options& SetSampleCache(std::shared_ptr<SampleRowKeysCache> cache_arg) {
+      sample_cache = std::move(cache_arg);
+      return *this;
+    }
+
+    std::size_t max_streams;
+    std::size_t queue_depth;
+    bool preserve_order;
+    std::size_t ordering_window;
+    std::shared_ptr<SampleRowKeysCache> sample_cache;
+  };
+
+  ParallelRowReader(Table table, RowSet row_set, Filter filter,
+                    Options options = Options());
+  ~ParallelRowReader();
+
+  // The background threads hold pointers to this object.
+  ParallelRowReader(ParallelRowReader&&) = delete;
+  ParallelRowReader(ParallelRowReader const&) = delete;
+
+  /**
+   * Return the next row of the scan.
+   *
+   * The first call samples the row keys and starts the background streams;
+   * later calls block until a row is available or the scan completes.
+   *
+   * Returns an engaged optional holding the row on success. If the sampling
+   * or any shard fails, returns an optional holding the error `Status` once,
+   * then an empty optional; rows buffered but not yet delivered when the
+   * error occurred are discarded. An empty optional means the scan is done.
+   */
+  absl::optional<StatusOr<Row>> Next();
+
+  /**
+   * Terminate the scan.
+   *
+   * Stops the background streams and joins the worker threads; reads already
+   * in flight are drained first. Any further call to `Next()` returns an
+   * empty optional.
+   */
+  void Cancel();
+
+ private:
+  /// The state of one shard of the scan.
+  struct Shard {
+    explicit Shard(RowSet rs) : row_set(std::move(rs)), done(false) {}
+
+    /// The portion of the scan covered by this shard, set before the workers
+    /// start and immutable afterwards.
+    RowSet row_set;
+    /// Rows read from the shard but not yet delivered, guarded by `mu_`.
+    std::queue<Row> rows;
+    /// The shard has been fully scanned (or abandoned), guarded by `mu_`.
+    bool done;
+  };
+
+  /// Sample the row keys, compute the shards and start the workers.
+  void Start();
+
+  /// The body of each worker thread: scan shards until none are left.
+  void WorkerLoop();
+
+  Table table_;
+  RowSet row_set_;
+  Filter filter_;
+  Options options_;
+
+  std::mutex mu_;
+  /// Signaled when a row is ready, a shard completes, or the scan fails.
+  std::condition_variable consumer_cv_;
+  /// Signaled when delivering a row makes room in a shard's queue.
+  std::condition_variable producer_cv_;
+  /// Set by the first call to `Next()`.
+  bool started_;
+  /// The scan was cancelled or abandoned after an error.
+  bool shutdown_;
+  /// The error (if any) has been returned from `Next()` already.
+  bool error_delivered_;
+  /// The first error reported by the sampling or by any shard.
+  Status status_;
+  /// The shards, in row key order; the vector is never resized after
+  /// `Start()`.
+  std::vector<Shard> shards_;
+  /// Index of the next shard to be claimed by a worker, guarded by `mu_`.
+  std::size_t scan_pos_;
+  /// Index of the first shard with undelivered rows, guarded by `mu_`.
+  std::size_t deliver_pos_;
+  /// Number of workers that have not exited yet, guarded by `mu_`.
+  std::size_t active_workers_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_ROW_READER_H
@@ -0,0 +1,231 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/parallel_row_reader.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace bigtable = google::cloud::bigtable;
+using ::testing::_;
+using ::testing::Return;
+
+namespace {
+
+namespace btproto = ::google::bigtable::v2;
+
+using bigtable::testing::MockReadRowsReader;
+using bigtable::testing::MockSampleRowKeysReader;
+
+class ParallelRowReaderTest : public bigtable::testing::TableTestFixture {
+ protected:
+  /// Expect one SampleRowKeys() call returning the given split points.
+  void ExpectSamples(std::vector<std::string> keys) {
+    auto reader = new MockSampleRowKeysReader(
+        "google.bigtable.v2.Bigtable.SampleRowKeys");
+    EXPECT_CALL(*client_, SampleRowKeys(_, _))
+        .WillOnce(reader->MakeMockReturner());
+    auto& expectation = EXPECT_CALL(*reader, Read(_));
+    std::int64_t offset = 0;
+    for (auto const& key : keys) {
+      offset += 1024;
+      expectation.WillOnce([key, offset](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key(key);
+        r->set_offset_bytes(offset);
+        return true;
+      });
+    }
+    expectation.WillOnce(Return(false));
+    EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  /// Create a mock ReadRows stream returning one row per key.
+  static std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
+  MakeRowsStream(std::vector<std::string> const& keys) {
+    auto responses =
+        std::make_shared<std::vector<btproto::ReadRowsResponse>>();
+    for (auto const& key : keys) {
+      responses->push_back(bigtable::testing::ReadRowsResponseFromString(R"(
+          chunks {
+            row_key: ")" + key + R"("
+            family_name { value: "fam" }
+            qualifier { value: "qual" }
+            timestamp_micros: 42000
+            value: "value"
+            commit_row: true
+          })"));
+    }
+    auto pos = std::make_shared<std::size_t>(0);
+    auto stream =
+        new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+    EXPECT_CALL(*stream, Read(_))
+        .WillRepeatedly([responses, pos](btproto::ReadRowsResponse* r) {
+          if (*pos >= responses->size()) {
+            return false;
+          }
+          *r = (*responses)[(*pos)++];
+          return true;
+        });
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+    return stream->AsUniqueMocked();
+  }
+};
+
+/// @test Verify that the shards are merged back in row key order.
+TEST_F(ParallelRowReaderTest, DeliversRowsInOrderAcrossShards) {
+  ExpectSamples({"k2", "k4"});
+
+  // The shards may be requested from any worker thread in any order, create
+  // the right stream based on the start of the requested range.
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillRepeatedly(
+          [](grpc::ClientContext*, btproto::ReadRowsRequest const& req) {
+            EXPECT_EQ(1, req.rows().row_ranges_size());
+            auto const& start = req.rows().row_ranges(0).start_key_closed();
+            if (start.empty()) {
+              return MakeRowsStream({"r1"});
+            }
+            if (start == "k2") {
+              return MakeRowsStream({"r2", "r3"});
+            }
+            EXPECT_EQ("k4", start);
+            return MakeRowsStream({"r4"});
+          });
+
+  bigtable::ParallelRowReader reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelRowReader::Options().SetMaxStreams(2));
+
+  std::vector<std::string> actual;
+  while (auto row = reader.Next()) {
+    ASSERT_STATUS_OK(*row);
+    actual.emplace_back((*row)->row_key());
+  }
+  EXPECT_EQ(std::vector<std::string>({"r1", "r2", "r3", "r4"}), actual);
+}
+
+/// @test Verify that unordered delivery returns every row.
+TEST_F(ParallelRowReaderTest, UnorderedDeliversAllRows) {
+  ExpectSamples({"k2"});
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillRepeatedly(
+          [](grpc::ClientContext*, btproto::ReadRowsRequest const& req) {
+            auto const& start = req.rows().row_ranges(0).start_key_closed();
+            if (start.empty()) {
+              return MakeRowsStream({"r1"});
+            }
+            return MakeRowsStream({"r2"});
+          });
+
+  bigtable::ParallelRowReader reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelRowReader::Options().SetMaxStreams(2).SetPreserveOrder(
+          false));
+
+  std::vector<std::string> actual;
+  while (auto row = reader.Next()) {
+    ASSERT_STATUS_OK(*row);
+    actual.emplace_back((*row)->row_key());
+  }
+  std::sort(actual.begin(), actual.end());
+  EXPECT_EQ(std::vector<std::string>({"r1", "r2"}), actual);
+}
+
+/// @test Verify that a bounded ordering window delivers every row.
+TEST_F(ParallelRowReaderTest, OrderingWindowDeliversAllRows) {
+  ExpectSamples({"k2", "k4"});
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillRepeatedly(
+          [](grpc::ClientContext*, btproto::ReadRowsRequest const& req) {
+            auto const& start = req.rows().row_ranges(0).start_key_closed();
+            if (start.empty()) {
+              return MakeRowsStream({"r1"});
+            }
+            if (start == "k2") {
+              return MakeRowsStream({"r2", "r3"});
+            }
+            return MakeRowsStream({"r4"});
+          });
+
+  // With a single stream the shards complete in key order, so a window of 2
+  // still delivers in key order; the window only matters for which buffered
+  // rows are eligible.
+  bigtable::ParallelRowReader reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelRowReader::Options().SetMaxStreams(1).SetOrderingWindow(
+          2));
+
+  std::vector<std::string> actual;
+  while (auto row = reader.Next()) {
+    ASSERT_STATUS_OK(*row);
+    actual.emplace_back((*row)->row_key());
+  }
+  EXPECT_EQ(std::vector<std::string>({"r1", "r2", "r3", "r4"}), actual);
+}
+
+/// @test Verify that a failure to sample the row keys is reported.
+TEST_F(ParallelRowReaderTest, SampleFailureIsReported) {
+  auto reader = new MockSampleRowKeysReader(
+      "google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(reader->MakeMockReturner());
+  EXPECT_CALL(*reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "nope")));
+
+  bigtable::ParallelRowReader parallel_reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter());
+
+  auto row = parallel_reader.Next();
+  ASSERT_TRUE(row.has_value());
+  ASSERT_FALSE(*row);
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied,
+            row->status().code());
+  EXPECT_FALSE(parallel_reader.Next().has_value());
+}
+
+/// @test Verify that a permanent failure in a shard stops the scan.
+TEST_F(ParallelRowReaderTest, ShardFailureIsReported) {
+  ExpectSamples({"k2"});
+
+  // With a single stream the first shard is scanned first; its failure is
+  // permanent, so the second shard is never requested.
+  auto stream =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  EXPECT_CALL(*stream, Read(_)).WillRepeatedly(Return(false));
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "nope")));
+  EXPECT_CALL(*client_, ReadRows(_, _)).WillOnce(stream->MakeMockReturner());
+
+  bigtable::ParallelRowReader parallel_reader(
+      table_, bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      bigtable::ParallelRowReader::Options().SetMaxStreams(1));
+
+  auto row = parallel_reader.Next();
+  ASSERT_TRUE(row.has_value());
+  ASSERT_FALSE(*row);
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied,
+            row->status().code());
+  EXPECT_FALSE(parallel_reader.Next().has_value());
+}
+
+}  // anonymous namespace
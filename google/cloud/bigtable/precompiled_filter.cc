@@ -0,0 +1,91 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/precompiled_filter.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+// The tags used when splicing serialized filters. In the protobuf wire
+// format a message-typed field is encoded as `(number << 3) | 2`, followed
+// by the payload length as a varint, followed by the serialized payload.
+// The field numbers are defined in `google/bigtable/v2/data.proto`.
+char constexpr kRowFilterChainTag = '\x0a';       // RowFilter.chain = 1
+char constexpr kRowFilterInterleaveTag = '\x12';  // RowFilter.interleave = 2
+// Chain.filters = 1 and Interleave.filters = 1
+char constexpr kFiltersTag = '\x0a';
+
+void AppendVarint(std::string& buffer, std::size_t value) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+/**
+ * Serialize a `RowFilter` holding a chain or interleave (per @p outer_tag)
+ * of the already serialized @p parts.
+ *
+ * Because the serialization of a message is the concatenation of the
+ * serializations of its fields, the result is identical to building the
+ * composite expression and serializing it, but requires no proto work.
+ */
+std::shared_ptr<std::string const> Splice(
+    char outer_tag, std::vector<PrecompiledFilter> const& parts) {
+  std::string payload;
+  for (auto const& part : parts) {
+    auto const& bytes = part.SerializedAsString();
+    payload.push_back(kFiltersTag);
+    AppendVarint(payload, bytes.size());
+    payload.append(bytes);
+  }
+  auto result = std::make_shared<std::string>();
+  result->push_back(outer_tag);
+  AppendVarint(*result, payload.size());
+  result->append(payload);
+  return result;
+}
+}  // namespace
+
+PrecompiledFilter PrecompiledFilter::Compile(Filter const& filter) {
+  auto bytes = std::make_shared<std::string>();
+  filter.as_proto().SerializeToString(bytes.get());
+  return PrecompiledFilter(std::move(bytes));
+}
+
+Filter PrecompiledFilter::as_filter() const {
+  Filter result;
+  // The bytes are always produced by serializing a `RowFilter`, this parse
+  // cannot fail.
+  result.filter_.ParseFromString(*filter_);
+  return result;
+}
+
+PrecompiledFilter PrecompiledFilter::ChainImpl(
+    std::vector<PrecompiledFilter> stages) {
+  return PrecompiledFilter(Splice(kRowFilterChainTag, stages));
+}
+
+PrecompiledFilter PrecompiledFilter::InterleaveImpl(
+    std::vector<PrecompiledFilter> streams) {
+  return PrecompiledFilter(Splice(kRowFilterInterleaveTag, streams));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
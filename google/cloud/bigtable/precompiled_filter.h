@@ -0,0 +1,128 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PRECOMPILED_FILTER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PRECOMPILED_FILTER_H
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/internal/conjunction.h"
+#include "google/cloud/bigtable/version.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A filter expression compiled to its serialized form.
+ *
+ * Applications that send the same filter expression on many requests can
+ * compile it once and reuse the result. A `PrecompiledFilter` stores the
+ * serialized `google.bigtable.v2.RowFilter` as shared immutable bytes:
+ * copies only bump a reference count, and `Chain()` and `Interleave()`
+ * compose precompiled parts by splicing their serialized forms, without
+ * rebuilding the filter expression.
+ *
+ * Use `as_filter()` to obtain a `Filter` for a request. This parses the
+ * serialized bytes in a single pass, which is cheaper than re-assembling a
+ * large expression from its parts, but is not free; the savings come from
+ * compiling the expression (or its fixed sub-expressions) ahead of time:
+ *
+ * @code
+ * auto const compiled = bigtable::PrecompiledFilter::Compile(
+ *     ComplexFilterForMyApplication());
+ * for (auto const& key : keys_to_read) {
+ *   auto row = table.ReadRow(key, compiled.as_filter());
+ *   ...
+ * }
+ * @endcode
+ */
+class PrecompiledFilter {
+ public:
+  PrecompiledFilter(PrecompiledFilter&&) noexcept = default;
+  PrecompiledFilter& operator=(PrecompiledFilter&&) noexcept = default;
+  PrecompiledFilter(PrecompiledFilter const&) = default;
+  PrecompiledFilter& operator=(PrecompiledFilter const&) = default;
+
+  /// Serialize @p filter, the result is shared by all copies.
+  static PrecompiledFilter Compile(Filter const& filter);
+
+  /**
+   * Return a chain filter composed of precompiled stages.
+   *
+   * This has the same semantics as `Filter::Chain()`, but the composition
+   * splices the serialized stages and does not build any protos.
+   *
+   * @tparam FilterTypes the type of the filter arguments. They must all be
+   *    convertible to PrecompiledFilter.
+   * @param stages the filter stages, see `Filter::Chain()` for the
+   *    restrictions imposed by the server on the stages.
+   */
+  template <typename... FilterTypes>
+  static PrecompiledFilter Chain(FilterTypes&&... stages) {
+    static_assert(
+        internal::conjunction<
+            std::is_convertible<FilterTypes, PrecompiledFilter>...>::value,
+        "The arguments passed to Chain(...) must be convertible to"
+        " PrecompiledFilter");
+    return ChainImpl({std::forward<FilterTypes>(stages)...});
+  }
+
+  /**
+   * Return an interleave filter composed of precompiled streams.
+   *
+   * This has the same semantics as `Filter::Interleave()`, but the
+   * composition splices the serialized streams and does not build any protos.
+   *
+   * @tparam FilterTypes the type of the filter arguments. They must all be
+   *    convertible to PrecompiledFilter.
+   * @param streams the filters to interleave, see `Filter::Interleave()` for
+   *    the restrictions imposed by the server on the streams.
+   */
+  template <typename... FilterTypes>
+  static PrecompiledFilter Interleave(FilterTypes&&... streams) {
+    static_assert(
+        internal::conjunction<
+            std::is_convertible<FilterTypes, PrecompiledFilter>...>::value,
+        "The arguments passed to Interleave(...) must be convertible to"
+        " PrecompiledFilter");
+    return InterleaveImpl({std::forward<FilterTypes>(streams)...});
+  }
+
+  /// Return the filter expression as a `Filter`, parsing the bytes once.
+  Filter as_filter() const;
+
+  /// Return the serialized `google.bigtable.v2.RowFilter` expression.
+  std::string const& SerializedAsString() const { return *filter_; }
+
+ private:
+  static PrecompiledFilter ChainImpl(std::vector<PrecompiledFilter> stages);
+  static PrecompiledFilter InterleaveImpl(
+      std::vector<PrecompiledFilter> streams);
+
+  explicit PrecompiledFilter(std::shared_ptr<std::string const> filter)
+      : filter_(std::move(filter)) {}
+
+  std::shared_ptr<std::string const> filter_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PRECOMPILED_FILTER_H
@@ -0,0 +1,92 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/precompiled_filter.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+
+using ::google::protobuf::util::MessageDifferencer;
+
+TEST(PrecompiledFilterTest, CompileRoundTrip) {
+  auto filter = bigtable::Filter::Chain(bigtable::Filter::FamilyRegex("fam"),
+                                        bigtable::Filter::Latest(1));
+  auto compiled = bigtable::PrecompiledFilter::Compile(filter);
+  std::string delta;
+  MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(filter.as_proto(),
+                                  compiled.as_filter().as_proto()))
+      << delta;
+}
+
+TEST(PrecompiledFilterTest, CopiesShareTheSerializedForm) {
+  auto compiled = bigtable::PrecompiledFilter::Compile(
+      bigtable::Filter::ColumnRegex("col[A-E]"));
+  auto copy = compiled;
+  EXPECT_EQ(&compiled.SerializedAsString(), &copy.SerializedAsString());
+}
+
+TEST(PrecompiledFilterTest, ChainMatchesFilterChain) {
+  auto a = bigtable::Filter::FamilyRegex("fam");
+  auto b = bigtable::Filter::Latest(2);
+  auto compiled = bigtable::PrecompiledFilter::Chain(
+      bigtable::PrecompiledFilter::Compile(a),
+      bigtable::PrecompiledFilter::Compile(b));
+  auto expected = bigtable::Filter::Chain(a, b);
+  std::string delta;
+  MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(expected.as_proto(),
+                                  compiled.as_filter().as_proto()))
+      << delta;
+}
+
+TEST(PrecompiledFilterTest, InterleaveMatchesFilterInterleave) {
+  auto a = bigtable::Filter::ColumnRegex("colA");
+  auto b = bigtable::Filter::ColumnRegex("colB");
+  auto compiled = bigtable::PrecompiledFilter::Interleave(
+      bigtable::PrecompiledFilter::Compile(a),
+      bigtable::PrecompiledFilter::Compile(b));
+  auto expected = bigtable::Filter::Interleave(a, b);
+  std::string delta;
+  MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(expected.as_proto(),
+                                  compiled.as_filter().as_proto()))
+      << delta;
+}
+
+TEST(PrecompiledFilterTest, NestedCompositionWithLongPayloads) {
+  // Use patterns longer than 127 bytes so the length prefixes spliced into
+  // the serialized form require multi-byte varints.
+  std::string const long_pattern(200, 'a');
+  auto a = bigtable::Filter::ValueRegex(long_pattern);
+  auto b = bigtable::Filter::RowKeysRegex(long_pattern);
+  auto c = bigtable::Filter::Latest(3);
+  auto compiled = bigtable::PrecompiledFilter::Chain(
+      bigtable::PrecompiledFilter::Interleave(
+          bigtable::PrecompiledFilter::Compile(a),
+          bigtable::PrecompiledFilter::Compile(b)),
+      bigtable::PrecompiledFilter::Compile(c));
+  auto expected =
+      bigtable::Filter::Chain(bigtable::Filter::Interleave(a, b), c);
+  std::string delta;
+  MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(expected.as_proto(),
+                                  compiled.as_filter().as_proto()))
+      << delta;
+}
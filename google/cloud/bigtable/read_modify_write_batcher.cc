@@ -0,0 +1,129 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_modify_write_batcher.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+
+namespace {
+// Enough concurrency to keep several channels busy; operations on the same
+// row serialize anyway, so higher values only help very spread-out key sets.
+std::size_t const kDefaultMaxOutstandingRequests = 16;
+}  // namespace
+
+ReadModifyWriteBatcher::Options::Options()
+    : max_outstanding_requests(kDefaultMaxOutstandingRequests) {}
+
+std::pair<future<void>, future<StatusOr<Row>>>
+ReadModifyWriteBatcher::AsyncReadModifyWriteRow(
+    CompletionQueue& cq, std::string row_key,
+    std::vector<ReadModifyWriteRule> rules) {
+  AdmissionPromise admission_promise;
+  CompletionPromise completion_promise;
+  auto res = std::make_pair(admission_promise.get_future(),
+                            completion_promise.get_future());
+
+  std::unique_lock<std::mutex> lk(mu_);
+  ++num_requests_pending_;
+  pending_requests_.push_back(
+      PendingRequest{std::move(row_key), std::move(rules),
+                     std::move(completion_promise),
+                     std::move(admission_promise)});
+  StartPendingRequests(cq, lk);
+  return res;
+}
+
+future<void> ReadModifyWriteBatcher::AsyncWaitForNoPendingRequests() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (num_requests_pending_ == 0 && num_outstanding_requests_ == 0) {
+    return make_ready_future();
+  }
+  no_more_pending_promises_.emplace_back();
+  return no_more_pending_promises_.back().get_future();
+}
+
+future<StatusOr<Row>> ReadModifyWriteBatcher::AsyncReadModifyWriteRowImpl(
+    Table& table, CompletionQueue& cq, std::string row_key,
+    std::vector<ReadModifyWriteRule> rules) {
+  return table.AsyncReadModifyWriteRow(std::move(row_key), cq,
+                                       std::move(rules));
+}
+
+void ReadModifyWriteBatcher::StartPendingRequests(
+    CompletionQueue& cq, std::unique_lock<std::mutex>& lk) {
+  std::vector<PendingRequest> to_start;
+  for (auto it = pending_requests_.begin(); it != pending_requests_.end();) {
+    if (num_outstanding_requests_ >= options_.max_outstanding_requests) {
+      break;
+    }
+    if (keys_in_flight_.find(it->row_key) != keys_in_flight_.end()) {
+      // An operation on this row is in flight, the queued one must wait for
+      // it to preserve per-key ordering.
+      ++it;
+      continue;
+    }
+    keys_in_flight_.insert(it->row_key);
+    ++num_outstanding_requests_;
+    to_start.emplace_back(std::move(*it));
+    it = pending_requests_.erase(it);
+  }
+  lk.unlock();
+  // Satisfy the admission promises and start the RPCs with the lock
+  // released; user-installed continuations may call back into this object.
+  for (auto& request : to_start) {
+    request.admission_promise.set_value();
+    auto completion_promise = std::make_shared<CompletionPromise>(
+        std::move(request.completion_promise));
+    auto row_key = request.row_key;
+    auto self = this;
+    AsyncReadModifyWriteRowImpl(table_, cq, std::move(request.row_key),
+                                std::move(request.rules))
+        .then([self, completion_promise, cq,
+               row_key](future<StatusOr<Row>> row) mutable {
+          completion_promise->set_value(row.get());
+          self->OnRequestDone(cq, row_key);
+        });
+  }
+}
+
+void ReadModifyWriteBatcher::OnRequestDone(CompletionQueue& cq,
+                                           std::string const& row_key) {
+  std::unique_lock<std::mutex> lk(mu_);
+  keys_in_flight_.erase(row_key);
+  --num_outstanding_requests_;
+  --num_requests_pending_;
+  if (!pending_requests_.empty()) {
+    StartPendingRequests(cq, lk);
+    return;
+  }
+  std::vector<NoMorePendingPromise> no_more_pending_promises;
+  if (num_requests_pending_ == 0 && num_outstanding_requests_ == 0) {
+    // We should wait not only on num_requests_pending_ being zero but also on
+    // num_outstanding_requests_ because we want to allow the user to shut
+    // down the completion queue after this promise is fulfilled.
+    no_more_pending_promises.swap(no_more_pending_promises_);
+  }
+  lk.unlock();
+  for (auto& promise : no_more_pending_promises) {
+    promise.set_value();
+  }
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
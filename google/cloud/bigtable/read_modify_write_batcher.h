@@ -0,0 +1,173 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_MODIFY_WRITE_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_MODIFY_WRITE_BATCHER_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/read_modify_write_rule.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Objects of this class pipeline many `ReadModifyWriteRow` operations.
+ *
+ * Applications that maintain high-rate counters need many
+ * `ReadModifyWriteRow` RPCs in flight to achieve throughput, but operations
+ * on the *same* row must be issued one at a time to keep their effects (and
+ * the values they return) in submission order. This class provides both:
+ * submit operations with `AsyncReadModifyWriteRow()` and the batcher keeps a
+ * bounded number of RPCs in flight, never more than one per row key, queuing
+ * the rest.
+ *
+ * This class also offers an easy-to-use flow control mechanism to avoid
+ * unbounded growth in its internal buffers.
+ *
+ * Applications must provide a `CompletionQueue` to (asynchronously) execute
+ * these operations. The application is responsible of executing the
+ * `CompletionQueue` event loop in one or more threads.
+ */
+class ReadModifyWriteBatcher {
+ public:
+  /// Configuration for `ReadModifyWriteBatcher`.
+  struct Options {
+    Options();
+
+    /// There will be no more RPCs outstanding (except for retries) than this.
+    Options& SetMaxOutstandingRequests(
+        std::size_t max_outstanding_requests_arg) {
+      max_outstanding_requests = max_outstanding_requests_arg;
+      return *this;
+    }
+
+    std::size_t max_outstanding_requests;
+  };
+
+  explicit ReadModifyWriteBatcher(Table table, Options options = Options())
+      : table_(std::move(table)),
+        options_(options),
+        num_outstanding_requests_(),
+        num_requests_pending_() {}
+
+  virtual ~ReadModifyWriteBatcher() = default;
+
+  /**
+   * Asynchronously perform a read-modify-write operation.
+   *
+   * The operation is started immediately if fewer than
+   * `Options::max_outstanding_requests` operations are in flight and no
+   * operation for the same row key is in flight; it is queued otherwise.
+   * Operations on the same row key execute (and therefore complete) in
+   * submission order.
+   *
+   * @param cq the completion queue that will execute the asynchronous
+   *    calls, the application must ensure that one or more threads are
+   *    blocked on `cq.Run()`.
+   * @param row_key the row to modify.
+   * @param rules the modifications to perform, must not be empty.
+   *
+   * @return *admission* and *completion* futures
+   *
+   * The *completion* future reports the modified cells (or the error) once
+   * the operation completes. The *admission* future is satisfied when the
+   * operation is sent to the service, and should be used for flow control as
+   * described in `MutationBatcher::AsyncApply()`.
+   */
+  std::pair<future<void>, future<StatusOr<Row>>> AsyncReadModifyWriteRow(
+      CompletionQueue& cq, std::string row_key,
+      std::vector<ReadModifyWriteRule> rules);
+
+  /**
+   * Asynchronously wait until all submitted operations complete.
+   *
+   * @return a future which will be satisfied once all operations submitted
+   *     before calling this function finish; if there are no such operations,
+   *     the returned future is already satisfied.
+   */
+  future<void> AsyncWaitForNoPendingRequests();
+
+ protected:
+  // Wrap calling the underlying operation in a virtual function to ease
+  // testing.
+  virtual future<StatusOr<Row>> AsyncReadModifyWriteRowImpl(
+      Table& table, CompletionQueue& cq, std::string row_key,
+      std::vector<ReadModifyWriteRule> rules);
+
+ private:
+  using CompletionPromise = promise<StatusOr<Row>>;
+  using AdmissionPromise = promise<void>;
+  using NoMorePendingPromise = promise<void>;
+
+  /// A read-modify-write operation waiting for an execution slot.
+  struct PendingRequest {
+    std::string row_key;
+    std::vector<ReadModifyWriteRule> rules;
+    CompletionPromise completion_promise;
+    AdmissionPromise admission_promise;
+  };
+
+  /**
+   * Start as many pending operations as the limits allow.
+   *
+   * Operations are considered in submission order; an operation whose row
+   * key already has an operation in flight stays queued, which preserves
+   * per-key ordering. Satisfies the admission promises of the started
+   * operations. Unlocks `lk`.
+   */
+  void StartPendingRequests(CompletionQueue& cq,
+                            std::unique_lock<std::mutex>& lk);
+
+  /// Handle the completion of the operation on @p row_key.
+  void OnRequestDone(CompletionQueue& cq, std::string const& row_key);
+
+  std::mutex mu_;
+  Table table_;
+  Options options_;
+
+  /// Number of RPCs sent but not completed.
+  std::size_t num_outstanding_requests_;
+  /// Number of uncompleted operations (including not yet started).
+  std::size_t num_requests_pending_;
+
+  /// The operations waiting for an execution slot, in submission order.
+  std::deque<PendingRequest> pending_requests_;
+  /// The row keys with an operation in flight.
+  std::unordered_set<std::string> keys_in_flight_;
+
+  /**
+   * The list of promises made to this point.
+   *
+   * These promises are satisfied as part of calling
+   * `AsyncWaitForNoPendingRequests()`.
+   */
+  std::vector<NoMorePendingPromise> no_more_pending_promises_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_READ_MODIFY_WRITE_BATCHER_H
@@ -0,0 +1,146 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/read_modify_write_batcher.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/**
+ * A `ReadModifyWriteBatcher` whose underlying operations are completed by
+ * hand.
+ *
+ * Started operations are recorded in `started_keys_` with a matching
+ * promise; the tests control when (and with what result) they complete.
+ */
+class ReadModifyWriteBatcherForTest : public ReadModifyWriteBatcher {
+ public:
+  using ReadModifyWriteBatcher::ReadModifyWriteBatcher;
+
+  std::vector<std::string> const& started_keys() const {
+    return started_keys_;
+  }
+
+  /// Complete the operation started at position @p index with @p result.
+  void CompleteOperation(std::size_t index, StatusOr<Row> result) {
+    operation_promises_[index].set_value(std::move(result));
+  }
+
+ protected:
+  future<StatusOr<Row>> AsyncReadModifyWriteRowImpl(
+      Table&, CompletionQueue&, std::string row_key,
+      std::vector<ReadModifyWriteRule>) override {
+    started_keys_.push_back(std::move(row_key));
+    operation_promises_.emplace_back();
+    return operation_promises_.back().get_future();
+  }
+
+ private:
+  std::vector<std::string> started_keys_;
+  std::deque<promise<StatusOr<Row>>> operation_promises_;
+};
+
+class ReadModifyWriteBatcherTest : public bigtable::testing::TableTestFixture {
+ protected:
+  std::pair<future<void>, future<StatusOr<Row>>> Submit(
+      ReadModifyWriteBatcher& batcher, std::string row_key) {
+    return batcher.AsyncReadModifyWriteRow(
+        cq_, std::move(row_key),
+        {ReadModifyWriteRule::IncrementAmount("fam", "counter", 1)});
+  }
+
+  CompletionQueue cq_;
+};
+
+TEST_F(ReadModifyWriteBatcherTest, OperationsOnSameKeySerialize) {
+  ReadModifyWriteBatcherForTest batcher(table_);
+
+  auto op1 = Submit(batcher, "k1");
+  auto op2 = Submit(batcher, "k1");
+  auto op3 = Submit(batcher, "k2");
+  // The second operation on "k1" must wait for the first, "k2" proceeds.
+  EXPECT_THAT(batcher.started_keys(), ::testing::ElementsAre("k1", "k2"));
+  EXPECT_TRUE(op1.first.is_ready());
+  EXPECT_FALSE(op2.first.is_ready());
+  EXPECT_TRUE(op3.first.is_ready());
+
+  batcher.CompleteOperation(0, Row("k1", {}));
+  EXPECT_THAT(batcher.started_keys(),
+              ::testing::ElementsAre("k1", "k2", "k1"));
+  EXPECT_TRUE(op2.first.is_ready());
+
+  ASSERT_STATUS_OK(op1.second.get());
+  batcher.CompleteOperation(1, Row("k2", {}));
+  batcher.CompleteOperation(2, Row("k1", {}));
+  ASSERT_STATUS_OK(op2.second.get());
+  ASSERT_STATUS_OK(op3.second.get());
+}
+
+TEST_F(ReadModifyWriteBatcherTest, MaxOutstandingRequestsIsEnforced) {
+  ReadModifyWriteBatcherForTest batcher(
+      table_, ReadModifyWriteBatcher::Options().SetMaxOutstandingRequests(2));
+
+  auto op1 = Submit(batcher, "k1");
+  auto op2 = Submit(batcher, "k2");
+  auto op3 = Submit(batcher, "k3");
+  EXPECT_THAT(batcher.started_keys(), ::testing::ElementsAre("k1", "k2"));
+  EXPECT_FALSE(op3.first.is_ready());
+
+  batcher.CompleteOperation(0, Row("k1", {}));
+  EXPECT_THAT(batcher.started_keys(),
+              ::testing::ElementsAre("k1", "k2", "k3"));
+  EXPECT_TRUE(op3.first.is_ready());
+
+  batcher.CompleteOperation(1, Row("k2", {}));
+  batcher.CompleteOperation(2, Row("k3", {}));
+}
+
+TEST_F(ReadModifyWriteBatcherTest, ErrorsAreDelivered) {
+  ReadModifyWriteBatcherForTest batcher(table_);
+
+  auto op = Submit(batcher, "k1");
+  batcher.CompleteOperation(0, Status(StatusCode::kPermissionDenied, "no"));
+  auto row = op.second.get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, row.status().code());
+}
+
+TEST_F(ReadModifyWriteBatcherTest, AsyncWaitForNoPendingRequests) {
+  ReadModifyWriteBatcherForTest batcher(table_);
+
+  // With no operations submitted the returned future is already satisfied.
+  EXPECT_TRUE(batcher.AsyncWaitForNoPendingRequests().is_ready());
+
+  auto op1 = Submit(batcher, "k1");
+  auto op2 = Submit(batcher, "k1");
+  auto no_more_pending = batcher.AsyncWaitForNoPendingRequests();
+  EXPECT_FALSE(no_more_pending.is_ready());
+
+  batcher.CompleteOperation(0, Row("k1", {}));
+  EXPECT_FALSE(no_more_pending.is_ready());
+  batcher.CompleteOperation(1, Row("k1", {}));
+  EXPECT_TRUE(no_more_pending.is_ready());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -18,6 +18,7 @@
 #include "google/cloud/bigtable/cell.h"
 #include "google/cloud/bigtable/row_key.h"
 #include "google/cloud/bigtable/version.h"
+#include <memory>
 #include <vector>
 
 namespace google {
@@ -30,26 +31,43 @@ inline namespace BIGTABLE_CLIENT_NS {
  * Notice that a row returned by the Bigtable Client may have been filtered by
  * any filtering expressions provided by the application, and may not contain
  * all the data available.
+ *
+ * Copies of a `Row` share the (immutable) cell storage, so passing rows by
+ * value, e.g. when fanning a scan out to multiple consumers, costs O(1)
+ * regardless of the number of cells. The storage is copied only when a copy
+ * moves the cells out from under the other owners (see `cells() &&`).
  */
 class Row {
  public:
   /// Create a row from a list of cells.
   template <typename T>
   Row(T&& row_key, std::vector<Cell> cells)
-      : row_key_(std::forward<T>(row_key)), cells_(std::move(cells)) {}
+      : row_key_(std::forward<T>(row_key)),
+        cells_(std::make_shared<std::vector<Cell>>(std::move(cells))) {}
 
   /// Return the row key. The returned value is not valid
   /// after this object is deleted.
   RowKeyType const& row_key() const { return row_key_; }
 
   /// Return all cells.
-  std::vector<Cell> const& cells() const& { return cells_; }
+  std::vector<Cell> const& cells() const& {
+    static std::vector<Cell> const kEmpty;
+    return cells_ ? *cells_ : kEmpty;
+  }
   /// Return all cells.
-  std::vector<Cell>&& cells() && { return std::move(cells_); }
+  std::vector<Cell>&& cells() && {
+    if (!cells_ || cells_.use_count() != 1) {
+      // Moving out of storage shared with other rows would be visible to
+      // them, detach into a private copy first. This is the same cost the
+      // copy that created the sharing used to pay eagerly.
+      cells_ = std::make_shared<std::vector<Cell>>(cells());
+    }
+    return std::move(*cells_);
+  }
 
  private:
   RowKeyType row_key_;
-  std::vector<Cell> cells_;
+  std::shared_ptr<std::vector<Cell>> cells_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
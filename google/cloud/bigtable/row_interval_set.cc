@@ -0,0 +1,155 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_interval_set.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// The smallest key larger than @p key, keys ordered as byte strings.
+std::string Successor(std::string key) {
+  key.push_back('\0');
+  return key;
+}
+
+/// The canonical (inclusive) start key for @p range.
+std::string CanonicalStart(
+    ::google::bigtable::v2::RowRange const& row_range) {
+  switch (row_range.start_key_case()) {
+    case ::google::bigtable::v2::RowRange::kStartKeyClosed:
+      return row_range.start_key_closed();
+    case ::google::bigtable::v2::RowRange::kStartKeyOpen:
+      return Successor(row_range.start_key_open());
+    default:
+      return "";
+  }
+}
+
+/// The canonical (exclusive) end bound for @p range.
+absl::optional<std::string> CanonicalEnd(
+    ::google::bigtable::v2::RowRange const& row_range) {
+  switch (row_range.end_key_case()) {
+    case ::google::bigtable::v2::RowRange::kEndKeyOpen:
+      return row_range.end_key_open();
+    case ::google::bigtable::v2::RowRange::kEndKeyClosed:
+      return Successor(row_range.end_key_closed());
+    default:
+      return absl::optional<std::string>();
+  }
+}
+
+}  // namespace
+
+void RowIntervalSet::Append(RowRange const& range) {
+  Insert(CanonicalStart(range.as_proto()), CanonicalEnd(range.as_proto()));
+}
+
+void RowIntervalSet::Append(std::string row_key) {
+  auto end = Successor(row_key);
+  Insert(std::move(row_key), EndBound(std::move(end)));
+}
+
+void RowIntervalSet::Insert(std::string start, EndBound end) {
+  if (end && *end <= start) {
+    return;
+  }
+  // Find the first interval starting at or before `start` that reaches it,
+  // i.e., the first interval [start, end) must be coalesced with.
+  auto it = intervals_.upper_bound(start);
+  if (it != intervals_.begin()) {
+    auto prev = std::prev(it);
+    if (!prev->second || *prev->second >= start) {
+      it = prev;
+    }
+  }
+  // Absorb every interval that overlaps or touches [start, end), growing
+  // the bounds as needed.
+  while (it != intervals_.end() && (!end || it->first <= *end)) {
+    if (it->first < start) {
+      start = it->first;
+    }
+    if (end && (!it->second || *it->second > *end)) {
+      end = it->second;
+    }
+    it = intervals_.erase(it);
+  }
+  intervals_.emplace_hint(it, std::move(start), std::move(end));
+}
+
+RowIntervalSet RowIntervalSet::Intersect(RowRange const& range) const {
+  auto const start = CanonicalStart(range.as_proto());
+  auto const end = CanonicalEnd(range.as_proto());
+  RowIntervalSet result;
+  if (end && *end <= start) {
+    return result;
+  }
+  // Find the first interval that may overlap [start, end).
+  auto it = intervals_.upper_bound(start);
+  if (it != intervals_.begin()) {
+    auto prev = std::prev(it);
+    if (!prev->second || *prev->second > start) {
+      it = prev;
+    }
+  }
+  for (; it != intervals_.end() && (!end || it->first < *end); ++it) {
+    auto s = (std::max)(it->first, start);
+    auto e = it->second;
+    if (end && (!e || *end < *e)) {
+      e = end;
+    }
+    if (e && *e <= s) {
+      continue;
+    }
+    result.intervals_.emplace_hint(result.intervals_.end(), std::move(s),
+                                   std::move(e));
+  }
+  return result;
+}
+
+RowSet RowIntervalSet::AsRowSet() const {
+  if (intervals_.empty()) {
+    return RowSet(RowRange::Empty());
+  }
+  RowSet result;
+  for (auto const& kv : intervals_) {
+    auto const& end = kv.second;
+    if (end && *end == Successor(kv.first)) {
+      result.Append(kv.first);
+      continue;
+    }
+    ::google::bigtable::v2::RowRange range;
+    if (!kv.first.empty()) {
+      range.set_start_key_closed(kv.first);
+    }
+    if (end) {
+      // Prefer a closed bound over an open bound at an artificial successor
+      // key, the resulting proto is smaller and easier to read.
+      if (end->back() == '\0') {
+        range.set_end_key_closed(end->data(), end->size() - 1);
+      } else {
+        range.set_end_key_open(*end);
+      }
+    }
+    result.Append(RowRange(std::move(range)));
+  }
+  return result;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,111 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_INTERVAL_SET_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_INTERVAL_SET_H
+
+#include "google/cloud/bigtable/row_range.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include "absl/types/optional.h"
+#include <map>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Represent a set of row keys as sorted, disjoint intervals.
+ *
+ * `RowSet` stores its keys and ranges exactly as they were appended, so a
+ * set built from many overlapping elements carries redundant entries that
+ * inflate the request and that `RowSet::Intersect()` must scan linearly.
+ * This class keeps the same information normalized: elements are coalesced
+ * as they are inserted (`O(log n)` amortized per insert), and intersecting
+ * with a range only examines the intervals that overlap it. This matters
+ * when splitting a scan into shards, where the same large set is
+ * intersected with each shard's range.
+ *
+ * Every row key and range is reduced to a half-open interval of keys: keys
+ * are totally ordered as byte strings, so a closed bound and the open bound
+ * at the key's successor (the key with a NUL byte appended) describe the
+ * same set of keys.
+ *
+ * @note A default constructed `RowIntervalSet` is empty, while a default
+ *     constructed `RowSet` matches all rows in the table. Use
+ *     `Append(RowRange::InfiniteRange())` to match all rows.
+ */
+class RowIntervalSet {
+ public:
+  /// Create an empty set.
+  RowIntervalSet() = default;
+
+  RowIntervalSet(RowIntervalSet&&) = default;
+  RowIntervalSet& operator=(RowIntervalSet&&) = default;
+  RowIntervalSet(RowIntervalSet const&) = default;
+  RowIntervalSet& operator=(RowIntervalSet const&) = default;
+
+  /// Add @p range to the set, coalescing with any intervals it overlaps.
+  void Append(RowRange const& range);
+
+  /// Add the single row @p row_key to the set.
+  void Append(std::string row_key);
+
+  /**
+   * Return the intersection of this set and @p range.
+   *
+   * Only the intervals overlapping @p range are examined, so this is cheap
+   * even on large sets.
+   */
+  RowIntervalSet Intersect(RowRange const& range) const;
+
+  /// Return true if the set matches no rows.
+  bool IsEmpty() const { return intervals_.empty(); }
+
+  /// Return the number of disjoint intervals in the set.
+  std::size_t size() const { return intervals_.size(); }
+
+  /**
+   * Convert the set to a `RowSet` suitable for `Table::ReadRows()`.
+   *
+   * Intervals holding a single key become `row_keys` entries, the rest
+   * become `row_ranges`. An empty set converts to a `RowSet` matching no
+   * rows (not to the default `RowSet`, which matches all rows).
+   */
+  RowSet AsRowSet() const;
+
+ private:
+  /// An exclusive upper bound for an interval, disengaged means "no bound".
+  using EndBound = absl::optional<std::string>;
+
+  /// Insert the canonical interval [@p start, @p end), coalescing.
+  void Insert(std::string start, EndBound end);
+
+  /**
+   * The intervals, keyed by their (inclusive) start key.
+   *
+   * The class maintains the invariants that no interval is empty and that
+   * no two intervals overlap or touch; this keeps the representation
+   * canonical, two sets with the same contents compare equal element by
+   * element.
+   */
+  std::map<std::string, EndBound> intervals_;
+};
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_INTERVAL_SET_H
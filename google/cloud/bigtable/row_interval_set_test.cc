@@ -0,0 +1,133 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_interval_set.h"
+#include <google/protobuf/text_format.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <gmock/gmock.h>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+
+namespace {
+void CheckAsRowSet(bigtable::RowIntervalSet const& actual,
+                   std::string const& expected_text) {
+  btproto::RowSet expected;
+  ASSERT_TRUE(google::protobuf::TextFormat::ParseFromString(expected_text,
+                                                            &expected));
+  std::string delta;
+  google::protobuf::util::MessageDifferencer differencer;
+  differencer.ReportDifferencesToString(&delta);
+  EXPECT_TRUE(differencer.Compare(expected, actual.AsRowSet().as_proto()))
+      << delta;
+}
+}  // anonymous namespace
+
+TEST(RowIntervalSetTest, DefaultIsEmpty) {
+  bigtable::RowIntervalSet set;
+  EXPECT_TRUE(set.IsEmpty());
+  EXPECT_EQ(0U, set.size());
+  // An empty set converts to a RowSet matching no rows.
+  EXPECT_TRUE(set.AsRowSet().IsEmpty());
+}
+
+TEST(RowIntervalSetTest, CoalescesOverlappingRanges) {
+  bigtable::RowIntervalSet set;
+  set.Append(bigtable::RowRange::RightOpen("a", "c"));
+  set.Append(bigtable::RowRange::RightOpen("f", "h"));
+  set.Append(bigtable::RowRange::RightOpen("b", "d"));
+  EXPECT_EQ(2U, set.size());
+  // Adjacent intervals coalesce too.
+  set.Append(bigtable::RowRange::RightOpen("d", "f"));
+  EXPECT_EQ(1U, set.size());
+  CheckAsRowSet(set, R"""(
+      row_ranges: { start_key_closed: "a" end_key_open: "h" }
+  )""");
+}
+
+TEST(RowIntervalSetTest, CoalescesContainedElements) {
+  bigtable::RowIntervalSet set;
+  set.Append(bigtable::RowRange::RightOpen("a", "z"));
+  set.Append(bigtable::RowRange::Closed("b", "c"));
+  set.Append(std::string("m"));
+  EXPECT_EQ(1U, set.size());
+  CheckAsRowSet(set, R"""(
+      row_ranges: { start_key_closed: "a" end_key_open: "z" }
+  )""");
+}
+
+TEST(RowIntervalSetTest, ClosedAndOpenBoundsCanonicalize) {
+  bigtable::RowIntervalSet set;
+  // [a, b] and (b, c) touch exactly: (b, ...) starts at the successor of b.
+  set.Append(bigtable::RowRange::Closed("a", "b"));
+  set.Append(bigtable::RowRange::Open("b", "c"));
+  EXPECT_EQ(1U, set.size());
+  CheckAsRowSet(set, R"""(
+      row_ranges: { start_key_closed: "a" end_key_open: "c" }
+  )""");
+}
+
+TEST(RowIntervalSetTest, PointKeysMergeIntoRanges) {
+  bigtable::RowIntervalSet set;
+  set.Append(std::string("k"));
+  set.Append(std::string("k"));
+  EXPECT_EQ(1U, set.size());
+  // A single-key interval converts back to a row_keys entry.
+  CheckAsRowSet(set, R"""( row_keys: "k" )""");
+
+  set.Append(bigtable::RowRange::RightOpen("a", "k"));
+  EXPECT_EQ(1U, set.size());
+  CheckAsRowSet(set, R"""(
+      row_ranges: { start_key_closed: "a" end_key_closed: "k" }
+  )""");
+}
+
+TEST(RowIntervalSetTest, EmptyRangesAreIgnored) {
+  bigtable::RowIntervalSet set;
+  set.Append(bigtable::RowRange::Empty());
+  set.Append(bigtable::RowRange::RightOpen("c", "a"));
+  EXPECT_TRUE(set.IsEmpty());
+}
+
+TEST(RowIntervalSetTest, Intersect) {
+  bigtable::RowIntervalSet set;
+  set.Append(bigtable::RowRange::RightOpen("a", "c"));
+  set.Append(bigtable::RowRange::RightOpen("e", "g"));
+  set.Append(std::string("x"));
+
+  auto i1 = set.Intersect(bigtable::RowRange::RightOpen("b", "f"));
+  EXPECT_EQ(2U, i1.size());
+  CheckAsRowSet(i1, R"""(
+      row_ranges: { start_key_closed: "b" end_key_open: "c" }
+      row_ranges: { start_key_closed: "e" end_key_open: "f" }
+  )""");
+
+  auto i2 = set.Intersect(bigtable::RowRange::StartingAt("w"));
+  CheckAsRowSet(i2, R"""( row_keys: "x" )""");
+
+  auto i3 = set.Intersect(bigtable::RowRange::RightOpen("c", "e"));
+  EXPECT_TRUE(i3.IsEmpty());
+}
+
+TEST(RowIntervalSetTest, IntersectInfiniteInterval) {
+  bigtable::RowIntervalSet set;
+  set.Append(bigtable::RowRange::InfiniteRange());
+  EXPECT_EQ(1U, set.size());
+
+  auto i = set.Intersect(bigtable::RowRange::RightOpen("a", "b"));
+  CheckAsRowSet(i, R"""(
+      row_ranges: { start_key_closed: "a" end_key_open: "b" }
+  )""");
+  CheckAsRowSet(set, R"""( row_ranges: { } )""");
+}
@@ -83,8 +83,18 @@ class RowRange {
   /// Return a range that contains all the keys starting with @p prefix.
   template <typename T>
   static RowRange Prefix(T&& prefix) {
-    auto end = internal::PrefixRangeEnd(prefix);
-    return RightOpen(std::forward<T>(prefix), std::move(end));
+    RowRange result;
+    auto& range = result.row_range_;
+    // Compute the end bound in place inside the proto, avoiding a temporary
+    // string; the prefix itself can then be moved into the start bound.
+    *range.mutable_end_key_open() = prefix;
+    internal::PrefixRangeEndInPlace(*range.mutable_end_key_open());
+    if (range.end_key_open().empty()) {
+      // When appearing as the end bound, the empty string means +infinity.
+      range.clear_end_key_open();
+    }
+    range.set_start_key_closed(std::forward<T>(prefix));
+    return result;
   }
 
   //@{
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/bigtable/row_reader.h"
+#include "google/cloud/bigtable/internal/prefetching_read_rows_reader.h"
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/throw_delegate.h"
@@ -103,7 +104,33 @@ RowReader::iterator RowReader::begin() {
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 RowReader::iterator RowReader::end() { return internal::RowReaderIterator(); }
 
+Status RowReader::ForEach(std::function<bool(Row&)> const& on_row) {
+  for (;;) {
+    auto row = Advance();
+    if (!row) {
+      return std::move(row).status();
+    }
+    if (!row->has_value()) {
+      return Status();
+    }
+    if (!on_row(**row)) {
+      Cancel();
+      return Status();
+    }
+  }
+}
+
 void RowReader::MakeRequest() {
+  if (stream_) {
+    // When restarting after a parse failure the previous stream is still
+    // open; cancel it so its prefetcher can complete the read it has in
+    // flight before the stream is discarded.
+    if (stream_is_open_) {
+      context_->TryCancel();
+      stream_is_open_ = false;
+    }
+    stream_.reset();
+  }
   response_ = {};
   processed_chunks_count_ = 0;
 
@@ -125,7 +152,11 @@ void RowReader::MakeRequest() {
   retry_policy_->Setup(*context_);
   backoff_policy_->Setup(*context_);
   metadata_update_policy_.Setup(*context_);
-  stream_ = client_->ReadRows(context_.get(), request);
+  // Read responses ahead of the parser, so the network transfer of the next
+  // batch overlaps with parsing the current one and with the application
+  // processing the rows.
+  stream_ = absl::make_unique<internal::PrefetchingReadRowsReader>(
+      client_->ReadRows(context_.get(), request));
   stream_is_open_ = true;
 
   parser_ = parser_factory_->Create();
@@ -30,6 +30,7 @@
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <grpcpp/grpcpp.h>
 #include <cinttypes>
+#include <functional>
 #include <iterator>
 
 namespace google {
@@ -39,7 +40,8 @@ inline namespace BIGTABLE_CLIENT_NS {
 /**
  * Object returned by Table::ReadRows(), enumerates rows in the response.
  *
- * Iterate over the results of ReadRows() using the STL idioms.
+ * Iterate over the results of ReadRows() using the STL idioms, or visit
+ * them in place with `ForEach()`.
  */
 class RowReader {
  public:
@@ -93,6 +95,36 @@ class RowReader {
   /// End iterator over the rows in the response.
   iterator end();
 
+  /**
+   * Invoke @p on_row for each row in the response.
+   *
+   * This is a lighter-weight alternative to the iterator interface: each
+   * row is handed to the callback by reference, straight from the parse
+   * loop, without the per-row `StatusOr<Row>` wrapping and iterator state
+   * that `begin()`/`end()` maintain. The reference is only valid for the
+   * duration of the callback; a callback that needs to keep the row may
+   * move from it.
+   *
+   * The callback returns `true` to continue the scan and `false` to stop
+   * it early; stopping early is not an error.
+   *
+   * Retry and backoff policies are honored. Do not mix this function with
+   * the iterator interface on the same `RowReader`.
+   *
+   * @par Example
+   * @code
+   * auto status = table.ReadRows(std::move(rows), std::move(filter))
+   *     .ForEach([&](bigtable::Row& row) {
+   *       Process(row);
+   *       return true;
+   *     });
+   * if (!status.ok()) std::cerr << "scan failed: " << status << "\n";
+   * @endcode
+   *
+   * @return the final status of the scan.
+   */
+  Status ForEach(std::function<bool(Row&)> const& on_row);
+
   /**
    * Gracefully terminate a streaming read.
    *
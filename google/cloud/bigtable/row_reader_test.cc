@@ -306,6 +306,92 @@ TEST_F(RowReaderTest, ReadOneOfTwoRowsClosesStream) {
   // and the previously setup expectations on the mock `stream` check that.
 }
 
+TEST_F(RowReaderTest, ForEachVisitsAllRows) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1", "r2"});
+  EXPECT_CALL(*parser, HandleEndOfStreamHook(_)).Times(1);
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _)).WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  std::vector<std::string> actual;
+  auto status = reader.ForEach([&actual](Row& row) {
+    actual.emplace_back(row.row_key());
+    return true;
+  });
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(std::vector<std::string>({"r1", "r2"}), actual);
+}
+
+TEST_F(RowReaderTest, ForEachStopsEarlyAndClosesStream) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1", "r2"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _)).WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  std::vector<std::string> actual;
+  auto status = reader.ForEach([&actual](Row& row) {
+    actual.emplace_back(row.row_key());
+    return false;
+  });
+  // Stopping early is not an error, and the stream is finalized; the
+  // previously setup expectations on the mock `stream` check that.
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(std::vector<std::string>({"r1"}), actual);
+}
+
+TEST_F(RowReaderTest, ForEachReportsPermanentFailures) {
+  // wrapped in unique_ptr by ReadRows
+  auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto parser = absl::make_unique<ReadRowsParserMock>();
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, _)).WillOnce(stream->MakeMockReturner());
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "fail")));
+
+    EXPECT_CALL(*retry_policy_, OnFailureHook(_)).WillOnce(Return(false));
+    EXPECT_CALL(*backoff_policy_, OnCompletionHook(_)).Times(0);
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::RowReader reader(
+      client_, "", bigtable::RowSet(), bigtable::RowReader::NO_ROWS_LIMIT,
+      bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+      std::move(backoff_policy_), metadata_update_policy_,
+      std::move(parser_factory_));
+
+  auto status = reader.ForEach([](Row&) { return true; });
+  EXPECT_EQ(google::cloud::StatusCode::kInternal, status.code());
+}
+
 TEST_F(RowReaderTest, FailedStreamIsRetried) {
   // wrapped in unique_ptr by ReadRows
   auto* stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
@@ -423,11 +509,17 @@ TEST_F(RowReaderTest, FailedParseIsRetried) {
   auto parser = absl::make_unique<ReadRowsParserMock>();
   parser->SetRows({"r1"});
   auto response = bigtable::testing::ReadRowsResponseFromString("chunks {}");
+  // The stream is abandoned after the parse failure, but its prefetcher may
+  // have issued one more Read() by then.
+  EXPECT_CALL(*stream, Read(_))
+      .Times(testing::AtMost(1))
+      .WillRepeatedly(Return(false));
   {
     testing::InSequence s;
     EXPECT_CALL(*client_, ReadRows(_, _)).WillOnce(stream->MakeMockReturner());
     EXPECT_CALL(*stream, Read(_))
-        .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)));
+        .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+        .RetiresOnSaturation();
     EXPECT_CALL(*parser, HandleChunkHook(_, _))
         .WillOnce(testing::SetArgReferee<1>(
             grpc::Status(grpc::StatusCode::INTERNAL, "parser exception")));
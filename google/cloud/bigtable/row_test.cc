@@ -36,6 +36,31 @@ TEST(RowTest, RowInstantiation) {
   EXPECT_EQ(std::next(two_cells_row.cells().begin())->value(), cell2.value());
 }
 
+/// @test Verify that copies share the cell storage.
+TEST(RowTest, CopiesShareCellStorage) {
+  std::string row_key = "row";
+  bigtable::Cell cell(row_key, "family", "column", 42, "value");
+  bigtable::Row row(row_key, {cell});
+
+  bigtable::Row copy = row;
+  EXPECT_EQ(row.cells().data(), copy.cells().data());
+}
+
+/// @test Verify that moving the cells out of a copy leaves others intact.
+TEST(RowTest, MoveOutDetachesSharedStorage) {
+  std::string row_key = "row";
+  bigtable::Cell cell(row_key, "family", "column", 42, "value");
+  bigtable::Row row(row_key, {cell});
+
+  bigtable::Row copy = row;
+  std::vector<bigtable::Cell> moved_cells = std::move(copy).cells();
+  EXPECT_EQ(1U, moved_cells.size());
+  ASSERT_EQ(1U, row.cells().size());
+  EXPECT_EQ("value", row.cells()[0].value());
+  // The move detached from the shared storage, the original kept its own.
+  EXPECT_NE(row.cells().data(), moved_cells.data());
+}
+
 TEST(RowTest, MoveOverload) {
   std::string row_key = "row";
   bigtable::Cell cell(row_key, "family", "column", 42, "value");
@@ -0,0 +1,115 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/sample_row_keys_cache.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+auto constexpr kDefaultTtlMinutes = 10;
+}  // anonymous namespace
+
+SampleRowKeysCache::Options::Options()
+    : ttl(std::chrono::minutes(kDefaultTtlMinutes)) {}
+
+std::shared_ptr<SampleRowKeysCache> SampleRowKeysCache::Create(
+    Table table, Options options) {
+  return std::shared_ptr<SampleRowKeysCache>(
+      new SampleRowKeysCache(std::move(table), options));
+}
+
+SampleRowKeysCache::SampleRowKeysCache(Table table, Options options)
+    : table_(std::move(table)),
+      options_(options),
+      expiration_(),
+      refresh_active_(false) {
+  // Guard against a nonsensical TTL, it would disable the cache and (worse)
+  // turn the background refresh into a busy loop.
+  if (options_.ttl <= std::chrono::milliseconds::zero()) {
+    options_.ttl = std::chrono::minutes(kDefaultTtlMinutes);
+  }
+}
+
+StatusOr<std::vector<RowKeySample>> SampleRowKeysCache::Samples() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (samples_ && Now() < expiration_) {
+      return *samples_;
+    }
+  }
+  return Refresh();
+}
+
+void SampleRowKeysCache::Invalidate() {
+  std::unique_lock<std::mutex> lk(mu_);
+  samples_.reset();
+}
+
+StatusOr<std::vector<RowKeySample>> SampleRowKeysCache::Refresh() {
+  auto samples = SampleRowsImpl(table_);
+  if (!samples) {
+    return samples;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  samples_ = *samples;
+  expiration_ = Now() + options_.ttl;
+  return samples;
+}
+
+void SampleRowKeysCache::StartBackgroundRefresh(CompletionQueue cq) {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (refresh_active_) {
+      return;
+    }
+    refresh_active_ = true;
+  }
+  ScheduleRefresh(std::move(cq));
+}
+
+void SampleRowKeysCache::StopBackgroundRefresh() {
+  std::unique_lock<std::mutex> lk(mu_);
+  refresh_active_ = false;
+}
+
+void SampleRowKeysCache::ScheduleRefresh(CompletionQueue cq) {
+  using TimerResult = StatusOr<std::chrono::system_clock::time_point>;
+  auto self = shared_from_this();
+  cq.MakeRelativeTimer(options_.ttl / 2)
+      .then([self, cq](future<TimerResult> result) mutable {
+        if (!result.get()) {
+          // The timer failed, which means the completion queue is shutting
+          // down; stop the refresh loop.
+          return;
+        }
+        {
+          std::unique_lock<std::mutex> lk(self->mu_);
+          if (!self->refresh_active_) {
+            return;
+          }
+        }
+        // Run the (synchronous) RPC outside the timer callback.
+        cq.RunAsync([self](CompletionQueue& c) {
+          self->Refresh();
+          self->ScheduleRefresh(c);
+        });
+      });
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,132 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SAMPLE_ROW_KEYS_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SAMPLE_ROW_KEYS_CACHE_H
+
+#include "google/cloud/bigtable/completion_queue.h"
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A cache of `Table::SampleRows()` results for shard planning.
+ *
+ * The row key samples change slowly, but each sharded scan that plans its
+ * shards with a fresh `Table::SampleRows()` call pays a full RPC round trip
+ * before it can start reading. Applications that issue sharded scans
+ * frequently (interactive query frontends, for example) can share one cache
+ * per table instead: `Samples()` serves the cached value while it is
+ * younger than the TTL, so planning is instant in the common case.
+ *
+ * With `StartBackgroundRefresh()` the cache also refreshes itself on a
+ * `CompletionQueue` timer at half the TTL, so steady callers never pay the
+ * round trip at all. Call `Invalidate()` when an operation fails in a way
+ * that suggests the table topology changed (e.g. `kAborted` after a tablet
+ * split) to force the next caller to fetch fresh samples.
+ *
+ * This class is thread-safe. Use `Create()` to build instances; the
+ * background refresh shares ownership of the cache, so it is safe to drop
+ * the application's reference at any time.
+ */
+class SampleRowKeysCache
+    : public std::enable_shared_from_this<SampleRowKeysCache> {
+ public:
+  /// Configuration for `SampleRowKeysCache`.
+  struct Options {
+    Options();
+
+    /// Cached samples older than this are discarded.
+    Options& SetTtl(std::chrono::milliseconds ttl_arg) {
+      ttl = ttl_arg;
+      return *this;
+    }
+
+    std::chrono::milliseconds ttl;
+  };
+
+  /// Create a cache of the row key samples of @p table.
+  static std::shared_ptr<SampleRowKeysCache> Create(
+      Table table, Options options = Options());
+
+  virtual ~SampleRowKeysCache() = default;
+
+  /**
+   * Return the row key samples, fetching them if missing or expired.
+   *
+   * Errors are returned to the caller and never cached, the next call
+   * retries the fetch.
+   */
+  StatusOr<std::vector<RowKeySample>> Samples();
+
+  /// Discard the cached samples, the next `Samples()` call fetches anew.
+  void Invalidate();
+
+  /**
+   * Periodically refresh the cache on @p cq timers.
+   *
+   * The refresh runs at half the TTL, so `Samples()` keeps hitting a fresh
+   * entry. Note that the `SampleRows()` call itself briefly occupies one of
+   * the threads running the completion queue.
+   */
+  void StartBackgroundRefresh(CompletionQueue cq);
+
+  /// Stop the periodic refresh started by `StartBackgroundRefresh()`.
+  void StopBackgroundRefresh();
+
+ protected:
+  SampleRowKeysCache(Table table, Options options);
+
+  // Wrap calling the underlying operation in a virtual function to ease
+  // testing.
+  virtual StatusOr<std::vector<RowKeySample>> SampleRowsImpl(Table& table) {
+    return table.SampleRows();
+  }
+
+  // Wrap reading the clock in a virtual function to ease testing.
+  virtual std::chrono::steady_clock::time_point Now() const {
+    return std::chrono::steady_clock::now();
+  }
+
+ private:
+  /// Fetch fresh samples and (on success) store them in the cache.
+  StatusOr<std::vector<RowKeySample>> Refresh();
+
+  /// Schedule the next background refresh timer.
+  void ScheduleRefresh(CompletionQueue cq);
+
+  std::mutex mu_;
+  Table table_;
+  Options options_;
+  absl::optional<std::vector<RowKeySample>> samples_;
+  std::chrono::steady_clock::time_point expiration_;
+  bool refresh_active_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SAMPLE_ROW_KEYS_CACHE_H
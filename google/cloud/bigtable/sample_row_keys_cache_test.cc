@@ -0,0 +1,122 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/sample_row_keys_cache.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace bigtable = ::google::cloud::bigtable;
+using ::google::cloud::Status;
+using ::google::cloud::StatusCode;
+using ::google::cloud::StatusOr;
+
+namespace {
+
+class SampleRowKeysCacheTest : public bigtable::testing::TableTestFixture {};
+
+/// A cache with a scripted `SampleRows()` and a controllable clock.
+class TestCache : public bigtable::SampleRowKeysCache {
+ public:
+  TestCache(bigtable::Table table, Options options)
+      : SampleRowKeysCache(std::move(table), options),
+        calls_(0),
+        now_(std::chrono::steady_clock::now()) {}
+
+  int calls() const { return calls_; }
+  void AdvanceClock(std::chrono::milliseconds d) { now_ += d; }
+  void SetResult(StatusOr<std::vector<bigtable::RowKeySample>> result) {
+    result_ = std::move(result);
+  }
+
+ protected:
+  StatusOr<std::vector<bigtable::RowKeySample>> SampleRowsImpl(
+      bigtable::Table&) override {
+    ++calls_;
+    return result_;
+  }
+
+  std::chrono::steady_clock::time_point Now() const override { return now_; }
+
+ private:
+  int calls_;
+  std::chrono::steady_clock::time_point now_;
+  StatusOr<std::vector<bigtable::RowKeySample>> result_;
+};
+
+std::vector<bigtable::RowKeySample> TwoSamples() {
+  std::vector<bigtable::RowKeySample> samples;
+  samples.push_back(bigtable::RowKeySample{"k1", 100});
+  samples.push_back(bigtable::RowKeySample{"k2", 200});
+  return samples;
+}
+
+}  // anonymous namespace
+
+/// @test Verify that the cache serves repeated calls without new RPCs.
+TEST_F(SampleRowKeysCacheTest, CachesWhileFresh) {
+  auto cache = std::make_shared<TestCache>(
+      table_,
+      bigtable::SampleRowKeysCache::Options().SetTtl(std::chrono::seconds(10)));
+  cache->SetResult(TwoSamples());
+
+  auto samples = cache->Samples();
+  ASSERT_STATUS_OK(samples);
+  EXPECT_EQ(2U, samples->size());
+  EXPECT_EQ(1, cache->calls());
+
+  samples = cache->Samples();
+  ASSERT_STATUS_OK(samples);
+  EXPECT_EQ(1, cache->calls());
+}
+
+/// @test Verify that entries older than the TTL are refreshed.
+TEST_F(SampleRowKeysCacheTest, ExpiresAfterTtl) {
+  auto cache = std::make_shared<TestCache>(
+      table_,
+      bigtable::SampleRowKeysCache::Options().SetTtl(std::chrono::seconds(10)));
+  cache->SetResult(TwoSamples());
+
+  ASSERT_STATUS_OK(cache->Samples());
+  cache->AdvanceClock(std::chrono::seconds(11));
+  ASSERT_STATUS_OK(cache->Samples());
+  EXPECT_EQ(2, cache->calls());
+}
+
+/// @test Verify that Invalidate() forces a new fetch.
+TEST_F(SampleRowKeysCacheTest, InvalidateForcesRefresh) {
+  auto cache = std::make_shared<TestCache>(
+      table_, bigtable::SampleRowKeysCache::Options());
+  cache->SetResult(TwoSamples());
+
+  ASSERT_STATUS_OK(cache->Samples());
+  cache->Invalidate();
+  ASSERT_STATUS_OK(cache->Samples());
+  EXPECT_EQ(2, cache->calls());
+}
+
+/// @test Verify that errors are returned but never cached.
+TEST_F(SampleRowKeysCacheTest, ErrorsAreNotCached) {
+  auto cache = std::make_shared<TestCache>(
+      table_, bigtable::SampleRowKeysCache::Options());
+  cache->SetResult(Status(StatusCode::kUnavailable, "try again"));
+
+  auto samples = cache->Samples();
+  EXPECT_EQ(StatusCode::kUnavailable, samples.status().code());
+
+  cache->SetResult(TwoSamples());
+  samples = cache->Samples();
+  ASSERT_STATUS_OK(samples);
+  EXPECT_EQ(2, cache->calls());
+}
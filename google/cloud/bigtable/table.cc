@@ -16,6 +16,7 @@
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
+#include "google/cloud/bigtable/mutation_batcher.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
 #include <thread>
@@ -66,6 +67,15 @@ static_assert(std::is_copy_assignable<bigtable::Table>::value,
               "bigtable::Table must be CopyAssignable");
 
 Status Table::Apply(SingleRowMutation mut) {
+  if (apply_batching_) {
+    // Concurrent Apply() calls coalesce into shared MutateRows batches; the
+    // per-call future reports this mutation's own status.
+    auto admission_completion =
+        apply_batching_->batcher->AsyncApply(apply_batching_->cq,
+                                             std::move(mut));
+    admission_completion.first.get();
+    return admission_completion.second.get();
+  }
   // Copy the policies in effect for this operation.  Many policy classes change
   // their state as the operation makes progress (or fails to make progress), so
   // we need fresh instances.
@@ -107,6 +117,14 @@ Status Table::Apply(SingleRowMutation mut) {
   }
 }
 
+void Table::EnableApplyBatching(std::shared_ptr<MutationBatcher> batcher,
+                                CompletionQueue cq) {
+  apply_batching_ = std::make_shared<ApplyBatchingConfig>(
+      ApplyBatchingConfig{std::move(batcher), std::move(cq)});
+}
+
+void Table::DisableApplyBatching() { apply_batching_.reset(); }
+
 future<Status> Table::AsyncApply(SingleRowMutation mut, CompletionQueue& cq) {
   google::bigtable::v2::MutateRowRequest request;
   SetCommonTableOperationRequest<google::bigtable::v2::MutateRowRequest>(
@@ -143,6 +161,21 @@ future<Status> Table::AsyncApply(SingleRowMutation mut, CompletionQueue& cq) {
 }
 
 std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
+  auto idemponent_policy = clone_idempotent_mutation_policy();
+  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
+                                          *idemponent_policy, std::move(mut));
+  return BulkApplyImpl(mutator);
+}
+
+std::vector<FailedMutation> Table::BulkApply(ArenaBulkMutation mut) {
+  auto idemponent_policy = clone_idempotent_mutation_policy();
+  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
+                                          *idemponent_policy, std::move(mut));
+  return BulkApplyImpl(mutator);
+}
+
+std::vector<FailedMutation> Table::BulkApplyImpl(
+    internal::BulkMutator& mutator) {
   grpc::Status status;
 
   // Copy the policies in effect for this operation.  Many policy classes change
@@ -150,10 +183,7 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation mut) {
   // we need fresh instances.
   auto backoff_policy = clone_rpc_backoff_policy();
   auto retry_policy = clone_rpc_retry_policy();
-  auto idemponent_policy = clone_idempotent_mutation_policy();
 
-  bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
-                                          *idemponent_policy, std::move(mut));
   while (mutator.HasPendingMutations()) {
     grpc::ClientContext client_context;
     backoff_policy->Setup(client_context);
@@ -178,6 +208,34 @@ future<std::vector<FailedMutation>> Table::AsyncBulkApply(BulkMutation mut,
       app_profile_id_, table_name(), std::move(mut));
 }
 
+future<std::vector<FailedMutation>> Table::AsyncBulkApply(
+    BulkMutation mut, std::shared_ptr<MutationByteBudget> budget,
+    CompletionQueue& cq) {
+  auto mutation_policy = clone_idempotent_mutation_policy();
+  return internal::AsyncRetryBulkApply::Create(
+      cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      *mutation_policy, clone_metadata_update_policy(), client_,
+      app_profile_id_, table_name(), std::move(mut), std::move(budget));
+}
+
+future<std::vector<FailedMutation>> Table::AsyncBulkApply(ArenaBulkMutation mut,
+                                                          CompletionQueue& cq) {
+  auto mutation_policy = clone_idempotent_mutation_policy();
+  return internal::AsyncRetryBulkApply::Create(
+      cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      *mutation_policy, clone_metadata_update_policy(), client_,
+      app_profile_id_, table_name(), std::move(mut));
+}
+
+std::vector<future<Status>> Table::AsyncBulkApplyPerMutation(
+    BulkMutation mut, CompletionQueue& cq) {
+  auto mutation_policy = clone_idempotent_mutation_policy();
+  return internal::AsyncRetryBulkApply::CreatePerMutation(
+      cq, clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
+      *mutation_policy, clone_metadata_update_policy(), client_,
+      app_profile_id_, table_name(), std::move(mut));
+}
+
 RowReader Table::ReadRows(RowSet row_set, Filter filter) {
   return RowReader(
       client_, app_profile_id_, table_name_, std::move(row_set),
@@ -15,11 +15,13 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TABLE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_TABLE_H
 
+#include "google/cloud/bigtable/arena_bulk_mutation.h"
 #include "google/cloud/bigtable/async_row_reader.h"
 #include "google/cloud/bigtable/completion_queue.h"
 #include "google/cloud/bigtable/data_client.h"
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
+#include "google/cloud/bigtable/mutation_byte_budget.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
 #include "google/cloud/bigtable/row_key_sample.h"
@@ -64,6 +66,10 @@ inline std::string TableName(std::shared_ptr<DataClient> const& client,
   return InstanceName(client) + "/tables/" + table_id;
 }
 
+namespace internal {
+class BulkMutator;
+}  // namespace internal
+
 /**
  * The main interface to interact with data in a Cloud Bigtable table.
  *
@@ -374,6 +380,36 @@ class Table {
    */
   Status Apply(SingleRowMutation mut);
 
+  /**
+   * Transparently coalesce `Apply()` calls into `MutateRows` batches.
+   *
+   * @warning This is an early version of the batching APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways.
+   *     It is not subject to any SLA or deprecation policy.
+   *
+   * Once enabled, concurrent `Apply()` calls on this object (typically from
+   * independent request handlers) are submitted through @p batcher instead
+   * of each becoming its own `MutateRow` RPC. Each call still blocks until
+   * its own mutation completes and returns that mutation's status; the
+   * batching is not observable except through throughput and latency.
+   * Configure a small `MutationBatcher::Options::flush_window` on the
+   * batcher so that lightly concurrent callers coalesce too.
+   *
+   * @note `Apply()` calls block on the completion queue, so @p cq must be
+   *     serviced by threads that do not themselves call `Apply()`.
+   *
+   * @param batcher the batcher to submit mutations through. Construct it
+   *     from a `Table` (often a copy of this one) without batching enabled.
+   * @param cq the completion queue that will execute the asynchronous
+   *    calls, the application must ensure that one or more threads are
+   *    blocked on `cq.Run()`.
+   */
+  void EnableApplyBatching(std::shared_ptr<MutationBatcher> batcher,
+                           CompletionQueue cq);
+
+  /// Restore the default behavior: each `Apply()` is its own RPC.
+  void DisableApplyBatching();
+
   /**
    * Makes asynchronous attempts to apply the mutation to a row.
    *
@@ -419,6 +455,22 @@ class Table {
    */
   std::vector<FailedMutation> BulkApply(BulkMutation mut);
 
+  /**
+   * Attempts to apply mutations to multiple rows.
+   *
+   * This overload accepts mutations built with `ArenaBulkMutation`, which
+   * allocates large batches with far fewer calls to the allocator.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership (and then discards) the data in the mutation.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent.
+   * Note that `ArenaBulkMutation::RowRef::SetCell()` without an explicit
+   * timestamp is **not** an idempotent operation.
+   */
+  std::vector<FailedMutation> BulkApply(ArenaBulkMutation mut);
+
   /**
    * Makes asynchronous attempts to apply mutations to multiple rows.
    *
@@ -446,6 +498,91 @@ class Table {
   future<std::vector<FailedMutation>> AsyncBulkApply(BulkMutation mut,
                                                      CompletionQueue& cq);
 
+  /**
+   * Makes asynchronous attempts to apply mutations to multiple rows, pacing
+   * each attempt through a shared byte budget.
+   *
+   * Every `MutateRows` attempt --- including each retry --- waits until
+   * @p budget admits its serialized size before it is sent. Share one budget
+   * between the operations (or `MutationBatcher` instances, see
+   * `MutationBatcher::Options::SetByteBudget()`) whose aggregate send rate
+   * must stay bounded.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership (and then discards) the data in the mutation.
+   * @param budget the shared budget of outstanding bytes, must not be null.
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent. Note
+   * that `google::cloud::bigtable::SetCell()` without an explicit timestamp is
+   * **not** an idempotent operation.
+   */
+  future<std::vector<FailedMutation>> AsyncBulkApply(
+      BulkMutation mut, std::shared_ptr<MutationByteBudget> budget,
+      CompletionQueue& cq);
+
+  /**
+   * Makes asynchronous attempts to apply mutations to multiple rows.
+   *
+   * This overload accepts mutations built with `ArenaBulkMutation`, which
+   * allocates large batches with far fewer calls to the allocator.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership (and then discards) the data in the mutation.
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent.
+   * Note that `ArenaBulkMutation::RowRef::SetCell()` without an explicit
+   * timestamp is **not** an idempotent operation.
+   */
+  future<std::vector<FailedMutation>> AsyncBulkApply(ArenaBulkMutation mut,
+                                                     CompletionQueue& cq);
+
+  /**
+   * Makes asynchronous attempts to apply mutations to multiple rows,
+   * reporting the outcome of each mutation individually.
+   *
+   * Returns one `future<Status>` per mutation, in the same order as the
+   * mutations in @p mut. Each future is satisfied as soon as the outcome of
+   * its mutation is known --- successes and permanent failures are reported
+   * as the `MutateRows` entry results stream back, while the batch (and any
+   * retries) are still in flight. This lets pipelines acknowledge records
+   * (e.g. advance source offsets) incrementally instead of waiting for the
+   * whole batch. Mutations whose final state is never confirmed complete
+   * when the retry loop gives up, with the status of the last attempt.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param mut the mutations, note that this function takes
+   *     ownership (and then discards) the data in the mutation.
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   *
+   * @par Idempotency
+   * This operation is idempotent if the provided mutations are idempotent. Note
+   * that `google::cloud::bigtable::SetCell()` without an explicit timestamp is
+   * **not** an idempotent operation.
+   */
+  std::vector<future<Status>> AsyncBulkApplyPerMutation(BulkMutation mut,
+                                                        CompletionQueue& cq);
+
   /**
    * Reads a set of rows from the table.
    *
@@ -651,6 +788,38 @@ class Table {
     return AsyncReadModifyWriteRowImpl(cq, std::move(request));
   }
 
+  /**
+   * Make an asynchronous request to atomically read and modify a row.
+   *
+   * This overload accepts the rules as a vector, which is convenient when
+   * the number of rules is only known at runtime.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * @param row_key the row key on which modification will be performed
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param rules the modifications to apply on the row, must not be empty.
+   * @returns A future, that becomes satisfied when the operation completes,
+   *     at that point the future has the contents of all modified cells.
+   *
+   * @par Idempotency
+   * This operation is always treated as non-idempotent.
+   */
+  future<StatusOr<Row>> AsyncReadModifyWriteRow(
+      std::string row_key, CompletionQueue& cq,
+      std::vector<bigtable::ReadModifyWriteRule> rules) {
+    ::google::bigtable::v2::ReadModifyWriteRowRequest request;
+    request.set_row_key(std::move(row_key));
+    for (auto& rule : rules) {
+      *request.add_rules() = std::move(rule).as_proto();
+    }
+    return AsyncReadModifyWriteRowImpl(cq, std::move(request));
+  }
+
   /**
    * Asynchronously reads a set of rows from the table.
    *
@@ -672,6 +841,9 @@ class Table {
    *     results are undefined
    * @param row_set the rows to read from.
    * @param filter is applied on the server-side to data in the rows.
+   * @param flow_control limits on how far the client reads ahead of the
+   *     application, see `AsyncReadRowsFlowControl`. By default the client
+   *     fetches more data only after all the received rows are delivered.
    *
    * @tparam RowFunctor the type of the @p on_row callback.
    * @tparam FinishFunctor the type of the @p on_finish callback.
@@ -680,15 +852,18 @@ class Table {
    * @snippet data_async_snippets.cc async read rows
    */
   template <typename RowFunctor, typename FinishFunctor>
-  void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
-                     FinishFunctor on_finish, RowSet row_set, Filter filter) {
+  void AsyncReadRows(
+      CompletionQueue& cq, RowFunctor on_row, FinishFunctor on_finish,
+      RowSet row_set, Filter filter,
+      AsyncReadRowsFlowControl flow_control = AsyncReadRowsFlowControl()) {
     AsyncRowReader<RowFunctor, FinishFunctor>::Create(
         cq, client_, app_profile_id_, table_name_, std::move(on_row),
         std::move(on_finish), std::move(row_set),
         AsyncRowReader<RowFunctor, FinishFunctor>::NO_ROWS_LIMIT,
         std::move(filter), clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
         metadata_update_policy_,
-        absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+        absl::make_unique<bigtable::internal::ReadRowsParserFactory>(),
+        flow_control);
   }
 
   /**
@@ -715,6 +890,9 @@ class Table {
    *     number or zero. Use `AsyncReadRows(CompletionQueue, RowSet, Filter)` to
    *     read all matching rows.
    * @param filter is applied on the server-side to data in the rows.
+   * @param flow_control limits on how far the client reads ahead of the
+   *     application, see `AsyncReadRowsFlowControl`. By default the client
+   *     fetches more data only after all the received rows are delivered.
    *
    * @tparam RowFunctor the type of the @p on_row callback.
    * @tparam FinishFunctor the type of the @p on_finish callback.
@@ -723,15 +901,17 @@ class Table {
    * @snippet data_async_snippets.cc async read rows with limit
    */
   template <typename RowFunctor, typename FinishFunctor>
-  void AsyncReadRows(CompletionQueue& cq, RowFunctor on_row,
-                     FinishFunctor on_finish, RowSet row_set,
-                     std::int64_t rows_limit, Filter filter) {
+  void AsyncReadRows(
+      CompletionQueue& cq, RowFunctor on_row, FinishFunctor on_finish,
+      RowSet row_set, std::int64_t rows_limit, Filter filter,
+      AsyncReadRowsFlowControl flow_control = AsyncReadRowsFlowControl()) {
     AsyncRowReader<RowFunctor, FinishFunctor>::Create(
         cq, client_, app_profile_id_, table_name_, std::move(on_row),
         std::move(on_finish), std::move(row_set), rows_limit, std::move(filter),
         clone_rpc_retry_policy(), clone_rpc_backoff_policy(),
         metadata_update_policy_,
-        absl::make_unique<bigtable::internal::ReadRowsParserFactory>());
+        absl::make_unique<bigtable::internal::ReadRowsParserFactory>(),
+        flow_control);
   }
 
   /**
@@ -766,6 +946,9 @@ class Table {
                                                       Filter filter);
 
  private:
+  /// Run the retry loop for `BulkApply()`, in both of its forms.
+  std::vector<FailedMutation> BulkApplyImpl(internal::BulkMutator& mutator);
+
   /**
    * Send request ReadModifyWriteRowRequest to modify the row and get it back
    */
@@ -825,6 +1008,12 @@ class Table {
   void ChangePolicies() {}
   //@}
 
+  /// The batcher and completion queue used when `Apply()` batching is on.
+  struct ApplyBatchingConfig {
+    std::shared_ptr<MutationBatcher> batcher;
+    CompletionQueue cq;
+  };
+
   friend class MutationBatcher;
   std::shared_ptr<DataClient> client_;
   std::string app_profile_id_;
@@ -834,6 +1023,7 @@ class Table {
   std::shared_ptr<RPCBackoffPolicy const> rpc_backoff_policy_prototype_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<IdempotentMutationPolicy> idempotent_mutation_policy_;
+  std::shared_ptr<ApplyBatchingConfig> apply_batching_;
 };
 
 }  // namespace BIGTABLE_CLIENT_NS
@@ -65,6 +65,38 @@ TEST_F(TableBulkApplyTest, Simple) {
   SUCCEED();
 }
 
+/// @test Verify that Table::BulkApply() accepts arena-built mutations.
+TEST_F(TableBulkApplyTest, ArenaBulkMutationSimple) {
+  auto reader = absl::make_unique<MockMutateRowsReader>(
+      "google.bigtable.v2.Bigtable.MutateRows");
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce([](btproto::MutateRowsResponse* r) {
+        {
+          auto& e = *r->add_entries();
+          e.set_index(0);
+          e.mutable_status()->set_code(grpc::StatusCode::OK);
+        }
+        {
+          auto& e = *r->add_entries();
+          e.set_index(1);
+          e.mutable_status()->set_code(grpc::StatusCode::OK);
+        }
+        return true;
+      })
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, MutateRows(_, _))
+      .WillOnce(reader.release()->MakeMockReturner());
+
+  bt::ArenaBulkMutation mut;
+  mut.AddRow("foo").SetCell("fam", "col", 0_ms, "baz");
+  mut.AddRow("bar").SetCell("fam", "col", 0_ms, "qux");
+  auto failures = table_.BulkApply(std::move(mut));
+  ASSERT_TRUE(failures.empty());
+  SUCCEED();
+}
+
 /// @test Verify that Table::BulkApply() retries partial failures.
 TEST_F(TableBulkApplyTest, RetryPartialFailure) {
   auto r1 = absl::make_unique<MockMutateRowsReader>(
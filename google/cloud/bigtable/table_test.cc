@@ -213,3 +213,32 @@ TEST_F(ValidContextMdAsyncTest, AsyncReadModifyWriteRow) {
       bigtable::ReadModifyWriteRule::IncrementAmount("fam", "counter", 1),
       bigtable::ReadModifyWriteRule::AppendValue("fam", "list", ";element")));
 }
+
+TEST_F(ValidContextMdAsyncTest, AsyncReadModifyWriteRowVectorOfRules) {
+  using ::testing::_;
+  bigtable::testing::MockAsyncFailingRpcFactory<bt::ReadModifyWriteRowRequest,
+                                                bt::ReadModifyWriteRowResponse>
+      rpc_factory;
+  EXPECT_CALL(*client_, AsyncReadModifyWriteRow(_, _, _))
+      .WillOnce(rpc_factory.Create(
+          R"""(
+              table_name: "projects/the-project/instances/the-instance/tables/the-table"
+              row_key: "row_key"
+              rules: {
+                  family_name: "fam"
+                  column_qualifier: "counter"
+                  increment_amount: 1
+              }
+              rules: {
+                  family_name: "fam"
+                  column_qualifier: "list"
+                  append_value: ";element"
+              }
+          )""",
+          "google.bigtable.v2.Bigtable.ReadModifyWriteRow"));
+  std::vector<bigtable::ReadModifyWriteRule> rules{
+      bigtable::ReadModifyWriteRule::IncrementAmount("fam", "counter", 1),
+      bigtable::ReadModifyWriteRule::AppendValue("fam", "list", ";element")};
+  FinishTest(
+      table_->AsyncReadModifyWriteRow("row_key", cq_, std::move(rules)));
+}
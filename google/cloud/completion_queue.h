@@ -17,6 +17,7 @@
 
 #include "google/cloud/future.h"
 #include "google/cloud/internal/async_read_stream_impl.h"
+#include "google/cloud/internal/async_read_write_stream_impl.h"
 #include "google/cloud/internal/completion_queue_impl.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
@@ -60,6 +61,10 @@ class CompletionQueue {
   /**
    * Create a timer that fires at @p deadline.
    *
+   * Timers expiring close together are coalesced onto a shared `grpc::Alarm`,
+   * so a timer may fire up to a millisecond after @p deadline, but it never
+   * fires early.
+   *
    * @param deadline when should the timer expire.
    *
    * @return a future that becomes satisfied after @p deadline.
@@ -174,6 +179,42 @@ class CompletionQueue {
     return stream;
   }
 
+  /**
+   * Make an asynchronous bidirectional streaming RPC.
+   *
+   * Unlike `MakeStreamingReadRpc()` this function does not drive the
+   * stream; the returned object exposes each stream operation (`Start()`,
+   * `Read()`, `Write()`, `WritesDone()`, `Finish()`) as a separate
+   * future-returning member function, and the caller sequences them.
+   *
+   * @param async_call a callable to prepare the asynchronous RPC, typically
+   *     a wrapper around one of the gRPC-generated `PrepareAsync*()`
+   *     functions. It must be invocable with
+   *     `(grpc::ClientContext*, grpc::CompletionQueue*)` and return a
+   *     `std::unique_ptr<grpc::ClientAsyncReaderWriterInterface<R, W>>`.
+   * @param context an initialized request context to make the call.
+   *
+   * @tparam AsyncCallType the type of @a async_call, its request and
+   *     response types are deduced by
+   *     `internal::AsyncReadWriteStreamTypes<>`, and this function is
+   *     excluded from overload resolution if the callable does not meet the
+   *     requirements.
+   */
+  template <typename AsyncCallType,
+            typename StreamType =
+                typename std::decay<google::cloud::internal::invoke_result_t<
+                    AsyncCallType, grpc::ClientContext*,
+                    grpc::CompletionQueue*>>::type,
+            typename Types = internal::AsyncReadWriteStreamTypes<StreamType>,
+            typename Request = typename Types::RequestType,
+            typename Response = typename Types::ResponseType>
+  std::shared_ptr<internal::AsyncReadWriteStreamImpl<Request, Response>>
+  MakeStreamingReadWriteRpc(AsyncCallType&& async_call,
+                            std::unique_ptr<grpc::ClientContext> context) {
+    return internal::AsyncReadWriteStreamImpl<Request, Response>::Create(
+        impl_, std::move(context), std::forward<AsyncCallType>(async_call));
+  }
+
   /**
    * Asynchronously run a functor on a thread `Run()`ning the `CompletionQueue`.
    *
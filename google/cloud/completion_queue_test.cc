@@ -493,6 +493,29 @@ TEST(CompletionQueueTest, ShutdownWithFastReschedulingTimer) {
   SUCCEED();
 }
 
+/// @test Verify a pool of pollers can drive many concurrent operations.
+TEST(CompletionQueueTest, ManyConcurrentTimers) {
+  auto constexpr kThreadCount = 8;
+  auto constexpr kTimerCount = 10000;
+  CompletionQueue cq;
+  std::vector<std::thread> threads(kThreadCount);
+  std::generate_n(threads.begin(), threads.size(),
+                  [&cq] { return std::thread([&cq] { cq.Run(); }); });
+
+  std::vector<TimerFuture> timers;
+  timers.reserve(kTimerCount);
+  for (int i = 0; i != kTimerCount; ++i) {
+    timers.push_back(
+        cq.MakeRelativeTimer(std::chrono::microseconds(i % 128)));
+  }
+  for (auto& t : timers) EXPECT_STATUS_OK(t.get());
+
+  cq.Shutdown();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
 TEST(CompletionQueueTest, CancelAndShutdownWithReschedulingTimer) {
   CompletionQueue cq;
   std::thread t([&cq] { cq.Run(); });
@@ -535,6 +558,85 @@ TEST(CompletionQueueTest, CancelTimerContinuation) {
   t.join();
 }
 
+/// @test Verify timers on the same deadline share one wheel slot.
+TEST(CompletionQueueTest, TimerWheelCoalesces) {
+  auto mock = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(mock);
+
+  auto const deadline =
+      std::chrono::system_clock::now() + std::chrono::hours(1);
+  std::vector<TimerFuture> timers;
+  for (int i = 0; i != 100; ++i) {
+    timers.push_back(cq.MakeDeadlineTimer(deadline));
+  }
+  // All the timers are batched into a single pending operation.
+  EXPECT_EQ(1U, mock->size());
+
+  mock->SimulateCompletion(/*ok=*/true);
+  for (auto& t : timers) {
+    auto tp = t.get();
+    ASSERT_STATUS_OK(tp);
+    EXPECT_EQ(deadline, *tp);
+  }
+  EXPECT_TRUE(mock->empty());
+}
+
+/// @test Verify cancelling one timer does not affect its batch.
+TEST(CompletionQueueTest, TimerWheelCancelOne) {
+  auto mock = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(mock);
+
+  auto const deadline =
+      std::chrono::system_clock::now() + std::chrono::hours(1);
+  auto f0 = cq.MakeDeadlineTimer(deadline);
+  auto f1 = cq.MakeDeadlineTimer(deadline);
+  EXPECT_EQ(1U, mock->size());
+
+  f0.cancel();
+  ASSERT_TRUE(f0.is_ready());
+  EXPECT_FALSE(f0.get().ok());
+  EXPECT_FALSE(f1.is_ready());
+
+  mock->SimulateCompletion(/*ok=*/true);
+  EXPECT_STATUS_OK(f1.get());
+}
+
+/// @test Verify a slot whose timers were all cancelled can be reused.
+TEST(CompletionQueueTest, TimerWheelCancelLastReusesSlot) {
+  auto mock = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(mock);
+
+  auto const deadline =
+      std::chrono::system_clock::now() + std::chrono::hours(1);
+  auto f0 = cq.MakeDeadlineTimer(deadline);
+  f0.cancel();
+  EXPECT_FALSE(f0.get().ok());
+
+  // The cancelled batch cannot accept new timers, a new batch takes over the
+  // slot.
+  auto f1 = cq.MakeDeadlineTimer(deadline);
+  mock->SimulateCompletion(/*ok=*/true);
+  EXPECT_STATUS_OK(f1.get());
+  EXPECT_TRUE(mock->empty());
+}
+
+/// @test Verify coalesced timers may fire late, but never early.
+TEST(CompletionQueueTest, TimerWheelNeverFiresEarly) {
+  CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+
+  using ms = std::chrono::milliseconds;
+  for (int i = 0; i != 50; ++i) {
+    auto const deadline = std::chrono::system_clock::now() + ms(i % 7);
+    auto tp = cq.MakeDeadlineTimer(deadline).get();
+    ASSERT_STATUS_OK(tp);
+    EXPECT_GE(std::chrono::system_clock::now(), deadline);
+  }
+
+  cq.Shutdown();
+  t.join();
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
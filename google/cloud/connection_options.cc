@@ -17,6 +17,7 @@
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
 #include <sstream>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -42,8 +43,16 @@ TracingOptions DefaultTracingOptions() {
   return TracingOptions{}.SetOptions(*tracing_options);
 }
 
-std::unique_ptr<BackgroundThreads> DefaultBackgroundThreads() {
-  return absl::make_unique<AutomaticallyCreatedBackgroundThreads>();
+std::unique_ptr<BackgroundThreads> DefaultBackgroundThreads(
+    std::size_t thread_pool_size) {
+  if (thread_pool_size == 0) {
+    // Pick a pool size automatically. `hardware_concurrency()` can return 0
+    // if the library cannot determine the number of hardware threads.
+    auto const n = std::thread::hardware_concurrency();
+    thread_pool_size = n == 0 ? 1 : n;
+  }
+  return absl::make_unique<AutomaticallyCreatedBackgroundThreads>(
+      thread_pool_size);
 }
 
 }  // namespace internal
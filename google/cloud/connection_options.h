@@ -20,7 +20,9 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/tracing_options.h"
 #include "google/cloud/version.h"
+#include "absl/types/optional.h"
 #include <grpcpp/grpcpp.h>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <set>
@@ -32,7 +34,8 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 std::set<std::string> DefaultTracingComponents();
 TracingOptions DefaultTracingOptions();
-std::unique_ptr<BackgroundThreads> DefaultBackgroundThreads();
+std::unique_ptr<BackgroundThreads> DefaultBackgroundThreads(
+    std::size_t thread_pool_size);
 }  // namespace internal
 
 /**
@@ -52,8 +55,7 @@ class ConnectionOptions {
         num_channels_(ConnectionTraits::default_num_channels()),
         tracing_components_(internal::DefaultTracingComponents()),
         tracing_options_(internal::DefaultTracingOptions()),
-        user_agent_prefix_(ConnectionTraits::user_agent_prefix()),
-        background_threads_factory_(internal::DefaultBackgroundThreads) {}
+        user_agent_prefix_(ConnectionTraits::user_agent_prefix()) {}
 
   /// Change the gRPC credentials value.
   ConnectionOptions& set_credentials(
@@ -157,6 +159,47 @@ class ConnectionOptions {
     return *this;
   }
 
+  /**
+   * The maximum size of a single inbound message, in bytes.
+   *
+   * Applications iterating over results with very large rows (or values) may
+   * need to increase this limit. The default (no value) uses the gRPC
+   * default, currently 4MiB. Set to -1 to remove the limit.
+   */
+  absl::optional<int> max_receive_message_size() const {
+    return max_receive_message_size_;
+  }
+
+  /// Set the value for `max_receive_message_size()`.
+  ConnectionOptions& set_max_receive_message_size(int v) {
+    max_receive_message_size_ = v;
+    return *this;
+  }
+
+  /**
+   * The HTTP/2 per-stream flow control window, in bytes.
+   *
+   * This bounds how much data the service can send before waiting for the
+   * client to consume it. Larger windows improve the throughput of streaming
+   * reads that return large rows, at the cost of additional client memory.
+   * Smaller windows bound the client memory, which may be preferable for
+   * latency-sensitive, interactive workloads. The default (no value) lets
+   * gRPC size the window automatically.
+   *
+   * Applications that run both workload profiles in the same binary can
+   * create two client objects configured with different values. Use
+   * `set_channel_pool_domain()` to ensure they do not share channels.
+   */
+  absl::optional<int> streaming_flow_control_window() const {
+    return streaming_flow_control_window_;
+  }
+
+  /// Set the value for `streaming_flow_control_window()`.
+  ConnectionOptions& set_streaming_flow_control_window(int v) {
+    streaming_flow_control_window_ = v;
+    return *this;
+  }
+
   /**
    * Prepend @p prefix to the user-agent string.
    *
@@ -192,6 +235,16 @@ class ConnectionOptions {
       channel_arguments.SetString("grpc.channel_pooling_domain",
                                   channel_pool_domain());
     }
+    if (max_receive_message_size_) {
+      channel_arguments.SetMaxReceiveMessageSize(*max_receive_message_size_);
+    }
+    if (streaming_flow_control_window_) {
+      // Newer versions of gRPC include a macro for this purpose
+      // (GRPC_ARG_HTTP2_STREAM_LOOKAHEAD_BYTES). As we are compiling against
+      // older versions in some cases, we use the actual value.
+      channel_arguments.SetInt("grpc.http2.lookahead_bytes",
+                               *streaming_flow_control_window_);
+    }
     channel_arguments.SetUserAgentPrefix(user_agent_prefix());
     return channel_arguments;
   }
@@ -214,10 +267,34 @@ class ConnectionOptions {
     return *this;
   }
 
+  /**
+   * Set the number of background threads.
+   *
+   * Connections perform background work on behalf of the application: timers,
+   * asynchronous completions, session keep-alives, and similar. All that work
+   * shares the pool configured here, so applications with many concurrent
+   * asynchronous operations may want a larger pool, while applications
+   * sensitive to the number of threads may want a pool of exactly one.
+   *
+   * The default value (`0`) sizes the pool automatically, currently using one
+   * thread per hardware thread reported by the `std::thread` library.
+   *
+   * @note this value is not used if `DisableBackgroundThreads()` is called.
+   */
+  ConnectionOptions& set_background_thread_pool_size(std::size_t s) {
+    background_thread_pool_size_ = s;
+    return *this;
+  }
+  std::size_t background_thread_pool_size() const {
+    return background_thread_pool_size_;
+  }
+
   using BackgroundThreadsFactory =
       std::function<std::unique_ptr<BackgroundThreads>()>;
   BackgroundThreadsFactory background_threads_factory() const {
-    return background_threads_factory_;
+    if (background_threads_factory_) return background_threads_factory_;
+    auto const s = background_thread_pool_size_;
+    return [s] { return internal::DefaultBackgroundThreads(s); };
   }
 
  private:
@@ -227,8 +304,11 @@ class ConnectionOptions {
   std::set<std::string> tracing_components_;
   TracingOptions tracing_options_;
   std::string channel_pool_domain_;
+  absl::optional<int> max_receive_message_size_;
+  absl::optional<int> streaming_flow_control_window_;
 
   std::string user_agent_prefix_;
+  std::size_t background_thread_pool_size_ = 0;
   BackgroundThreadsFactory background_threads_factory_;
 };
 
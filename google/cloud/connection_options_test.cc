@@ -108,6 +108,20 @@ TEST(ConnectionOptionsTest, ChannelPoolName) {
   EXPECT_EQ("test-channel-pool", options.channel_pool_domain());
 }
 
+TEST(ConnectionOptionsTest, MaxReceiveMessageSize) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  EXPECT_FALSE(options.max_receive_message_size().has_value());
+  options.set_max_receive_message_size(64 * 1024 * 1024);
+  EXPECT_EQ(64 * 1024 * 1024, options.max_receive_message_size().value());
+}
+
+TEST(ConnectionOptionsTest, StreamingFlowControlWindow) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  EXPECT_FALSE(options.streaming_flow_control_window().has_value());
+  options.set_streaming_flow_control_window(4 * 1024 * 1024);
+  EXPECT_EQ(4 * 1024 * 1024, options.streaming_flow_control_window().value());
+}
+
 TEST(ConnectionOptionsTest, UserAgentPrefix) {
   TestConnectionOptions options(grpc::InsecureChannelCredentials());
   EXPECT_EQ(TestTraits::user_agent_prefix(), options.user_agent_prefix());
@@ -162,6 +176,40 @@ TEST(ConnectionOptionsTest, CreateChannelArgumentsWithChannelPool) {
               StartsWith(options.user_agent_prefix()));
 }
 
+TEST(ConnectionOptionsTest, CreateChannelArgumentsWithStreamingTuning) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  options.set_max_receive_message_size(64 * 1024 * 1024);
+  options.set_streaming_flow_control_window(4 * 1024 * 1024);
+
+  auto actual = options.CreateChannelArguments();
+
+  // Use the low-level C API because grpc::ChannelArguments lacks high-level
+  // accessors.
+  grpc_channel_args test_args = actual.c_channel_args();
+  std::map<std::string, int> args;
+  for (std::size_t i = 0; i != test_args.num_args; ++i) {
+    if (test_args.args[i].type != GRPC_ARG_INTEGER) continue;
+    args[test_args.args[i].key] = test_args.args[i].value.integer;
+  }
+
+  EXPECT_EQ(64 * 1024 * 1024, args[GRPC_ARG_MAX_RECEIVE_MESSAGE_LENGTH]);
+  EXPECT_EQ(4 * 1024 * 1024, args["grpc.http2.lookahead_bytes"]);
+}
+
+TEST(ConnectionOptionsTest, BackgroundThreadPoolSize) {
+  TestConnectionOptions options(grpc::InsecureChannelCredentials());
+  // The default (0) sizes the pool automatically.
+  EXPECT_EQ(0U, options.background_thread_pool_size());
+  options.set_background_thread_pool_size(4);
+  EXPECT_EQ(4U, options.background_thread_pool_size());
+
+  auto background = options.background_threads_factory()();
+  auto* tp = dynamic_cast<internal::AutomaticallyCreatedBackgroundThreads*>(
+      background.get());
+  ASSERT_NE(nullptr, tp);
+  EXPECT_EQ(4U, tp->pool_size());
+}
+
 TEST(ConnectionOptionsTest, CustomBackgroundThreads) {
   CompletionQueue cq;
 
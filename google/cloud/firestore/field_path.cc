@@ -20,17 +20,36 @@ namespace google {
 namespace cloud {
 namespace firestore {
 
-FieldPath::FieldPath(std::vector<std::string> parts)
-    : parts_(std::move(parts)) {
-  for (auto const& part : parts_) {
+FieldPath::FieldPath(std::vector<std::string> parts) : valid_(true) {
+  std::size_t total_size = 0;
+  for (auto const& part : parts) {
     if (part.empty()) {
-      this->valid_ = false;
-      return;
+      valid_ = false;
     }
+    total_size += part.size();
   }
-  this->valid_ = true;
+  parts_.reserve(total_size);
+  offsets_.reserve(parts.size());
+  for (auto const& part : parts) {
+    parts_ += part;
+    offsets_.push_back(parts_.size());
+  }
+  if (!valid_ || offsets_.empty()) {
+    return;  // let the server catch the empty string error for invalid
+  }
+  for (auto& part : parts) {
+    AppendPartToApiRepr(api_repr_, std::move(part));
+  }
+  api_repr_.resize(api_repr_.size() - 1);  // remove final period
 }
 
+FieldPath::FieldPath(std::string parts, std::vector<std::size_t> offsets,
+                     std::string api_repr)
+    : parts_(std::move(parts)),
+      offsets_(std::move(offsets)),
+      api_repr_(std::move(api_repr)),
+      valid_(true) {}
+
 FieldPath FieldPath::InvalidFieldPath() {
   std::vector<std::string> parts = {""};
   return FieldPath(parts);
@@ -44,74 +63,75 @@ FieldPath FieldPath::FromString(std::string const& string) {
 }
 
 FieldPath FieldPath::Append(std::string const& string) const {
-  std::vector<std::string> parts(this->parts_);
-  auto const field_path = FieldPath::FromString(string);
-  return this->Append(field_path);
+  return Append(FieldPath::FromString(string));
 }
 
 FieldPath FieldPath::Append(FieldPath const& field_path) const {
   if (valid_ && field_path.valid_) {
-    std::vector<std::string> parts(this->parts_);
-    for (auto const& part : field_path.parts_) {
-      parts.push_back(part);
+    // Both paths are already parsed and escaped, so the concatenation
+    // is three buffer appends and an offset merge.
+    std::string parts = parts_ + field_path.parts_;
+    std::vector<std::size_t> offsets = offsets_;
+    offsets.reserve(offsets_.size() + field_path.offsets_.size());
+    for (auto const offset : field_path.offsets_) {
+      offsets.push_back(offset + parts_.size());
     }
-    return FieldPath(parts);
+    std::string api_repr = api_repr_;
+    if (!api_repr.empty() && !field_path.api_repr_.empty()) {
+      api_repr += '.';
+    }
+    api_repr += field_path.api_repr_;
+    return FieldPath(std::move(parts), std::move(offsets),
+                     std::move(api_repr));
   }
   return FieldPath::InvalidFieldPath();
 }
 
-std::string FieldPath::ToApiRepr() const {
+void FieldPath::AppendPartToApiRepr(std::string& api_repr, std::string part) {
   // gcc-4.8 ships with a broken regex library (sigh), so don't use it.
-  auto is_simple_field_name = [](std::string const& part) {
-    if (part.empty()) {
+  auto is_simple_field_name = [](std::string const& name) {
+    if (name.empty()) {
       return false;
     }
-    if (part[0] != '_' && std::isalpha(part[0]) == 0) {
+    if (name[0] != '_' && std::isalpha(name[0]) == 0) {
       return false;
     }
-    return std::all_of(part.begin(), part.end(),
+    return std::all_of(name.begin(), name.end(),
                        [](char c) { return c == '_' || std::isalnum(c) != 0; });
   };
-  std::string s;
-  if (valid_) {
-    for (auto part : parts_) {
-      auto const match = is_simple_field_name(part);
-      if (match) {
-        s += part + '.';
-      } else {
-        ReplaceAll(part, "\\", "\\\\");
-        ReplaceAll(part, "`", "\\`");
-        s += '`' + part + "`.";
-      }
-    }
-    s.resize(s.size() - 1);  // cannot be empty and remove final period
+  if (is_simple_field_name(part)) {
+    api_repr += part;
+    api_repr += '.';
+  } else {
+    ReplaceAll(part, "\\", "\\\\");
+    ReplaceAll(part, "`", "\\`");
+    api_repr += '`' + part + "`.";
   }
-  return s;  // let the server catch the empty string error for invalid
 }
 
 bool operator==(FieldPath const& lhs, FieldPath const& rhs) {
-  return lhs.ToApiRepr() == rhs.ToApiRepr();
+  return lhs.api_repr_ == rhs.api_repr_;
 }
 
 bool operator<(FieldPath const& lhs, FieldPath const& rhs) {
-  auto const lhs_size = lhs.parts_.size();
-  auto const rhs_size = rhs.parts_.size();
+  auto const lhs_size = lhs.offsets_.size();
+  auto const rhs_size = rhs.offsets_.size();
   auto const min_length = (std::min)(lhs_size, rhs_size);
-  for (auto i = 0U; i != min_length; i++) {
-    if (lhs.parts_[i] < rhs.parts_[i]) {
-      return true;
-    }
-    if (lhs.parts_[i] > rhs.parts_[i]) {
-      return false;
+  std::size_t lhs_begin = 0;
+  std::size_t rhs_begin = 0;
+  for (std::size_t i = 0; i != min_length; ++i) {
+    auto const lhs_end = lhs.offsets_[i];
+    auto const rhs_end = rhs.offsets_[i];
+    auto const cmp = lhs.parts_.compare(lhs_begin, lhs_end - lhs_begin,
+                                        rhs.parts_, rhs_begin,
+                                        rhs_end - rhs_begin);
+    if (cmp != 0) {
+      return cmp < 0;
     }
+    lhs_begin = lhs_end;
+    rhs_begin = rhs_end;
   }
-  if (lhs_size < rhs_size) {
-    return true;
-  }
-  if (lhs_size > rhs_size) {
-    return false;
-  }
-  return false;
+  return lhs_size < rhs_size;
 }
 
 std::ostream& operator<<(std::ostream& os, FieldPath const& field_path) {
@@ -73,15 +73,19 @@ class FieldPath {
 
   /**
    * Convert the FieldPath into a unique representation for the server.
+   *
+   * The representation is computed once, when the FieldPath is
+   * constructed, so this is a simple copy.
+   *
    * @return The unique server API representation.
    */
-  std::string ToApiRepr() const;
+  std::string ToApiRepr() const { return api_repr_; }
 
   /**
    * Return the number of components for this FieldPath.
    * @return The number of components for this FieldPath.
    */
-  std::size_t size() const { return parts_.size(); }
+  std::size_t size() const { return offsets_.size(); }
 
   /**
    * Returns whether this FieldPath is valid or not.
@@ -100,9 +104,18 @@ class FieldPath {
   friend std::ostream& operator<<(std::ostream& os,
                                   const FieldPath& field_path);
 
-  // This is a friend because it accesses parts_ directly.
+  // These are friends because they access the representation directly.
+  friend bool operator==(FieldPath const& lhs, FieldPath const& rhs);
   friend bool operator<(FieldPath const& lhs, FieldPath const& rhs);
 
+  /**
+   * Construct a FieldPath from an already built representation. Used by
+   * `Append()` to concatenate two paths without re-parsing or
+   * re-escaping them.
+   */
+  FieldPath(std::string parts, std::vector<std::size_t> offsets,
+            std::string api_repr);
+
   /**
    * Ensures @p string has no invalid characters.
    *
@@ -130,9 +143,24 @@ class FieldPath {
                          std::string const& replace);
 
   /**
-   * The components of this FieldPath.
+   * Append the server API representation of @p part and a trailing
+   * period to @p api_repr.
+   */
+  static void AppendPartToApiRepr(std::string& api_repr, std::string part);
+
+  /**
+   * The components of this FieldPath, stored back to back in a single
+   * buffer: component `i` occupies `[offsets_[i - 1], offsets_[i])` of
+   * `parts_`, with an implicit starting offset of 0. A path of any
+   * depth costs two allocations instead of one per component.
+   */
+  std::string parts_;
+  std::vector<std::size_t> offsets_;
+
+  /**
+   * The server API representation, escaped once at construction.
    */
-  std::vector<std::string> parts_;
+  std::string api_repr_;
 
   /**
    * Whether this FieldPath is valid or not.
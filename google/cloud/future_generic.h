@@ -109,6 +109,32 @@ class future final : private internal::future_base<T> {
     return then_impl(std::forward<F>(func), requires_unwrap_t{});
   }
 
+  /**
+   * Attach a continuation to the future, to be invoked by @p executor.
+   *
+   * Like `then()`, but @p func always runs in @p executor instead of inline
+   * in whatever thread satisfies the future. For futures returned by
+   * asynchronous RPCs the satisfying thread is a `CompletionQueue` polling
+   * thread, where a slow continuation stalls the completion of all other
+   * pending operations; use `then_on()` to move such continuations off that
+   * thread.
+   *
+   * `then()` remains the default (inline) policy. `then_on()` always pays one
+   * executor dispatch, even when the future is already satisfied.
+   *
+   * @tparam Executor a copyable type with a `RunAsync()` member function that
+   *   accepts `void()` functors, e.g. `CompletionQueue`, typically obtained
+   *   from `BackgroundThreads::cq()`.
+   * @param executor where to run @p func; it must outlive the continuation.
+   * @param func a Callable to be invoked when the future is ready, with the
+   *   same requirements and unwrapping rules as in `then()`.
+   *
+   * Side effects: `valid() == false` if the operation is successful.
+   */
+  template <typename Executor, typename F>
+  typename internal::then_helper<F, T>::future_t then_on(Executor executor,
+                                                         F&& func);
+
   explicit future(std::shared_ptr<shared_state_type> state)
       : internal::future_base<T>(std::move(state)) {}
 
@@ -18,6 +18,8 @@
 #include "google/cloud/testing_util/expect_future_error.h"
 #include <gmock/gmock.h>
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -188,6 +190,106 @@ TEST(FutureTestInt, CancelThroughContinuation) {
   EXPECT_EQ(84, f1.get());
 }
 
+/// A copyable executor that queues functors until `Drain()` is called.
+class FakeExecutor {
+ public:
+  FakeExecutor() : tasks_(std::make_shared<std::vector<TaskPtr>>()) {}
+
+  template <typename Functor>
+  void RunAsync(Functor&& functor) {
+    struct Wrapper : public Task {
+      explicit Wrapper(Functor&& f) : fun(std::forward<Functor>(f)) {}
+      void exec() override { fun(); }
+      typename std::decay<Functor>::type fun;
+    };
+    tasks_->push_back(TaskPtr(new Wrapper(std::forward<Functor>(functor))));
+  }
+
+  std::size_t size() const { return tasks_->size(); }
+  void Drain() {
+    std::vector<TaskPtr> tasks;
+    tasks.swap(*tasks_);
+    for (auto& t : tasks) t->exec();
+  }
+
+ private:
+  struct Task {
+    virtual ~Task() = default;
+    virtual void exec() = 0;
+  };
+  using TaskPtr = std::unique_ptr<Task>;
+  std::shared_ptr<std::vector<TaskPtr>> tasks_;
+};
+
+TEST(FutureTestInt, ThenOnRunsInExecutor) {
+  FakeExecutor executor;
+  promise<int> p;
+  future<int> fut = p.get_future();
+
+  bool called = false;
+  future<int> next = fut.then_on(executor, [&called](future<int> r) {
+    called = true;
+    return 2 * r.get();
+  });
+  EXPECT_FALSE(fut.valid());
+  EXPECT_TRUE(next.valid());
+  EXPECT_EQ(0U, executor.size());
+
+  // Satisfying the promise only schedules the continuation.
+  p.set_value(42);
+  EXPECT_FALSE(called);
+  EXPECT_EQ(1U, executor.size());
+  ASSERT_NE(std::future_status::ready, next.wait_for(0_ms));
+
+  executor.Drain();
+  EXPECT_TRUE(called);
+  ASSERT_EQ(std::future_status::ready, next.wait_for(0_ms));
+  EXPECT_EQ(84, next.get());
+}
+
+TEST(FutureTestInt, ThenOnAlreadySatisfied) {
+  FakeExecutor executor;
+  future<int> next = make_ready_future(42).then_on(
+      executor, [](future<int> r) { return 2 * r.get(); });
+
+  // Even a satisfied future pays the executor dispatch, the continuation
+  // never runs inline.
+  ASSERT_NE(std::future_status::ready, next.wait_for(0_ms));
+  EXPECT_EQ(1U, executor.size());
+  executor.Drain();
+  EXPECT_EQ(84, next.get());
+}
+
+TEST(FutureTestInt, ThenOnUnwrap) {
+  FakeExecutor executor;
+  promise<int> p;
+  promise<std::string> inner;
+
+  future<std::string> next =
+      p.get_future().then_on(executor, [&inner](future<int> r) {
+        EXPECT_EQ(42, r.get());
+        return inner.get_future();
+      });
+  p.set_value(42);
+  executor.Drain();
+  ASSERT_NE(std::future_status::ready, next.wait_for(0_ms));
+  inner.set_value("value=42");
+  EXPECT_EQ("value=42", next.get());
+}
+
+TEST(FutureTestInt, ThenOnCancelThroughContinuation) {
+  FakeExecutor executor;
+  bool cancelled = false;
+  promise<int> p0([&cancelled] { cancelled = true; });
+  auto f1 = p0.get_future().then_on(executor,
+                                    [](future<int> f) { return f.get() * 2; });
+  EXPECT_TRUE(f1.cancel());
+  EXPECT_TRUE(cancelled);
+  p0.set_value(42);
+  executor.Drain();
+  EXPECT_EQ(84, f1.get());
+}
+
 // The following tests reference the technical specification:
 //   http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2015/p0159r0.html
 // The test names match the section and paragraph from the TS.
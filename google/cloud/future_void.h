@@ -106,6 +106,20 @@ class future<void> final : private internal::future_base<void> {
     return then_impl(std::forward<F>(func), requires_unwrap_t{});
   }
 
+  /**
+   * Attach a continuation to the future, to be invoked by @p executor.
+   *
+   * Like `then()`, but @p func always runs in @p executor instead of inline
+   * in whatever thread satisfies the future. See the documentation in
+   * `future<T>::then_on()` for the motivation and the requirements on
+   * @p executor.
+   *
+   * Side effects: `valid() == false` if the operation is successful.
+   */
+  template <typename Executor, typename F>
+  typename internal::then_helper<F, void>::future_t then_on(Executor executor,
+                                                            F&& func);
+
   explicit future(std::shared_ptr<shared_state_type> state)
       : future_base<void>(std::move(state)) {}
 
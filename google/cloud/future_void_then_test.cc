@@ -18,6 +18,8 @@
 #include "google/cloud/testing_util/expect_future_error.h"
 #include <gmock/gmock.h>
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -179,6 +181,76 @@ TEST(FutureTestVoid, CancelThroughContinuation) {
   EXPECT_EQ(7, f1.get());
 }
 
+/// A copyable executor that queues functors until `Drain()` is called.
+class FakeExecutor {
+ public:
+  FakeExecutor() : tasks_(std::make_shared<std::vector<TaskPtr>>()) {}
+
+  template <typename Functor>
+  void RunAsync(Functor&& functor) {
+    struct Wrapper : public Task {
+      explicit Wrapper(Functor&& f) : fun(std::forward<Functor>(f)) {}
+      void exec() override { fun(); }
+      typename std::decay<Functor>::type fun;
+    };
+    tasks_->push_back(TaskPtr(new Wrapper(std::forward<Functor>(functor))));
+  }
+
+  std::size_t size() const { return tasks_->size(); }
+  void Drain() {
+    std::vector<TaskPtr> tasks;
+    tasks.swap(*tasks_);
+    for (auto& t : tasks) t->exec();
+  }
+
+ private:
+  struct Task {
+    virtual ~Task() = default;
+    virtual void exec() = 0;
+  };
+  using TaskPtr = std::unique_ptr<Task>;
+  std::shared_ptr<std::vector<TaskPtr>> tasks_;
+};
+
+TEST(FutureTestVoid, ThenOnRunsInExecutor) {
+  FakeExecutor executor;
+  promise<void> p;
+  future<void> fut = p.get_future();
+
+  bool called = false;
+  future<int> next = fut.then_on(executor, [&called](future<void> r) {
+    called = true;
+    r.get();
+    return 7;
+  });
+  EXPECT_FALSE(fut.valid());
+  EXPECT_TRUE(next.valid());
+  EXPECT_EQ(0U, executor.size());
+
+  // Satisfying the promise only schedules the continuation.
+  p.set_value();
+  EXPECT_FALSE(called);
+  EXPECT_EQ(1U, executor.size());
+  ASSERT_NE(std::future_status::ready, next.wait_for(0_ms));
+
+  executor.Drain();
+  EXPECT_TRUE(called);
+  ASSERT_EQ(std::future_status::ready, next.wait_for(0_ms));
+  EXPECT_EQ(7, next.get());
+}
+
+TEST(FutureTestVoid, ThenOnCancelThroughContinuation) {
+  FakeExecutor executor;
+  bool cancelled = false;
+  promise<void> p0([&cancelled] { cancelled = true; });
+  auto f1 = p0.get_future().then_on(executor, [](future<void>) { return 7; });
+  EXPECT_TRUE(f1.cancel());
+  EXPECT_TRUE(cancelled);
+  p0.set_value();
+  executor.Drain();
+  EXPECT_EQ(7, f1.get());
+}
+
 /// @test Verify conformance with section 2.3 of the Concurrency TS.
 // NOLINTNEXTLINE(google-readability-avoid-underscore-in-googletest-name)
 TEST(FutureTestVoid, conform_2_3_2_a) {
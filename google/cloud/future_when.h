@@ -0,0 +1,315 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FUTURE_WHEN_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FUTURE_WHEN_H
+/**
+ * @file
+ *
+ * Define the `when_all()` and `when_any()` combinators for `future<T>`.
+ */
+
+#include "google/cloud/internal/future_then_impl.h"
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+
+/**
+ * The result type for `when_any()`.
+ *
+ * @tparam Sequence the collection of futures passed to `when_any()`, either a
+ *     `std::vector<future<T>>` or a `std::tuple<future<Ts>...>`.
+ */
+template <typename Sequence>
+struct when_any_result {
+  /// The index of a ready future in @p futures, `size_t(-1)` if the input
+  /// sequence was empty.
+  std::size_t index;
+  /// All the input futures, the one at @p index is ready.
+  Sequence futures;
+};
+
+namespace internal {
+
+// Maps `future<T>` to `T`.
+template <typename Future>
+struct future_value_type;
+template <typename U>
+struct future_value_type<future<U>> {
+  using type = U;
+};
+
+// The state shared by the continuations attached in `when_all()`. Each
+// continuation stores its (then ready) future in the sequence and the last
+// one satisfies the promise.
+template <typename Sequence>
+struct when_all_state {
+  explicit when_all_state(std::size_t n) : pending(n) {}
+
+  void notify() {
+    if (pending.fetch_sub(1) != 1) return;
+    p.set_value(std::move(sequence));
+  }
+
+  std::atomic<std::size_t> pending;
+  Sequence sequence;
+  promise<Sequence> p;
+};
+
+// Satisfies @p p with the value (or exception) held by the ready future @p f.
+template <typename T>
+void transfer_result(promise<T>& p, future<T> f) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    p.set_value(f.get());
+  } catch (...) {
+    p.set_exception(std::current_exception());
+  }
+#else
+  p.set_value(f.get());
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+inline void transfer_result(promise<void>& p, future<void> f) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    f.get();
+    p.set_value();
+  } catch (...) {
+    p.set_exception(std::current_exception());
+  }
+#else
+  f.get();
+  p.set_value();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+// The state shared by the continuations attached in `when_any()`. The input
+// futures are consumed by `.then()`, so the sequence holds futures backed by
+// the `slots` promises instead; each continuation forwards its result to its
+// slot, and the first one also satisfies the outer promise. The sequence is
+// fully populated before any continuation is attached, so it is complete even
+// if the first input is already satisfied.
+template <typename Sequence, typename Slots>
+struct when_any_state {
+  void notify(std::size_t index) {
+    if (satisfied.test_and_set()) return;
+    p.set_value(when_any_result<Sequence>{index, std::move(sequence)});
+  }
+
+  std::atomic_flag satisfied = ATOMIC_FLAG_INIT;
+  Sequence sequence;
+  Slots slots;
+  promise<when_any_result<Sequence>> p;
+};
+
+// Attach a continuation to each future in the pack, recursing on the index.
+template <std::size_t I, typename State>
+void when_all_attach(std::shared_ptr<State> const&) {}
+
+template <std::size_t I, typename State, typename T, typename... Ts>
+void when_all_attach(std::shared_ptr<State> const& state, future<T> f,
+                     future<Ts>... rest) {
+  struct handler {
+    std::shared_ptr<State> state;
+    void operator()(future<T> g) {
+      std::get<I>(state->sequence) = std::move(g);
+      state->notify();
+    }
+  };
+  f.then(handler{state});
+  when_all_attach<I + 1>(state, std::move(rest)...);
+}
+
+// Populate the slot futures for `when_any()`, recursing on the index.
+template <std::size_t I, typename State>
+typename std::enable_if<(
+    I == std::tuple_size<decltype(State::slots)>::value)>::type
+when_any_init(State&) {}
+
+template <std::size_t I, typename State>
+typename std::enable_if<(
+    I < std::tuple_size<decltype(State::slots)>::value)>::type
+when_any_init(State& state) {
+  std::get<I>(state.sequence) = std::get<I>(state.slots).get_future();
+  when_any_init<I + 1>(state);
+}
+
+template <std::size_t I, typename State>
+void when_any_attach(std::shared_ptr<State> const&) {}
+
+template <std::size_t I, typename State, typename T, typename... Ts>
+void when_any_attach(std::shared_ptr<State> const& state, future<T> f,
+                     future<Ts>... rest) {
+  struct handler {
+    std::shared_ptr<State> state;
+    void operator()(future<T> g) {
+      transfer_result(std::get<I>(state->slots), std::move(g));
+      state->notify(I);
+    }
+  };
+  f.then(handler{state});
+  when_any_attach<I + 1>(state, std::move(rest)...);
+}
+
+}  // namespace internal
+
+/**
+ * Creates a future that becomes satisfied when all the inputs are satisfied.
+ *
+ * The returned future never holds an exception. The futures in the resulting
+ * tuple are all ready; examine each to obtain its value or exception.
+ *
+ * The input futures are consumed, as if `.then()` was called on each one.
+ */
+template <typename... Ts>
+future<std::tuple<future<Ts>...>> when_all(future<Ts>... futures) {
+  using Sequence = std::tuple<future<Ts>...>;
+  auto state = std::make_shared<internal::when_all_state<Sequence>>(
+      sizeof...(futures));
+  if (sizeof...(futures) == 0) {
+    state->p.set_value(Sequence{});
+    return state->p.get_future();
+  }
+  internal::when_all_attach<0>(state, std::move(futures)...);
+  return state->p.get_future();
+}
+
+/**
+ * Creates a future that becomes satisfied when all the futures in
+ * `[first, last)` are satisfied.
+ *
+ * The returned future never holds an exception. The futures in the resulting
+ * vector are all ready; examine each to obtain its value or exception. An
+ * empty range yields a future that is immediately satisfied with an empty
+ * vector.
+ *
+ * The input futures are consumed, as if `.then()` was called on each one.
+ *
+ * @tparam InputIt an input iterator with `future<T>` as its value type.
+ */
+template <typename InputIt,
+          typename T = typename std::iterator_traits<InputIt>::value_type>
+future<std::vector<T>> when_all(InputIt first, InputIt last) {
+  using Sequence = std::vector<T>;
+  struct handler {
+    std::shared_ptr<internal::when_all_state<Sequence>> state;
+    std::size_t index;
+    void operator()(T g) {
+      state->sequence[index] = std::move(g);
+      state->notify();
+    }
+  };
+  auto const n = static_cast<std::size_t>(std::distance(first, last));
+  auto state = std::make_shared<internal::when_all_state<Sequence>>(n);
+  if (n == 0) {
+    state->p.set_value(Sequence{});
+    return state->p.get_future();
+  }
+  state->sequence.resize(n);
+  std::size_t index = 0;
+  for (; first != last; ++first) {
+    first->then(handler{state, index++});
+  }
+  return state->p.get_future();
+}
+
+/**
+ * Creates a future that becomes satisfied when any of the inputs is
+ * satisfied.
+ *
+ * The returned future never holds an exception. Its `when_any_result` value
+ * contains all the input futures, with `index` naming one that is ready;
+ * the others become satisfied as their inputs do.
+ *
+ * The input futures are consumed, as if `.then()` was called on each one.
+ */
+template <typename... Ts>
+future<when_any_result<std::tuple<future<Ts>...>>> when_any(
+    future<Ts>... futures) {
+  using Sequence = std::tuple<future<Ts>...>;
+  using Slots = std::tuple<promise<Ts>...>;
+  auto state =
+      std::make_shared<internal::when_any_state<Sequence, Slots>>();
+  if (sizeof...(futures) == 0) {
+    state->p.set_value(when_any_result<Sequence>{
+        static_cast<std::size_t>(-1), Sequence{}});
+    return state->p.get_future();
+  }
+  internal::when_any_init<0>(*state);
+  internal::when_any_attach<0>(state, std::move(futures)...);
+  return state->p.get_future();
+}
+
+/**
+ * Creates a future that becomes satisfied when any future in `[first, last)`
+ * is satisfied.
+ *
+ * The returned future never holds an exception. Its `when_any_result` value
+ * contains all the input futures, with `index` naming one that is ready; the
+ * others become satisfied as their inputs do. An empty range yields a future
+ * immediately satisfied with an empty vector and `index == size_t(-1)`.
+ *
+ * The input futures are consumed, as if `.then()` was called on each one.
+ *
+ * @tparam InputIt an input iterator with `future<T>` as its value type.
+ */
+template <typename InputIt,
+          typename T = typename std::iterator_traits<InputIt>::value_type>
+future<when_any_result<std::vector<T>>> when_any(InputIt first, InputIt last) {
+  using Sequence = std::vector<T>;
+  using ValueType = typename internal::future_value_type<T>::type;
+  using Slots = std::vector<promise<ValueType>>;
+  struct handler {
+    std::shared_ptr<internal::when_any_state<Sequence, Slots>> state;
+    std::size_t index;
+    void operator()(T g) {
+      internal::transfer_result(state->slots[index], std::move(g));
+      state->notify(index);
+    }
+  };
+  auto const n = static_cast<std::size_t>(std::distance(first, last));
+  auto state =
+      std::make_shared<internal::when_any_state<Sequence, Slots>>();
+  if (n == 0) {
+    state->p.set_value(when_any_result<Sequence>{
+        static_cast<std::size_t>(-1), Sequence{}});
+    return state->p.get_future();
+  }
+  state->slots.resize(n);
+  state->sequence.reserve(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    state->sequence.push_back(state->slots[i].get_future());
+  }
+  std::size_t index = 0;
+  for (; first != last; ++first) {
+    first->then(handler{state, index++});
+  }
+  return state->p.get_future();
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_FUTURE_WHEN_H
@@ -0,0 +1,193 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/future.h"
+#include <gmock/gmock.h>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+TEST(WhenAll, Tuple) {
+  promise<int> pi;
+  promise<std::string> ps;
+  auto result = when_all(pi.get_future(), ps.get_future());
+  EXPECT_FALSE(result.is_ready());
+
+  // Satisfy in reverse order, the combinator must wait for both.
+  ps.set_value("42");
+  EXPECT_FALSE(result.is_ready());
+  pi.set_value(42);
+  ASSERT_TRUE(result.is_ready());
+
+  auto sequence = result.get();
+  ASSERT_TRUE(std::get<0>(sequence).is_ready());
+  ASSERT_TRUE(std::get<1>(sequence).is_ready());
+  EXPECT_EQ(42, std::get<0>(sequence).get());
+  EXPECT_EQ("42", std::get<1>(sequence).get());
+}
+
+TEST(WhenAll, TupleAlreadySatisfied) {
+  auto result = when_all(make_ready_future(7), make_ready_future());
+  ASSERT_TRUE(result.is_ready());
+  auto sequence = result.get();
+  EXPECT_EQ(7, std::get<0>(sequence).get());
+  std::get<1>(sequence).get();
+}
+
+TEST(WhenAll, TupleEmpty) {
+  auto result = when_all();
+  ASSERT_TRUE(result.is_ready());
+  result.get();
+}
+
+TEST(WhenAll, Vector) {
+  std::vector<promise<int>> promises(3);
+  std::vector<future<int>> futures;
+  futures.reserve(promises.size());
+  for (auto& p : promises) futures.push_back(p.get_future());
+
+  auto result = when_all(futures.begin(), futures.end());
+  promises[2].set_value(2);
+  promises[0].set_value(0);
+  EXPECT_FALSE(result.is_ready());
+  promises[1].set_value(1);
+  ASSERT_TRUE(result.is_ready());
+
+  auto sequence = result.get();
+  ASSERT_EQ(3U, sequence.size());
+  for (int i = 0; i != 3; ++i) {
+    ASSERT_TRUE(sequence[i].is_ready());
+    EXPECT_EQ(i, sequence[i].get());
+  }
+}
+
+TEST(WhenAll, VectorEmpty) {
+  std::vector<future<int>> futures;
+  auto result = when_all(futures.begin(), futures.end());
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_TRUE(result.get().empty());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(WhenAll, HoldsExceptions) {
+  promise<int> p0;
+  promise<int> p1;
+  auto result = when_all(p0.get_future(), p1.get_future());
+  p0.set_exception(std::make_exception_ptr(std::runtime_error("uh-oh")));
+  p1.set_value(42);
+  ASSERT_TRUE(result.is_ready());
+
+  // The combined future does not fail, the error is delivered through the
+  // corresponding element.
+  auto sequence = result.get();
+  EXPECT_THROW(
+      try { std::get<0>(sequence).get(); } catch (std::runtime_error const& e) {
+        EXPECT_STREQ("uh-oh", e.what());
+        throw;
+      },
+      std::runtime_error);
+  EXPECT_EQ(42, std::get<1>(sequence).get());
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(WhenAny, Tuple) {
+  promise<int> pi;
+  promise<std::string> ps;
+  auto result = when_any(pi.get_future(), ps.get_future());
+  EXPECT_FALSE(result.is_ready());
+
+  ps.set_value("42");
+  ASSERT_TRUE(result.is_ready());
+  auto r = result.get();
+  EXPECT_EQ(1U, r.index);
+  ASSERT_TRUE(std::get<1>(r.futures).is_ready());
+  EXPECT_EQ("42", std::get<1>(r.futures).get());
+
+  // The other future is still pending, and becomes satisfied later.
+  EXPECT_FALSE(std::get<0>(r.futures).is_ready());
+  pi.set_value(42);
+  ASSERT_TRUE(std::get<0>(r.futures).is_ready());
+  EXPECT_EQ(42, std::get<0>(r.futures).get());
+}
+
+TEST(WhenAny, TupleAlreadySatisfied) {
+  promise<std::string> ps;
+  auto result = when_any(make_ready_future(7), ps.get_future());
+  ASSERT_TRUE(result.is_ready());
+  auto r = result.get();
+  EXPECT_EQ(0U, r.index);
+  EXPECT_EQ(7, std::get<0>(r.futures).get());
+  ps.set_value("42");
+  EXPECT_EQ("42", std::get<1>(r.futures).get());
+}
+
+TEST(WhenAny, TupleEmpty) {
+  auto result = when_any();
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_EQ(static_cast<std::size_t>(-1), result.get().index);
+}
+
+TEST(WhenAny, Vector) {
+  std::vector<promise<int>> promises(3);
+  std::vector<future<int>> futures;
+  futures.reserve(promises.size());
+  for (auto& p : promises) futures.push_back(p.get_future());
+
+  auto result = when_any(futures.begin(), futures.end());
+  EXPECT_FALSE(result.is_ready());
+  promises[1].set_value(1);
+  ASSERT_TRUE(result.is_ready());
+
+  auto r = result.get();
+  EXPECT_EQ(1U, r.index);
+  ASSERT_EQ(3U, r.futures.size());
+  EXPECT_EQ(1, r.futures[1].get());
+
+  promises[0].set_value(0);
+  promises[2].set_value(2);
+  EXPECT_EQ(0, r.futures[0].get());
+  EXPECT_EQ(2, r.futures[2].get());
+}
+
+TEST(WhenAny, VectorEmpty) {
+  std::vector<future<int>> futures;
+  auto result = when_any(futures.begin(), futures.end());
+  ASSERT_TRUE(result.is_ready());
+  auto r = result.get();
+  EXPECT_EQ(static_cast<std::size_t>(-1), r.index);
+  EXPECT_TRUE(r.futures.empty());
+}
+
+TEST(WhenAny, VectorVoid) {
+  std::vector<promise<void>> promises(2);
+  std::vector<future<void>> futures;
+  futures.reserve(promises.size());
+  for (auto& p : promises) futures.push_back(p.get_future());
+
+  auto result = when_any(futures.begin(), futures.end());
+  promises[0].set_value();
+  ASSERT_TRUE(result.is_ready());
+  auto r = result.get();
+  EXPECT_EQ(0U, r.index);
+  r.futures[0].get();
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
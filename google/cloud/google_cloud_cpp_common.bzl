@@ -20,11 +20,14 @@ google_cloud_cpp_common_hdrs = [
     "future.h",
     "future_generic.h",
     "future_void.h",
+    "future_when.h",
     "iam_binding.h",
     "iam_bindings.h",
     "iam_policy.h",
+    "internal/async_log_backend.h",
     "internal/backoff_policy.h",
     "internal/big_endian.h",
+    "internal/bounded_queue.h",
     "internal/build_info.h",
     "internal/compiler_info.h",
     "internal/conjunction.h",
@@ -35,6 +38,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/filesystem.h",
     "internal/format_time_point.h",
     "internal/future_base.h",
+    "internal/future_coroutines.h",
     "internal/future_fwd.h",
     "internal/future_impl.h",
     "internal/future_then_impl.h",
@@ -42,6 +46,7 @@ google_cloud_cpp_common_hdrs = [
     "internal/getenv.h",
     "internal/invoke_result.h",
     "internal/ios_flags_saver.h",
+    "internal/metrics.h",
     "internal/parse_rfc3339.h",
     "internal/port_platform.h",
     "internal/random.h",
@@ -64,12 +69,14 @@ google_cloud_cpp_common_hdrs = [
 google_cloud_cpp_common_srcs = [
     "iam_bindings.cc",
     "iam_policy.cc",
+    "internal/async_log_backend.cc",
     "internal/backoff_policy.cc",
     "internal/compiler_info.cc",
     "internal/filesystem.cc",
     "internal/format_time_point.cc",
     "internal/future_impl.cc",
     "internal/getenv.cc",
+    "internal/metrics.cc",
     "internal/parse_rfc3339.cc",
     "internal/random.cc",
     "internal/setenv.cc",
@@ -17,4 +17,5 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 google_cloud_cpp_common_benchmarks = [
+    "internal/parse_rfc3339_benchmark.cc",
 ]
@@ -21,15 +21,20 @@ google_cloud_cpp_common_unit_tests = [
     "future_generic_then_test.cc",
     "future_void_test.cc",
     "future_void_then_test.cc",
+    "future_when_test.cc",
     "iam_bindings_test.cc",
+    "internal/async_log_backend_test.cc",
     "internal/backoff_policy_test.cc",
     "internal/big_endian_test.cc",
+    "internal/bounded_queue_test.cc",
     "internal/compiler_info_test.cc",
     "internal/env_test.cc",
     "internal/filesystem_test.cc",
     "internal/format_time_point_test.cc",
+    "internal/future_coroutines_test.cc",
     "internal/future_impl_test.cc",
     "internal/invoke_result_test.cc",
+    "internal/metrics_test.cc",
     "internal/parse_rfc3339_test.cc",
     "internal/random_test.cc",
     "internal/retry_policy_test.cc",
@@ -62,13 +62,17 @@ google::cloud::StatusCode MapStatusCode(grpc::StatusCode const& code) {
 }  // namespace
 
 google::cloud::Status MakeStatusFromRpcError(grpc::Status const& status) {
-  return MakeStatusFromRpcError(status.error_code(), status.error_message());
+  // The error details (a serialized `google.rpc.Status` proto) are carried
+  // as an opaque blob, they are not parsed or re-serialized here. Retry
+  // loops consume large numbers of transient errors without ever looking at
+  // the details, deferring that cost to the (rare) caller that wants them.
+  return google::cloud::Status(MapStatusCode(status.error_code()),
+                               status.error_message(),
+                               status.error_details());
 }
 
 google::cloud::Status MakeStatusFromRpcError(grpc::StatusCode code,
                                              std::string what) {
-  // TODO(#1912): Pass along status.error_details() once we have absl::Status
-  // or some version that supports binary blobs of data.
   return google::cloud::Status(MapStatusCode(code), std::move(what));
 }
 
@@ -55,6 +55,16 @@ TEST(MakeStatusFromRpcError, AllCodes) {
   }
 }
 
+TEST(MakeStatusFromRpcError, PreservesErrorDetails) {
+  // The error details blob is carried as-is, without parsing it.
+  auto const original = grpc::Status(grpc::StatusCode::UNAVAILABLE,
+                                     "try-again", "serialized-proto-blob");
+  auto const actual = MakeStatusFromRpcError(original);
+  EXPECT_EQ(StatusCode::kUnavailable, actual.code());
+  EXPECT_EQ("try-again", actual.message());
+  EXPECT_EQ("serialized-proto-blob", actual.error_details());
+}
+
 TEST(MakeStatusFromRpcError, ProtoValidCode) {
   using google::cloud::StatusCode;
 
@@ -0,0 +1,68 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_log_backend.h"
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+AsyncLogBackend::AsyncLogBackend(std::shared_ptr<LogBackend> backend,
+                                 std::size_t capacity)
+    : backend_(std::move(backend)), queue_(capacity) {
+  flusher_ = std::thread([this] { Flusher(); });
+}
+
+AsyncLogBackend::~AsyncLogBackend() {
+  // `Pop()` drains any buffered records after a shutdown, so this flushes
+  // everything accepted before the destructor was called.
+  queue_.Shutdown();
+  flusher_.join();
+}
+
+void AsyncLogBackend::Process(LogRecord const& log_record) {
+  ProcessWithOwnership(log_record);
+}
+
+void AsyncLogBackend::ProcessWithOwnership(LogRecord log_record) {
+  if (queue_.TryPush(log_record)) return;
+  dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncLogBackend::Flusher() {
+  for (;;) {
+    auto record = queue_.Pop();
+    if (!record) break;
+    backend_->ProcessWithOwnership(*std::move(record));
+    auto const dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped == reported_dropped_) continue;
+    LogRecord report;
+    report.severity = Severity::GCP_LS_WARNING;
+    report.function = __func__;
+    report.filename = __FILE__;
+    report.lineno = __LINE__;
+    report.timestamp = std::chrono::system_clock::now();
+    report.message = "dropped " + std::to_string(dropped - reported_dropped_) +
+                     " log records because the logging buffer was full";
+    reported_dropped_ = dropped;
+    backend_->ProcessWithOwnership(std::move(report));
+  }
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
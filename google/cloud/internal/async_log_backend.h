@@ -0,0 +1,76 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_LOG_BACKEND_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_LOG_BACKEND_H
+
+#include "google/cloud/internal/bounded_queue.h"
+#include "google/cloud/log.h"
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A `LogBackend` decorator that moves log I/O off the caller's thread.
+ *
+ * `LogSink::Log()` calls each backend from the thread that created the log
+ * record, so a backend that performs I/O (e.g. writing to `std::clog`)
+ * serializes the application threads behind that I/O. This decorator buffers
+ * the records in a bounded lock-free queue and forwards them to the wrapped
+ * backend from a dedicated flusher thread.
+ *
+ * Producers never block: when the buffer is full the record is dropped and
+ * counted. The flusher reports the number of dropped records to the wrapped
+ * backend, as a synthesized record at `WARNING` severity, as soon as the
+ * overload clears. The destructor flushes any buffered records before
+ * returning.
+ */
+class AsyncLogBackend : public LogBackend {
+ public:
+  explicit AsyncLogBackend(std::shared_ptr<LogBackend> backend)
+      : AsyncLogBackend(std::move(backend), 1024) {}
+  AsyncLogBackend(std::shared_ptr<LogBackend> backend, std::size_t capacity);
+  ~AsyncLogBackend() override;
+
+  void Process(LogRecord const& log_record) override;
+  void ProcessWithOwnership(LogRecord log_record) override;
+
+  /// The number of records discarded because the buffer was full.
+  std::int64_t dropped_count() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void Flusher();
+
+  std::shared_ptr<LogBackend> backend_;
+  BoundedQueue<LogRecord> queue_;
+  std::atomic<std::int64_t> dropped_{0};
+  std::int64_t reported_dropped_ = 0;  // only accessed by the flusher thread
+  std::thread flusher_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_LOG_BACKEND_H
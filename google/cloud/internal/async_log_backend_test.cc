@@ -0,0 +1,123 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/async_log_backend.h"
+#include <gmock/gmock.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+using ::testing::Contains;
+using ::testing::HasSubstr;
+
+/// A backend that captures messages and (optionally) blocks its caller.
+class CaptureBackend : public LogBackend {
+ public:
+  void Process(LogRecord const& lr) override { ProcessWithOwnership(lr); }
+
+  void ProcessWithOwnership(LogRecord lr) override {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return !blocked_; });
+    messages_.push_back(std::move(lr.message));
+  }
+
+  std::vector<std::string> messages() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return messages_;
+  }
+
+  void Block() {
+    std::lock_guard<std::mutex> lk(mu_);
+    blocked_ = true;
+  }
+
+  void Unblock() {
+    std::lock_guard<std::mutex> lk(mu_);
+    blocked_ = false;
+    cv_.notify_all();
+  }
+
+ private:
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  bool blocked_ = false;
+  std::vector<std::string> messages_;
+};
+
+LogRecord MakeLogRecord(std::string message) {
+  LogRecord lr;
+  lr.severity = Severity::GCP_LS_INFO;
+  lr.function = "Func";
+  lr.filename = "filename.cc";
+  lr.lineno = 123;
+  lr.timestamp = std::chrono::system_clock::now();
+  lr.message = std::move(message);
+  return lr;
+}
+
+TEST(AsyncLogBackendTest, DeliversAllRecords) {
+  auto capture = std::make_shared<CaptureBackend>();
+  {
+    AsyncLogBackend async(capture);
+    for (int i = 0; i != 100; ++i) {
+      async.ProcessWithOwnership(MakeLogRecord("message-" + std::to_string(i)));
+    }
+    EXPECT_EQ(0, async.dropped_count());
+    // The destructor flushes any buffered records.
+  }
+  auto const messages = capture->messages();
+  ASSERT_EQ(100U, messages.size());
+  EXPECT_EQ("message-0", messages.front());
+  EXPECT_EQ("message-99", messages.back());
+}
+
+TEST(AsyncLogBackendTest, ProcessAlsoEnqueues) {
+  auto capture = std::make_shared<CaptureBackend>();
+  {
+    AsyncLogBackend async(capture);
+    auto const lr = MakeLogRecord("by-const-ref");
+    async.Process(lr);
+  }
+  EXPECT_THAT(capture->messages(), Contains("by-const-ref"));
+}
+
+TEST(AsyncLogBackendTest, DropsAndReportsUnderOverload) {
+  auto capture = std::make_shared<CaptureBackend>();
+  capture->Block();
+  std::size_t const capacity = 16;
+  {
+    AsyncLogBackend async(capture, capacity);
+    // With the wrapped backend blocked at most `capacity` records fit in the
+    // buffer (plus one in flight), the rest must be dropped.
+    for (std::size_t i = 0; i != 4 * capacity; ++i) {
+      async.ProcessWithOwnership(MakeLogRecord("m-" + std::to_string(i)));
+    }
+    EXPECT_GE(async.dropped_count(), 1);
+    capture->Unblock();
+  }
+  EXPECT_THAT(capture->messages(),
+              Contains(HasSubstr("log records because the logging buffer")));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,220 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_READ_WRITE_STREAM_IMPL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_READ_WRITE_STREAM_IMPL_H
+
+#include "google/cloud/internal/completion_queue_impl.h"
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <memory>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A meta function to extract the request and response types from an
+ * asynchronous bidirectional streaming RPC callable.
+ *
+ * Asynchronous bidirectional streaming calls have the form:
+ *
+ * @code
+ *   std::unique_ptr<grpc::ClientAsyncReaderWriterInterface<Request, Response>>(
+ *      grpc::ClientContext*,
+ *      grpc::CompletionQueue*
+ *   );
+ * @endcode
+ *
+ * This is the generic version, implementing the "does not match the expected
+ * type" path.
+ */
+template <typename StreamType>
+struct AsyncReadWriteStreamTypes {};
+
+/**
+ * The specialization implementing the "matched with the expected type" path.
+ */
+template <typename Request, typename Response>
+struct AsyncReadWriteStreamTypes<std::unique_ptr<
+    grpc::ClientAsyncReaderWriterInterface<Request, Response>>> {
+  using RequestType = Request;
+  using ResponseType = Response;
+};
+
+/**
+ * Wrap a bidirectional streaming RPC into future-returning operations.
+ *
+ * Unlike `AsyncReadStreamImpl`, which drives a read loop and invokes
+ * callbacks, this class exposes each stream operation as a separate member
+ * function returning a `future<>`. The caller sequences the operations.
+ * Note that gRPC allows at most one outstanding `Read()` and at most one
+ * outstanding `Write()` or `WritesDone()` at a time, and requires all
+ * received messages to be read before calling `Finish()`.
+ *
+ * Objects of this class must be owned by a `shared_ptr<>`: each pending
+ * operation holds a reference to the object until the operation completes.
+ * This is enforced by making the constructor private and providing a factory
+ * function returning a `shared_ptr`.
+ *
+ * @tparam Request the type of the requests in the streaming RPC.
+ * @tparam Response the type of the responses in the streaming RPC.
+ */
+template <typename Request, typename Response>
+class AsyncReadWriteStreamImpl
+    : public std::enable_shared_from_this<
+          AsyncReadWriteStreamImpl<Request, Response>> {
+ public:
+  /**
+   * Create a new instance and prepare (but do not start) the RPC.
+   *
+   * @param cq the completion queue that will execute the streaming RPC. It
+   *     is the application's responsibility to keep a thread pool to execute
+   *     the completion queue loop.
+   * @param context the client context to control the streaming RPC.
+   * @param async_call the function to prepare the asynchronous streaming
+   *     RPC. This is typically a wrapper around one of the gRPC-generated
+   *     `PrepareAsync*()` functions.
+   */
+  template <typename AsyncCallType>
+  static std::shared_ptr<AsyncReadWriteStreamImpl> Create(
+      std::shared_ptr<CompletionQueueImpl> cq,
+      std::unique_ptr<grpc::ClientContext> context,
+      AsyncCallType&& async_call) {
+    auto impl = std::shared_ptr<AsyncReadWriteStreamImpl>(
+        new AsyncReadWriteStreamImpl(std::move(cq), std::move(context)));
+    impl->stream_ = async_call(impl->context_.get(), &impl->cq_->cq());
+    return impl;
+  }
+
+  /// Start the RPC; the future is satisfied with `false` if the stream
+  /// could not be started.
+  future<bool> Start() {
+    auto op = std::make_shared<BoolOp>(this->shared_from_this());
+    auto f = op->p.get_future();
+    cq_->StartOperation(std::move(op),
+                        [&](void* tag) { stream_->StartCall(tag); });
+    return f;
+  }
+
+  /// Read one response; an empty optional indicates the end of the stream.
+  future<absl::optional<Response>> Read() {
+    auto op = std::make_shared<ReadOp>(this->shared_from_this());
+    auto f = op->p.get_future();
+    auto response = &op->response;
+    cq_->StartOperation(std::move(op),
+                        [&](void* tag) { stream_->Read(response, tag); });
+    return f;
+  }
+
+  /// Write one request; `false` indicates the stream is broken.
+  future<bool> Write(Request const& request) {
+    auto op = std::make_shared<BoolOp>(this->shared_from_this());
+    auto f = op->p.get_future();
+    cq_->StartOperation(std::move(op),
+                        [&](void* tag) { stream_->Write(request, tag); });
+    return f;
+  }
+
+  /// Half-close the stream, no `Write()` calls are allowed afterwards.
+  future<bool> WritesDone() {
+    auto op = std::make_shared<BoolOp>(this->shared_from_this());
+    auto f = op->p.get_future();
+    cq_->StartOperation(std::move(op),
+                        [&](void* tag) { stream_->WritesDone(tag); });
+    return f;
+  }
+
+  /// Fetch the final status, after the read side signaled end of stream.
+  future<Status> Finish() {
+    auto op = std::make_shared<FinishOp>(this->shared_from_this());
+    auto f = op->p.get_future();
+    auto status = &op->status;
+    cq_->StartOperation(std::move(op),
+                        [&](void* tag) { stream_->Finish(status, tag); });
+    return f;
+  }
+
+  /// Best-effort request to cancel the RPC.
+  void Cancel() { context_->TryCancel(); }
+
+ private:
+  AsyncReadWriteStreamImpl(std::shared_ptr<CompletionQueueImpl> cq,
+                           std::unique_ptr<grpc::ClientContext> context)
+      : cq_(std::move(cq)), context_(std::move(context)) {}
+
+  using SharedPtr = std::shared_ptr<AsyncReadWriteStreamImpl>;
+
+  /// An adapter for the operations that only report success or failure.
+  struct BoolOp final : public AsyncGrpcOperation {
+    explicit BoolOp(SharedPtr s) : self(std::move(s)) {}
+    promise<bool> p;
+    SharedPtr self;
+
+   private:
+    void Cancel() override {}
+    bool Notify(bool ok) override {
+      p.set_value(ok);
+      return true;
+    }
+  };
+
+  /// An adapter for `Read()` operations.
+  struct ReadOp final : public AsyncGrpcOperation {
+    explicit ReadOp(SharedPtr s) : self(std::move(s)) {}
+    Response response;
+    promise<absl::optional<Response>> p;
+    SharedPtr self;
+
+   private:
+    void Cancel() override {}
+    bool Notify(bool ok) override {
+      if (!ok) {
+        p.set_value(absl::nullopt);
+        return true;
+      }
+      p.set_value(std::move(response));
+      return true;
+    }
+  };
+
+  /// An adapter for the `Finish()` operation.
+  struct FinishOp final : public AsyncGrpcOperation {
+    explicit FinishOp(SharedPtr s) : self(std::move(s)) {}
+    grpc::Status status;
+    promise<Status> p;
+    SharedPtr self;
+
+   private:
+    void Cancel() override {}
+    bool Notify(bool ok) override {
+      p.set_value(ok ? MakeStatusFromRpcError(status)
+                     : Status(StatusCode::kCancelled, "call cancelled"));
+      return true;
+    }
+  };
+
+  std::shared_ptr<CompletionQueueImpl> cq_;
+  std::unique_ptr<grpc::ClientContext> context_;
+  std::unique_ptr<grpc::ClientAsyncReaderWriterInterface<Request, Response>>
+      stream_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_ASYNC_READ_WRITE_STREAM_IMPL_H
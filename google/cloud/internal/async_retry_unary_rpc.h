@@ -20,12 +20,86 @@
 #include "google/cloud/version.h"
 #include "absl/memory/memory.h"
 #include <google/protobuf/empty.pb.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
+/**
+ * A budget limiting the rate of hedged requests.
+ *
+ * Hedged requests trade additional load on the service for lower tail
+ * latency. An unbounded hedge rate can double the load during an outage,
+ * exactly when the service can least afford it, so all hedging draws from a
+ * shared budget. The budget is a token bucket: every primary attempt earns
+ * `hedge_ratio` tokens and every hedged attempt spends one, so over time at
+ * most a `hedge_ratio` fraction of the requests are hedged.
+ *
+ * A single budget is typically shared by all the requests of a client (or
+ * even a process): pass the same `std::shared_ptr<HedgeRateBudget>` to every
+ * retry loop that should draw from it. All member functions are thread-safe.
+ */
+class HedgeRateBudget {
+ public:
+  /**
+   * @param hedge_ratio the maximum fraction of requests that may be hedged,
+   *     e.g. 0.1 allows (over time) one hedged attempt per ten requests.
+   * @param burst the maximum number of tokens the bucket accumulates, it
+   *     bounds how many hedges can be issued back to back after an idle
+   *     period.
+   */
+  explicit HedgeRateBudget(double hedge_ratio, double burst = 10.0)
+      : hedge_ratio_(hedge_ratio), burst_(burst), tokens_(burst) {}
+
+  /// Record a primary attempt, earning a fraction of a hedge token.
+  void OnAttempt() {
+    std::lock_guard<std::mutex> lk(mu_);
+    tokens_ = (std::min)(burst_, tokens_ + hedge_ratio_);
+  }
+
+  /// Returns true if a hedged attempt is admitted, consuming one token.
+  bool TryHedge() {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (tokens_ < 1.0) return false;
+    tokens_ -= 1.0;
+    return true;
+  }
+
+ private:
+  double const hedge_ratio_;
+  double const burst_;
+  std::mutex mu_;
+  double tokens_;  // GUARDED_BY(mu_)
+};
+
+/**
+ * The configuration for hedged requests in `RetryAsyncUnaryRpc`.
+ *
+ * When enabled, and only for idempotent requests, the retry loop issues a
+ * second attempt for any request still outstanding after `hedge_delay`. The
+ * first successful attempt wins and the other one is cancelled; the loop
+ * waits for all outstanding attempts to fail before treating the iteration
+ * as a failure. Set `hedge_delay` close to the tail latency (say the p95) of
+ * the RPC, so only the slowest requests are hedged.
+ */
+struct HedgingOptions {
+  /// Issue a hedged attempt after this delay, zero disables hedging.
+  std::chrono::milliseconds hedge_delay = std::chrono::milliseconds(0);
+  /// The budget shared by all the hedged requests, a null budget disables
+  /// hedging.
+  std::shared_ptr<HedgeRateBudget> budget;
+
+  bool enabled() const {
+    return hedge_delay > std::chrono::milliseconds(0) && budget != nullptr;
+  }
+};
+
 /**
  * Make an asynchronous unary RPC with retries.
  *
@@ -84,9 +158,29 @@ class RetryAsyncUnaryRpc {
       std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
       std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy, bool is_idempotent,
       AsyncCallType async_call, Request request) {
+    return Start(std::move(cq), location, std::move(rpc_retry_policy),
+                 std::move(rpc_backoff_policy), is_idempotent, HedgingOptions{},
+                 std::move(async_call), std::move(request));
+  }
+
+  /**
+   * Start the asynchronous retry loop with hedging.
+   *
+   * Same as the overload above, but if @p hedging_options is enabled (and
+   * the request is idempotent) each iteration issues a second attempt after
+   * `hedging_options.hedge_delay`, taking the first success and cancelling
+   * the other attempt. See `HedgingOptions` for details.
+   */
+  static future<StatusOr<Response>> Start(
+      CompletionQueue cq, char const* location,
+      std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy, bool is_idempotent,
+      HedgingOptions hedging_options, AsyncCallType async_call,
+      Request request) {
     std::shared_ptr<RetryAsyncUnaryRpc> self(new RetryAsyncUnaryRpc(
         location, std::move(rpc_retry_policy), std::move(rpc_backoff_policy),
-        is_idempotent, std::move(async_call), std::move(request)));
+        is_idempotent, std::move(hedging_options), std::move(async_call),
+        std::move(request)));
     auto future = self->final_result_.get_future();
     self->StartIteration(self, std::move(cq));
     return future;
@@ -99,12 +193,13 @@ class RetryAsyncUnaryRpc {
   RetryAsyncUnaryRpc(char const* location,
                      std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
                      std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
-                     bool is_idempotent, AsyncCallType async_call,
-                     Request request)
+                     bool is_idempotent, HedgingOptions hedging_options,
+                     AsyncCallType async_call, Request request)
       : location_(location),
         rpc_retry_policy_(std::move(rpc_retry_policy)),
         rpc_backoff_policy_(std::move(rpc_backoff_policy)),
         is_idempotent_(is_idempotent),
+        hedging_options_(std::move(hedging_options)),
         async_call_(std::move(async_call)),
         request_(std::move(request)) {}
 
@@ -144,6 +239,10 @@ class RetryAsyncUnaryRpc {
   /// The callback to start another iteration of the retry loop.
   static void StartIteration(std::shared_ptr<RetryAsyncUnaryRpc> self,
                              CompletionQueue cq) {
+    if (self->is_idempotent_ && self->hedging_options_.enabled()) {
+      StartHedgedIteration(self, std::move(cq));
+      return;
+    }
     auto context = absl::make_unique<grpc::ClientContext>();
 
     cq.MakeUnaryRpc(self->async_call_, self->request_, std::move(context))
@@ -152,6 +251,88 @@ class RetryAsyncUnaryRpc {
         });
   }
 
+  /// The state shared by the attempts of one hedged iteration.
+  struct HedgedIteration {
+    /// Set when the iteration has produced a result: a winning success, or
+    /// the failure of its last outstanding attempt.
+    std::atomic<bool> decided{false};
+    /// The number of attempts that have not failed yet.
+    std::atomic<int> outstanding{1};
+    std::mutex mu;
+    /// The continuations of the attempts, kept only to cancel the loser.
+    future<void> attempts[2];  // GUARDED_BY(mu)
+    future<void> hedge_timer;  // GUARDED_BY(mu)
+  };
+
+  /// Start one iteration of the retry loop with a hedged attempt.
+  static void StartHedgedIteration(std::shared_ptr<RetryAsyncUnaryRpc> self,
+                                   CompletionQueue cq) {
+    auto iteration = std::make_shared<HedgedIteration>();
+    self->hedging_options_.budget->OnAttempt();
+    auto primary = StartAttempt(self, cq, iteration, 0);
+    auto timer =
+        cq.MakeRelativeTimer(self->hedging_options_.hedge_delay)
+            .then([self, cq, iteration](
+                      future<StatusOr<std::chrono::system_clock::time_point>>
+                          result) {
+              if (!result.get()) return;  // cancelled or shutdown
+              if (iteration->decided.load()) return;
+              if (!self->hedging_options_.budget->TryHedge()) return;
+              // The primary attempt may fail while the hedge starts; the
+              // stray attempt is then handled like any other loser.
+              iteration->outstanding.fetch_add(1);
+              auto hedge = StartAttempt(self, cq, iteration, 1);
+              std::lock_guard<std::mutex> lk(iteration->mu);
+              iteration->attempts[1] = std::move(hedge);
+            });
+    std::lock_guard<std::mutex> lk(iteration->mu);
+    iteration->attempts[0] = std::move(primary);
+    iteration->hedge_timer = std::move(timer);
+  }
+
+  /// Start one attempt (primary or hedged) of a hedged iteration.
+  static future<void> StartAttempt(std::shared_ptr<RetryAsyncUnaryRpc> self,
+                                   CompletionQueue cq,
+                                   std::shared_ptr<HedgedIteration> iteration,
+                                   int index) {
+    auto context = absl::make_unique<grpc::ClientContext>();
+
+    return cq.MakeUnaryRpc(self->async_call_, self->request_,
+                           std::move(context))
+        .then([self, cq, iteration, index](future<StatusOr<Response>> fut) {
+          OnHedgedAttempt(self, cq, iteration, index, fut.get());
+        });
+  }
+
+  /// The callback for a completed attempt in a hedged iteration.
+  static void OnHedgedAttempt(std::shared_ptr<RetryAsyncUnaryRpc> self,
+                              CompletionQueue cq,
+                              std::shared_ptr<HedgedIteration> const& iteration,
+                              int index, StatusOr<Response> result) {
+    if (result) {
+      // The first success wins, a second one is ignored.
+      if (iteration->decided.exchange(true)) return;
+      future<void> timer;
+      future<void> other;
+      {
+        std::lock_guard<std::mutex> lk(iteration->mu);
+        timer = std::move(iteration->hedge_timer);
+        other = std::move(iteration->attempts[1 - index]);
+      }
+      // Cancel the pending hedge timer and the losing attempt; `cancel()`
+      // is a no-op on attempts that already completed.
+      if (timer.valid()) timer.cancel();
+      if (other.valid()) other.cancel();
+      self->final_result_.set_value(std::move(result));
+      return;
+    }
+    // Wait until all the outstanding attempts fail before declaring the
+    // iteration a failure, the other attempt may still succeed.
+    if (iteration->outstanding.fetch_sub(1) != 1) return;
+    if (iteration->decided.exchange(true)) return;
+    OnCompletion(self, std::move(cq), std::move(result));
+  }
+
   /// Generate an error message
   Status DetailedStatus(char const* context, Status const& status) {
     std::string full_message = location_;
@@ -165,6 +346,7 @@ class RetryAsyncUnaryRpc {
   std::unique_ptr<RPCRetryPolicy> rpc_retry_policy_;
   std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
   bool is_idempotent_;
+  HedgingOptions hedging_options_;
 
   AsyncCallType async_call_;
   Request request_;
@@ -221,6 +403,42 @@ StartRetryAsyncUnaryRpc(CompletionQueue cq, char const* location,
                                                  request));
 }
 
+/**
+ * Start the asynchronous retry loop with hedging.
+ *
+ * Same as `StartRetryAsyncUnaryRpc()`, but if @p hedging_options is enabled
+ * (and the request is idempotent) each iteration issues a second attempt
+ * after `hedging_options.hedge_delay`, taking the first success and
+ * cancelling the other attempt. See `HedgingOptions` for details.
+ */
+template <
+    typename RPCBackoffPolicy, typename RPCRetryPolicy, typename AsyncCallType,
+    typename RequestType,
+    typename AsyncCallT = typename std::decay<AsyncCallType>::type,
+    typename RequestT = typename std::decay<RequestType>::type,
+    typename std::enable_if<google::cloud::internal::is_invocable<
+                                AsyncCallT, grpc::ClientContext*,
+                                RequestT const&, grpc::CompletionQueue*>::value,
+                            int>::type = 0>
+future<StatusOr<typename AsyncCallResponseType<AsyncCallT, RequestT>::type>>
+// NOLINTNEXTLINE(performance-unnecessary-value-param)  TODO(#4112)
+StartRetryAsyncUnaryRpc(CompletionQueue cq, char const* location,
+                        std::unique_ptr<RPCRetryPolicy> rpc_retry_policy,
+                        std::unique_ptr<RPCBackoffPolicy> rpc_backoff_policy,
+                        bool is_idempotent, HedgingOptions hedging_options,
+                        AsyncCallType&& async_call, RequestType&& request) {
+  return RetryAsyncUnaryRpc<RPCBackoffPolicy, RPCRetryPolicy, AsyncCallT,
+                            RequestT>::Start(std::move(cq), location,
+                                             std::move(rpc_retry_policy),
+                                             std::move(rpc_backoff_policy),
+                                             is_idempotent,
+                                             std::move(hedging_options),
+                                             std::forward<AsyncCallType>(
+                                                 async_call),
+                                             std::forward<RequestType>(
+                                                 request));
+}
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -362,6 +362,199 @@ TEST(AsyncRetryUnaryRpcTest, TransientOnNonIdempotent) {
   EXPECT_THAT(result.status().message(), HasSubstr("maybe-try-again"));
 }
 
+TEST(HedgeRateBudgetTest, TokenAccounting) {
+  // Start with 2 tokens, each attempt earns half a token.
+  HedgeRateBudget budget(/*hedge_ratio=*/0.5, /*burst=*/2.0);
+  EXPECT_TRUE(budget.TryHedge());
+  EXPECT_TRUE(budget.TryHedge());
+  EXPECT_FALSE(budget.TryHedge());
+
+  budget.OnAttempt();
+  EXPECT_FALSE(budget.TryHedge());
+  budget.OnAttempt();
+  EXPECT_TRUE(budget.TryHedge());
+  EXPECT_FALSE(budget.TryHedge());
+}
+
+TEST(HedgeRateBudgetTest, BurstCapsTokens) {
+  HedgeRateBudget budget(/*hedge_ratio=*/1.0, /*burst=*/1.0);
+  for (int i = 0; i != 10; ++i) budget.OnAttempt();
+  EXPECT_TRUE(budget.TryHedge());
+  EXPECT_FALSE(budget.TryHedge());
+}
+
+TEST(AsyncRetryUnaryRpcTest, HedgingDeniedByBudget) {
+  MockStub mock;
+
+  using ReaderType = MockAsyncResponseReader<btadmin::Table>;
+  auto reader = absl::make_unique<ReaderType>();
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .WillOnce([](btadmin::Table* table, grpc::Status* status, void*) {
+        table->set_name("fake/table/name/response");
+        *status = grpc::Status::OK;
+      });
+
+  EXPECT_CALL(mock, AsyncGetTable(_, _, _))
+      .WillOnce([&reader](grpc::ClientContext*,
+                          btadmin::GetTableRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ("fake/table/name/request", request.name());
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            // This is safe, see comments in MockAsyncResponseReader.
+            btadmin::Table>>(reader.get());
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(impl);
+
+  btadmin::GetTableRequest request;
+  request.set_name("fake/table/name/request");
+
+  // An exhausted budget means the hedge timer fires but no second attempt
+  // is issued, the loop behaves exactly like the serial one.
+  HedgingOptions options;
+  options.hedge_delay = std::chrono::milliseconds(10);
+  options.budget =
+      std::make_shared<HedgeRateBudget>(/*hedge_ratio=*/0.0, /*burst=*/0.0);
+
+  auto fut = StartRetryAsyncUnaryRpc(
+      cq, __func__, RpcLimitedErrorCountRetryPolicy(3).clone(),
+      RpcExponentialBackoffPolicy(10_us, 40_us, 2.0).clone(),
+      /*is_idempotent=*/true, options,
+      [&mock](grpc::ClientContext* context,
+              btadmin::GetTableRequest const& request,
+              grpc::CompletionQueue* cq) {
+        return mock.AsyncGetTable(context, request, cq);
+      },
+      request);
+
+  // Two pending operations: the primary attempt and the hedge timer.
+  EXPECT_EQ(2, impl->size());
+  impl->SimulateCompletion(true);
+
+  EXPECT_TRUE(impl->empty());
+  ASSERT_EQ(std::future_status::ready, fut.wait_for(0_us));
+  auto result = fut.get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ("fake/table/name/response", result->name());
+}
+
+TEST(AsyncRetryUnaryRpcTest, HedgedRequestSucceeds) {
+  MockStub mock;
+
+  using ReaderType = MockAsyncResponseReader<btadmin::Table>;
+  auto finish_success = [](btadmin::Table* table, grpc::Status* status,
+                           void*) {
+    table->set_name("fake/table/name/response");
+    *status = grpc::Status::OK;
+  };
+  // Whether the hedged attempt is issued depends on the order in which the
+  // simulated completions are delivered, so the second reader may go unused.
+  auto r1 = absl::make_unique<ReaderType>();
+  EXPECT_CALL(*r1, Finish(_, _, _)).WillOnce(finish_success);
+  auto r2 = absl::make_unique<ReaderType>();
+  EXPECT_CALL(*r2, Finish(_, _, _)).Times(::testing::AtMost(1));
+  ON_CALL(*r2, Finish(_, _, _)).WillByDefault(finish_success);
+
+  int call_count = 0;
+  EXPECT_CALL(mock, AsyncGetTable(_, _, _))
+      .Times(::testing::Between(1, 2))
+      .WillRepeatedly([&](grpc::ClientContext*,
+                          btadmin::GetTableRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ("fake/table/name/request", request.name());
+        auto* reader = call_count++ == 0 ? r1.get() : r2.get();
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            // This is safe, see comments in MockAsyncResponseReader.
+            btadmin::Table>>(reader);
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(impl);
+
+  btadmin::GetTableRequest request;
+  request.set_name("fake/table/name/request");
+
+  HedgingOptions options;
+  options.hedge_delay = std::chrono::milliseconds(10);
+  options.budget =
+      std::make_shared<HedgeRateBudget>(/*hedge_ratio=*/0.1, /*burst=*/10.0);
+
+  auto fut = StartRetryAsyncUnaryRpc(
+      cq, __func__, RpcLimitedErrorCountRetryPolicy(3).clone(),
+      RpcExponentialBackoffPolicy(10_us, 40_us, 2.0).clone(),
+      /*is_idempotent=*/true, options,
+      [&mock](grpc::ClientContext* context,
+              btadmin::GetTableRequest const& request,
+              grpc::CompletionQueue* cq) {
+        return mock.AsyncGetTable(context, request, cq);
+      },
+      request);
+
+  // Two pending operations: the primary attempt and the hedge timer. The
+  // simulated completion may fire the hedge timer before the primary
+  // attempt, issuing a hedged attempt that remains pending.
+  EXPECT_EQ(2, impl->size());
+  while (!impl->empty()) impl->SimulateCompletion(true);
+
+  ASSERT_EQ(std::future_status::ready, fut.wait_for(0_us));
+  auto result = fut.get();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ("fake/table/name/response", result->name());
+}
+
+TEST(AsyncRetryUnaryRpcTest, HedgingSkippedForNonIdempotent) {
+  MockStub mock;
+
+  using ReaderType = MockAsyncResponseReader<google::protobuf::Empty>;
+  auto reader = absl::make_unique<ReaderType>();
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .WillOnce([](google::protobuf::Empty*, grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      });
+
+  EXPECT_CALL(mock, AsyncDeleteTable(_, _, _))
+      .WillOnce([&reader](grpc::ClientContext*,
+                          btadmin::DeleteTableRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ("fake/table/name/request", request.name());
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            // This is safe, see comments in MockAsyncResponseReader.
+            google::protobuf::Empty>>(reader.get());
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  CompletionQueue cq(impl);
+
+  btadmin::DeleteTableRequest request;
+  request.set_name("fake/table/name/request");
+
+  HedgingOptions options;
+  options.hedge_delay = std::chrono::milliseconds(10);
+  options.budget =
+      std::make_shared<HedgeRateBudget>(/*hedge_ratio=*/0.1, /*burst=*/10.0);
+
+  auto fut = StartRetryAsyncUnaryRpc(
+      cq, __func__, RpcLimitedErrorCountRetryPolicy(3).clone(),
+      RpcExponentialBackoffPolicy(10_us, 40_us, 2.0).clone(),
+      /*is_idempotent=*/false, options,
+      [&mock](grpc::ClientContext* context,
+              btadmin::DeleteTableRequest const& request,
+              grpc::CompletionQueue* cq) {
+        return mock.AsyncDeleteTable(context, request, cq);
+      },
+      request);
+
+  // Non-idempotent requests never hedge: only the RPC itself is pending, no
+  // hedge timer.
+  EXPECT_EQ(1, impl->size());
+  impl->SimulateCompletion(true);
+
+  EXPECT_TRUE(impl->empty());
+  ASSERT_EQ(std::future_status::ready, fut.wait_for(0_us));
+  ASSERT_STATUS_OK(fut.get());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
@@ -19,8 +19,14 @@ namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
-AutomaticallyCreatedBackgroundThreads::AutomaticallyCreatedBackgroundThreads()
-    : runner_([](CompletionQueue cq) { cq.Run(); }, cq_) {}
+AutomaticallyCreatedBackgroundThreads::AutomaticallyCreatedBackgroundThreads(
+    std::size_t thread_pool_size) {
+  if (thread_pool_size == 0) thread_pool_size = 1;
+  pool_.reserve(thread_pool_size);
+  for (std::size_t i = 0; i != thread_pool_size; ++i) {
+    pool_.emplace_back([](CompletionQueue cq) { cq.Run(); }, cq_);
+  }
+}
 
 AutomaticallyCreatedBackgroundThreads::
     ~AutomaticallyCreatedBackgroundThreads() {
@@ -29,7 +35,9 @@ AutomaticallyCreatedBackgroundThreads::
 
 void AutomaticallyCreatedBackgroundThreads::Shutdown() {
   cq_.Shutdown();
-  if (runner_.joinable()) runner_.join();
+  for (auto& runner : pool_) {
+    if (runner.joinable()) runner.join();
+  }
 }
 
 }  // namespace internal
@@ -18,7 +18,9 @@
 #include "google/cloud/background_threads.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/version.h"
+#include <cstddef>
 #include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -38,18 +40,27 @@ class CustomerSuppliedBackgroundThreads : public BackgroundThreads {
   CompletionQueue cq_;
 };
 
-/// Create a background thread to perform background operations.
+/**
+ * Create a pool of threads to perform background operations.
+ *
+ * All the threads in the pool poll the same `CompletionQueue`, so any of them
+ * can run any timer or asynchronous completion. A pool size of `0` is treated
+ * as `1`.
+ */
 class AutomaticallyCreatedBackgroundThreads : public BackgroundThreads {
  public:
-  AutomaticallyCreatedBackgroundThreads();
+  AutomaticallyCreatedBackgroundThreads()
+      : AutomaticallyCreatedBackgroundThreads(1) {}
+  explicit AutomaticallyCreatedBackgroundThreads(std::size_t thread_pool_size);
   ~AutomaticallyCreatedBackgroundThreads() override;
 
   CompletionQueue cq() const override { return cq_; }
   void Shutdown();
+  std::size_t pool_size() const { return pool_.size(); }
 
  private:
   CompletionQueue cq_;
-  std::thread runner_;
+  std::vector<std::thread> pool_;
 };
 
 }  // namespace internal
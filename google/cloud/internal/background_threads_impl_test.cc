@@ -15,6 +15,9 @@
 #include "google/cloud/internal/background_threads_impl.h"
 #include "google/cloud/testing_util/scoped_thread.h"
 #include <gmock/gmock.h>
+#include <condition_variable>
+#include <mutex>
+#include <set>
 
 namespace google {
 namespace cloud {
@@ -72,6 +75,48 @@ TEST(CustomerSuppliedBackgroundThreads, SharesCompletionQueue) {
 /// @test Verify that automatically created completion queues are usable.
 TEST(AutomaticallyCreatedBackgroundThreads, IsActive) {
   AutomaticallyCreatedBackgroundThreads actual;
+  EXPECT_EQ(1U, actual.pool_size());
+
+  promise<std::thread::id> bg;
+  actual.cq().RunAsync([&bg] { bg.set_value(std::this_thread::get_id()); });
+  EXPECT_NE(std::this_thread::get_id(), bg.get_future().get());
+}
+
+/// @test Verify that a pool of any size is usable.
+TEST(AutomaticallyCreatedBackgroundThreads, ManyThreads) {
+  auto constexpr kThreadCount = std::size_t{4};
+  AutomaticallyCreatedBackgroundThreads actual(kThreadCount);
+  EXPECT_EQ(kThreadCount, actual.pool_size());
+
+  // Block all the threads in the pool at the same time, that can only work if
+  // the pool has (at least) the configured number of threads.
+  std::mutex mu;
+  std::condition_variable cv;
+  std::size_t blocked = 0;
+  bool release = false;
+  std::set<std::thread::id> ids;
+  for (std::size_t i = 0; i != kThreadCount; ++i) {
+    actual.cq().RunAsync([&] {
+      std::unique_lock<std::mutex> lock(mu);
+      ids.insert(std::this_thread::get_id());
+      if (++blocked == kThreadCount) cv.notify_all();
+      cv.wait(lock, [&] { return release; });
+    });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mu);
+    cv.wait(lock, [&] { return blocked == kThreadCount; });
+    release = true;
+  }
+  cv.notify_all();
+  actual.Shutdown();
+  EXPECT_EQ(kThreadCount, ids.size());
+}
+
+/// @test Verify that a pool size of zero is treated as one.
+TEST(AutomaticallyCreatedBackgroundThreads, ZeroThreads) {
+  AutomaticallyCreatedBackgroundThreads actual(0);
+  EXPECT_EQ(1U, actual.pool_size());
 
   promise<std::thread::id> bg;
   actual.cq().RunAsync([&bg] { bg.set_value(std::this_thread::get_id()); });
@@ -15,10 +15,8 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BACKOFF_POLICY_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BACKOFF_POLICY_H
 
-#include "google/cloud/internal/random.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/version.h"
-#include "absl/types/optional.h"
 #include <chrono>
 #include <memory>
 
@@ -138,23 +136,16 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
     }
   }
 
-  // Do not copy the PRNG, we get two benefits:
-  //  - This works around a bug triggered by MSVC + absl::optional (we do not
-  //    know specifically which one is at fault)
-  //  - We want uncorrelated data streams for each copy anyway.
-  ExponentialBackoffPolicy(ExponentialBackoffPolicy const& rhs) noexcept
-      : current_delay_range_(rhs.current_delay_range_),
-        maximum_delay_(rhs.maximum_delay_),
-        scaling_(rhs.scaling_) {}
-
   std::unique_ptr<BackoffPolicy> clone() const override;
   std::chrono::milliseconds OnCompletion() override;
 
  private:
+  // There is no PRNG member: the jitter is drawn from a thread-local
+  // generator, so copies (and `clone()`) are trivial and each copy still gets
+  // an uncorrelated stream of delays.
   std::chrono::microseconds current_delay_range_;
   std::chrono::microseconds maximum_delay_;
   double scaling_;
-  absl::optional<DefaultPRNG> generator_;
 };
 
 }  // namespace internal
@@ -18,17 +18,64 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
-#include <array>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 
+// Whether the host stores integers with their most significant byte first.
+// All the platforms supported by these libraries are either little-endian or
+// define `__BYTE_ORDER__`.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+auto constexpr kBigEndianHost = true;
+#else
+auto constexpr kBigEndianHost = false;
+#endif
+
+// Reverses the bytes of an unsigned integer. The recursion (as opposed to a
+// loop) keeps this usable in constant expressions under C++11; for runtime
+// arguments the compilers we support reduce it to a single `bswap`.
+template <typename U,
+          typename std::enable_if<std::is_unsigned<U>::value, int>::type = 0>
+constexpr U ByteSwap(U value, std::size_t byte = 0) {
+  static_assert(std::numeric_limits<unsigned char>::digits == 8,
+                "This code assumes an 8-bit char");
+  return byte == sizeof(U)
+             ? U{0}
+             : static_cast<U>(
+                   static_cast<U>((value >> (byte * 8) & U{0xff})
+                                  << ((sizeof(U) - 1 - byte) * 8)) |
+                   ByteSwap(value, byte + 1));
+}
+
+// Converts an integer between the host byte order and big-endian. The
+// conversion is its own inverse, so this is also `FromBigEndian()`. Both are
+// usable in constant expressions, which lets key layout constants fold at
+// compile time. The result has the same value representation as the input,
+// only the object representation (the bytes in memory) changes.
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+constexpr T ToBigEndian(T value) {
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  return kBigEndianHost
+             ? value
+             : static_cast<T>(ByteSwap(static_cast<unsigned_type>(value)));
+}
+
+/// The inverse of `ToBigEndian()`, provided for readability at call sites.
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+constexpr T FromBigEndian(T value) {
+  return ToBigEndian(value);
+}
+
 // Encodes signed or unsigned integers as a big-endian sequence of bytes. The
 // returned string has a size matching `sizeof(T)`. Example:
 //
@@ -38,17 +85,10 @@ namespace internal {
 template <typename T,
           typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
 std::string EncodeBigEndian(T value) {
-  static_assert(std::numeric_limits<unsigned char>::digits == 8,
-                "This code assumes an 8-bit char");
-  using unsigned_type = typename std::make_unsigned<T>::type;
-  unsigned_type const n = *reinterpret_cast<unsigned_type*>(&value);
-  auto shift = sizeof(n) * 8;
-  std::array<std::uint8_t, sizeof(n)> a;
-  for (auto& c : a) {
-    shift -= 8;
-    c = static_cast<std::uint8_t>(n >> shift);
-  }
-  return {reinterpret_cast<char const*>(a.data()), a.size()};
+  auto const n = ToBigEndian(value);
+  std::string result(sizeof(n), '\0');
+  std::memcpy(&result[0], &n, sizeof(n));
+  return result;
 }
 
 // Decodes the given string as a big-endian sequence of bytes representing an
@@ -62,22 +102,57 @@ std::string EncodeBigEndian(T value) {
 template <typename T,
           typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
 StatusOr<T> DecodeBigEndian(std::string const& value) {
-  static_assert(std::numeric_limits<unsigned char>::digits == 8,
-                "This code assumes an 8-bit char");
   if (value.size() != sizeof(T)) {
     auto const msg = "Given value with " + std::to_string(value.size()) +
                      " bytes; expected " + std::to_string(sizeof(T));
     return Status(StatusCode::kInvalidArgument, msg);
   }
-  using unsigned_type = typename std::make_unsigned<T>::type;
-  auto shift = sizeof(T) * 8;
-  unsigned_type result = 0;
-  for (auto const& c : value) {
-    auto const n = *reinterpret_cast<std::uint8_t const*>(&c);
-    shift -= 8;
-    result |= unsigned_type{n} << shift;
+  T n;
+  std::memcpy(&n, value.data(), sizeof(n));
+  return FromBigEndian(n);
+}
+
+// Encodes a contiguous sequence of integers as their concatenated big-endian
+// representations. The returned string has `sizeof(T) * values.size()` bytes.
+// Prefer this over calling `EncodeBigEndian()` in a loop when encoding many
+// values: the single conversion loop over contiguous memory vectorizes, and
+// only one string is allocated.
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+std::string EncodeBigEndianArray(std::vector<T> const& values) {
+  std::string result(sizeof(T) * values.size(), '\0');
+  char* out = &result[0];
+  for (auto const& value : values) {
+    auto const n = ToBigEndian(value);
+    std::memcpy(out, &n, sizeof(n));
+    out += sizeof(n);
+  }
+  return result;
+}
+
+// Decodes the given string as a concatenation of big-endian representations
+// of integers of the specified type. Returns an error status if the string
+// size is not a multiple of `sizeof(T)`. This is the bulk counterpart of
+// `DecodeBigEndian()`, with the same performance rationale as
+// `EncodeBigEndianArray()`.
+template <typename T,
+          typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+StatusOr<std::vector<T>> DecodeBigEndianArray(std::string const& value) {
+  if (value.size() % sizeof(T) != 0) {
+    auto const msg = "Given value with " + std::to_string(value.size()) +
+                     " bytes; expected a multiple of " +
+                     std::to_string(sizeof(T));
+    return Status(StatusCode::kInvalidArgument, msg);
+  }
+  std::vector<T> result(value.size() / sizeof(T));
+  char const* in = value.data();
+  for (auto& item : result) {
+    T n;
+    std::memcpy(&n, in, sizeof(n));
+    item = FromBigEndian(n);
+    in += sizeof(n);
   }
-  return *reinterpret_cast<T*>(&result);
+  return result;
 }
 
 }  // namespace internal
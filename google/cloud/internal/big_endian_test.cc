@@ -173,6 +173,54 @@ TEST(RoundTripBigEndian, UInt64) {
   RunTests(test_data);
 }
 
+TEST(BigEndian, ConstexprConversion) {
+  // The conversions are usable in constant expressions, and they are their
+  // own inverse.
+  constexpr auto kRoundTrip =
+      FromBigEndian(ToBigEndian(std::int64_t{0x0102030405060708}));
+  static_assert(kRoundTrip == 0x0102030405060708,
+                "FromBigEndian() must invert ToBigEndian()");
+  constexpr auto kConverted = ToBigEndian(std::uint32_t{0x01020304});
+  static_assert(kBigEndianHost ? kConverted == 0x01020304
+                               : kConverted == 0x04030201,
+                "ToBigEndian() must reverse bytes on little-endian hosts");
+
+  // The object representation of the converted value matches the encoding.
+  auto const n = ToBigEndian(std::int32_t{255});
+  std::string s(sizeof(n), '\0');
+  std::memcpy(&s[0], &n, sizeof(n));
+  EXPECT_EQ(EncodeBigEndian(std::int32_t{255}), s);
+}
+
+TEST(BigEndian, ArrayRoundTrip) {
+  std::vector<std::int64_t> const values{-0x7FFFFFFFFFFFFFFF - 1, -256, -1, 0,
+                                         1,  255,  256,  0x7FFFFFFFFFFFFFFF};
+  auto const encoded = EncodeBigEndianArray(values);
+  EXPECT_EQ(sizeof(std::int64_t) * values.size(), encoded.size());
+
+  // Each element matches its scalar encoding.
+  for (std::size_t i = 0; i != values.size(); ++i) {
+    EXPECT_EQ(EncodeBigEndian(values[i]),
+              encoded.substr(i * sizeof(std::int64_t), sizeof(std::int64_t)));
+  }
+
+  auto const decoded = DecodeBigEndianArray<std::int64_t>(encoded);
+  ASSERT_STATUS_OK(decoded);
+  EXPECT_EQ(values, *decoded);
+}
+
+TEST(BigEndian, ArrayEmpty) {
+  EXPECT_EQ("", EncodeBigEndianArray(std::vector<std::uint32_t>{}));
+  auto const decoded = DecodeBigEndianArray<std::uint32_t>("");
+  ASSERT_STATUS_OK(decoded);
+  EXPECT_TRUE(decoded->empty());
+}
+
+TEST(BigEndian, ArrayInvalidSize) {
+  auto const decoded = DecodeBigEndianArray<std::uint32_t>("12345");
+  EXPECT_EQ(StatusCode::kInvalidArgument, decoded.status().code());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
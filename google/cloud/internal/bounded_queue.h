@@ -0,0 +1,243 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BOUNDED_QUEUE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BOUNDED_QUEUE_H
+
+#include "google/cloud/version.h"
+#include "absl/types/optional.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A bounded multi-producer multi-consumer queue.
+ *
+ * The fast paths (`TryPush()` and `TryPop()`) are lock-free: each slot in a
+ * fixed-size ring buffer carries a sequence number, producers and consumers
+ * claim slots with a single compare-and-swap and never contend on a mutex.
+ * This is the classic bounded MPMC design described by D. Vyukov.
+ *
+ * `Push()` and `Pop()` add a blocking facade: they spin briefly on the
+ * lock-free operation and only then park the thread on a condition variable.
+ * The mutex protects *only* the parking; threads that never need to wait
+ * never touch it. Producers (consumers) check an atomic waiter count before
+ * signaling, so an uncontended transfer performs no system calls.
+ *
+ * `Shutdown()` unblocks all waiters. After shutdown `Push()` drops its
+ * argument and `Pop()` drains any remaining elements before returning an
+ * empty optional.
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  BoundedQueue() : BoundedQueue(1024) {}
+  explicit BoundedQueue(std::size_t capacity)
+      : capacity_(RoundUpToPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        slots_(new Slot[capacity_]) {
+    for (std::size_t i = 0; i != capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+  }
+
+  BoundedQueue(BoundedQueue const&) = delete;
+  BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+  void Shutdown() {
+    is_shutdown_.store(true);
+    std::lock_guard<std::mutex> lk(mu_);
+    cv_read_.notify_all();
+    cv_write_.notify_all();
+  }
+
+  /// Pushes @p value if the queue is not full, without blocking.
+  bool TryPush(T& value) {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      auto const seq = slot->sequence.load(std::memory_order_acquire);
+      auto const dif = static_cast<std::ptrdiff_t>(seq) -
+                       static_cast<std::ptrdiff_t>(pos);
+      if (dif == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // full
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Pops into @p value if the queue is not empty, without blocking.
+  bool TryPop(T& value) {
+    auto pos = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      auto const seq = slot->sequence.load(std::memory_order_acquire);
+      auto const dif = static_cast<std::ptrdiff_t>(seq) -
+                       static_cast<std::ptrdiff_t>(pos + 1);
+      if (dif == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        return false;  // empty
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(slot->value);
+    slot->sequence.store(pos + capacity_, std::memory_order_release);
+    return true;
+  }
+
+  /// Blocks until @p value is enqueued or the queue shuts down.
+  void Push(T value) {
+    for (;;) {
+      for (int i = 0; i != kSpinCount; ++i) {
+        if (TryPush(value)) return NotifyReaders();
+        if (is_shutdown_.load(std::memory_order_relaxed)) return;
+      }
+      std::unique_lock<std::mutex> lk(mu_);
+      push_waiters_.fetch_add(1);
+      // The fence pairs with the one in `NotifyWriters()`: either this
+      // thread's increment is visible to a consumer that just popped (and we
+      // get a signal), or that pop is visible to the retry below.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (TryPush(value)) {
+        push_waiters_.fetch_sub(1);
+        lk.unlock();
+        return NotifyReaders();
+      }
+      if (is_shutdown_.load()) {
+        push_waiters_.fetch_sub(1);
+        return;
+      }
+      cv_write_.wait(lk);
+      push_waiters_.fetch_sub(1);
+    }
+  }
+
+  /// Blocks until an element is available; empty on shutdown after draining.
+  absl::optional<T> Pop() {
+    T value;
+    for (;;) {
+      for (int i = 0; i != kSpinCount; ++i) {
+        if (TryPop(value)) {
+          NotifyWriters();
+          return value;
+        }
+        if (is_shutdown_.load(std::memory_order_relaxed)) {
+          // Drain any element published after the last failed `TryPop()`.
+          if (!TryPop(value)) return {};
+          NotifyWriters();
+          return value;
+        }
+      }
+      std::unique_lock<std::mutex> lk(mu_);
+      pop_waiters_.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (TryPop(value)) {
+        pop_waiters_.fetch_sub(1);
+        lk.unlock();
+        NotifyWriters();
+        return value;
+      }
+      if (is_shutdown_.load()) {
+        pop_waiters_.fetch_sub(1);
+        return {};
+      }
+      cv_read_.wait(lk);
+      pop_waiters_.fetch_sub(1);
+    }
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+ private:
+  static std::size_t RoundUpToPowerOfTwo(std::size_t capacity) {
+    std::size_t result = 1;
+    while (result < capacity) result <<= 1;
+    return result;
+  }
+
+  void NotifyReaders() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pop_waiters_.load(std::memory_order_relaxed) == 0) return;
+    std::lock_guard<std::mutex> lk(mu_);
+    cv_read_.notify_one();
+  }
+
+  void NotifyWriters() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (push_waiters_.load(std::memory_order_relaxed) == 0) return;
+    std::lock_guard<std::mutex> lk(mu_);
+    cv_write_.notify_one();
+  }
+
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  // Waiting threads spin this many times before parking on the condition
+  // variable. The value only affects the latency of wakeups, not correctness.
+  static int constexpr kSpinCount = 64;
+
+  std::size_t const capacity_;
+  std::size_t const mask_;
+  std::unique_ptr<Slot[]> slots_;
+  // Pad the producer and consumer cursors to separate cache lines, they are
+  // updated by different threads on every operation.
+  char pad0_[64] = {};
+  std::atomic<std::size_t> head_;
+  char pad1_[64] = {};
+  std::atomic<std::size_t> tail_;
+  char pad2_[64] = {};
+
+  std::atomic<bool> is_shutdown_{false};
+  std::atomic<int> push_waiters_{0};
+  std::atomic<int> pop_waiters_{0};
+  std::mutex mu_;
+  std::condition_variable cv_read_;
+  std::condition_variable cv_write_;
+};
+
+template <typename T>
+int constexpr BoundedQueue<T>::kSpinCount;
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_BOUNDED_QUEUE_H
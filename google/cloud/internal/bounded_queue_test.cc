@@ -0,0 +1,140 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/bounded_queue.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+TEST(BoundedQueueTest, Basic) {
+  BoundedQueue<int> queue;
+  queue.Push(42);
+  auto value = queue.Pop();
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ(42, *value);
+}
+
+TEST(BoundedQueueTest, CapacityRoundsUpToPowerOfTwo) {
+  BoundedQueue<int> queue(100);
+  EXPECT_EQ(128, queue.capacity());
+}
+
+TEST(BoundedQueueTest, TryPushHonorsCapacity) {
+  BoundedQueue<int> queue(4);
+  for (int i = 0; i != 4; ++i) {
+    int value = i;
+    EXPECT_TRUE(queue.TryPush(value));
+  }
+  int overflow = 42;
+  EXPECT_FALSE(queue.TryPush(overflow));
+  int value = 0;
+  EXPECT_TRUE(queue.TryPop(value));
+  EXPECT_EQ(0, value);
+  EXPECT_TRUE(queue.TryPush(overflow));
+}
+
+TEST(BoundedQueueTest, TryPopEmpty) {
+  BoundedQueue<int> queue(4);
+  int value = 0;
+  EXPECT_FALSE(queue.TryPop(value));
+}
+
+TEST(BoundedQueueTest, ShutdownDrains) {
+  BoundedQueue<int> queue;
+  queue.Push(1);
+  queue.Push(2);
+  queue.Shutdown();
+  auto a = queue.Pop();
+  auto b = queue.Pop();
+  auto c = queue.Pop();
+  ASSERT_TRUE(a.has_value());
+  ASSERT_TRUE(b.has_value());
+  EXPECT_FALSE(c.has_value());
+  EXPECT_EQ(1, *a);
+  EXPECT_EQ(2, *b);
+}
+
+TEST(BoundedQueueTest, ShutdownUnblocksConsumers) {
+  BoundedQueue<int> queue;
+  std::thread consumer([&queue] {
+    auto value = queue.Pop();
+    EXPECT_FALSE(value.has_value());
+  });
+  queue.Shutdown();
+  consumer.join();
+}
+
+TEST(BoundedQueueTest, ManyProducersManyConsumers) {
+  auto constexpr kProducerCount = 4;
+  auto constexpr kConsumerCount = 4;
+  auto constexpr kElementsPerProducer = 10000;
+
+  BoundedQueue<int> queue(64);
+  std::vector<std::thread> producers;
+  for (int p = 0; p != kProducerCount; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i != kElementsPerProducer; ++i) {
+        queue.Push(p * kElementsPerProducer + i);
+      }
+    });
+  }
+
+  std::vector<std::thread> consumers;
+  std::vector<std::vector<int>> received(kConsumerCount);
+  for (int c = 0; c != kConsumerCount; ++c) {
+    consumers.emplace_back([&queue, &received, c] {
+      for (auto value = queue.Pop(); value.has_value(); value = queue.Pop()) {
+        received[c].push_back(*value);
+      }
+    });
+  }
+
+  for (auto& t : producers) t.join();
+  queue.Shutdown();
+  for (auto& t : consumers) t.join();
+
+  std::vector<int> all;
+  for (auto const& r : received) {
+    all.insert(all.end(), r.begin(), r.end());
+  }
+  ASSERT_EQ(kProducerCount * kElementsPerProducer, all.size());
+  std::sort(all.begin(), all.end());
+  std::vector<int> expected(all.size());
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(expected, all);
+}
+
+TEST(BoundedQueueTest, MoveOnlyElements) {
+  BoundedQueue<std::unique_ptr<int>> queue(4);
+  queue.Push(std::unique_ptr<int>(new int(7)));
+  auto value = queue.Pop();
+  ASSERT_TRUE(value.has_value());
+  ASSERT_TRUE(*value);
+  EXPECT_EQ(7, **value);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
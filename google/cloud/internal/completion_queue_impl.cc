@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/internal/completion_queue_impl.h"
+#include "google/cloud/internal/metrics.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
 
 // There is no wait to unblock the gRPC event loop, not even calling Shutdown(),
 // so we periodically wake up from the loop to check if the application has
@@ -25,32 +27,201 @@ namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+
+std::size_t constexpr CompletionQueueImpl::kOperationShardCount;
+std::chrono::milliseconds constexpr CompletionQueueImpl::kTimerSlotWidth;
+
+/**
+ * A slot of the timer wheel in `CompletionQueueImpl`.
+ *
+ * All the timers expiring within the same slot share this operation: a
+ * single `grpc::Alarm` and a single event on the completion queue satisfy
+ * all of them. Cancelling an individual timer removes it from the batch and
+ * satisfies its future immediately, without touching the shared alarm.
+ */
+class TimerBatch : public AsyncGrpcOperation,
+                   public std::enable_shared_from_this<TimerBatch> {
+ public:
+  /// A single timer coalesced into a batch.
+  class Timer {
+   public:
+    explicit Timer(std::chrono::system_clock::time_point deadline)
+        : deadline_(deadline),
+          promise_(/*cancellation_callback=*/[this] { Cancel(); }) {}
+
+    future<StatusOr<std::chrono::system_clock::time_point>> GetFuture() {
+      return promise_.get_future();
+    }
+
+    /// Satisfy the future. Called at most once, the batch removes the timer
+    /// from its list before expiring it.
+    void Expire(bool ok) {
+      if (!ok) {
+        promise_.set_value(Status(StatusCode::kCancelled, "timer canceled"));
+        return;
+      }
+      promise_.set_value(deadline_);
+    }
+
+   private:
+    friend class TimerBatch;
+
+    void Cancel() {
+      std::shared_ptr<TimerBatch> batch;
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        batch = batch_.lock();
+      }
+      if (batch) batch->CancelTimer(this);
+    }
+
+    std::chrono::system_clock::time_point deadline_;
+    promise<StatusOr<std::chrono::system_clock::time_point>> promise_;
+    std::mutex mu_;
+    std::weak_ptr<TimerBatch> batch_;  // GUARDED_BY(mu_)
+  };
+
+  TimerBatch(CompletionQueueImpl* cq, std::int64_t slot,
+             std::unique_ptr<grpc::Alarm> alarm)
+      : cq_(cq), slot_(slot), alarm_(std::move(alarm)) {}
+
+  /**
+   * Add @p timer to the batch.
+   *
+   * The caller must hold the timer wheel lock, so the batch cannot expire
+   * concurrently. Returns false if the batch has already been cancelled, in
+   * that case the caller must create a new batch for the slot.
+   */
+  bool Add(std::shared_ptr<Timer> const& timer) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (cancelled_) return false;
+      timers_.push_back(timer);
+    }
+    std::lock_guard<std::mutex> lk(timer->mu_);
+    timer->batch_ = shared_from_this();
+    return true;
+  }
+
+  /// Arm the shared alarm, called from `StartOperation()`.
+  void Set(grpc::CompletionQueue& cq,
+           std::chrono::system_clock::time_point deadline, void* tag) {
+    if (alarm_) {
+      alarm_->Set(&cq, deadline, tag);
+    }
+  }
+
+  void Cancel() override {
+    if (alarm_) {
+      alarm_->Cancel();
+    }
+  }
+
+ private:
+  /// Expire @p timer as cancelled, if it has not expired already.
+  void CancelTimer(Timer* timer) {
+    std::shared_ptr<Timer> found;
+    bool empty = false;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      for (auto i = timers_.begin(); i != timers_.end(); ++i) {
+        if (i->get() != timer) continue;
+        found = *i;
+        timers_.erase(i);
+        break;
+      }
+      empty = timers_.empty() && !cancelled_;
+      if (empty) cancelled_ = true;
+    }
+    if (found) found->Expire(/*ok=*/false);
+    // The last timer is gone, fire the alarm early to release the batch
+    // instead of keeping it registered until the slot deadline.
+    if (empty) Cancel();
+  }
+
+  bool Notify(bool ok) override {
+    if (ok) RecordFireLag();
+    cq_->EraseTimerWheelSlot(slot_, this);
+    std::vector<std::shared_ptr<Timer>> timers;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      cancelled_ = true;
+      timers.swap(timers_);
+    }
+    for (auto& timer : timers) timer->Expire(ok);
+    return true;
+  }
+
+  /// Report how late the shared alarm fired relative to the slot deadline.
+  void RecordFireLag() const {
+    static auto& fire_lag = MetricsRegistry::Instance().Histogram(
+        "completion_queue.timer.fire_lag_us");
+    auto const width =
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            CompletionQueueImpl::kTimerSlotWidth)
+            .count();
+    auto const slot_deadline = std::chrono::system_clock::time_point(
+        std::chrono::system_clock::duration(slot_ * width));
+    auto const lag = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - slot_deadline);
+    fire_lag.Record((std::max<std::int64_t>)(lag.count(), 0));
+  }
+
+  CompletionQueueImpl* cq_;
+  std::int64_t slot_;
+  /// Holds the underlying handle. It might be a nullptr in tests.
+  std::unique_ptr<grpc::Alarm> alarm_;
+  std::mutex mu_;
+  bool cancelled_ = false;                       // GUARDED_BY(mu_)
+  std::vector<std::shared_ptr<Timer>> timers_;  // GUARDED_BY(mu_)
+};
+
 void CompletionQueueImpl::Run() {
+  // The busy vs. wall time of all the pollers, their ratio is the poller
+  // utilization. Plain counters keep the hot loop to two clock reads and
+  // two striped increments per event.
+  auto& registry = MetricsRegistry::Instance();
+  static auto& poller_busy_us =
+      registry.Counter("completion_queue.poller.busy_us");
+  static auto& poller_wall_us =
+      registry.Counter("completion_queue.poller.wall_us");
+  auto as_us = [](std::chrono::steady_clock::duration d) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+  };
+
   void* tag;
   bool ok;
   auto deadline = [] {
     return std::chrono::system_clock::now() + kLoopTimeout;
   };
 
-  for (auto status = cq_.AsyncNext(&tag, &ok, deadline());
-       status != grpc::CompletionQueue::SHUTDOWN;
-       status = cq_.AsyncNext(&tag, &ok, deadline())) {
+  for (;;) {
+    auto const wait_start = std::chrono::steady_clock::now();
+    auto const status = cq_.AsyncNext(&tag, &ok, deadline());
+    auto const wake = std::chrono::steady_clock::now();
+    poller_wall_us.Increment(as_us(wake - wait_start));
+    if (status == grpc::CompletionQueue::SHUTDOWN) break;
     if (status == grpc::CompletionQueue::TIMEOUT) continue;
     if (status != grpc::CompletionQueue::GOT_EVENT) {
       google::cloud::internal::ThrowRuntimeError(
           "unexpected status from AsyncNext()");
     }
-    auto op = FindOperation(tag);
+    // The tag is the address of the operation itself; its `self_` reference
+    // keeps it alive until `ForgetOperation()`, so no lookup is needed.
+    auto* op = static_cast<AsyncGrpcOperation*>(tag);
     if (op->Notify(ok)) {
-      ForgetOperation(tag);
+      ForgetOperation(op);
     }
+    auto const dispatched = std::chrono::steady_clock::now();
+    poller_busy_us.Increment(as_us(dispatched - wake));
+    poller_wall_us.Increment(as_us(dispatched - wake));
   }
 }
 
 void CompletionQueueImpl::Shutdown() {
-  {
-    std::lock_guard<std::mutex> lk(mu_);
-    shutdown_ = true;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    shard.shutdown = true;
   }
   cq_.Shutdown();
 }
@@ -60,39 +231,111 @@ void CompletionQueueImpl::CancelAll() {
   // canceling them may trigger a recursive call that needs the lock. And we
   // need the lock because canceling might trigger calls that invalidate the
   // iterators.
-  auto pending = [this] {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_;
-  }();
-  for (auto& kv : pending) {
-    kv.second->Cancel();
+  for (auto& shard : shards_) {
+    std::vector<std::shared_ptr<AsyncGrpcOperation>> pending;
+    {
+      std::unique_lock<std::mutex> lk(shard.mu);
+      pending.reserve(shard.size);
+      for (auto* op = shard.head; op != nullptr; op = op->next_) {
+        pending.push_back(op->self_);
+      }
+    }
+    for (auto& op : pending) {
+      op->Cancel();
+    }
   }
 }
 
+future<StatusOr<std::chrono::system_clock::time_point>>
+CompletionQueueImpl::MakeDeadlineTimer(
+    std::chrono::system_clock::time_point deadline) {
+  auto const width =
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          kTimerSlotWidth)
+          .count();
+  auto const ticks = deadline.time_since_epoch().count();
+  // Round up to the next slot boundary, a timer may fire a little late, but
+  // it must never fire early.
+  auto const slot = (ticks + width - 1) / width;
+  auto const slot_deadline = std::chrono::system_clock::time_point(
+      std::chrono::system_clock::duration(slot * width));
+
+  auto timer = std::make_shared<TimerBatch::Timer>(deadline);
+  std::shared_ptr<TimerBatch> batch;
+  {
+    std::lock_guard<std::mutex> lk(timer_mu_);
+    auto& entry = timer_wheel_[slot];
+    // `Add()` fails if the batch was cancelled after its last timer was
+    // removed; such a batch is simply replaced by a new one.
+    if (entry && entry->Add(timer)) return timer->GetFuture();
+    batch = std::make_shared<TimerBatch>(this, slot, CreateAlarm());
+    batch->Add(timer);
+    entry = batch;
+  }
+  // Register and arm the shared alarm outside the wheel lock, `Notify()` may
+  // run inline if the queue has shut down, and it needs to acquire the lock.
+  StartOperation(batch,
+                 [&](void* tag) { batch->Set(cq_, slot_deadline, tag); });
+  return timer->GetFuture();
+}
+
 std::unique_ptr<grpc::Alarm> CompletionQueueImpl::CreateAlarm() const {
   return absl::make_unique<grpc::Alarm>();
 }
 
-std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::FindOperation(
+void CompletionQueueImpl::EraseTimerWheelSlot(std::int64_t slot,
+                                              TimerBatch const* batch) {
+  std::lock_guard<std::mutex> lk(timer_mu_);
+  auto loc = timer_wheel_.find(slot);
+  if (loc != timer_wheel_.end() && loc->second.get() == batch) {
+    timer_wheel_.erase(loc);
+  }
+}
+
+std::shared_ptr<AsyncGrpcOperation> CompletionQueueImpl::HoldOperation(
     void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto loc = pending_ops_.find(reinterpret_cast<std::intptr_t>(tag));
-  if (pending_ops_.end() == loc) {
+  auto* op = static_cast<AsyncGrpcOperation*>(tag);
+  auto& shard = GetShard(reinterpret_cast<std::intptr_t>(op));
+  std::lock_guard<std::mutex> lk(shard.mu);
+  if (!op->self_) {
     google::cloud::internal::ThrowRuntimeError(
-        "assertion failure: searching for async op tag");
+        "assertion failure: async operation is not registered");
   }
-  return loc->second;
+  return op->self_;
 }
 
-void CompletionQueueImpl::ForgetOperation(void* tag) {
-  std::lock_guard<std::mutex> lk(mu_);
-  auto const num_erased =
-      pending_ops_.erase(reinterpret_cast<std::intptr_t>(tag));
-  if (num_erased != 1) {
-    google::cloud::internal::ThrowRuntimeError(
-        "assertion failure: searching for async op tag when trying to "
-        "unregister");
+void CompletionQueueImpl::ForgetOperation(AsyncGrpcOperation* op) {
+  auto& registry = MetricsRegistry::Instance();
+  static auto& pending_operations =
+      registry.Counter("completion_queue.pending_operations");
+  static auto& queue_time_us =
+      registry.Histogram("completion_queue.queue_time_us");
+  auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - op->enqueue_time_);
+  auto& shard = GetShard(reinterpret_cast<std::intptr_t>(op));
+  // Move the queue's reference out of the operation, releasing it after the
+  // lock is dropped; this may be the last reference to the operation.
+  std::shared_ptr<AsyncGrpcOperation> self;
+  {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (!op->self_) {
+      google::cloud::internal::ThrowRuntimeError(
+          "assertion failure: async operation is not registered when trying "
+          "to unregister");
+    }
+    if (op->prev_ != nullptr) {
+      op->prev_->next_ = op->next_;
+    } else {
+      shard.head = op->next_;
+    }
+    if (op->next_ != nullptr) op->next_->prev_ = op->prev_;
+    op->next_ = nullptr;
+    op->prev_ = nullptr;
+    --shard.size;
+    self = std::move(op->self_);
   }
+  pending_operations.Increment(-1);
+  queue_time_us.Record(elapsed.count());
 }
 
 // This function is used in unit tests to simulate the completion of an
@@ -101,28 +344,28 @@ void CompletionQueueImpl::ForgetOperation(void* tag) {
 // to simulate the operation lifecycle. Note that the unit test must simulate
 // the operation results separately.
 void CompletionQueueImpl::SimulateCompletion(AsyncOperation* op, bool ok) {
-  auto internal_op = FindOperation(op);
+  // Hold an extra reference, `ForgetOperation()` releases the queue's own.
+  auto internal_op = HoldOperation(op);
   internal_op->Cancel();
   if (internal_op->Notify(ok)) {
-    ForgetOperation(op);
+    ForgetOperation(internal_op.get());
   }
 }
 
 void CompletionQueueImpl::SimulateCompletion(bool ok) {
   // Make a copy to avoid race conditions or iterator invalidation.
-  std::vector<void*> tags;
-  {
-    std::lock_guard<std::mutex> lk(mu_);
-    tags.reserve(pending_ops_.size());
-    for (auto&& kv : pending_ops_) {
-      tags.push_back(reinterpret_cast<void*>(kv.first));
+  std::vector<std::shared_ptr<AsyncGrpcOperation>> pending;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    pending.reserve(pending.size() + shard.size);
+    for (auto* op = shard.head; op != nullptr; op = op->next_) {
+      pending.push_back(op->self_);
     }
   }
-  for (void* tag : tags) {
-    auto internal_op = FindOperation(tag);
+  for (auto& internal_op : pending) {
     internal_op->Cancel();
     if (internal_op->Notify(ok)) {
-      ForgetOperation(tag);
+      ForgetOperation(internal_op.get());
     }
   }
 
@@ -19,12 +19,16 @@
 #include "google/cloud/future.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/invoke_result.h"
+#include "google/cloud/internal/metrics.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <grpcpp/alarm.h>
 #include <grpcpp/support/async_stream.h>
 #include <grpcpp/support/async_unary_call.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -34,6 +38,7 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
 class CompletionQueue;
 namespace internal {
 class CompletionQueueImpl;
+class TimerBatch;
 
 /**
  * Represents an AsyncOperation which gRPC understands.
@@ -44,10 +49,30 @@ class CompletionQueueImpl;
  * hides it in a class derived from `AsyncOperation`. A shared pointer to the
  * `AsyncOperation` is returned by the completion queue so library developers
  * can cancel the operation if needed.
+ *
+ * The operation is its own registration record: while it is pending it
+ * holds a self-reference (the queue lifecycle refcount) and a pair of
+ * intrusive hooks linking it into a per-shard list in
+ * `CompletionQueueImpl`. The gRPC tag is the address of the operation, so
+ * dispatching a completion requires no lookup at all.
  */
 class AsyncGrpcOperation : public AsyncOperation {
  private:
   friend class CompletionQueueImpl;
+
+  /// When the operation was registered, used to report time-in-queue.
+  std::chrono::steady_clock::time_point enqueue_time_;
+
+  /// Keeps the operation alive from `StartOperation()` until it completes.
+  /// Set and cleared under the shard mutex.
+  std::shared_ptr<AsyncGrpcOperation> self_;
+
+  /// Intrusive hooks for the per-shard list of pending operations, used by
+  /// the (rare) members that visit all pending operations. Guarded by the
+  /// shard mutex.
+  AsyncGrpcOperation* next_ = nullptr;
+  AsyncGrpcOperation* prev_ = nullptr;
+
   /**
    * Notifies the application that the operation completed.
    *
@@ -84,7 +109,8 @@ class AsyncGrpcOperation : public AsyncOperation {
 template <typename Request, typename Response>
 class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
  public:
-  AsyncUnaryRpcFuture() = default;
+  AsyncUnaryRpcFuture()
+      : promise_(/*cancellation_callback=*/[this] { Cancel(); }) {}
 
   future<StatusOr<Response>> GetFuture() { return promise_.get_future(); }
 
@@ -98,7 +124,9 @@ class AsyncUnaryRpcFuture : public AsyncGrpcOperation {
     rpc->Finish(&response_, &status_, tag);
   }
 
-  void Cancel() override { context_->TryCancel(); }
+  void Cancel() override {
+    if (context_) context_->TryCancel();
+  }
 
  private:
   bool Notify(bool ok) override {
@@ -226,13 +254,28 @@ using AsyncCallResponseType = AsyncCallResponseTypeUnwrap<
  * `CompletionQueue` is implemented using the PImpl idiom:
  *     https://en.wikipedia.org/wiki/Opaque_pointer
  * This is the implementation class in that idiom.
+ *
+ * The queue is designed for multi-threaded polling: any number of threads
+ * may call `Run()` concurrently, each one draining events from the
+ * underlying gRPC completion queue. To scale to that kind of fan-out the
+ * pending operations register intrusively: each `AsyncGrpcOperation`
+ * carries its own refcount and list hooks, sharded over several lists
+ * (each with its own mutex) so threads registering or completing
+ * unrelated operations rarely contend on a lock. The gRPC tag is the
+ * operation's address, so dispatching a completion performs no lookup.
  */
 class CompletionQueueImpl {
  public:
   CompletionQueueImpl() = default;
   virtual ~CompletionQueueImpl() = default;
 
-  /// Run the event loop until Shutdown() is called.
+  /**
+   * Run the event loop until Shutdown() is called.
+   *
+   * Many threads may call this member function concurrently; each one
+   * polls the underlying gRPC queue and dispatches the completions it
+   * receives, so the event throughput scales with the number of threads.
+   */
   void Run();
 
   /// Terminate the event loop.
@@ -241,6 +284,24 @@ class CompletionQueueImpl {
   /// Cancel all existing operations.
   void CancelAll();
 
+  /**
+   * Create a timer that fires at @p deadline.
+   *
+   * Timers are coalesced into the slots of a hashed timer wheel: all the
+   * timers that expire within the same `kTimerSlotWidth` interval share a
+   * single `grpc::Alarm`, a single tag, and a single pass through the event
+   * loop. Retry backoffs, session refreshes, and similar workloads create
+   * very large numbers of short timers; batching their expirations reduces
+   * the allocations and queue traversals to one per slot instead of one per
+   * timer. A timer may fire up to `kTimerSlotWidth` after @p deadline, it
+   * never fires early.
+   *
+   * @return a future satisfied with @p deadline when the timer expires, or
+   *     with an error `Status` if the timer is cancelled.
+   */
+  future<StatusOr<std::chrono::system_clock::time_point>> MakeDeadlineTimer(
+      std::chrono::system_clock::time_point deadline);
+
   /// Create a new alarm object.
   virtual std::unique_ptr<grpc::Alarm> CreateAlarm() const;
 
@@ -254,30 +315,35 @@ class CompletionQueueImpl {
                 int>::type = 0>
   void StartOperation(std::shared_ptr<AsyncGrpcOperation> op,
                       Callable&& start) {
-    void* tag = op.get();
-    std::unique_lock<std::mutex> lk(mu_);
-    if (shutdown_) {
+    static auto& pending_operations =
+        MetricsRegistry::Instance().Counter(
+            "completion_queue.pending_operations");
+    AsyncGrpcOperation* raw = op.get();
+    raw->enqueue_time_ = std::chrono::steady_clock::now();
+    auto& shard = GetShard(reinterpret_cast<std::intptr_t>(raw));
+    std::unique_lock<std::mutex> lk(shard.mu);
+    if (shard.shutdown) {
       lk.unlock();
       op->Notify(/*ok=*/false);
       return;
     }
-    auto ins = pending_ops_.emplace(reinterpret_cast<std::intptr_t>(tag),
-                                    std::move(op));
-    if (ins.second) {
-      start(tag);
-      lk.unlock();
-      return;
-    }
-    google::cloud::internal::ThrowRuntimeError(
-        "assertion failure: insertion should succeed");
+    raw->self_ = std::move(op);
+    raw->prev_ = nullptr;
+    raw->next_ = shard.head;
+    if (shard.head != nullptr) shard.head->prev_ = raw;
+    shard.head = raw;
+    ++shard.size;
+    start(raw);
+    lk.unlock();
+    pending_operations.Increment();
   }
 
  protected:
-  /// Return the asynchronous operation associated with @p tag.
-  std::shared_ptr<AsyncGrpcOperation> FindOperation(void* tag);
+  /// Return a reference that keeps @p tag alive past its unregistration.
+  std::shared_ptr<AsyncGrpcOperation> HoldOperation(void* tag);
 
-  /// Unregister @p tag from pending operations.
-  void ForgetOperation(void* tag);
+  /// Unregister @p op and release the queue's reference to it.
+  void ForgetOperation(AsyncGrpcOperation* op);
 
   /// Simulate a completed operation, provided only to support unit tests.
   void SimulateCompletion(AsyncOperation* op, bool ok);
@@ -287,21 +353,66 @@ class CompletionQueueImpl {
   void SimulateCompletion(bool ok);
 
   bool empty() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_.empty();
+    for (auto const& shard : shards_) {
+      std::unique_lock<std::mutex> lk(shard.mu);
+      if (shard.head != nullptr) return false;
+    }
+    return true;
   }
 
   std::size_t size() const {
-    std::unique_lock<std::mutex> lk(mu_);
-    return pending_ops_.size();
+    std::size_t n = 0;
+    for (auto const& shard : shards_) {
+      std::unique_lock<std::mutex> lk(shard.mu);
+      n += shard.size;
+    }
+    return n;
   }
 
  private:
+  friend class TimerBatch;
+
+  /// The granularity of the timer wheel, see `MakeDeadlineTimer()`.
+  static std::chrono::milliseconds constexpr kTimerSlotWidth{1};
+
+  /// Remove @p batch from the timer wheel, unless @p slot has been taken over
+  /// by a newer batch.
+  void EraseTimerWheelSlot(std::int64_t slot, TimerBatch const* batch);
+
+  /**
+   * One shard of the pending operations.
+   *
+   * Each shard holds its own mutex, intrusive list, and shutdown flag.
+   * `Shutdown()` sets the flag on every shard, so the "no new operations
+   * after shutdown" invariant only requires the one shard lock that
+   * `StartOperation()` already holds.
+   */
+  struct OperationShard {
+    mutable std::mutex mu;
+    bool shutdown = false;              // GUARDED_BY(mu)
+    AsyncGrpcOperation* head = nullptr;  // GUARDED_BY(mu)
+    std::size_t size = 0;               // GUARDED_BY(mu)
+  };
+
+  /// More shards reduce contention with many pollers, but slow down the
+  /// (rare) operations that visit all of them.
+  static std::size_t constexpr kOperationShardCount = 16;
+
+  OperationShard& GetShard(std::intptr_t key) {
+    // The low bits of a tag are mostly alignment, discard them so the
+    // operations spread evenly over the shards.
+    return shards_[(static_cast<std::size_t>(key) >> 6) %
+                   kOperationShardCount];
+  }
+
   grpc::CompletionQueue cq_;
-  mutable std::mutex mu_;
-  bool shutdown_{false};  // GUARDED_BY(mu_)
-  std::unordered_map<std::intptr_t, std::shared_ptr<AsyncGrpcOperation>>
-      pending_ops_;  // GUARDED_BY(mu_)
+  std::array<OperationShard, kOperationShardCount> shards_;
+
+  std::mutex timer_mu_;
+  /// The timer wheel: maps a slot index (the deadline rounded up to a
+  /// `kTimerSlotWidth` boundary) to the batch of timers expiring in it.
+  std::unordered_map<std::int64_t, std::shared_ptr<TimerBatch>>
+      timer_wheel_;  // GUARDED_BY(timer_mu_)
 };
 
 }  // namespace internal
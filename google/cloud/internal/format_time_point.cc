@@ -13,36 +13,149 @@
 // limitations under the License.
 
 #include "google/cloud/internal/format_time_point.h"
-#include "absl/time/time.h"
+#include <cstdint>
 
 namespace google {
 namespace cloud {
 inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
+namespace {
+
+// The civil time (in UTC) for a `std::chrono::system_clock::time_point`,
+// along with any positive sub-second part of the time point.
+struct CivilTime {
+  std::int64_t year;
+  int month;
+  int day;
+  int hours;
+  int minutes;
+  int seconds;
+  std::chrono::nanoseconds subseconds;
+};
+
+// Computes year/month/day from a count of days since 1970-01-01 in the
+// proleptic Gregorian calendar, using the algorithm from
+// http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+CivilTime MakeCivilTime(std::chrono::system_clock::time_point tp) {
+  auto const d = tp.time_since_epoch();
+  auto secs = std::chrono::duration_cast<std::chrono::seconds>(d);
+  if (secs > d) secs -= std::chrono::seconds(1);  // floor
+  auto const subseconds =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(d - secs);
+
+  auto constexpr kSecondsInDay = 24 * 3600;
+  auto const count = secs.count();
+  std::int64_t days = count / kSecondsInDay;
+  if (days * kSecondsInDay > count) --days;  // floor
+  auto const time_of_day = static_cast<int>(count - days * kSecondsInDay);
+
+  std::int64_t const z = days + 719468;
+  std::int64_t const era = (z >= 0 ? z : z - 146096) / 146097;
+  std::int64_t const doe = z - era * 146097;
+  std::int64_t const yoe =
+      (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  std::int64_t const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  std::int64_t const mp = (5 * doy + 2) / 153;
+
+  CivilTime ct;
+  ct.day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  ct.month = static_cast<int>(mp + (mp < 10 ? 3 : -9));
+  ct.year = yoe + era * 400 + (ct.month <= 2 ? 1 : 0);
+  ct.hours = time_of_day / 3600;
+  ct.minutes = (time_of_day / 60) % 60;
+  ct.seconds = time_of_day % 60;
+  ct.subseconds = subseconds;
+  return ct;
+}
+
+void AppendTwoDigits(std::string& s, int value) {
+  s.push_back(static_cast<char>('0' + value / 10));
+  s.push_back(static_cast<char>('0' + value % 10));
+}
+
+// Appends the year zero-padded to (at least) 4 digits, as `%E4Y` would.
+void AppendYear(std::string& s, std::int64_t year) {
+  if (year < 0 || year > 9999) {
+    s.append(std::to_string(year));
+    return;
+  }
+  AppendTwoDigits(s, static_cast<int>(year / 100));
+  AppendTwoDigits(s, static_cast<int>(year % 100));
+}
+
+// Appends the sub-second part as `.<digits>`, without trailing zeros, and
+// appends nothing at all for a whole number of seconds (like `%E*S`).
+void AppendSubseconds(std::string& s, std::chrono::nanoseconds subseconds) {
+  if (subseconds.count() == 0) return;
+  char buffer[9];
+  auto value = subseconds.count();
+  for (int i = 9; i != 0; value /= 10) {
+    buffer[--i] = static_cast<char>('0' + value % 10);
+  }
+  int width = 9;
+  while (buffer[width - 1] == '0') --width;
+  s.push_back('.');
+  s.append(buffer, width);
+}
+
+}  // namespace
 
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y-%m-%dT%H:%M:%E*SZ";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  auto const ct = MakeCivilTime(tp);
+  std::string s;
+  s.reserve(sizeof("YYYY-MM-DDTHH:MM:SS.123456789Z"));
+  AppendYear(s, ct.year);
+  s.push_back('-');
+  AppendTwoDigits(s, ct.month);
+  s.push_back('-');
+  AppendTwoDigits(s, ct.day);
+  s.push_back('T');
+  AppendTwoDigits(s, ct.hours);
+  s.push_back(':');
+  AppendTwoDigits(s, ct.minutes);
+  s.push_back(':');
+  AppendTwoDigits(s, ct.seconds);
+  AppendSubseconds(s, ct.subseconds);
+  s.push_back('Z');
+  return s;
 }
 
 std::string FormatUtcDate(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y-%m-%d";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  auto const ct = MakeCivilTime(tp);
+  std::string s;
+  s.reserve(sizeof("YYYY-MM-DD"));
+  AppendYear(s, ct.year);
+  s.push_back('-');
+  AppendTwoDigits(s, ct.month);
+  s.push_back('-');
+  AppendTwoDigits(s, ct.day);
+  return s;
 }
 
 std::string FormatV4SignedUrlTimestamp(
     std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y%m%dT%H%M%SZ";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  auto const ct = MakeCivilTime(tp);
+  std::string s;
+  s.reserve(sizeof("YYYYMMDDTHHMMSSZ"));
+  AppendYear(s, ct.year);
+  AppendTwoDigits(s, ct.month);
+  AppendTwoDigits(s, ct.day);
+  s.push_back('T');
+  AppendTwoDigits(s, ct.hours);
+  AppendTwoDigits(s, ct.minutes);
+  AppendTwoDigits(s, ct.seconds);
+  s.push_back('Z');
+  return s;
 }
 
 std::string FormatV4SignedUrlScope(std::chrono::system_clock::time_point tp) {
-  auto constexpr kFormat = "%E4Y%m%d";
-  auto const t = absl::FromChrono(tp);
-  return absl::FormatTime(kFormat, t, absl::UTCTimeZone());
+  auto const ct = MakeCivilTime(tp);
+  std::string s;
+  s.reserve(sizeof("YYYYMMDD"));
+  AppendYear(s, ct.year);
+  AppendTwoDigits(s, ct.month);
+  AppendTwoDigits(s, ct.day);
+  return s;
 }
 
 }  // namespace internal
@@ -72,6 +72,12 @@ TEST(FormatRfc3339Test, FractionalNanos) {
   }
 }
 
+TEST(FormatRfc3339Test, PreEpoch) {
+  auto timestamp = ParseRfc3339("1969-07-20T20:17:40.5Z");
+  std::string actual = FormatRfc3339(timestamp);
+  EXPECT_EQ("1969-07-20T20:17:40.5Z", actual);
+}
+
 TEST(FormatV4SignedUrlTimestampTest, Base) {
   auto timestamp = ParseRfc3339("2019-08-02T01:02:03Z");
   std::string actual = FormatV4SignedUrlTimestamp(timestamp);
@@ -0,0 +1,90 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
+/**
+ * @file
+ *
+ * Make `google::cloud::future<T>` awaitable in C++20 coroutines.
+ *
+ * The library targets C++11, but applications compiling against it with C++20
+ * can `co_await` any `future<T>` directly instead of writing a bridge through
+ * `.then()` by hand.
+ */
+
+#include "google/cloud/internal/port_platform.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#include "google/cloud/internal/future_then_impl.h"
+#include "google/cloud/version.h"
+#include <coroutine>
+#include <utility>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * The awaiter type returned by `operator co_await(future<T>&&)`.
+ *
+ * Suspending attaches a continuation that resumes the coroutine when the
+ * future becomes satisfied. The continuation captures only `this` and the
+ * coroutine handle, so it fits in the shared state's inline continuation
+ * buffer and suspension performs no additional allocations. The coroutine
+ * resumes in whatever thread satisfies the future, exactly where a `.then()`
+ * callback would run.
+ */
+template <typename T>
+class future_awaiter {  // NOLINT(readability-identifier-naming)
+ public:
+  explicit future_awaiter(future<T> f) : future_(std::move(f)) {}
+
+  bool await_ready() { return future_.is_ready(); }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // The result future must be stored back before resuming: resuming may run
+    // the coroutine to completion and destroy the frame holding this awaiter.
+    future_.then([this, handle](future<T> f) {
+      future_ = std::move(f);
+      handle.resume();
+    });
+  }
+
+  T await_resume() { return future_.get(); }
+
+ private:
+  future<T> future_;
+};
+
+}  // namespace internal
+
+/**
+ * Make `future<T>` usable in `co_await` expressions.
+ *
+ * Awaiting consumes the future, just like `.get()` or `.then()` would, which
+ * is why only rvalue futures are accepted. The `co_await` expression yields
+ * the value stored in the future, or re-throws the stored exception.
+ */
+template <typename T>
+internal::future_awaiter<T> operator co_await(future<T>&& f) {
+  return internal::future_awaiter<T>(std::move(f));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_FUTURE_COROUTINES_H
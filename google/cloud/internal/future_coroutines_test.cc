@@ -0,0 +1,97 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The tests in this file only compile (and run) with C++20 coroutine support.
+#include "google/cloud/internal/port_platform.h"
+#if GOOGLE_CLOUD_CPP_HAVE_COROUTINES
+
+#include "google/cloud/future.h"
+#include <gmock/gmock.h>
+#include <coroutine>
+#include <thread>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+
+/// A minimal fire-and-forget coroutine type, just enough for these tests.
+struct TestCoroutine {
+  struct promise_type {
+    TestCoroutine get_return_object() { return {}; }
+    std::suspend_never initial_suspend() { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+TestCoroutine AddOne(future<int> input, promise<int> output) {
+  auto value = co_await std::move(input);
+  output.set_value(value + 1);
+}
+
+/// @test Verify co_await on a future that is already satisfied.
+TEST(FutureCoroutines, AwaitReadyFuture) {
+  promise<int> output;
+  auto result = output.get_future();
+  AddOne(make_ready_future(42), std::move(output));
+  ASSERT_TRUE(result.is_ready());
+  EXPECT_EQ(43, result.get());
+}
+
+/// @test Verify co_await suspends until the future is satisfied.
+TEST(FutureCoroutines, AwaitPendingFuture) {
+  promise<int> input;
+  promise<int> output;
+  auto result = output.get_future();
+  AddOne(input.get_future(), std::move(output));
+  EXPECT_FALSE(result.is_ready());
+  input.set_value(7);
+  EXPECT_EQ(8, result.get());
+}
+
+/// @test Verify the coroutine resumes in the thread satisfying the future.
+TEST(FutureCoroutines, AwaitFromAnotherThread) {
+  promise<int> input;
+  promise<int> output;
+  auto result = output.get_future();
+  AddOne(input.get_future(), std::move(output));
+  std::thread t([&input] { input.set_value(100); });
+  EXPECT_EQ(101, result.get());
+  t.join();
+}
+
+TestCoroutine Chain(future<void> input, promise<std::string> output) {
+  co_await std::move(input);
+  output.set_value("done");
+}
+
+/// @test Verify co_await works with future<void>.
+TEST(FutureCoroutines, AwaitVoid) {
+  promise<void> input;
+  promise<std::string> output;
+  auto result = output.get_future();
+  Chain(input.get_future(), std::move(output));
+  EXPECT_FALSE(result.is_ready());
+  input.set_value();
+  EXPECT_EQ("done", result.get());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_HAVE_COROUTINES
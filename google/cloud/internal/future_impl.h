@@ -25,9 +25,11 @@
 #include "google/cloud/version.h"
 #include "absl/memory/memory.h"
 #include <condition_variable>
+#include <cstddef>
 #include <exception>
 #include <future>
 #include <mutex>
+#include <type_traits>
 
 namespace google {
 namespace cloud {
@@ -73,6 +75,7 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   explicit future_shared_state_base(std::function<void()> cancellation_callback)
       : current_state_(state::not_ready),
         cancellation_callback_(std::move(cancellation_callback)) {}
+  ~future_shared_state_base() { destroy_continuation(); }
   /// Return true if the shared state has a value or an exception.
   bool is_ready() const {
     std::unique_lock<std::mutex> lk(mu_);
@@ -200,7 +203,39 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
       c->execute();
       return;
     }
-    continuation_ = std::move(c);
+    continuation_ = c.release();
+    continuation_is_inline_ = false;
+  }
+
+  /**
+   * Construct a continuation of type @p C directly in the shared state.
+   *
+   * Continuations that fit in the inline buffer are placed there, saving
+   * one allocation per `.then()` link; larger ones fall back to the heap.
+   * The semantics are otherwise identical to `set_continuation()`.
+   *
+   * @tparam C the concrete continuation type, it must derive from
+   *     `continuation_base`.
+   */
+  template <typename C, typename... Args>
+  void emplace_continuation(Args&&... args) {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (continuation_) {
+      ThrowFutureError(std::future_errc::future_already_retrieved, __func__);
+    }
+    using fits_inline = std::integral_constant<
+        bool, (sizeof(C) <= kInlineContinuationSize &&
+               alignof(C) <= alignof(inline_continuation_storage_t))>;
+    construct_continuation<C>(fits_inline{}, std::forward<Args>(args)...);
+    // If the future is already satisfied, invoke the continuation immediately.
+    if (is_ready_unlocked()) {
+      // Release the lock before calling the user's code, holding locks during
+      // callbacks is a bad practice.
+      lk.unlock();
+      continuation_->execute();
+      destroy_continuation();
+      return;
+    }
   }
 
   std::function<void()> release_cancellation_callback() {
@@ -294,14 +329,55 @@ class future_shared_state_base {  // NOLINT(readability-identifier-naming)
   state current_state_;
   std::exception_ptr exception_;
 
+  /// Construct a continuation in the inline buffer.
+  template <typename C, typename... Args>
+  void construct_continuation(std::true_type, Args&&... args) {
+    continuation_ = new (&continuation_buffer_) C(std::forward<Args>(args)...);
+    continuation_is_inline_ = true;
+  }
+
+  /// Construct a continuation too large for the inline buffer.
+  template <typename C, typename... Args>
+  void construct_continuation(std::false_type, Args&&... args) {
+    continuation_ = new C(std::forward<Args>(args)...);
+    continuation_is_inline_ = false;
+  }
+
+  /// Destroy the continuation, wherever it lives.
+  void destroy_continuation() {
+    if (continuation_ == nullptr) return;
+    if (continuation_is_inline_) {
+      continuation_->~continuation_base();
+    } else {
+      delete continuation_;
+    }
+    continuation_ = nullptr;
+  }
+
+  /**
+   * The size of the inline buffer for continuations.
+   *
+   * Most continuations capture a functor with a couple of pointers plus
+   * the input and output shared states; this is large enough for those
+   * without growing the shared state too much.
+   */
+  static std::size_t constexpr kInlineContinuationSize = 64;
+  using inline_continuation_storage_t = typename std::aligned_storage<
+      kInlineContinuationSize, alignof(std::max_align_t)>::type;
+
   /**
    * The continuation, if any, associated with this shared state.
    *
    * Note that continuations may be set independently of having a value or
    * exception. Setting a continuation does not change the `current_state_`
    * member variable and does not satisfy the shared state.
+   *
+   * The pointer refers to `continuation_buffer_` for continuations small
+   * enough to be stored inline, and to a heap allocation otherwise.
    */
-  std::unique_ptr<continuation_base> continuation_;
+  continuation_base* continuation_ = nullptr;
+  bool continuation_is_inline_ = false;
+  inline_continuation_storage_t continuation_buffer_;
 
   // Allow users "cancel" the future with the given callback.
   std::atomic<bool> cancelled_ = ATOMIC_VAR_INIT(false);
@@ -349,6 +425,7 @@ class future_shared_state final : private future_shared_state_base {
 
   using future_shared_state_base::abandon;
   using future_shared_state_base::cancel;
+  using future_shared_state_base::emplace_continuation;
   using future_shared_state_base::is_ready;
   using future_shared_state_base::release_cancellation_callback;
   using future_shared_state_base::set_continuation;
@@ -478,6 +555,7 @@ class future_shared_state<void> final : private future_shared_state_base {
 
   using future_shared_state_base::abandon;
   using future_shared_state_base::cancel;
+  using future_shared_state_base::emplace_continuation;
   using future_shared_state_base::is_ready;
   using future_shared_state_base::release_cancellation_callback;
   using future_shared_state_base::set_continuation;
@@ -733,6 +811,13 @@ struct unwrapping_continuation : public continuation_base {
         output(std::make_shared<output_shared_state_t>(
             input.lock()->release_cancellation_callback())) {}
 
+  unwrapping_continuation(Functor&& f, std::shared_ptr<input_shared_state_t> s,
+                          std::shared_ptr<output_shared_state_t> o)
+      : functor(std::move(f)),
+        input(std::move(s)),
+        intermediate(),
+        output(std::move(o)) {}
+
   void execute() override {
     auto tmp = input.lock();
     if (!tmp) {
@@ -763,13 +848,11 @@ struct unwrapping_continuation : public continuation_base {
       return r->get();
     };
     using continuation_type = internal::continuation<decltype(unwrapper), R>;
-    auto continuation = absl::make_unique<continuation_type>(
-        std::move(unwrapper), intermediate, output);
     // assert(intermediate->continuation_ == nullptr)
     // If intermediate has a continuation then the associated future would have
     // been invalid, and we never get here.
-    intermediate->set_continuation(
-        std::unique_ptr<continuation_base>(std::move(continuation)));
+    intermediate->template emplace_continuation<continuation_type>(
+        std::move(unwrapper), intermediate, output);
   }
 
   /// The functor called when `input` is satisfied.
@@ -791,12 +874,14 @@ template <typename F>
 std::shared_ptr<typename internal::continuation_helper<F, T>::state_t>
 future_shared_state<T>::make_continuation(
     std::shared_ptr<future_shared_state<T>> self, F&& functor) {
+  using state_t = typename internal::continuation_helper<F, T>::state_t;
   using continuation_type = internal::continuation<F, T>;
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  auto result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  // Create the output shared state first so it survives even when the
+  // continuation runs (and is destroyed) immediately.
+  auto result =
+      std::make_shared<state_t>(self->release_cancellation_callback());
+  self->template emplace_continuation<continuation_type>(
+      std::forward<F>(functor), self, result);
   return result;
 }
 
@@ -812,15 +897,12 @@ future_shared_state<T>::make_continuation(
   // The type continuation that executes `F` on `self`:
   using continuation_type = internal::unwrapping_continuation<F, T>;
 
-  // First create a continuation that calls the functor, and stores the result
-  // in a `future_shared_state<future_shared_state<R>>`
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  // Save the value of `continuation->output`, because the move will make it
-  // inaccessible.
-  std::shared_ptr<future_shared_state<R>> result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  // Create the output shared state first so it survives even when the
+  // continuation runs (and is destroyed) immediately.
+  auto result = std::make_shared<future_shared_state<R>>(
+      self->release_cancellation_callback());
+  self->template emplace_continuation<continuation_type>(
+      std::forward<F>(functor), self, result);
   return result;
 }
 
@@ -829,14 +911,14 @@ template <typename F>
 std::shared_ptr<typename internal::continuation_helper<F, void>::state_t>
 future_shared_state<void>::make_continuation(
     std::shared_ptr<future_shared_state<void>> self, F&& functor) {
+  using state_t = typename internal::continuation_helper<F, void>::state_t;
   using continuation_type = internal::continuation<F, void>;
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  // Save the value of `continuation->output`, because the move will make it
-  // inaccessible.
-  auto result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  // Create the output shared state first so it survives even when the
+  // continuation runs (and is destroyed) immediately.
+  auto result =
+      std::make_shared<state_t>(self->release_cancellation_callback());
+  self->emplace_continuation<continuation_type>(std::forward<F>(functor), self,
+                                                result);
   return result;
 }
 
@@ -854,15 +936,12 @@ future_shared_state<void>::make_continuation(
   // The type continuation that executes `F` on `self`:
   using continuation_type = internal::unwrapping_continuation<F, void>;
 
-  // First create a continuation that calls the functor, and stores the result
-  // in a `future_shared_state<future_shared_state<R>>`
-  auto continuation =
-      absl::make_unique<continuation_type>(std::forward<F>(functor), self);
-  // Save the value of `continuation->output`, because the move will make it
-  // inaccessible.
-  std::shared_ptr<future_shared_state<R>> result = continuation->output;
-  self->set_continuation(
-      std::unique_ptr<continuation_base>(std::move(continuation)));
+  // Create the output shared state first so it survives even when the
+  // continuation runs (and is destroyed) immediately.
+  auto result = std::make_shared<future_shared_state<R>>(
+      self->release_cancellation_callback());
+  self->emplace_continuation<continuation_type>(std::forward<F>(functor), self,
+                                                result);
   return result;
 }
 
@@ -124,6 +124,60 @@ typename internal::then_helper<F, T>::future_t future<T>::then_impl(
   return future_t(std::move(output_shared_state));
 }
 
+template <typename T>
+template <typename Executor, typename F>
+typename internal::then_helper<F, T>::future_t future<T>::then_on(
+    Executor executor, F&& func) {
+  this->check_valid();
+
+  // The value is transferred to an intermediate promise from within the
+  // executor, and @p func is attached to that promise's future with the
+  // regular `then()` machinery. Thus @p func (a) runs wherever the
+  // intermediate promise is satisfied, i.e., in the executor, and (b) keeps
+  // the unwrapping semantics of `then()`. Because we need to support C++11 we
+  // use local classes instead of lambdas, as support for move+capture in
+  // lambdas is a C++14 feature.
+
+  // Move the (satisfied) input future into the intermediate promise, this is
+  // the functor handed to the executor.
+  struct transfer {  // NOLINT(readability-identifier-naming)
+    transfer(promise<T> p, future<T> f)
+        : output(std::move(p)), input(std::move(f)) {}
+    void operator()() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        output.set_value(input.get());
+      } catch (...) {
+        output.set_exception(std::current_exception());
+      }
+#else
+      output.set_value(input.get());
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+    promise<T> output;
+    future<T> input;
+  };
+
+  // Runs inline when the input future is satisfied, only to schedule
+  // `transfer` in the executor.
+  struct schedule {  // NOLINT(readability-identifier-naming)
+    schedule(Executor e, promise<T> p)
+        : executor(std::move(e)), output(std::move(p)) {}
+    void operator()(future<T> f) {
+      executor.RunAsync(transfer(std::move(output), std::move(f)));
+    }
+    Executor executor;
+    promise<T> output;
+  };
+
+  // Move the cancellation callback into the intermediate promise, so that
+  // `cancel()` on the returned future behaves just like it does for `then()`.
+  promise<T> p{this->shared_state_->release_cancellation_callback()};
+  auto result = p.get_future().then(std::forward<F>(func));
+  this->then(schedule(std::move(executor), std::move(p)));
+  return result;
+}
+
 inline future<void>::future(future<future<void>>&& rhs)
     : future<void>(rhs.then([](future<future<void>> f) { return f.get(); })) {}
 
@@ -206,6 +260,49 @@ typename internal::then_helper<F, void>::future_t future<void>::then_impl(
   return future_t(std::move(output_shared_state));
 }
 
+template <typename Executor, typename F>
+typename internal::then_helper<F, void>::future_t future<void>::then_on(
+    Executor executor, F&& func) {
+  check_valid();
+
+  // See the documentation in `future<T>::then_on()` for the design; the only
+  // difference here is that `set_value()` takes no argument.
+  struct transfer {  // NOLINT(readability-identifier-naming)
+    transfer(promise<void> p, future<void> f)
+        : output(std::move(p)), input(std::move(f)) {}
+    void operator()() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        input.get();
+        output.set_value();
+      } catch (...) {
+        output.set_exception(std::current_exception());
+      }
+#else
+      input.get();
+      output.set_value();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+    promise<void> output;
+    future<void> input;
+  };
+
+  struct schedule {  // NOLINT(readability-identifier-naming)
+    schedule(Executor e, promise<void> p)
+        : executor(std::move(e)), output(std::move(p)) {}
+    void operator()(future<void> f) {
+      executor.RunAsync(transfer(std::move(output), std::move(f)));
+    }
+    Executor executor;
+    promise<void> output;
+  };
+
+  promise<void> p{shared_state_->release_cancellation_callback()};
+  auto result = p.get_future().then(std::forward<F>(func));
+  this->then(schedule(std::move(executor), std::move(p)));
+  return result;
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
 }  // namespace google
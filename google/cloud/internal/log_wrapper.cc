@@ -33,6 +33,12 @@ std::string DebugString(google::protobuf::Message const& m,
   return str;
 }
 
+bool DebugLoggingEnabled() {
+  auto const& sink = google::cloud::LogSink::Instance();
+  return LogSink::CompileTimeEnabled(Severity::GCP_LS_DEBUG) && !sink.empty() &&
+         sink.is_enabled(Severity::GCP_LS_DEBUG);
+}
+
 std::string RequestIdForLogging() {
   static std::atomic<std::uint64_t> generator{0};
   return std::to_string(++generator);
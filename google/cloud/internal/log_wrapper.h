@@ -39,6 +39,12 @@ char const* DebugFutureStatus(std::future_status s);
 // pairs.
 std::string RequestIdForLogging();
 
+// Returns true if the DEBUG log lines produced by `LogWrapper()` are enabled.
+// The synchronous overloads rely on `GCP_LOG()` to perform (the equivalent of)
+// this check, the asynchronous overloads use it to skip creating a request id
+// and attaching logging continuations to the returned future.
+bool DebugLoggingEnabled();
+
 template <typename T>
 struct IsStatusOr : public std::false_type {};
 template <typename T>
@@ -127,6 +133,9 @@ template <
     typename std::enable_if<IsFutureStatusOr<Result>::value, int>::type = 0>
 Result LogWrapper(Functor&& functor, Request request, char const* where,
                   TracingOptions const& options) {
+  // When logging is disabled skip the cost of creating a request id and of
+  // attaching a continuation to the returned future.
+  if (!DebugLoggingEnabled()) return functor(std::move(request));
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto prefix = std::string(where) + "(" + RequestIdForLogging() + ")";
@@ -160,6 +169,9 @@ Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
                   std::unique_ptr<grpc::ClientContext> context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  // When logging is disabled skip the cost of creating a request id and of
+  // attaching a continuation to the returned future.
+  if (!DebugLoggingEnabled()) return functor(cq, std::move(context), request);
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto prefix = std::string(where) + "(" + RequestIdForLogging() + ")";
@@ -192,6 +204,9 @@ Result LogWrapper(Functor&& functor, google::cloud::CompletionQueue& cq,
                   std::unique_ptr<grpc::ClientContext> context,
                   Request const& request, char const* where,
                   TracingOptions const& options) {
+  // When logging is disabled skip the cost of creating a request id and of
+  // attaching a continuation to the returned future.
+  if (!DebugLoggingEnabled()) return functor(cq, std::move(context), request);
   // Because this is an asynchronous request we need a unique identifier so
   // applications can match the request and response in the log.
   auto prefix = std::string(where) + "(" + RequestIdForLogging() + ")";
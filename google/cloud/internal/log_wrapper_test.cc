@@ -28,6 +28,7 @@ namespace {
 using ::testing::AllOf;
 using ::testing::Contains;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
 
 google::spanner::v1::Mutation MakeMutation() {
   auto constexpr kText = R"pb(
@@ -193,6 +194,28 @@ TEST(LogWrapper, FutureStatusOrError) {
   google::cloud::LogSink::Instance().RemoveBackend(id);
 }
 
+/// @test the overload for functions returning FutureStatusOr skips all work
+/// when no sink wants DEBUG lines
+TEST(LogWrapper, FutureStatusOrSkipsLoggingWhenDisabled) {
+  auto mock = [](google::spanner::v1::Mutation m) {
+    return make_ready_future(make_status_or(std::move(m)));
+  };
+
+  auto backend = std::make_shared<testing_util::CaptureLogLinesBackend>();
+  auto id = google::cloud::LogSink::Instance().AddBackend(backend);
+  google::cloud::LogSink::Instance().set_minimum_severity(
+      Severity::GCP_LS_WARNING);
+
+  auto result = LogWrapper(mock, MakeMutation(), "in-test", {}).get();
+  EXPECT_TRUE(result.ok());
+
+  EXPECT_THAT(backend->log_lines, IsEmpty());
+
+  google::cloud::LogSink::Instance().set_minimum_severity(
+      Severity::GCP_LS_LOWEST_ENABLED);
+  google::cloud::LogSink::Instance().RemoveBackend(id);
+}
+
 /// @test the overload for functions returning FutureStatusOr and using
 /// CompletionQueue as input
 TEST(LogWrapper, FutureStatusOrValueWithContextAndCQ) {
@@ -0,0 +1,70 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/metrics.h"
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+std::size_t constexpr MetricCounter::kStripes;
+int constexpr MetricHistogram::kBucketCount;
+
+std::size_t MetricCounter::ThisThreadStripe() {
+  // Assign threads to stripes round-robin as they first record a metric.
+  // This spreads the active threads evenly, a hash of the thread id would
+  // leave some stripes with two threads and others with none.
+  static std::atomic<std::size_t> ordinals{0};
+  thread_local std::size_t const stripe = ordinals++ % kStripes;
+  return stripe;
+}
+
+MetricsRegistry& MetricsRegistry::Instance() {
+  // Allocated on first use and never destroyed, threads may record metrics
+  // during program exit.
+  static auto* const kInstance = new MetricsRegistry;
+  return *kInstance;
+}
+
+MetricCounter& MetricsRegistry::Counter(std::string name) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& counter = counters_[std::move(name)];
+  if (!counter) counter.reset(new MetricCounter);
+  return *counter;
+}
+
+MetricHistogram& MetricsRegistry::Histogram(std::string name) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& histogram = histograms_[std::move(name)];
+  if (!histogram) histogram.reset(new MetricHistogram);
+  return *histogram;
+}
+
+MetricsRegistry::Snapshot MetricsRegistry::TakeSnapshot() const {
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> lk(mu_);
+  for (auto const& kv : counters_) {
+    snapshot.counters.emplace(kv.first, kv.second->Value());
+  }
+  for (auto const& kv : histograms_) {
+    snapshot.histograms.emplace(kv.first, kv.second->TakeSnapshot());
+  }
+  return snapshot;
+}
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,199 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_H
+
+#include "google/cloud/version.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+
+/**
+ * A monotonic counter striped across cache lines.
+ *
+ * The counter is updated on hot paths (one increment per RPC or per HTTP
+ * request), often from many threads at once. A single `std::atomic<>` would
+ * make all those threads contend for one cache line, so the count is split
+ * into a small number of stripes, each on its own cache line, and every
+ * thread consistently updates one stripe. Reading the counter adds up the
+ * stripes; the result is exact once the writers quiesce, and a normal
+ * racy-but-consistent snapshot while they run.
+ */
+class MetricCounter {
+ public:
+  MetricCounter() = default;
+
+  MetricCounter(MetricCounter const&) = delete;
+  MetricCounter& operator=(MetricCounter const&) = delete;
+
+  void Increment(std::int64_t delta = 1) {
+    stripes_[ThisThreadStripe()].value.fetch_add(delta,
+                                                 std::memory_order_relaxed);
+  }
+
+  std::int64_t Value() const {
+    std::int64_t total = 0;
+    for (auto const& stripe : stripes_) {
+      total += stripe.value.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+ private:
+  /// Map the calling thread to one stripe, stable for the thread's lifetime.
+  static std::size_t ThisThreadStripe();
+
+  // More stripes than typical core counts buys nothing, the goal is only to
+  // keep unrelated threads off the same cache line.
+  static std::size_t constexpr kStripes = 16;
+
+  // Pad each stripe to a cache line. Padding (rather than `alignas(64)`) is
+  // deliberate: C++11 `operator new` does not honor extended alignment, and
+  // keeping the stripes a cache line apart is what prevents false sharing.
+  struct Stripe {
+    std::atomic<std::int64_t> value{0};
+    char padding[64 - sizeof(std::atomic<std::int64_t>)];
+  };
+  Stripe stripes_[kStripes];
+};
+
+/**
+ * A histogram with power-of-2 (log-scale) buckets.
+ *
+ * Latencies and sizes span many orders of magnitude, log-scale buckets
+ * cover that range with a fixed, small amount of memory and a constant-time
+ * `Record()`. Bucket 0 counts values `<= 1`; bucket `i` counts values in
+ * `(2^(i-1), 2^i]`. Recording is a single relaxed atomic
+ * increment, there are no locks anywhere.
+ */
+class MetricHistogram {
+ public:
+  MetricHistogram() = default;
+
+  MetricHistogram(MetricHistogram const&) = delete;
+  MetricHistogram& operator=(MetricHistogram const&) = delete;
+
+  static int constexpr kBucketCount = 64;
+
+  void Record(std::int64_t value) {
+    buckets_[BucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.Increment(value);
+  }
+
+  /// The bucket index for @p value, exposed for the unit tests.
+  static int BucketFor(std::int64_t value) {
+    if (value <= 1) return 0;
+    int index = 0;
+    auto v = static_cast<std::uint64_t>(value - 1);
+    while (v != 0) {
+      v >>= 1;
+      ++index;
+    }
+    return index < kBucketCount ? index : kBucketCount - 1;
+  }
+
+  struct Snapshot {
+    /// Total number of recorded values.
+    std::int64_t count;
+    /// Sum of all recorded values.
+    std::int64_t sum;
+    /// Per-bucket counts, see the class comments for the bucket boundaries.
+    std::int64_t buckets[kBucketCount];
+  };
+
+  Snapshot TakeSnapshot() const {
+    Snapshot snapshot{};
+    for (int i = 0; i != kBucketCount; ++i) {
+      snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+      snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum = sum_.Value();
+    return snapshot;
+  }
+
+ private:
+  std::atomic<std::int64_t> buckets_[kBucketCount] = {};
+  MetricCounter sum_;
+};
+
+/**
+ * A process-wide registry of named counters and histograms.
+ *
+ * The libraries in this repo (storage, spanner, bigtable, pubsub) had no
+ * common instrumentation, applications wrapped every client call just to
+ * count them. The registry gives the client libraries one place to record
+ * counts, latencies and sizes, and gives applications one `TakeSnapshot()`
+ * call to export them to whatever monitoring system they use.
+ *
+ * Metrics are created on first use and live for the lifetime of the
+ * process; the returned references remain valid forever, so call sites
+ * resolve the name once (typically in a function-local static) and pay only
+ * an atomic increment per event afterwards.
+ *
+ * Names use dotted lowercase paths, e.g. `storage.curl.requests` or
+ * `spanner.session_pool.waits`. Registering the same name as both a counter
+ * and a histogram creates two independent metrics, do not do that.
+ */
+class MetricsRegistry {
+ public:
+  /// The process-wide registry instance.
+  static MetricsRegistry& Instance();
+
+  MetricsRegistry(MetricsRegistry const&) = delete;
+  MetricsRegistry& operator=(MetricsRegistry const&) = delete;
+
+  /// Return the counter named @p name, creating it on the first call.
+  MetricCounter& Counter(std::string name);
+
+  /// Return the histogram named @p name, creating it on the first call.
+  MetricHistogram& Histogram(std::string name);
+
+  struct Snapshot {
+    std::map<std::string, std::int64_t> counters;
+    std::map<std::string, MetricHistogram::Snapshot> histograms;
+  };
+
+  /// Return the current value of every registered metric.
+  Snapshot TakeSnapshot() const;
+
+  /**
+   * Create a new, empty registry.
+   *
+   * Only used in tests, everything else shares `Instance()`.
+   */
+  MetricsRegistry() = default;
+
+ private:
+  // The mutex only guards registration and snapshots; recording an event
+  // never touches it.
+  mutable std::mutex mu_;
+  std::map<std::string, std::unique_ptr<MetricCounter>> counters_;
+  std::map<std::string, std::unique_ptr<MetricHistogram>> histograms_;
+};
+
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_INTERNAL_METRICS_H
@@ -0,0 +1,108 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/metrics.h"
+#include <gmock/gmock.h>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+TEST(MetricCounterTest, Basic) {
+  MetricCounter counter;
+  EXPECT_EQ(0, counter.Value());
+  counter.Increment();
+  counter.Increment(41);
+  EXPECT_EQ(42, counter.Value());
+}
+
+TEST(MetricCounterTest, ConcurrentIncrementsAreExact) {
+  MetricCounter counter;
+  auto constexpr kThreads = 8;
+  auto constexpr kIncrementsPerThread = 10000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kThreads; ++i) {
+    threads.emplace_back([&counter] {
+      for (int j = 0; j != kIncrementsPerThread; ++j) counter.Increment();
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(kThreads * kIncrementsPerThread, counter.Value());
+}
+
+TEST(MetricHistogramTest, BucketBoundaries) {
+  // Bucket 0 holds values <= 1, bucket i holds (2^(i-1), 2^i].
+  EXPECT_EQ(0, MetricHistogram::BucketFor(-5));
+  EXPECT_EQ(0, MetricHistogram::BucketFor(0));
+  EXPECT_EQ(0, MetricHistogram::BucketFor(1));
+  EXPECT_EQ(1, MetricHistogram::BucketFor(2));
+  EXPECT_EQ(2, MetricHistogram::BucketFor(3));
+  EXPECT_EQ(2, MetricHistogram::BucketFor(4));
+  EXPECT_EQ(3, MetricHistogram::BucketFor(5));
+  EXPECT_EQ(3, MetricHistogram::BucketFor(8));
+  EXPECT_EQ(10, MetricHistogram::BucketFor(1024));
+  EXPECT_EQ(11, MetricHistogram::BucketFor(1025));
+  EXPECT_EQ(MetricHistogram::kBucketCount - 1,
+            MetricHistogram::BucketFor(
+                (std::numeric_limits<std::int64_t>::max)()));
+}
+
+TEST(MetricHistogramTest, RecordAndSnapshot) {
+  MetricHistogram histogram;
+  histogram.Record(1);
+  histogram.Record(100);
+  histogram.Record(100);
+  auto snapshot = histogram.TakeSnapshot();
+  EXPECT_EQ(3, snapshot.count);
+  EXPECT_EQ(201, snapshot.sum);
+  EXPECT_EQ(1, snapshot.buckets[MetricHistogram::BucketFor(1)]);
+  EXPECT_EQ(2, snapshot.buckets[MetricHistogram::BucketFor(100)]);
+}
+
+TEST(MetricsRegistryTest, SameNameSameMetric) {
+  MetricsRegistry registry;
+  auto& c1 = registry.Counter("test.counter");
+  auto& c2 = registry.Counter("test.counter");
+  EXPECT_EQ(&c1, &c2);
+  auto& h1 = registry.Histogram("test.histogram");
+  auto& h2 = registry.Histogram("test.histogram");
+  EXPECT_EQ(&h1, &h2);
+}
+
+TEST(MetricsRegistryTest, TakeSnapshot) {
+  MetricsRegistry registry;
+  registry.Counter("test.requests").Increment(7);
+  registry.Histogram("test.latency").Record(8);
+  auto snapshot = registry.TakeSnapshot();
+  ASSERT_EQ(1U, snapshot.counters.size());
+  EXPECT_EQ(7, snapshot.counters.at("test.requests"));
+  ASSERT_EQ(1U, snapshot.histograms.size());
+  EXPECT_EQ(1, snapshot.histograms.at("test.latency").count);
+  EXPECT_EQ(8, snapshot.histograms.at("test.latency").sum);
+}
+
+TEST(MetricsRegistryTest, InstanceIsSingleton) {
+  EXPECT_EQ(&MetricsRegistry::Instance(), &MetricsRegistry::Instance());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -18,9 +18,15 @@
 #include "google/cloud/status_or.h"
 #include "google/cloud/version.h"
 #include <google/protobuf/util/message_differencer.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -206,6 +212,184 @@ class PaginationRange {
   bool on_last_page_;
 };
 
+/**
+ * A `PaginationRange` that prefetches pages on a background thread.
+ *
+ * The page token protocol is inherently serial: the request for page N+1
+ * cannot be issued until the response carrying page N's token arrives. This
+ * class overlaps the fetch of upcoming pages with the consumption of the
+ * current one, buffering up to @p prefetched_pages pages, and surfaces the
+ * elements in order. Use it when iterating over large collections where each
+ * element requires enough processing that the next fetch can complete in the
+ * background.
+ *
+ * The background thread stops after the last page, after the first error, or
+ * when the range is destroyed. The destructor blocks until any fetch in
+ * progress completes.
+ *
+ * The range is cheap to move and copy, so the `List*()` member functions in
+ * the client libraries can return one by value, just like they return a
+ * `PaginationRange`. Copies share the underlying stream: consuming an element
+ * through one copy consumes it for all of them.
+ *
+ * @tparam T the type of the items, typically a proto describing the resources
+ * @tparam Request the type of the request object for the `List` RPC.
+ * @tparam Response the type of the response object for the `List` RPC.
+ */
+template <typename T, typename Request, typename Response>
+class PrefetchingPaginationRange {
+ public:
+  /**
+   * Create a new range to paginate over some elements.
+   *
+   * @param request the first request to start the iteration, the library may
+   *    initialize this request with any filtering constraints.
+   * @param loader makes the RPC request to fetch a new page of items, called
+   *    from the background thread.
+   * @param get_items extracts the items from the response using native C++
+   *     types (as opposed to the proto types used in `Response`).
+   * @param prefetched_pages how many unconsumed pages to keep buffered.
+   */
+  PrefetchingPaginationRange(
+      Request request,
+      std::function<StatusOr<Response>(Request const& r)> loader,
+      std::function<std::vector<T>(Response r)> get_items,
+      std::size_t prefetched_pages = 2)
+      : impl_(std::make_shared<Impl>(std::move(request), std::move(loader),
+                                     std::move(get_items), prefetched_pages)) {
+  }
+
+  /// The iterator type for this Range.
+  using iterator = PaginationIterator<T, PrefetchingPaginationRange>;
+
+  /**
+   * Return an iterator over the range of `T` objects.
+   *
+   * The returned iterator is a single-pass input iterator that reads new `T`
+   * objects from the underlying buffer when incremented.
+   *
+   * Creating, and particularly incrementing, multiple iterators on the same
+   * PrefetchingPaginationRange<> is unsupported and can produce incorrect
+   * results.
+   */
+  iterator begin() { return GetNext(); }
+
+  /// Return an iterator pointing to the end of the stream.
+  iterator end() {
+    return PaginationIterator<T, PrefetchingPaginationRange>{};
+  }
+
+ protected:
+  friend class PaginationIterator<T, PrefetchingPaginationRange>;
+
+  /**
+   * Returns (waiting for the background fetch if necessary) the next object
+   * from the stream.
+   *
+   * @return An iterator pointing to the next element in the stream. On error,
+   *   it returns an iterator that is different from `.end()`, but has an error
+   *   status. If the stream is exhausted, it returns the `.end()` iterator.
+   */
+  iterator GetNext() {
+    static Status const kPastTheEndError(
+        StatusCode::kFailedPrecondition,
+        "Cannot iterate past the end of PrefetchingPaginationRange");
+    auto& impl = *impl_;
+    while (impl.current_page.end() == impl.current) {
+      std::unique_lock<std::mutex> lock(impl.mu);
+      impl.cond.wait(lock,
+                     [&impl] { return impl.done || !impl.pages.empty(); });
+      if (impl.pages.empty()) return iterator(nullptr, kPastTheEndError);
+      auto page = std::move(impl.pages.front());
+      impl.pages.pop_front();
+      impl.cond.notify_all();
+      lock.unlock();
+      if (!page) return iterator(this, std::move(page).status());
+      impl.current_page = *std::move(page);
+      impl.current = impl.current_page.begin();
+    }
+    return iterator(this, std::move(*impl.current++));
+  }
+
+ private:
+  // The state shared by all copies of the range and by the background thread.
+  // Keeping it behind a `std::shared_ptr<>` (instead of making the mutex and
+  // thread direct members) is what makes the range movable and copyable.
+  struct Impl {
+    Impl(Request r, std::function<StatusOr<Response>(Request const&)> loader,
+         std::function<std::vector<T>(Response)> extractor,
+         std::size_t prefetched_pages)
+        : request(std::move(r)),
+          next_page_loader(std::move(loader)),
+          get_items(std::move(extractor)),
+          max_prefetched_pages(prefetched_pages == 0 ? 1 : prefetched_pages) {
+      current = current_page.begin();
+      worker = std::thread([this] { FetchPages(); });
+    }
+
+    ~Impl() {
+      {
+        std::lock_guard<std::mutex> lock(mu);
+        shutdown = true;
+      }
+      cond.notify_all();
+      worker.join();
+    }
+
+    // The body of the background thread, fetches pages until the collection
+    // is exhausted, an error occurs, the buffer is full, or the range is
+    // destroyed.
+    void FetchPages() {
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(mu);
+          cond.wait(lock, [this] {
+            return shutdown || pages.size() < max_prefetched_pages;
+          });
+          if (shutdown) return;
+        }
+        auto response = next_page_loader(request);
+        if (!response.ok()) {
+          std::lock_guard<std::mutex> lock(mu);
+          pages.emplace_back(std::move(response).status());
+          done = true;
+          cond.notify_all();
+          return;
+        }
+        auto token = std::move(*response->mutable_next_page_token());
+        auto items = get_items(*std::move(response));
+        request.set_page_token(token);
+        std::lock_guard<std::mutex> lock(mu);
+        pages.emplace_back(std::move(items));
+        if (token.empty()) done = true;
+        cond.notify_all();
+        if (done) return;
+      }
+    }
+
+    // Only the background thread uses these after construction.
+    Request request;
+    std::function<StatusOr<Response>(Request const& r)> next_page_loader;
+    std::function<std::vector<T>(Response r)> get_items;
+    std::size_t const max_prefetched_pages;
+
+    std::mutex mu;
+    std::condition_variable cond;
+    // The pages fetched but not yet consumed, protected by `mu`. An error
+    // status, which is always the last element, ends the iteration.
+    std::deque<StatusOr<std::vector<T>>> pages;
+    bool done = false;      // no more pages will be buffered, protected by `mu`
+    bool shutdown = false;  // the last owner is gone, protected by `mu`
+
+    // Only the consuming thread uses these.
+    std::vector<T> current_page;
+    typename std::vector<T>::iterator current;
+    std::thread worker;
+  };
+
+  std::shared_ptr<Impl> impl_;
+};
+
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
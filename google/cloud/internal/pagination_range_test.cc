@@ -15,6 +15,7 @@
 #include "google/cloud/internal/pagination_range.h"
 #include <google/bigtable/admin/v2/bigtable_instance_admin.grpc.pb.h>
 #include <gmock/gmock.h>
+#include <future>
 
 namespace google {
 namespace cloud {
@@ -177,6 +178,163 @@ TEST(RangeFromPagination, IteratorCoverage) {
   EXPECT_TRUE(i1 == range.end());
 }
 
+using PrefetchedRange = PrefetchingPaginationRange<ItemType, Request, Response>;
+
+TEST(PrefetchingRangeFromPagination, Empty) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_)).WillOnce([](Request const& request) {
+    EXPECT_TRUE(request.page_token().empty());
+    Response response;
+    response.clear_next_page_token();
+    return response;
+  });
+
+  PrefetchedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  EXPECT_TRUE(range.begin() == range.end());
+}
+
+TEST(PrefetchingRangeFromPagination, TwoPagesInOrder) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce([](Request const& request) {
+        EXPECT_TRUE(request.page_token().empty());
+        Response response;
+        response.set_next_page_token("t1");
+        response.add_app_profiles()->set_name("p1");
+        response.add_app_profiles()->set_name("p2");
+        return response;
+      })
+      .WillOnce([](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        Response response;
+        response.clear_next_page_token();
+        response.add_app_profiles()->set_name("p3");
+        response.add_app_profiles()->set_name("p4");
+        return response;
+      });
+
+  PrefetchedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) break;
+    names.push_back(p->name());
+  }
+  EXPECT_THAT(names, ElementsAre("p1", "p2", "p3", "p4"));
+}
+
+TEST(PrefetchingRangeFromPagination, FetchesAheadOfConsumption) {
+  MockRpc mock;
+  std::promise<void> second_page_fetched;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce([](Request const& request) {
+        EXPECT_TRUE(request.page_token().empty());
+        Response response;
+        response.set_next_page_token("t1");
+        response.add_app_profiles()->set_name("p1");
+        return response;
+      })
+      .WillOnce([&](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        second_page_fetched.set_value();
+        Response response;
+        response.clear_next_page_token();
+        response.add_app_profiles()->set_name("p2");
+        return response;
+      });
+
+  PrefetchedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  // The second page is fetched before any element is consumed.
+  second_page_fetched.get_future().wait();
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) break;
+    names.push_back(p->name());
+  }
+  EXPECT_THAT(names, ElementsAre("p1", "p2"));
+}
+
+TEST(PrefetchingRangeFromPagination, TwoPagesWithError) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce([](Request const& request) {
+        EXPECT_TRUE(request.page_token().empty());
+        Response response;
+        response.set_next_page_token("t1");
+        response.add_app_profiles()->set_name("p1");
+        response.add_app_profiles()->set_name("p2");
+        return response;
+      })
+      .WillOnce([](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        return Status(StatusCode::kAborted, "bad-luck");
+      });
+
+  PrefetchedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) {
+      EXPECT_EQ(StatusCode::kAborted, p.status().code());
+      EXPECT_THAT(p.status().message(), HasSubstr("bad-luck"));
+      break;
+    }
+    names.push_back(p->name());
+  }
+  EXPECT_THAT(names, ElementsAre("p1", "p2"));
+}
+
+TEST(PrefetchingRangeFromPagination, ReturnedByValue) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_))
+      .WillOnce([](Request const& request) {
+        EXPECT_TRUE(request.page_token().empty());
+        Response response;
+        response.set_next_page_token("t1");
+        response.add_app_profiles()->set_name("p1");
+        return response;
+      })
+      .WillOnce([](Request const& request) {
+        EXPECT_EQ("t1", request.page_token());
+        Response response;
+        response.clear_next_page_token();
+        response.add_app_profiles()->set_name("p2");
+        return response;
+      });
+
+  // The range must survive being returned by value, as the `List*()` member
+  // functions in the client libraries do.
+  auto factory = [&] {
+    return PrefetchedRange(
+        Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+  };
+  auto range = factory();
+  std::vector<std::string> names;
+  for (auto& p : range) {
+    if (!p) break;
+    names.push_back(p->name());
+  }
+  EXPECT_THAT(names, ElementsAre("p1", "p2"));
+}
+
+TEST(PrefetchingRangeFromPagination, AbandonedBeforeConsumption) {
+  MockRpc mock;
+  EXPECT_CALL(mock, Loader(_)).WillOnce([](Request const& request) {
+    EXPECT_TRUE(request.page_token().empty());
+    Response response;
+    response.clear_next_page_token();
+    response.add_app_profiles()->set_name("p1");
+    return response;
+  });
+
+  // The destructor must stop the background thread even if the application
+  // never iterates over the range.
+  PrefetchedRange range(
+      Request{}, [&](Request const& r) { return mock.Loader(r); }, GetItems);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace GOOGLE_CLOUD_CPP_NS
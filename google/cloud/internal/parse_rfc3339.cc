@@ -16,9 +16,7 @@
 #include "google/cloud/internal/throw_delegate.h"
 #include <array>
 #include <cctype>
-#include <cstdio>
-#include <iomanip>
-#include <iostream>
+#include <cstdint>
 #include <sstream>
 
 namespace {
@@ -42,24 +40,55 @@ auto constexpr kMinutesInHour =
 auto constexpr kSecondsInMinute =
     std::chrono::seconds(std::chrono::minutes(1)).count();
 
-#include "google/cloud/internal/disable_msvc_crt_secure_warnings.inc"
+bool IsDigit(char ch) {
+  return std::isdigit(static_cast<unsigned char>(ch)) != 0;
+}
+
+// Parses exactly @p width decimal digits, advancing @p buffer past them.
+// Returns false (leaving @p buffer unspecified) unless there are exactly
+// @p width consecutive digits.
+bool ParseFixedDigits(char const*& buffer, int width, int& value) {
+  value = 0;
+  for (int i = 0; i != width; ++i) {
+    if (!IsDigit(buffer[i])) return false;
+    value = value * 10 + (buffer[i] - '0');
+  }
+  if (IsDigit(buffer[width])) return false;
+  buffer += width;
+  return true;
+}
+
+// Returns the number of days between 1970-01-01 and year/month/day in the
+// proleptic Gregorian calendar, using the algorithm from
+// http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+std::int64_t DaysFromCivil(std::int64_t year, int month, int day) {
+  year -= month <= 2;
+  std::int64_t const era = (year >= 0 ? year : year - 399) / 400;
+  std::int64_t const yoe = year - era * 400;
+  std::int64_t const doy =
+      (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  std::int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
 std::chrono::system_clock::time_point ParseDateTime(
     char const*& buffer, std::string const& timestamp) {
-  // Use std::mktime to compute the number of seconds because RFC 3339 requires
-  // working with civil time, including the annoying leap seconds, and mktime
-  // does.
-  int year, month, day;  // NOLINT(readability-isolate-declaration)
-  char date_time_separator;
+  // RFC 3339 requires working with civil time, so convert the broken-down
+  // fields to a count of seconds using calendar arithmetic. This avoids any
+  // locale or timezone machinery (and their allocations and locks).
+  int year, month, day;         // NOLINT(readability-isolate-declaration)
   int hours, minutes, seconds;  // NOLINT(readability-isolate-declaration)
 
-  int pos;
-  auto count =
-      std::sscanf(buffer, "%4d-%2d-%2d%c%2d:%2d:%2d%n", &year, &month, &day,
-                  &date_time_separator, &hours, &minutes, &seconds, &pos);
-  // All the fields up to this point have fixed width, so total width must be:
-  auto constexpr kExpectedWidth = 19;
-  auto constexpr kExpectedFields = 7;
-  if (count != kExpectedFields || pos != kExpectedWidth) {
+  char const* p = buffer;
+  bool parsed_date = ParseFixedDigits(p, 4, year) && *p++ == '-' &&
+                     ParseFixedDigits(p, 2, month) && *p++ == '-' &&
+                     ParseFixedDigits(p, 2, day);
+  char const date_time_separator = parsed_date ? *p++ : '\0';
+  bool parsed_time = parsed_date && date_time_separator != '\0' &&
+                     ParseFixedDigits(p, 2, hours) && *p++ == ':' &&
+                     ParseFixedDigits(p, 2, minutes) && *p++ == ':' &&
+                     ParseFixedDigits(p, 2, seconds);
+  if (!parsed_time) {
     ReportError(timestamp,
                 "Invalid format for RFC 3339 timestamp detected while parsing"
                 " the base date and time portion.");
@@ -83,7 +112,6 @@ std::chrono::system_clock::time_point ParseDateTime(
       30,  // November
       31,  // December
   }};
-  auto constexpr kMkTimeBaseYear = 1900;
   if (month < 1 || month > kMonthsInYear) {
     ReportError(timestamp, "Out of range month.");
   }
@@ -108,17 +136,15 @@ std::chrono::system_clock::time_point ParseDateTime(
     ReportError(timestamp, "Out of range second.");
   }
   // Advance the pointer for all the characters read.
-  buffer += pos;
-
-  std::tm tm{};
-  tm.tm_year = year - kMkTimeBaseYear;
-  tm.tm_mon = month - 1;
-  tm.tm_mday = day;
-  tm.tm_hour = hours;
-  tm.tm_min = minutes;
-  tm.tm_sec = seconds;
-  tm.tm_isdst = 0;  // Force use of the "standard" UTC offset.
-  return std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  buffer = p;
+
+  auto constexpr kSecondsInHour = 3600;
+  auto const count =
+      DaysFromCivil(year, month, day) * kHoursInDay * kSecondsInHour +
+      hours * kSecondsInHour + minutes * kSecondsInMinute + seconds;
+  return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::seconds(count)));
 }
 
 std::chrono::system_clock::duration ParseFractionalSeconds(
@@ -128,22 +154,26 @@ std::chrono::system_clock::duration ParseFractionalSeconds(
   }
   ++buffer;
 
-  long fractional_seconds;  // NOLINT(google-runtime-int)
-  int pos;
-  auto count = std::sscanf(buffer, "%9ld%n", &fractional_seconds, &pos);
-  if (count != 1) {
+  if (!IsDigit(buffer[0])) {
     ReportError(timestamp, "Invalid fractional seconds component.");
   }
   auto constexpr kMaxNanosecondDigits = 9;
   auto constexpr kNanosecondsBase = 10;
   // Normalize the fractional seconds to nanoseconds.
-  for (int digits = pos; digits < kMaxNanosecondDigits; ++digits) {
+  long fractional_seconds = 0;  // NOLINT(google-runtime-int)
+  int digits = 0;
+  while (digits != kMaxNanosecondDigits && IsDigit(buffer[0])) {
+    fractional_seconds =
+        fractional_seconds * kNanosecondsBase + (buffer[0] - '0');
+    ++buffer;
+    ++digits;
+  }
+  for (; digits != kMaxNanosecondDigits; ++digits) {
     fractional_seconds *= kNanosecondsBase;
   }
   // Skip any other digits. This loses precision for sub-nanosecond timestamps,
   // but we do not consider this a problem for Internet timestamps.
-  buffer += pos;
-  while (std::isdigit(buffer[0]) != 0) {
+  while (IsDigit(buffer[0])) {
     ++buffer;
   }
   return std::chrono::duration_cast<std::chrono::system_clock::duration>(
@@ -156,11 +186,10 @@ std::chrono::seconds ParseOffset(char const*& buffer,
     bool positive = (buffer[0] == '+');
     ++buffer;
     // Parse the HH:MM offset.
-    int hours, minutes, pos;  // NOLINT(readability-isolate-declaration)
-    auto count = std::sscanf(buffer, "%2d:%2d%n", &hours, &minutes, &pos);
-    auto constexpr kExpectedOffsetWidth = 5;
-    auto constexpr kExpectedOffsetFields = 2;
-    if (count != kExpectedOffsetFields || pos != kExpectedOffsetWidth) {
+    int hours, minutes;  // NOLINT(readability-isolate-declaration)
+    char const* p = buffer;
+    if (!ParseFixedDigits(p, 2, hours) || *p++ != ':' ||
+        !ParseFixedDigits(p, 2, minutes)) {
       ReportError(timestamp, "Invalid timezone offset, expected [+-]HH:MM.");
     }
     if (hours < 0 || hours >= kHoursInDay) {
@@ -169,7 +198,7 @@ std::chrono::seconds ParseOffset(char const*& buffer,
     if (minutes < 0 || minutes >= kMinutesInHour) {
       ReportError(timestamp, "Out of range offset minute.");
     }
-    buffer += pos;
+    buffer = p;
     using std::chrono::duration_cast;
     if (positive) {
       return duration_cast<std::chrono::seconds>(std::chrono::hours(hours) +
@@ -185,7 +214,6 @@ std::chrono::seconds ParseOffset(char const*& buffer,
   return std::chrono::seconds(0);
 }
 
-#include "google/cloud/internal/diagnostics_pop.inc"
 }  // anonymous namespace
 
 namespace google {
@@ -194,25 +222,6 @@ inline namespace GOOGLE_CLOUD_CPP_NS {
 namespace internal {
 std::chrono::system_clock::time_point ParseRfc3339(
     std::string const& timestamp) {
-  // TODO(#530) - dynamically change the timezone offset.
-  // Because this computation is a bit expensive, assume the timezone offset
-  // does not change during the lifetime of the program.  This function takes
-  // the current time, converts to UTC and then convert back to a time_t.  The
-  // difference is the offset.
-  static std::chrono::seconds const kLocalTimeOffset = []() {
-    auto now = std::time(nullptr);
-    std::tm lcl;
-    // The standard C++ function to convert time_t to a struct tm is not thread
-    // safe (it holds global storage), use some OS specific stuff here:
-#if _WIN32
-    gmtime_s(&lcl, &now);
-#else
-    gmtime_r(&now, &lcl);
-#endif                 // _WIN32
-    lcl.tm_isdst = 0;  // Force use of the "standard" UTC offset.
-    return std::chrono::seconds(mktime(&lcl) - now);
-  }();
-
   char const* buffer = timestamp.c_str();
   auto time_point = ParseDateTime(buffer, timestamp);
   auto fractional_seconds = ParseFractionalSeconds(buffer, timestamp);
@@ -224,7 +233,6 @@ std::chrono::system_clock::time_point ParseRfc3339(
 
   time_point += fractional_seconds;
   time_point -= offset;
-  time_point -= kLocalTimeOffset;
   return time_point;
 }
 
@@ -0,0 +1,73 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/parse_rfc3339.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace internal {
+namespace {
+
+// These functions run for every object in a storage listing and every
+// timestamp field decoded from a response, so their per-call cost matters.
+// The benchmarks guard against regressions, e.g., reintroducing iostreams or
+// locale-dependent APIs in the implementation.
+//
+// Run on (1 X 2100 MHz CPU )
+// CPU Caches:
+//   L1 Data 48 KiB (x1)
+//   L1 Instruction 32 KiB (x1)
+//   L2 Unified 2048 KiB (x1)
+//   L3 Unified 307200 KiB (x1)
+// Load Average: 0.40, 0.38, 0.31
+// --------------------------------------------------------------------
+// Benchmark                          Time             CPU   Iterations
+// --------------------------------------------------------------------
+// BM_ParseRfc3339                 38.1 ns         37.0 ns     23657867
+// BM_ParseRfc3339WithOffset       34.9 ns         33.5 ns     22139115
+// BM_FormatRfc3339                99.8 ns         96.4 ns      9397930
+
+void BM_ParseRfc3339(benchmark::State& state) {
+  std::string const timestamp = "2020-07-08T12:34:56.789123456Z";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(timestamp));
+  }
+}
+BENCHMARK(BM_ParseRfc3339);
+
+void BM_ParseRfc3339WithOffset(benchmark::State& state) {
+  std::string const timestamp = "2020-07-08T12:34:56.789123456-04:00";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ParseRfc3339(timestamp));
+  }
+}
+BENCHMARK(BM_ParseRfc3339WithOffset);
+
+void BM_FormatRfc3339(benchmark::State& state) {
+  auto const tp = ParseRfc3339("2020-07-08T12:34:56.789123456Z");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FormatRfc3339(tp));
+  }
+}
+BENCHMARK(BM_FormatRfc3339);
+
+}  // namespace
+}  // namespace internal
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
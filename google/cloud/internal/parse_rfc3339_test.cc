@@ -76,6 +76,15 @@ TEST(ParseRfc3339Test, ParseSimpleZulu) {
   }
 }
 
+TEST(ParseRfc3339Test, ParsePreEpoch) {
+  auto timestamp = ParseRfc3339("1969-12-31T23:59:59Z");
+  EXPECT_EQ(-1, duration_cast<seconds>(timestamp.time_since_epoch()).count());
+  timestamp = ParseRfc3339("1969-07-20T20:17:40Z");
+  // Use `date -u +%s --date='1969-07-20T20:17:40Z'` to get the magic value:
+  EXPECT_EQ(-14182940L,
+            duration_cast<seconds>(timestamp.time_since_epoch()).count());
+}
+
 TEST(ParseRfc3339Test, ParseAlternativeSeparators) {
   auto timestamp = ParseRfc3339("2018-05-18t14:42:03z");
   // Use `date -u +%s --date='2018-05-18T14:42:03'` to get the magic value:
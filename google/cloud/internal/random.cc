@@ -80,6 +80,11 @@ std::vector<unsigned int> FetchEntropy(std::size_t desired_bits) {
   return entropy;
 }
 
+DefaultPRNG& ThreadLocalPRNG() {
+  thread_local DefaultPRNG generator = MakeDefaultPRNG();
+  return generator;
+}
+
 std::string Sample(DefaultPRNG& gen, int n, std::string const& population) {
   std::uniform_int_distribution<std::size_t> rd(0, population.size() - 1);
 
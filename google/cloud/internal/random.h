@@ -56,6 +56,18 @@ Generator MakePRNG() {
 /// Create a new PRNG.
 inline DefaultPRNG MakeDefaultPRNG() { return MakePRNG<DefaultPRNG>(); }
 
+/**
+ * Returns a PRNG seeded once and then shared by all callers in the thread.
+ *
+ * Seeding a `DefaultPRNG` draws hundreds of bytes from `std::random_device`,
+ * which is far too expensive for callers that only need a few bits of
+ * non-cryptographic randomness, such as the jitter in a retry backoff.
+ * Sharing one generator per thread amortizes the seeding cost over the
+ * lifetime of the thread, without the locking that a process-wide generator
+ * would require.
+ */
+DefaultPRNG& ThreadLocalPRNG();
+
 /**
  * Take @p n samples out of @p population, using the @p gen PRNG.
  *
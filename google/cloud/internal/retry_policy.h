@@ -58,6 +58,18 @@ class RetryPolicy {
   }
   virtual bool IsExhausted() const = 0;
 
+  /**
+   * The time when the policy expires.
+   *
+   * Policies that are not time based return `time_point::max()`. Retry loops
+   * can use this value as the overall deadline for the operation, e.g., to
+   * bound the time spent in each attempt, or to skip a final attempt that
+   * would start with no time left to succeed.
+   */
+  virtual std::chrono::system_clock::time_point deadline() const {
+    return (std::chrono::system_clock::time_point::max)();
+  }
+
  protected:
   virtual void OnFailureImpl() = 0;
 };
@@ -148,7 +160,9 @@ class LimitedTimeRetryPolicy : public RetryPolicy<StatusType, RetryablePolicy> {
     return std::chrono::system_clock::now() >= deadline_;
   }
 
-  std::chrono::system_clock::time_point deadline() const { return deadline_; }
+  std::chrono::system_clock::time_point deadline() const override {
+    return deadline_;
+  }
 
  protected:
   void OnFailureImpl() override {}
@@ -66,6 +66,22 @@
  * Note that while `std::clog` is buffered, the framework will flush any log
  * message at severity `WARNING` or higher.
  *
+ * @par Example: Compile Out Low Severity Logs
+ * Log statements below a compile-time minimum severity compile to nothing,
+ * their streamed operands are never evaluated, and the compiler can remove
+ * the whole statement. Define the minimum severity when compiling, for
+ * example:
+ *
+ * @code
+ * -DGOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY_ENABLED=GCP_LS_INFO
+ * @endcode
+ *
+ * compiles out all `GCP_LOG(TRACE)` and `GCP_LOG(DEBUG)` statements, while
+ * `GCP_LOG(INFO)` and above remain runtime-configurable as usual. CMake
+ * builds can set `-DGOOGLE_CLOUD_CPP_LOGGING_MIN_SEVERITY=INFO` instead,
+ * which propagates the definition to all the libraries. The definition must
+ * be consistent across all the translation units of a program.
+ *
  * @par Example: Capture Logs
  * The application can implement simple backends by wrapping a functor:
  *
@@ -0,0 +1,104 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/benchmark_utils.h"
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+namespace benchmarks {
+namespace {
+
+std::string Basename(std::string const& path) {
+  auto last_sep = path.find_last_of("/\\");
+  if (last_sep == std::string::npos) return path;
+  return path.substr(last_sep + 1);
+}
+
+}  // namespace
+
+std::string BuildUsage(std::vector<OptionDescriptor> const& desc,
+                       std::string const& command_path) {
+  std::ostringstream os;
+  os << "Usage: " << Basename(command_path) << " [options]\n";
+  for (auto const& d : desc) {
+    os << "    " << d.option << ": " << d.help << "\n";
+  }
+  return std::move(os).str();
+}
+
+std::vector<std::string> OptionsParse(std::vector<OptionDescriptor> const& desc,
+                                      std::vector<std::string> argv) {
+  if (argv.empty()) {
+    return argv;
+  }
+
+  auto next_arg = argv.begin() + 1;
+  while (next_arg != argv.end()) {
+    std::string const& argument = *next_arg;
+
+    // Try to match `argument` against the options in `desc`
+    bool matched = false;
+    for (auto const& d : desc) {
+      if (argument.rfind(d.option, 0) != 0) {
+        // Not a match, keep searching.
+        continue;
+      }
+      std::string val = argument.substr(d.option.size());
+      if (!val.empty() && val[0] != '=') {
+        // Matched a prefix of an option, keep searching.
+        continue;
+      }
+      if (!val.empty()) {
+        // The first character must be '=', remove it too.
+        val.erase(val.begin());
+      }
+      d.parser(val);
+      // This is a match, consume the argument and stop the search.
+      matched = true;
+      break;
+    }
+    // If next_arg is matched against any option erase it, otherwise skip it.
+    next_arg = matched ? argv.erase(next_arg) : next_arg + 1;
+  }
+  return argv;
+}
+
+std::string MakeRandomData(google::cloud::internal::DefaultPRNG& generator,
+                           std::size_t size) {
+  return google::cloud::internal::Sample(
+      generator, static_cast<int>(size),
+      "abcdefghijklmnopqrstuvwxyz"
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+      "0123456789");
+}
+
+std::string RandomTopicId(google::cloud::internal::DefaultPRNG& generator) {
+  return "cloud-cpp-benchmark-topic-" +
+         google::cloud::internal::Sample(
+             generator, 32, "abcdefghijklmnopqrstuvwxyz0123456789");
+}
+
+std::string RandomSubscriptionId(
+    google::cloud::internal::DefaultPRNG& generator) {
+  return "cloud-cpp-benchmark-subscription-" +
+         google::cloud::internal::Sample(
+             generator, 32, "abcdefghijklmnopqrstuvwxyz0123456789");
+}
+
+}  // namespace benchmarks
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
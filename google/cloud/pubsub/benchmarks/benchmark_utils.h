@@ -0,0 +1,67 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_BENCHMARK_UTILS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_BENCHMARK_UTILS_H
+
+#include "google/cloud/internal/random.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+namespace benchmarks {
+
+constexpr std::int64_t kKiB = 1024;
+constexpr std::int64_t kMiB = 1024 * kKiB;
+
+/// Defines a command-line option.
+struct OptionDescriptor {
+  using OptionParser = std::function<void(std::string const&)>;
+
+  std::string option;
+  std::string help;
+  OptionParser parser;
+};
+
+/// Build the `Usage` string from a list of command-line option descriptions.
+std::string BuildUsage(std::vector<OptionDescriptor> const& desc,
+                       std::string const& command_path);
+
+/**
+ * Parse @p argv using the descriptions in @p desc, return unparsed arguments.
+ */
+std::vector<std::string> OptionsParse(std::vector<OptionDescriptor> const& desc,
+                                      std::vector<std::string> argv);
+
+/// Create a random message payload of @p size bytes.
+std::string MakeRandomData(google::cloud::internal::DefaultPRNG& generator,
+                           std::size_t size);
+
+/// Create a random topic ID for a benchmark run.
+std::string RandomTopicId(google::cloud::internal::DefaultPRNG& generator);
+
+/// Create a random subscription ID for a benchmark run.
+std::string RandomSubscriptionId(
+    google::cloud::internal::DefaultPRNG& generator);
+
+}  // namespace benchmarks
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_BENCHMARKS_BENCHMARK_UTILS_H
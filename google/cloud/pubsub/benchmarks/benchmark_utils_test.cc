@@ -0,0 +1,84 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/benchmark_utils.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+namespace benchmarks {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(BenchmarkUtilsTest, OptionsParseMatches) {
+  std::string project_id;
+  std::string topic_id;
+  std::vector<OptionDescriptor> descriptors{
+      {"--project-id", "the project",
+       [&project_id](std::string const& v) { project_id = v; }},
+      {"--topic-id", "the topic",
+       [&topic_id](std::string const& v) { topic_id = v; }},
+  };
+  auto unparsed = OptionsParse(
+      descriptors, {"self-test", "--project-id=p1", "--topic-id=t1", "extra"});
+  EXPECT_EQ("p1", project_id);
+  EXPECT_EQ("t1", topic_id);
+  EXPECT_THAT(unparsed, ElementsAre("self-test", "extra"));
+}
+
+TEST(BenchmarkUtilsTest, OptionsParsePrefixIsNotAMatch) {
+  std::string topic_id = "unset";
+  std::vector<OptionDescriptor> descriptors{
+      {"--topic-id", "the topic",
+       [&topic_id](std::string const& v) { topic_id = v; }},
+  };
+  auto unparsed =
+      OptionsParse(descriptors, {"self-test", "--topic-id-suffix=t1"});
+  EXPECT_EQ("unset", topic_id);
+  EXPECT_THAT(unparsed, ElementsAre("self-test", "--topic-id-suffix=t1"));
+}
+
+TEST(BenchmarkUtilsTest, BuildUsage) {
+  std::vector<OptionDescriptor> descriptors{
+      {"--option-name", "the help text", [](std::string const&) {}},
+  };
+  auto usage = BuildUsage(descriptors, "/some/path/program");
+  EXPECT_THAT(usage, ::testing::HasSubstr("program"));
+  EXPECT_THAT(usage, ::testing::HasSubstr("--option-name"));
+  EXPECT_THAT(usage, ::testing::HasSubstr("the help text"));
+}
+
+TEST(BenchmarkUtilsTest, MakeRandomData) {
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto const data = MakeRandomData(generator, 128);
+  EXPECT_EQ(128U, data.size());
+}
+
+TEST(BenchmarkUtilsTest, RandomIds) {
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto const t0 = RandomTopicId(generator);
+  auto const t1 = RandomTopicId(generator);
+  EXPECT_NE(t0, t1);
+  auto const s0 = RandomSubscriptionId(generator);
+  auto const s1 = RandomSubscriptionId(generator);
+  EXPECT_NE(s0, s1);
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
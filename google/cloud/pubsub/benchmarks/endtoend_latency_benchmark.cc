@@ -0,0 +1,249 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/benchmark_utils.h"
+#include "google/cloud/pubsub/benchmarks/latency_histogram.h"
+#include "google/cloud/pubsub/publisher.h"
+#include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsub/subscription_admin_client.h"
+#include "google/cloud/pubsub/topic_admin_client.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+namespace pubsub = google::cloud::pubsub;
+using google::cloud::future;
+using google::cloud::promise;
+using google::cloud::StatusOr;
+using google::cloud::pubsub::benchmarks::LatencyHistogram;
+
+char const kDescription[] = R"""(
+Measure the end-to-end latency of the Cloud Pub/Sub C++ client library.
+
+The program creates a temporary topic and subscription in the same process,
+publishes messages at a fixed (configurable) rate, and measures the elapsed
+time from the `Publish()` call to the delivery of the message to the
+subscriber callback. The latencies are reported as a distribution, because
+tail latencies matter more than averages for this kind of measurement.
+
+Because publisher and subscriber share a clock the measurement does not
+suffer from clock skew. The publish timestamp travels with each message as
+an attribute.
+
+The benchmark runs against the production environment by default; set
+PUBSUB_EMULATOR_HOST to run it against the Cloud Pub/Sub emulator.
+)""";
+
+auto constexpr kTimestampAttribute = "bm-publish-timestamp";
+
+struct Options {
+  std::string project_id;
+  std::int64_t message_count = 1000;
+  std::int64_t message_size = 1024;
+  std::chrono::microseconds publish_interval{10000};
+  bool streaming_pull = false;
+};
+
+StatusOr<Options> ParseArgs(int argc, char* argv[]);
+
+std::string CurrentTimestamp() {
+  auto const now = std::chrono::steady_clock::now().time_since_epoch();
+  auto const us = std::chrono::duration_cast<std::chrono::microseconds>(now);
+  return std::to_string(us.count());
+}
+
+std::chrono::microseconds SinceTimestamp(std::string const& timestamp) {
+  auto const now = std::chrono::steady_clock::now().time_since_epoch();
+  auto const us = std::chrono::duration_cast<std::chrono::microseconds>(now);
+  return us - std::chrono::microseconds(std::stoll(timestamp));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  pubsub::Topic const topic(options->project_id,
+                            pubsub::benchmarks::RandomTopicId(generator));
+  pubsub::Subscription const subscription(
+      options->project_id,
+      pubsub::benchmarks::RandomSubscriptionId(generator));
+
+  auto topic_admin =
+      pubsub::TopicAdminClient(pubsub::MakeTopicAdminConnection());
+  auto subscription_admin = pubsub::SubscriptionAdminClient(
+      pubsub::MakeSubscriptionAdminConnection());
+
+  auto topic_metadata =
+      topic_admin.CreateTopic(pubsub::TopicMutationBuilder(topic));
+  if (!topic_metadata) {
+    std::cerr << "Error creating topic " << topic << ": "
+              << topic_metadata.status() << "\n";
+    return 1;
+  }
+  auto subscription_metadata = subscription_admin.CreateSubscription(
+      topic, subscription,
+      pubsub::SubscriptionMutationBuilder{}.set_ack_deadline(
+          std::chrono::seconds(30)));
+  if (!subscription_metadata) {
+    std::cerr << "Error creating subscription " << subscription << ": "
+              << subscription_metadata.status() << "\n";
+    (void)topic_admin.DeleteTopic(topic);
+    return 1;
+  }
+  std::cout << "# Running test on topic: " << topic.FullName()
+            << "\n# Subscription: " << subscription.FullName() << "\n";
+
+  std::mutex mu;
+  LatencyHistogram histogram;
+  std::int64_t received_count = 0;
+  promise<void> all_received;
+
+  auto callback = [&](pubsub::Message m, pubsub::AckHandler h) {
+    auto const attributes = m.attributes();
+    auto const ts = attributes.find(kTimestampAttribute);
+    if (ts != attributes.end()) {
+      auto const latency = SinceTimestamp(ts->second);
+      std::unique_lock<std::mutex> lk(mu);
+      histogram.Record(latency);
+      if (++received_count == options->message_count) {
+        lk.unlock();
+        all_received.set_value();
+      }
+    }
+    std::move(h).ack();
+  };
+  pubsub::SubscriptionOptions subscription_options;
+  if (options->streaming_pull) {
+    subscription_options.enable_streaming_pull();
+  }
+  auto connection = pubsub::MakeSubscriberConnection();
+  auto session = connection->Subscribe(
+      {subscription.FullName(), callback, subscription_options});
+
+  auto publisher =
+      pubsub::Publisher(pubsub::MakePublisherConnection(topic, {}));
+  auto const payload = pubsub::benchmarks::MakeRandomData(
+      generator, static_cast<std::size_t>(options->message_size));
+
+  std::int64_t publish_errors = 0;
+  for (std::int64_t i = 0; i != options->message_count; ++i) {
+    auto response = publisher
+                        .Publish(pubsub::MessageBuilder{}
+                                     .SetData(payload)
+                                     .InsertAttribute(kTimestampAttribute,
+                                                      CurrentTimestamp())
+                                     .Build())
+                        .get();
+    if (!response) {
+      ++publish_errors;
+      std::lock_guard<std::mutex> lk(mu);
+      // Count undeliverable messages as received or the benchmark hangs.
+      if (++received_count == options->message_count) {
+        all_received.set_value();
+      }
+    }
+    std::this_thread::sleep_for(options->publish_interval);
+  }
+
+  all_received.get_future().get();
+  session.cancel();
+  (void)session.get();
+
+  auto delete_subscription =
+      subscription_admin.DeleteSubscription(subscription);
+  if (!delete_subscription.ok()) {
+    std::cerr << "# Error deleting subscription " << subscription << ": "
+              << delete_subscription << "\n";
+  }
+  auto delete_topic = topic_admin.DeleteTopic(topic);
+  if (!delete_topic.ok()) {
+    std::cerr << "# Error deleting topic " << topic << ": " << delete_topic
+              << "\n";
+  }
+
+  std::cout << "# Publish errors: " << publish_errors
+            << "\nEnd-to-end latency: " << histogram << "\n";
+  return publish_errors == 0 ? 0 : 1;
+}
+
+namespace {
+
+StatusOr<Options> ParseArgs(int argc, char* argv[]) {
+  Options options;
+  options.project_id =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_PROJECT").value_or("");
+
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<pubsub::benchmarks::OptionDescriptor> descriptors{
+      {"--help", "print the usage message",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print a description of the benchmark",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--project-id", "the GCP project to create the topic in",
+       [&options](std::string const& val) { options.project_id = val; }},
+      {"--message-count", "the number of messages to publish",
+       [&options](std::string const& val) {
+         options.message_count = std::stoll(val);
+       }},
+      {"--message-size", "the size of each message in bytes",
+       [&options](std::string const& val) {
+         options.message_size = std::stoll(val);
+       }},
+      {"--publish-interval",
+       "the time between Publish() calls in microseconds",
+       [&options](std::string const& val) {
+         options.publish_interval = std::chrono::microseconds(std::stoll(val));
+       }},
+      {"--streaming-pull", "use StreamingPull to receive messages",
+       [&options](std::string const&) { options.streaming_pull = true; }},
+  };
+  auto usage = pubsub::benchmarks::BuildUsage(descriptors, argv[0]);
+
+  std::vector<std::string> argv_copy{argv, argv + argc};
+  auto unparsed = pubsub::benchmarks::OptionsParse(descriptors, argv_copy);
+  if (wants_help) {
+    std::cout << usage << "\n";
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+  }
+  if (unparsed.size() != 1) {
+    std::ostringstream os;
+    os << "Unknown arguments or options\n" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (options.project_id.empty()) {
+    std::ostringstream os;
+    os << "Missing --project-id option (or GOOGLE_CLOUD_PROJECT environment"
+       << " variable)\n"
+       << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  return options;
+}
+
+}  // namespace
@@ -0,0 +1,90 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/latency_histogram.h"
+#include <gmock/gmock.h>
+#include <cmath>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub {
+namespace benchmarks {
+namespace {
+
+/// @test Small values are stored exactly, and the percentile convention
+/// matches the sorted-sample reports.
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  for (int i = 0; i != 16; ++i) {
+    histogram.Record(std::chrono::microseconds(i));
+  }
+  EXPECT_EQ(16U, histogram.count());
+  EXPECT_EQ(0, histogram.min().count());
+  EXPECT_EQ(15, histogram.max().count());
+  // rank = round((16 - 1) * p / 100), the value at each rank is the rank.
+  EXPECT_EQ(0, histogram.Percentile(0).count());
+  EXPECT_EQ(8, histogram.Percentile(50).count());
+  EXPECT_EQ(14, histogram.Percentile(90).count());
+  EXPECT_EQ(15, histogram.Percentile(100).count());
+}
+
+/// @test Percentiles stay within the documented error bound of the values a
+/// full sort would have produced.
+TEST(LatencyHistogramTest, PercentilesAreClose) {
+  // Use a (sorted) set of samples spanning several powers of two.
+  std::vector<std::int64_t> samples;
+  for (int i = 1; i <= 1000; ++i) {
+    samples.push_back(i * 37);
+  }
+  LatencyHistogram histogram;
+  for (auto s : samples) {
+    histogram.Record(std::chrono::microseconds(s));
+  }
+  EXPECT_EQ(samples.size(), histogram.count());
+  EXPECT_EQ(samples.front(), histogram.min().count());
+  EXPECT_EQ(samples.back(), histogram.max().count());
+  for (double p : {50.0, 90.0, 95.0, 99.0, 99.9}) {
+    auto rank = static_cast<std::size_t>(
+        std::round(static_cast<double>(samples.size() - 1) * p / 100.0));
+    auto const expected = static_cast<double>(samples[rank]);
+    auto const actual = static_cast<double>(histogram.Percentile(p).count());
+    // Each power of two has 16 sub-buckets, so the midpoint of a bucket is
+    // within 1/16th of any value in that bucket.
+    EXPECT_NEAR(expected, actual, expected / 16) << "p=" << p;
+  }
+}
+
+/// @test Merging histograms combines counts and exact bounds.
+TEST(LatencyHistogramTest, Merge) {
+  LatencyHistogram a;
+  a.Record(std::chrono::microseconds(10));
+  a.Record(std::chrono::microseconds(12));
+
+  LatencyHistogram b;
+  b.Record(std::chrono::microseconds(5000));
+
+  a.Merge(b);
+  EXPECT_EQ(3U, a.count());
+  EXPECT_EQ(10, a.min().count());
+  EXPECT_EQ(5000, a.max().count());
+  EXPECT_EQ(10, a.Percentile(0).count());
+  EXPECT_EQ(5000, a.Percentile(100).count());
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace pubsub
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,215 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/benchmark_utils.h"
+#include "google/cloud/pubsub/benchmarks/latency_histogram.h"
+#include "google/cloud/pubsub/publisher.h"
+#include "google/cloud/pubsub/topic_admin_client.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+namespace {
+namespace pubsub = google::cloud::pubsub;
+using google::cloud::future;
+using google::cloud::StatusOr;
+using google::cloud::pubsub::benchmarks::LatencyHistogram;
+
+char const kDescription[] = R"""(
+Measure the publisher throughput of the Cloud Pub/Sub C++ client library.
+
+The program creates a temporary topic, publishes a configurable number of
+messages of a configurable size, and reports the sustained message and byte
+rates as well as the publish-to-acknowledgment latency distribution. The
+batching parameters (message count, hold time, pending batches, adaptive
+hold time) are all configurable, so the benchmark can be used to evaluate
+different batching configurations against each other.
+
+The benchmark runs against the production environment by default; set
+PUBSUB_EMULATOR_HOST to run it against the Cloud Pub/Sub emulator.
+)""";
+
+struct Options {
+  std::string project_id;
+  std::int64_t message_count = 100000;
+  std::int64_t message_size = 1024;
+  std::size_t maximum_batch_message_count = 0;
+  std::chrono::milliseconds maximum_hold_time{0};
+  std::size_t maximum_pending_batches = 0;
+  bool adaptive_hold_time = false;
+};
+
+StatusOr<Options> ParseArgs(int argc, char* argv[]);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  pubsub::Topic const topic(
+      options->project_id,
+      pubsub::benchmarks::RandomTopicId(generator));
+
+  auto topic_admin =
+      pubsub::TopicAdminClient(pubsub::MakeTopicAdminConnection());
+  auto topic_metadata =
+      topic_admin.CreateTopic(pubsub::TopicMutationBuilder(topic));
+  if (!topic_metadata) {
+    std::cerr << "Error creating topic " << topic << ": "
+              << topic_metadata.status() << "\n";
+    return 1;
+  }
+  std::cout << "# Running test on topic: " << topic.FullName() << "\n";
+
+  pubsub::BatchingConfig batching;
+  if (options->maximum_batch_message_count != 0) {
+    batching.set_maximum_message_count(options->maximum_batch_message_count);
+  }
+  if (options->maximum_hold_time.count() != 0) {
+    batching.set_maximum_hold_time(options->maximum_hold_time);
+  }
+  if (options->maximum_pending_batches != 0) {
+    batching.set_maximum_pending_batches(options->maximum_pending_batches);
+  }
+  if (options->adaptive_hold_time) {
+    batching.enable_adaptive_hold_time();
+  }
+  auto publisher = pubsub::Publisher(pubsub::MakePublisherConnection(
+      topic, pubsub::PublisherOptions{}.set_batching_config(batching)));
+
+  auto const payload = pubsub::benchmarks::MakeRandomData(
+      generator, static_cast<std::size_t>(options->message_size));
+
+  std::mutex mu;
+  LatencyHistogram histogram;
+  std::atomic<std::int64_t> error_count{0};
+
+  auto const start = std::chrono::steady_clock::now();
+  for (std::int64_t i = 0; i != options->message_count; ++i) {
+    auto const publish_start = std::chrono::steady_clock::now();
+    publisher.Publish(pubsub::MessageBuilder{}.SetData(payload).Build())
+        .then([&, publish_start](future<StatusOr<std::string>> f) {
+          auto const elapsed =
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - publish_start);
+          if (!f.get()) {
+            ++error_count;
+            return;
+          }
+          std::lock_guard<std::mutex> lk(mu);
+          histogram.Record(elapsed);
+        });
+  }
+  publisher.Flush().get();
+  auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+
+  auto delete_status = topic_admin.DeleteTopic(topic);
+  if (!delete_status.ok()) {
+    std::cerr << "# Error deleting topic " << topic << ": " << delete_status
+              << "\n";
+  }
+
+  auto const seconds = static_cast<double>(elapsed.count()) / 1e6;
+  auto const bytes = static_cast<double>(histogram.count()) *
+                     static_cast<double>(options->message_size);
+  std::cout << "# Elapsed: " << elapsed.count() << "us"
+            << "\n# Published: " << histogram.count()
+            << "\n# Errors: " << error_count.load()
+            << "\nThroughput: "
+            << static_cast<double>(histogram.count()) / seconds << " msgs/s, "
+            << bytes / seconds / pubsub::benchmarks::kMiB << " MiB/s"
+            << "\nPublish-to-ack latency: " << histogram << "\n";
+
+  return error_count.load() == 0 ? 0 : 1;
+}
+
+namespace {
+
+StatusOr<Options> ParseArgs(int argc, char* argv[]) {
+  Options options;
+  options.project_id =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_PROJECT").value_or("");
+
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<pubsub::benchmarks::OptionDescriptor> descriptors{
+      {"--help", "print the usage message",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print a description of the benchmark",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--project-id", "the GCP project to create the topic in",
+       [&options](std::string const& val) { options.project_id = val; }},
+      {"--message-count", "the number of messages to publish",
+       [&options](std::string const& val) {
+         options.message_count = std::stoll(val);
+       }},
+      {"--message-size", "the size of each message in bytes",
+       [&options](std::string const& val) {
+         options.message_size = std::stoll(val);
+       }},
+      {"--maximum-batch-message-count",
+       "the maximum number of messages in each batch",
+       [&options](std::string const& val) {
+         options.maximum_batch_message_count = std::stoul(val);
+       }},
+      {"--maximum-hold-time",
+       "the maximum batch hold time in milliseconds",
+       [&options](std::string const& val) {
+         options.maximum_hold_time = std::chrono::milliseconds(std::stoll(val));
+       }},
+      {"--maximum-pending-batches",
+       "the maximum number of batches with outstanding publish RPCs",
+       [&options](std::string const& val) {
+         options.maximum_pending_batches = std::stoul(val);
+       }},
+      {"--adaptive-hold-time", "enable the adaptive batch hold time",
+       [&options](std::string const&) { options.adaptive_hold_time = true; }},
+  };
+  auto usage = pubsub::benchmarks::BuildUsage(descriptors, argv[0]);
+
+  std::vector<std::string> argv_copy{argv, argv + argc};
+  auto unparsed = pubsub::benchmarks::OptionsParse(descriptors, argv_copy);
+  if (wants_help) {
+    std::cout << usage << "\n";
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+  }
+  if (unparsed.size() != 1) {
+    std::ostringstream os;
+    os << "Unknown arguments or options\n" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (options.project_id.empty()) {
+    std::ostringstream os;
+    os << "Missing --project-id option (or GOOGLE_CLOUD_PROJECT environment"
+       << " variable)\n"
+       << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  return options;
+}
+
+}  // namespace
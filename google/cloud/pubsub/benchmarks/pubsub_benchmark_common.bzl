@@ -0,0 +1,27 @@
+# Copyright 2020 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# DO NOT EDIT -- GENERATED BY CMake -- Change the CMakeLists.txt file if needed
+
+"""Automatically generated source lists for pubsub_benchmark_common - DO NOT EDIT."""
+
+pubsub_benchmark_common_hdrs = [
+    "benchmark_utils.h",
+    "latency_histogram.h",
+]
+
+pubsub_benchmark_common_srcs = [
+    "benchmark_utils.cc",
+    "latency_histogram.cc",
+]
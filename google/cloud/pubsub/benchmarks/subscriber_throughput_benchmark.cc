@@ -0,0 +1,239 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/benchmarks/benchmark_utils.h"
+#include "google/cloud/pubsub/publisher.h"
+#include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsub/subscription_admin_client.h"
+#include "google/cloud/pubsub/topic_admin_client.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include <atomic>
+#include <iostream>
+#include <sstream>
+
+namespace {
+namespace pubsub = google::cloud::pubsub;
+using google::cloud::future;
+using google::cloud::promise;
+using google::cloud::StatusOr;
+
+char const kDescription[] = R"""(
+Measure the subscriber throughput of the Cloud Pub/Sub C++ client library.
+
+The program creates a temporary topic and subscription, pre-fills the topic
+with a configurable number of messages of a configurable size, and then
+measures how fast a subscriber can receive and acknowledge them. The
+receive path is configurable: unary Pull() vs. StreamingPull(), the number
+of streams, the callback concurrency, and the flow control limits. This
+makes the benchmark useful to compare the different receive configurations
+against each other.
+
+The benchmark runs against the production environment by default; set
+PUBSUB_EMULATOR_HOST to run it against the Cloud Pub/Sub emulator.
+)""";
+
+struct Options {
+  std::string project_id;
+  std::int64_t message_count = 10000;
+  std::int64_t message_size = 1024;
+  bool streaming_pull = false;
+  std::size_t streams = 1;
+  std::size_t concurrency = 0;
+  std::size_t max_outstanding_messages = 0;
+};
+
+StatusOr<Options> ParseArgs(int argc, char* argv[]);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  auto options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  pubsub::Topic const topic(options->project_id,
+                            pubsub::benchmarks::RandomTopicId(generator));
+  pubsub::Subscription const subscription(
+      options->project_id,
+      pubsub::benchmarks::RandomSubscriptionId(generator));
+
+  auto topic_admin =
+      pubsub::TopicAdminClient(pubsub::MakeTopicAdminConnection());
+  auto subscription_admin = pubsub::SubscriptionAdminClient(
+      pubsub::MakeSubscriptionAdminConnection());
+
+  auto topic_metadata =
+      topic_admin.CreateTopic(pubsub::TopicMutationBuilder(topic));
+  if (!topic_metadata) {
+    std::cerr << "Error creating topic " << topic << ": "
+              << topic_metadata.status() << "\n";
+    return 1;
+  }
+  auto subscription_metadata = subscription_admin.CreateSubscription(
+      topic, subscription,
+      pubsub::SubscriptionMutationBuilder{}.set_ack_deadline(
+          std::chrono::seconds(60)));
+  if (!subscription_metadata) {
+    std::cerr << "Error creating subscription " << subscription << ": "
+              << subscription_metadata.status() << "\n";
+    (void)topic_admin.DeleteTopic(topic);
+    return 1;
+  }
+  std::cout << "# Running test on topic: " << topic.FullName()
+            << "\n# Subscription: " << subscription.FullName() << "\n";
+
+  // Pre-fill the topic, the subscriber measurement starts only after all
+  // the messages are published.
+  auto publisher =
+      pubsub::Publisher(pubsub::MakePublisherConnection(topic, {}));
+  auto const payload = pubsub::benchmarks::MakeRandomData(
+      generator, static_cast<std::size_t>(options->message_size));
+  std::atomic<std::int64_t> publish_errors{0};
+  std::cout << "# Pre-filling the topic ..." << std::flush;
+  for (std::int64_t i = 0; i != options->message_count; ++i) {
+    publisher.Publish(pubsub::MessageBuilder{}.SetData(payload).Build())
+        .then([&publish_errors](future<StatusOr<std::string>> f) {
+          if (!f.get()) ++publish_errors;
+        });
+  }
+  publisher.Flush().get();
+  std::cout << " DONE (errors=" << publish_errors.load() << ")\n";
+
+  auto const expected_count = options->message_count - publish_errors.load();
+  std::atomic<std::int64_t> received_count{0};
+  promise<void> all_received;
+  auto callback = [&](pubsub::Message const&, pubsub::AckHandler h) {
+    std::move(h).ack();
+    // Cloud Pub/Sub has "at least once" semantics, duplicates would push
+    // the count past the expected value, only fire the promise once.
+    if (++received_count == expected_count) all_received.set_value();
+  };
+
+  pubsub::SubscriptionOptions subscription_options;
+  if (options->streaming_pull) {
+    subscription_options.enable_streaming_pull().set_streaming_pull_streams(
+        options->streams);
+  }
+  subscription_options.set_concurrency(options->concurrency);
+  if (options->max_outstanding_messages != 0) {
+    subscription_options.set_max_outstanding_messages(
+        options->max_outstanding_messages);
+  }
+
+  auto const start = std::chrono::steady_clock::now();
+  auto connection = pubsub::MakeSubscriberConnection();
+  auto session = connection->Subscribe(
+      {subscription.FullName(), callback, subscription_options});
+  all_received.get_future().get();
+  auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  session.cancel();
+  (void)session.get();
+
+  auto delete_subscription =
+      subscription_admin.DeleteSubscription(subscription);
+  if (!delete_subscription.ok()) {
+    std::cerr << "# Error deleting subscription " << subscription << ": "
+              << delete_subscription << "\n";
+  }
+  auto delete_topic = topic_admin.DeleteTopic(topic);
+  if (!delete_topic.ok()) {
+    std::cerr << "# Error deleting topic " << topic << ": " << delete_topic
+              << "\n";
+  }
+
+  auto const seconds = static_cast<double>(elapsed.count()) / 1e6;
+  auto const bytes = static_cast<double>(received_count.load()) *
+                     static_cast<double>(options->message_size);
+  std::cout << "# Elapsed: " << elapsed.count() << "us"
+            << "\n# Received: " << received_count.load()
+            << "\nThroughput: "
+            << static_cast<double>(received_count.load()) / seconds
+            << " msgs/s, " << bytes / seconds / pubsub::benchmarks::kMiB
+            << " MiB/s\n";
+  return publish_errors.load() == 0 ? 0 : 1;
+}
+
+namespace {
+
+StatusOr<Options> ParseArgs(int argc, char* argv[]) {
+  Options options;
+  options.project_id =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_PROJECT").value_or("");
+
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<pubsub::benchmarks::OptionDescriptor> descriptors{
+      {"--help", "print the usage message",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print a description of the benchmark",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--project-id", "the GCP project to create the topic in",
+       [&options](std::string const& val) { options.project_id = val; }},
+      {"--message-count", "the number of messages to pre-fill the topic with",
+       [&options](std::string const& val) {
+         options.message_count = std::stoll(val);
+       }},
+      {"--message-size", "the size of each message in bytes",
+       [&options](std::string const& val) {
+         options.message_size = std::stoll(val);
+       }},
+      {"--streaming-pull", "use StreamingPull to receive messages",
+       [&options](std::string const&) { options.streaming_pull = true; }},
+      {"--streams", "the number of parallel streams for StreamingPull",
+       [&options](std::string const& val) {
+         options.streams = std::stoul(val);
+       }},
+      {"--concurrency", "the number of threads running the callback",
+       [&options](std::string const& val) {
+         options.concurrency = std::stoul(val);
+       }},
+      {"--max-outstanding-messages",
+       "the maximum number of messages awaiting delivery",
+       [&options](std::string const& val) {
+         options.max_outstanding_messages = std::stoul(val);
+       }},
+  };
+  auto usage = pubsub::benchmarks::BuildUsage(descriptors, argv[0]);
+
+  std::vector<std::string> argv_copy{argv, argv + argc};
+  auto unparsed = pubsub::benchmarks::OptionsParse(descriptors, argv_copy);
+  if (wants_help) {
+    std::cout << usage << "\n";
+  }
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+  }
+  if (unparsed.size() != 1) {
+    std::ostringstream os;
+    os << "Unknown arguments or options\n" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (options.project_id.empty()) {
+    std::ostringstream os;
+    os << "Missing --project-id option (or GOOGLE_CLOUD_PROJECT environment"
+       << " variable)\n"
+       << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  return options;
+}
+
+}  // namespace
@@ -0,0 +1,100 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_batching_queue.h"
+#include "absl/memory/memory.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+std::size_t constexpr AckBatchingQueue::kMaxAckIdsPerRequest;
+std::chrono::milliseconds constexpr AckBatchingQueue::kMaxHoldTime;
+
+void AckBatchingQueue::Ack(std::string ack_id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  ack_ids_.push_back(std::move(ack_id));
+  MaybeFlush(std::move(lk));
+}
+
+void AckBatchingQueue::Nack(std::string ack_id) {
+  std::unique_lock<std::mutex> lk(mu_);
+  nack_ids_.push_back(std::move(ack_id));
+  MaybeFlush(std::move(lk));
+}
+
+void AckBatchingQueue::Flush() {
+  FlushImpl(std::unique_lock<std::mutex>(mu_));
+}
+
+void AckBatchingQueue::MaybeFlush(std::unique_lock<std::mutex> lk) {
+  if (ack_ids_.size() >= kMaxAckIdsPerRequest ||
+      nack_ids_.size() >= kMaxAckIdsPerRequest) {
+    FlushImpl(std::move(lk));
+    return;
+  }
+  // The hold timer is armed when the first id enters an empty queue, and
+  // disarmed by each flush.
+  if (timer_.valid()) return;
+  auto weak = std::weak_ptr<AckBatchingQueue>(shared_from_this());
+  timer_ = cq_.MakeRelativeTimer(kMaxHoldTime)
+               .then([weak](
+                         future<StatusOr<std::chrono::system_clock::time_point>>
+                             f) {
+                 auto self = weak.lock();
+                 if (!self || !f.get()) return;
+                 self->OnTimer();
+               });
+}
+
+void AckBatchingQueue::FlushImpl(std::unique_lock<std::mutex> lk) {
+  if (timer_.valid()) {
+    timer_.cancel();
+    timer_ = {};
+  }
+  std::vector<std::string> acks;
+  std::vector<std::string> nacks;
+  acks.swap(ack_ids_);
+  nacks.swap(nack_ids_);
+  lk.unlock();
+
+  if (!acks.empty()) {
+    google::pubsub::v1::AcknowledgeRequest request;
+    request.set_subscription(subscription_);
+    for (auto& a : acks) request.add_ack_ids(std::move(a));
+    (void)stub_->AsyncAcknowledge(
+        cq_, absl::make_unique<grpc::ClientContext>(), request);
+  }
+  if (!nacks.empty()) {
+    google::pubsub::v1::ModifyAckDeadlineRequest request;
+    request.set_subscription(subscription_);
+    // A zero-second deadline asks the service to redeliver immediately.
+    request.set_ack_deadline_seconds(0);
+    for (auto& n : nacks) request.add_ack_ids(std::move(n));
+    (void)stub_->AsyncModifyAckDeadline(
+        cq_, absl::make_unique<grpc::ClientContext>(), request);
+  }
+}
+
+void AckBatchingQueue::OnTimer() {
+  std::unique_lock<std::mutex> lk(mu_);
+  timer_ = {};
+  FlushImpl(std::move(lk));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,96 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_BATCHING_QUEUE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_BATCHING_QUEUE_H
+
+#include "google/cloud/pubsub/internal/subscriber_stub.h"
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Aggregate acks and nacks into batched RPCs.
+ *
+ * `Acknowledge()` and `ModifyAckDeadline()` accept many ack ids per
+ * request, but each `AckHandler` completes independently. At high
+ * throughput one RPC per message doubles the request count against the
+ * service and burns CPU marshaling tiny requests. This class collects the
+ * ack ids across callbacks and sends them in batches, bounded by
+ * `kMaxAckIdsPerRequest` and by `kMaxHoldTime`.
+ */
+class AckBatchingQueue : public std::enable_shared_from_this<AckBatchingQueue> {
+ public:
+  /// Flush a batch once it accumulates this many ack ids.
+  static std::size_t constexpr kMaxAckIdsPerRequest = 1000;
+  /// Flush a batch at most this long after its first ack id.
+  static std::chrono::milliseconds constexpr kMaxHoldTime{100};
+
+  /// The constructor is private to prevent accidents with shared_from_this()
+  static std::shared_ptr<AckBatchingQueue> Create(
+      google::cloud::CompletionQueue cq,
+      std::shared_ptr<pubsub_internal::SubscriberStub> stub,
+      std::string subscription) {
+    return std::shared_ptr<AckBatchingQueue>(new AckBatchingQueue(
+        std::move(cq), std::move(stub), std::move(subscription)));
+  }
+
+  /// Queue an ACK for @p ack_id.
+  void Ack(std::string ack_id);
+
+  /// Queue a NACK (a zero-second deadline change) for @p ack_id.
+  void Nack(std::string ack_id);
+
+  /// Send any queued acks and nacks immediately.
+  void Flush();
+
+ private:
+  AckBatchingQueue(google::cloud::CompletionQueue cq,
+                   std::shared_ptr<pubsub_internal::SubscriberStub> stub,
+                   std::string subscription)
+      : cq_(std::move(cq)),
+        stub_(std::move(stub)),
+        subscription_(std::move(subscription)) {}
+
+  /// Flush if the batch is full, otherwise arm the hold timer.
+  void MaybeFlush(std::unique_lock<std::mutex> lk);
+  void FlushImpl(std::unique_lock<std::mutex> lk);
+  void OnTimer();
+
+  google::cloud::CompletionQueue cq_;
+  std::shared_ptr<pubsub_internal::SubscriberStub> stub_;
+  std::string subscription_;
+
+  std::mutex mu_;
+  std::vector<std::string> ack_ids_;
+  std::vector<std::string> nack_ids_;
+  future<void> timer_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_BATCHING_QUEUE_H
@@ -0,0 +1,107 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_batching_queue.h"
+#include "google/cloud/pubsub/testing/mock_subscriber_stub.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::_;
+using ::testing::ElementsAre;
+
+/// @test Verify acks and nacks are aggregated into batched requests.
+TEST(AckBatchingQueueTest, AggregateAcksAndNacks) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::pubsub::v1::AcknowledgeRequest const& request) {
+        EXPECT_EQ("test-subscription", request.subscription());
+        EXPECT_THAT(request.ack_ids(),
+                    ElementsAre("ack-0", "ack-1", "ack-2"));
+        return make_ready_future(Status{});
+      });
+  EXPECT_CALL(*mock, AsyncModifyAckDeadline(_, _, _))
+      .WillOnce(
+          [](google::cloud::CompletionQueue&,
+             std::unique_ptr<grpc::ClientContext>,
+             google::pubsub::v1::ModifyAckDeadlineRequest const& request) {
+            EXPECT_EQ("test-subscription", request.subscription());
+            EXPECT_EQ(0, request.ack_deadline_seconds());
+            EXPECT_THAT(request.ack_ids(), ElementsAre("nack-0", "nack-1"));
+            return make_ready_future(Status{});
+          });
+
+  google::cloud::CompletionQueue cq;
+  auto queue = AckBatchingQueue::Create(cq, mock, "test-subscription");
+  queue->Ack("ack-0");
+  queue->Nack("nack-0");
+  queue->Ack("ack-1");
+  queue->Ack("ack-2");
+  queue->Nack("nack-1");
+  queue->Flush();
+}
+
+/// @test Verify a full batch is flushed without waiting for the hold timer.
+TEST(AckBatchingQueueTest, FlushOnFullBatch) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
+      .WillOnce([](google::cloud::CompletionQueue&,
+                   std::unique_ptr<grpc::ClientContext>,
+                   google::pubsub::v1::AcknowledgeRequest const& request) {
+        EXPECT_EQ(AckBatchingQueue::kMaxAckIdsPerRequest,
+                  static_cast<std::size_t>(request.ack_ids_size()));
+        return make_ready_future(Status{});
+      });
+
+  google::cloud::CompletionQueue cq;
+  auto queue = AckBatchingQueue::Create(cq, mock, "test-subscription");
+  for (std::size_t i = 0; i != AckBatchingQueue::kMaxAckIdsPerRequest; ++i) {
+    queue->Ack("ack-" + std::to_string(i));
+  }
+  // The expectation on the mock verifies the flush already happened, an
+  // explicit `Flush()` would find the queue empty and send nothing.
+  queue->Flush();
+}
+
+/// @test Verify the hold timer flushes a partial batch.
+TEST(AckBatchingQueueTest, FlushOnHoldTimer) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  promise<void> flushed;
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::AcknowledgeRequest const& request) {
+        EXPECT_THAT(request.ack_ids(), ElementsAre("ack-0"));
+        flushed.set_value();
+        return make_ready_future(Status{});
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto queue =
+      AckBatchingQueue::Create(background.cq(), mock, "test-subscription");
+  queue->Ack("ack-0");
+  flushed.get_future().get();
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
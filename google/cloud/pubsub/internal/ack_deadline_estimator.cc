@@ -0,0 +1,58 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+double constexpr AckDeadlineEstimator::kMeanGain;
+double constexpr AckDeadlineEstimator::kDeviationGain;
+double constexpr AckDeadlineEstimator::kDeviationMultiplier;
+
+void AckDeadlineEstimator::RecordProcessingTime(
+    std::chrono::microseconds elapsed) {
+  auto const sample = static_cast<double>(elapsed.count());
+  std::lock_guard<std::mutex> lk(mu_);
+  if (!has_samples_) {
+    mean_us_ = sample;
+    deviation_us_ = sample / 2;
+    has_samples_ = true;
+    return;
+  }
+  auto const error = sample - mean_us_;
+  mean_us_ += kMeanGain * error;
+  deviation_us_ += kDeviationGain * (std::abs(error) - deviation_us_);
+}
+
+std::chrono::seconds AckDeadlineEstimator::estimate() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  // Without samples assume the worst, this matches the historical
+  // behavior of extending to the maximum.
+  if (!has_samples_) return maximum_;
+  auto const predicted_us = mean_us_ + kDeviationMultiplier * deviation_us_;
+  auto const predicted = std::chrono::seconds(
+      static_cast<std::int64_t>(std::ceil(predicted_us / 1000000)));
+  return (std::min)((std::max)(predicted, minimum_), maximum_);
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
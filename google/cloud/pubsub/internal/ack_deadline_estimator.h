@@ -0,0 +1,74 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_DEADLINE_ESTIMATOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_DEADLINE_ESTIMATOR_H
+
+#include "google/cloud/pubsub/version.h"
+#include <chrono>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Estimate how long this subscription takes to process a message.
+ *
+ * The sessions extend the ack deadline of every outstanding message.
+ * Extending to a fixed maximum wastes RPCs and delays the redelivery of
+ * messages stuck in a crashed or hung handler; extending too little
+ * causes duplicate deliveries while the handler is still working.
+ *
+ * This class tracks an exponentially-weighted moving average of the
+ * processing time and of its deviation, in the style of the TCP
+ * retransmission-timeout estimator, and predicts a deadline most
+ * messages complete within. While no samples have been recorded the
+ * estimate is the configured maximum.
+ */
+class AckDeadlineEstimator {
+ public:
+  AckDeadlineEstimator(std::chrono::seconds minimum,
+                       std::chrono::seconds maximum)
+      : minimum_(minimum), maximum_(maximum) {}
+
+  /// The weight of a new sample in the average.
+  static double constexpr kMeanGain = 1.0 / 8;
+  /// The weight of a new sample in the deviation.
+  static double constexpr kDeviationGain = 1.0 / 4;
+  /// How many deviations above the average the estimate sits.
+  static double constexpr kDeviationMultiplier = 4.0;
+
+  /// Record that a message took @p elapsed from receipt to ack or nack.
+  void RecordProcessingTime(std::chrono::microseconds elapsed);
+
+  /// The predicted ack deadline, clamped to `[minimum, maximum]`.
+  std::chrono::seconds estimate() const;
+
+ private:
+  mutable std::mutex mu_;
+  bool has_samples_ = false;
+  double mean_us_ = 0;
+  double deviation_us_ = 0;
+  std::chrono::seconds minimum_;
+  std::chrono::seconds maximum_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ACK_DEADLINE_ESTIMATOR_H
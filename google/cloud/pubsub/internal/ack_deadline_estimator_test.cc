@@ -0,0 +1,70 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using std::chrono::microseconds;
+using std::chrono::seconds;
+
+microseconds AsSample(seconds s) {
+  return std::chrono::duration_cast<microseconds>(s);
+}
+
+TEST(AckDeadlineEstimatorTest, NoSamplesUsesMaximum) {
+  AckDeadlineEstimator estimator(seconds(10), seconds(600));
+  EXPECT_EQ(seconds(600), estimator.estimate());
+}
+
+TEST(AckDeadlineEstimatorTest, ConvergesToObservedProcessingTime) {
+  AckDeadlineEstimator estimator(seconds(10), seconds(600));
+  for (int i = 0; i != 64; ++i) {
+    estimator.RecordProcessingTime(AsSample(seconds(30)));
+  }
+  // With a steady processing time the deviation decays away and the
+  // estimate settles just above the observed time.
+  EXPECT_GE(estimator.estimate(), seconds(30));
+  EXPECT_LE(estimator.estimate(), seconds(45));
+}
+
+TEST(AckDeadlineEstimatorTest, ClampedToMinimum) {
+  AckDeadlineEstimator estimator(seconds(10), seconds(600));
+  for (int i = 0; i != 64; ++i) {
+    estimator.RecordProcessingTime(AsSample(seconds(1)));
+  }
+  EXPECT_EQ(seconds(10), estimator.estimate());
+}
+
+TEST(AckDeadlineEstimatorTest, VariableProcessingTimeAddsSlack) {
+  AckDeadlineEstimator estimator(seconds(10), seconds(600));
+  for (int i = 0; i != 64; ++i) {
+    estimator.RecordProcessingTime(
+        AsSample(seconds(i % 2 == 0 ? 5 : 60)));
+  }
+  // The deviation term keeps the estimate above the slowest samples, so
+  // spiky handlers do not see their messages redelivered mid-flight.
+  EXPECT_GT(estimator.estimate(), seconds(60));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/batching_publisher_connection.h"
-#include <numeric>
+#include "google/cloud/internal/metrics.h"
+#include <algorithm>
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -27,8 +29,27 @@ struct Batch {
   // well name it as one.
   google::cloud::CompletionQueue executor;
   std::vector<promise<StatusOr<std::string>>> waiters;
+  std::weak_ptr<BatchingPublisherConnection> publisher;
+  // Owns the request until the RPC completes, then the publisher recycles
+  // the proto (and its allocated buffers) for a future batch.
+  std::unique_ptr<google::pubsub::v1::PublishRequest> request;
+  // Feedback for the adaptive hold-time controller, only engaged when
+  // `BatchingConfig::adaptive_hold_time()` is enabled.
+  bool adaptive = false;
+  std::chrono::steady_clock::time_point start;
+  double fill = 0;
 
   void operator()(future<StatusOr<google::pubsub::v1::PublishResponse>> f) {
+    if (auto self = publisher.lock()) {
+      if (adaptive) {
+        self->RecordBatchPerformance(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start),
+            fill);
+      }
+      self->OnBatchDone();
+      self->ReclaimRequest(std::move(request));
+    }
     auto response = f.get();
     if (!response) {
       SatisfyAllWaiters(response.status());
@@ -63,85 +84,263 @@ struct Batch {
   }
 };
 
+std::size_t constexpr BatchingPublisherConnection::kMaxSpareItems;
+
+BatchingPublisherConnection::~BatchingPublisherConnection() {
+  // Unsent items are discarded; destroying their promises breaks the
+  // corresponding futures, just like destroying a pending batch would.
+  auto* node = submission_queue_.exchange(nullptr);
+  while (node != nullptr) {
+    auto* next = node->next;
+    delete node;
+    node = next;
+  }
+}
+
 future<StatusOr<std::string>> BatchingPublisherConnection::Publish(
     PublishParams p) {
-  promise<StatusOr<std::string>> promise;
-  auto f = promise.get_future();
-  std::unique_lock<std::mutex> lk(mu_);
-  pending_.push_back(Item{std::move(promise), std::move(p.message)});
-  MaybeFlush(std::move(lk));
+  auto item = AcquireItem();
+  item->message = std::move(p.message);
+  auto f = item->response.get_future();
+  auto const bytes = item->message.data().size();
+
+  // Push onto the submission stack; this is the only work producers do
+  // concurrently and it takes no lock.
+  auto* node = item.release();
+  node->next = submission_queue_.load();
+  while (!submission_queue_.compare_exchange_weak(node->next, node)) {
+  }
+  auto const count = pending_count_.fetch_add(1) + 1;
+  auto const total_bytes = pending_bytes_.fetch_add(bytes) + bytes;
+
+  if (count >= batching_config_.maximum_message_count() ||
+      total_bytes >= batching_config_.maximum_batch_bytes()) {
+    FlushImpl(std::unique_lock<std::mutex>(mu_));
+  } else if (count == 1U) {
+    // The first message of a batch starts the hold-time clock.
+    SetHoldDeadline(std::unique_lock<std::mutex>(mu_));
+  }
   return f;
 }
 
-void BatchingPublisherConnection::Flush(FlushParams) {
+future<void> BatchingPublisherConnection::Flush(FlushParams) {
   FlushImpl(std::unique_lock<std::mutex>(mu_));
+  std::unique_lock<std::mutex> lk(mu_);
+  if (in_flight_batches_ == 0 && !flush_deferred_) {
+    return make_ready_future();
+  }
+  flush_waiters_.emplace_back();
+  return flush_waiters_.back().get_future();
 }
 
-void BatchingPublisherConnection::MaybeFlush(std::unique_lock<std::mutex> lk) {
-  if (pending_.size() >= batching_config_.maximum_message_count()) {
+void BatchingPublisherConnection::OnBatchDone() {
+  std::unique_lock<std::mutex> lk(mu_);
+  --in_flight_batches_;
+  if (flush_deferred_) {
+    // A batch cut was postponed because the in-flight window was full,
+    // cut it now that a slot opened up.
+    flush_deferred_ = false;
     FlushImpl(std::move(lk));
-    return;
-  }
-  auto const bytes = std::accumulate(
-      pending_.begin(), pending_.end(), std::size_t{0},
-      [](std::size_t a, Item const& b) { return a + b.message.data().size(); });
-  if (bytes >= batching_config_.maximum_batch_bytes()) {
-    FlushImpl(std::move(lk));
-    return;
-  }
-  // If the batch is empty obviously we do not need a timer, and if it has more
-  // than one element then we already have setup a timer previously.
-  if (pending_.size() == 1U) {
-    batch_expiration_ =
-        std::chrono::system_clock::now() + batching_config_.maximum_hold_time();
-    lk.unlock();
-    // We need a weak_ptr<> because this class owns the completion queue,
-    // creating a lambda with a shared_ptr<> owning this class would create a
-    // cycle.  Unfortunately some older compiler/libraries lack
-    // `weak_from_this()`.
-    auto weak = std::weak_ptr<BatchingPublisherConnection>(shared_from_this());
-    // Note that at this point the lock is released, so whether the timer
-    // schedules later on schedules in this thread has no effect.
-    cq_.MakeDeadlineTimer(batch_expiration_)
-        .then([weak](future<StatusOr<std::chrono::system_clock::time_point>>) {
-          auto self = weak.lock();
-          if (!self) return;
-          self->OnTimer();
-        });
+    lk = std::unique_lock<std::mutex>(mu_);
   }
+  if (in_flight_batches_ != 0 || flush_deferred_) return;
+  std::vector<promise<void>> waiters;
+  waiters.swap(flush_waiters_);
+  lk.unlock();
+  for (auto& w : waiters) w.set_value();
 }
 
-void BatchingPublisherConnection::OnTimer() {
+void BatchingPublisherConnection::SetHoldDeadline(
+    std::unique_lock<std::mutex> lk) {
+  // No timer is armed here: the shared flush scheduler tick picks the
+  // deadline up, so thousands of connections do not each churn timers.
+  batch_expiration_ = std::chrono::system_clock::now() + CurrentHoldTime();
+  lk.unlock();
+}
+
+void BatchingPublisherConnection::OnFlushTick(
+    std::chrono::system_clock::time_point now) {
+  // An idle connection sees only this check on each tick.
+  if (pending_count_.load() == 0) return;
   std::unique_lock<std::mutex> lk(mu_);
-  if (std::chrono::system_clock::now() < batch_expiration_) {
-    // We may get many "old" timers for batches that have already flushed due to
-    // size. Trying to cancel these timers is a bit hopeless, they might trigger
-    // even if we attempt to cancel them. This test is more robust.
-    return;
-  }
+  if (now < batch_expiration_) return;
   FlushImpl(std::move(lk));
 }
 
 void BatchingPublisherConnection::FlushImpl(std::unique_lock<std::mutex> lk) {
-  if (pending_.empty()) return;
+  if (in_flight_batches_ >= batching_config_.maximum_pending_batches()) {
+    // The in-flight window is full; leave the messages queued and cut the
+    // batch when one of the outstanding RPCs completes.
+    flush_deferred_ = true;
+    return;
+  }
+  // Take the whole submission stack in one step; producers pushing from
+  // here on start a new batch.
+  auto* node = submission_queue_.exchange(nullptr);
+  if (node == nullptr) return;
+
+  // The stack holds the newest item first, reverse it to restore the
+  // submission order.
+  Item* head = nullptr;
+  std::size_t count = 0;
+  std::size_t bytes = 0;
+  while (node != nullptr) {
+    auto* next = node->next;
+    node->next = head;
+    head = node;
+    ++count;
+    bytes += node->message.data().size();
+    node = next;
+  }
+  pending_count_.fetch_sub(count);
+  pending_bytes_.fetch_sub(bytes);
+
+  auto& registry = google::cloud::internal::MetricsRegistry::Instance();
+  static auto& batch_count = registry.Counter("pubsub.publisher.batches");
+  static auto& batch_sizes =
+      registry.Histogram("pubsub.publisher.batch_size");
+  static auto& batch_bytes =
+      registry.Histogram("pubsub.publisher.batch_bytes");
+  batch_count.Increment();
+  batch_sizes.Record(static_cast<std::int64_t>(count));
+  batch_bytes.Record(static_cast<std::int64_t>(bytes));
 
   auto context = absl::make_unique<grpc::ClientContext>();
+  if (batching_config_.compression_enabled() &&
+      bytes >= batching_config_.compression_threshold()) {
+    context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+  }
+
+  ++in_flight_batches_;
 
   Batch batch;
   batch.executor = cq_;
-  batch.waiters.reserve(pending_.size());
-  google::pubsub::v1::PublishRequest request;
-  request.set_topic(topic_full_name_);
-  request.mutable_messages()->Reserve(static_cast<int>(pending_.size()));
+  batch.waiters.reserve(count);
+  batch.publisher = shared_from_this();
+  if (batching_config_.adaptive_hold_time()) {
+    batch.adaptive = true;
+    batch.start = std::chrono::steady_clock::now();
+    auto fraction = [](std::size_t used, std::size_t limit) {
+      if (limit == 0) return 0.0;
+      return static_cast<double>(used) / static_cast<double>(limit);
+    };
+    batch.fill =
+        (std::max)(fraction(count, batching_config_.maximum_message_count()),
+                   fraction(bytes, batching_config_.maximum_batch_bytes()));
+  }
+  batch.request = AcquireRequest();
+  batch.request->set_topic(topic_full_name_);
+  batch.request->mutable_messages()->Reserve(static_cast<int>(count));
 
-  for (auto& i : pending_) {
-    batch.waiters.push_back(std::move(i.response));
-    *request.add_messages() = pubsub_internal::ToProto(std::move(i.message));
+  for (auto* node = head; node != nullptr; node = node->next) {
+    batch.waiters.push_back(std::move(node->response));
+    *batch.request->add_messages() =
+        pubsub_internal::ToProto(std::move(node->message));
   }
-  pending_.clear();
-  lk.unlock();
+  ReclaimItems(head);
+
+  // A message pushed while we drained saw a non-empty counter and did not
+  // start the hold-time clock; start it on its behalf.
+  if (pending_count_.load() != 0) {
+    SetHoldDeadline(std::move(lk));
+  } else {
+    lk.unlock();
+  }
+
+  stub_->AsyncPublish(cq_, std::move(context), *batch.request)
+      .then(std::move(batch));
+}
+
+std::unique_ptr<BatchingPublisherConnection::Item>
+BatchingPublisherConnection::AcquireItem() {
+  std::unique_ptr<Item> item;
+  {
+    // Do not block the (otherwise lock-free) publish path on the pool;
+    // if the lock is contended a fresh node is cheaper than waiting.
+    std::unique_lock<std::mutex> lk(pool_mu_, std::try_to_lock);
+    if (lk.owns_lock() && !spare_items_.empty()) {
+      item = std::move(spare_items_.back());
+      spare_items_.pop_back();
+    }
+  }
+  if (!item) return absl::make_unique<Item>();
+  item->response = promise<StatusOr<std::string>>();
+  item->next = nullptr;
+  return item;
+}
+
+void BatchingPublisherConnection::ReclaimItems(Item* head) {
+  std::lock_guard<std::mutex> lk(pool_mu_);
+  while (head != nullptr) {
+    auto* next = head->next;
+    if (spare_items_.size() >= kMaxSpareItems) {
+      delete head;
+    } else {
+      spare_items_.emplace_back(head);
+    }
+    head = next;
+  }
+}
+
+std::unique_ptr<google::pubsub::v1::PublishRequest>
+BatchingPublisherConnection::AcquireRequest() {
+  {
+    std::lock_guard<std::mutex> lk(pool_mu_);
+    if (!spare_requests_.empty()) {
+      auto request = std::move(spare_requests_.back());
+      spare_requests_.pop_back();
+      return request;
+    }
+  }
+  return absl::make_unique<google::pubsub::v1::PublishRequest>();
+}
 
-  stub_->AsyncPublish(cq_, std::move(context), request).then(std::move(batch));
+void BatchingPublisherConnection::ReclaimRequest(
+    std::unique_ptr<google::pubsub::v1::PublishRequest> r) {
+  // `Clear()` keeps the memory allocated for the `messages` field, the
+  // next batch reuses it instead of allocating.
+  r->Clear();
+  std::lock_guard<std::mutex> lk(pool_mu_);
+  if (spare_requests_.size() >= batching_config_.maximum_pending_batches()) {
+    return;
+  }
+  spare_requests_.push_back(std::move(r));
+}
+
+std::chrono::microseconds BatchingPublisherConnection::CurrentHoldTime()
+    const {
+  if (!batching_config_.adaptive_hold_time()) {
+    return batching_config_.maximum_hold_time();
+  }
+  return std::chrono::microseconds(effective_hold_us_.load());
+}
+
+void BatchingPublisherConnection::RecordBatchPerformance(
+    std::chrono::microseconds rpc_latency, double fill) {
+  using rep = std::chrono::microseconds::rep;
+  auto const max_hold = batching_config_.maximum_hold_time().count();
+  if (max_hold <= 0) return;
+  // Rearming the timer much more often than this costs more than it
+  // saves, do not shrink the hold time below this floor.
+  auto const min_hold =
+      (std::min)(max_hold, (std::max<rep>)(max_hold / 16, 1000));
+  auto const current = effective_hold_us_.load();
+  rep updated;
+  if (fill >= 0.5 || rpc_latency.count() >= current) {
+    // The batches fill up faster than we cut them, or each RPC takes
+    // longer than we hold messages for: grow the hold time so every RPC
+    // carries more messages.
+    updated = (std::min)(current * 2, max_hold);
+  } else if (fill < 0.25) {
+    // Light load, the batches go out mostly empty; holding messages
+    // longer adds latency without improving throughput.
+    updated = (std::max)(current / 2, min_hold);
+  } else {
+    return;
+  }
+  // A plain store suffices, concurrent updates race benignly and the
+  // value converges as more batches complete.
+  effective_hold_us_.store(updated);
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
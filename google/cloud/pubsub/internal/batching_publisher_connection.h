@@ -15,31 +15,98 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCHING_PUBLISHER_CONNECTION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_BATCHING_PUBLISHER_CONNECTION_H
 
+#include "google/cloud/pubsub/internal/flush_scheduler.h"
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * A `PublisherConnection` that batches messages before sending them.
+ *
+ * `Publish()` does not hold any lock: producers push their message onto a
+ * lock-free multi-producer stack, so many threads publishing concurrently
+ * do not convoy on a mutex. The mutex only serializes the (comparatively
+ * rare) batch cuts: whichever thread triggers a flush --- by size, by
+ * byte count, by hold time, or explicitly --- drains the stack and sends
+ * the batch.
+ *
+ * Hold-time flushes are driven by a `FlushScheduler` tick, which can be
+ * shared by many connections on the same completion queue, instead of one
+ * timer per partial batch.
+ */
 class BatchingPublisherConnection
     : public pubsub::PublisherConnection,
       public std::enable_shared_from_this<BatchingPublisherConnection> {
  public:
+  /**
+   * Create a connection, registered with @p scheduler for hold-time flushes.
+   *
+   * Pass the same @p scheduler to all the connections sharing a completion
+   * queue, so they share its periodic ticks. When absent the connection
+   * creates its own scheduler.
+   */
   static std::shared_ptr<BatchingPublisherConnection> Create(
       pubsub::Topic topic, pubsub::BatchingConfig batching_config,
       std::shared_ptr<pubsub_internal::PublisherStub> stub,
-      google::cloud::CompletionQueue cq) {
-    return std::shared_ptr<BatchingPublisherConnection>(
+      google::cloud::CompletionQueue cq,
+      std::shared_ptr<FlushScheduler> scheduler = {}) {
+    auto connection = std::shared_ptr<BatchingPublisherConnection>(
         new BatchingPublisherConnection(std::move(topic),
                                         std::move(batching_config),
                                         std::move(stub), std::move(cq)));
+    if (!scheduler) scheduler = FlushScheduler::Create(connection->cq_);
+    connection->scheduler_ = std::move(scheduler);
+    auto weak = std::weak_ptr<BatchingPublisherConnection>(connection);
+    connection->scheduler_->Register(
+        connection->batching_config_.maximum_hold_time(),
+        [weak](std::chrono::system_clock::time_point now) {
+          auto self = weak.lock();
+          if (!self) return false;
+          self->OnFlushTick(now);
+          return true;
+        });
+    return connection;
   }
 
+  ~BatchingPublisherConnection() override;
+
   future<StatusOr<std::string>> Publish(PublishParams p) override;
-  void Flush(FlushParams) override;
+  future<void> Flush(FlushParams) override;
+
+  /**
+   * Feed the adaptive hold-time controller with the outcome of one batch.
+   *
+   * Called as each publish RPC completes with the RPC latency and how
+   * full the batch was relative to the configured limits. Only used when
+   * `BatchingConfig::adaptive_hold_time()` is enabled.
+   */
+  void RecordBatchPerformance(std::chrono::microseconds rpc_latency,
+                              double fill);
+
+  /**
+   * Called as each publish RPC completes.
+   *
+   * Shrinks the in-flight window, cuts any batch deferred because the
+   * window was full, and satisfies `Flush()` futures once no RPCs remain
+   * outstanding.
+   */
+  void OnBatchDone();
+
+  /**
+   * Return the request proto of a completed batch to the pool.
+   *
+   * The request keeps the memory allocated for its `messages` field, so
+   * in steady state the publish path reuses it instead of allocating.
+   */
+  void ReclaimRequest(std::unique_ptr<google::pubsub::v1::PublishRequest> r);
 
  private:
   explicit BatchingPublisherConnection(
@@ -50,25 +117,83 @@ class BatchingPublisherConnection
         topic_full_name_(topic_.FullName()),
         batching_config_(std::move(batching_config)),
         stub_(std::move(stub)),
-        cq_(std::move(cq)) {}
+        cq_(std::move(cq)),
+        submission_queue_(nullptr),
+        pending_count_(0),
+        pending_bytes_(0),
+        effective_hold_us_(batching_config_.maximum_hold_time().count()) {}
+
+  /// A message waiting in the submission queue.
+  struct Item {
+    promise<StatusOr<std::string>> response;
+    pubsub::Message message;
+    /// The next (older) item in the submission stack.
+    Item* next = nullptr;
+  };
 
-  void OnTimer();
-  void MaybeFlush(std::unique_lock<std::mutex> lk);
+  /// Called on each tick of the flush scheduler, flushes a due batch.
+  void OnFlushTick(std::chrono::system_clock::time_point now);
+  /// Start the hold-time clock for the current batch. Unlocks @p lk.
+  void SetHoldDeadline(std::unique_lock<std::mutex> lk);
   void FlushImpl(std::unique_lock<std::mutex> lk);
+  /// The hold time for the next batch, adapted if so configured.
+  std::chrono::microseconds CurrentHoldTime() const;
+
+  /// Get a node for `Publish()`, recycled if the pool has one.
+  std::unique_ptr<Item> AcquireItem();
+  /// Return the (drained) nodes of a batch to the pool.
+  void ReclaimItems(Item* head);
+  /// Get a request proto for the next batch, recycled if the pool has one.
+  std::unique_ptr<google::pubsub::v1::PublishRequest> AcquireRequest();
 
   pubsub::Topic topic_;
   std::string topic_full_name_;
   pubsub::BatchingConfig batching_config_;
   std::shared_ptr<pubsub_internal::PublisherStub> stub_;
   google::cloud::CompletionQueue cq_;
+  /// Drives the hold-time flushes, possibly shared with other connections.
+  std::shared_ptr<FlushScheduler> scheduler_;
 
+  /// Serializes batch cuts and the deadline state, `Publish()` never takes
+  /// it.
   std::mutex mu_;
-  struct Item {
-    promise<StatusOr<std::string>> response;
-    pubsub::Message message;
-  };
-  std::vector<Item> pending_;
+
+  /**
+   * The lock-free submission stack, newest item first.
+   *
+   * Producers push with a CAS loop; the flushing thread takes the whole
+   * stack with a single `exchange()` and reverses it, so the batch keeps
+   * the global submission order.
+   */
+  std::atomic<Item*> submission_queue_;
+  /// Approximate count and byte size of the submission queue. They may
+  /// briefly overcount while a flush is draining; that only triggers a
+  /// harmless extra flush attempt.
+  std::atomic<std::size_t> pending_count_;
+  std::atomic<std::size_t> pending_bytes_;
+  /// The adapted hold time, in microseconds. Concurrent updates race
+  /// benignly, the value converges as more batches complete.
+  std::atomic<std::chrono::microseconds::rep> effective_hold_us_;
   std::chrono::system_clock::time_point batch_expiration_;
+  /// The number of batches with an outstanding publish RPC. Guarded by
+  /// `mu_`.
+  std::size_t in_flight_batches_ = 0;
+  /// Set when a batch cut is postponed because the in-flight window is
+  /// full. Guarded by `mu_`.
+  bool flush_deferred_ = false;
+  /// Satisfied when no publish RPCs remain outstanding. Guarded by `mu_`.
+  std::vector<promise<void>> flush_waiters_;
+
+  /// Keep at most this many recycled nodes, batches can be much larger
+  /// but the excess memory is better returned to the allocator.
+  static std::size_t constexpr kMaxSpareItems = 1024;
+  /// Recycled `Item` nodes and request protos; in steady state the
+  /// publish path reuses these instead of allocating. Guarded by
+  /// `pool_mu_`, never by `mu_`.
+  std::mutex pool_mu_;
+  std::vector<std::unique_ptr<Item>> spare_items_;
+  std::vector<std::unique_ptr<google::pubsub::v1::PublishRequest>>
+      spare_requests_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
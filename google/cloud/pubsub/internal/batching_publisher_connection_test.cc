@@ -135,6 +135,62 @@ TEST(BatchingPublisherConnectionTest, BatchByMessageCount) {
   t.join();
 }
 
+TEST(BatchingPublisherConnectionTest, RecycledRequestsAreClean) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AsyncPublish(_, _, _))
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const& request) {
+        EXPECT_EQ(2, request.messages_size());
+        EXPECT_EQ("test-data-0", request.messages(0).data());
+        EXPECT_EQ("test-data-1", request.messages(1).data());
+        google::pubsub::v1::PublishResponse response;
+        response.add_message_ids("test-message-id-0");
+        response.add_message_ids("test-message-id-1");
+        return make_ready_future(make_status_or(response));
+      })
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const& request) {
+        // This batch reuses the request from the previous one, it must
+        // not carry any of its messages.
+        EXPECT_EQ(topic.FullName(), request.topic());
+        EXPECT_EQ(2, request.messages_size());
+        EXPECT_EQ("test-data-2", request.messages(0).data());
+        EXPECT_EQ("test-data-3", request.messages(1).data());
+        google::pubsub::v1::PublishResponse response;
+        response.add_message_ids("test-message-id-2");
+        response.add_message_ids("test-message-id-3");
+        return make_ready_future(make_status_or(response));
+      });
+
+  google::cloud::CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+  // Use a long hold time so only the message count cuts the batches.
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::BatchingConfig{}
+          .set_maximum_message_count(2)
+          .set_maximum_hold_time(std::chrono::seconds(300)),
+      mock, cq);
+  for (int i = 0; i != 4; i += 2) {
+    auto r0 = publisher->Publish({pubsub::MessageBuilder{}
+                                      .SetData("test-data-" + std::to_string(i))
+                                      .Build()});
+    auto r1 =
+        publisher->Publish({pubsub::MessageBuilder{}
+                                .SetData("test-data-" + std::to_string(i + 1))
+                                .Build()});
+    ASSERT_STATUS_OK(r0.get());
+    ASSERT_STATUS_OK(r1.get());
+  }
+
+  cq.Shutdown();
+  t.join();
+}
+
 TEST(BatchingPublisherConnectionTest, BatchByMessageSize) {
   auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
   pubsub::Topic const topic("test-project", "test-topic");
@@ -315,6 +371,158 @@ TEST(BatchingPublisherConnectionTest, BatchByFlush) {
   t.join();
 }
 
+TEST(BatchingPublisherConnectionTest, MaximumPendingBatches) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  std::atomic<int> call_count{0};
+  promise<StatusOr<google::pubsub::v1::PublishResponse>> first_batch;
+  EXPECT_CALL(*mock, AsyncPublish(_, _, _))
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const&) {
+        ++call_count;
+        return first_batch.get_future();
+      })
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const& request) {
+        ++call_count;
+        google::pubsub::v1::PublishResponse response;
+        for (auto const& m : request.messages()) {
+          response.add_message_ids("ack-for-" + std::string(m.data()));
+        }
+        return make_ready_future(make_status_or(response));
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads bg;
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::BatchingConfig{}
+          .set_maximum_hold_time(std::chrono::seconds(30))
+          .set_maximum_message_count(2)
+          .set_maximum_pending_batches(1),
+      mock, bg.cq());
+
+  std::vector<future<StatusOr<std::string>>> results;
+  auto publish = [&](std::string data) {
+    results.push_back(publisher->Publish(
+        {pubsub::MessageBuilder{}.SetData(std::move(data)).Build()}));
+  };
+  // The first two messages cut a batch and start its publish RPC.
+  publish("test-data-0");
+  publish("test-data-1");
+  EXPECT_EQ(1, call_count.load());
+  // The next two messages fill another batch, but the in-flight window is
+  // full, so the cut is deferred and no RPC starts.
+  publish("test-data-2");
+  publish("test-data-3");
+  EXPECT_EQ(1, call_count.load());
+
+  // Completing the first RPC opens a slot and sends the deferred batch.
+  google::pubsub::v1::PublishResponse response;
+  response.add_message_ids("ack-for-test-data-0");
+  response.add_message_ids("ack-for-test-data-1");
+  first_batch.set_value(make_status_or(response));
+
+  int idx = 0;
+  for (auto& r : results) {
+    auto id = r.get();
+    ASSERT_STATUS_OK(id);
+    EXPECT_EQ("ack-for-test-data-" + std::to_string(idx++), *id);
+  }
+  EXPECT_EQ(2, call_count.load());
+}
+
+TEST(BatchingPublisherConnectionTest, FlushCompletesWithPendingBatches) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  promise<StatusOr<google::pubsub::v1::PublishResponse>> pending;
+  EXPECT_CALL(*mock, AsyncPublish(_, _, _))
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>,
+                    google::pubsub::v1::PublishRequest const&) {
+        return pending.get_future();
+      });
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads bg;
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::BatchingConfig{}
+          .set_maximum_hold_time(std::chrono::seconds(30))
+          .set_maximum_message_count(2),
+      mock, bg.cq());
+
+  auto r0 =
+      publisher->Publish({pubsub::MessageBuilder{}.SetData("data-0").Build()});
+  auto r1 =
+      publisher->Publish({pubsub::MessageBuilder{}.SetData("data-1").Build()});
+
+  // The batch is cut but its RPC has not completed, `Flush()` should not
+  // be satisfied yet.
+  auto flushed = publisher->Flush({});
+  using std::chrono::milliseconds;
+  EXPECT_EQ(std::future_status::timeout, flushed.wait_for(milliseconds(1)));
+
+  google::pubsub::v1::PublishResponse response;
+  response.add_message_ids("id-0");
+  response.add_message_ids("id-1");
+  pending.set_value(make_status_or(response));
+
+  flushed.get();
+  ASSERT_STATUS_OK(r0.get());
+  ASSERT_STATUS_OK(r1.get());
+}
+
+TEST(BatchingPublisherConnectionTest, AdaptiveHoldTimeShrinksWhenIdle) {
+  auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+  pubsub::Topic const topic("test-project", "test-topic");
+
+  EXPECT_CALL(*mock, AsyncPublish(_, _, _))
+      .WillRepeatedly([&](google::cloud::CompletionQueue&,
+                          std::unique_ptr<grpc::ClientContext>,
+                          google::pubsub::v1::PublishRequest const& request) {
+        google::pubsub::v1::PublishResponse response;
+        for (auto const& m : request.messages()) {
+          response.add_message_ids("ack-for-" + std::string(m.data()));
+        }
+        return make_ready_future(make_status_or(response));
+      });
+
+  // The maximum hold time is far longer than this test is willing to
+  // wait; the controller should shrink the effective hold time down to
+  // its floor (1/16th of the maximum) after a few mostly-empty batches.
+  auto const maximum_hold_time = std::chrono::milliseconds(1600);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads bg;
+  auto publisher = BatchingPublisherConnection::Create(
+      topic,
+      pubsub::BatchingConfig{}
+          .set_maximum_hold_time(maximum_hold_time)
+          .set_maximum_message_count(100)
+          .enable_adaptive_hold_time(),
+      mock, bg.cq());
+
+  // Each flushed batch carries a single message, 1% of the maximum, so
+  // every completion halves the effective hold time.
+  for (int i = 0; i != 8; ++i) {
+    auto f = publisher->Publish(
+        {pubsub::MessageBuilder{}.SetData("test-data").Build()});
+    publisher->Flush({});
+    ASSERT_STATUS_OK(f.get());
+  }
+
+  // This message is delivered by the hold-time timer; with the shrunken
+  // hold time it completes well before the configured maximum.
+  auto const start = std::chrono::steady_clock::now();
+  auto r = publisher
+               ->Publish({pubsub::MessageBuilder{}.SetData("late").Build()})
+               .get();
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  ASSERT_STATUS_OK(r);
+  EXPECT_LT(elapsed, maximum_hold_time);
+}
+
 TEST(BatchingPublisherConnectionTest, HandleError) {
   auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
   pubsub::Topic const topic("test-project", "test-topic");
@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/callback_executor.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+namespace {
+// Runs one lane callback and then unblocks the lane. A copyable callable
+// because `RunAsync()` may need to copy it; a `weak_ptr<>` because the
+// executor owns the completion queue these run on.
+struct LaneRunner {
+  std::function<void()> callback;
+  std::string key;
+  std::weak_ptr<CallbackExecutor> executor;
+
+  void operator()() const {
+    callback();
+    // Even if the executor is gone the callback ran; there is just no
+    // lane left to unblock.
+    auto self = executor.lock();
+    if (self) self->OnLaneDone(key);
+  }
+};
+}  // namespace
+
+std::shared_ptr<CallbackExecutor> CallbackExecutor::Create(
+    std::size_t thread_count) {
+  return std::shared_ptr<CallbackExecutor>(new CallbackExecutor(thread_count));
+}
+
+CallbackExecutor::CallbackExecutor(std::size_t thread_count) {
+  thread_count = (std::max<std::size_t>)(1, thread_count);
+  auto cq = cq_;
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    threads_.emplace_back([cq]() mutable { cq.Run(); });
+  }
+}
+
+CallbackExecutor::~CallbackExecutor() {
+  // Running callbacks complete, queued callbacks are discarded.
+  cq_.Shutdown();
+  for (auto& t : threads_) t.join();
+}
+
+void CallbackExecutor::Submit(std::string ordering_key,
+                              std::function<void()> callback) {
+  if (ordering_key.empty()) {
+    cq_.RunAsync(std::move(callback));
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = lanes_.find(ordering_key);
+  if (i != lanes_.end()) {
+    // The lane is busy, queue behind the running callback.
+    i->second.push_back(std::move(callback));
+    return;
+  }
+  // Mark the lane busy, then schedule outside the lock.
+  lanes_.emplace(ordering_key, std::deque<std::function<void()>>{});
+  lk.unlock();
+  auto weak = std::weak_ptr<CallbackExecutor>(shared_from_this());
+  cq_.RunAsync(
+      LaneRunner{std::move(callback), std::move(ordering_key), weak});
+}
+
+void CallbackExecutor::OnLaneDone(std::string const& key) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = lanes_.find(key);
+  if (i == lanes_.end()) return;
+  if (i->second.empty()) {
+    // The lane drained, remove the busy marker.
+    lanes_.erase(i);
+    return;
+  }
+  auto next = std::move(i->second.front());
+  i->second.pop_front();
+  lk.unlock();
+  auto weak = std::weak_ptr<CallbackExecutor>(shared_from_this());
+  cq_.RunAsync(LaneRunner{std::move(next), key, weak});
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,89 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_CALLBACK_EXECUTOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_CALLBACK_EXECUTOR_H
+
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * Run application callbacks on a pool of threads dedicated to them.
+ *
+ * CPU-heavy message handlers should not run on the transport threads,
+ * they would starve the I/O that keeps the streams and timers going. The
+ * pool is sized independently of the transport threads, and all its
+ * threads service a single queue, so an idle thread picks up the next
+ * callback no matter which session submitted it.
+ *
+ * Callbacks that share an ordering key are serialized on a per-key lane,
+ * at most one of them runs at a time and they run in submission order.
+ * Callbacks without an ordering key run with full parallelism.
+ */
+class CallbackExecutor
+    : public std::enable_shared_from_this<CallbackExecutor> {
+ public:
+  /// The constructor is private to prevent accidents with shared_from_this()
+  static std::shared_ptr<CallbackExecutor> Create(std::size_t thread_count);
+
+  ~CallbackExecutor();
+
+  /**
+   * Schedule @p callback to run on the pool.
+   *
+   * An empty @p ordering_key imposes no ordering. Callbacks with the same
+   * non-empty @p ordering_key run one at a time, in submission order.
+   */
+  void Submit(std::string ordering_key, std::function<void()> callback);
+
+ private:
+  explicit CallbackExecutor(std::size_t thread_count);
+
+  /// A lane callback finished, run the next one queued for @p key (if any).
+  void OnLaneDone(std::string const& key);
+
+  google::cloud::CompletionQueue cq_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mu_;
+  /**
+   * The callbacks waiting on each busy ordering key.
+   *
+   * A key present in the map has a callback running (or scheduled); the
+   * mapped queue holds the callbacks submitted behind it. The entry is
+   * removed once the lane drains, so the map only grows with the number
+   * of keys in flight.
+   */
+  std::map<std::string, std::deque<std::function<void()>>> lanes_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_CALLBACK_EXECUTOR_H
@@ -0,0 +1,88 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/callback_executor.h"
+#include "google/cloud/future.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(CallbackExecutorTest, UnorderedCallbacksRunInParallel) {
+  auto executor = CallbackExecutor::Create(2);
+  promise<void> first_running;
+  promise<void> blocker;
+  promise<void> first_done;
+  executor->Submit("", [&] {
+    first_running.set_value();
+    blocker.get_future().get();
+    first_done.set_value();
+  });
+  first_running.get_future().get();
+  // The second callback runs while the first is still blocked; if the
+  // callbacks were serialized the first would never be unblocked.
+  executor->Submit("", [&] { blocker.set_value(); });
+  first_done.get_future().get();
+}
+
+TEST(CallbackExecutorTest, DistinctOrderingKeysRunInParallel) {
+  auto executor = CallbackExecutor::Create(2);
+  promise<void> first_running;
+  promise<void> blocker;
+  promise<void> first_done;
+  executor->Submit("k0", [&] {
+    first_running.set_value();
+    blocker.get_future().get();
+    first_done.set_value();
+  });
+  first_running.get_future().get();
+  executor->Submit("k1", [&] { blocker.set_value(); });
+  first_done.get_future().get();
+}
+
+TEST(CallbackExecutorTest, SameOrderingKeySerialized) {
+  auto constexpr kCallbacks = 8;
+  auto executor = CallbackExecutor::Create(4);
+  std::atomic<int> active{0};
+  std::mutex mu;
+  std::vector<int> order;
+  std::vector<promise<void>> done(kCallbacks);
+  for (int i = 0; i != kCallbacks; ++i) {
+    executor->Submit("key", [&, i] {
+      // At most one callback for the key runs at a time.
+      EXPECT_EQ(1, ++active);
+      {
+        std::lock_guard<std::mutex> lk(mu);
+        order.push_back(i);
+      }
+      --active;
+      done[i].set_value();
+    });
+  }
+  for (auto& d : done) d.get_future().get();
+  EXPECT_THAT(order, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -13,29 +13,15 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/default_ack_handler_impl.h"
-#include "absl/memory/memory.h"
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
-void DefaultAckHandlerImpl::ack() {
-  google::pubsub::v1::AcknowledgeRequest request;
-  request.set_subscription(std::move(subscription_));
-  request.add_ack_ids(std::move(ack_id_));
-  (void)stub_->AsyncAcknowledge(cq_, absl::make_unique<grpc::ClientContext>(),
-                                request);
-}
+void DefaultAckHandlerImpl::ack() { queue_->Ack(std::move(ack_id_)); }
 
-void DefaultAckHandlerImpl::nack() {
-  google::pubsub::v1::ModifyAckDeadlineRequest request;
-  request.set_subscription(std::move(subscription_));
-  request.add_ack_ids(std::move(ack_id_));
-  request.set_ack_deadline_seconds(0);
-  (void)stub_->AsyncModifyAckDeadline(
-      cq_, absl::make_unique<grpc::ClientContext>(), request);
-}
+void DefaultAckHandlerImpl::nack() { queue_->Nack(std::move(ack_id_)); }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
@@ -16,7 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_DEFAULT_ACK_HANDLER_IMPL_H
 
 #include "google/cloud/pubsub/ack_handler.h"
-#include "google/cloud/pubsub/internal/subscriber_stub.h"
+#include "google/cloud/pubsub/internal/ack_batching_queue.h"
 #include "google/cloud/pubsub/version.h"
 
 namespace google {
@@ -24,15 +24,17 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * The default `AckHandler` implementation.
+ *
+ * Acks and nacks are queued on a `AckBatchingQueue` shared by all the
+ * handlers in a session, which aggregates them into batched RPCs.
+ */
 class DefaultAckHandlerImpl : public pubsub::AckHandler::Impl {
  public:
-  DefaultAckHandlerImpl(google::cloud::CompletionQueue cq,
-                        std::shared_ptr<pubsub_internal::SubscriberStub> s,
-                        std::string subscription, std::string ack_id)
-      : cq_(std::move(cq)),
-        stub_(std::move(s)),
-        subscription_(std::move(subscription)),
-        ack_id_(std::move(ack_id)) {}
+  DefaultAckHandlerImpl(std::shared_ptr<AckBatchingQueue> queue,
+                        std::string ack_id)
+      : queue_(std::move(queue)), ack_id_(std::move(ack_id)) {}
 
   ~DefaultAckHandlerImpl() override = default;
 
@@ -42,9 +44,7 @@ class DefaultAckHandlerImpl : public pubsub::AckHandler::Impl {
   std::string ack_id() const override { return ack_id_; }
 
  private:
-  google::cloud::CompletionQueue cq_;
-  std::shared_ptr<pubsub_internal::SubscriberStub> stub_;
-  std::string subscription_;
+  std::shared_ptr<AckBatchingQueue> queue_;
   std::string ack_id_;
 };
 
@@ -37,9 +37,11 @@ TEST(DefaultAckHandlerTest, Ack) {
       });
 
   google::cloud::CompletionQueue cq;
-  DefaultAckHandlerImpl handler(cq, mock, "test-subscription", "test-ack-id");
+  auto queue = AckBatchingQueue::Create(cq, mock, "test-subscription");
+  DefaultAckHandlerImpl handler(queue, "test-ack-id");
   EXPECT_EQ("test-ack-id", handler.ack_id());
   ASSERT_NO_FATAL_FAILURE(handler.ack());
+  queue->Flush();
 }
 
 TEST(DefaultAckHandlerTest, Nack) {
@@ -57,9 +59,11 @@ TEST(DefaultAckHandlerTest, Nack) {
           });
 
   google::cloud::CompletionQueue cq;
-  DefaultAckHandlerImpl handler(cq, mock, "test-subscription", "test-ack-id");
+  auto queue = AckBatchingQueue::Create(cq, mock, "test-subscription");
+  DefaultAckHandlerImpl handler(queue, "test-ack-id");
   EXPECT_EQ("test-ack-id", handler.ack_id());
   ASSERT_NO_FATAL_FAILURE(handler.nack());
+  queue->Flush();
 }
 
 }  // namespace
@@ -0,0 +1,98 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/flush_scheduler.h"
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+void FlushScheduler::Register(std::chrono::microseconds hold_time,
+                              Callback callback) {
+  auto const period = TickPeriod(hold_time);
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& tick_class = classes_[period];
+  tick_class.entries.push_back(std::move(callback));
+  if (tick_class.timer_armed) return;
+  tick_class.timer_armed = true;
+  lk.unlock();
+  ArmTimer(period);
+}
+
+std::chrono::milliseconds FlushScheduler::TickPeriod(
+    std::chrono::microseconds hold_time) {
+  auto const target = hold_time / 4;
+  std::chrono::milliseconds period(1);
+  while (period * 2 <= target && period < std::chrono::seconds(1)) {
+    period *= 2;
+  }
+  return period;
+}
+
+void FlushScheduler::ArmTimer(std::chrono::milliseconds period) {
+  // A `weak_ptr<>` because the registrants (indirectly) own this scheduler,
+  // the pending timer should not keep it alive after they are gone.
+  auto weak = std::weak_ptr<FlushScheduler>(shared_from_this());
+  using TimerResult = StatusOr<std::chrono::system_clock::time_point>;
+  cq_.MakeRelativeTimer(period).then([weak,
+                                      period](future<TimerResult> result) {
+    auto self = weak.lock();
+    if (!self) return;
+    if (!result.get()) {
+      // The completion queue is shutting down, stop ticking. Any remaining
+      // registrants become unreachable, just as their per-batch timers
+      // would have.
+      std::lock_guard<std::mutex> lk(self->mu_);
+      self->classes_[period].timer_armed = false;
+      return;
+    }
+    self->OnTick(period);
+  });
+}
+
+void FlushScheduler::OnTick(std::chrono::milliseconds period) {
+  std::vector<Callback> entries;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    entries.swap(classes_[period].entries);
+  }
+  // Run the callbacks without holding the lock, they call into publishers
+  // that may (indirectly) register new entries.
+  auto const now = std::chrono::system_clock::now();
+  std::vector<Callback> survivors;
+  survivors.reserve(entries.size());
+  for (auto& callback : entries) {
+    if (callback(now)) survivors.push_back(std::move(callback));
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& tick_class = classes_[period];
+  tick_class.entries.insert(tick_class.entries.end(),
+                            std::make_move_iterator(survivors.begin()),
+                            std::make_move_iterator(survivors.end()));
+  if (tick_class.entries.empty()) {
+    // Nobody is registered anymore, let the timer lapse; the next
+    // `Register()` call rearms it.
+    tick_class.timer_armed = false;
+    return;
+  }
+  lk.unlock();
+  ArmTimer(period);
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,103 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_FLUSH_SCHEDULER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_FLUSH_SCHEDULER_H
+
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * A shared driver for the hold-time flushes of many publishers.
+ *
+ * Arming one `CompletionQueue` timer per partial batch is wasteful when a
+ * process hosts thousands of low-rate topics: most timers fire only to find
+ * their batch already flushed, and creating and destroying them churns the
+ * completion queue. This class replaces them with a small number of periodic
+ * ticks: registrants are grouped into classes by their hold time, each class
+ * shares one repeating timer, and on each tick the class scans its
+ * registrants so the due ones can flush.
+ *
+ * The tick period is roughly a quarter of the hold time (see `TickPeriod()`),
+ * so a hold-time flush may be late by up to that amount. Size-based flushes
+ * are unaffected, they never involve the scheduler.
+ *
+ * A class ticks only while it has registrants; when the last callback
+ * unregisters the timer is allowed to lapse, and the next `Register()` call
+ * rearms it.
+ */
+class FlushScheduler : public std::enable_shared_from_this<FlushScheduler> {
+ public:
+  static std::shared_ptr<FlushScheduler> Create(
+      google::cloud::CompletionQueue cq) {
+    return std::shared_ptr<FlushScheduler>(new FlushScheduler(std::move(cq)));
+  }
+
+  /**
+   * The callback invoked on every tick of a hold-time class.
+   *
+   * The argument is the tick time. Return `false` to unregister, e.g., when
+   * the publisher that registered the callback no longer exists.
+   */
+  using Callback = std::function<bool(std::chrono::system_clock::time_point)>;
+
+  /// Invoke @p callback on every tick of the class for @p hold_time.
+  void Register(std::chrono::microseconds hold_time, Callback callback);
+
+  /**
+   * The tick period for registrants with @p hold_time.
+   *
+   * This is a quarter of the hold time rounded down to a power-of-2 number of
+   * milliseconds, so topics with similar configurations land in the same
+   * class and share one timer. The result is clamped to [1ms, 1024ms].
+   */
+  static std::chrono::milliseconds TickPeriod(
+      std::chrono::microseconds hold_time);
+
+ private:
+  explicit FlushScheduler(google::cloud::CompletionQueue cq)
+      : cq_(std::move(cq)) {}
+
+  /// Start the repeating timer for one hold-time class. Call without holding
+  /// `mu_`.
+  void ArmTimer(std::chrono::milliseconds period);
+  void OnTick(std::chrono::milliseconds period);
+
+  struct TickClass {
+    bool timer_armed = false;
+    std::vector<Callback> entries;
+  };
+
+  google::cloud::CompletionQueue cq_;
+  std::mutex mu_;
+  std::map<std::chrono::milliseconds, TickClass> classes_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_FLUSH_SCHEDULER_H
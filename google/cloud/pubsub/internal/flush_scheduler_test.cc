@@ -0,0 +1,105 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/flush_scheduler.h"
+#include "google/cloud/internal/background_threads_impl.h"
+#include <gmock/gmock.h>
+#include <condition_variable>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+TEST(FlushSchedulerTest, TickPeriod) {
+  using std::chrono::milliseconds;
+  // A zero hold time (flush as soon as possible) still ticks.
+  EXPECT_EQ(milliseconds(1), FlushScheduler::TickPeriod(milliseconds(0)));
+  EXPECT_EQ(milliseconds(1), FlushScheduler::TickPeriod(milliseconds(5)));
+  // A quarter of the hold time, rounded down to a power of 2.
+  EXPECT_EQ(milliseconds(16), FlushScheduler::TickPeriod(milliseconds(100)));
+  EXPECT_EQ(milliseconds(256), FlushScheduler::TickPeriod(milliseconds(1024)));
+  // Very long hold times are clamped, so due batches are found promptly.
+  EXPECT_EQ(milliseconds(1024),
+            FlushScheduler::TickPeriod(std::chrono::hours(1)));
+}
+
+TEST(FlushSchedulerTest, InvokesCallbackUntilUnregistered) {
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto scheduler = FlushScheduler::Create(background.cq());
+
+  std::mutex mu;
+  std::condition_variable cv;
+  int calls = 0;
+  scheduler->Register(std::chrono::milliseconds(0),
+                      [&](std::chrono::system_clock::time_point) {
+                        std::lock_guard<std::mutex> lk(mu);
+                        if (++calls >= 3) cv.notify_one();
+                        return calls < 3;
+                      });
+  std::unique_lock<std::mutex> lk(mu);
+  cv.wait(lk, [&] { return calls >= 3; });
+  EXPECT_EQ(3, calls);
+}
+
+TEST(FlushSchedulerTest, RearmsAfterClassBecomesEmpty) {
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto scheduler = FlushScheduler::Create(background.cq());
+
+  std::mutex mu;
+  std::condition_variable cv;
+  int generation = 0;
+  auto register_one = [&] {
+    scheduler->Register(std::chrono::milliseconds(0),
+                        [&](std::chrono::system_clock::time_point) {
+                          std::lock_guard<std::mutex> lk(mu);
+                          ++generation;
+                          cv.notify_one();
+                          return false;
+                        });
+  };
+
+  // The first registrant runs once and unregisters, idling its class.
+  register_one();
+  std::unique_lock<std::mutex> lk(mu);
+  cv.wait(lk, [&] { return generation >= 1; });
+  lk.unlock();
+
+  // Registering again rearms the (stopped) timer for the class.
+  register_one();
+  lk.lock();
+  cv.wait(lk, [&] { return generation >= 2; });
+  EXPECT_EQ(2, generation);
+}
+
+TEST(FlushSchedulerTest, SchedulerCanBeDestroyedWithPendingTicks) {
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto scheduler = FlushScheduler::Create(background.cq());
+  scheduler->Register(std::chrono::seconds(300),
+                      [](std::chrono::system_clock::time_point) {
+                        return true;
+                      });
+  // The pending timer holds only a weak reference, dropping the last owner
+  // must release the scheduler without waiting for the tick.
+  scheduler.reset();
+  SUCCEED();
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -13,35 +13,62 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/internal/ordering_key_publisher_connection.h"
+#include <atomic>
+#include <functional>
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+int constexpr OrderingKeyPublisherConnection::kNumShards;
+
 future<StatusOr<std::string>> OrderingKeyPublisherConnection::Publish(
     PublishParams p) {
-  auto child = [this, &p] {
-    std::lock_guard<std::mutex> lk(mu_);
-    auto i = children_.emplace(p.message.ordering_key(),
-                               std::shared_ptr<PublisherConnection>{});
-    if (i.second) i.first->second = factory_(p.message.ordering_key());
-    return i.first->second;
-  }();
-
+  auto child = GetChild(p.message.ordering_key());
   return child->Publish(std::move(p));
 }
 
-void OrderingKeyPublisherConnection::Flush(FlushParams p) {
+future<void> OrderingKeyPublisherConnection::Flush(FlushParams p) {
+  // Counts the children that have not completed their flush yet, starting
+  // at one so the futures attached below cannot satisfy `done` before all
+  // the children have been visited.
+  struct Waiter {
+    std::atomic<std::size_t> remaining{1};
+    promise<void> done;
+    void Arrive() {
+      if (--remaining == 0) done.set_value();
+    }
+  };
+  auto waiter = std::make_shared<Waiter>();
+  auto result = waiter->done.get_future();
   // Make a copy so we can iterate without holding a lock, that is important as
   // other threads may be interested in publishing events and/or adding new
   // ordering keys. Locking while performing many (potentially long) requests is
   // just not a good idea.
-  auto copy_children = [this] {
-    std::lock_guard<std::mutex> lk(mu_);
-    return children_;
-  };
-  for (auto const& kv : copy_children()) kv.second->Flush(p);
+  for (auto& shard : shards_) {
+    auto copy_children = [&shard] {
+      std::lock_guard<std::mutex> lk(shard.mu);
+      return shard.children;
+    };
+    for (auto const& kv : copy_children()) {
+      ++waiter->remaining;
+      kv.second->Flush(p).then([waiter](future<void>) { waiter->Arrive(); });
+    }
+  }
+  waiter->Arrive();
+  return result;
+}
+
+std::shared_ptr<pubsub::PublisherConnection>
+OrderingKeyPublisherConnection::GetChild(std::string const& ordering_key) {
+  auto& shard =
+      shards_[std::hash<std::string>{}(ordering_key) % shards_.size()];
+  std::lock_guard<std::mutex> lk(shard.mu);
+  auto i = shard.children.emplace(ordering_key,
+                                  std::shared_ptr<PublisherConnection>{});
+  if (i.second) i.first->second = factory_(ordering_key);
+  return i.first->second;
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
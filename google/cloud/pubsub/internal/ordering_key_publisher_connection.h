@@ -17,6 +17,8 @@
 
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/version.h"
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <map>
 #include <mutex>
@@ -26,6 +28,14 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * Route each message to a per-ordering-key child connection.
+ *
+ * The children are fully independent pipelines, each with its own batches
+ * and in-flight requests, so a slow ordering key does not head-of-line
+ * block the others. The key-to-child table is sharded to keep lookups
+ * from different keys off a single hot mutex.
+ */
 class OrderingKeyPublisherConnection : public pubsub::PublisherConnection {
  public:
   using ConnectionFactory =
@@ -40,15 +50,26 @@ class OrderingKeyPublisherConnection : public pubsub::PublisherConnection {
   ~OrderingKeyPublisherConnection() override = default;
 
   future<StatusOr<std::string>> Publish(PublishParams p) override;
-  void Flush(FlushParams) override;
+  future<void> Flush(FlushParams) override;
 
  private:
   explicit OrderingKeyPublisherConnection(ConnectionFactory factory)
       : factory_(std::move(factory)) {}
 
+  /// A shard of the key-to-child table, guarded by its own mutex.
+  struct Shard {
+    std::mutex mu;
+    std::map<std::string, std::shared_ptr<PublisherConnection>> children;
+  };
+
+  static auto constexpr kNumShards = 16;
+
+  /// Find (or create) the child connection for @p ordering_key.
+  std::shared_ptr<PublisherConnection> GetChild(
+      std::string const& ordering_key);
+
   ConnectionFactory factory_;
-  std::mutex mu_;
-  std::map<std::string, std::shared_ptr<PublisherConnection>> children_;
+  std::array<Shard, kNumShards> shards_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
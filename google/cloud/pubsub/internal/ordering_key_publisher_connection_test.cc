@@ -48,7 +48,11 @@ TEST(OrderingKeyPublisherConnectionTest, Publish) {
                             std::string(p.message.data());
               return make_ready_future(make_status_or(ack_id));
             });
-    EXPECT_CALL(*mock, Flush(_)).Times(2);
+    EXPECT_CALL(*mock, Flush(_))
+        .Times(2)
+        .WillRepeatedly([](pubsub::PublisherConnection::FlushParams) {
+          return make_ready_future();
+        });
     return mock;
   };
 
@@ -71,8 +75,8 @@ TEST(OrderingKeyPublisherConnectionTest, Publish) {
   }
   for (auto& r : results) r.get();
 
-  publisher->Flush({});
-  publisher->Flush({});
+  publisher->Flush({}).get();
+  publisher->Flush({}).get();
 }
 
 }  // namespace
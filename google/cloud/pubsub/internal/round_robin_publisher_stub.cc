@@ -0,0 +1,63 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/round_robin_publisher_stub.h"
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+StatusOr<google::pubsub::v1::Topic> RoundRobinPublisherStub::CreateTopic(
+    grpc::ClientContext& client_context,
+    google::pubsub::v1::Topic const& request) {
+  return NextChild()->CreateTopic(client_context, request);
+}
+
+StatusOr<google::pubsub::v1::Topic> RoundRobinPublisherStub::GetTopic(
+    grpc::ClientContext& client_context,
+    google::pubsub::v1::GetTopicRequest const& request) {
+  return NextChild()->GetTopic(client_context, request);
+}
+
+StatusOr<google::pubsub::v1::ListTopicsResponse>
+RoundRobinPublisherStub::ListTopics(
+    grpc::ClientContext& client_context,
+    google::pubsub::v1::ListTopicsRequest const& request) {
+  return NextChild()->ListTopics(client_context, request);
+}
+
+Status RoundRobinPublisherStub::DeleteTopic(
+    grpc::ClientContext& client_context,
+    google::pubsub::v1::DeleteTopicRequest const& request) {
+  return NextChild()->DeleteTopic(client_context, request);
+}
+
+future<StatusOr<google::pubsub::v1::PublishResponse>>
+RoundRobinPublisherStub::AsyncPublish(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> client_context,
+    google::pubsub::v1::PublishRequest const& request) {
+  return NextChild()->AsyncPublish(cq, std::move(client_context), request);
+}
+
+std::shared_ptr<PublisherStub> RoundRobinPublisherStub::NextChild() {
+  auto const index = next_child_.fetch_add(1) % children_.size();
+  return children_[index];
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,76 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ROUND_ROBIN_PUBLISHER_STUB_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ROUND_ROBIN_PUBLISHER_STUB_H
+
+#include "google/cloud/pubsub/internal/publisher_stub.h"
+#include "google/cloud/pubsub/version.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * A `PublisherStub` that round-robins over several child stubs.
+ *
+ * Each child stub uses its own gRPC channel, and each call is sent over
+ * the next channel in turn. A single HTTP/2 connection caps the publish
+ * throughput at its flow-control window; spreading the batches over
+ * several connections removes that cap.
+ */
+class RoundRobinPublisherStub : public PublisherStub {
+ public:
+  explicit RoundRobinPublisherStub(
+      std::vector<std::shared_ptr<PublisherStub>> children)
+      : children_(std::move(children)), next_child_(0) {}
+
+  StatusOr<google::pubsub::v1::Topic> CreateTopic(
+      grpc::ClientContext& client_context,
+      google::pubsub::v1::Topic const& request) override;
+
+  StatusOr<google::pubsub::v1::Topic> GetTopic(
+      grpc::ClientContext& client_context,
+      google::pubsub::v1::GetTopicRequest const& request) override;
+
+  StatusOr<google::pubsub::v1::ListTopicsResponse> ListTopics(
+      grpc::ClientContext& client_context,
+      google::pubsub::v1::ListTopicsRequest const& request) override;
+
+  Status DeleteTopic(
+      grpc::ClientContext& client_context,
+      google::pubsub::v1::DeleteTopicRequest const& request) override;
+
+  future<StatusOr<google::pubsub::v1::PublishResponse>> AsyncPublish(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context,
+      google::pubsub::v1::PublishRequest const& request) override;
+
+ private:
+  std::shared_ptr<PublisherStub> NextChild();
+
+  std::vector<std::shared_ptr<PublisherStub>> children_;
+  std::atomic<std::size_t> next_child_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_ROUND_ROBIN_PUBLISHER_STUB_H
@@ -0,0 +1,84 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/round_robin_publisher_stub.h"
+#include "google/cloud/pubsub/testing/mock_publisher_stub.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::_;
+
+TEST(RoundRobinPublisherStubTest, AsyncPublishRoundRobins) {
+  std::vector<std::shared_ptr<pubsub_testing::MockPublisherStub>> mocks;
+  std::vector<std::shared_ptr<PublisherStub>> children;
+  for (int i = 0; i != 3; ++i) {
+    auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+    // Each call goes to the next child in turn, so each child sees
+    // exactly two of the six calls below.
+    EXPECT_CALL(*mock, AsyncPublish(_, _, _))
+        .Times(2)
+        .WillRepeatedly([](google::cloud::CompletionQueue&,
+                           std::unique_ptr<grpc::ClientContext>,
+                           google::pubsub::v1::PublishRequest const&) {
+          return make_ready_future(
+              make_status_or(google::pubsub::v1::PublishResponse{}));
+        });
+    mocks.push_back(mock);
+    children.push_back(mock);
+  }
+
+  RoundRobinPublisherStub stub(children);
+  google::cloud::CompletionQueue cq;
+  for (int i = 0; i != 6; ++i) {
+    google::pubsub::v1::PublishRequest request;
+    auto response =
+        stub.AsyncPublish(cq, absl::make_unique<grpc::ClientContext>(),
+                          request)
+            .get();
+    EXPECT_STATUS_OK(response);
+  }
+}
+
+TEST(RoundRobinPublisherStubTest, UnaryCallsRoundRobin) {
+  std::vector<std::shared_ptr<PublisherStub>> children;
+  for (int i = 0; i != 2; ++i) {
+    auto mock = std::make_shared<pubsub_testing::MockPublisherStub>();
+    EXPECT_CALL(*mock, DeleteTopic(_, _))
+        .WillOnce([](grpc::ClientContext&,
+                     google::pubsub::v1::DeleteTopicRequest const&) {
+          return Status{};
+        });
+    children.push_back(std::move(mock));
+  }
+
+  RoundRobinPublisherStub stub(children);
+  for (int i = 0; i != 2; ++i) {
+    grpc::ClientContext context;
+    google::pubsub::v1::DeleteTopicRequest request;
+    EXPECT_STATUS_OK(stub.DeleteTopic(context, request));
+  }
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,406 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/streaming_pull_session.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+class StreamingPullAckHandler : public pubsub::AckHandler::Impl {
+ public:
+  StreamingPullAckHandler(std::weak_ptr<StreamingPullSession> session,
+                          std::size_t stream_index, std::string ack_id,
+                          std::size_t message_size)
+      : session_(std::move(session)),
+        stream_index_(stream_index),
+        ack_id_(std::move(ack_id)),
+        message_size_(message_size) {}
+  ~StreamingPullAckHandler() override = default;
+
+  void ack() override {
+    auto session = session_.lock();
+    if (session) session->AckMessage(stream_index_, ack_id_, message_size_);
+  }
+  void nack() override {
+    auto session = session_.lock();
+    if (session) session->NackMessage(stream_index_, ack_id_, message_size_);
+  }
+  std::string ack_id() const override { return ack_id_; }
+
+ private:
+  std::weak_ptr<StreamingPullSession> session_;
+  std::size_t stream_index_;
+  std::string ack_id_;
+  std::size_t message_size_;
+};
+
+namespace {
+// Carries one message and its handler to the callback executor. The
+// `shared_ptr<>`s make the callable copyable, as `std::function<>`
+// requires, even though `AckHandler` is move-only.
+struct MessageDelivery {
+  pubsub::SubscriberConnection::CallbackType callback;
+  std::shared_ptr<pubsub::Message> message;
+  std::shared_ptr<pubsub::AckHandler> handler;
+
+  void operator()() { callback(std::move(*message), std::move(*handler)); }
+};
+
+// The flow control limits need a consistent size for each message, use the
+// serialized size as a proxy for its memory footprint.
+std::size_t MessageSize(google::pubsub::v1::PubsubMessage const& m) {
+  return m.ByteSizeLong();
+}
+}  // namespace
+
+int constexpr StreamingPullSession::kStreamAckDeadlineSeconds;
+int constexpr StreamingPullSession::kMaximumAckDeadlineSeconds;
+int constexpr StreamingPullSession::kAckDeadlineSlackSeconds;
+
+future<Status> StreamingPullSession::Start() {
+  auto self = shared_from_this();
+  std::weak_ptr<StreamingPullSession> w(self);
+  result_ = promise<Status>{[w] {
+    auto self = w.lock();
+    if (!self) return;
+    self->Cancel();
+  }};
+  auto const count =
+      (std::max<std::size_t>)(1, params_.options.streaming_pull_streams());
+  streams_.resize(count);
+  for (std::size_t i = 0; i != count; ++i) StartStream(i);
+  StartRefreshTimer(std::unique_lock<std::mutex>(mu_));
+  return result_.get_future();
+}
+
+void StreamingPullSession::AckMessage(std::size_t stream_index,
+                                      std::string const& ack_id,
+                                      std::size_t message_size) {
+  google::pubsub::v1::StreamingPullRequest request;
+  request.add_ack_ids(ack_id);
+  SendOverStream(std::unique_lock<std::mutex>(mu_), stream_index,
+                 std::move(request));
+  MessageHandled(ack_id, message_size);
+}
+
+void StreamingPullSession::NackMessage(std::size_t stream_index,
+                                       std::string const& ack_id,
+                                       std::size_t message_size) {
+  google::pubsub::v1::StreamingPullRequest request;
+  // A zero-second extension asks the service to redeliver immediately.
+  request.add_modify_deadline_ack_ids(ack_id);
+  request.add_modify_deadline_seconds(0);
+  SendOverStream(std::unique_lock<std::mutex>(mu_), stream_index,
+                 std::move(request));
+  MessageHandled(ack_id, message_size);
+}
+
+void StreamingPullSession::MessageHandled(std::string const& ack_id,
+                                          std::size_t message_size) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = ack_deadlines_.find(ack_id);
+  if (i != ack_deadlines_.end()) {
+    deadline_estimator_.RecordProcessingTime(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - i->second.received));
+    ack_deadlines_.erase(i);
+    // Release the flow control budget held by this message, the `erase()`
+    // above guarantees this happens at most once per message.
+    outstanding_bytes_ -= (std::min)(message_size, outstanding_bytes_);
+  }
+  auto self = shared_from_this();
+  // After the callback re-schedule ourselves.
+  // TODO(#4652) - support parallel scheduling of callbacks
+  executor_.RunAsync([self] { self->HandleQueue(); });
+  lk.unlock();
+  // The backlog shrank, restart any reads paused by flow control.
+  ResumeReads();
+}
+
+void StreamingPullSession::Cancel() {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (shutdown_) return;
+  shutdown_ = true;
+  if (refresh_timer_.valid()) refresh_timer_.cancel();
+  messages_.clear();
+  lk.unlock();
+  // Cancelling a stream may complete its pending operations inline, do not
+  // hold the lock. The `streams_` vector is never resized after `Start()`.
+  for (auto& s : streams_) {
+    if (s.stream) s.stream->Cancel();
+  }
+  // The pending reads complete with "end of stream" and fetch the final
+  // status; streams paused by flow control need a read restarted to do so.
+  ResumeReads();
+}
+
+void StreamingPullSession::StartStream(std::size_t index) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& s = streams_[index];
+  s.stream = stub_->AsyncStreamingPull(
+      executor_, absl::make_unique<grpc::ClientContext>());
+  auto self = shared_from_this();
+  auto start = s.stream->Start();
+  lk.unlock();
+  start.then(
+      [self, index](future<bool> f) { self->OnStreamStart(index, f.get()); });
+}
+
+void StreamingPullSession::OnStreamStart(std::size_t index, bool ok) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (!ok) {
+    // The stream never became usable, fetch the final status.
+    auto self = shared_from_this();
+    auto finish = streams_[index].stream->Finish();
+    lk.unlock();
+    finish.then([self, index](future<Status> f) {
+      self->OnStreamFinish(index, f.get());
+    });
+    return;
+  }
+  streams_[index].open = true;
+  // The initial request configures the subscription and the deadline for
+  // messages delivered over this stream.
+  google::pubsub::v1::StreamingPullRequest request;
+  request.set_subscription(params_.full_subscription_name);
+  request.set_stream_ack_deadline_seconds(kStreamAckDeadlineSeconds);
+  SendOverStream(std::move(lk), index, std::move(request));
+  StartRead(std::unique_lock<std::mutex>(mu_), index);
+}
+
+void StreamingPullSession::StartRead(std::unique_lock<std::mutex> lk,
+                                     std::size_t index) {
+  auto& s = streams_[index];
+  if (!s.open || s.read_in_progress) return;
+  // Flow control: while the application holds too many (or too large)
+  // unhandled messages leave the stream without a pending `Read()`, the
+  // service stops sending once the transport buffers fill up. The reads
+  // restart as the application handles messages. During shutdown the
+  // reads continue, they just drain the stream.
+  if (!shutdown_ && !ack_deadlines_.empty() &&
+      (ack_deadlines_.size() >= params_.options.max_outstanding_messages() ||
+       outstanding_bytes_ >= params_.options.max_outstanding_bytes())) {
+    return;
+  }
+  s.read_in_progress = true;
+  auto self = shared_from_this();
+  auto read = s.stream->Read();
+  lk.unlock();
+  read.then(
+      [self, index](
+          future<absl::optional<google::pubsub::v1::StreamingPullResponse>>
+              f) { self->OnRead(index, f.get()); });
+}
+
+void StreamingPullSession::OnRead(
+    std::size_t index,
+    absl::optional<google::pubsub::v1::StreamingPullResponse> response) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& s = streams_[index];
+  s.read_in_progress = false;
+  if (!response) {
+    // End of stream, fetch the final status.
+    s.open = false;
+    auto self = shared_from_this();
+    auto finish = s.stream->Finish();
+    lk.unlock();
+    finish.then([self, index](future<Status> f) {
+      self->OnStreamFinish(index, f.get());
+    });
+    return;
+  }
+  if (!shutdown_) {
+    auto const now = std::chrono::system_clock::now();
+    auto const received = std::chrono::steady_clock::now();
+    auto const handling_deadline = now + params_.options.max_deadline_time();
+    for (auto& rm : *response->mutable_received_messages()) {
+      ack_deadlines_.emplace(rm.ack_id(),
+                             AckStatus{handling_deadline, index, received});
+      outstanding_bytes_ += MessageSize(rm.message());
+      messages_.push_back(PendingMessage{std::move(rm), index});
+    }
+    auto self = shared_from_this();
+    executor_.RunAsync([self] { self->HandleQueue(); });
+  }
+  // During shutdown this just drains the stream, gRPC requires all pending
+  // messages be read before calling `Finish()`.
+  StartRead(std::move(lk), index);
+}
+
+void StreamingPullSession::ResumeReads() {
+  for (std::size_t i = 0; i != streams_.size(); ++i) {
+    StartRead(std::unique_lock<std::mutex>(mu_), i);
+  }
+}
+
+void StreamingPullSession::SendOverStream(
+    std::unique_lock<std::mutex> lk, std::size_t index,
+    google::pubsub::v1::StreamingPullRequest request) {
+  auto& s = streams_[index];
+  if (shutdown_ || !s.open) return;
+  s.write_queue.push_back(std::move(request));
+  if (s.write_in_progress) return;
+  StartNextWrite(std::move(lk), index);
+}
+
+void StreamingPullSession::StartNextWrite(std::unique_lock<std::mutex> lk,
+                                          std::size_t index) {
+  auto& s = streams_[index];
+  auto request = std::move(s.write_queue.front());
+  s.write_queue.pop_front();
+  s.write_in_progress = true;
+  auto self = shared_from_this();
+  auto write = s.stream->Write(request);
+  lk.unlock();
+  write.then([self, index](future<bool> f) { self->OnWrite(index, f.get()); });
+}
+
+void StreamingPullSession::OnWrite(std::size_t index, bool ok) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& s = streams_[index];
+  s.write_in_progress = false;
+  if (!ok) {
+    // The stream failed; the pending `Read()` discovers the error and
+    // fetches the final status, just stop writing.
+    return;
+  }
+  if (shutdown_ || !s.open) return;
+  if (!s.write_queue.empty()) StartNextWrite(std::move(lk), index);
+}
+
+void StreamingPullSession::OnStreamFinish(std::size_t index, Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  streams_[index].open = false;
+  ++finished_streams_;
+  if (!status.ok() && status_.ok() && !shutdown_) {
+    // The session is abandoned on the first stream error, stop the other
+    // streams and discard any undelivered messages.
+    // TODO(#4699) - retry on transient failures
+    status_ = std::move(status);
+    lk.unlock();
+    Cancel();
+    lk.lock();
+  }
+  if (finished_streams_ != streams_.size()) return;
+  // The last stream closed, satisfy the session future.
+  auto result = std::move(status_);
+  lk.unlock();
+  result_.set_value(std::move(result));
+}
+
+void StreamingPullSession::HandleQueue(std::unique_lock<std::mutex> lk) {
+  if (shutdown_ || messages_.empty()) return;
+  if (callback_executor_) {
+    // Dispatch every waiting message; the pool runs them in parallel,
+    // serializing only the messages that share an ordering key.
+    while (!shutdown_ && !messages_.empty()) {
+      auto m = std::move(messages_.front());
+      messages_.pop_front();
+      lk.unlock();
+      DeliverOneMessage(std::move(m));
+      lk.lock();
+    }
+    return;
+  }
+  auto m = std::move(messages_.front());
+  messages_.pop_front();
+  lk.unlock();
+
+  auto const message_size = MessageSize(m.message.message());
+  std::unique_ptr<pubsub::AckHandler::Impl> handler =
+      absl::make_unique<StreamingPullAckHandler>(
+          shared_from_this(), m.stream_index,
+          std::move(*m.message.mutable_ack_id()), message_size);
+  params_.callback(FromProto(std::move(*m.message.mutable_message())),
+                   pubsub::AckHandler(std::move(handler)));
+}
+
+void StreamingPullSession::DeliverOneMessage(PendingMessage m) {
+  auto const message_size = MessageSize(m.message.message());
+  auto ordering_key = m.message.message().ordering_key();
+  std::unique_ptr<pubsub::AckHandler::Impl> handler =
+      absl::make_unique<StreamingPullAckHandler>(
+          shared_from_this(), m.stream_index,
+          std::move(*m.message.mutable_ack_id()), message_size);
+  callback_executor_->Submit(
+      std::move(ordering_key),
+      MessageDelivery{
+          params_.callback,
+          std::make_shared<pubsub::Message>(
+              FromProto(std::move(*m.message.mutable_message()))),
+          std::make_shared<pubsub::AckHandler>(std::move(handler))});
+}
+
+void StreamingPullSession::RefreshAckDeadlines(
+    std::unique_lock<std::mutex> lk) {
+  if (shutdown_) return;
+  using seconds = std::chrono::seconds;
+  auto const now = std::chrono::system_clock::now();
+  // Extend to the predicted completion time of the outstanding messages,
+  // not to the maximum the service allows: over-extending delays the
+  // redelivery of messages whose handler is stuck or crashed.
+  auto const predicted = deadline_estimator_.estimate();
+  // Group the extensions by stream, each message is extended over the
+  // stream that delivered it.
+  std::vector<google::pubsub::v1::StreamingPullRequest> requests(
+      streams_.size());
+  for (auto const& kv : ack_deadlines_) {
+    // This message cannot be extended any further, and we do not want to
+    // send an extension of 0 seconds because that is a nack.
+    if (kv.second.handling_deadline < now + seconds(1)) continue;
+    auto const extension = (std::min)(
+        predicted, std::chrono::duration_cast<seconds>(
+                       kv.second.handling_deadline - now));
+    auto& request = requests[kv.second.stream_index];
+    request.add_modify_deadline_ack_ids(kv.first);
+    request.add_modify_deadline_seconds(
+        static_cast<std::int32_t>(extension.count()));
+  }
+  for (std::size_t i = 0; i != requests.size(); ++i) {
+    if (requests[i].modify_deadline_ack_ids().empty()) continue;
+    SendOverStream(std::move(lk), i, std::move(requests[i]));
+    lk = std::unique_lock<std::mutex>(mu_);
+  }
+  StartRefreshTimer(std::move(lk));
+}
+
+void StreamingPullSession::StartRefreshTimer(std::unique_lock<std::mutex>) {
+  if (shutdown_) return;
+  auto weak = std::weak_ptr<StreamingPullSession>(shared_from_this());
+  auto period = std::chrono::milliseconds(std::chrono::seconds(
+      kStreamAckDeadlineSeconds - kAckDeadlineSlackSeconds));
+  if (test_refresh_period_.count() != 0) period = test_refresh_period_;
+  auto const deadline = std::chrono::system_clock::now() + period;
+  refresh_timer_ = executor_.MakeDeadlineTimer(deadline).then(
+      [weak](future<StatusOr<std::chrono::system_clock::time_point>> f) {
+        auto self = weak.lock();
+        if (!self || !f.get()) return;
+        self->OnRefreshTimer();
+      });
+}
+
+void StreamingPullSession::OnRefreshTimer() {
+  std::unique_lock<std::mutex> lk(mu_);
+  refresh_timer_ = {};
+  RefreshAckDeadlines(std::move(lk));
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,199 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_STREAMING_PULL_SESSION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_STREAMING_PULL_SESSION_H
+
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
+#include "google/cloud/pubsub/internal/callback_executor.h"
+#include "google/cloud/pubsub/internal/subscriber_stub.h"
+#include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsub/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+
+/**
+ * A subscription session implemented on `StreamingPull`.
+ *
+ * Compared to `SubscriptionSession`, which issues one unary `Pull()` per
+ * message, this class keeps one or more long-lived bidirectional streams
+ * open against the service. Messages arrive without a per-delivery round
+ * trip, and acks, nacks, and ack-deadline extensions are multiplexed over
+ * the same streams. While the application holds too many (or too large)
+ * unhandled messages the session stops reading, so the service stops
+ * sending once the transport buffers fill up.
+ */
+class StreamingPullSession
+    : public std::enable_shared_from_this<StreamingPullSession> {
+ public:
+  static auto constexpr kStreamAckDeadlineSeconds = 10;
+  static auto constexpr kMaximumAckDeadlineSeconds = 600;
+  static auto constexpr kAckDeadlineSlackSeconds = 2;
+
+  /// The constructor is private to prevent accidents with shared_from_this()
+  static std::shared_ptr<StreamingPullSession> Create(
+      std::shared_ptr<pubsub_internal::SubscriberStub> s,
+      google::cloud::CompletionQueue executor,
+      pubsub::SubscriberConnection::SubscribeParams p) {
+    return std::shared_ptr<StreamingPullSession>(new StreamingPullSession(
+        std::move(s), std::move(executor), std::move(p)));
+  }
+
+  /// Open the streams and start delivering messages.
+  future<Status> Start();
+
+  /// Send an ACK for @p ack_id over the stream that delivered it.
+  void AckMessage(std::size_t stream_index, std::string const& ack_id,
+                  std::size_t message_size);
+
+  /// Send a NACK (a zero-deadline extension) for @p ack_id.
+  void NackMessage(std::size_t stream_index, std::string const& ack_id,
+                   std::size_t message_size);
+
+  /// Discard any information about @p ack_id and deliver the next message.
+  void MessageHandled(std::string const& ack_id, std::size_t message_size);
+
+  /// Test-only, speed up the deadline refreshes to keep tests snappy.
+  void SetTestRefreshPeriod(std::chrono::milliseconds d) {
+    test_refresh_period_ = d;
+  }
+
+ private:
+  StreamingPullSession(std::shared_ptr<pubsub_internal::SubscriberStub> s,
+                       google::cloud::CompletionQueue executor,
+                       pubsub::SubscriberConnection::SubscribeParams p)
+      : stub_(std::move(s)),
+        executor_(std::move(executor)),
+        params_(std::move(p)),
+        test_refresh_period_(0) {
+    if (params_.options.concurrency() != 0) {
+      callback_executor_ =
+          CallbackExecutor::Create(params_.options.concurrency());
+    }
+  }
+
+  /// The state for one of the parallel streams.
+  struct Stream {
+    std::unique_ptr<SubscriberStreamingPullStream> stream;
+    std::deque<google::pubsub::v1::StreamingPullRequest> write_queue;
+    bool write_in_progress = false;
+    bool read_in_progress = false;
+    bool open = false;
+  };
+
+  /// A message waiting for delivery to the application.
+  struct PendingMessage {
+    google::pubsub::v1::ReceivedMessage message;
+    std::size_t stream_index;
+  };
+
+  /// Stop the streams and discard any undelivered messages.
+  void Cancel();
+
+  /// Create and start the stream at @p index.
+  void StartStream(std::size_t index);
+
+  /// Called when the stream at @p index started (or failed to).
+  void OnStreamStart(std::size_t index, bool ok);
+
+  /// Issue a `Read()` on the stream, unless flow control pauses it.
+  void StartRead(std::unique_lock<std::mutex> lk, std::size_t index);
+
+  /// Called when a `Read()` completes.
+  void OnRead(
+      std::size_t index,
+      absl::optional<google::pubsub::v1::StreamingPullResponse> response);
+
+  /// Restart any reads paused by flow control.
+  void ResumeReads();
+
+  /// Queue @p request for the stream at @p index, starting a write if idle.
+  void SendOverStream(std::unique_lock<std::mutex> lk, std::size_t index,
+                      google::pubsub::v1::StreamingPullRequest request);
+
+  /// Send the next queued request over the stream at @p index.
+  void StartNextWrite(std::unique_lock<std::mutex> lk, std::size_t index);
+
+  /// Called when a `Write()` completes.
+  void OnWrite(std::size_t index, bool ok);
+
+  /// Called when a stream closed and its final status is known.
+  void OnStreamFinish(std::size_t index, Status status);
+
+  void HandleQueue() { HandleQueue(std::unique_lock<std::mutex>(mu_)); }
+
+  /// Handle the queue of messages, invoking the callback on the next one.
+  void HandleQueue(std::unique_lock<std::mutex> lk);
+
+  /// Submit one message to the callback executor.
+  void DeliverOneMessage(PendingMessage m);
+
+  /// Extend the deadlines for all outstanding messages over the streams.
+  void RefreshAckDeadlines(std::unique_lock<std::mutex> lk);
+
+  /// Start the timer for the next round of deadline extensions.
+  void StartRefreshTimer(std::unique_lock<std::mutex> lk);
+
+  /// The deadline refresh timer has triggered.
+  void OnRefreshTimer();
+
+  std::shared_ptr<pubsub_internal::SubscriberStub> stub_;
+  google::cloud::CompletionQueue executor_;
+  pubsub::SubscriberConnection::SubscribeParams params_;
+  /// Runs the application callbacks when `concurrency()` is non-zero.
+  std::shared_ptr<CallbackExecutor> callback_executor_;
+  std::mutex mu_;
+  bool shutdown_ = false;
+  std::vector<Stream> streams_;
+  std::size_t finished_streams_ = 0;
+  std::deque<PendingMessage> messages_;
+  struct AckStatus {
+    std::chrono::system_clock::time_point handling_deadline;
+    std::size_t stream_index;
+    /// When the message was received, the processing time starts here.
+    std::chrono::steady_clock::time_point received;
+  };
+  std::map<std::string, AckStatus> ack_deadlines_;
+  /// The total size of the unhandled messages, the flow control limits in
+  /// `SubscriptionOptions` gate `StartRead()` on this and on the number of
+  /// entries in `ack_deadlines_`.
+  std::size_t outstanding_bytes_ = 0;
+  /// Predicts how long the application takes to handle a message.
+  AckDeadlineEstimator deadline_estimator_{
+      std::chrono::seconds(kStreamAckDeadlineSeconds),
+      std::chrono::seconds(kMaximumAckDeadlineSeconds)};
+  Status status_;
+  promise<Status> result_;
+  future<void> refresh_timer_;
+
+  std::chrono::milliseconds test_refresh_period_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_STREAMING_PULL_SESSION_H
@@ -0,0 +1,159 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/pubsub/internal/streaming_pull_session.h"
+#include "google/cloud/pubsub/testing/mock_subscriber_stub.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <condition_variable>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace pubsub_internal {
+inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
+namespace {
+
+using ::testing::_;
+using ::testing::AtMost;
+using ::testing::ByMove;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+
+/// @test Verify messages are delivered and acked over the stream.
+TEST(StreamingPullSessionTest, DeliverAndAck) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  pubsub::Subscription const subscription("test-project", "test-subscription");
+
+  std::mutex mu;
+  std::vector<std::string> acked_ids;
+  // The second Read() stays pending until the session is cancelled.
+  promise<absl::optional<google::pubsub::v1::StreamingPullResponse>>
+      pending_read;
+
+  EXPECT_CALL(*mock, AsyncStreamingPull(_, _))
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>) {
+        auto stream = absl::make_unique<
+            pubsub_testing::MockSubscriberStreamingPullStream>();
+        EXPECT_CALL(*stream, Start)
+            .WillOnce(Return(ByMove(make_ready_future(true))));
+        EXPECT_CALL(*stream, Write(_))
+            .WillRepeatedly(
+                [&](google::pubsub::v1::StreamingPullRequest const& request) {
+                  std::lock_guard<std::mutex> lk(mu);
+                  if (!request.subscription().empty()) {
+                    // The initial request configures the stream.
+                    EXPECT_EQ(subscription.FullName(), request.subscription());
+                    EXPECT_EQ(StreamingPullSession::kStreamAckDeadlineSeconds,
+                              request.stream_ack_deadline_seconds());
+                  }
+                  for (auto const& id : request.ack_ids()) {
+                    acked_ids.push_back(id);
+                  }
+                  return make_ready_future(true);
+                });
+        EXPECT_CALL(*stream, Read)
+            .WillOnce([&] {
+              google::pubsub::v1::StreamingPullResponse response;
+              for (int i = 0; i != 2; ++i) {
+                auto& m = *response.add_received_messages();
+                m.set_ack_id("test-ack-id-" + std::to_string(i));
+                m.mutable_message()->set_message_id("test-message-id-" +
+                                                    std::to_string(i));
+              }
+              return make_ready_future(
+                  absl::make_optional(std::move(response)));
+            })
+            .WillOnce([&] { return pending_read.get_future(); });
+        EXPECT_CALL(*stream, Cancel).WillOnce([&] {
+          pending_read.set_value(absl::nullopt);
+        });
+        EXPECT_CALL(*stream, Finish)
+            .WillOnce(Return(ByMove(make_ready_future(Status{}))));
+        return stream;
+      });
+
+  std::condition_variable cv;
+  int handled = 0;
+  auto callback = [&](pubsub::Message const&, pubsub::AckHandler h) {
+    std::move(h).ack();
+    std::unique_lock<std::mutex> lk(mu);
+    if (++handled == 2) cv.notify_one();
+  };
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto session = StreamingPullSession::Create(
+      mock, background.cq(),
+      {subscription.FullName(), callback,
+       pubsub::SubscriptionOptions{}.enable_streaming_pull()});
+  auto response = session->Start();
+
+  {
+    std::unique_lock<std::mutex> lk(mu);
+    cv.wait(lk, [&] { return handled == 2; });
+    EXPECT_THAT(acked_ids,
+                UnorderedElementsAre("test-ack-id-0", "test-ack-id-1"));
+  }
+  response.cancel();
+  EXPECT_STATUS_OK(response.get());
+}
+
+/// @test Verify a stream error terminates the session.
+TEST(StreamingPullSessionTest, StreamErrorTerminatesSession) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  pubsub::Subscription const subscription("test-project", "test-subscription");
+
+  auto const expected_status = Status(StatusCode::kPermissionDenied, "uh-oh");
+  EXPECT_CALL(*mock, AsyncStreamingPull(_, _))
+      .WillOnce([&](google::cloud::CompletionQueue&,
+                    std::unique_ptr<grpc::ClientContext>) {
+        auto stream = absl::make_unique<
+            pubsub_testing::MockSubscriberStreamingPullStream>();
+        EXPECT_CALL(*stream, Start)
+            .WillOnce(Return(ByMove(make_ready_future(true))));
+        EXPECT_CALL(*stream, Write(_))
+            .WillRepeatedly(
+                [](google::pubsub::v1::StreamingPullRequest const&) {
+                  return make_ready_future(true);
+                });
+        EXPECT_CALL(*stream, Read).WillOnce([] {
+          return make_ready_future(
+              absl::optional<google::pubsub::v1::StreamingPullResponse>{});
+        });
+        EXPECT_CALL(*stream, Cancel).Times(AtMost(1));
+        EXPECT_CALL(*stream, Finish)
+            .WillOnce(Return(ByMove(make_ready_future(expected_status))));
+        return stream;
+      });
+
+  auto callback = [](pubsub::Message const&, pubsub::AckHandler const&) {
+    FAIL() << "no messages should be delivered in this test";
+  };
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads background;
+  auto session = StreamingPullSession::Create(
+      mock, background.cq(),
+      {subscription.FullName(), callback,
+       pubsub::SubscriptionOptions{}.enable_streaming_pull()});
+  auto response = session->Start();
+  EXPECT_EQ(expected_status, response.get());
+}
+
+}  // namespace
+}  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
+}  // namespace pubsub_internal
+}  // namespace cloud
+}  // namespace google
@@ -93,6 +93,16 @@ future<StatusOr<google::pubsub::v1::PullResponse>> SubscriberLogging::AsyncPull(
       cq, std::move(context), request, __func__, tracing_options_);
 }
 
+std::unique_ptr<SubscriberStreamingPullStream>
+SubscriberLogging::AsyncStreamingPull(
+    google::cloud::CompletionQueue& cq,
+    std::unique_ptr<grpc::ClientContext> context) {
+  // The stream operations are sequenced by the session and carry large
+  // message payloads, log only the stream creation.
+  GCP_LOG(DEBUG) << __func__ << "() - creating streaming-pull stream";
+  return child_->AsyncStreamingPull(cq, std::move(context));
+}
+
 future<Status> SubscriberLogging::AsyncAcknowledge(
     google::cloud::CompletionQueue& cq,
     std::unique_ptr<grpc::ClientContext> context,
@@ -57,6 +57,10 @@ class SubscriberLogging : public SubscriberStub {
       std::unique_ptr<grpc::ClientContext> context,
       google::pubsub::v1::PullRequest const& request) override;
 
+  std::unique_ptr<SubscriberStreamingPullStream> AsyncStreamingPull(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context) override;
+
   future<Status> AsyncAcknowledge(
       google::cloud::CompletionQueue& cq,
       std::unique_ptr<grpc::ClientContext> context,
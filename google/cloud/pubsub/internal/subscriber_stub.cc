@@ -15,12 +15,46 @@
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/internal/emulator_overrides.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include "absl/memory/memory.h"
 
 namespace google {
 namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+class DefaultSubscriberStreamingPullStream
+    : public SubscriberStreamingPullStream {
+ public:
+  using StreamImpl = google::cloud::internal::AsyncReadWriteStreamImpl<
+      google::pubsub::v1::StreamingPullRequest,
+      google::pubsub::v1::StreamingPullResponse>;
+
+  explicit DefaultSubscriberStreamingPullStream(
+      std::shared_ptr<StreamImpl> impl)
+      : impl_(std::move(impl)) {}
+
+  future<bool> Start() override { return impl_->Start(); }
+
+  future<absl::optional<google::pubsub::v1::StreamingPullResponse>> Read()
+      override {
+    return impl_->Read();
+  }
+
+  future<bool> Write(
+      google::pubsub::v1::StreamingPullRequest const& request) override {
+    return impl_->Write(request);
+  }
+
+  future<bool> WritesDone() override { return impl_->WritesDone(); }
+
+  future<Status> Finish() override { return impl_->Finish(); }
+
+  void Cancel() override { impl_->Cancel(); }
+
+ private:
+  std::shared_ptr<StreamImpl> impl_;
+};
+
 class DefaultSubscriberStub : public SubscriberStub {
  public:
   explicit DefaultSubscriberStub(
@@ -87,6 +121,17 @@ class DefaultSubscriberStub : public SubscriberStub {
         request, std::move(context));
   }
 
+  std::unique_ptr<SubscriberStreamingPullStream> AsyncStreamingPull(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> context) override {
+    return absl::make_unique<DefaultSubscriberStreamingPullStream>(
+        cq.MakeStreamingReadWriteRpc(
+            [this](grpc::ClientContext* context, grpc::CompletionQueue* cq) {
+              return grpc_stub_->PrepareAsyncStreamingPull(context, cq);
+            },
+            std::move(context)));
+  }
+
   future<Status> AsyncAcknowledge(
       google::cloud::CompletionQueue& cq,
       std::unique_ptr<grpc::ClientContext> context,
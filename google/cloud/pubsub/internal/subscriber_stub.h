@@ -18,6 +18,7 @@
 #include "google/cloud/pubsub/connection_options.h"
 #include "google/cloud/pubsub/version.h"
 #include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
 #include <google/pubsub/v1/pubsub.grpc.pb.h>
 
 namespace google {
@@ -25,6 +26,40 @@ namespace cloud {
 namespace pubsub_internal {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * Define the interface for bidirectional streaming-pull streams.
+ *
+ * The default implementation wraps the gRPC-generated `StreamingPull()`
+ * stream. Note that gRPC allows at most one outstanding `Read()` and at
+ * most one outstanding `Write()` or `WritesDone()` per stream, and requires
+ * all received messages to be read before calling `Finish()`; the caller
+ * must sequence the operations accordingly.
+ */
+class SubscriberStreamingPullStream {
+ public:
+  virtual ~SubscriberStreamingPullStream() = default;
+
+  /// Start the stream; `false` means the stream could not be started.
+  virtual future<bool> Start() = 0;
+
+  /// Read one response; an empty optional indicates the end of the stream.
+  virtual future<absl::optional<google::pubsub::v1::StreamingPullResponse>>
+  Read() = 0;
+
+  /// Write one request; `false` indicates the stream is broken.
+  virtual future<bool> Write(
+      google::pubsub::v1::StreamingPullRequest const& request) = 0;
+
+  /// Half-close the stream, no `Write()` calls are allowed afterwards.
+  virtual future<bool> WritesDone() = 0;
+
+  /// Fetch the final status, after the read side signaled end of stream.
+  virtual future<Status> Finish() = 0;
+
+  /// Best-effort request to cancel the stream.
+  virtual void Cancel() = 0;
+};
+
 /**
  * Define the interface for the gRPC wrapper.
  *
@@ -71,6 +106,11 @@ class SubscriberStub {
       std::unique_ptr<grpc::ClientContext> client_context,
       google::pubsub::v1::PullRequest const& request) = 0;
 
+  /// Create (but do not start) a bidirectional streaming-pull stream.
+  virtual std::unique_ptr<SubscriberStreamingPullStream> AsyncStreamingPull(
+      google::cloud::CompletionQueue& cq,
+      std::unique_ptr<grpc::ClientContext> client_context) = 0;
+
   /// Acknowledge one or more messages.
   virtual future<Status> AsyncAcknowledge(
       google::cloud::CompletionQueue& cq,
@@ -15,6 +15,7 @@
 #include "google/cloud/pubsub/internal/subscription_session.h"
 #include "google/cloud/pubsub/internal/default_ack_handler_impl.h"
 #include "absl/memory/memory.h"
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -54,6 +55,25 @@ class NotifyWhenMessageHandled : public pubsub::AckHandler::Impl {
   std::size_t message_size_;
 };
 
+namespace {
+// Moves one message and its handler to the callback executor; the
+// `shared_ptr<>`s keep the callable copyable (as `std::function<>`
+// requires) despite `AckHandler` being move-only.
+struct MessageDelivery {
+  pubsub::SubscriberConnection::CallbackType callback;
+  std::shared_ptr<pubsub::Message> message;
+  std::shared_ptr<pubsub::AckHandler> handler;
+
+  void operator()() { callback(std::move(*message), std::move(*handler)); }
+};
+
+// The flow control limits need a consistent size for each message, use the
+// serialized size as a proxy for its memory footprint.
+std::size_t MessageSize(google::pubsub::v1::PubsubMessage const& m) {
+  return m.ByteSizeLong();
+}
+}  // namespace
+
 int constexpr SubscriptionSession::kMinimumAckDeadlineSeconds;
 int constexpr SubscriptionSession::kMaximumAckDeadlineSeconds;
 int constexpr SubscriptionSession::kAckDeadlineSlackSeconds;
@@ -71,9 +91,18 @@ future<Status> SubscriptionSession::Start() {
 }
 
 void SubscriptionSession::MessageHandled(std::string const& ack_id,
-                                         std::size_t) {
+                                         std::size_t message_size) {
   std::unique_lock<std::mutex> lk(mu_);
-  ack_deadlines_.erase(ack_id);
+  auto i = ack_deadlines_.find(ack_id);
+  if (i != ack_deadlines_.end()) {
+    deadline_estimator_.RecordProcessingTime(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - i->second.received));
+    ack_deadlines_.erase(i);
+    // Release the flow control budget held by this message, the `erase()`
+    // above guarantees this happens at most once per message.
+    outstanding_bytes_ -= (std::min)(message_size, outstanding_bytes_);
+  }
   auto self = shared_from_this();
   // After the callback re-schedule ourselves.
   // TODO(#4652) - support parallel scheduling of callbacks
@@ -81,9 +110,13 @@ void SubscriptionSession::MessageHandled(std::string const& ack_id,
 }
 
 void SubscriptionSession::Cancel() {
-  std::lock_guard<std::mutex> lk(mu_);
-  shutdown_ = true;
-  if (refresh_timer_.valid()) refresh_timer_.cancel();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    if (refresh_timer_.valid()) refresh_timer_.cancel();
+  }
+  // Do not wait for the hold timer on any queued acks or nacks.
+  ack_queue_->Flush();
 }
 
 void SubscriptionSession::PullOne() {
@@ -97,6 +130,25 @@ void SubscriptionSession::PullOne() {
     result_.set_value(Status{});
     return;
   }
+  // With parallel callbacks several `MessageHandled()` calls may schedule
+  // `PullOne()` concurrently, only one pull should be outstanding.
+  if (pull_in_progress_) return;
+  // Flow control: while the application holds too many (or too large)
+  // unhandled messages do not pull more, `MessageHandled()` schedules a
+  // new attempt as the backlog shrinks.
+  auto const message_limit = params_.options.max_outstanding_messages();
+  if (!ack_deadlines_.empty() &&
+      (ack_deadlines_.size() >= message_limit ||
+       outstanding_bytes_ >= params_.options.max_outstanding_bytes())) {
+    return;
+  }
+  // Pull enough messages to keep the callback executor busy, but never
+  // more than the flow control limit allows.
+  auto const max_messages = (std::max<std::size_t>)(
+      1, (std::min<std::size_t>)(
+             (std::max<std::size_t>)(1, params_.options.concurrency()),
+             message_limit - ack_deadlines_.size()));
+  pull_in_progress_ = true;
 
   auto self = shared_from_this();
   lk.unlock();
@@ -104,7 +156,7 @@ void SubscriptionSession::PullOne() {
   auto context = absl::make_unique<grpc::ClientContext>();
   google::pubsub::v1::PullRequest request;
   request.set_subscription(params_.full_subscription_name);
-  request.set_max_messages(1);
+  request.set_max_messages(static_cast<std::int32_t>(max_messages));
   stub_->AsyncPull(executor_, std::move(context), request)
       .then([self](future<StatusOr<google::pubsub::v1::PullResponse>> f) {
         self->OnPull(f.get());
@@ -119,12 +171,16 @@ void SubscriptionSession::OnPull(StatusOr<google::pubsub::v1::PullResponse> r) {
   }
 
   std::unique_lock<std::mutex> lk(mu_);
+  pull_in_progress_ = false;
   auto const now = std::chrono::system_clock::now();
+  auto const received = std::chrono::steady_clock::now();
   auto const estimated_server_deadline = now + std::chrono::seconds(10);
   auto const handling_deadline = now + params_.options.max_deadline_time();
   for (auto const& rm : r->received_messages()) {
     ack_deadlines_.emplace(
-        rm.ack_id(), AckStatus{estimated_server_deadline, handling_deadline});
+        rm.ack_id(),
+        AckStatus{estimated_server_deadline, handling_deadline, received});
+    outstanding_bytes_ += MessageSize(rm.message());
   }
   std::move(r->mutable_received_messages()->begin(),
             r->mutable_received_messages()->end(),
@@ -147,29 +203,60 @@ void SubscriptionSession::HandleQueue(std::unique_lock<std::mutex> lk) {
     executor_.RunAsync([self] { self->PullOne(); });
     return;
   }
+  if (callback_executor_) {
+    // Dispatch every waiting message; the pool runs them in parallel,
+    // serializing only the messages that share an ordering key.
+    while (!messages_.empty()) {
+      auto m = std::move(messages_.front());
+      messages_.pop_front();
+      lk.unlock();
+      DeliverOneMessage(std::move(m));
+      lk.lock();
+    }
+    return;
+  }
   auto m = std::move(messages_.front());
   messages_.pop_front();
   lk.unlock();
 
   std::unique_ptr<pubsub::AckHandler::Impl> handler =
-      absl::make_unique<DefaultAckHandlerImpl>(executor_, stub_,
-                                               params_.full_subscription_name,
+      absl::make_unique<DefaultAckHandlerImpl>(ack_queue_,
                                                std::move(*m.mutable_ack_id()));
-  // TODO(#4645) - use a better estimation for the message size.
-  auto const message_size = m.message().data().size();
+  auto const message_size = MessageSize(m.message());
   handler = absl::make_unique<NotifyWhenMessageHandled>(
       self, std::move(handler), message_size);
   params_.callback(FromProto(std::move(*m.mutable_message())),
                    pubsub::AckHandler(std::move(handler)));
 }
 
+void SubscriptionSession::DeliverOneMessage(
+    google::pubsub::v1::ReceivedMessage m) {
+  std::unique_ptr<pubsub::AckHandler::Impl> handler =
+      absl::make_unique<DefaultAckHandlerImpl>(ack_queue_,
+                                               std::move(*m.mutable_ack_id()));
+  auto const message_size = MessageSize(m.message());
+  handler = absl::make_unique<NotifyWhenMessageHandled>(
+      shared_from_this(), std::move(handler), message_size);
+  auto ordering_key = m.message().ordering_key();
+  callback_executor_->Submit(
+      std::move(ordering_key),
+      MessageDelivery{
+          params_.callback,
+          std::make_shared<pubsub::Message>(
+              FromProto(std::move(*m.mutable_message()))),
+          std::make_shared<pubsub::AckHandler>(std::move(handler))});
+}
+
 void SubscriptionSession::RefreshAckDeadlines(std::unique_lock<std::mutex> lk) {
   if (ack_deadlines_.empty() || refreshing_deadlines_) return;
   google::pubsub::v1::ModifyAckDeadlineRequest request;
   auto const now = std::chrono::system_clock::now();
   request.set_subscription(params_.full_subscription_name);
   using seconds = std::chrono::seconds;
-  auto extension = seconds(kMaximumAckDeadlineSeconds);
+  // Extend to the predicted completion time of the outstanding messages,
+  // not to the maximum the service allows: over-extending delays the
+  // redelivery of messages whose handler is stuck or crashed.
+  auto extension = deadline_estimator_.estimate();
   for (auto const& kv : ack_deadlines_) {
     // This message cannot be extended any further, and we do not want to send
     // an extension of 0 seconds because that is a nack.
@@ -15,6 +15,9 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_SESSION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_PUBSUB_INTERNAL_SUBSCRIPTION_SESSION_H
 
+#include "google/cloud/pubsub/internal/ack_batching_queue.h"
+#include "google/cloud/pubsub/internal/ack_deadline_estimator.h"
+#include "google/cloud/pubsub/internal/callback_executor.h"
 #include "google/cloud/pubsub/internal/subscriber_stub.h"
 #include "google/cloud/pubsub/subscriber_connection.h"
 #include "google/cloud/pubsub/version.h"
@@ -63,7 +66,14 @@ class SubscriptionSession
       : stub_(std::move(s)),
         executor_(std::move(executor)),
         params_(std::move(p)),
-        test_refresh_period_(0) {}
+        ack_queue_(AckBatchingQueue::Create(executor_, stub_,
+                                            params_.full_subscription_name)),
+        test_refresh_period_(0) {
+    if (params_.options.concurrency() != 0) {
+      callback_executor_ =
+          CallbackExecutor::Create(params_.options.concurrency());
+    }
+  }
 
   /// Stop fetching message batchines and stop updating any deadlines
   void Cancel();
@@ -79,6 +89,9 @@ class SubscriptionSession
   /// Handle the queue of messages, invoking `callback_` on the next message.
   void HandleQueue(std::unique_lock<std::mutex> lk);
 
+  /// Submit one message to the callback executor.
+  void DeliverOneMessage(google::pubsub::v1::ReceivedMessage m);
+
   /// Start the loop to keep ack deadlines refreshed
   void StartAckDeadlineLoop() {
     RefreshAckDeadlines(std::unique_lock<std::mutex>(mu_));
@@ -103,14 +116,30 @@ class SubscriptionSession
   std::shared_ptr<pubsub_internal::SubscriberStub> stub_;
   google::cloud::CompletionQueue executor_;
   pubsub::SubscriberConnection::SubscribeParams params_;
+  std::shared_ptr<AckBatchingQueue> ack_queue_;
+  /// Runs the application callbacks when `concurrency()` is non-zero.
+  std::shared_ptr<CallbackExecutor> callback_executor_;
   std::mutex mu_;
   bool shutdown_ = false;
+  /// With parallel callbacks several `MessageHandled()` calls may race to
+  /// issue the next `Pull()`, only one should.
+  bool pull_in_progress_ = false;
   std::deque<google::pubsub::v1::ReceivedMessage> messages_;
   struct AckStatus {
     std::chrono::system_clock::time_point estimated_server_deadline;
     std::chrono::system_clock::time_point handling_deadline;
+    /// When the message was received, the processing time starts here.
+    std::chrono::steady_clock::time_point received;
   };
   std::map<std::string, AckStatus> ack_deadlines_;
+  /// The total size of the unhandled messages, the flow control limits in
+  /// `SubscriptionOptions` gate `PullOne()` on this and on the number of
+  /// entries in `ack_deadlines_`.
+  std::size_t outstanding_bytes_ = 0;
+  /// Predicts how long the application takes to handle a message.
+  AckDeadlineEstimator deadline_estimator_{
+      std::chrono::seconds(kMinimumAckDeadlineSeconds),
+      std::chrono::seconds(kMaximumAckDeadlineSeconds)};
   promise<Status> result_;
   bool refreshing_deadlines_ = false;
   future<void> refresh_timer_;
@@ -27,7 +27,6 @@ namespace {
 
 using ::testing::_;
 using ::testing::AtLeast;
-using ::testing::InSequence;
 
 /// @test Verify callbacks are scheduled in the background threads.
 TEST(SubscriptionSessionTest, ScheduleCallbacks) {
@@ -140,36 +139,17 @@ TEST(SubscriptionSessionTest, SequencedCallbacks) {
                          google::pubsub::v1::ModifyAckDeadlineRequest const&) {
         return make_ready_future(Status{});
       });
-  {
-    InSequence sequence;
-
-    EXPECT_CALL(*mock, AsyncPull(_, _, _)).WillOnce(generate_3);
-    EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
-        .Times(3)
-        .WillRepeatedly([](google::cloud::CompletionQueue&,
-                           std::unique_ptr<grpc::ClientContext>,
-                           google::pubsub::v1::AcknowledgeRequest const&) {
-          return make_ready_future(Status{});
-        });
-
-    EXPECT_CALL(*mock, AsyncPull(_, _, _)).WillOnce(generate_3);
-    EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
-        .Times(3)
-        .WillRepeatedly([](google::cloud::CompletionQueue&,
-                           std::unique_ptr<grpc::ClientContext>,
-                           google::pubsub::v1::AcknowledgeRequest const&) {
-          return make_ready_future(Status{});
-        });
-
-    EXPECT_CALL(*mock, AsyncPull(_, _, _)).WillOnce(generate_3);
-    EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
-        .Times(3)
-        .WillRepeatedly([](google::cloud::CompletionQueue&,
-                           std::unique_ptr<grpc::ClientContext>,
-                           google::pubsub::v1::AcknowledgeRequest const&) {
-          return make_ready_future(Status{});
-        });
-  }
+  EXPECT_CALL(*mock, AsyncPull(_, _, _))
+      .Times(AtLeast(3))
+      .WillRepeatedly(generate_3);
+  // The acks are batched, so they do not interleave with the pulls in a
+  // deterministic way; the handler below verifies the delivery order.
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
+      .WillRepeatedly([](google::cloud::CompletionQueue&,
+                         std::unique_ptr<grpc::ClientContext>,
+                         google::pubsub::v1::AcknowledgeRequest const&) {
+        return make_ready_future(Status{});
+      });
 
   promise<void> enough_messages;
   std::atomic<int> received_counter{0};
@@ -200,6 +180,80 @@ TEST(SubscriptionSessionTest, SequencedCallbacks) {
   t.join();
 }
 
+/// @test Verify the flow control limits bound how far the session pulls ahead.
+TEST(SubscriptionSessionTest, RespectsFlowControlLimits) {
+  auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
+  pubsub::Subscription const subscription("test-project", "test-subscription");
+
+  std::mutex mu;
+  int count = 0;
+  EXPECT_CALL(*mock, AsyncPull(_, _, _))
+      .Times(AtLeast(1))
+      .WillRepeatedly([&](google::cloud::CompletionQueue&,
+                          std::unique_ptr<grpc::ClientContext>,
+                          google::pubsub::v1::PullRequest const& request) {
+        // The message budget (2) is smaller than the concurrency (4), it
+        // caps the batch size.
+        EXPECT_EQ(2, request.max_messages());
+        google::pubsub::v1::PullResponse response;
+        for (int i = 0; i != 2; ++i) {
+          auto& m = *response.add_received_messages();
+          std::lock_guard<std::mutex> lk(mu);
+          m.set_ack_id("test-ack-id-" + std::to_string(count));
+          m.mutable_message()->set_data(std::string(16, 'x'));
+          ++count;
+        }
+        return make_ready_future(make_status_or(response));
+      });
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
+      .WillRepeatedly([](google::cloud::CompletionQueue&,
+                         std::unique_ptr<grpc::ClientContext>,
+                         google::pubsub::v1::AcknowledgeRequest const&) {
+        return make_ready_future(Status{});
+      });
+  EXPECT_CALL(*mock, AsyncModifyAckDeadline(_, _, _))
+      .WillRepeatedly([](google::cloud::CompletionQueue&,
+                         std::unique_ptr<grpc::ClientContext>,
+                         google::pubsub::v1::ModifyAckDeadlineRequest const&) {
+        return make_ready_future(Status{});
+      });
+
+  promise<void> enough_messages;
+  std::atomic<int> unhandled{0};
+  std::atomic<int> total{0};
+  auto constexpr kMaximumMessages = 20;
+  auto handler = [&](pubsub::Message const&, pubsub::AckHandler h) {
+    // Each message is over the byte budget, so the session must not pull
+    // more messages until the whole batch is handled.
+    auto const c = ++unhandled;
+    EXPECT_LE(c, 2);
+    if (++total == kMaximumMessages) enough_messages.set_value();
+    --unhandled;
+    std::move(h).ack();
+  };
+
+  google::cloud::CompletionQueue cq;
+  std::vector<std::thread> tasks;
+  std::generate_n(std::back_inserter(tasks), 4,
+                  [&] { return std::thread([&cq] { cq.Run(); }); });
+
+  auto session = SubscriptionSession::Create(
+      mock, cq,
+      {subscription.FullName(), handler,
+       pubsub::SubscriptionOptions{}
+           .set_concurrency(4)
+           .set_max_outstanding_messages(2)
+           .set_max_outstanding_bytes(16)});
+  auto response = session->Start();
+  enough_messages.get_future()
+      .then([&](future<void>) { response.cancel(); })
+      .get();
+  EXPECT_STATUS_OK(response.get());
+
+  cq.Shutdown();
+  for (auto& t : tasks) t.join();
+}
+
 /// @test Verify callbacks are scheduled in sequence.
 TEST(SubscriptionSessionTest, UpdateAckDeadlines) {
   auto mock = std::make_shared<pubsub_testing::MockSubscriberStub>();
@@ -227,23 +281,14 @@ TEST(SubscriptionSessionTest, UpdateAckDeadlines) {
           google::pubsub::v1::AcknowledgeRequest const&) {
         return make_ready_future(Status{});
       };
-  // The basic expectations, pull some data, ack each message, pull more data,
-  // must be in a specific order.
-  {
-    InSequence sequence;
-    EXPECT_CALL(*mock, AsyncPull(_, _, _)).WillOnce(generate_3);
-    EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
-        .Times(3)
-        .WillRepeatedly(generate_ack_response);
-    EXPECT_CALL(*mock, AsyncPull(_, _, _)).WillOnce(generate_3);
-    EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
-        .Times(3)
-        .WillRepeatedly(generate_ack_response);
-    EXPECT_CALL(*mock, AsyncPull(_, _, _)).WillOnce(generate_3);
-    EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
-        .Times(3)
-        .WillRepeatedly(generate_ack_response);
-  }
+  // The basic expectations: pull some data and ack each message. The acks
+  // are batched, so they do not interleave with the pulls in a
+  // deterministic way.
+  EXPECT_CALL(*mock, AsyncPull(_, _, _))
+      .Times(AtLeast(3))
+      .WillRepeatedly(generate_3);
+  EXPECT_CALL(*mock, AsyncAcknowledge(_, _, _))
+      .WillRepeatedly(generate_ack_response);
 
   // The expectations for timers and AsyncModifyAckDeadline are more complex.
   // The setup is as follows:
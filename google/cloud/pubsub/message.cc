@@ -27,6 +27,14 @@ std::chrono::system_clock::time_point Message::publish_time() const {
   return google::cloud::internal::ToChronoTimePoint(proto_.publish_time());
 }
 
+std::string const& Message::attribute(std::string const& key) const {
+  // Leaked on purpose, trivial destructors make for safer shutdown.
+  static auto const* const kEmpty = new std::string;
+  auto i = proto_.attributes().find(key);
+  if (i == proto_.attributes().end()) return *kEmpty;
+  return i->second;
+}
+
 bool operator==(Message const& a, Message const& b) {
   google::protobuf::util::MessageDifferencer diff;
   return diff.Compare(a.proto_, b.proto_);
@@ -17,8 +17,10 @@
 
 #include "google/cloud/pubsub/version.h"
 #include <google/pubsub/v1/pubsub.pb.h>
+#include <algorithm>
 #include <iosfwd>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace google {
@@ -74,7 +76,14 @@ class Message {
  public:
   /// @name accessors
   //@{
+  /**
+   * The message payload.
+   *
+   * The returned reference aliases the deserialized message, no copy is
+   * made. It remains valid for the lifetime of this object.
+   */
   PubsubMessageDataType const& data() const& { return proto_.data(); }
+  /// Extract the payload from a message about to be discarded, no copy.
   PubsubMessageDataType&& data() && {
     return std::move(*proto_.mutable_data());
   }
@@ -88,6 +97,22 @@ class Message {
     }
     return r;
   }
+
+  /**
+   * The value of the attribute @p key, or the empty string if not set.
+   *
+   * The returned reference aliases the deserialized message, no copy is
+   * made. It remains valid for the lifetime of this object. Prefer this
+   * function (and `has_attribute()`) over `attributes()` when looking up
+   * a handful of attributes, `attributes()` copies all the attributes
+   * into a newly allocated container.
+   */
+  std::string const& attribute(std::string const& key) const;
+
+  /// Returns `true` if the attribute @p key is set in this message.
+  bool has_attribute(std::string const& key) const {
+    return proto_.attributes().count(key) != 0;
+  }
   //@}
 
   /// @name Copy and move
@@ -134,9 +159,26 @@ class MessageBuilder {
   MessageBuilder() = default;
 
   /// Create a new message.
-  Message Build() && { return Message(std::move(proto_)); }
+  Message Build() && {
+    if (!attributes_.empty()) {
+      using value_type =
+          google::protobuf::Map<std::string, std::string>::value_type;
+      auto& attributes = *proto_.mutable_attributes();
+      for (auto& kv : attributes_) {
+        attributes.insert(
+            value_type(std::move(kv.first), std::move(kv.second)));
+      }
+      attributes_.clear();
+    }
+    return Message(std::move(proto_));
+  }
 
-  /// Create a message with the data in @p data
+  /**
+   * Create a message with the data in @p data
+   *
+   * Pass an rvalue (e.g. `SetData(std::move(payload))`) to move the
+   * payload into the message without copying it.
+   */
   MessageBuilder& SetData(std::string data) & {
     proto_.set_data(std::move(data));
     return *this;
@@ -148,6 +190,24 @@ class MessageBuilder {
     return std::move(*this);
   }
 
+  /// Insert (or overwrite) the attribute @p key with value @p value
+  MessageBuilder& InsertAttribute(std::string const& key, std::string value) & {
+    auto loc = AttributeLowerBound(key);
+    if (loc != attributes_.end() && loc->first == key) {
+      loc->second = std::move(value);
+    } else {
+      attributes_.emplace(loc, key, std::move(value));
+    }
+    return *this;
+  }
+
+  /// Insert (or overwrite) the attribute @p key with value @p value
+  MessageBuilder&& InsertAttribute(std::string const& key,
+                                   std::string value) && {
+    InsertAttribute(key, std::move(value));
+    return std::move(*this);
+  }
+
   /// Create the message with ordering key @p key
   MessageBuilder& SetOrderingKey(std::string key) & {
     proto_.set_ordering_key(std::move(key));
@@ -162,14 +222,11 @@ class MessageBuilder {
   /// Create a message with the attributes from the range [@p begin, @p end)
   template <typename Iterator>
   MessageBuilder& SetAttributes(Iterator begin, Iterator end) & {
-    google::protobuf::Map<std::string, std::string> tmp;
-    using value_type =
-        google::protobuf::Map<std::string, std::string>::value_type;
+    attributes_.clear();
     for (auto kv = begin; kv != end; ++kv) {
       using std::get;
-      tmp.insert(value_type(get<0>(*kv), get<1>(*kv)));
+      InsertIfAbsent(get<0>(*kv), get<1>(*kv));
     }
-    proto_.mutable_attributes()->swap(tmp);
     return *this;
   }
 
@@ -184,13 +241,10 @@ class MessageBuilder {
   MessageBuilder& SetAttributes(
       // NOLINTNEXTLINE(performance-unnecessary-value-param)
       std::vector<std::pair<std::string, std::string>> v) & {
-    using value_type =
-        google::protobuf::Map<std::string, std::string>::value_type;
-    google::protobuf::Map<std::string, std::string> tmp;
+    attributes_.clear();
     for (auto& kv : v) {
-      tmp.insert(value_type(std::move(kv.first), std::move(kv.second)));
+      InsertIfAbsent(std::move(kv.first), std::move(kv.second));
     }
-    proto_.mutable_attributes()->swap(tmp);
     return *this;
   }
 
@@ -216,7 +270,33 @@ class MessageBuilder {
   }
 
  private:
+  using AttributeVector = std::vector<std::pair<std::string, std::string>>;
+
+  /// The first position in the sorted attribute vector not before @p key.
+  AttributeVector::iterator AttributeLowerBound(std::string const& key) {
+    return std::lower_bound(attributes_.begin(), attributes_.end(), key,
+                            [](AttributeVector::value_type const& kv,
+                               std::string const& k) { return kv.first < k; });
+  }
+
+  /// Insert @p key, keeping any existing value for the same key.
+  void InsertIfAbsent(std::string key, std::string value) {
+    auto loc = AttributeLowerBound(key);
+    if (loc != attributes_.end() && loc->first == key) return;
+    attributes_.emplace(loc, std::move(key), std::move(value));
+  }
+
   google::pubsub::v1::PubsubMessage proto_;
+
+  /**
+   * The attributes accumulated by the builder, sorted by key.
+   *
+   * Messages typically carry a handful of attributes; a sorted vector
+   * avoids the per-entry node allocations of the proto map while the
+   * message is built, `Build()` transfers the entries into the proto in
+   * a single pass.
+   */
+  AttributeVector attributes_;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -158,6 +158,55 @@ TEST(Message, DataMove) {
   EXPECT_EQ("contents-0", d);
 }
 
+TEST(Message, InsertAttribute) {
+  auto const m0 = MessageBuilder{}
+                      .InsertAttribute("k0", "v0")
+                      .InsertAttribute("k1", "v1")
+                      .InsertAttribute("k0", "overwritten")
+                      .Build();
+  EXPECT_THAT(m0.attributes(),
+              UnorderedElementsAre(std::make_pair("k0", "overwritten"),
+                                   std::make_pair("k1", "v1")));
+}
+
+TEST(Message, SetAttributesDuplicateKeysKeepFirst) {
+  std::vector<std::pair<std::string, std::string>> const attributes(
+      {{"k0", "v0"}, {"k1", "v1"}, {"k0", "duplicate"}});
+  auto const m0 = MessageBuilder{}.SetAttributes(attributes).Build();
+  EXPECT_THAT(m0.attributes(),
+              UnorderedElementsAre(std::make_pair("k0", "v0"),
+                                   std::make_pair("k1", "v1")));
+}
+
+TEST(Message, AttributeLookup) {
+  auto const m0 = MessageBuilder{}
+                      .InsertAttribute("k0", "v0")
+                      .InsertAttribute("k1", "v1")
+                      .Build();
+  EXPECT_TRUE(m0.has_attribute("k0"));
+  EXPECT_EQ("v0", m0.attribute("k0"));
+  EXPECT_EQ("v1", m0.attribute("k1"));
+  EXPECT_FALSE(m0.has_attribute("k2"));
+  EXPECT_EQ("", m0.attribute("k2"));
+}
+
+TEST(Message, DataMovedNotCopied) {
+  // Large enough to defeat any small-string optimization.
+  std::string payload(128, 'A');
+  auto const* buffer = payload.data();
+  auto m = MessageBuilder{}.SetData(std::move(payload)).Build();
+  // The payload was moved into the message, not copied.
+  EXPECT_EQ(buffer, m.data().data());
+  // And it is moved, not copied, when extracting the wrapped proto.
+  auto proto = pubsub_internal::ToProto(std::move(m));
+  EXPECT_EQ(buffer, proto.data().data());
+  // The same holds on the receive path.
+  auto received = pubsub_internal::FromProto(std::move(proto));
+  EXPECT_EQ(buffer, received.data().data());
+  auto extracted = std::move(received).data();
+  EXPECT_EQ(buffer, extracted.data());
+}
+
 TEST(Message, FromProto) {
   auto constexpr kText = R"pb(
     data: "test-data"
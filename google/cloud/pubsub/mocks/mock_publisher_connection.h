@@ -27,7 +27,7 @@ class MockPublisherConnection : public pubsub::PublisherConnection {
  public:
   MOCK_METHOD(future<StatusOr<std::string>>, Publish,
               (pubsub::PublisherConnection::PublishParams), (override));
-  MOCK_METHOD(void, Flush, (pubsub::PublisherConnection::FlushParams),
+  MOCK_METHOD(future<void>, Flush, (pubsub::PublisherConnection::FlushParams),
               (override));
 };
 
@@ -127,11 +127,12 @@ class Publisher {
    * sometimes useful to flush them before any of the normal criteria to send
    * the RPCs is met.
    *
-   * @note This function does not return any status or error codes, the
-   *     application can use the `future<StatusOr<std::string>>` returned in
-   *     each `Publish()` call to find out what the results are.
+   * @return a future satisfied when all the publish RPCs outstanding at
+   *     the time of the call have completed. It carries no status or error
+   *     codes, the application can use the `future<StatusOr<std::string>>`
+   *     returned in each `Publish()` call to find out what the results are.
    */
-  void Flush() { connection_->Flush({}); }
+  future<void> Flush() { return connection_->Flush({}); }
 
  private:
   std::shared_ptr<PublisherConnection> connection_;
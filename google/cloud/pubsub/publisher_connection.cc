@@ -14,10 +14,14 @@
 
 #include "google/cloud/pubsub/publisher_connection.h"
 #include "google/cloud/pubsub/internal/batching_publisher_connection.h"
+#include "google/cloud/pubsub/internal/flush_scheduler.h"
 #include "google/cloud/pubsub/internal/ordering_key_publisher_connection.h"
 #include "google/cloud/pubsub/internal/publisher_logging.h"
 #include "google/cloud/pubsub/internal/publisher_stub.h"
+#include "google/cloud/pubsub/internal/round_robin_publisher_stub.h"
 #include "google/cloud/log.h"
+#include <algorithm>
+#include <atomic>
 #include <memory>
 
 namespace google {
@@ -36,7 +40,9 @@ class ContainingPublisherConnection : public PublisherConnection {
   future<StatusOr<std::string>> Publish(PublishParams p) override {
     return child_->Publish(std::move(p));
   }
-  void Flush(FlushParams p) override { child_->Flush(std::move(p)); }
+  future<void> Flush(FlushParams p) override {
+    return child_->Flush(std::move(p));
+  }
 
  private:
   std::shared_ptr<BackgroundThreads> background_;
@@ -49,11 +55,16 @@ PublisherConnection::~PublisherConnection() = default;
 std::shared_ptr<PublisherConnection> MakePublisherConnection(
     Topic topic, PublisherOptions options,
     ConnectionOptions const& connection_options) {
-  auto stub = pubsub_internal::CreateDefaultPublisherStub(connection_options,
-                                                          /*channel_id=*/0);
+  std::vector<std::shared_ptr<pubsub_internal::PublisherStub>> stubs(
+      (std::max)(1, connection_options.num_channels()));
+  int channel_id = 0;
+  for (auto& stub : stubs) {
+    stub = pubsub_internal::CreateDefaultPublisherStub(connection_options,
+                                                       channel_id++);
+  }
   return pubsub_internal::MakePublisherConnection(
       std::move(topic), std::move(options), connection_options,
-      std::move(stub));
+      std::move(stubs));
 }
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
@@ -65,25 +76,44 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
     pubsub::Topic topic, pubsub::PublisherOptions options,
     pubsub::ConnectionOptions const& connection_options,
-    std::shared_ptr<PublisherStub> stub) {
+    std::vector<std::shared_ptr<PublisherStub>> stubs) {
   if (connection_options.tracing_enabled("rpc")) {
     GCP_LOG(INFO) << "Enabled logging for gRPC calls";
-    stub = std::make_shared<pubsub_internal::PublisherLogging>(
-        std::move(stub), connection_options.tracing_options());
+    for (auto& stub : stubs) {
+      stub = std::make_shared<pubsub_internal::PublisherLogging>(
+          std::move(stub), connection_options.tracing_options());
+    }
   }
   auto background = connection_options.background_threads_factory()();
   auto make_connection = [&]() -> std::shared_ptr<pubsub::PublisherConnection> {
     auto cq = background->cq();
+    // All the connections created here share one flush scheduler, so (for
+    // example) thousands of per-ordering-key children do not each arm their
+    // own hold-time timers.
+    auto scheduler = FlushScheduler::Create(cq);
     if (options.message_ordering()) {
-      auto factory = [topic, options, stub, cq](std::string const&) {
+      // Messages with the same ordering key must be published in order,
+      // sending their batches over different channels could reorder
+      // them. Stripe by key instead: each (single-key) child connection
+      // sticks to one channel, and distinct keys spread over the pool.
+      auto next_stub = std::make_shared<std::atomic<std::size_t>>(0);
+      auto factory = [topic, options, stubs, next_stub, cq,
+                      scheduler](std::string const&) {
+        auto stub = stubs[next_stub->fetch_add(1) % stubs.size()];
         return BatchingPublisherConnection::Create(
-            topic, options.batching_config(), stub, cq);
+            topic, options.batching_config(), std::move(stub), cq, scheduler);
       };
       return OrderingKeyPublisherConnection::Create(std::move(factory));
     }
-    return BatchingPublisherConnection::Create(std::move(topic),
-                                               options.batching_config(),
-                                               std::move(stub), std::move(cq));
+    std::shared_ptr<PublisherStub> stub;
+    if (stubs.size() == 1) {
+      stub = std::move(stubs[0]);
+    } else {
+      stub = std::make_shared<RoundRobinPublisherStub>(std::move(stubs));
+    }
+    return BatchingPublisherConnection::Create(
+        std::move(topic), options.batching_config(), std::move(stub),
+        std::move(cq), std::move(scheduler));
   };
   return std::make_shared<pubsub::ContainingPublisherConnection>(
       std::move(background), make_connection());
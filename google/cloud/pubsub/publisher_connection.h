@@ -42,7 +42,13 @@ class PublisherConnection {
   virtual future<StatusOr<std::string>> Publish(PublishParams p) = 0;
 
   struct FlushParams {};
-  virtual void Flush(FlushParams) = 0;
+  /**
+   * Send any batched messages immediately.
+   *
+   * @return a future satisfied when all the publish RPCs outstanding at
+   *     the time of the call have completed.
+   */
+  virtual future<void> Flush(FlushParams) = 0;
 };
 
 /**
@@ -74,7 +80,7 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 std::shared_ptr<pubsub::PublisherConnection> MakePublisherConnection(
     pubsub::Topic topic, pubsub::PublisherOptions options,
     pubsub::ConnectionOptions const& connection_options,
-    std::shared_ptr<PublisherStub> stub);
+    std::vector<std::shared_ptr<PublisherStub>> stubs);
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub_internal
 }  // namespace cloud
@@ -47,7 +47,7 @@ TEST(PublisherConnectionTest, Basic) {
       });
 
   auto publisher =
-      pubsub_internal::MakePublisherConnection(topic, {}, {}, mock);
+      pubsub_internal::MakePublisherConnection(topic, {}, {}, {mock});
   auto response =
       publisher->Publish({MessageBuilder{}.SetData("test-data-0").Build()})
           .get();
@@ -75,7 +75,7 @@ TEST(PublisherConnectionTest, Logging) {
       });
 
   auto publisher = pubsub_internal::MakePublisherConnection(
-      topic, {}, ConnectionOptions{}.enable_tracing("rpc"), mock);
+      topic, {}, ConnectionOptions{}.enable_tracing("rpc"), {mock});
   auto response =
       publisher->Publish({MessageBuilder{}.SetData("test-data-0").Build()})
           .get();
@@ -102,7 +102,7 @@ TEST(PublisherConnectionTest, OrderingKey) {
       });
 
   auto publisher = pubsub_internal::MakePublisherConnection(
-      topic, PublisherOptions{}.enable_message_ordering(), {}, mock);
+      topic, PublisherOptions{}.enable_message_ordering(), {}, {mock});
   auto response =
       publisher->Publish({MessageBuilder{}.SetData("test-data-0").Build()})
           .get();
@@ -123,7 +123,7 @@ TEST(PublisherConnectionTest, HandleInvalidResponse) {
       });
 
   auto publisher =
-      pubsub_internal::MakePublisherConnection(topic, {}, {}, mock);
+      pubsub_internal::MakePublisherConnection(topic, {}, {}, {mock});
   auto response =
       publisher->Publish({MessageBuilder{}.SetData("test-data-0").Build()})
           .get();
@@ -148,7 +148,7 @@ TEST(PublisherConnectionTest, HandleError) {
       });
 
   auto publisher =
-      pubsub_internal::MakePublisherConnection(topic, {}, {}, mock);
+      pubsub_internal::MakePublisherConnection(topic, {}, {}, {mock});
   auto response =
       publisher->Publish({MessageBuilder{}.SetData("test-message-0").Build()})
           .get();
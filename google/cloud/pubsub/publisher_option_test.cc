@@ -36,6 +36,36 @@ TEST(PublisherOptions, Batching) {
   EXPECT_EQ(expected, b.maximum_hold_time());
 }
 
+TEST(PublisherOptions, AdaptiveHoldTime) {
+  auto const b0 = BatchingConfig{};
+  EXPECT_FALSE(b0.adaptive_hold_time());
+
+  auto b = BatchingConfig{}.enable_adaptive_hold_time();
+  EXPECT_TRUE(b.adaptive_hold_time());
+  b.disable_adaptive_hold_time();
+  EXPECT_FALSE(b.adaptive_hold_time());
+}
+
+TEST(PublisherOptions, MaximumPendingBatches) {
+  auto const b0 = BatchingConfig{};
+  EXPECT_EQ(32, b0.maximum_pending_batches());
+
+  auto const b = BatchingConfig{}.set_maximum_pending_batches(4);
+  EXPECT_EQ(4, b.maximum_pending_batches());
+}
+
+TEST(PublisherOptions, Compression) {
+  auto const b0 = BatchingConfig{};
+  EXPECT_FALSE(b0.compression_enabled());
+  EXPECT_EQ(1024, b0.compression_threshold());
+
+  auto b = BatchingConfig{}.enable_compression().set_compression_threshold(16);
+  EXPECT_TRUE(b.compression_enabled());
+  EXPECT_EQ(16, b.compression_threshold());
+  b.disable_compression();
+  EXPECT_FALSE(b.compression_enabled());
+}
+
 TEST(PublisherOptions, PublisherOptions) {
   auto const o0 = PublisherOptions{};
   EXPECT_FALSE(o0.message_ordering());
@@ -23,7 +23,11 @@ inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 BatchingConfig::BatchingConfig()
     : maximum_hold_time_(0),
       maximum_message_count_((std::numeric_limits<std::size_t>::max)()),
-      maximum_batch_bytes_((std::numeric_limits<std::size_t>::max)()) {}
+      maximum_batch_bytes_((std::numeric_limits<std::size_t>::max)()),
+      adaptive_hold_time_(false),
+      maximum_pending_batches_(32),
+      compression_enabled_(false),
+      compression_threshold_(1024) {}
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
 }  // namespace pubsub
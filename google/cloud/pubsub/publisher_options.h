@@ -52,10 +52,80 @@ class BatchingConfig {
     return *this;
   }
 
+  /**
+   * Adaptively tune the hold time against the observed traffic.
+   *
+   * When enabled `maximum_hold_time()` becomes an upper bound. The
+   * publisher shrinks the effective hold time while batches go out mostly
+   * empty, reducing latency under light load, and grows it back towards
+   * the maximum when batches fill up or the publish RPCs take longer than
+   * the current hold time, improving throughput under pressure.
+   */
+  BatchingConfig& enable_adaptive_hold_time() {
+    adaptive_hold_time_ = true;
+    return *this;
+  }
+  BatchingConfig& disable_adaptive_hold_time() {
+    adaptive_hold_time_ = false;
+    return *this;
+  }
+  bool adaptive_hold_time() const { return adaptive_hold_time_; }
+
+  /**
+   * The maximum number of batches with outstanding publish RPCs.
+   *
+   * The publisher pipelines batches: it sends a new batch without waiting
+   * for the previous RPCs to complete, up to this limit. Once the limit
+   * is reached new batches are held (the messages keep accumulating)
+   * until an outstanding RPC completes.
+   */
+  std::size_t maximum_pending_batches() const {
+    return maximum_pending_batches_;
+  }
+  BatchingConfig& set_maximum_pending_batches(std::size_t v) {
+    maximum_pending_batches_ = v;
+    return *this;
+  }
+
+  /**
+   * Compress the publish RPCs.
+   *
+   * When enabled the publish RPCs use gRPC per-call (gzip) compression.
+   * Highly compressible payloads, such as JSON or text, can shrink
+   * severalfold on the wire, which matters for cross-region publishers
+   * where egress is billed.
+   */
+  BatchingConfig& enable_compression() {
+    compression_enabled_ = true;
+    return *this;
+  }
+  BatchingConfig& disable_compression() {
+    compression_enabled_ = false;
+    return *this;
+  }
+  bool compression_enabled() const { return compression_enabled_; }
+
+  /**
+   * Only compress batches with at least this many payload bytes.
+   *
+   * Small payloads often grow under compression, and compressing them
+   * wastes CPU on both ends. Batches below the threshold are sent
+   * uncompressed even when `compression_enabled()` is set.
+   */
+  std::size_t compression_threshold() const { return compression_threshold_; }
+  BatchingConfig& set_compression_threshold(std::size_t v) {
+    compression_threshold_ = v;
+    return *this;
+  }
+
  private:
   std::chrono::microseconds maximum_hold_time_;
   std::size_t maximum_message_count_;
   std::size_t maximum_batch_bytes_;
+  bool adaptive_hold_time_;
+  std::size_t maximum_pending_batches_;
+  bool compression_enabled_;
+  std::size_t compression_threshold_;
 };
 
 /// Configuration options for a `PublisherClient`
@@ -32,10 +32,12 @@ TEST(PublisherTest, PublishSimple) {
         EXPECT_EQ("test-data-0", p.message.data());
         return make_ready_future(StatusOr<std::string>("test-id-0"));
       });
-  EXPECT_CALL(*mock, Flush(_)).Times(1);
+  EXPECT_CALL(*mock, Flush(_)).WillOnce([](PublisherConnection::FlushParams) {
+    return make_ready_future();
+  });
 
   Publisher publisher(mock);
-  publisher.Flush();
+  publisher.Flush().get();
   auto id =
       publisher.Publish(pubsub::MessageBuilder{}.SetData("test-data-0").Build())
           .get();
@@ -19,12 +19,18 @@
 pubsub_client_hdrs = [
     "ack_handler.h",
     "connection_options.h",
+    "internal/ack_batching_queue.h",
+    "internal/ack_deadline_estimator.h",
     "internal/batching_publisher_connection.h",
+    "internal/callback_executor.h",
     "internal/default_ack_handler_impl.h",
     "internal/emulator_overrides.h",
+    "internal/flush_scheduler.h",
     "internal/ordering_key_publisher_connection.h",
     "internal/publisher_logging.h",
     "internal/publisher_stub.h",
+    "internal/round_robin_publisher_stub.h",
+    "internal/streaming_pull_session.h",
     "internal/subscriber_logging.h",
     "internal/subscriber_stub.h",
     "internal/subscription_session.h",
@@ -51,12 +57,18 @@ pubsub_client_hdrs = [
 pubsub_client_srcs = [
     "ack_handler.cc",
     "connection_options.cc",
+    "internal/ack_batching_queue.cc",
+    "internal/ack_deadline_estimator.cc",
     "internal/batching_publisher_connection.cc",
+    "internal/callback_executor.cc",
     "internal/default_ack_handler_impl.cc",
     "internal/emulator_overrides.cc",
+    "internal/flush_scheduler.cc",
     "internal/ordering_key_publisher_connection.cc",
     "internal/publisher_logging.cc",
     "internal/publisher_stub.cc",
+    "internal/round_robin_publisher_stub.cc",
+    "internal/streaming_pull_session.cc",
     "internal/subscriber_logging.cc",
     "internal/subscriber_stub.cc",
     "internal/subscription_session.cc",
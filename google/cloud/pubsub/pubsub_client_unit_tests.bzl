@@ -18,11 +18,17 @@
 
 pubsub_client_unit_tests = [
     "ack_handler_test.cc",
+    "internal/ack_batching_queue_test.cc",
+    "internal/ack_deadline_estimator_test.cc",
     "internal/batching_publisher_connection_test.cc",
+    "internal/callback_executor_test.cc",
     "internal/default_ack_handler_impl_test.cc",
     "internal/emulator_overrides_test.cc",
+    "internal/flush_scheduler_test.cc",
     "internal/ordering_key_publisher_connection_test.cc",
     "internal/publisher_logging_test.cc",
+    "internal/round_robin_publisher_stub_test.cc",
+    "internal/streaming_pull_session_test.cc",
     "internal/subscriber_logging_test.cc",
     "internal/subscription_session_test.cc",
     "internal/user_agent_prefix_test.cc",
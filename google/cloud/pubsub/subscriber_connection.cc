@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/pubsub/subscriber_connection.h"
+#include "google/cloud/pubsub/internal/streaming_pull_session.h"
 #include "google/cloud/pubsub/internal/subscriber_logging.h"
 #include "google/cloud/pubsub/internal/subscription_session.h"
 #include "google/cloud/log.h"
@@ -50,6 +51,11 @@ class SubscriberConnectionImpl : public pubsub::SubscriberConnection {
   ~SubscriberConnectionImpl() override = default;
 
   future<Status> Subscribe(SubscribeParams p) override {
+    if (p.options.streaming_pull()) {
+      auto session =
+          StreamingPullSession::Create(stub_, background_->cq(), std::move(p));
+      return session->Start();
+    }
     auto session =
         SubscriptionSession::Create(stub_, background_->cq(), std::move(p));
     return session->Start();
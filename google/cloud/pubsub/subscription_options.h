@@ -17,6 +17,7 @@
 
 #include "google/cloud/pubsub/version.h"
 #include <chrono>
+#include <cstddef>
 
 namespace google {
 namespace cloud {
@@ -53,10 +54,92 @@ class SubscriptionOptions {
     return *this;
   }
 
-  // TODO(#4645) - add options for flow control
+  /**
+   * Use `StreamingPull` to receive messages.
+   *
+   * When enabled the library keeps one or more long-lived bidirectional
+   * streams open against the service, instead of issuing one unary `Pull()`
+   * per message. This removes a round trip from every delivery and
+   * increases the achievable throughput per subscriber.
+   */
+  SubscriptionOptions& enable_streaming_pull() {
+    streaming_pull_ = true;
+    return *this;
+  }
+  SubscriptionOptions& disable_streaming_pull() {
+    streaming_pull_ = false;
+    return *this;
+  }
+  bool streaming_pull() const { return streaming_pull_; }
+
+  /**
+   * The number of parallel streams when `streaming_pull()` is enabled.
+   *
+   * A single stream is limited by the service to about 10 MiB/s, use
+   * multiple streams to scale beyond that. The value `0` is treated as `1`.
+   */
+  SubscriptionOptions& set_streaming_pull_streams(std::size_t v) {
+    streaming_pull_streams_ = v;
+    return *this;
+  }
+  std::size_t streaming_pull_streams() const {
+    return streaming_pull_streams_;
+  }
+
+  /**
+   * The maximum number of messages held by the library before handling.
+   *
+   * The session stops pulling (or, when `streaming_pull()` is enabled,
+   * stops reading from the streams) while more than this many messages
+   * have been received but not handled (ACKed or NACKed) by the
+   * application. It resumes as the application handles messages.
+   */
+  SubscriptionOptions& set_max_outstanding_messages(std::size_t v) {
+    max_outstanding_messages_ = v;
+    return *this;
+  }
+  std::size_t max_outstanding_messages() const {
+    return max_outstanding_messages_;
+  }
+
+  /**
+   * The maximum number of message bytes held by the library before handling.
+   *
+   * Like `max_outstanding_messages()`, but based on the total size of the
+   * unhandled messages rather than their count. With this limit a slow
+   * application degrades to bounded memory usage instead of accumulating
+   * messages without limit.
+   */
+  SubscriptionOptions& set_max_outstanding_bytes(std::size_t v) {
+    max_outstanding_bytes_ = v;
+    return *this;
+  }
+  std::size_t max_outstanding_bytes() const { return max_outstanding_bytes_; }
+
+  /**
+   * The number of threads dedicated to running the application callback.
+   *
+   * The value `0` (the default) runs the callbacks on the transport
+   * threads, one message at a time, preserving the historical behavior.
+   * CPU-heavy handlers should set this to the desired delivery
+   * concurrency: the library then runs the callbacks on a pool of this
+   * many threads, sized independently of the transport threads, and
+   * delivers messages in parallel. Messages that share an ordering key
+   * are still delivered one at a time, in order.
+   */
+  SubscriptionOptions& set_concurrency(std::size_t v) {
+    concurrency_ = v;
+    return *this;
+  }
+  std::size_t concurrency() const { return concurrency_; }
 
  private:
   std::chrono::seconds max_deadline_time_ = std::chrono::seconds(0);
+  bool streaming_pull_ = false;
+  std::size_t streaming_pull_streams_ = 1;
+  std::size_t max_outstanding_messages_ = 1000;
+  std::size_t max_outstanding_bytes_ = 100 * 1024 * 1024L;
+  std::size_t concurrency_ = 0;
 };
 
 }  // namespace GOOGLE_CLOUD_CPP_PUBSUB_NS
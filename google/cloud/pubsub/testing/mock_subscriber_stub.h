@@ -24,6 +24,30 @@ namespace cloud {
 namespace pubsub_testing {
 inline namespace GOOGLE_CLOUD_CPP_PUBSUB_NS {
 
+/**
+ * A class to mock pubsub_internal::SubscriberStreamingPullStream
+ */
+class MockSubscriberStreamingPullStream
+    : public pubsub_internal::SubscriberStreamingPullStream {
+ public:
+  ~MockSubscriberStreamingPullStream() override = default;
+
+  MOCK_METHOD(future<bool>, Start, (), (override));
+
+  MOCK_METHOD(
+      (future<absl::optional<google::pubsub::v1::StreamingPullResponse>>),
+      Read, (), (override));
+
+  MOCK_METHOD(future<bool>, Write,
+              (google::pubsub::v1::StreamingPullRequest const&), (override));
+
+  MOCK_METHOD(future<bool>, WritesDone, (), (override));
+
+  MOCK_METHOD(future<Status>, Finish, (), (override));
+
+  MOCK_METHOD(void, Cancel, (), (override));
+};
+
 /**
  * A class to mock pubsub_internal::SubscriberStub
  */
@@ -62,6 +86,12 @@ class MockSubscriberStub : public pubsub_internal::SubscriberStub {
                google::pubsub::v1::PullRequest const&),
               (override));
 
+  MOCK_METHOD(std::unique_ptr<pubsub_internal::SubscriberStreamingPullStream>,
+              AsyncStreamingPull,
+              (google::cloud::CompletionQueue&,
+               std::unique_ptr<grpc::ClientContext>),
+              (override));
+
   MOCK_METHOD(future<Status>, AsyncAcknowledge,
               (google::cloud::CompletionQueue&,
                std::unique_ptr<grpc::ClientContext>,
@@ -18,6 +18,7 @@
 #include "google/cloud/internal/getenv.h"
 #include <functional>
 #include <sstream>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -42,6 +43,8 @@ std::ostream& operator<<(std::ostream& os, Config const& config) {
             << "\n# Query Size: " << config.query_size
             << "\n# Use Only Stubs: " << config.use_only_stubs
             << "\n# Use Only Clients: " << config.use_only_clients
+            << "\n# Target Requests/Second: "
+            << config.target_requests_per_second
             << "\n# Compiler: " << spanner::internal::CompilerId() << "-"
             << spanner::internal::CompilerVersion()
             << "\n# Build Flags: " << google::cloud::internal::compiler_flags()
@@ -121,6 +124,11 @@ google::cloud::StatusOr<Config> ParseArgs(std::vector<std::string> args) {
        [](Config& c, std::string const&) { c.use_only_stubs = true; }},
       {"--use-only-clients",
        [](Config& c, std::string const&) { c.use_only_clients = true; }},
+
+      {"--target-requests-per-second=",
+       [](Config& c, std::string const& v) {
+         c.target_requests_per_second = std::stoi(v);
+       }},
   };
 
   auto invalid_argument = [](std::string msg) {
@@ -200,9 +208,49 @@ google::cloud::StatusOr<Config> ParseArgs(std::vector<std::string> args) {
     return invalid_argument(os.str());
   }
 
+  if (config.target_requests_per_second < 0) {
+    std::ostringstream os;
+    os << "The target requests per second ("
+       << config.target_requests_per_second << ") should be >= 0";
+    return invalid_argument(os.str());
+  }
+
   return config;
 }
 
+OperationSchedule::OperationSchedule(Config const& config, int thread_count)
+    : interval_(std::chrono::steady_clock::duration::zero()),
+      next_(std::chrono::steady_clock::now()),
+      lag_(0) {
+  if (config.target_requests_per_second <= 0) return;
+  // Each thread issues its share of the target rate; the divisions round
+  // towards a slightly higher per-thread rate, so the aggregate rate is
+  // never below the target.
+  interval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::seconds(thread_count)) /
+              config.target_requests_per_second;
+}
+
+void OperationSchedule::WaitUntilNextSlot() {
+  if (interval_ == std::chrono::steady_clock::duration::zero()) return;
+  auto const scheduled = next_;
+  next_ = scheduled + interval_;
+  auto const now = std::chrono::steady_clock::now();
+  if (now < scheduled) {
+    std::this_thread::sleep_until(scheduled);
+    lag_ = std::chrono::microseconds(0);
+    return;
+  }
+  // The schedule fell behind, issue the request immediately and report
+  // the backlog delay as part of the operation latency.
+  lag_ = std::chrono::duration_cast<std::chrono::microseconds>(now - scheduled);
+}
+
+std::chrono::microseconds OperationSchedule::OpenLoopLatency(
+    std::chrono::microseconds elapsed) const {
+  return elapsed + lag_;
+}
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_benchmarks
 }  // namespace cloud
@@ -47,12 +47,57 @@ struct Config {
 
   bool use_only_clients = false;
   bool use_only_stubs = false;
+
+  // When non-zero, run open-loop: issue this many requests per second
+  // (spread across all the threads of an iteration) on a fixed schedule,
+  // regardless of how long each request takes. The default (0) keeps the
+  // closed-loop behavior, where each thread issues a request as soon as
+  // the previous one completes.
+  int target_requests_per_second = 0;
 };
 
 std::ostream& operator<<(std::ostream& os, Config const& config);
 
 google::cloud::StatusOr<Config> ParseArgs(std::vector<std::string> args);
 
+/**
+ * Paces the request loop of one benchmark thread in open-loop mode.
+ *
+ * Closed-loop benchmarks suffer from coordinated omission: when the
+ * service slows down the threads issue fewer requests, so the slow period
+ * is underrepresented in the samples. In open-loop mode each thread
+ * issues requests on a fixed schedule, and the latency of a request is
+ * measured from its *scheduled* start time. If the thread falls behind it
+ * does not sleep, and the backlog delay is included in the reported
+ * latency, as it would be for a client arriving at that rate.
+ *
+ * With `target_requests_per_second == 0` the schedule is a no-op and the
+ * benchmark behaves as before.
+ */
+class OperationSchedule {
+ public:
+  OperationSchedule(Config const& config, int thread_count);
+
+  /// Block until the next scheduled request; a no-op in closed-loop mode
+  /// or when the schedule has fallen behind.
+  void WaitUntilNextSlot();
+
+  /**
+   * The latency to report for an operation that took @p elapsed.
+   *
+   * In open-loop mode this adds the delay between the scheduled and the
+   * actual start of the operation, in closed-loop mode it returns
+   * @p elapsed unchanged.
+   */
+  std::chrono::microseconds OpenLoopLatency(
+      std::chrono::microseconds elapsed) const;
+
+ private:
+  std::chrono::steady_clock::duration interval_;
+  std::chrono::steady_clock::time_point next_;
+  std::chrono::microseconds lag_;
+};
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_benchmarks
 }  // namespace cloud
@@ -16,6 +16,8 @@
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/scoped_environment.h"
 #include <gmock/gmock.h>
+#include <chrono>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -132,6 +134,57 @@ TEST(BenchmarkConfigTest, OnlyClients) {
   EXPECT_TRUE(config->use_only_clients);
 }
 
+TEST(BenchmarkConfigTest, TargetRequestsPerSecond) {
+  auto config = ParseArgs({"placeholder", "--project=test-project",
+                           "--target-requests-per-second=1000"});
+  ASSERT_STATUS_OK(config);
+
+  EXPECT_EQ(1000, config->target_requests_per_second);
+}
+
+TEST(BenchmarkConfigTest, InvalidTargetRequestsPerSecond) {
+  auto config = ParseArgs({"placeholder", "--project=test-project",
+                           "--target-requests-per-second=-1"});
+  EXPECT_EQ(StatusCode::kInvalidArgument, config.status().code());
+}
+
+TEST(OperationScheduleTest, ClosedLoopIsNoOp) {
+  Config config;
+  OperationSchedule schedule(config, 4);
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i != 1000; ++i) schedule.WaitUntilNextSlot();
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::seconds(1));
+  EXPECT_EQ(std::chrono::microseconds(1234).count(),
+            schedule.OpenLoopLatency(std::chrono::microseconds(1234)).count());
+}
+
+TEST(OperationScheduleTest, OpenLoopPacesRequests) {
+  Config config;
+  config.target_requests_per_second = 1000;
+  // With 2 threads each schedule issues 500 requests per second, so 50
+  // requests should take at least 100ms (minus one interval for the
+  // immediate first request).
+  OperationSchedule schedule(config, 2);
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i != 50; ++i) schedule.WaitUntilNextSlot();
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(98));
+}
+
+TEST(OperationScheduleTest, OpenLoopReportsBacklogDelay) {
+  Config config;
+  config.target_requests_per_second = 1000;
+  OperationSchedule schedule(config, 1);
+  schedule.WaitUntilNextSlot();
+  // Fall behind the schedule by much more than one interval, the delay
+  // should show up in the reported latency.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  schedule.WaitUntilNextSlot();
+  auto const latency = schedule.OpenLoopLatency(std::chrono::microseconds(10));
+  EXPECT_GE(latency, std::chrono::milliseconds(40));
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner_benchmarks
@@ -21,6 +21,7 @@
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/benchmark_result.h"
 #include "absl/memory/memory.h"
 #include "absl/time/civil_time.h"
 #include <google/spanner/v1/result_set.pb.h>
@@ -28,10 +29,12 @@
 #include <chrono>
 #include <future>
 #include <limits>
+#include <mutex>
 #include <numeric>
 #include <random>
 #include <sstream>
 #include <thread>
+#include <vector>
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
 #include <sys/resource.h>
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
@@ -52,6 +55,7 @@ namespace {
 namespace spanner = ::google::cloud::spanner;
 using ::google::cloud::Status;
 using ::google::cloud::spanner_benchmarks::Config;
+using ::google::cloud::spanner_benchmarks::OperationSchedule;
 
 struct RowCpuSample {
   int client_count;
@@ -69,6 +73,31 @@ std::ostream& operator<<(std::ostream& os, RowCpuSample const& s) {
             << s.cpu_time.count() << ',' << s.status.code();
 }
 
+// The elapsed time of every successful sample, kept to emit the
+// machine-readable summary for the benchmark regression harness.
+std::mutex elapsed_samples_mu;
+std::vector<double> elapsed_samples;  // GUARDED_BY(elapsed_samples_mu)
+
+void AccumulateElapsedSamples(std::vector<RowCpuSample> const& samples) {
+  std::lock_guard<std::mutex> lk(elapsed_samples_mu);
+  for (auto const& s : samples) {
+    if (!s.status.ok()) continue;
+    elapsed_samples.push_back(static_cast<double>(s.elapsed.count()));
+  }
+}
+
+void PrintResultJson(Config const& config) {
+  std::lock_guard<std::mutex> lk(elapsed_samples_mu);
+  google::cloud::testing_util::BenchmarkResult result;
+  result.benchmark = "spanner-multiple-rows-cpu/" + config.experiment;
+  result.unit = "us";
+  result.environment = google::cloud::testing_util::BenchmarkEnvironment();
+  result.samples = std::move(elapsed_samples);
+  elapsed_samples.clear();
+  std::cout << google::cloud::testing_util::FormatBenchmarkResultAsJson(result)
+            << "\n";
+}
+
 namespace {
 bool SupportPerThreadUsage() {
 #if GOOGLE_CLOUD_CPP_HAVE_RUSAGE_THREAD
@@ -209,6 +238,7 @@ int main(int argc, char* argv[]) {
   if (setup_status.ok()) {
     auto run_status = experiment->Run(config, database);
     if (!run_status.ok()) exit_status = EXIT_FAILURE;
+    PrintResultJson(config);
     if (database_created) {
       (void)experiment->TearDown(config, database);
     }
@@ -451,6 +481,7 @@ class ExperimentImpl {
   };
 
   void DumpSamples(std::vector<RowCpuSample> const& samples) const {
+    AccumulateElapsedSamples(samples);
     std::lock_guard<std::mutex> lk(mu_);
     std::copy(samples.begin(), samples.end(),
               std::ostream_iterator<RowCpuSample>(std::cout, "\n"));
@@ -666,6 +697,7 @@ class ReadExperiment : public Experiment {
     // the size of the vector.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     std::vector<std::string> const columns{"Key",   "Data0", "Data1", "Data2",
                                            "Data3", "Data4", "Data5", "Data6",
                                            "Data7", "Data8", "Data9"};
@@ -674,6 +706,7 @@ class ReadExperiment : public Experiment {
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = impl_.RandomKeySet(config);
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
 
@@ -712,8 +745,9 @@ class ReadExperiment : public Experiment {
       }
       auto final = stream->Finish();
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{
-          client_count, thread_count, true, row_count, timer.elapsed_time(),
+          client_count, thread_count, true, row_count, latency,
           timer.cpu_time(), google::cloud::MakeStatusFromRpcError(final)});
     }
     return samples;
@@ -750,11 +784,13 @@ class ReadExperiment : public Experiment {
     // memory to start.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = impl_.RandomKeySet(config);
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
       auto rows = client.Read(table_name_, key, column_names);
@@ -768,8 +804,9 @@ class ReadExperiment : public Experiment {
         ++row_count;
       }
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{client_count, thread_count, false,
-                                     row_count, timer.elapsed_time(),
+                                     row_count, latency,
                                      timer.cpu_time(), std::move(status)});
     }
     return samples;
@@ -887,12 +924,14 @@ class SelectExperiment : public Experiment {
     // the size of the vector.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     auto const statement = CreateStatement();
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = impl_.RandomKeySetBegin(config);
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
 
@@ -937,8 +976,9 @@ class SelectExperiment : public Experiment {
       }
       auto final = stream->Finish();
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{
-          client_count, thread_count, true, row_count, timer.elapsed_time(),
+          client_count, thread_count, true, row_count, latency,
           timer.cpu_time(), google::cloud::MakeStatusFromRpcError(final)});
     }
     return samples;
@@ -972,11 +1012,13 @@ class SelectExperiment : public Experiment {
     // memory to start.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = impl_.RandomKeySetBegin(config);
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
       auto rows = client.ExecuteQuery(spanner::SqlStatement(
@@ -992,8 +1034,9 @@ class SelectExperiment : public Experiment {
         ++row_count;
       }
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{client_count, thread_count, false,
-                                     row_count, timer.elapsed_time(),
+                                     row_count, latency,
                                      timer.cpu_time(), std::move(status)});
     }
     return samples;
@@ -1128,6 +1171,7 @@ class UpdateExperiment : public Experiment {
     // the size of the vector.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
@@ -1142,6 +1186,7 @@ class UpdateExperiment : public Experiment {
           impl_.GenerateRandomValue(), impl_.GenerateRandomValue(),
       };
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
 
@@ -1190,8 +1235,9 @@ class UpdateExperiment : public Experiment {
       }
 
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{client_count, thread_count, true,
-                                     row_count, timer.elapsed_time(),
+                                     row_count, latency,
                                      timer.cpu_time(), status});
     }
     return samples;
@@ -1224,6 +1270,7 @@ class UpdateExperiment : public Experiment {
     // memory to start.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
@@ -1238,6 +1285,7 @@ class UpdateExperiment : public Experiment {
           impl_.GenerateRandomValue(), impl_.GenerateRandomValue(),
       };
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
       std::unordered_map<std::string, spanner::Value> const params{
@@ -1260,8 +1308,9 @@ class UpdateExperiment : public Experiment {
             return spanner::Mutations{};
           });
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{
-          client_count, thread_count, false, row_count, timer.elapsed_time(),
+          client_count, thread_count, false, row_count, latency,
           timer.cpu_time(), std::move(commit_result).status()});
     }
     return samples;
@@ -1398,6 +1447,7 @@ class MutationExperiment : public Experiment {
     // the size of the vector.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
@@ -1420,6 +1470,7 @@ class MutationExperiment : public Experiment {
           impl_.GenerateRandomValue(), impl_.GenerateRandomValue(),
       };
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
 
@@ -1444,9 +1495,10 @@ class MutationExperiment : public Experiment {
       auto response = stub->Commit(context, commit_request);
 
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{
           client_count, thread_count, true, commit_request.mutations_size(),
-          timer.elapsed_time(), timer.cpu_time(), response.status()});
+          latency, timer.cpu_time(), response.status()});
     }
     return samples;
   }
@@ -1480,6 +1532,7 @@ class MutationExperiment : public Experiment {
     // memory to start.
     samples.reserve(
         static_cast<std::size_t>(config.iteration_duration.count() * 50));
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
@@ -1502,6 +1555,7 @@ class MutationExperiment : public Experiment {
           impl_.GenerateRandomValue(), impl_.GenerateRandomValue(),
       };
 
+      schedule.WaitUntilNextSlot();
       SimpleTimer timer;
       timer.Start();
 
@@ -1512,8 +1566,9 @@ class MutationExperiment : public Experiment {
               values[3], values[4], values[5], values[6], values[7], values[8],
               values[9])});
       timer.Stop();
+      auto const latency = schedule.OpenLoopLatency(timer.elapsed_time());
       samples.push_back(RowCpuSample{
-          client_count, thread_count, false, row_count, timer.elapsed_time(),
+          client_count, thread_count, false, row_count, latency,
           timer.cpu_time(), std::move(commit_result).status()});
     }
     return samples;
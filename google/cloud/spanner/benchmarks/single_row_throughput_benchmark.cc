@@ -29,6 +29,7 @@ namespace {
 
 namespace spanner = ::google::cloud::spanner;
 using ::google::cloud::spanner_benchmarks::Config;
+using ::google::cloud::spanner_benchmarks::OperationSchedule;
 
 struct SingleRowThroughputSample {
   int client_count;
@@ -286,7 +287,8 @@ class InsertOrUpdateExperiment : public Experiment {
     auto start = std::chrono::steady_clock::now();
     for (auto& t : tasks) {
       t = std::async(std::launch::async, &InsertOrUpdateExperiment::RunTask,
-                     config, client, locked_random_key, error_sink);
+                     config, thread_count, client, locked_random_key,
+                     error_sink);
     }
     int insert_count = 0;
     for (auto& t : tasks) {
@@ -299,16 +301,19 @@ class InsertOrUpdateExperiment : public Experiment {
         std::chrono::duration_cast<std::chrono::microseconds>(elapsed)}});
   }
 
-  static int RunTask(Config const& config, spanner::Client client,
+  static int RunTask(Config const& config, int thread_count,
+                     spanner::Client client,
                      RandomKeyGenerator const& key_generator,
                      ErrorSink const& error_sink) {
     int count = 0;
     std::string value(1024, 'A');
     std::vector<google::cloud::Status> errors;
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = key_generator();
+      schedule.WaitUntilNextSlot();
       auto result =
           client.Commit(spanner::Mutations{spanner::MakeInsertOrUpdateMutation(
               "KeyValue", {"Key", "Data"}, key, value)});
@@ -379,7 +384,7 @@ class ReadExperiment : public Experiment {
     auto start = std::chrono::steady_clock::now();
     for (auto& t : tasks) {
       t = std::async(std::launch::async, &ReadExperiment::RunTask, config,
-                     client, locked_random_key, error_sink);
+                     thread_count, client, locked_random_key, error_sink);
     }
     int total_count = 0;
     for (auto& t : tasks) {
@@ -392,16 +397,19 @@ class ReadExperiment : public Experiment {
         std::chrono::duration_cast<std::chrono::microseconds>(elapsed)}});
   }
 
-  static int RunTask(Config const& config, spanner::Client client,
+  static int RunTask(Config const& config, int thread_count,
+                     spanner::Client client,
                      RandomKeyGenerator const& key_generator,
                      ErrorSink const& error_sink) {
     int count = 0;
     std::string value(1024, 'A');
     std::vector<google::cloud::Status> errors;
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = key_generator();
+      schedule.WaitUntilNextSlot();
       auto rows = client.Read("KeyValue",
                               spanner::KeySet().AddKey(spanner::MakeKey(key)),
                               {"Key", "Data"});
@@ -476,7 +484,7 @@ class UpdateDmlExperiment : public Experiment {
     auto start = std::chrono::steady_clock::now();
     for (auto& t : tasks) {
       t = std::async(std::launch::async, &UpdateDmlExperiment::RunTask, config,
-                     client, locked_random_key, error_sink);
+                     thread_count, client, locked_random_key, error_sink);
     }
     int insert_count = 0;
     for (auto& t : tasks) {
@@ -489,16 +497,19 @@ class UpdateDmlExperiment : public Experiment {
         std::chrono::duration_cast<std::chrono::microseconds>(elapsed)}});
   }
 
-  static int RunTask(Config const& config, spanner::Client client,
+  static int RunTask(Config const& config, int thread_count,
+                     spanner::Client client,
                      RandomKeyGenerator const& key_generator,
                      ErrorSink const& error_sink) {
     int count = 0;
     std::string value(1024, 'A');
     std::vector<google::cloud::Status> errors;
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = key_generator();
+      schedule.WaitUntilNextSlot();
       auto result =
           client.Commit([&client, key, &value](spanner::Transaction const& txn)
                             -> google::cloud::StatusOr<spanner::Mutations> {
@@ -577,7 +588,7 @@ class SelectExperiment : public Experiment {
     auto start = std::chrono::steady_clock::now();
     for (auto& t : tasks) {
       t = std::async(std::launch::async, &SelectExperiment::RunTask, config,
-                     client, locked_random_key, error_sink);
+                     thread_count, client, locked_random_key, error_sink);
     }
     int total_count = 0;
     for (auto& t : tasks) {
@@ -590,16 +601,19 @@ class SelectExperiment : public Experiment {
         std::chrono::duration_cast<std::chrono::microseconds>(elapsed)}});
   }
 
-  static int RunTask(Config const& config, spanner::Client client,
+  static int RunTask(Config const& config, int thread_count,
+                     spanner::Client client,
                      RandomKeyGenerator const& key_generator,
                      ErrorSink const& error_sink) {
     int count = 0;
     std::string value(1024, 'A');
     std::vector<google::cloud::Status> errors;
+    OperationSchedule schedule(config, thread_count);
     for (auto start = std::chrono::steady_clock::now(),
               deadline = start + config.iteration_duration;
          start < deadline; start = std::chrono::steady_clock::now()) {
       auto key = key_generator();
+      schedule.WaitUntilNextSlot();
       auto rows = client.ExecuteQuery(
           spanner::SqlStatement("SELECT Key, Data FROM KeyValue"
                                 " WHERE Key = @key",
@@ -143,6 +143,83 @@ void Bytes::Decoder::Iterator::Fill() {
 
 namespace internal {
 
+// Bulk base64 encoding of @p n octets at @p p into @p rep, which must be
+// empty. Processing whole 24-bit groups in a tight loop over contiguous
+// memory, with the output sized up front, is substantially faster than the
+// octet-at-a-time `Bytes::Encoder`, and gives the optimizer a loop it can
+// unroll or vectorize.
+void Base64Encode(std::string& rep, unsigned char const* p, std::size_t n) {
+  rep.resize((n + 2) / 3 * 4);
+  auto* out = &rep[0];
+  for (; n >= 3; p += 3, n -= 3) {
+    unsigned int const v = p[0] << 16 | p[1] << 8 | p[2];
+    *out++ = kIndexToChar[v >> 18];
+    *out++ = kIndexToChar[v >> 12 & 0x3f];
+    *out++ = kIndexToChar[v >> 6 & 0x3f];
+    *out++ = kIndexToChar[v & 0x3f];
+  }
+  switch (n) {
+    case 2: {
+      unsigned int const v = p[0] << 16 | p[1] << 8;
+      *out++ = kIndexToChar[v >> 18];
+      *out++ = kIndexToChar[v >> 12 & 0x3f];
+      *out++ = kIndexToChar[v >> 6 & 0x3f];
+      *out++ = kPadding;
+      break;
+    }
+    case 1: {
+      unsigned int const v = p[0] << 16;
+      *out++ = kIndexToChar[v >> 18];
+      *out++ = kIndexToChar[v >> 12 & 0x3f];
+      *out++ = kPadding;
+      *out++ = kPadding;
+      break;
+    }
+  }
+}
+
+// The number of octets encoded in @p rep, which must be valid base64.
+std::size_t Base64DecodedSize(std::string const& rep) {
+  auto size = rep.size() / 4 * 3;
+  if (!rep.empty() && rep[rep.size() - 1] == kPadding) {
+    --size;
+    if (rep[rep.size() - 2] == kPadding) --size;
+  }
+  return size;
+}
+
+// Bulk base64 decoding of @p rep, which must be valid base64, into @p out,
+// which must have room for `Base64DecodedSize(rep)` octets. See
+// `Base64Encode()` for why this outperforms the octet-at-a-time
+// `Bytes::Decoder`.
+void Base64Decode(std::string const& rep, unsigned char* out) {
+  auto const* p = reinterpret_cast<unsigned char const*>(rep.data());
+  auto const* ep = p + rep.size();
+  // Decode all but the final (possibly padded) 4-character chunk.
+  for (; ep - p > 4; p += 4) {
+    auto i0 = kCharToIndexExcessOne[p[0]] - 1;
+    auto i1 = kCharToIndexExcessOne[p[1]] - 1;
+    auto i2 = kCharToIndexExcessOne[p[2]] - 1;
+    auto i3 = kCharToIndexExcessOne[p[3]] - 1;
+    *out++ = i0 << 2 | i1 >> 4;
+    *out++ = i1 << 4 | i2 >> 2;
+    *out++ = i2 << 6 | i3;
+  }
+  if (p != ep) {
+    auto i0 = kCharToIndexExcessOne[p[0]] - 1;
+    auto i1 = kCharToIndexExcessOne[p[1]] - 1;
+    *out++ = i0 << 2 | i1 >> 4;
+    if (p[2] != kPadding) {
+      auto i2 = kCharToIndexExcessOne[p[2]] - 1;
+      *out++ = i1 << 4 | i2 >> 2;
+      if (p[3] != kPadding) {
+        auto i3 = kCharToIndexExcessOne[p[3]] - 1;
+        *out++ = i2 << 6 | i3;
+      }
+    }
+  }
+}
+
 // Construction from a base64-encoded US-ASCII `std::string`.
 StatusOr<Bytes> BytesFromBase64(std::string input) {
   auto* p = reinterpret_cast<unsigned char const*>(input.data());
@@ -22,6 +22,8 @@
 #include <iterator>
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -34,6 +36,31 @@ class Bytes;  // defined below
 namespace internal {
 StatusOr<Bytes> BytesFromBase64(std::string input);
 std::string BytesToBase64(Bytes b);
+
+/// @name Bulk base64 transcoding between octets and the `Bytes` rep.
+///@{
+void Base64Encode(std::string& rep, unsigned char const* p, std::size_t n);
+std::size_t Base64DecodedSize(std::string const& rep);
+void Base64Decode(std::string const& rep, unsigned char* p);
+///@}
+
+// Containers of octets with contiguous storage (e.g., `std::string` or
+// `std::vector<std::uint8_t>`) use the bulk transcoders above, which process
+// whole 24-bit groups instead of carrying state from octet to octet.
+template <typename Container, typename AlwaysVoid = void>
+struct IsContiguousByteContainer : std::false_type {};
+
+template <typename Container>
+struct IsContiguousByteContainer<
+    Container,
+    typename std::enable_if<
+        std::is_integral<typename Container::value_type>::value &&
+        sizeof(typename Container::value_type) == 1 &&
+        std::is_pointer<decltype(
+            std::declval<Container const&>().data())>::value &&
+        sizeof(decltype(std::declval<Container&>()[0])) == 1 &&
+        std::is_void<decltype(std::declval<Container&>().resize(
+            std::size_t{}))>::value>::type> : std::true_type {};
 }  // namespace internal
 
 /**
@@ -58,18 +85,50 @@ class Bytes {
     }
     if (encoder.len_ != 0) encoder.FlushAndPad();
   }
-  template <typename Container>
+  template <typename Container,
+            typename std::enable_if<
+                !internal::IsContiguousByteContainer<Container>::value,
+                int>::type = 0>
   explicit Bytes(Container const& c) : Bytes(std::begin(c), std::end(c)) {}
+
+  /// Overload for containers with contiguous storage, encoded in bulk.
+  template <typename Container,
+            typename std::enable_if<
+                internal::IsContiguousByteContainer<Container>::value,
+                int>::type = 0>
+  explicit Bytes(Container const& c) {
+    internal::Base64Encode(base64_rep_,
+                           reinterpret_cast<unsigned char const*>(c.data()),
+                           c.size());
+  }
   ///@}
 
   /// Conversion to a sequence of octets.  The `Container` must support
   /// construction from a range specified as a pair of input iterators.
-  template <typename Container>
+  template <typename Container,
+            typename std::enable_if<
+                !internal::IsContiguousByteContainer<Container>::value,
+                int>::type = 0>
   Container get() const {
     Decoder decoder(base64_rep_);
     return Container(decoder.begin(), decoder.end());
   }
 
+  /// Overload for containers with contiguous storage, decoded in bulk.
+  template <typename Container,
+            typename std::enable_if<
+                internal::IsContiguousByteContainer<Container>::value,
+                int>::type = 0>
+  Container get() const {
+    Container result;
+    result.resize(internal::Base64DecodedSize(base64_rep_));
+    if (!result.empty()) {
+      internal::Base64Decode(base64_rep_,
+                             reinterpret_cast<unsigned char*>(&result[0]));
+    }
+    return result;
+  }
+
   /// @name Relational operators
   ///@{
   friend bool operator==(Bytes const& a, Bytes const& b) {
@@ -0,0 +1,207 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/columnar_batch.h"
+#include "google/cloud/spanner/internal/partial_result_set_source.h"
+#include "google/cloud/spanner/value.h"
+#include "google/cloud/internal/strerror.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+Status ColumnarBatch::Initialize(
+    google::spanner::v1::ResultSetMetadata const& metadata) {
+  auto const& fields = metadata.row_type().fields();
+  if (fields.empty()) {
+    return Status(StatusCode::kInternal,
+                  "response metadata is missing row type information");
+  }
+  columns_.reserve(fields.size());
+  for (auto const& field : fields) {
+    switch (field.type().code()) {
+      case google::spanner::v1::TypeCode::BOOL:
+      case google::spanner::v1::TypeCode::INT64:
+      case google::spanner::v1::TypeCode::FLOAT64:
+      case google::spanner::v1::TypeCode::STRING:
+      case google::spanner::v1::TypeCode::BYTES:
+      case google::spanner::v1::TypeCode::TIMESTAMP:
+      case google::spanner::v1::TypeCode::DATE:
+      case google::spanner::v1::TypeCode::NUMERIC:
+        break;
+      default:
+        return Status(
+            StatusCode::kUnimplemented,
+            "NextBatch() does not support columns of type " +
+                google::spanner::v1::TypeCode_Name(field.type().code()));
+    }
+    Column column;
+    column.name = field.name();
+    column.type = field.type().code();
+    columns_.push_back(std::move(column));
+  }
+  return {};  // OK
+}
+
+Status ColumnarBatch::AppendCell(std::size_t column,
+                                 google::protobuf::Value&& value) {
+  auto& col = columns_[column];
+  if (value.kind_case() == google::protobuf::Value::kNullValue) {
+    col.is_null.push_back(true);
+    switch (col.type) {
+      case google::spanner::v1::TypeCode::BOOL:
+        col.bools.push_back(false);
+        break;
+      case google::spanner::v1::TypeCode::INT64:
+        col.int64s.push_back(0);
+        break;
+      case google::spanner::v1::TypeCode::FLOAT64:
+        col.float64s.push_back(0.0);
+        break;
+      default:
+        col.strings.emplace_back();
+        break;
+    }
+    return {};  // OK
+  }
+  col.is_null.push_back(false);
+  switch (col.type) {
+    case google::spanner::v1::TypeCode::BOOL: {
+      if (value.kind_case() != google::protobuf::Value::kBoolValue) {
+        return Status(StatusCode::kUnknown, "missing BOOL");
+      }
+      col.bools.push_back(value.bool_value());
+      return {};  // OK
+    }
+    case google::spanner::v1::TypeCode::INT64: {
+      if (value.kind_case() != google::protobuf::Value::kStringValue) {
+        return Status(StatusCode::kUnknown, "missing INT64");
+      }
+      auto const& s = value.string_value();
+      char* end = nullptr;
+      errno = 0;
+      std::int64_t x = {std::strtoll(s.c_str(), &end, 10)};
+      if (errno != 0) {
+        return Status(
+            StatusCode::kUnknown,
+            google::cloud::internal::strerror(errno) + ": \"" + s + "\"");
+      }
+      if (end == s.c_str()) {
+        return Status(StatusCode::kUnknown,
+                      "No numeric conversion: \"" + s + "\"");
+      }
+      if (*end != '\0') {
+        return Status(StatusCode::kUnknown, "Trailing data: \"" + s + "\"");
+      }
+      col.int64s.push_back(x);
+      return {};  // OK
+    }
+    case google::spanner::v1::TypeCode::FLOAT64: {
+      if (value.kind_case() == google::protobuf::Value::kNumberValue) {
+        col.float64s.push_back(value.number_value());
+        return {};  // OK
+      }
+      if (value.kind_case() != google::protobuf::Value::kStringValue) {
+        return Status(StatusCode::kUnknown, "missing FLOAT64");
+      }
+      std::string const& s = value.string_value();
+      auto const inf = std::numeric_limits<double>::infinity();
+      if (s == "-Infinity") {
+        col.float64s.push_back(-inf);
+      } else if (s == "Infinity") {
+        col.float64s.push_back(inf);
+      } else if (s == "NaN") {
+        col.float64s.push_back(std::nan(""));
+      } else {
+        return Status(StatusCode::kUnknown, "bad FLOAT64 data: \"" + s + "\"");
+      }
+      return {};  // OK
+    }
+    default: {
+      // STRING, BYTES, TIMESTAMP, DATE, and NUMERIC values all travel as
+      // strings; keep the wire form and let the caller convert as needed.
+      if (value.kind_case() != google::protobuf::Value::kStringValue) {
+        return Status(StatusCode::kUnknown, "missing STRING");
+      }
+      col.strings.push_back(std::move(*value.mutable_string_value()));
+      return {};  // OK
+    }
+  }
+}
+
+StatusOr<ColumnarBatch> NextBatch(RowStream& stream, std::size_t max_rows) {
+  ColumnarBatch batch;
+  auto* source = internal::RowStreamInternals::GetSourcePointer(stream);
+  // A default-constructed `RowStream` has no rows to offer.
+  if (source == nullptr) return batch;
+
+  auto metadata = source->Metadata();
+  if (!metadata) {
+    return Status(StatusCode::kInternal, "response contained no metadata");
+  }
+  auto status = batch.Initialize(*metadata);
+  if (!status.ok()) return status;
+  if (max_rows == 0) max_rows = 1;
+
+  // When the stream is fed by the gRPC `PartialResultSet` reader, decode the
+  // raw value protos directly; other sources (e.g. mocks, prefetch wrappers)
+  // fall back to row-at-a-time iteration below.
+  auto* fast = dynamic_cast<internal::PartialResultSetSource*>(source);
+  if (fast != nullptr) {
+    std::vector<google::protobuf::Value> row;
+    while (batch.rows_ != max_rows) {
+      auto more = fast->NextRowProtos(row);
+      if (!more) return std::move(more).status();
+      if (!*more) break;
+      if (row.size() != batch.columns()) {
+        return Status(StatusCode::kInternal,
+                      "row width does not match the result metadata");
+      }
+      for (std::size_t i = 0; i != row.size(); ++i) {
+        auto append = batch.AppendCell(i, std::move(row[i]));
+        if (!append.ok()) return append;
+      }
+      ++batch.rows_;
+    }
+    return batch;
+  }
+
+  while (batch.rows_ != max_rows) {
+    auto row = source->NextRow();
+    if (!row) return std::move(row).status();
+    if (row->size() == 0) break;
+    if (row->size() != batch.columns()) {
+      return Status(StatusCode::kInternal,
+                    "row width does not match the result metadata");
+    }
+    auto values = std::move(*row).values();
+    for (std::size_t i = 0; i != values.size(); ++i) {
+      auto append = batch.AppendCell(
+          i, internal::ValueInternals::ToValueProto(std::move(values[i])));
+      if (!append.ok()) return append;
+    }
+    ++batch.rows_;
+  }
+  return batch;
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
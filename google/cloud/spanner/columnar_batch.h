@@ -0,0 +1,146 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_COLUMNAR_BATCH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_COLUMNAR_BATCH_H
+
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status_or.h"
+#include <google/spanner/v1/type.pb.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+class ColumnarBatch;
+
+/**
+ * Decodes up to @p max_rows rows from @p stream into a column-major
+ * `ColumnarBatch`.
+ *
+ * Iterating a `RowStream` materializes a `Row` of `Value` objects for every
+ * row, which is convenient but costs an allocation-heavy conversion per cell.
+ * `NextBatch()` instead decodes the values from the underlying
+ * `PartialResultSet` responses directly into one contiguous vector per
+ * column (plus a null bitmap), skipping the `Row` and `Value` machinery.
+ * This suits analytical consumers that process results a column at a time.
+ *
+ * Call `NextBatch()` repeatedly to consume the stream in batches; a batch
+ * with `rows() == 0` indicates the end of the stream. Do not mix calls to
+ * `NextBatch()` with direct iteration of the same stream.
+ *
+ * Only scalar column types are supported; `NextBatch()` returns
+ * `StatusCode::kUnimplemented` if the result contains an `ARRAY` or `STRUCT`
+ * column.
+ */
+StatusOr<ColumnarBatch> NextBatch(RowStream& stream,
+                                  std::size_t max_rows = 1000);
+
+/**
+ * A column-major slice of a result set.
+ *
+ * Each column holds its values in a single contiguous vector, chosen by the
+ * column's type:
+ *
+ * - `BOOL` columns use `bool_values()`
+ * - `INT64` columns use `int64_values()`
+ * - `FLOAT64` columns use `float64_values()`
+ * - `STRING`, `BYTES`, `TIMESTAMP`, `DATE`, and `NUMERIC` columns use
+ *   `string_values()`, holding each value in its wire (string) form.
+ *
+ * `NULL` cells occupy a default-constructed slot in the column's vector and
+ * are flagged in `nulls()`. All accessors taking a column index require
+ * `i < columns()`.
+ */
+class ColumnarBatch {
+ public:
+  ColumnarBatch() = default;
+
+  /// Returns the number of rows in this batch.
+  std::size_t rows() const { return rows_; }
+
+  /// Returns the number of columns in the result set.
+  std::size_t columns() const { return columns_.size(); }
+
+  /// Returns the name of column @p i.
+  std::string const& column_name(std::size_t i) const {
+    return columns_[i].name;
+  }
+
+  /// Returns the type of column @p i.
+  google::spanner::v1::TypeCode column_type(std::size_t i) const {
+    return columns_[i].type;
+  }
+
+  /// Returns the null bitmap for column @p i, one entry per row.
+  std::vector<bool> const& nulls(std::size_t i) const {
+    return columns_[i].is_null;
+  }
+
+  /// Returns the values of `BOOL` column @p i; empty for other types.
+  std::vector<bool> const& bool_values(std::size_t i) const {
+    return columns_[i].bools;
+  }
+
+  /// Returns the values of `INT64` column @p i; empty for other types.
+  std::vector<std::int64_t> const& int64_values(std::size_t i) const {
+    return columns_[i].int64s;
+  }
+
+  /// Returns the values of `FLOAT64` column @p i; empty for other types.
+  std::vector<double> const& float64_values(std::size_t i) const {
+    return columns_[i].float64s;
+  }
+
+  /**
+   * Returns the values of a string-typed column @p i in wire form; empty for
+   * other types.
+   */
+  std::vector<std::string> const& string_values(std::size_t i) const {
+    return columns_[i].strings;
+  }
+
+ private:
+  friend StatusOr<ColumnarBatch> NextBatch(RowStream& stream,
+                                           std::size_t max_rows);
+
+  struct Column {
+    std::string name;
+    google::spanner::v1::TypeCode type;
+    std::vector<bool> is_null;
+    std::vector<bool> bools;
+    std::vector<std::int64_t> int64s;
+    std::vector<double> float64s;
+    std::vector<std::string> strings;
+  };
+
+  Status Initialize(google::spanner::v1::ResultSetMetadata const& metadata);
+  Status AppendCell(std::size_t column, google::protobuf::Value&& value);
+
+  std::size_t rows_ = 0;
+  std::vector<Column> columns_;
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_COLUMNAR_BATCH_H
@@ -0,0 +1,265 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/columnar_batch.h"
+#include "google/cloud/spanner/internal/partial_result_set_source.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/testing/mock_partial_result_set_reader.h"
+#include "google/cloud/spanner/value.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::google::cloud::spanner_testing::MockPartialResultSetReader;
+using ::google::protobuf::TextFormat;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::Return;
+
+// Creates a `RowStream` fed by a real `PartialResultSetSource` replaying the
+// given responses, so `NextBatch()` exercises the raw-proto decode path.
+RowStream MakeSourceStream(
+    std::vector<spanner_proto::PartialResultSet> responses) {
+  auto grpc_reader = absl::make_unique<MockPartialResultSetReader>();
+  auto& read = EXPECT_CALL(*grpc_reader, Read());
+  for (auto& response : responses) {
+    read.WillOnce(Return(std::move(response)));
+  }
+  read.WillOnce(Return(absl::optional<spanner_proto::PartialResultSet>{}));
+  EXPECT_CALL(*grpc_reader, Finish()).WillOnce(Return(Status()));
+  auto source =
+      internal::PartialResultSetSource::Create(std::move(grpc_reader));
+  EXPECT_STATUS_OK(source);
+  return RowStream(*std::move(source));
+}
+
+spanner_proto::PartialResultSet MakeResponse(std::string const& text) {
+  spanner_proto::PartialResultSet response;
+  EXPECT_TRUE(TextFormat::ParseFromString(text, &response));
+  return response;
+}
+
+TEST(ColumnarBatchTest, DecodesScalarTypesFromSource) {
+  auto stream = MakeSourceStream({MakeResponse(R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "Flag",
+          type: { code: BOOL }
+        }
+        fields: {
+          name: "Count",
+          type: { code: INT64 }
+        }
+        fields: {
+          name: "Weight",
+          type: { code: FLOAT64 }
+        }
+        fields: {
+          name: "Name",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { bool_value: true }
+    values: { string_value: "42" }
+    values: { number_value: 1.5 }
+    values: { string_value: "Ann" }
+    values: { bool_value: false }
+    values: { string_value: "-7" }
+    values: { number_value: 2.5 }
+    values: { string_value: "Bob" }
+  )pb")});
+
+  auto batch = NextBatch(stream);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(batch->rows(), 2);
+  ASSERT_EQ(batch->columns(), 4);
+  EXPECT_EQ(batch->column_name(0), "Flag");
+  EXPECT_EQ(batch->column_name(3), "Name");
+  EXPECT_EQ(batch->column_type(1), spanner_proto::TypeCode::INT64);
+  EXPECT_THAT(batch->bool_values(0), ElementsAre(true, false));
+  EXPECT_THAT(batch->int64_values(1), ElementsAre(42, -7));
+  EXPECT_THAT(batch->float64_values(2), ElementsAre(1.5, 2.5));
+  EXPECT_THAT(batch->string_values(3), ElementsAre("Ann", "Bob"));
+  EXPECT_THAT(batch->nulls(1), ElementsAre(false, false));
+
+  // The stream is exhausted; the next batch is empty.
+  auto next = NextBatch(stream);
+  ASSERT_STATUS_OK(next);
+  EXPECT_EQ(next->rows(), 0);
+}
+
+TEST(ColumnarBatchTest, NullCellsFlaggedInBitmap) {
+  auto stream = MakeSourceStream({MakeResponse(R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "Count",
+          type: { code: INT64 }
+        }
+        fields: {
+          name: "Name",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "1" }
+    values: { null_value: NULL_VALUE }
+    values: { null_value: NULL_VALUE }
+    values: { string_value: "Bob" }
+  )pb")});
+
+  auto batch = NextBatch(stream);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(batch->rows(), 2);
+  EXPECT_THAT(batch->nulls(0), ElementsAre(false, true));
+  EXPECT_THAT(batch->nulls(1), ElementsAre(true, false));
+  // NULL cells occupy a default-constructed slot in the value vectors.
+  EXPECT_THAT(batch->int64_values(0), ElementsAre(1, 0));
+  EXPECT_THAT(batch->string_values(1), ElementsAre("", "Bob"));
+}
+
+TEST(ColumnarBatchTest, HonorsMaxRows) {
+  auto stream = MakeSourceStream({MakeResponse(R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "Count",
+          type: { code: INT64 }
+        }
+      }
+    }
+    values: { string_value: "1" }
+    values: { string_value: "2" }
+    values: { string_value: "3" }
+  )pb")});
+
+  auto batch = NextBatch(stream, 2);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_THAT(batch->int64_values(0), ElementsAre(1, 2));
+
+  batch = NextBatch(stream, 2);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_THAT(batch->int64_values(0), ElementsAre(3));
+
+  batch = NextBatch(stream, 2);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(batch->rows(), 0);
+}
+
+TEST(ColumnarBatchTest, UnsupportedColumnType) {
+  auto stream = MakeSourceStream({MakeResponse(R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "Tags",
+          type: {
+            code: ARRAY
+            array_element_type: { code: STRING }
+          }
+        }
+      }
+    }
+  )pb")});
+
+  auto batch = NextBatch(stream);
+  EXPECT_EQ(batch.status().code(), StatusCode::kUnimplemented);
+  EXPECT_THAT(batch.status().message(), HasSubstr("ARRAY"));
+}
+
+TEST(ColumnarBatchTest, FallbackPathDecodesRows) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  spanner_proto::ResultSetMetadata metadata;
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(
+        row_type: {
+          fields: {
+            name: "Count",
+            type: { code: INT64 }
+          }
+          fields: {
+            name: "Name",
+            type: { code: STRING }
+          }
+        }
+      )pb",
+      &metadata));
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(metadata));
+  EXPECT_CALL(*source, NextRow())
+      .WillOnce(Return(
+          MakeTestRow({{"Count", Value(1)}, {"Name", Value("Ann")}})))
+      .WillOnce(Return(MakeTestRow(
+          {{"Count", Value(2)},
+           {"Name", Value(absl::optional<std::string>{})}})))
+      .WillOnce(Return(Row()));
+
+  RowStream stream(std::move(source));
+  auto batch = NextBatch(stream);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(batch->rows(), 2);
+  EXPECT_THAT(batch->int64_values(0), ElementsAre(1, 2));
+  EXPECT_THAT(batch->string_values(1), ElementsAre("Ann", ""));
+  EXPECT_THAT(batch->nulls(1), ElementsAre(false, true));
+}
+
+TEST(ColumnarBatchTest, PropagatesStreamErrors) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  spanner_proto::ResultSetMetadata metadata;
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(
+        row_type: {
+          fields: {
+            name: "Count",
+            type: { code: INT64 }
+          }
+        }
+      )pb",
+      &metadata));
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(metadata));
+  EXPECT_CALL(*source, NextRow())
+      .WillOnce(Return(Status(StatusCode::kUnavailable, "try again")));
+
+  RowStream stream(std::move(source));
+  auto batch = NextBatch(stream);
+  EXPECT_EQ(batch.status().code(), StatusCode::kUnavailable);
+}
+
+TEST(ColumnarBatchTest, DefaultConstructedStream) {
+  RowStream stream;
+  auto batch = NextBatch(stream);
+  ASSERT_STATUS_OK(batch);
+  EXPECT_EQ(batch->rows(), 0);
+  EXPECT_EQ(batch->columns(), 0);
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -28,10 +28,12 @@
 #include "google/cloud/spanner/sql_statement.h"
 #include "google/cloud/spanner/transaction.h"
 #include "google/cloud/spanner/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/optional.h"
 #include "google/cloud/status_or.h"
 #include "absl/types/optional.h"
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace google {
@@ -160,6 +162,18 @@ class Connection {
   /// Defines the interface for `Client::Commit()`
   virtual StatusOr<CommitResult> Commit(CommitParams) = 0;
 
+  /**
+   * Like `Commit()`, but returns a `future<>` so a few threads can keep many
+   * commits in flight.
+   *
+   * The default implementation simply blocks on `Commit()`; the connections
+   * created by `MakeConnection()` override it to drive the commit RPC from
+   * their background `CompletionQueue`.
+   */
+  virtual future<StatusOr<CommitResult>> AsyncCommit(CommitParams params) {
+    return make_ready_future(Commit(std::move(params)));
+  }
+
   /// Defines the interface for `Client::Rollback()`
   virtual Status Rollback(RollbackParams) = 0;
 };
@@ -0,0 +1,67 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/dml_batcher.h"
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+Status DmlBatcher::Add(SqlStatement statement) {
+  auto const size = internal::ToProto(statement).ByteSizeLong();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (statements_.empty()) batch_start_ = std::chrono::steady_clock::now();
+  statements_.push_back(std::move(statement));
+  batch_bytes_ += size;
+  bool const flush =
+      statements_.size() >= options_.max_statements_per_batch() ||
+      batch_bytes_ >= options_.max_bytes_per_batch() ||
+      std::chrono::steady_clock::now() - batch_start_ >=
+          options_.max_batch_latency();
+  if (!flush) return Status();
+  return FlushImpl(std::move(lk));
+}
+
+Status DmlBatcher::Flush() {
+  return FlushImpl(std::unique_lock<std::mutex>(mu_));
+}
+
+std::int64_t DmlBatcher::modified_row_count() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return modified_row_count_;
+}
+
+Status DmlBatcher::FlushImpl(std::unique_lock<std::mutex> lk) {
+  if (statements_.empty()) return Status();
+  std::vector<SqlStatement> statements;
+  statements.swap(statements_);
+  batch_bytes_ = 0;
+  // Release the lock during the RPC so other threads can buffer statements.
+  // Note that batches from concurrent flushes execute in an unspecified
+  // order, just like concurrently added statements do.
+  lk.unlock();
+  auto result = client_.ExecuteBatchDml(transaction_, std::move(statements));
+  if (!result) return std::move(result).status();
+  std::int64_t count = 0;
+  for (auto const& stats : result->stats) count += stats.row_count;
+  lk.lock();
+  modified_row_count_ += count;
+  return result->status;
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
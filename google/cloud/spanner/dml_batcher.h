@@ -0,0 +1,172 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/transaction.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Controls when a `DmlBatcher` flushes its buffered statements.
+ *
+ * Use the setters in this class to control the maximum number of statements,
+ * the maximum request size, and the maximum time statements are held before
+ * the batcher executes them in a `Client::ExecuteBatchDml()` call.
+ */
+class DmlBatcherOptions {
+ public:
+  DmlBatcherOptions() = default;
+
+  /// A single `ExecuteBatchDml()` call will not have more statements.
+  DmlBatcherOptions& set_max_statements_per_batch(std::size_t count) {
+    max_statements_per_batch_ = (std::max<std::size_t>)(count, 1);
+    return *this;
+  }
+  std::size_t max_statements_per_batch() const {
+    return max_statements_per_batch_;
+  }
+
+  /**
+   * The buffered statements are flushed once their total serialized size
+   * reaches this limit. A single statement larger than the limit is still
+   * executed, in its own batch.
+   */
+  DmlBatcherOptions& set_max_bytes_per_batch(std::size_t bytes) {
+    max_bytes_per_batch_ = bytes;
+    return *this;
+  }
+  std::size_t max_bytes_per_batch() const { return max_bytes_per_batch_; }
+
+  /**
+   * Buffered statements older than this limit are flushed by the next
+   * `DmlBatcher::Add()` call.
+   *
+   * The batcher has no background threads, so this limit is only checked
+   * when the application adds a statement; use `DmlBatcher::Flush()` to
+   * execute statements buffered after the last `Add()`.
+   */
+  DmlBatcherOptions& set_max_batch_latency(std::chrono::milliseconds limit) {
+    max_batch_latency_ = limit;
+    return *this;
+  }
+  std::chrono::milliseconds max_batch_latency() const {
+    return max_batch_latency_;
+  }
+
+ private:
+  std::size_t max_statements_per_batch_ = 128;
+  std::size_t max_bytes_per_batch_ = 1024 * 1024;
+  std::chrono::milliseconds max_batch_latency_ =
+      std::chrono::milliseconds(100);
+};
+
+/**
+ * Packs DML statements into `Client::ExecuteBatchDml()` calls.
+ *
+ * Executing DML statements one at a time pays one round trip per statement.
+ * Applications that issue many small DML statements within a transaction can
+ * use this class to accumulate the statements and execute them in batches,
+ * which improves write throughput per session.
+ *
+ * Statements added with `Add()` are buffered and flushed automatically once
+ * the batch reaches the configured statement count, request size, or age
+ * (see `DmlBatcherOptions`). Applications must call `Flush()` to execute any
+ * remaining statements before committing the transaction.
+ *
+ * As with `Client::ExecuteBatchDml()`, the statements in a batch are executed
+ * serially, and execution stops at the first statement that fails. `Add()`
+ * and `Flush()` return the status of any batch they execute; after a failure
+ * the remaining buffered statements are discarded.
+ *
+ * @par Example
+ * @code
+ * void InsertAll(spanner::Client client, spanner::Transaction txn,
+ *                std::vector<spanner::SqlStatement> statements) {
+ *   spanner::DmlBatcher batcher(std::move(client), std::move(txn));
+ *   for (auto& statement : statements) {
+ *     auto status = batcher.Add(std::move(statement));
+ *     if (!status.ok()) return;  // handle error
+ *   }
+ *   auto status = batcher.Flush();
+ *   // handle error, commit the transaction, etc.
+ * }
+ * @endcode
+ *
+ * @par Thread Safety
+ *
+ * Instances of this class are thread safe, though note that the order in
+ * which concurrently added statements execute is unspecified.
+ */
+class DmlBatcher {
+ public:
+  DmlBatcher(Client client, Transaction transaction,
+             DmlBatcherOptions options = DmlBatcherOptions())
+      : client_(std::move(client)),
+        transaction_(std::move(transaction)),
+        options_(std::move(options)) {}
+
+  // Copies would execute the buffered statements more than once.
+  DmlBatcher(DmlBatcher const&) = delete;
+  DmlBatcher& operator=(DmlBatcher const&) = delete;
+
+  /**
+   * Buffers @p statement for execution, flushing the current batch if it has
+   * reached any of the configured limits.
+   *
+   * @return the status of the flushed batch, if any; otherwise OK.
+   */
+  Status Add(SqlStatement statement);
+
+  /// Executes any buffered statements.
+  Status Flush();
+
+  /// The total number of rows modified by the batches executed so far.
+  std::int64_t modified_row_count() const;
+
+ private:
+  Status FlushImpl(std::unique_lock<std::mutex> lk);
+
+  Client client_;
+  Transaction transaction_;
+  DmlBatcherOptions options_;
+
+  mutable std::mutex mu_;
+  std::vector<SqlStatement> statements_;  // GUARDED_BY(mu_)
+  std::size_t batch_bytes_ = 0;           // GUARDED_BY(mu_)
+  // The time the oldest buffered statement was added.
+  std::chrono::steady_clock::time_point batch_start_;  // GUARDED_BY(mu_)
+  std::int64_t modified_row_count_ = 0;                // GUARDED_BY(mu_)
+};
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_DML_BATCHER_H
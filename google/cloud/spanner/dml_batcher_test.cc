@@ -0,0 +1,149 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/dml_batcher.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::testing::_;
+using ::testing::Return;
+
+BatchDmlResult MakeResult(std::vector<std::int64_t> row_counts) {
+  BatchDmlResult result;
+  for (auto count : row_counts) {
+    result.stats.push_back(BatchDmlResult::Stats{count});
+  }
+  return result;
+}
+
+// Use a large latency limit so only the count/bytes limits apply.
+std::chrono::milliseconds TestLatency() {
+  return std::chrono::milliseconds(std::chrono::hours(1));
+}
+
+TEST(DmlBatcherTest, FlushesByStatementCount) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .WillOnce([](Connection::ExecuteBatchDmlParams params) {
+        EXPECT_EQ(2, params.statements.size());
+        return MakeResult({10, 10});
+      })
+      .WillOnce([](Connection::ExecuteBatchDmlParams params) {
+        EXPECT_EQ(1, params.statements.size());
+        return MakeResult({10});
+      });
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction(),
+                     DmlBatcherOptions()
+                         .set_max_statements_per_batch(2)
+                         .set_max_batch_latency(TestLatency()));
+  for (int i = 0; i != 3; ++i) {
+    EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 1")));
+  }
+  EXPECT_STATUS_OK(batcher.Flush());
+  EXPECT_EQ(30, batcher.modified_row_count());
+}
+
+TEST(DmlBatcherTest, FlushesByBatchSize) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .Times(2)
+      .WillRepeatedly([](Connection::ExecuteBatchDmlParams params) {
+        EXPECT_EQ(1, params.statements.size());
+        return MakeResult({1});
+      });
+
+  // Every statement is larger than the limit, so each is its own batch.
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction(),
+                     DmlBatcherOptions()
+                         .set_max_bytes_per_batch(1)
+                         .set_max_batch_latency(TestLatency()));
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 1")));
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 2")));
+  EXPECT_STATUS_OK(batcher.Flush());
+  EXPECT_EQ(2, batcher.modified_row_count());
+}
+
+TEST(DmlBatcherTest, FlushesByLatency) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .Times(2)
+      .WillRepeatedly([](Connection::ExecuteBatchDmlParams params) {
+        EXPECT_EQ(1, params.statements.size());
+        return MakeResult({1});
+      });
+
+  // A zero latency limit makes every `Add()` flush immediately.
+  DmlBatcher batcher(
+      Client(conn), MakeReadWriteTransaction(),
+      DmlBatcherOptions().set_max_batch_latency(std::chrono::milliseconds(0)));
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 1")));
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 2")));
+  EXPECT_STATUS_OK(batcher.Flush());
+  EXPECT_EQ(2, batcher.modified_row_count());
+}
+
+TEST(DmlBatcherTest, EmptyFlushIsANoop) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_)).Times(0);
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  EXPECT_STATUS_OK(batcher.Flush());
+  EXPECT_EQ(0, batcher.modified_row_count());
+}
+
+TEST(DmlBatcherTest, ReportsFailedStatements) {
+  BatchDmlResult result = MakeResult({42});
+  result.status = Status(StatusCode::kInvalidArgument, "oops");
+
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_)).WillOnce(Return(result));
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 1")));
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("this is not valid DML")));
+  auto status = batcher.Flush();
+  EXPECT_EQ(StatusCode::kInvalidArgument, status.code());
+  // The rows modified before the failed statement are still counted.
+  EXPECT_EQ(42, batcher.modified_row_count());
+}
+
+TEST(DmlBatcherTest, ReportsFailedRpcs) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteBatchDml(_))
+      .WillOnce(
+          Return(StatusOr<BatchDmlResult>(Status(StatusCode::kAborted, ""))));
+
+  DmlBatcher batcher(Client(conn), MakeReadWriteTransaction());
+  EXPECT_STATUS_OK(batcher.Add(SqlStatement("UPDATE Foo SET Bar = 1")));
+  auto status = batcher.Flush();
+  EXPECT_EQ(StatusCode::kAborted, status.code());
+  EXPECT_EQ(0, batcher.modified_row_count());
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,96 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/async_row_source.h"
+#include "absl/memory/memory.h"
+#include <grpcpp/grpcpp.h>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+future<Status> AsyncRowSource::Start(google::cloud::CompletionQueue cq,
+                                     std::shared_ptr<SpannerStub> stub,
+                                     spanner_proto::ExecuteSqlRequest request,
+                                     RowCallback on_row) {
+  std::shared_ptr<AsyncRowSource> source(
+      new AsyncRowSource(std::move(on_row)));
+  auto result = source->promise_.get_future();
+  cq.MakeStreamingReadRpc(
+      [stub](grpc::ClientContext* context,
+             spanner_proto::ExecuteSqlRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return stub->AsyncExecuteStreamingSql(*context, request, cq);
+      },
+      request, absl::make_unique<grpc::ClientContext>(),
+      [source](spanner_proto::PartialResultSet result_set) {
+        return source->OnRead(std::move(result_set));
+      },
+      [source](Status status) { source->OnFinish(std::move(status)); });
+  return result;
+}
+
+future<bool> AsyncRowSource::OnRead(
+    spanner_proto::PartialResultSet result_set) {
+  auto status = assembler_.Push(std::move(result_set));
+  if (!status.ok()) {
+    assembly_status_ = std::move(status);
+    return make_ready_future(false);
+  }
+  for (;;) {
+    auto row = assembler_.PopRow();
+    if (!row) {
+      assembly_status_ = std::move(row).status();
+      return make_ready_future(false);
+    }
+    if (row->size() == 0) break;
+    if (!on_row_(*std::move(row))) {
+      cancelled_ = true;
+      return make_ready_future(false);
+    }
+  }
+  return make_ready_future(true);
+}
+
+void AsyncRowSource::OnFinish(Status status) {
+  if (!assembly_status_.ok()) {
+    promise_.set_value(std::move(assembly_status_));
+    return;
+  }
+  if (!cancelled_ && status.ok()) {
+    status = assembler_.CheckEndOfStream();
+    if (status.ok() && !assembler_.metadata()) {
+      status = Status(StatusCode::kInternal, "response contained no metadata");
+    }
+  }
+  promise_.set_value(std::move(status));
+}
+
+future<Status> AsyncExecuteQuery(google::cloud::CompletionQueue cq,
+                                 std::shared_ptr<SpannerStub> stub,
+                                 spanner_proto::ExecuteSqlRequest request,
+                                 AsyncRowSource::RowCallback on_row) {
+  return AsyncRowSource::Start(std::move(cq), std::move(stub),
+                               std::move(request), std::move(on_row));
+}
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_ASYNC_ROW_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_ASYNC_ROW_SOURCE_H
+
+#include "google/cloud/spanner/internal/partial_result_set_assembler.h"
+#include "google/cloud/spanner/internal/spanner_stub.h"
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/completion_queue.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status.h"
+#include <google/spanner/v1/spanner.pb.h>
+#include <functional>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+/**
+ * Drives a streaming SQL query on a `CompletionQueue`.
+ *
+ * The rows are assembled from the `PartialResultSet` responses as they arrive
+ * and delivered through a callback; no thread blocks waiting for data. The
+ * callbacks are invoked by the threads running the completion queue's event
+ * loop, one at a time.
+ */
+class AsyncRowSource : public std::enable_shared_from_this<AsyncRowSource> {
+ public:
+  /**
+   * The per-row callback; return `false` to cancel the rest of the stream,
+   * in which case the future returned from `Start()` is typically satisfied
+   * with `StatusCode::kCancelled`.
+   */
+  using RowCallback = std::function<bool(Row)>;
+
+  /**
+   * Start the query described by @p request, invoking @p on_row for each row.
+   *
+   * The returned future is satisfied with the final status of the stream
+   * after the last `on_row` callback has completed.
+   */
+  static future<Status> Start(google::cloud::CompletionQueue cq,
+                              std::shared_ptr<SpannerStub> stub,
+                              google::spanner::v1::ExecuteSqlRequest request,
+                              RowCallback on_row);
+
+  // Callbacks keep pointers to these objects.
+  AsyncRowSource(AsyncRowSource const&) = delete;
+  AsyncRowSource& operator=(AsyncRowSource const&) = delete;
+
+ private:
+  explicit AsyncRowSource(RowCallback on_row) : on_row_(std::move(on_row)) {}
+
+  future<bool> OnRead(google::spanner::v1::PartialResultSet result_set);
+  void OnFinish(Status status);
+
+  RowCallback on_row_;
+  PartialResultSetAssembler assembler_;
+  // The first error detected while assembling rows, it overrides the stream's
+  // final status because canceling the stream reports `kCancelled`.
+  Status assembly_status_;
+  bool cancelled_ = false;
+  promise<Status> promise_;
+};
+
+/**
+ * Execute @p request as an asynchronous streaming query on @p cq.
+ *
+ * This is the asynchronous analogue of `Connection::ExecuteQuery()`: @p on_row
+ * is called for every row in the result, and the returned future is satisfied
+ * with the final status once the stream completes. Note that, unlike the
+ * synchronous API, interrupted streams are not automatically resumed.
+ */
+future<Status> AsyncExecuteQuery(google::cloud::CompletionQueue cq,
+                                 std::shared_ptr<SpannerStub> stub,
+                                 google::spanner::v1::ExecuteSqlRequest request,
+                                 AsyncRowSource::RowCallback on_row);
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_ASYNC_ROW_SOURCE_H
@@ -0,0 +1,213 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/async_row_source.h"
+#include "google/cloud/spanner/testing/mock_spanner_stub.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/mock_completion_queue.h"
+#include "absl/memory/memory.h"
+#include <google/protobuf/text_format.h>
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::MockCompletionQueue;
+using ::google::protobuf::TextFormat;
+using ::testing::_;
+using ::testing::ElementsAre;
+
+namespace spanner_proto = ::google::spanner::v1;
+
+class MockAsyncPartialResultSetReader
+    : public grpc::ClientAsyncReaderInterface<spanner_proto::PartialResultSet> {
+ public:
+  MOCK_METHOD1(StartCall, void(void*));
+  MOCK_METHOD1(ReadInitialMetadata, void(void*));
+  MOCK_METHOD2(Read, void(spanner_proto::PartialResultSet*, void*));
+  MOCK_METHOD2(Finish, void(grpc::Status*, void*));
+};
+
+spanner_proto::PartialResultSet MakeResponse(std::string const& text) {
+  spanner_proto::PartialResultSet response;
+  EXPECT_TRUE(TextFormat::ParseFromString(text, &response));
+  return response;
+}
+
+/// @test Verify rows are assembled and delivered as responses arrive.
+TEST(AsyncRowSourceTest, DeliverRows) {
+  auto grpc_reader = absl::make_unique<MockAsyncPartialResultSetReader>();
+  auto response = MakeResponse(R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "AlbumTitle",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "album1" }
+    values: { string_value: "album2" }
+  )pb");
+  EXPECT_CALL(*grpc_reader, StartCall(_)).Times(1);
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([&response](spanner_proto::PartialResultSet* r, void*) {
+        *r = response;
+      })
+      .WillOnce([](spanner_proto::PartialResultSet*, void*) {});
+  EXPECT_CALL(*grpc_reader, Finish(_, _))
+      .WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status::OK;
+      });
+
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  EXPECT_CALL(*mock, AsyncExecuteStreamingSql(_, _, _))
+      .WillOnce([&grpc_reader](grpc::ClientContext&,
+                               spanner_proto::ExecuteSqlRequest const& request,
+                               grpc::CompletionQueue*) {
+        EXPECT_EQ("SELECT AlbumTitle FROM Albums", request.sql());
+        return std::unique_ptr<grpc::ClientAsyncReaderInterface<
+            spanner_proto::PartialResultSet>>(grpc_reader.release());
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  google::cloud::CompletionQueue cq(impl);
+
+  spanner_proto::ExecuteSqlRequest request;
+  request.set_sql("SELECT AlbumTitle FROM Albums");
+
+  std::vector<std::string> titles;
+  auto result = AsyncExecuteQuery(cq, mock, request, [&titles](Row row) {
+    auto title = std::move(row).get<std::string>(0);
+    EXPECT_STATUS_OK(title);
+    titles.push_back(*std::move(title));
+    return true;
+  });
+
+  // Simulate the completions for StartCall(), both Read() calls (the second
+  // fails, indicating end of stream), and Finish().
+  impl->SimulateCompletion(true);
+  impl->SimulateCompletion(true);
+  EXPECT_THAT(titles, ElementsAre("album1", "album2"));
+  impl->SimulateCompletion(false);
+  impl->SimulateCompletion(true);
+
+  auto status = result.get();
+  EXPECT_STATUS_OK(status);
+}
+
+/// @test Verify returning `false` from the row callback cancels the stream.
+TEST(AsyncRowSourceTest, CancelThroughCallback) {
+  auto grpc_reader = absl::make_unique<MockAsyncPartialResultSetReader>();
+  auto response = MakeResponse(R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "AlbumTitle",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "album1" }
+  )pb");
+  EXPECT_CALL(*grpc_reader, StartCall(_)).Times(1);
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([&response](spanner_proto::PartialResultSet* r, void*) {
+        *r = response;
+      })
+      // The stream discards any pending messages after the cancel.
+      .WillOnce([](spanner_proto::PartialResultSet*, void*) {});
+  EXPECT_CALL(*grpc_reader, Finish(_, _))
+      .WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::CANCELLED, "cancelled");
+      });
+
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  EXPECT_CALL(*mock, AsyncExecuteStreamingSql(_, _, _))
+      .WillOnce([&grpc_reader](grpc::ClientContext&,
+                               spanner_proto::ExecuteSqlRequest const&,
+                               grpc::CompletionQueue*) {
+        return std::unique_ptr<grpc::ClientAsyncReaderInterface<
+            spanner_proto::PartialResultSet>>(grpc_reader.release());
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  google::cloud::CompletionQueue cq(impl);
+
+  int row_count = 0;
+  auto result = AsyncExecuteQuery(cq, mock, spanner_proto::ExecuteSqlRequest{},
+                                  [&row_count](Row) {
+                                    ++row_count;
+                                    return false;
+                                  });
+
+  impl->SimulateCompletion(true);
+  impl->SimulateCompletion(true);
+  EXPECT_EQ(1, row_count);
+  // The discard loop issues one more Read(), fail it, then complete Finish().
+  impl->SimulateCompletion(false);
+  impl->SimulateCompletion(true);
+
+  auto status = result.get();
+  EXPECT_EQ(StatusCode::kCancelled, status.code());
+}
+
+/// @test Verify the final status reflects a failed stream.
+TEST(AsyncRowSourceTest, StreamFailure) {
+  auto grpc_reader = absl::make_unique<MockAsyncPartialResultSetReader>();
+  EXPECT_CALL(*grpc_reader, StartCall(_)).Times(1);
+  EXPECT_CALL(*grpc_reader, Read(_, _))
+      .WillOnce([](spanner_proto::PartialResultSet*, void*) {});
+  EXPECT_CALL(*grpc_reader, Finish(_, _))
+      .WillOnce([](grpc::Status* status, void*) {
+        *status = grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh");
+      });
+
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  EXPECT_CALL(*mock, AsyncExecuteStreamingSql(_, _, _))
+      .WillOnce([&grpc_reader](grpc::ClientContext&,
+                               spanner_proto::ExecuteSqlRequest const&,
+                               grpc::CompletionQueue*) {
+        return std::unique_ptr<grpc::ClientAsyncReaderInterface<
+            spanner_proto::PartialResultSet>>(grpc_reader.release());
+      });
+
+  auto impl = std::make_shared<MockCompletionQueue>();
+  google::cloud::CompletionQueue cq(impl);
+
+  auto result = AsyncExecuteQuery(cq, mock, spanner_proto::ExecuteSqlRequest{},
+                                  [](Row) { return true; });
+
+  impl->SimulateCompletion(true);
+  impl->SimulateCompletion(false);
+  impl->SimulateCompletion(true);
+
+  auto status = result.get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, status.code());
+  EXPECT_EQ("uh-oh", status.message());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
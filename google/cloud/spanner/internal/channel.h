@@ -17,6 +17,7 @@
 
 #include "google/cloud/spanner/internal/spanner_stub.h"
 #include "google/cloud/spanner/version.h"
+#include <atomic>
 #include <memory>
 
 namespace google {
@@ -39,6 +40,11 @@ struct Channel {
 
   std::shared_ptr<SpannerStub> const stub;
   int session_count = 0;
+
+  // The number of streaming reads/queries currently using this channel; see
+  // `SessionPool::GetStreamStub()`. Atomic because the count is decremented
+  // without any locks when a stream's `StreamChannelLease` is destroyed.
+  std::atomic<int> in_flight_streams{0};
 };
 
 }  // namespace internal
@@ -21,6 +21,7 @@
 #include "google/cloud/spanner/query_partition.h"
 #include "google/cloud/spanner/read_partition.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include "google/cloud/internal/async_retry_unary_rpc.h"
 #include "absl/memory/memory.h"
 #include <limits>
 
@@ -235,6 +236,17 @@ StatusOr<CommitResult> ConnectionImpl::Commit(CommitParams params) {
       });
 }
 
+future<StatusOr<CommitResult>> ConnectionImpl::AsyncCommit(
+    CommitParams params) {
+  return internal::Visit(
+      std::move(params.transaction),
+      [this, &params](SessionHolder& session,
+                      StatusOr<spanner_proto::TransactionSelector>& s,
+                      std::int64_t) {
+        return this->AsyncCommitImpl(session, s, std::move(params));
+      });
+}
+
 Status ConnectionImpl::Rollback(RollbackParams params) {
   return internal::Visit(
       std::move(params.transaction),
@@ -374,9 +386,10 @@ RowStream ConnectionImpl::ReadImpl(
     request.set_partition_token(*std::move(params.partition_token));
   }
 
-  // Capture a copy of `stub` to ensure the `shared_ptr<>` remains valid through
-  // the lifetime of the lambda.
-  auto stub = session_pool_->GetStub(*session);
+  // Capture a copy of `stub` to ensure the stub (and the accounting of this
+  // stream against its channel) remains valid through the lifetime of the
+  // lambda.
+  auto stub = session_pool_->GetStreamStub(*session);
   auto const tracing_enabled = rpc_stream_tracing_enabled_;
   auto const tracing_options = tracing_options_;
   auto factory = [stub, &request, tracing_enabled,
@@ -508,14 +521,9 @@ StatusOr<ResultType> ConnectionImpl::ExecuteSqlImpl(
     return s.status();
   }
 
-  spanner_proto::ExecuteSqlRequest request;
+  auto request = statement_cache_.MakeRequest(std::move(params.statement));
   request.set_session(session->session_name());
   *request.mutable_transaction() = *s;
-  auto sql_statement = internal::ToProto(std::move(params.statement));
-  request.set_sql(std::move(*sql_statement.mutable_sql()));
-  *request.mutable_params() = std::move(*sql_statement.mutable_params());
-  *request.mutable_param_types() =
-      std::move(*sql_statement.mutable_param_types());
   request.set_seqno(seqno);
   request.set_query_mode(query_mode);
   if (params.partition_token) {
@@ -569,7 +577,8 @@ ResultType ConnectionImpl::CommonQueryImpl(
   // Capture a copy of of these to ensure the `shared_ptr<>` remains valid
   // through the lifetime of the lambda. Note that the local variables are a
   // reference to avoid increasing refcounts twice, but the capture is by value.
-  auto stub = session_pool_->GetStub(*session);
+  // The stub lease also counts this stream against its channel's load.
+  auto stub = session_pool_->GetStreamStub(*session);
   auto const& retry_policy = retry_policy_prototype_;
   auto const& backoff_policy = backoff_policy_prototype_;
   auto const tracing_enabled = rpc_stream_tracing_enabled_;
@@ -841,14 +850,9 @@ StatusOr<PartitionedDmlResult> ConnectionImpl::ExecutePartitionedDmlImpl(
   }
   s->set_id(begin->id());
 
-  spanner_proto::ExecuteSqlRequest request;
+  auto request = statement_cache_.MakeRequest(std::move(params.statement));
   request.set_session(session->session_name());
   *request.mutable_transaction() = *s;
-  auto sql_statement = internal::ToProto(std::move(params.statement));
-  request.set_sql(std::move(*sql_statement.mutable_sql()));
-  *request.mutable_params() = std::move(*sql_statement.mutable_params());
-  *request.mutable_param_types() =
-      std::move(*sql_statement.mutable_param_types());
   request.set_seqno(seqno);
   auto stub = session_pool_->GetStub(*session);
   auto response = internal::RetryLoop(
@@ -923,6 +927,72 @@ StatusOr<CommitResult> ConnectionImpl::CommitImpl(
   return r;
 }
 
+future<StatusOr<CommitResult>> ConnectionImpl::AsyncCommitImpl(
+    SessionHolder& session, StatusOr<spanner_proto::TransactionSelector>& s,
+    CommitParams params) {
+  using ReturnType = StatusOr<CommitResult>;
+  if (!s.ok()) {
+    // Fail the commit if the transaction has been invalidated.
+    return make_ready_future(ReturnType(s.status()));
+  }
+
+  auto prepare_status = PrepareSession(session);
+  if (!prepare_status.ok()) {
+    return make_ready_future(ReturnType(prepare_status));
+  }
+
+  spanner_proto::CommitRequest request;
+  request.set_session(session->session_name());
+  for (auto&& m : params.mutations) {
+    *request.add_mutations() = std::move(m).as_proto();
+  }
+
+  // Assigning a transaction ID (when needed) stays on the calling thread; it
+  // is a quick unary RPC and serializing it through the transaction visitor
+  // keeps the "begin" handling identical to the synchronous path. Only the
+  // commit itself, which dominates the round trip, runs asynchronously.
+  if (s->selector_case() != spanner_proto::TransactionSelector::kId) {
+    auto begin = BeginTransaction(
+        session, s->has_begin() ? s->begin() : s->single_use(), __func__);
+    if (!begin.ok()) {
+      s = begin.status();  // invalidate the transaction
+      return make_ready_future(ReturnType(begin.status()));
+    }
+    s->set_id(begin->id());
+  }
+  request.set_transaction_id(s->id());
+
+  auto stub = session_pool_->GetStub(*session);
+  auto cq = background_threads_->cq();
+  return google::cloud::internal::StartRetryAsyncUnaryRpc(
+             cq, __func__, retry_policy_prototype_->clone(),
+             backoff_policy_prototype_->clone(),
+             /*is_idempotent=*/true,
+             [stub](grpc::ClientContext* context,
+                    spanner_proto::CommitRequest const& request,
+                    grpc::CompletionQueue* cq) {
+               return stub->AsyncCommit(*context, request, cq);
+             },
+             std::move(request))
+      .then([session](future<StatusOr<spanner_proto::CommitResponse>> f)
+                -> ReturnType {
+        // Holding `session` here keeps it out of the pool until the commit
+        // completes.
+        auto response = f.get();
+        if (!response) {
+          auto status = std::move(response).status();
+          if (internal::IsSessionNotFound(status)) session->set_bad();
+          return status;
+        }
+        auto timestamp =
+            internal::TimestampFromProto(response->commit_timestamp());
+        if (!timestamp) return std::move(timestamp).status();
+        CommitResult r;
+        r.commit_timestamp = *std::move(timestamp);
+        return r;
+      });
+}
+
 Status ConnectionImpl::RollbackImpl(
     SessionHolder& session, StatusOr<spanner_proto::TransactionSelector>& s) {
   if (!s.ok()) {
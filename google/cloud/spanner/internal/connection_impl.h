@@ -21,10 +21,12 @@
 #include "google/cloud/spanner/internal/session.h"
 #include "google/cloud/spanner/internal/session_pool.h"
 #include "google/cloud/spanner/internal/spanner_stub.h"
+#include "google/cloud/spanner/internal/sql_statement_cache.h"
 #include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/tracing_options.h"
 #include "google/cloud/spanner/version.h"
 #include "google/cloud/background_threads.h"
+#include "google/cloud/future.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/spanner.pb.h>
@@ -81,6 +83,7 @@ class ConnectionImpl : public Connection {
       PartitionQueryParams) override;
   StatusOr<BatchDmlResult> ExecuteBatchDml(ExecuteBatchDmlParams) override;
   StatusOr<CommitResult> Commit(CommitParams) override;
+  future<StatusOr<CommitResult>> AsyncCommit(CommitParams) override;
   Status Rollback(RollbackParams) override;
 
  private:
@@ -156,6 +159,11 @@ class ConnectionImpl : public Connection {
       StatusOr<google::spanner::v1::TransactionSelector>& s,
       CommitParams params);
 
+  future<StatusOr<CommitResult>> AsyncCommitImpl(
+      SessionHolder& session,
+      StatusOr<google::spanner::v1::TransactionSelector>& s,
+      CommitParams params);
+
   Status RollbackImpl(SessionHolder& session,
                       StatusOr<google::spanner::v1::TransactionSelector>& s);
 
@@ -187,6 +195,7 @@ class ConnectionImpl : public Connection {
   std::shared_ptr<BackoffPolicy const> backoff_policy_prototype_;
   std::unique_ptr<BackgroundThreads> background_threads_;
   std::shared_ptr<SessionPool> session_pool_;
+  SqlStatementCache statement_cache_;
   bool rpc_stream_tracing_enabled_ = false;
   TracingOptions tracing_options_;
 };
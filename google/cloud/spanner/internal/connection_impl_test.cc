@@ -19,6 +19,8 @@
 #include "google/cloud/spanner/testing/mock_spanner_stub.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include "google/cloud/testing_util/is_proto_equal.h"
+#include "google/cloud/testing_util/mock_async_response_reader.h"
+#include "google/cloud/testing_util/mock_completion_queue.h"
 #include "google/cloud/testing_util/status_matchers.h"
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
@@ -1807,6 +1809,80 @@ TEST(ConnectionImplTest, CommitSuccessWithTransactionId) {
   EXPECT_STATUS_OK(commit);
 }
 
+TEST(ConnectionImplTest, AsyncCommitSuccess) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+
+  auto db = Database("dummy_project", "dummy_instance", "dummy_database_id");
+  auto impl = std::make_shared<testing_util::MockCompletionQueue>();
+  auto conn =
+      MakeConnection(db, {mock},
+                     ConnectionOptions{grpc::InsecureChannelCredentials()}
+                         .DisableBackgroundThreads(CompletionQueue(impl)));
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(
+          [&db](grpc::ClientContext&,
+                spanner_proto::BatchCreateSessionsRequest const& request) {
+            EXPECT_EQ(db.FullName(), request.database());
+            return MakeSessionsResponse({"test-session-name"});
+          });
+  auto const commit_timestamp =
+      MakeTimestamp(std::chrono::system_clock::from_time_t(123)).value();
+  auto reader = absl::make_unique<
+      testing_util::MockAsyncResponseReader<spanner_proto::CommitResponse>>();
+  EXPECT_CALL(*reader, Finish(_, _, _))
+      .WillOnce([commit_timestamp](spanner_proto::CommitResponse* response,
+                                   grpc::Status* status, void*) {
+        *response->mutable_commit_timestamp() =
+            internal::TimestampToProto(commit_timestamp);
+        *status = grpc::Status::OK;
+      });
+  EXPECT_CALL(*mock, AsyncCommit(_, _, _))
+      .WillOnce([&reader](grpc::ClientContext&,
+                          spanner_proto::CommitRequest const& request,
+                          grpc::CompletionQueue*) {
+        EXPECT_EQ("test-session-name", request.session());
+        EXPECT_EQ("test-txn-id", request.transaction_id());
+        // This is safe. See comments in MockAsyncResponseReader.
+        return std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+            spanner_proto::CommitResponse>>(reader.get());
+      });
+
+  auto txn = MakeReadWriteTransaction();
+  SetTransactionId(txn, "test-txn-id");
+
+  auto fut = conn->AsyncCommit({txn});
+  // The RPC completes when the (simulated) completion queue runs.
+  impl->SimulateCompletion(true);
+  auto commit = fut.get();
+  EXPECT_STATUS_OK(commit);
+  EXPECT_EQ(commit_timestamp, commit->commit_timestamp);
+}
+
+TEST(ConnectionImplTest, AsyncCommitGetSessionFailure) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+
+  auto db = Database("dummy_project", "dummy_instance", "dummy_database_id");
+  auto impl = std::make_shared<testing_util::MockCompletionQueue>();
+  auto conn =
+      MakeConnection(db, {mock},
+                     ConnectionOptions{grpc::InsecureChannelCredentials()}
+                         .DisableBackgroundThreads(CompletionQueue(impl)));
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce([](grpc::ClientContext&,
+                   spanner_proto::BatchCreateSessionsRequest const&) {
+        return Status(StatusCode::kPermissionDenied, "uh-oh in GetSession");
+      });
+  EXPECT_CALL(*mock, AsyncCommit(_, _, _)).Times(0);
+
+  auto txn = MakeReadWriteTransaction();
+  SetTransactionId(txn, "test-txn-id");
+
+  // The failure is reported through the future without blocking.
+  auto commit = conn->AsyncCommit({txn}).get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, commit.status().code());
+  EXPECT_THAT(commit.status().message(), HasSubstr("uh-oh in GetSession"));
+}
+
 TEST(ConnectionImplTest, RollbackGetSessionFailure) {
   auto db = Database("project", "instance", "database");
 
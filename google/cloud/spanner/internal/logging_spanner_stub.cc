@@ -148,6 +148,21 @@ LoggingSpannerStub::ExecuteStreamingSql(
       client_context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncReaderInterface<spanner_proto::PartialResultSet>>
+LoggingSpannerStub::AsyncExecuteStreamingSql(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteSqlRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return LogWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::ExecuteSqlRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return child_->AsyncExecuteStreamingSql(context, request, cq);
+      },
+      client_context, request, cq, __func__, tracing_options_);
+}
+
 StatusOr<spanner_proto::ExecuteBatchDmlResponse>
 LoggingSpannerStub::ExecuteBatchDml(
     grpc::ClientContext& client_context,
@@ -193,6 +208,20 @@ StatusOr<spanner_proto::CommitResponse> LoggingSpannerStub::Commit(
       client_context, request, __func__, tracing_options_);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+LoggingSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                spanner_proto::CommitRequest const& request,
+                                grpc::CompletionQueue* cq) {
+  return LogWrapper(
+      [this](grpc::ClientContext& context,
+             spanner_proto::CommitRequest const& request,
+             grpc::CompletionQueue* cq) {
+        return child_->AsyncCommit(context, request, cq);
+      },
+      client_context, request, cq, __func__, tracing_options_);
+}
+
 Status LoggingSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
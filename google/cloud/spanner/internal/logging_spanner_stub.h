@@ -77,6 +77,12 @@ class LoggingSpannerStub : public SpannerStub {
   ExecuteStreamingSql(
       grpc::ClientContext& client_context,
       google::spanner::v1::ExecuteSqlRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncReaderInterface<google::spanner::v1::PartialResultSet>>
+  AsyncExecuteStreamingSql(
+      grpc::ClientContext& client_context,
+      google::spanner::v1::ExecuteSqlRequest const& request,
+      grpc::CompletionQueue* cq) override;
   StatusOr<google::spanner::v1::ExecuteBatchDmlResponse> ExecuteBatchDml(
       grpc::ClientContext& client_context,
       google::spanner::v1::ExecuteBatchDmlRequest const& request) override;
@@ -90,6 +96,11 @@ class LoggingSpannerStub : public SpannerStub {
   StatusOr<google::spanner::v1::CommitResponse> Commit(
       grpc::ClientContext& client_context,
       google::spanner::v1::CommitRequest const& request) override;
+  std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+      google::spanner::v1::CommitResponse>>
+  AsyncCommit(grpc::ClientContext& client_context,
+              google::spanner::v1::CommitRequest const& request,
+              grpc::CompletionQueue* cq) override;
   Status Rollback(grpc::ClientContext& client_context,
                   google::spanner::v1::RollbackRequest const& request) override;
   StatusOr<google::spanner::v1::PartitionResponse> PartitionQuery(
@@ -112,6 +112,16 @@ MetadataSpannerStub::ExecuteStreamingSql(
   return child_->ExecuteStreamingSql(client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncReaderInterface<spanner_proto::PartialResultSet>>
+MetadataSpannerStub::AsyncExecuteStreamingSql(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteSqlRequest const& request,
+    grpc::CompletionQueue* cq) {
+  SetMetadata(client_context, "session=" + request.session());
+  return child_->AsyncExecuteStreamingSql(client_context, request, cq);
+}
+
 StatusOr<spanner_proto::ExecuteBatchDmlResponse>
 MetadataSpannerStub::ExecuteBatchDml(
     grpc::ClientContext& client_context,
@@ -141,6 +151,15 @@ StatusOr<spanner_proto::CommitResponse> MetadataSpannerStub::Commit(
   return child_->Commit(client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+MetadataSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                 spanner_proto::CommitRequest const& request,
+                                 grpc::CompletionQueue* cq) {
+  SetMetadata(client_context, "session=" + request.session());
+  return child_->AsyncCommit(client_context, request, cq);
+}
+
 Status MetadataSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
@@ -0,0 +1,195 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/partial_result_set_assembler.h"
+#include "google/cloud/spanner/internal/merge_chunk.h"
+#include "google/cloud/log.h"
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+Status PartialResultSetAssembler::Push(
+    google::spanner::v1::PartialResultSet result_set) {
+  if (result_set.has_metadata()) {
+    // If we got metadata more than once, log it, but use the first one.
+    if (metadata_) {
+      GCP_LOG(WARNING) << "Unexpectedly received two sets of metadata";
+    } else {
+      metadata_ = std::move(*result_set.mutable_metadata());
+      // Copies the column names into a shared_ptr that will be shared with
+      // every Row object returned from PopRow().
+      columns_ = std::make_shared<std::vector<std::string>>();
+      for (auto const& field : metadata_->row_type().fields()) {
+        columns_->push_back(field.name());
+      }
+    }
+  }
+
+  if (result_set.has_stats()) {
+    // If we got stats more than once, log it, but use the last one.
+    if (stats_) {
+      GCP_LOG(WARNING) << "Unexpectedly received two sets of stats";
+    }
+    stats_ = std::move(*result_set.mutable_stats());
+  }
+
+  auto& new_values = *result_set.mutable_values();
+
+  // Merge values if necessary, as described in:
+  // https://cloud.google.com/spanner/docs/reference/rpc/google.spanner.v1#google.spanner.v1.PartialResultSet
+  //
+  // As an example, if we receive the following 4 responses (assume the values
+  // are all `string_value`s of type `STRING`):
+  //
+  // ```
+  // { { values: ["A", "B", "C1"] }  chunked_value: true }
+  // { { values: ["C2", "D", "E1"] } chunked_value: true }
+  // { { values: ["E2"] },           chunked_value: true }
+  // { { values: ["E3", "F"] }       chunked_value: false }
+  // ```
+  //
+  // The final values yielded are: `A`, `B`, `C1C2`, `D`, `E1E2E3`, `F`.
+  //
+  // n.b. One value can span more than two responses (the `E1E2E3` case above);
+  // the code "just works" without needing to treat that as a special-case.
+  if (chunk_) {
+    if (new_values.empty()) {
+      return Status(StatusCode::kInternal,
+                    "PartialResultSet contained no values "
+                    "to merge with prior chunked_value");
+    }
+    auto& front = new_values[0];
+    if (chunk_->kind_case() == google::protobuf::Value::kStringValue &&
+        front.kind_case() == google::protobuf::Value::kStringValue) {
+      // Chunked strings are the common case (STRING and BYTES columns).
+      // Accumulate the pieces and concatenate them only once the value is
+      // complete; appending on every response would copy the merged prefix
+      // again and again for values spanning many responses.
+      chunk_pieces_.push_back(std::move(*front.mutable_string_value()));
+      if (result_set.chunked_value() && new_values.size() == 1) {
+        // The value continues in the next response, keep accumulating.
+        new_values.RemoveLast();
+        return {};  // OK
+      }
+      MaterializeChunk();
+      using std::swap;
+      swap(*chunk_, front);
+      chunk_ = {};
+    } else {
+      auto merge_status = MergeChunk(*chunk_, std::move(front));
+      if (!merge_status.ok()) {
+        return merge_status;
+      }
+      using std::swap;
+      swap(*chunk_, front);
+      chunk_ = {};
+    }
+  }
+
+  if (result_set.chunked_value()) {
+    if (new_values.empty()) {
+      return Status(StatusCode::kInternal,
+                    "PartialResultSet had chunked_value "
+                    "set true but contained no values");
+    }
+    chunk_ = std::move(new_values[new_values.size() - 1]);
+    new_values.RemoveLast();
+  }
+
+  // Moves all the remaining in new_values to buffer_
+  for (auto& value_proto : new_values) {
+    buffer_.push_back(std::move(value_proto));
+  }
+
+  return {};  // OK
+}
+
+StatusOr<Row> PartialResultSetAssembler::PopRow() {
+  if (buffer_.empty()) return Row();
+
+  if (!metadata_) {
+    return Status(StatusCode::kInternal, "response contained no metadata");
+  }
+  auto const& fields = metadata_->row_type().fields();
+  if (fields.empty()) {
+    return Status(StatusCode::kInternal,
+                  "response metadata is missing row type information");
+  }
+  if (buffer_.size() < static_cast<std::size_t>(fields.size())) return Row();
+
+  std::vector<Value> values;
+  values.reserve(fields.size());
+  auto iter = buffer_.begin();
+  for (auto const& field : fields) {
+    values.push_back(FromProto(field.type(), std::move(*iter)));
+    ++iter;
+  }
+  buffer_.erase(buffer_.begin(), iter);
+  return internal::MakeRow(std::move(values), columns_);
+}
+
+StatusOr<bool> PartialResultSetAssembler::PopRowProtos(
+    std::vector<google::protobuf::Value>& row) {
+  if (buffer_.empty()) return false;
+
+  if (!metadata_) {
+    return Status(StatusCode::kInternal, "response contained no metadata");
+  }
+  auto const& fields = metadata_->row_type().fields();
+  if (fields.empty()) {
+    return Status(StatusCode::kInternal,
+                  "response metadata is missing row type information");
+  }
+  if (buffer_.size() < static_cast<std::size_t>(fields.size())) return false;
+
+  row.clear();
+  row.reserve(fields.size());
+  auto iter = buffer_.begin();
+  for (int i = 0; i != fields.size(); ++i) {
+    row.push_back(std::move(*iter));
+    ++iter;
+  }
+  buffer_.erase(buffer_.begin(), iter);
+  return true;
+}
+
+Status PartialResultSetAssembler::CheckEndOfStream() const {
+  if (chunk_) {
+    return Status(StatusCode::kInternal,
+                  "incomplete chunked_value at end of stream");
+  }
+  if (!buffer_.empty()) {
+    return Status(StatusCode::kInternal, "incomplete row at end of stream");
+  }
+  return {};  // OK
+}
+
+void PartialResultSetAssembler::MaterializeChunk() {
+  if (chunk_pieces_.empty()) return;
+  auto& value = *chunk_->mutable_string_value();
+  auto size = value.size();
+  for (auto const& piece : chunk_pieces_) size += piece.size();
+  value.reserve(size);
+  for (auto const& piece : chunk_pieces_) value.append(piece);
+  chunk_pieces_.clear();
+}
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
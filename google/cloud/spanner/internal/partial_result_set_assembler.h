@@ -0,0 +1,100 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_ASSEMBLER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_ASSEMBLER_H
+
+#include "google/cloud/spanner/row.h"
+#include "google/cloud/spanner/version.h"
+#include "google/cloud/status.h"
+#include "google/cloud/status_or.h"
+#include "absl/types/optional.h"
+#include <google/spanner/v1/spanner.pb.h>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+/**
+ * Assembles `Row`s from a sequence of `PartialResultSet` responses.
+ *
+ * This class holds the state needed to reassemble the values split across
+ * responses (see `chunked_value` in the `PartialResultSet` documentation) and
+ * to group the values into rows. It is shared by the synchronous
+ * `PartialResultSetSource` and the asynchronous row source, which differ only
+ * in how they obtain the responses.
+ */
+class PartialResultSetAssembler {
+ public:
+  /// Incorporate @p result_set, merging chunked values as necessary.
+  Status Push(google::spanner::v1::PartialResultSet result_set);
+
+  /**
+   * Pop the next complete row.
+   *
+   * Returns an empty `Row` if more input is needed, or an error if the
+   * metadata was missing the row type information.
+   */
+  StatusOr<Row> PopRow();
+
+  /**
+   * Pop the raw value protos for the next complete row into @p row.
+   *
+   * Returns `true` if a row was popped, `false` if more input is needed, or
+   * an error if the metadata was missing the row type information. This is
+   * the columnar-decode counterpart of `PopRow()`; it skips the `Value`
+   * materialization entirely.
+   */
+  StatusOr<bool> PopRowProtos(std::vector<google::protobuf::Value>& row);
+
+  /// Diagnose streams that end in the middle of a value or a row.
+  Status CheckEndOfStream() const;
+
+  absl::optional<google::spanner::v1::ResultSetMetadata> const& metadata()
+      const {
+    return metadata_;
+  }
+  absl::optional<google::spanner::v1::ResultSetStats> const& stats() const {
+    return stats_;
+  }
+
+ private:
+  // Append any accumulated `chunk_pieces_` to the string in `chunk_`,
+  // reserving the final size so the value is materialized in a single pass.
+  void MaterializeChunk();
+
+  absl::optional<google::spanner::v1::ResultSetMetadata> metadata_;
+  absl::optional<google::spanner::v1::ResultSetStats> stats_;
+  std::deque<google::protobuf::Value> buffer_;
+  absl::optional<google::protobuf::Value> chunk_;
+  // The continuations of a chunked string value, in arrival order. The pieces
+  // are accumulated here (stealing the protobuf string storage) and
+  // concatenated only once, when the value is complete.
+  std::vector<std::string> chunk_pieces_;
+  std::shared_ptr<std::vector<std::string>> columns_;
+};
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_ASSEMBLER_H
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/internal/partial_result_set_resume.h"
+#include "google/cloud/log.h"
 #include <thread>
 
 namespace google {
@@ -21,28 +22,47 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 namespace internal {
 
+PartialResultSetResume::~PartialResultSetResume() {
+  if (counters_.resumptions == 0) return;
+  GCP_LOG(DEBUG) << "PartialResultSet stream resumed " << counters_.resumptions
+                 << " time(s), dropped " << counters_.values_replayed
+                 << " replayed value(s) and " << counters_.values_discarded
+                 << " held-back value(s)";
+}
+
 void PartialResultSetResume::TryCancel() { child_->TryCancel(); }
 
 absl::optional<google::spanner::v1::PartialResultSet>
 PartialResultSetResume::Read() {
-  do {
-    absl::optional<google::spanner::v1::PartialResultSet> result =
-        child_->Read();
-    if (result) {
-      last_resume_token_ = result->resume_token();
+  for (;;) {
+    if (!ready_.empty()) {
+      absl::optional<google::spanner::v1::PartialResultSet> result(
+          std::move(ready_.front()));
+      ready_.pop_front();
       return result;
     }
+    if (eos_) return {};
+    auto result = child_->Read();
+    if (result) {
+      Buffer(*std::move(result));
+      continue;
+    }
     auto status = Finish();
-    if (status.ok()) return {};
+    if (status.ok()) {
+      eos_ = true;
+      // The stream may have ended while a chunked value was incomplete;
+      // deliver the held-back responses so the caller can diagnose that.
+      FlushHeld();
+      continue;
+    }
     if (is_idempotent_ == Idempotency::kNotIdempotent ||
-        !retry_policy_prototype_->OnFailure(status)) {
+        !retry_policy_prototype_->OnFailure(status) ||
+        retry_policy_prototype_->IsExhausted()) {
       return {};
     }
     std::this_thread::sleep_for(backoff_policy_prototype_->OnCompletion());
-    last_status_.reset();
-    child_ = factory_(last_resume_token_);
-  } while (!retry_policy_prototype_->IsExhausted());
-  return {};
+    Resume();
+  }
 }
 
 Status PartialResultSetResume::Finish() {
@@ -54,6 +74,116 @@ Status PartialResultSetResume::Finish() {
   return *last_status_;
 }
 
+void PartialResultSetResume::Buffer(
+    google::spanner::v1::PartialResultSet result_set) {
+  if (!held_.empty()) {
+    if (result_set.values_size() == 1 && result_set.chunked_value()) {
+      // The held-back value remains incomplete, keep accumulating.
+      held_.push_back(std::move(result_set));
+      return;
+    }
+    // The held-back value completes within `result_set` (or the stream is
+    // malformed, which the layer above will diagnose).
+    FlushHeld();
+  }
+  if (result_set.chunked_value() && result_set.values_size() > 0) {
+    // Split off the trailing (incomplete) value and hold it back until it
+    // completes; anything before it can be delivered immediately.
+    google::spanner::v1::PartialResultSet tail;
+    tail.set_chunked_value(true);
+    auto& values = *result_set.mutable_values();
+    tail.add_values()->Swap(&values[values.size() - 1]);
+    values.RemoveLast();
+    // A token (if any) only becomes usable once the whole response,
+    // including the held-back value, has been delivered.
+    if (!result_set.resume_token().empty()) {
+      tail.set_resume_token(std::move(*result_set.mutable_resume_token()));
+      result_set.clear_resume_token();
+    }
+    result_set.set_chunked_value(false);
+    if (result_set.values_size() > 0 || result_set.has_metadata() ||
+        result_set.has_stats()) {
+      Deliver(std::move(result_set));
+    }
+    held_.push_back(std::move(tail));
+    return;
+  }
+  Deliver(std::move(result_set));
+}
+
+void PartialResultSetResume::Deliver(
+    google::spanner::v1::PartialResultSet result_set) {
+  auto& values = *result_set.mutable_values();
+  // Drop the values that are replays of data delivered before a resumption.
+  int skipped = 0;
+  while (skipped != values.size() && (skip_chunk_ || skip_values_ > 0)) {
+    bool const continues =
+        skipped + 1 == values.size() && result_set.chunked_value();
+    if (skip_chunk_) {
+      ++skipped;
+      if (!continues) {
+        skip_chunk_ = false;
+        --skip_values_;
+      }
+    } else if (continues) {
+      // An incomplete replay of the next value to drop; it counts against
+      // `skip_values_` only once it completes.
+      skip_chunk_ = true;
+      ++skipped;
+    } else {
+      ++skipped;
+      --skip_values_;
+    }
+  }
+  if (skipped != 0) {
+    counters_.values_replayed += skipped;
+    values.DeleteSubrange(0, skipped);
+    if (values.empty()) {
+      result_set.set_chunked_value(false);
+      if (!result_set.has_metadata() && !result_set.has_stats()) {
+        // Nothing left to deliver, but the response may move the resumption
+        // point past some of the values we still have to drop.
+        if (!result_set.resume_token().empty()) {
+          last_resume_token_ = std::move(*result_set.mutable_resume_token());
+          values_since_token_ = skip_values_;
+        }
+        return;
+      }
+    }
+  }
+  // A trailing chunked value is completed by the next response; it is
+  // counted when it completes.
+  values_since_token_ += values.size() - (result_set.chunked_value() ? 1 : 0);
+  if (!result_set.resume_token().empty()) {
+    // The values in this response precede the token, a resumed stream will
+    // not replay them.
+    last_resume_token_ = result_set.resume_token();
+    values_since_token_ = skip_values_;
+  }
+  ready_.push_back(std::move(result_set));
+}
+
+void PartialResultSetResume::FlushHeld() {
+  for (auto& held : held_) {
+    Deliver(std::move(held));
+  }
+  held_.clear();
+}
+
+void PartialResultSetResume::Resume() {
+  last_status_.reset();
+  ++counters_.resumptions;
+  // The held-back responses were never delivered; the resumed stream sends
+  // their values again, so just drop them.
+  for (auto const& held : held_) {
+    counters_.values_discarded += held.values_size();
+  }
+  held_.clear();
+  skip_values_ = values_since_token_;
+  skip_chunk_ = false;
+  child_ = factory_(last_resume_token_);
+}
+
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
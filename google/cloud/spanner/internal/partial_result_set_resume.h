@@ -20,6 +20,8 @@
 #include "google/cloud/spanner/retry_policy.h"
 #include "google/cloud/spanner/version.h"
 #include "absl/types/optional.h"
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
 
@@ -40,6 +42,21 @@ enum class Idempotency {
 
 /**
  * A PartialResultSetReader that resumes the streaming RPC on retryable errors.
+ *
+ * A resumed stream replays all the data received after the last
+ * `resume_token`, because the service can only restart the stream at a token
+ * boundary. This class keeps track of how many values it has returned since
+ * that boundary and silently drops the replayed copies, so the caller sees
+ * each value exactly once and never pays to re-assemble or re-decode data it
+ * already consumed.
+ *
+ * Responses ending in an incomplete `chunked_value` are held back until the
+ * value completes. If the stream breaks while a value is incomplete the held
+ * responses are simply discarded and received again after the resumption;
+ * without the holdback the caller would be left with a partial value that
+ * cannot be reconciled with its replayed copy. The memory used by the
+ * holdback is bounded by the size of a single value, the same bound the
+ * caller needs to reassemble the value anyway.
  */
 class PartialResultSetResume : public PartialResultSetReader {
  public:
@@ -53,13 +70,33 @@ class PartialResultSetResume : public PartialResultSetReader {
         backoff_policy_prototype_(std::move(backoff_policy)),
         child_(factory_(last_resume_token_)) {}
 
-  ~PartialResultSetResume() override = default;
+  ~PartialResultSetResume() override;
 
   void TryCancel() override;
   absl::optional<google::spanner::v1::PartialResultSet> Read() override;
   Status Finish() override;
 
+  /// The cost of any stream resumptions, mostly for tests and diagnostics.
+  struct Counters {
+    std::int64_t resumptions;       ///< streams resumed after an error
+    std::int64_t values_replayed;   ///< returned values received again
+    std::int64_t values_discarded;  ///< held-back values dropped on resume
+  };
+  Counters counters() const { return counters_; }
+
  private:
+  /// Queue @p result_set for `Read()`, holding back incomplete chunks.
+  void Buffer(google::spanner::v1::PartialResultSet result_set);
+
+  /// Queue @p result_set for `Read()`, dropping any replayed values.
+  void Deliver(google::spanner::v1::PartialResultSet result_set);
+
+  /// Move any held-back responses to the `Read()` queue.
+  void FlushHeld();
+
+  /// Create a new child stream starting from `last_resume_token_`.
+  void Resume();
+
   PartialResultSetReaderFactory factory_;
   Idempotency is_idempotent_;
   std::unique_ptr<RetryPolicy> retry_policy_prototype_;
@@ -67,6 +104,19 @@ class PartialResultSetResume : public PartialResultSetReader {
   std::string last_resume_token_;
   std::unique_ptr<PartialResultSetReader> child_;
   absl::optional<Status> last_status_;
+  bool eos_ = false;
+
+  /// Responses ready to be returned from `Read()`.
+  std::deque<google::spanner::v1::PartialResultSet> ready_;
+  /// Responses held back because their last value is incomplete.
+  std::deque<google::spanner::v1::PartialResultSet> held_;
+  /// The number of values returned since `last_resume_token_`.
+  std::int64_t values_since_token_ = 0;
+  /// The number of replayed values still to drop after a resumption.
+  std::int64_t skip_values_ = 0;
+  /// True if the value currently being dropped is incomplete.
+  bool skip_chunk_ = false;
+  Counters counters_ = {};
 };
 
 }  // namespace internal
@@ -294,6 +294,343 @@ TEST(PartialResultSetResume, TooManyTransients) {
   EXPECT_THAT(status.message(), HasSubstr("try-again-N"));
 }
 
+TEST(PartialResultSetResume, SkipsReplayedValuesAfterResume) {
+  auto constexpr kText0 = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "TestColumn",
+          type: { code: STRING }
+        }
+      }
+    }
+    resume_token: "test-token-0"
+    values: { string_value: "value-1" }
+    values: { string_value: "value-2" }
+  )pb";
+  spanner_proto::PartialResultSet r0;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText0, &r0));
+
+  // No resume token, so a resumed stream replays these values.
+  auto constexpr kText1 = R"pb(
+    values: { string_value: "value-3" }
+    values: { string_value: "value-4" }
+  )pb";
+  spanner_proto::PartialResultSet r1;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText1, &r1));
+
+  auto constexpr kText2 = R"pb(
+    resume_token: "test-token-1"
+    values: { string_value: "value-5" }
+  )pb";
+  spanner_proto::PartialResultSet r2;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText2, &r2));
+
+  MockFactory mock_factory;
+  EXPECT_CALL(mock_factory, MakeReader(_))
+      .WillOnce([&r0, &r1](std::string const& token) {
+        EXPECT_TRUE(token.empty());
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r0] { return ReadReturn(r0); })
+            .WillOnce([&r1] { return ReadReturn(r1); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish())
+            .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again-0")));
+        return mock;
+      })
+      .WillOnce([&r1, &r2](std::string const& token) {
+        EXPECT_EQ("test-token-0", token);
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r1] { return ReadReturn(r1); })
+            .WillOnce([&r2] { return ReadReturn(r2); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish()).WillOnce(Return(Status()));
+        return mock;
+      });
+
+  auto factory = [&mock_factory](std::string const& token) {
+    return mock_factory.MakeReader(token);
+  };
+  auto reader = absl::make_unique<PartialResultSetResume>(
+      factory, Idempotency::kIdempotent,
+      LimitedErrorCountRetryPolicy(/*maximum_failures=*/2).clone(),
+      ExponentialBackoffPolicy(/*initial_delay=*/std::chrono::microseconds(1),
+                               /*maximum_delay=*/std::chrono::microseconds(1),
+                               /*scaling=*/2.0)
+          .clone());
+  auto v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r0));
+  v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r1));
+  // The replayed copy of `r1` is dropped, the next value is "value-5".
+  v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r2));
+  v = reader->Read();
+  ASSERT_FALSE(v.has_value());
+  EXPECT_STATUS_OK(reader->Finish());
+
+  auto counters = reader->counters();
+  EXPECT_EQ(1, counters.resumptions);
+  EXPECT_EQ(2, counters.values_replayed);
+  EXPECT_EQ(0, counters.values_discarded);
+}
+
+TEST(PartialResultSetResume, SplitsPartiallyReplayedResponse) {
+  auto constexpr kText0 = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "TestColumn",
+          type: { code: STRING }
+        }
+      }
+    }
+    resume_token: "test-token-0"
+    values: { string_value: "value-1" }
+  )pb";
+  spanner_proto::PartialResultSet r0;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText0, &r0));
+
+  auto constexpr kText1 = R"pb(
+    values: { string_value: "value-2" }
+  )pb";
+  spanner_proto::PartialResultSet r1;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText1, &r1));
+
+  // The resumed stream replays "value-2" in the same response as new data.
+  auto constexpr kText2 = R"pb(
+    values: { string_value: "value-2" }
+    values: { string_value: "value-3" }
+  )pb";
+  spanner_proto::PartialResultSet r2;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText2, &r2));
+
+  MockFactory mock_factory;
+  EXPECT_CALL(mock_factory, MakeReader(_))
+      .WillOnce([&r0, &r1](std::string const& token) {
+        EXPECT_TRUE(token.empty());
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r0] { return ReadReturn(r0); })
+            .WillOnce([&r1] { return ReadReturn(r1); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish())
+            .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again-0")));
+        return mock;
+      })
+      .WillOnce([&r2](std::string const& token) {
+        EXPECT_EQ("test-token-0", token);
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r2] { return ReadReturn(r2); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish()).WillOnce(Return(Status()));
+        return mock;
+      });
+
+  auto factory = [&mock_factory](std::string const& token) {
+    return mock_factory.MakeReader(token);
+  };
+  auto reader = MakeTestResume(factory, Idempotency::kIdempotent);
+  auto v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r0));
+  v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r1));
+  spanner_proto::PartialResultSet expected;
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(values: { string_value: "value-3" })pb", &expected));
+  v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(expected));
+  v = reader->Read();
+  ASSERT_FALSE(v.has_value());
+  EXPECT_STATUS_OK(reader->Finish());
+}
+
+TEST(PartialResultSetResume, HoldsIncompleteChunkAcrossResume) {
+  auto constexpr kText0 = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "TestColumn",
+          type: { code: STRING }
+        }
+      }
+    }
+    resume_token: "test-token-0"
+    values: { string_value: "value-1" }
+  )pb";
+  spanner_proto::PartialResultSet r0;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText0, &r0));
+
+  // "value-2" is complete, the last value is not.
+  auto constexpr kText1 = R"pb(
+    values: { string_value: "value-2" }
+    values: { string_value: "chunk-1/" }
+    chunked_value: true
+  )pb";
+  spanner_proto::PartialResultSet r1;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText1, &r1));
+
+  // The resumed stream replays "value-2" and re-sends the whole value that
+  // was chunked before, this time in one piece.
+  auto constexpr kText2 = R"pb(
+    values: { string_value: "value-2" }
+  )pb";
+  spanner_proto::PartialResultSet r2;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText2, &r2));
+  auto constexpr kText3 = R"pb(
+    resume_token: "test-token-1"
+    values: { string_value: "chunk-1/chunk-2" }
+  )pb";
+  spanner_proto::PartialResultSet r3;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText3, &r3));
+
+  MockFactory mock_factory;
+  EXPECT_CALL(mock_factory, MakeReader(_))
+      .WillOnce([&r0, &r1](std::string const& token) {
+        EXPECT_TRUE(token.empty());
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r0] { return ReadReturn(r0); })
+            .WillOnce([&r1] { return ReadReturn(r1); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish())
+            .WillOnce(Return(Status(StatusCode::kUnavailable, "try-again-0")));
+        return mock;
+      })
+      .WillOnce([&r2, &r3](std::string const& token) {
+        EXPECT_EQ("test-token-0", token);
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r2] { return ReadReturn(r2); })
+            .WillOnce([&r3] { return ReadReturn(r3); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish()).WillOnce(Return(Status()));
+        return mock;
+      });
+
+  auto factory = [&mock_factory](std::string const& token) {
+    return mock_factory.MakeReader(token);
+  };
+  auto reader = absl::make_unique<PartialResultSetResume>(
+      factory, Idempotency::kIdempotent,
+      LimitedErrorCountRetryPolicy(/*maximum_failures=*/2).clone(),
+      ExponentialBackoffPolicy(/*initial_delay=*/std::chrono::microseconds(1),
+                               /*maximum_delay=*/std::chrono::microseconds(1),
+                               /*scaling=*/2.0)
+          .clone());
+  auto v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r0));
+  // Only the complete value of `r1` is delivered, the incomplete one is held
+  // back and then discarded when the stream breaks.
+  spanner_proto::PartialResultSet expected;
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(values: { string_value: "value-2" })pb", &expected));
+  v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(expected));
+  v = reader->Read();
+  ASSERT_TRUE(v.has_value());
+  EXPECT_THAT(*v, IsProtoEqual(r3));
+  v = reader->Read();
+  ASSERT_FALSE(v.has_value());
+  EXPECT_STATUS_OK(reader->Finish());
+
+  auto counters = reader->counters();
+  EXPECT_EQ(1, counters.resumptions);
+  EXPECT_EQ(1, counters.values_replayed);
+  EXPECT_EQ(1, counters.values_discarded);
+}
+
+TEST(PartialResultSetResume, DeliversChunkedValueOnlyWhenComplete) {
+  auto constexpr kText0 = R"pb(
+    metadata: {
+      row_type: {
+        fields: {
+          name: "TestColumn",
+          type: { code: STRING }
+        }
+      }
+    }
+    values: { string_value: "value-1" }
+    values: { string_value: "chunk-1/" }
+    chunked_value: true
+  )pb";
+  spanner_proto::PartialResultSet r0;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText0, &r0));
+
+  auto constexpr kText1 = R"pb(
+    values: { string_value: "chunk-2/" }
+    chunked_value: true
+  )pb";
+  spanner_proto::PartialResultSet r1;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText1, &r1));
+
+  auto constexpr kText2 = R"pb(
+    values: { string_value: "chunk-3" }
+    values: { string_value: "value-3" }
+  )pb";
+  spanner_proto::PartialResultSet r2;
+  ASSERT_TRUE(TextFormat::ParseFromString(kText2, &r2));
+
+  MockFactory mock_factory;
+  EXPECT_CALL(mock_factory, MakeReader(_))
+      .WillOnce([&r0, &r1, &r2](std::string const& token) {
+        EXPECT_TRUE(token.empty());
+        auto mock = absl::make_unique<MockPartialResultSetReader>();
+        EXPECT_CALL(*mock, Read())
+            .WillOnce([&r0] { return ReadReturn(r0); })
+            .WillOnce([&r1] { return ReadReturn(r1); })
+            .WillOnce([&r2] { return ReadReturn(r2); })
+            .WillOnce(Return(ReadReturn{}));
+        EXPECT_CALL(*mock, Finish()).WillOnce(Return(Status()));
+        return mock;
+      });
+
+  auto factory = [&mock_factory](std::string const& token) {
+    return mock_factory.MakeReader(token);
+  };
+  auto reader = MakeTestResume(factory, Idempotency::kIdempotent);
+  // The incomplete value is withheld until its last chunk arrives, and then
+  // delivered with the original chunking.
+  std::array<char const*, 4> expected_text = {{
+      R"pb(
+        metadata: {
+          row_type: {
+            fields: {
+              name: "TestColumn",
+              type: { code: STRING }
+            }
+          }
+        }
+        values: { string_value: "value-1" }
+      )pb",
+      R"pb(values: { string_value: "chunk-1/" } chunked_value: true)pb",
+      R"pb(values: { string_value: "chunk-2/" } chunked_value: true)pb",
+      R"pb(values: { string_value: "chunk-3" }
+           values: { string_value: "value-3" })pb",
+  }};
+  for (auto const* text : expected_text) {
+    spanner_proto::PartialResultSet expected;
+    ASSERT_TRUE(TextFormat::ParseFromString(text, &expected));
+    auto v = reader->Read();
+    ASSERT_TRUE(v.has_value());
+    EXPECT_THAT(*v, IsProtoEqual(expected));
+  }
+  auto v = reader->Read();
+  ASSERT_FALSE(v.has_value());
+  EXPECT_STATUS_OK(reader->Finish());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
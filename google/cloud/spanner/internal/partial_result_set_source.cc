@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include "google/cloud/spanner/internal/partial_result_set_source.h"
-#include "google/cloud/spanner/internal/merge_chunk.h"
 #include "google/cloud/log.h"
 
 namespace google {
@@ -34,7 +33,7 @@ StatusOr<std::unique_ptr<ResultSourceInterface>> PartialResultSetSource::Create(
   }
 
   // The first response must contain metadata.
-  if (!source->metadata_) {
+  if (!source->assembler_.metadata()) {
     return Status(StatusCode::kInternal, "response contained no metadata");
   }
 
@@ -46,38 +45,44 @@ StatusOr<Row> PartialResultSetSource::NextRow() {
     return Row();
   }
 
-  while (buffer_.empty() || buffer_.size() < columns_->size()) {
+  for (;;) {
+    auto row = assembler_.PopRow();
+    if (!row) return row;
+    if (row->size() != 0) return row;
+
     auto status = ReadFromStream();
     if (!status.ok()) {
       return status;
     }
     if (finished_) {
-      if (chunk_) {
-        return Status(StatusCode::kInternal,
-                      "incomplete chunked_value at end of stream");
-      }
-      if (!buffer_.empty()) {
-        return Status(StatusCode::kInternal, "incomplete row at end of stream");
-      }
+      auto eos = assembler_.CheckEndOfStream();
+      if (!eos.ok()) return eos;
       return Row();
     }
   }
+}
 
-  auto const& fields = metadata_->row_type().fields();
-  if (fields.empty()) {
-    return Status(StatusCode::kInternal,
-                  "response metadata is missing row type information");
+StatusOr<bool> PartialResultSetSource::NextRowProtos(
+    std::vector<google::protobuf::Value>& row) {
+  if (finished_) {
+    return false;
   }
 
-  std::vector<Value> values;
-  values.reserve(fields.size());
-  auto iter = buffer_.begin();
-  for (auto const& field : fields) {
-    values.push_back(FromProto(field.type(), std::move(*iter)));
-    ++iter;
+  for (;;) {
+    auto popped = assembler_.PopRowProtos(row);
+    if (!popped) return popped;
+    if (*popped) return true;
+
+    auto status = ReadFromStream();
+    if (!status.ok()) {
+      return status;
+    }
+    if (finished_) {
+      auto eos = assembler_.CheckEndOfStream();
+      if (!eos.ok()) return eos;
+      return false;
+    }
   }
-  buffer_.erase(buffer_.begin(), iter);
-  return internal::MakeRow(std::move(values), columns_);
 }
 
 PartialResultSetSource::~PartialResultSetSource() {
@@ -103,81 +108,7 @@ Status PartialResultSetSource::ReadFromStream() {
     finished_ = true;
     return reader_->Finish();
   }
-
-  if (result_set->has_metadata()) {
-    // If we got metadata more than once, log it, but use the first one.
-    if (metadata_) {
-      GCP_LOG(WARNING) << "Unexpectedly received two sets of metadata";
-    } else {
-      metadata_ = std::move(*result_set->mutable_metadata());
-      // Copies the column names into a shared_ptr that will be shared with
-      // every Row object returned from NextRow().
-      columns_ = std::make_shared<std::vector<std::string>>();
-      for (auto const& field : metadata_->row_type().fields()) {
-        columns_->push_back(field.name());
-      }
-    }
-  }
-
-  if (result_set->has_stats()) {
-    // If we got stats more than once, log it, but use the last one.
-    if (stats_) {
-      GCP_LOG(WARNING) << "Unexpectedly received two sets of stats";
-    }
-    stats_ = std::move(*result_set->mutable_stats());
-  }
-
-  auto& new_values = *result_set->mutable_values();
-
-  // Merge values if necessary, as described in:
-  // https://cloud.google.com/spanner/docs/reference/rpc/google.spanner.v1#google.spanner.v1.PartialResultSet
-  //
-  // As an example, if we receive the following 4 responses (assume the values
-  // are all `string_value`s of type `STRING`):
-  //
-  // ```
-  // { { values: ["A", "B", "C1"] }  chunked_value: true }
-  // { { values: ["C2", "D", "E1"] } chunked_value: true }
-  // { { values: ["E2"] },           chunked_value: true }
-  // { { values: ["E3", "F"] }       chunked_value: false }
-  // ```
-  //
-  // The final values yielded are: `A`, `B`, `C1C2`, `D`, `E1E2E3`, `F`.
-  //
-  // n.b. One value can span more than two responses (the `E1E2E3` case above);
-  // the code "just works" without needing to treat that as a special-case.
-  if (chunk_) {
-    if (new_values.empty()) {
-      return Status(StatusCode::kInternal,
-                    "PartialResultSet contained no values "
-                    "to merge with prior chunked_value");
-    }
-    auto& front = new_values[0];
-    auto merge_status = MergeChunk(*chunk_, std::move(front));
-    if (!merge_status.ok()) {
-      return merge_status;
-    }
-    using std::swap;
-    swap(*chunk_, front);
-    chunk_ = {};
-  }
-
-  if (result_set->chunked_value()) {
-    if (new_values.empty()) {
-      return Status(StatusCode::kInternal,
-                    "PartialResultSet had chunked_value "
-                    "set true but contained no values");
-    }
-    chunk_ = std::move(new_values[new_values.size() - 1]);
-    new_values.RemoveLast();
-  }
-
-  // Moves all the remaining in new_values to buffer_
-  for (auto& value_proto : new_values) {
-    buffer_.push_back(std::move(value_proto));
-  }
-
-  return {};  // OK
+  return assembler_.Push(*std::move(result_set));
 }
 
 }  // namespace internal
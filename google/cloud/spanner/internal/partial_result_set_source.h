@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_PARTIAL_RESULT_SET_SOURCE_H
 
+#include "google/cloud/spanner/internal/partial_result_set_assembler.h"
 #include "google/cloud/spanner/internal/partial_result_set_reader.h"
 #include "google/cloud/spanner/results.h"
 #include "google/cloud/spanner/value.h"
@@ -25,8 +26,8 @@
 #include <google/spanner/v1/spanner.grpc.pb.h>
 #include <google/spanner/v1/spanner.pb.h>
 #include <grpcpp/grpcpp.h>
-#include <deque>
 #include <memory>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -49,12 +50,21 @@ class PartialResultSetSource : public internal::ResultSourceInterface {
 
   StatusOr<Row> NextRow() override;
 
+  /**
+   * Like `NextRow()`, but yields the raw value protos for the next row in
+   * @p row, skipping the `Row`/`Value` materialization.
+   *
+   * Returns `true` if a row was produced, and `false` at end of stream. Used
+   * by the columnar decoder in `NextBatch()`.
+   */
+  StatusOr<bool> NextRowProtos(std::vector<google::protobuf::Value>& row);
+
   absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
-    return metadata_;
+    return assembler_.metadata();
   }
 
   absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
-    return stats_;
+    return assembler_.stats();
   }
 
  private:
@@ -65,11 +75,7 @@ class PartialResultSetSource : public internal::ResultSourceInterface {
   Status ReadFromStream();
 
   std::unique_ptr<PartialResultSetReader> reader_;
-  absl::optional<google::spanner::v1::ResultSetMetadata> metadata_;
-  absl::optional<google::spanner::v1::ResultSetStats> stats_;
-  std::deque<google::protobuf::Value> buffer_;
-  absl::optional<google::protobuf::Value> chunk_;
-  std::shared_ptr<std::vector<std::string>> columns_;
+  PartialResultSetAssembler assembler_;
   bool finished_ = false;
 };
 
@@ -0,0 +1,168 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/partial_result_set_source.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/spanner/value.h"
+#include "absl/memory/memory.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+// These benchmarks replay canned `PartialResultSet` streams through
+// `PartialResultSetSource` and `Row::get<T>()`, isolating the client-side
+// decode path from the server and network costs measured by the end-to-end
+// benchmarks in google/cloud/spanner/benchmarks/. The counters report rows
+// (`items_per_second`) and cell decode throughput.
+
+// A `PartialResultSetReader` that replays a canned stream.
+class CannedReader : public PartialResultSetReader {
+ public:
+  explicit CannedReader(
+      std::vector<spanner_proto::PartialResultSet> const* replay)
+      : replay_(replay) {}
+
+  void TryCancel() override {}
+  absl::optional<spanner_proto::PartialResultSet> Read() override {
+    if (next_ == replay_->size()) return absl::nullopt;
+    return (*replay_)[next_++];
+  }
+  Status Finish() override { return Status(); }
+
+ private:
+  std::vector<spanner_proto::PartialResultSet> const* replay_;
+  std::size_t next_ = 0;
+};
+
+spanner_proto::ResultSetMetadata MakeMetadata(
+    spanner_proto::TypeCode type_code, int columns) {
+  spanner_proto::ResultSetMetadata metadata;
+  for (int i = 0; i != columns; ++i) {
+    auto* field = metadata.mutable_row_type()->add_fields();
+    field->set_name("column" + std::to_string(i));
+    field->mutable_type()->set_code(type_code);
+  }
+  return metadata;
+}
+
+// Makes a stream of `PartialResultSet` responses holding @p rows rows of
+// @p columns copies of @p value each, spread over several responses the way
+// the backend chunks large results.
+std::vector<spanner_proto::PartialResultSet> MakeReplay(
+    spanner_proto::TypeCode type_code, int columns, int rows,
+    google::protobuf::Value const& value) {
+  auto constexpr kValuesPerResponse = 1024;
+  std::vector<spanner_proto::PartialResultSet> replay;
+  spanner_proto::PartialResultSet response;
+  *response.mutable_metadata() = MakeMetadata(type_code, columns);
+  for (int i = 0; i != rows * columns; ++i) {
+    if (response.values_size() == kValuesPerResponse) {
+      replay.push_back(std::move(response));
+      response = spanner_proto::PartialResultSet{};
+    }
+    *response.add_values() = value;
+  }
+  replay.push_back(std::move(response));
+  return replay;
+}
+
+template <typename T>
+void ReplayStream(benchmark::State& state,
+                  std::vector<spanner_proto::PartialResultSet> const& replay,
+                  int columns) {
+  std::int64_t rows = 0;
+  for (auto _ : state) {
+    auto source = PartialResultSetSource::Create(
+        absl::make_unique<CannedReader>(&replay));
+    if (!source) {
+      state.SkipWithError(source.status().message().c_str());
+      break;
+    }
+    for (auto row = (*source)->NextRow(); row && row->size() != 0;
+         row = (*source)->NextRow()) {
+      for (std::size_t i = 0; i != row->size(); ++i) {
+        benchmark::DoNotOptimize(row->get<T>(i));
+      }
+      ++rows;
+    }
+  }
+  state.SetItemsProcessed(rows);
+  state.counters["cells_per_second"] = benchmark::Counter(
+      static_cast<double>(rows * columns), benchmark::Counter::kIsRate);
+}
+
+auto constexpr kRows = 1000;
+auto constexpr kColumns = 4;
+
+void BM_DecodeInt64(benchmark::State& state) {
+  google::protobuf::Value value;
+  value.set_string_value("8589934592");  // INT64 is encoded as a string
+  auto const replay =
+      MakeReplay(spanner_proto::TypeCode::INT64, kColumns, kRows, value);
+  ReplayStream<std::int64_t>(state, replay, kColumns);
+}
+BENCHMARK(BM_DecodeInt64);
+
+void BM_DecodeFloat64(benchmark::State& state) {
+  google::protobuf::Value value;
+  value.set_number_value(3.14159265358979323846);
+  auto const replay =
+      MakeReplay(spanner_proto::TypeCode::FLOAT64, kColumns, kRows, value);
+  ReplayStream<double>(state, replay, kColumns);
+}
+BENCHMARK(BM_DecodeFloat64);
+
+void BM_DecodeBool(benchmark::State& state) {
+  google::protobuf::Value value;
+  value.set_bool_value(true);
+  auto const replay =
+      MakeReplay(spanner_proto::TypeCode::BOOL, kColumns, kRows, value);
+  ReplayStream<bool>(state, replay, kColumns);
+}
+BENCHMARK(BM_DecodeBool);
+
+void BM_DecodeString(benchmark::State& state) {
+  google::protobuf::Value value;
+  value.set_string_value(std::string(64, 'x'));
+  auto const replay =
+      MakeReplay(spanner_proto::TypeCode::STRING, kColumns, kRows, value);
+  ReplayStream<std::string>(state, replay, kColumns);
+}
+BENCHMARK(BM_DecodeString);
+
+void BM_DecodeTimestamp(benchmark::State& state) {
+  google::protobuf::Value value;
+  value.set_string_value("2020-09-15T14:59:59.123456789Z");
+  auto const replay =
+      MakeReplay(spanner_proto::TypeCode::TIMESTAMP, kColumns, kRows, value);
+  ReplayStream<Timestamp>(state, replay, kColumns);
+}
+BENCHMARK(BM_DecodeTimestamp);
+
+}  // namespace
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -21,7 +21,12 @@
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/status_or.h"
 #include <google/longrunning/operations.pb.h>
+#include <google/spanner/admin/database/v1/backup.pb.h>
+#include <google/spanner/admin/database/v1/common.pb.h>
+#include <google/spanner/admin/database/v1/spanner_database_admin.pb.h>
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <chrono>
 #include <thread>
 
 namespace google {
@@ -89,6 +94,59 @@ struct PollingLoopMetadataExtractor {
   }
 };
 
+/**
+ * Compute how long to wait before polling @p operation again.
+ *
+ * The backup and restore operations report their progress (percent complete
+ * and start time) in the operation metadata. When that information is
+ * available, estimate the time remaining from the progress rate so far and
+ * space the polls at half that estimate, instead of polling on the fixed
+ * `PollingPolicy` cadence. This avoids poll storms when many slow operations
+ * run concurrently, while still completing promptly. The result is clamped
+ * to `[wait_period, 10 * wait_period]`, so the policy cadence remains both
+ * the floor and (up to a small factor) the ceiling. Operations that do not
+ * report progress just use @p wait_period.
+ */
+inline std::chrono::milliseconds AdaptivePollDelay(
+    std::chrono::milliseconds wait_period,
+    google::longrunning::Operation const& operation,
+    std::chrono::system_clock::time_point now =
+        std::chrono::system_clock::now()) {
+  namespace gcsa = ::google::spanner::admin::database::v1;
+  if (!operation.has_metadata()) return wait_period;
+  auto const& any = operation.metadata();
+  gcsa::OperationProgress progress;
+  if (any.Is<gcsa::CreateBackupMetadata>()) {
+    gcsa::CreateBackupMetadata metadata;
+    any.UnpackTo(&metadata);
+    progress = metadata.progress();
+  } else if (any.Is<gcsa::RestoreDatabaseMetadata>()) {
+    gcsa::RestoreDatabaseMetadata metadata;
+    any.UnpackTo(&metadata);
+    progress = metadata.progress();
+  } else if (any.Is<gcsa::OptimizeRestoredDatabaseMetadata>()) {
+    gcsa::OptimizeRestoredDatabaseMetadata metadata;
+    any.UnpackTo(&metadata);
+    progress = metadata.progress();
+  } else {
+    return wait_period;
+  }
+  auto const percent = progress.progress_percent();
+  if (percent <= 0 || percent >= 100 || !progress.has_start_time()) {
+    return wait_period;
+  }
+  auto const start = std::chrono::system_clock::time_point(
+      std::chrono::seconds(progress.start_time().seconds()));
+  auto const elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+  if (elapsed.count() <= 0) return wait_period;
+  // With `percent` done after `elapsed`, the remainder should take about
+  // `elapsed * (100 - percent) / percent`. Poll at half that, so we detect
+  // completion within ~50% of the estimate even if the rate fluctuates.
+  auto const remaining = elapsed * (100 - percent) / percent;
+  return (std::min)((std::max)(remaining / 2, wait_period), 10 * wait_period);
+}
+
 /**
  * A generic retry loop for gRPC operations.
  *
@@ -125,7 +183,7 @@ typename ValueExtractor::ReturnType PollingLoopImpl(
   Status last_status;
 
   while (!operation.done()) {
-    sleeper(polling_policy->WaitPeriod());
+    sleeper(AdaptivePollDelay(polling_policy->WaitPeriod(), operation));
 
     grpc::ClientContext poll_context;
     google::longrunning::GetOperationRequest poll_request;
@@ -45,6 +45,75 @@ StatusOr<google::longrunning::Operation> ShouldNotBeCalled(
   return make_status_or(google::longrunning::Operation{});
 }
 
+TEST(PollingLoopTest, AdaptivePollDelayNoMetadata) {
+  google::longrunning::Operation operation;
+  operation.set_name("test-operation");
+  auto const period = std::chrono::milliseconds(std::chrono::seconds(10));
+  EXPECT_EQ(period, AdaptivePollDelay(period, operation));
+}
+
+TEST(PollingLoopTest, AdaptivePollDelayUsesReportedProgress) {
+  namespace gcsa = ::google::spanner::admin::database::v1;
+  auto const now =
+      std::chrono::system_clock::time_point(std::chrono::seconds(1000000));
+
+  gcsa::CreateBackupMetadata metadata;
+  metadata.mutable_progress()->set_progress_percent(50);
+  // Started 60 seconds ago; at 50% the estimated remainder is 60 seconds.
+  metadata.mutable_progress()->mutable_start_time()->set_seconds(1000000 - 60);
+  google::longrunning::Operation operation;
+  operation.set_name("test-operation");
+  operation.mutable_metadata()->PackFrom(metadata);
+
+  auto const period = std::chrono::milliseconds(std::chrono::seconds(10));
+  // Half the 60 second estimate, well within the clamping range.
+  EXPECT_EQ(std::chrono::seconds(30),
+            AdaptivePollDelay(period, operation, now));
+}
+
+TEST(PollingLoopTest, AdaptivePollDelayClamped) {
+  namespace gcsa = ::google::spanner::admin::database::v1;
+  auto const now =
+      std::chrono::system_clock::time_point(std::chrono::seconds(1000000));
+  auto const period = std::chrono::milliseconds(std::chrono::seconds(10));
+
+  gcsa::RestoreDatabaseMetadata metadata;
+  metadata.mutable_progress()->set_progress_percent(1);
+  metadata.mutable_progress()->mutable_start_time()->set_seconds(1000000 - 100);
+  google::longrunning::Operation operation;
+  operation.set_name("test-operation");
+  operation.mutable_metadata()->PackFrom(metadata);
+  // The ~9900 second estimate is clamped to 10x the policy cadence.
+  EXPECT_EQ(std::chrono::seconds(100),
+            AdaptivePollDelay(period, operation, now));
+
+  metadata.mutable_progress()->set_progress_percent(99);
+  operation.mutable_metadata()->PackFrom(metadata);
+  // The ~1 second estimate never polls faster than the policy cadence.
+  EXPECT_EQ(period, AdaptivePollDelay(period, operation, now));
+}
+
+TEST(PollingLoopTest, AdaptivePollDelayIgnoresUnusableProgress) {
+  namespace gcsa = ::google::spanner::admin::database::v1;
+  auto const now =
+      std::chrono::system_clock::time_point(std::chrono::seconds(1000000));
+  auto const period = std::chrono::milliseconds(std::chrono::seconds(10));
+
+  // No progress percent reported yet.
+  gcsa::OptimizeRestoredDatabaseMetadata metadata;
+  metadata.mutable_progress()->mutable_start_time()->set_seconds(1000000 - 60);
+  google::longrunning::Operation operation;
+  operation.set_name("test-operation");
+  operation.mutable_metadata()->PackFrom(metadata);
+  EXPECT_EQ(period, AdaptivePollDelay(period, operation, now));
+
+  // A start time in the future yields no usable rate.
+  metadata.mutable_progress()->set_progress_percent(50);
+  metadata.mutable_progress()->mutable_start_time()->set_seconds(1000000 + 60);
+  operation.mutable_metadata()->PackFrom(metadata);
+  EXPECT_EQ(period, AdaptivePollDelay(period, operation, now));
+}
+
 TEST(PollingLoopTest, ExtractResponseSuccess) {
   google::protobuf::Value expected;
   expected.set_string_value("42");
@@ -21,6 +21,7 @@
 #include "google/cloud/internal/invoke_result.h"
 #include "google/cloud/status_or.h"
 #include <grpcpp/grpcpp.h>
+#include <chrono>
 #include <thread>
 
 namespace google {
@@ -77,10 +78,18 @@ auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
                    Sleeper sleeper)
     -> google::cloud::internal::invoke_result_t<Functor, grpc::ClientContext&,
                                                 Request const&> {
+  auto const overall_deadline = retry_policy->deadline();
+  bool time_budget_consumed = false;
   Status last_status;
   while (!retry_policy->IsExhausted()) {
     // Need to create a new context for each retry.
     grpc::ClientContext context;
+    if (overall_deadline !=
+        (std::chrono::system_clock::time_point::max)()) {
+      // Bound each attempt by the remaining time budget, so the per-attempt
+      // timeout shrinks as the budget is consumed.
+      context.set_deadline(overall_deadline);
+    }
     auto result = functor(context, request);
     if (result.ok()) {
       return result;
@@ -95,9 +104,17 @@ auto RetryLoopImpl(std::unique_ptr<RetryPolicy> retry_policy,
       // way, exit the loop.
       break;
     }
-    sleeper(backoff_policy->OnCompletion());
+    auto delay = backoff_policy->OnCompletion();
+    if (std::chrono::system_clock::now() + delay >= overall_deadline) {
+      // Sleeping for the backoff period would consume the remaining time
+      // budget, and the next attempt would start with no time to succeed.
+      // Report the retry policy as exhausted rather than make that attempt.
+      time_budget_consumed = true;
+      break;
+    }
+    sleeper(delay);
   }
-  if (!retry_policy->IsExhausted()) {
+  if (!time_budget_consumed && !retry_policy->IsExhausted()) {
     // The last error cannot be retried, but it is not because the retry
     // policy is exhausted, we call these "permanent errors", and they
     // get a special message.
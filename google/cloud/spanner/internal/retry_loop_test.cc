@@ -153,6 +153,44 @@ TEST(RetryLoopTest, TooManyTransientFailuresIdempotent) {
   EXPECT_THAT(actual.status().message(), HasSubstr("Retry policy exhausted"));
 }
 
+TEST(RetryLoopTest, SetsAttemptDeadlineFromTimeBudget) {
+  auto const start = std::chrono::system_clock::now();
+  StatusOr<int> actual = RetryLoop(
+      LimitedTimeRetryPolicy(std::chrono::minutes(5)).clone(),
+      TestBackoffPolicy(), true,
+      [&start](grpc::ClientContext& context, int request) {
+        EXPECT_LE(context.deadline(), start + std::chrono::minutes(6));
+        return StatusOr<int>(2 * request);
+      },
+      42, "error message");
+  EXPECT_STATUS_OK(actual);
+  EXPECT_EQ(84, *actual);
+}
+
+TEST(RetryLoopTest, SkipsAttemptDoomedByTimeBudget) {
+  using ms = std::chrono::milliseconds;
+
+  std::unique_ptr<MockBackoffPolicy> mock(new MockBackoffPolicy);
+  // The backoff is longer than the whole time budget, so after the first
+  // failure the loop should give up rather than sleep and make an attempt
+  // that starts with no time left.
+  EXPECT_CALL(*mock, OnCompletion()).WillOnce(Return(ms(500)));
+
+  int counter = 0;
+  std::vector<ms> sleep_for;
+  StatusOr<int> actual = RetryLoopImpl(
+      LimitedTimeRetryPolicy(ms(250)).clone(), std::move(mock), true,
+      [&counter](grpc::ClientContext&, int) {
+        ++counter;
+        return StatusOr<int>(Status(StatusCode::kUnavailable, "try again"));
+      },
+      42, "error message", [&sleep_for](ms p) { sleep_for.push_back(p); });
+  EXPECT_EQ(1, counter);
+  EXPECT_TRUE(sleep_for.empty());
+  EXPECT_EQ(StatusCode::kUnavailable, actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("Retry policy exhausted"));
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace SPANNER_CLIENT_NS
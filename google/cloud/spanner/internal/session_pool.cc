@@ -18,11 +18,14 @@
 #include "google/cloud/spanner/internal/session.h"
 #include "google/cloud/completion_queue.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
+#include "google/cloud/internal/metrics.h"
 #include "google/cloud/log.h"
 #include "google/cloud/status.h"
 #include "absl/memory/memory.h"
 #include <algorithm>
 #include <chrono>
+#include <functional>
+#include <map>
 #include <random>
 #include <thread>
 #include <utility>
@@ -36,6 +39,14 @@ namespace internal {
 
 namespace spanner_proto = ::google::spanner::v1;
 
+constexpr std::size_t SessionPool::kWaitDurationBuckets;
+
+namespace {
+// How often the background maintenance (pool sizing and session refresh)
+// runs.
+auto constexpr kBackgroundWorkPeriod = std::chrono::seconds(5);
+}  // namespace
+
 std::shared_ptr<SessionPool> MakeSessionPool(
     Database db, std::vector<std::shared_ptr<SpannerStub>> stubs,
     SessionPoolOptions options, google::cloud::CompletionQueue cq,
@@ -77,14 +88,72 @@ SessionPool::SessionPool(Database db,
   }
   // `channels_` is never resized after this point.
   next_dissociated_stub_channel_ = channels_.begin();
+
+  // More free-list shards than threads adds no value, and too many shards
+  // makes stealing from other shards expensive. `shards_` is never resized
+  // after this point.
+  auto shard_count = std::thread::hardware_concurrency();
+  if (shard_count == 0 || shard_count > 16) {
+    shard_count = shard_count == 0 ? 1 : 16;
+  }
+  shards_.reserve(shard_count);
+  for (unsigned int i = 0; i != shard_count; ++i) {
+    shards_.push_back(absl::make_unique<SessionShard>());
+  }
 }
 
 void SessionPool::Initialize() {
   if (options_.min_sessions() > 0) {
     std::unique_lock<std::mutex> lk(mu_);
-    (void)Grow(lk, options_.min_sessions(), WaitForSessionAllocation::kWait);
+    auto create_counts = ComputeCreateCounts(options_.min_sessions());
+    if (!create_counts.ok()) {
+      warmup_done_ = make_ready_future(std::move(create_counts).status());
+    } else if (!create_counts->empty()) {
+      create_calls_in_progress_ += static_cast<int>(create_counts->size());
+      lk.unlock();
+      // Warm up all the channels concurrently. A serial warmup multiplies
+      // the session-create latency by the channel count, and freshly
+      // deployed binaries would pay that on their first requests.
+      struct WarmupState {
+        explicit WarmupState(int n) : remaining(n) {}
+        std::mutex mu;
+        int remaining;  // GUARDED_BY(mu)
+        Status status;  // GUARDED_BY(mu), the first error seen
+        promise<Status> done;
+      };
+      auto state = std::make_shared<WarmupState>(
+          static_cast<int>(create_counts->size()));
+      // The threads hold a reference to the pool, so it cannot be destroyed
+      // while any warmup call is still in progress.
+      auto self = shared_from_this();
+      for (auto const& op : *create_counts) {
+        std::thread(
+            [self, state](std::shared_ptr<Channel> const& channel,
+                          int session_count) {
+              auto status = self->CreateSessionsSync(
+                  channel, self->options_.labels(), session_count);
+              std::unique_lock<std::mutex> lk(state->mu);
+              if (state->status.ok() && !status.ok()) {
+                state->status = std::move(status);
+              }
+              if (--state->remaining == 0) {
+                auto result = std::move(state->status);
+                lk.unlock();
+                state->done.set_value(std::move(result));
+              }
+            },
+            op.channel, op.session_count)
+            .detach();
+      }
+      warmup_done_ = state->done.get_future();
+    }
   }
-  ScheduleBackgroundWork(std::chrono::seconds(5));
+  ScheduleBackgroundWork(kBackgroundWorkPeriod);
+}
+
+future<Status> SessionPool::WarmupCompleted() {
+  if (!warmup_done_.valid()) return make_ready_future(Status());
+  return std::move(warmup_done_);
 }
 
 SessionPool::~SessionPool() {
@@ -119,7 +188,7 @@ void SessionPool::ScheduleBackgroundWork(std::chrono::seconds relative_time) {
 void SessionPool::DoBackgroundWork() {
   MaintainPoolSize();
   RefreshExpiringSessions();
-  ScheduleBackgroundWork(std::chrono::seconds(5));
+  ScheduleBackgroundWork(kBackgroundWorkPeriod);
 }
 
 // Ensure the pool size conforms to what was specified in the `SessionOptions`,
@@ -133,8 +202,13 @@ void SessionPool::MaintainPoolSize() {
   }
 }
 
-// Refresh all sessions whose last-use time is older than the keep-alive
-// interval. Issues asynchronous RPCs, so this method does not block.
+// Refresh sessions whose last-use time is older than the keep-alive
+// interval. The refreshes issued in one cycle are capped, and each channel's
+// share of them is capped, so a large idle pool is pinged in small windows
+// spread over the keep-alive interval and across the channels, instead of in
+// one burst. Sessions over the cap keep their last-use time, which keeps
+// `last_use_time_lower_bound_` old enough for the next cycle to resume where
+// this one stopped. Issues asynchronous RPCs, so this method does not block.
 void SessionPool::RefreshExpiringSessions() {
   std::vector<std::pair<std::shared_ptr<SpannerStub>, std::string>>
       sessions_to_refresh;
@@ -143,32 +217,104 @@ void SessionPool::RefreshExpiringSessions() {
   {
     std::unique_lock<std::mutex> lk(mu_);
     if (last_use_time_lower_bound_ <= refresh_limit) {
+      // Budget the refreshes so that a fully-idle pool is refreshed over
+      // half the keep-alive interval, leaving the other half as headroom
+      // before the backend could expire the sessions.
+      auto const cycles = (std::max<std::int64_t>)(
+          options_.keep_alive_interval() / kBackgroundWorkPeriod / 2, 1);
+      auto const max_refreshes = total_sessions_ / static_cast<int>(cycles) + 1;
+      auto const max_per_channel =
+          max_refreshes / static_cast<int>(channels_.size()) + 1;
+      std::map<Channel*, int> refreshes_per_channel;
+      int refreshes = 0;
       last_use_time_lower_bound_ = now;
-      for (auto const& session : sessions_) {
-        auto last_use_time = session->last_use_time();
-        if (last_use_time <= refresh_limit) {
-          sessions_to_refresh.emplace_back(session->channel()->stub,
-                                           session->session_name());
-          session->update_last_use_time();
-        } else if (last_use_time < last_use_time_lower_bound_) {
-          last_use_time_lower_bound_ = last_use_time;
+      for (auto const& shard : shards_) {
+        std::lock_guard<std::mutex> slk(shard->mu);
+        for (auto const& session : shard->sessions) {
+          auto last_use_time = session->last_use_time();
+          if (last_use_time <= refresh_limit && refreshes != max_refreshes) {
+            auto& channel_refreshes =
+                refreshes_per_channel[session->channel().get()];
+            if (channel_refreshes != max_per_channel) {
+              ++channel_refreshes;
+              ++refreshes;
+              sessions_to_refresh.emplace_back(session->channel()->stub,
+                                               session->session_name());
+              session->update_last_use_time();
+              continue;
+            }
+          }
+          if (last_use_time < last_use_time_lower_bound_) {
+            last_use_time_lower_bound_ = last_use_time;
+          }
         }
       }
     }
   }
+  std::weak_ptr<SessionPool> pool = shared_from_this();
   for (auto& refresh : sessions_to_refresh) {
+    ++refresh_rpcs_;
     AsyncRefreshSession(cq_, refresh.first, std::move(refresh.second))
-        .then([](future<StatusOr<spanner_proto::ResultSet>> result) {
+        .then([pool](future<StatusOr<spanner_proto::ResultSet>> result) {
           // We simply discard the response as handling IsSessionNotFound()
           // by removing the session from the pool is problematic (and would
           // not eliminate the possibility of IsSessionNotFound() elsewhere).
           // The last-use time has already been updated to throttle attempts.
           // TODO(#1430): Re-evaluate these decisions.
-          (void)result.get();
+          auto const ok = result.get().ok();
+          if (auto shared_pool = pool.lock()) {
+            if (ok) {
+              ++shared_pool->sessions_refreshed_;
+            } else {
+              ++shared_pool->refresh_failures_;
+            }
+          }
         });
   }
 }
 
+SessionPool::PoolHealth SessionPool::GetPoolHealth() {
+  PoolHealth health;
+  health.available_sessions = available_sessions_.load();
+  health.sessions_refreshed = sessions_refreshed_.load();
+  health.refresh_failures = refresh_failures_.load();
+  std::unique_lock<std::mutex> lk(mu_);
+  health.total_sessions = total_sessions_;
+  return health;
+}
+
+void SessionPool::RecordWaitDuration(
+    std::chrono::steady_clock::duration elapsed) {
+  auto const ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  total_wait_ms_ += ms;
+  std::size_t bucket = 0;
+  while (bucket + 1 < kWaitDurationBuckets && (ms >> bucket) != 0) ++bucket;
+  ++wait_duration_histogram_[bucket];
+  // Also mirror the wait into the process-wide registry, where applications
+  // can export it alongside the metrics from the other client libraries.
+  auto& registry = google::cloud::internal::MetricsRegistry::Instance();
+  static auto& pool_waits = registry.Counter("spanner.session_pool.waits");
+  static auto& pool_wait_ms =
+      registry.Histogram("spanner.session_pool.wait_ms");
+  pool_waits.Increment();
+  pool_wait_ms.Record(ms);
+}
+
+SessionPool::Counters SessionPool::Snapshot() const {
+  Counters counters;
+  counters.sessions_allocated = sessions_allocated_.load();
+  counters.allocation_waits = allocation_waits_.load();
+  counters.total_wait_ms = total_wait_ms_.load();
+  counters.exhausted_failures = exhausted_failures_.load();
+  counters.create_rpcs = create_rpcs_.load();
+  counters.refresh_rpcs = refresh_rpcs_.load();
+  for (std::size_t i = 0; i != kWaitDurationBuckets; ++i) {
+    counters.wait_duration_histogram[i] = wait_duration_histogram_[i].load();
+  }
+  return counters;
+}
+
 /**
  * Grow the session pool by creating up to `sessions_to_create` sessions and
  * adding them to the pool.  Note that `lk` may be released and reacquired in
@@ -265,31 +411,67 @@ Status SessionPool::CreateSessions(
   return return_status;
 }
 
+SessionPool::SessionShard& SessionPool::PreferredShard() {
+  auto const id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  return *shards_[id % shards_.size()];
+}
+
+std::unique_ptr<Session> SessionPool::TryAcquireSession() {
+  // Checking the atomic count first makes an empty pool cheap: no locks are
+  // acquired when there is nothing to take.
+  if (available_sessions_.load() == 0) return nullptr;
+  auto const id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  auto const num_shards = shards_.size();
+  for (std::size_t i = 0; i != num_shards; ++i) {
+    auto& shard = *shards_[(id + i) % num_shards];
+    std::lock_guard<std::mutex> lk(shard.mu);
+    if (shard.sessions.empty()) continue;
+    // Return the most recently used session in the shard.
+    auto session = std::move(shard.sessions.back());
+    shard.sessions.pop_back();
+    --available_sessions_;
+    return session;
+  }
+  return nullptr;
+}
+
 StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
-  std::unique_lock<std::mutex> lk(mu_);
   for (;;) {
-    if (!sessions_.empty()) {
-      // return the most recently used session.
-      auto session = std::move(sessions_.back());
-      sessions_.pop_back();
+    // Fast path: take a session from the sharded free-list without ever
+    // acquiring the pool-wide lock.
+    auto session = TryAcquireSession();
+    if (session) {
       if (dissociate_from_pool) {
+        std::unique_lock<std::mutex> lk(mu_);
         --total_sessions_;
         auto const& channel = session->channel();
         if (channel) {
           --channel->session_count;
         }
       }
+      ++sessions_allocated_;
+      static auto& pool_checkouts =
+          google::cloud::internal::MetricsRegistry::Instance().Counter(
+              "spanner.session_pool.checkouts");
+      pool_checkouts.Increment();
       return {MakeSessionHolder(std::move(session), dissociate_from_pool)};
     }
 
+    std::unique_lock<std::mutex> lk(mu_);
+    // A session may have been released between `TryAcquireSession()` and
+    // acquiring `mu_`; if so just retry the fast path.
+    if (available_sessions_.load() > 0) continue;
+
     // If the pool is at its max size, fail or wait until someone returns a
     // session to the pool then try again.
     if (total_sessions_ >= max_pool_size_) {
       if (options_.action_on_exhaustion() == ActionOnExhaustion::kFail) {
+        ++exhausted_failures_;
         return Status(StatusCode::kResourceExhausted, "session pool exhausted");
       }
       Wait(lk, [this] {
-        return !sessions_.empty() || total_sessions_ < max_pool_size_;
+        return available_sessions_.load() > 0 ||
+               total_sessions_ < max_pool_size_;
       });
       continue;
     }
@@ -302,7 +484,8 @@ StatusOr<SessionHolder> SessionPool::Allocate(bool dissociate_from_pool) {
     // number of waiters in the `sessions_to_create` calculation below.
     if (create_calls_in_progress_ > 0) {
       Wait(lk, [this] {
-        return !sessions_.empty() || create_calls_in_progress_ == 0;
+        return available_sessions_.load() > 0 ||
+               create_calls_in_progress_ == 0;
       });
       continue;
     }
@@ -334,11 +517,24 @@ std::shared_ptr<SpannerStub> SessionPool::GetStub(Session const& session) {
   return stub;
 }
 
-void SessionPool::Release(std::unique_ptr<Session> session) {
+StreamChannelLease SessionPool::GetStreamStub(Session const& session) {
+  auto best = session.channel();
   std::unique_lock<std::mutex> lk(mu_);
+  // Route the stream to the least-loaded channel, preferring the session's
+  // own channel on ties (`<` rather than `<=`).
+  for (auto const& channel : channels_) {
+    if (!best || channel->in_flight_streams < best->in_flight_streams) {
+      best = channel;
+    }
+  }
+  return StreamChannelLease(std::move(best));
+}
+
+void SessionPool::Release(std::unique_ptr<Session> session) {
   if (session->is_bad()) {
     // Once we have support for background processing, we may want to signal
     // that to replenish this bad session.
+    std::unique_lock<std::mutex> lk(mu_);
     --total_sessions_;
     auto const& channel = session->channel();
     if (channel) {
@@ -347,8 +543,18 @@ void SessionPool::Release(std::unique_ptr<Session> session) {
     return;
   }
   session->update_last_use_time();
-  sessions_.push_back(std::move(session));
-  if (num_waiting_for_session_ > 0) {
+  {
+    auto& shard = PreferredShard();
+    std::lock_guard<std::mutex> lk(shard.mu);
+    shard.sessions.push_back(std::move(session));
+  }
+  ++available_sessions_;
+  if (num_waiting_for_session_.load() > 0) {
+    // Acquiring and releasing `mu_` before notifying ensures a thread that
+    // registered as a waiter, but has not blocked yet, observes the released
+    // session when it re-evaluates its predicate; otherwise the notification
+    // could be lost.
+    std::unique_lock<std::mutex> lk(mu_);
     lk.unlock();
     cond_.notify_one();
   }
@@ -358,6 +564,7 @@ void SessionPool::Release(std::unique_ptr<Session> session) {
 Status SessionPool::CreateSessionsSync(
     std::shared_ptr<Channel> const& channel,
     std::map<std::string, std::string> const& labels, int num_sessions) {
+  ++create_rpcs_;
   spanner_proto::BatchCreateSessionsRequest request;
   request.set_database(db_.FullName());
   request.mutable_session_template()->mutable_labels()->insert(labels.begin(),
@@ -378,6 +585,7 @@ Status SessionPool::CreateSessionsSync(
 void SessionPool::CreateSessionsAsync(
     std::shared_ptr<Channel> const& channel,
     std::map<std::string, std::string> const& labels, int num_sessions) {
+  ++create_rpcs_;
   std::weak_ptr<SessionPool> pool = shared_from_this();
   AsyncBatchCreateSessions(cq_, channel->stub, labels, num_sessions)
       .then([pool, channel](
@@ -475,13 +683,22 @@ Status SessionPool::HandleBatchCreateSessionsDone(
   auto const sessions_created = response->session_size();
   channel->session_count += sessions_created;
   total_sessions_ += sessions_created;
-  sessions_.reserve(sessions_.size() + sessions_created);
+  std::vector<std::unique_ptr<Session>> new_sessions;
+  new_sessions.reserve(sessions_created);
   for (auto& session : *response->mutable_session()) {
-    sessions_.push_back(absl::make_unique<Session>(
+    new_sessions.push_back(absl::make_unique<Session>(
         std::move(*session.mutable_name()), channel, clock_));
   }
-  // Shuffle the pool so we distribute returned sessions across channels.
-  std::shuffle(sessions_.begin(), sessions_.end(), random_generator_);
+  // Shuffle the new sessions so we distribute returned sessions across
+  // channels, then spread them over the free-list shards.
+  std::shuffle(new_sessions.begin(), new_sessions.end(), random_generator_);
+  auto shard_index = static_cast<std::size_t>(random_generator_());
+  for (auto& session : new_sessions) {
+    auto& shard = *shards_[shard_index++ % shards_.size()];
+    std::lock_guard<std::mutex> slk(shard.mu);
+    shard.sessions.push_back(std::move(session));
+  }
+  available_sessions_ += sessions_created;
 
   // Wake up anyone who was waiting for a `Session`.
   lk.unlock();
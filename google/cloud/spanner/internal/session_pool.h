@@ -27,9 +27,12 @@
 #include "google/cloud/future.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/spanner.pb.h>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -45,6 +48,34 @@ inline namespace SPANNER_CLIENT_NS {
 namespace internal {
 struct SessionPoolFriendForTest;
 
+/**
+ * A `SpannerStub` for a streaming operation, bundled with the in-flight
+ * stream accounting for the channel that owns the stub.
+ *
+ * While any copy of this object is alive the stream counts against the
+ * channel's load, which `SessionPool::GetStreamStub()` uses to route new
+ * streams to the least-loaded channel.
+ */
+class StreamChannelLease {
+ public:
+  StreamChannelLease() = default;
+  explicit StreamChannelLease(std::shared_ptr<Channel> channel)
+      : channel_(std::move(channel)) {
+    ++channel_->in_flight_streams;
+    auto held = channel_;
+    token_ = std::shared_ptr<void>(
+        nullptr, [held](void*) { --held->in_flight_streams; });
+  }
+
+  std::shared_ptr<SpannerStub> const& stub() const { return channel_->stub; }
+  SpannerStub* operator->() const { return channel_->stub.get(); }
+
+ private:
+  std::shared_ptr<Channel> channel_;
+  // Decrements `channel_->in_flight_streams` when the last copy goes away.
+  std::shared_ptr<void> token_;
+};
+
 /**
  * Maintains a pool of `Session` objects.
  *
@@ -57,6 +88,13 @@ struct SessionPoolFriendForTest;
  * Allocation from the pool is LIFO to take advantage of the fact the Spanner
  * backends maintain a cache of sessions which is valid for 30 seconds, so
  * re-using Sessions as quickly as possible has performance advantages.
+ *
+ * The free-list is sharded, with each thread preferring the shard selected by
+ * its thread id. In steady state (sessions available, no pool growth in
+ * progress) allocating and releasing a `Session` only touches one shard, so
+ * many threads can check sessions in and out without contending on a
+ * pool-wide lock. The pool-wide lock is only needed to grow the pool or to
+ * wait for a session to be released.
  */
 class SessionPool : public std::enable_shared_from_this<SessionPool> {
  public:
@@ -81,6 +119,20 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
    */
   void Initialize();
 
+  /**
+   * A future satisfied when the initial `min_sessions` warmup completes.
+   *
+   * `Initialize()` issues the warmup `BatchCreateSessions` calls for all the
+   * channels concurrently and returns without waiting for them. Applications
+   * that want a fully-warmed pool before serving traffic (e.g. a deployment
+   * health check) can block on this future. It holds the first error status
+   * if any of the calls failed; the pool remains usable either way, growing
+   * on demand.
+   *
+   * May be called at most once; later calls return a ready `Status`.
+   */
+  future<Status> WarmupCompleted();
+
   /**
    * Allocate a `Session` from the pool, creating a new one if necessary.
    *
@@ -99,6 +151,60 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
    */
   std::shared_ptr<SpannerStub> GetStub(Session const& session);
 
+  /**
+   * Return a stub for a new streaming read or query using `session`.
+   *
+   * Streams are routed to the channel with the fewest in-flight streams,
+   * preferring the session's own channel on a tie. This keeps a high fan-out
+   * of streaming reads spread over all the HTTP/2 connections rather than
+   * piling onto one and hitting its per-connection flow-control limits.
+   */
+  StreamChannelLease GetStreamStub(Session const& session);
+
+  /**
+   * A snapshot of the pool's health counters.
+   *
+   * `sessions_refreshed` and `refresh_failures` accumulate over the life of
+   * the pool; the other fields reflect the state at the time of the call.
+   */
+  struct PoolHealth {
+    int total_sessions;
+    int available_sessions;
+    std::int64_t sessions_refreshed;
+    std::int64_t refresh_failures;
+  };
+  PoolHealth GetPoolHealth();
+
+  /// The number of buckets in `Counters::wait_duration_histogram`.
+  static constexpr std::size_t kWaitDurationBuckets = 16;
+
+  /**
+   * A snapshot of the pool's cumulative activity counters.
+   *
+   * All fields accumulate over the life of the pool, so a metrics scraper
+   * can export them as monotonic counters and compute rates. Bucket `i` of
+   * `wait_duration_histogram` counts the waits that took less than `2^i`
+   * milliseconds (and at least `2^(i-1)` milliseconds for `i > 0`); the
+   * last bucket also counts all longer waits.
+   */
+  struct Counters {
+    std::int64_t sessions_allocated;  ///< successful `Allocate()` calls
+    std::int64_t allocation_waits;    ///< `Allocate()` calls that blocked
+    std::int64_t total_wait_ms;       ///< total time blocked in `Allocate()`
+    std::int64_t exhausted_failures;  ///< `Allocate()` failures, pool full
+    std::int64_t create_rpcs;  ///< `BatchCreateSessions` calls, sans retries
+    std::int64_t refresh_rpcs;  ///< session refresh calls issued
+    std::array<std::int64_t, kWaitDurationBuckets> wait_duration_histogram;
+  };
+
+  /**
+   * Returns the current value of the activity counters.
+   *
+   * Cheap enough to scrape frequently: it only loads the atomic counters
+   * and takes no locks.
+   */
+  Counters Snapshot() const;
+
  private:
   // Represents a request to create `session_count` sessions on `channel`
   // See `ComputeCreateCounts` and `CreateSessions`.
@@ -108,6 +214,22 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   };
   enum class WaitForSessionAllocation { kWait, kNoWait };
 
+  // One shard of the session free-list. Sharding the list (and the mutex
+  // protecting it) keeps session checkout cheap when many threads allocate
+  // and release sessions concurrently.
+  struct SessionShard {
+    std::mutex mu;
+    std::vector<std::unique_ptr<Session>> sessions;  // GUARDED_BY(mu)
+  };
+
+  // The shard preferred by the calling thread.
+  SessionShard& PreferredShard();
+
+  // Pop a session from the free-list, preferring the calling thread's shard
+  // and stealing from the other shards when it is empty. Returns nullptr if
+  // no session is available.
+  std::unique_ptr<Session> TryAcquireSession();
+
   // Release session back to the pool.
   void Release(std::unique_ptr<Session> session);
 
@@ -116,10 +238,16 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
   template <typename Predicate>
   void Wait(std::unique_lock<std::mutex>& lk, Predicate&& p) {
     ++num_waiting_for_session_;
+    ++allocation_waits_;
+    auto const start = std::chrono::steady_clock::now();
     cond_.wait(lk, std::forward<Predicate>(p));
+    RecordWaitDuration(std::chrono::steady_clock::now() - start);
     --num_waiting_for_session_;
   }
 
+  // Record a completed `Allocate()` wait in the activity counters.
+  void RecordWaitDuration(std::chrono::steady_clock::duration elapsed);
+
   Status Grow(std::unique_lock<std::mutex>& lk, int sessions_to_create,
               WaitForSessionAllocation wait);  // EXCLUSIVE_LOCKS_REQUIRED(mu_)
   StatusOr<std::vector<CreateCount>> ComputeCreateCounts(
@@ -172,17 +300,41 @@ class SessionPool : public std::enable_shared_from_this<SessionPool> {
 
   std::mutex mu_;
   std::condition_variable cond_;
-  std::vector<std::unique_ptr<Session>> sessions_;  // GUARDED_BY(mu_)
-  int total_sessions_ = 0;                          // GUARDED_BY(mu_)
-  int create_calls_in_progress_ = 0;                // GUARDED_BY(mu_)
-  int num_waiting_for_session_ = 0;                 // GUARDED_BY(mu_)
+  int total_sessions_ = 0;            // GUARDED_BY(mu_)
+  int create_calls_in_progress_ = 0;  // GUARDED_BY(mu_)
+
+  // The sharded free-list; `shards_` is never resized after the constructor
+  // runs. `available_sessions_` counts the sessions across all shards so
+  // `TryAcquireSession()` can fail fast without touching any locks, and
+  // `num_waiting_for_session_` lets `Release()` skip the notification
+  // machinery in the common, uncontended case.
+  std::vector<std::unique_ptr<SessionShard>> shards_;
+  std::atomic<int> available_sessions_{0};
+  std::atomic<int> num_waiting_for_session_{0};
+
+  // Pool-health counters, cumulative over the life of the pool.
+  std::atomic<std::int64_t> sessions_refreshed_{0};
+  std::atomic<std::int64_t> refresh_failures_{0};
 
-  // Lower bound on all `sessions_[i]->last_use_time()` values.
+  // Activity counters, cumulative over the life of the pool, see `Snapshot()`.
+  std::atomic<std::int64_t> sessions_allocated_{0};
+  std::atomic<std::int64_t> allocation_waits_{0};
+  std::atomic<std::int64_t> total_wait_ms_{0};
+  std::atomic<std::int64_t> exhausted_failures_{0};
+  std::atomic<std::int64_t> create_rpcs_{0};
+  std::atomic<std::int64_t> refresh_rpcs_{0};
+  std::atomic<std::int64_t> wait_duration_histogram_[kWaitDurationBuckets] = {};
+
+  // Lower bound on all the free sessions' `last_use_time()` values.
   Session::Clock::time_point last_use_time_lower_bound_ =
       clock_->Now();  // GUARDED_BY(mu_)
 
   future<void> current_timer_;
 
+  // Satisfied when the `Initialize()` warmup completes, see
+  // `WarmupCompleted()`. Only valid when `min_sessions() > 0`.
+  future<Status> warmup_done_;
+
   // `channels_` is guaranteed to be non-empty and will not be resized after
   // the constructor runs (so the iterators are guaranteed to always be valid).
   // TODO(#566) replace `vector` with `absl::FixedArray` when available.
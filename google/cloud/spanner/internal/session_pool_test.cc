@@ -26,6 +26,7 @@
 #include <google/protobuf/text_format.h>
 #include <gmock/gmock.h>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
@@ -248,6 +249,70 @@ TEST(SessionPool, MinSessionsMultipleAllocations) {
               UnorderedElementsAre("s1", "s2", "s3", "s4", "s5", "s6", "s7"));
 }
 
+TEST(SessionPool, WarmupCreatesSessionsInParallel) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  // Each call signals that it started and then waits for the other, so the
+  // test only passes when the warmup calls overlap in time.
+  std::promise<void> started1;
+  std::promise<void> started2;
+  auto done1 = started1.get_future();
+  auto done2 = started2.get_future();
+  EXPECT_CALL(*mock1, BatchCreateSessions(_, SessionCountIs(2)))
+      .WillOnce([&](grpc::ClientContext&,
+                    spanner_proto::BatchCreateSessionsRequest const&) {
+        started1.set_value();
+        EXPECT_EQ(std::future_status::ready,
+                  done2.wait_for(std::chrono::seconds(60)));
+        return MakeSessionsResponse({"c1s1", "c1s2"});
+      });
+  EXPECT_CALL(*mock2, BatchCreateSessions(_, SessionCountIs(2)))
+      .WillOnce([&](grpc::ClientContext&,
+                    spanner_proto::BatchCreateSessionsRequest const&) {
+        started2.set_value();
+        EXPECT_EQ(std::future_status::ready,
+                  done1.wait_for(std::chrono::seconds(60)));
+        return MakeSessionsResponse({"c2s1", "c2s2"});
+      });
+
+  SessionPoolOptions options;
+  options.set_min_sessions(4);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock1, mock2}, options, threads.cq());
+  EXPECT_STATUS_OK(pool->WarmupCompleted().get());
+
+  std::vector<SessionHolder> sessions;
+  std::vector<std::string> session_names;
+  for (int i = 0; i != 4; ++i) {
+    auto session = pool->Allocate();
+    ASSERT_STATUS_OK(session);
+    session_names.push_back((*session)->session_name());
+    sessions.push_back(*std::move(session));
+  }
+  EXPECT_THAT(session_names,
+              UnorderedElementsAre("c1s1", "c1s2", "c2s1", "c2s2"));
+}
+
+TEST(SessionPool, WarmupReportsFailures) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce([](grpc::ClientContext&,
+                   spanner_proto::BatchCreateSessionsRequest const&) {
+        return StatusOr<spanner_proto::BatchCreateSessionsResponse>(
+            Status(StatusCode::kPermissionDenied, "uh-oh"));
+      });
+
+  SessionPoolOptions options;
+  options.set_min_sessions(1);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock}, options, threads.cq());
+  auto status = pool->WarmupCompleted().get();
+  EXPECT_EQ(StatusCode::kPermissionDenied, status.code());
+  EXPECT_THAT(status.message(), HasSubstr("uh-oh"));
+}
+
 TEST(SessionPool, MaxSessionsFailOnExhaustion) {
   int const max_sessions_per_channel = 3;
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
@@ -303,6 +368,112 @@ TEST(SessionPool, MaxSessionsBlockUntilRelease) {
   t.join();
 }
 
+TEST(SessionPool, CountersTrackAllocations) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))));
+
+  SessionPoolOptions options;
+  options.set_max_sessions_per_channel(1).set_action_on_exhaustion(
+      ActionOnExhaustion::kFail);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock}, options, threads.cq());
+
+  auto counters = pool->Snapshot();
+  EXPECT_EQ(0, counters.sessions_allocated);
+  EXPECT_EQ(0, counters.exhausted_failures);
+
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+  auto exhausted = pool->Allocate();
+  EXPECT_EQ(exhausted.status().code(), StatusCode::kResourceExhausted);
+
+  counters = pool->Snapshot();
+  EXPECT_EQ(1, counters.sessions_allocated);
+  EXPECT_EQ(1, counters.exhausted_failures);
+  EXPECT_EQ(1, counters.create_rpcs);
+  std::int64_t histogram_total = 0;
+  for (auto count : counters.wait_duration_histogram) {
+    histogram_total += count;
+  }
+  EXPECT_EQ(counters.allocation_waits, histogram_total);
+}
+
+TEST(SessionPool, CountersTrackWaits) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"s1"}))));
+
+  SessionPoolOptions options;
+  options.set_max_sessions_per_channel(1).set_action_on_exhaustion(
+      ActionOnExhaustion::kBlock);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock}, options, threads.cq());
+  auto session = pool->Allocate();
+  ASSERT_STATUS_OK(session);
+
+  // This thread will block in Allocate() until the main thread releases s1.
+  std::thread t([&pool]() {
+    auto session = pool->Allocate();
+    ASSERT_STATUS_OK(session);
+  });
+  // Release the session only after the other thread is counted as waiting,
+  // so the wait counters are guaranteed to tick.
+  while (pool->Snapshot().allocation_waits == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  session->reset();
+  t.join();
+
+  auto counters = pool->Snapshot();
+  EXPECT_EQ(2, counters.sessions_allocated);
+  EXPECT_LE(1, counters.allocation_waits);
+  std::int64_t histogram_total = 0;
+  for (auto count : counters.wait_duration_histogram) {
+    histogram_total += count;
+  }
+  EXPECT_EQ(counters.allocation_waits, histogram_total);
+}
+
+TEST(SessionPool, ConcurrentAllocateRelease) {
+  auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  int session_counter = 0;
+  EXPECT_CALL(*mock, BatchCreateSessions(_, _))
+      .WillRepeatedly(
+          [&session_counter](
+              grpc::ClientContext&,
+              spanner_proto::BatchCreateSessionsRequest const& request) {
+            std::vector<std::string> sessions;
+            for (int i = 0; i != request.session_count(); ++i) {
+              sessions.push_back("session" + std::to_string(++session_counter));
+            }
+            return MakeSessionsResponse(std::move(sessions));
+          });
+
+  SessionPoolOptions options;
+  options.set_max_sessions_per_channel(100).set_action_on_exhaustion(
+      ActionOnExhaustion::kBlock);
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock}, options, threads.cq());
+
+  // Repeatedly check sessions in and out from many threads; the sharded
+  // free-list must never lose or duplicate a live session.
+  std::vector<std::thread> tasks;
+  for (int t = 0; t != 8; ++t) {
+    tasks.emplace_back([&pool] {
+      for (int i = 0; i != 100; ++i) {
+        auto session = pool->Allocate();
+        ASSERT_STATUS_OK(session);
+        EXPECT_FALSE((*session)->session_name().empty());
+      }
+    });
+  }
+  for (auto& task : tasks) task.join();
+}
+
 TEST(SessionPool, Labels) {
   auto mock = std::make_shared<spanner_testing::MockSpannerStub>();
   auto db = Database("project", "instance", "database");
@@ -393,6 +564,55 @@ TEST(SessionPool, GetStubForStublessSession) {
   EXPECT_EQ(pool->GetStub(*session), mock);
 }
 
+TEST(SessionPool, StreamStubRoutesToLeastLoadedChannel) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock1, mock2}, {}, threads.cq());
+  auto session = MakeDissociatedSessionHolder("session_id");
+
+  auto lease1 = pool->GetStreamStub(*session);
+  EXPECT_EQ(lease1.stub(), mock1);
+  auto lease2 = pool->GetStreamStub(*session);
+  EXPECT_EQ(lease2.stub(), mock2);
+  {
+    auto lease3 = pool->GetStreamStub(*session);
+    EXPECT_EQ(lease3.stub(), mock1);
+  }
+  // `lease3` finished, so its channel is the less loaded one again; were it
+  // still in flight this stream would be routed to `mock2`.
+  auto lease4 = pool->GetStreamStub(*session);
+  EXPECT_EQ(lease4.stub(), mock1);
+}
+
+TEST(SessionPool, StreamStubPrefersSessionChannelOnTie) {
+  auto mock1 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto mock2 = std::make_shared<spanner_testing::MockSpannerStub>();
+  auto db = Database("project", "instance", "database");
+  EXPECT_CALL(*mock1, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c1s1"}))));
+  EXPECT_CALL(*mock2, BatchCreateSessions(_, _))
+      .WillOnce(Return(ByMove(MakeSessionsResponse({"c2s1"}))));
+
+  google::cloud::internal::AutomaticallyCreatedBackgroundThreads threads;
+  auto pool = MakeSessionPool(db, {mock1, mock2}, {}, threads.cq());
+  // Allocate both sessions and pick the one on `mock2`'s channel.
+  auto s1 = pool->Allocate();
+  ASSERT_STATUS_OK(s1);
+  auto s2 = pool->Allocate();
+  ASSERT_STATUS_OK(s2);
+  auto& session = (*s1)->session_name() == "c2s1" ? *s1 : *s2;
+  ASSERT_EQ("c2s1", session->session_name());
+
+  // With all channels idle the session's own channel wins the tie.
+  auto lease1 = pool->GetStreamStub(*session);
+  EXPECT_EQ(lease1.stub(), mock2);
+  // With a stream in flight on `mock2` the other channel is less loaded.
+  auto lease2 = pool->GetStreamStub(*session);
+  EXPECT_EQ(lease2.stub(), mock1);
+}
+
 TEST(SessionPool, SessionRefresh) {
   auto mock = std::make_shared<StrictMock<spanner_testing::MockSpannerStub>>();
   EXPECT_CALL(*mock, BatchCreateSessions(_, _))
@@ -458,6 +678,12 @@ TEST(SessionPool, SessionRefresh) {
   // call, which should do nothing.  If anything goes wrong with this
   // process, we'll get unsatisfied/uninteresting gmock errors.
   impl->SimulateCompletion(true);
+
+  auto health = pool->GetPoolHealth();
+  EXPECT_EQ(2, health.total_sessions);
+  EXPECT_EQ(2, health.available_sessions);
+  EXPECT_EQ(1, health.sessions_refreshed);
+  EXPECT_EQ(0, health.refresh_failures);
 }
 
 }  // namespace
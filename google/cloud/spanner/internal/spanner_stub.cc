@@ -77,6 +77,11 @@ class DefaultSpannerStub : public SpannerStub {
   std::unique_ptr<grpc::ClientReaderInterface<spanner_proto::PartialResultSet>>
   ExecuteStreamingSql(grpc::ClientContext& client_context,
                       spanner_proto::ExecuteSqlRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncReaderInterface<spanner_proto::PartialResultSet>>
+  AsyncExecuteStreamingSql(grpc::ClientContext& client_context,
+                           spanner_proto::ExecuteSqlRequest const& request,
+                           grpc::CompletionQueue* cq) override;
   StatusOr<spanner_proto::ExecuteBatchDmlResponse> ExecuteBatchDml(
       grpc::ClientContext& client_context,
       spanner_proto::ExecuteBatchDmlRequest const& request) override;
@@ -89,6 +94,11 @@ class DefaultSpannerStub : public SpannerStub {
   StatusOr<spanner_proto::CommitResponse> Commit(
       grpc::ClientContext& client_context,
       spanner_proto::CommitRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+  AsyncCommit(grpc::ClientContext& client_context,
+              spanner_proto::CommitRequest const& request,
+              grpc::CompletionQueue* cq) override;
   Status Rollback(grpc::ClientContext& client_context,
                   spanner_proto::RollbackRequest const& request) override;
   StatusOr<spanner_proto::PartitionResponse> PartitionQuery(
@@ -206,6 +216,16 @@ DefaultSpannerStub::ExecuteStreamingSql(
   return grpc_stub_->ExecuteStreamingSql(&client_context, request);
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncReaderInterface<spanner_proto::PartialResultSet>>
+DefaultSpannerStub::AsyncExecuteStreamingSql(
+    grpc::ClientContext& client_context,
+    spanner_proto::ExecuteSqlRequest const& request,
+    grpc::CompletionQueue* cq) {
+  return grpc_stub_->PrepareAsyncExecuteStreamingSql(&client_context, request,
+                                                     cq);
+}
+
 StatusOr<spanner_proto::ExecuteBatchDmlResponse>
 DefaultSpannerStub::ExecuteBatchDml(
     grpc::ClientContext& client_context,
@@ -249,6 +269,14 @@ StatusOr<spanner_proto::CommitResponse> DefaultSpannerStub::Commit(
   return response;
 }
 
+std::unique_ptr<
+    grpc::ClientAsyncResponseReaderInterface<spanner_proto::CommitResponse>>
+DefaultSpannerStub::AsyncCommit(grpc::ClientContext& client_context,
+                                spanner_proto::CommitRequest const& request,
+                                grpc::CompletionQueue* cq) {
+  return grpc_stub_->AsyncCommit(&client_context, request, cq);
+}
+
 Status DefaultSpannerStub::Rollback(
     grpc::ClientContext& client_context,
     spanner_proto::RollbackRequest const& request) {
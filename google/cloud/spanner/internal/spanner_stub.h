@@ -89,6 +89,12 @@ class SpannerStub {
   ExecuteStreamingSql(
       grpc::ClientContext& client_context,
       google::spanner::v1::ExecuteSqlRequest const& request) = 0;
+  virtual std::unique_ptr<
+      grpc::ClientAsyncReaderInterface<google::spanner::v1::PartialResultSet>>
+  AsyncExecuteStreamingSql(
+      grpc::ClientContext& client_context,
+      google::spanner::v1::ExecuteSqlRequest const& request,
+      grpc::CompletionQueue* cq) = 0;
   virtual StatusOr<google::spanner::v1::ExecuteBatchDmlResponse>
   ExecuteBatchDml(
       grpc::ClientContext& client_context,
@@ -103,6 +109,11 @@ class SpannerStub {
   virtual StatusOr<google::spanner::v1::CommitResponse> Commit(
       grpc::ClientContext& client_context,
       google::spanner::v1::CommitRequest const& request) = 0;
+  virtual std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+      google::spanner::v1::CommitResponse>>
+  AsyncCommit(grpc::ClientContext& client_context,
+              google::spanner::v1::CommitRequest const& request,
+              grpc::CompletionQueue* cq) = 0;
   virtual Status Rollback(
       grpc::ClientContext& client_context,
       google::spanner::v1::RollbackRequest const& request) = 0;
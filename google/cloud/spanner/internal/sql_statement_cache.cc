@@ -0,0 +1,91 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/sql_statement_cache.h"
+#include "google/cloud/spanner/value.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+spanner_proto::ExecuteSqlRequest SqlStatementCache::MakeRequest(
+    SqlStatement statement) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto it = cache_.find(statement.sql());
+  if (it != cache_.end() && SkeletonMatches(it->second->request, statement)) {
+    auto const& entry = it->second;
+    // Overwrite just the parameter values that changed since the last call;
+    // unchanged values reuse the bytes already encoded in the cached request.
+    auto& fields = *entry->request.mutable_params()->mutable_fields();
+    for (auto& param : ExtractParams(std::move(statement))) {
+      auto cached = entry->params.find(param.first);
+      if (cached->second == param.second) continue;
+      fields[param.first] = ToProto(param.second).second;
+      cached->second = std::move(param.second);
+    }
+    return entry->request;
+  }
+  lk.unlock();
+
+  auto entry = std::make_shared<Entry>();
+  entry->params = statement.params();
+  auto statement_proto = ToProto(std::move(statement));
+  entry->request.set_sql(std::move(*statement_proto.mutable_sql()));
+  *entry->request.mutable_params() =
+      std::move(*statement_proto.mutable_params());
+  *entry->request.mutable_param_types() =
+      std::move(*statement_proto.mutable_param_types());
+
+  lk.lock();
+  if (cache_.size() >= max_size_ &&
+      cache_.count(entry->request.sql()) == 0) {
+    // Workloads typically run far fewer distinct statements than `max_size_`;
+    // if the cache ever fills, discard it wholesale rather than tracking
+    // per-entry usage for a finer eviction policy.
+    cache_.clear();
+  }
+  cache_[entry->request.sql()] = entry;
+  // Copy while holding the lock; another thread could mutate the entry's
+  // parameter values as soon as it is released.
+  return entry->request;
+}
+
+bool SqlStatementCache::SkeletonMatches(
+    spanner_proto::ExecuteSqlRequest const& skeleton,
+    SqlStatement const& statement) {
+  auto const& types = skeleton.param_types();
+  auto const& params = statement.params();
+  if (static_cast<std::size_t>(types.size()) != params.size()) return false;
+  for (auto const& param : params) {
+    auto it = types.find(param.first);
+    if (it == types.end()) return false;
+    if (!google::protobuf::util::MessageDifferencer::Equals(
+            it->second, ValueInternals::GetType(param.second))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
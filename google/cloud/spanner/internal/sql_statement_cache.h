@@ -0,0 +1,88 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_SQL_STATEMENT_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_SQL_STATEMENT_CACHE_H
+
+#include "google/cloud/spanner/sql_statement.h"
+#include "google/cloud/spanner/version.h"
+#include <google/spanner/v1/spanner.pb.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+
+/**
+ * Caches `ExecuteSqlRequest` skeletons for repeatedly executed statements.
+ *
+ * Assembling an `ExecuteSqlRequest` from a `SqlStatement` rebuilds the `sql`
+ * field and the `param_types` map on every call. Workloads often execute a
+ * small set of distinct statements many times, varying only the parameter
+ * values, so this class caches a request skeleton (the `sql` and
+ * `param_types` fields) per distinct SQL text, and assembles subsequent
+ * requests by copying the skeleton and splicing in just the parameter values.
+ *
+ * The cached request also retains the parameter values from the previous
+ * call. Prepared-statement-style workloads usually change only a few scalar
+ * parameters between calls, so `MakeRequest()` compares the new values
+ * against the cached ones and only re-encodes the values that changed; the
+ * rest reuse the bytes already encoded in the cached request.
+ *
+ * A cached skeleton is only used when the parameters of the new statement
+ * have the same names and types; otherwise the skeleton is rebuilt, so the
+ * resulting request is always identical to one built from scratch.
+ */
+class SqlStatementCache {
+ public:
+  explicit SqlStatementCache(std::size_t max_size = 128)
+      : max_size_(max_size) {}
+
+  /**
+   * Returns a request with the `sql`, `params`, and `param_types` fields
+   * filled in from @p statement. Callers set the per-call fields (session,
+   * transaction, seqno, etc.) on the returned request.
+   */
+  google::spanner::v1::ExecuteSqlRequest MakeRequest(SqlStatement statement);
+
+ private:
+  // A cached request and the parameter values currently encoded in it.
+  struct Entry {
+    google::spanner::v1::ExecuteSqlRequest request;
+    SqlStatement::ParamType params;
+  };
+
+  static bool SkeletonMatches(
+      google::spanner::v1::ExecuteSqlRequest const& skeleton,
+      SqlStatement const& statement);
+
+  std::size_t const max_size_;
+  std::mutex mu_;
+  std::unordered_map<std::string, std::shared_ptr<Entry>>
+      cache_;  // GUARDED_BY(mu_)
+};
+
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_INTERNAL_SQL_STATEMENT_CACHE_H
@@ -0,0 +1,120 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/internal/sql_statement_cache.h"
+#include "google/cloud/testing_util/is_proto_equal.h"
+#include <gmock/gmock.h>
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::testing_util::IsProtoEqual;
+
+namespace spanner_proto = ::google::spanner::v1;
+
+// Builds the request the same way `ExecuteSqlImpl` did before the cache
+// existed; `MakeRequest()` must always produce an identical proto.
+spanner_proto::ExecuteSqlRequest MakeExpectedRequest(SqlStatement statement) {
+  spanner_proto::ExecuteSqlRequest request;
+  auto sql_statement = ToProto(std::move(statement));
+  request.set_sql(std::move(*sql_statement.mutable_sql()));
+  *request.mutable_params() = std::move(*sql_statement.mutable_params());
+  *request.mutable_param_types() =
+      std::move(*sql_statement.mutable_param_types());
+  return request;
+}
+
+TEST(SqlStatementCacheTest, NoParameters) {
+  SqlStatementCache cache;
+  SqlStatement statement("SELECT 1");
+  auto request = cache.MakeRequest(statement);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(statement)));
+  // A second request, through the cached skeleton, is identical.
+  request = cache.MakeRequest(statement);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(statement)));
+}
+
+TEST(SqlStatementCacheTest, SplicesParameterValues) {
+  SqlStatementCache cache;
+  for (std::int64_t id : {1, 2, 3}) {
+    SqlStatement statement("SELECT * FROM Singers WHERE SingerId = @id",
+                           {{"id", Value(id)}});
+    auto request = cache.MakeRequest(statement);
+    EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(statement)));
+  }
+}
+
+TEST(SqlStatementCacheTest, ReusesUnchangedParameterValues) {
+  SqlStatementCache cache;
+  std::string sql =
+      "SELECT * FROM Singers WHERE SingerId = @id AND LastName = @name";
+  // Repeating a value exercises the path that keeps the cached encoding,
+  // changing one exercises the partial overwrite.
+  for (auto const* name : {"fname-1", "fname-1", "fname-2"}) {
+    SqlStatement statement(sql, {{"id", Value(42)}, {"name", Value(name)}});
+    auto request = cache.MakeRequest(statement);
+    EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(statement)));
+  }
+}
+
+TEST(SqlStatementCacheTest, RebuildsOnParameterTypeChange) {
+  SqlStatementCache cache;
+  std::string sql = "SELECT * FROM Singers WHERE SingerId = @id";
+  SqlStatement with_int(sql, {{"id", Value(42)}});
+  SqlStatement with_string(sql, {{"id", Value("42")}});
+
+  auto request = cache.MakeRequest(with_int);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(with_int)));
+  request = cache.MakeRequest(with_string);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(with_string)));
+  request = cache.MakeRequest(with_int);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(with_int)));
+}
+
+TEST(SqlStatementCacheTest, RebuildsOnParameterNameChange) {
+  SqlStatementCache cache;
+  std::string sql = "SELECT * FROM Singers WHERE SingerId = @id";
+  SqlStatement with_id(sql, {{"id", Value(42)}});
+  SqlStatement with_other(sql, {{"other", Value(42)}});
+
+  auto request = cache.MakeRequest(with_id);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(with_id)));
+  request = cache.MakeRequest(with_other);
+  EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(with_other)));
+}
+
+TEST(SqlStatementCacheTest, CorrectAfterEviction) {
+  SqlStatementCache cache(/*max_size=*/1);
+  SqlStatement first("SELECT 1");
+  SqlStatement second("SELECT 2");
+  for (int i = 0; i != 2; ++i) {
+    auto request = cache.MakeRequest(first);
+    EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(first)));
+    request = cache.MakeRequest(second);
+    EXPECT_THAT(request, IsProtoEqual(MakeExpectedRequest(second)));
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
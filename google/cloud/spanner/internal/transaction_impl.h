@@ -21,6 +21,7 @@
 #include "google/cloud/internal/port_platform.h"
 #include "google/cloud/status_or.h"
 #include <google/spanner/v1/transaction.pb.h>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
@@ -74,7 +75,9 @@ class TransactionImpl {
   //
   // If the TransactionSelector is not in the "begin" state then the functor
   // must not modify it. Rather it should use either the transaction ID or
-  // the error state in a manner appropriate for the operation.
+  // the error state in a manner appropriate for the operation. Because the
+  // session and selector are then immutable, such visitors may run
+  // concurrently with one another.
   //
   // A monotonically-increasing sequence number is also passed to the functor.
   template <typename Functor>
@@ -84,16 +87,26 @@ class TransactionImpl {
                       StatusOr<google::spanner::v1::TransactionSelector>&,
                       std::int64_t>::value,
                   "TransactionImpl::Visit() functor has incompatible type.");
+    // Once a transaction ID has been assigned (or the transaction is
+    // single-use) the session and selector never change again, so visitors
+    // need not serialize on the mutex. `State::kDone` is terminal, and the
+    // release store that published it makes the final `session_` and
+    // `selector_` values visible to this acquire load.
+    if (state_.load(std::memory_order_acquire) == State::kDone) {
+      return f(session_, selector_, ++seqno_);
+    }
     std::int64_t seqno;
     {
       std::unique_lock<std::mutex> lock(mu_);
       seqno = ++seqno_;  // what about overflow?
-      cond_.wait(lock, [this] { return state_ != State::kPending; });
-      if (state_ == State::kDone) {
+      cond_.wait(lock, [this] {
+        return state_.load(std::memory_order_relaxed) != State::kPending;
+      });
+      if (state_.load(std::memory_order_relaxed) == State::kDone) {
         lock.unlock();
         return f(session_, selector_, seqno);
       }
-      state_ = State::kPending;
+      state_.store(State::kPending, std::memory_order_relaxed);
     }
     // selector_->has_begin(), but only one visitor active at a time.
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
@@ -103,9 +116,11 @@ class TransactionImpl {
       bool done = false;
       {
         std::lock_guard<std::mutex> lock(mu_);
-        state_ =
-            selector_ && selector_->has_begin() ? State::kBegin : State::kDone;
-        done = (state_ == State::kDone);
+        done = !(selector_ && selector_->has_begin());
+        // The release store publishes the functor's writes to `session_` and
+        // `selector_` to the lock-free fast path above.
+        state_.store(done ? State::kDone : State::kBegin,
+                     std::memory_order_release);
       }
       if (done) {
         cond_.notify_all();
@@ -117,7 +132,7 @@ class TransactionImpl {
     } catch (...) {
       {
         std::lock_guard<std::mutex> lock(mu_);
-        state_ = State::kBegin;
+        state_.store(State::kBegin, std::memory_order_relaxed);
       }
       cond_.notify_one();
       throw;
@@ -131,13 +146,16 @@ class TransactionImpl {
     kPending,  // waiting for an active visitor to assign a transaction ID
     kDone,     // a transaction ID has been assigned (or we are single-use)
   };
-  State state_;
+  // `kDone` is terminal; it is published with a release store so that the
+  // lock-free fast path in `Visit()` can read `session_` and `selector_`
+  // without holding `mu_`.
+  std::atomic<State> state_;
 
   std::mutex mu_;
   std::condition_variable cond_;
   SessionHolder session_;
   StatusOr<google::spanner::v1::TransactionSelector> selector_;
-  std::int64_t seqno_;
+  std::atomic<std::int64_t> seqno_;
 };
 
 }  // namespace internal
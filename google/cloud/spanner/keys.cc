@@ -16,6 +16,7 @@
 #include "google/cloud/spanner/value.h"
 #include <google/protobuf/util/message_differencer.h>
 #include <google/spanner/v1/keys.pb.h>
+#include <unordered_set>
 
 namespace google {
 namespace cloud {
@@ -23,18 +24,43 @@ namespace spanner {
 inline namespace SPANNER_CLIENT_NS {
 
 namespace {
-// Appends the values in the given `key` to the `lv` proto.
+// Appends the values in the given `key` to the `lv` proto. A `KeySet` carries
+// only the key values; the server derives their types from the index.
 void AppendKey(google::protobuf::ListValue& lv, Key&& key) {
+  lv.mutable_values()->Reserve(static_cast<int>(key.size()));
   for (auto& v : key) {
-    *lv.add_values() = internal::ToProto(std::move(v)).second;
+    *lv.add_values() = internal::ValueInternals::ToValueProto(std::move(v));
   }
 }
+
+// Removes elements that are byte-for-byte duplicates of an earlier element,
+// preserving the order of the survivors.
+template <typename Message>
+void RemoveExactDuplicates(google::protobuf::RepeatedPtrField<Message>& field) {
+  std::unordered_set<std::string> seen;
+  int keep = 0;
+  for (int i = 0; i != field.size(); ++i) {
+    if (seen.insert(field.Get(i).SerializeAsString()).second) {
+      if (keep != i) field.SwapElements(keep, i);
+      ++keep;
+    }
+  }
+  field.DeleteSubrange(keep, field.size() - keep);
+}
 }  // namespace
 
 namespace internal {
 
 ::google::spanner::v1::KeySet ToProto(KeySet ks) {
-  return std::move(ks.proto_);
+  auto proto = std::move(ks.proto_);
+  // A `KeySet` is a set, so keys and ranges that exactly duplicate an earlier
+  // entry are redundant; drop them rather than send them to the server. Note
+  // that coalescing *overlapping* ranges is not possible here: the protos
+  // carry the key values but not their types, and range overlap depends on
+  // the index's ordering semantics.
+  if (proto.keys_size() > 1) RemoveExactDuplicates(*proto.mutable_keys());
+  if (proto.ranges_size() > 1) RemoveExactDuplicates(*proto.mutable_ranges());
+  return proto;
 }
 
 KeySet FromProto(::google::spanner::v1::KeySet proto) {
@@ -53,6 +79,11 @@ KeySet& KeySet::AddKey(Key key) {
   return *this;
 }
 
+void KeySet::ReserveAdditionalKeys(std::size_t n) {
+  if (proto_.all()) return;
+  proto_.mutable_keys()->Reserve(proto_.keys_size() + static_cast<int>(n));
+}
+
 KeySet& KeySet::AddRange(KeyBound start, KeyBound end) {
   if (proto_.all()) return *this;
   auto* range = proto_.add_ranges();
@@ -18,7 +18,10 @@
 #include "google/cloud/spanner/value.h"
 #include "google/cloud/spanner/version.h"
 #include <google/spanner/v1/keys.pb.h>
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -186,6 +189,24 @@ class KeySet {
    */
   KeySet& AddKey(Key key);
 
+  /**
+   * Adds all the keys in the range [@p first, @p last) to the `KeySet`.
+   *
+   * This is more efficient than repeated `AddKey()` calls for large batches
+   * of keys: when the size of the range can be computed cheaply the storage
+   * for all the keys is reserved up front.
+   */
+  template <typename InputIt>
+  KeySet& AddKeys(InputIt first, InputIt last) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if (std::is_base_of<std::forward_iterator_tag, Category>::value) {
+      ReserveAdditionalKeys(
+          static_cast<std::size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) AddKey(*first);
+    return *this;
+  }
+
   /**
    * Adds a range of keys defined by the given `KeyBound`s.
    *
@@ -206,6 +227,9 @@ class KeySet {
   explicit KeySet(google::spanner::v1::KeySet proto)
       : proto_(std::move(proto)) {}
 
+  // Reserves storage for `n` keys beyond those already in the set.
+  void ReserveAdditionalKeys(std::size_t n);
+
   google::spanner::v1::KeySet proto_;
 };
 
@@ -214,6 +214,49 @@ TEST(KeySetTest, RoundTripProtos) {
   }
 }
 
+TEST(KeySetTest, AddKeysBulk) {
+  std::vector<Key> keys;
+  KeySet expected;
+  for (int i = 0; i != 100; ++i) {
+    keys.push_back(MakeKey(i, "key-" + std::to_string(i)));
+    expected.AddKey(keys.back());
+  }
+
+  KeySet actual;
+  actual.AddKeys(keys.begin(), keys.end());
+  EXPECT_EQ(expected, actual);
+
+  // Adding keys to an "All" `KeySet` remains a no-op.
+  auto all = KeySet::All();
+  all.AddKeys(keys.begin(), keys.end());
+  EXPECT_EQ(KeySet::All(), all);
+}
+
+TEST(KeySetTest, ToProtoRemovesDuplicateKeys) {
+  auto ks = KeySet()
+                .AddKey(MakeKey(42))
+                .AddKey(MakeKey(123))
+                .AddKey(MakeKey(42))
+                .AddKey(MakeKey(7));
+  auto proto = internal::ToProto(ks);
+  auto expected = internal::ToProto(
+      KeySet().AddKey(MakeKey(42)).AddKey(MakeKey(123)).AddKey(MakeKey(7)));
+  EXPECT_THAT(proto, IsProtoEqual(expected));
+}
+
+TEST(KeySetTest, ToProtoRemovesDuplicateRanges) {
+  auto ks = KeySet()
+                .AddRange(MakeKeyBoundClosed(1), MakeKeyBoundOpen(10))
+                .AddRange(MakeKeyBoundClosed(20), MakeKeyBoundOpen(30))
+                .AddRange(MakeKeyBoundClosed(1), MakeKeyBoundOpen(10));
+  auto proto = internal::ToProto(ks);
+  auto expected = internal::ToProto(
+      KeySet()
+          .AddRange(MakeKeyBoundClosed(1), MakeKeyBoundOpen(10))
+          .AddRange(MakeKeyBoundClosed(20), MakeKeyBoundOpen(30)));
+  EXPECT_THAT(proto, IsProtoEqual(expected));
+}
+
 }  // namespace
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
@@ -56,6 +56,8 @@ class MockConnection : public spanner::Connection {
   MOCK_METHOD1(ExecuteBatchDml,
                StatusOr<spanner::BatchDmlResult>(ExecuteBatchDmlParams));
   MOCK_METHOD1(Commit, StatusOr<spanner::CommitResult>(CommitParams));
+  MOCK_METHOD1(AsyncCommit,
+               future<StatusOr<spanner::CommitResult>>(CommitParams));
   MOCK_METHOD1(Rollback, Status(RollbackParams));
 };
 
@@ -19,6 +19,7 @@
 #include "google/cloud/spanner/value.h"
 #include "google/cloud/spanner/version.h"
 #include <google/spanner/v1/mutation.pb.h>
+#include <iterator>
 #include <vector>
 
 namespace google {
@@ -117,8 +118,9 @@ class WriteMutationBuilder {
 
   WriteMutationBuilder& AddRow(std::vector<Value> values) & {
     auto& lv = *Op::mutable_field(m_.proto()).add_values();
+    lv.mutable_values()->Reserve(static_cast<int>(values.size()));
     for (auto& v : values) {
-      std::tie(std::ignore, *lv.add_values()) = internal::ToProto(std::move(v));
+      *lv.add_values() = internal::ValueInternals::ToValueProto(std::move(v));
     }
     return *this;
   }
@@ -127,9 +129,46 @@ class WriteMutationBuilder {
     return std::move(AddRow(std::move(values)));
   }
 
+  /**
+   * Add all the rows in the range [@p first, @p last) to the mutation.
+   *
+   * Each element of the range must be a container of `Value` (e.g. a
+   * `std::vector<Value>`). The repeated fields in the underlying proto are
+   * reserved up front and the values are moved out of the range, so bulk
+   * ingest can append thousands of rows without an allocation or copy per
+   * row. @p first and @p last must be forward iterators.
+   */
+  template <typename RowIterator>
+  WriteMutationBuilder& AddRows(RowIterator first, RowIterator last) & {
+    auto& field = Op::mutable_field(m_.proto());
+    field.mutable_values()->Reserve(
+        field.values_size() + static_cast<int>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      auto& row = *first;
+      auto& lv = *field.add_values();
+      lv.mutable_values()->Reserve(static_cast<int>(row.size()));
+      for (auto& v : row) {
+        *lv.add_values() =
+            internal::ValueInternals::ToValueProto(std::move(v));
+      }
+    }
+    return *this;
+  }
+
+  template <typename RowIterator>
+  WriteMutationBuilder&& AddRows(RowIterator first, RowIterator last) && {
+    return std::move(AddRows(std::move(first), std::move(last)));
+  }
+
+  // Mutations carry only cell values; the server derives the cell types from
+  // the table schema. Encoding the arguments directly avoids building (and
+  // then discarding) a `Type` proto tree for every cell.
   template <typename... Ts>
   WriteMutationBuilder& EmplaceRow(Ts&&... values) & {
-    return AddRow({Value(std::forward<Ts>(values))...});
+    auto& lv = *Op::mutable_field(m_.proto()).add_values();
+    lv.mutable_values()->Reserve(static_cast<int>(sizeof...(Ts)));
+    AddValues(lv, std::forward<Ts>(values)...);
+    return *this;
   }
 
   template <typename... Ts>
@@ -138,6 +177,15 @@ class WriteMutationBuilder {
   }
 
  private:
+  static void AddValues(google::protobuf::ListValue&) {}
+  template <typename T, typename... Ts>
+  static void AddValues(google::protobuf::ListValue& lv, T&& value,
+                        Ts&&... rest) {
+    *lv.add_values() =
+        internal::ValueInternals::ToValueProto(std::forward<T>(value));
+    AddValues(lv, std::forward<Ts>(rest)...);
+  }
+
   Mutation m_;
 };
 
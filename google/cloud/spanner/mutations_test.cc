@@ -115,6 +115,52 @@ TEST(MutationsTest, InsertComplex) {
   EXPECT_THAT(actual, IsProtoEqual(expected));
 }
 
+TEST(MutationsTest, AddRowsBulkAppend) {
+  std::vector<std::vector<Value>> rows;
+  for (int i = 0; i != 3; ++i) {
+    rows.push_back({Value(i), Value("name-" + std::to_string(i))});
+  }
+  Mutation insert = InsertMutationBuilder("table-name", {"id", "name"})
+                        .AddRows(rows.begin(), rows.end())
+                        .Build();
+
+  Mutation expected = InsertMutationBuilder("table-name", {"id", "name"})
+                          .AddRow({Value(0), Value("name-0")})
+                          .AddRow({Value(1), Value("name-1")})
+                          .AddRow({Value(2), Value("name-2")})
+                          .Build();
+  EXPECT_THAT(std::move(insert).as_proto(),
+              IsProtoEqual(std::move(expected).as_proto()));
+}
+
+TEST(MutationsTest, AddRowsAfterAddRow) {
+  std::vector<std::vector<Value>> rows;
+  rows.push_back({Value(2)});
+  rows.push_back({Value(3)});
+  Mutation update = UpdateMutationBuilder("table-name", {"id"})
+                        .AddRow({Value(1)})
+                        .AddRows(rows.begin(), rows.end())
+                        .Build();
+
+  Mutation expected = UpdateMutationBuilder("table-name", {"id"})
+                          .AddRow({Value(1)})
+                          .AddRow({Value(2)})
+                          .AddRow({Value(3)})
+                          .Build();
+  EXPECT_THAT(std::move(update).as_proto(),
+              IsProtoEqual(std::move(expected).as_proto()));
+}
+
+TEST(MutationsTest, EmplaceRowAcceptsValues) {
+  auto with_values = InsertMutationBuilder("table-name", {"col1", "col2"})
+                         .EmplaceRow(Value(42), Value("foo"))
+                         .Build();
+  auto with_literals = InsertMutationBuilder("table-name", {"col1", "col2"})
+                           .EmplaceRow(42, "foo")
+                           .Build();
+  EXPECT_EQ(with_values, with_literals);
+}
+
 TEST(MutationsTest, UpdateSimple) {
   Mutation empty;
   Mutation update =
@@ -19,6 +19,8 @@
 #include <cerrno>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <deque>
 #include <iomanip>
 #include <limits>
@@ -33,6 +35,20 @@ inline namespace SPANNER_CLIENT_NS {
 
 namespace {
 
+// Each two-character group is the decimal representation of its index,
+// used to emit two digits at a time when formatting integers.
+constexpr char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 inline bool IsDigit(char ch) {
   return std::isdigit(static_cast<unsigned char>(ch)) != 0;
 }
@@ -107,15 +123,29 @@ void Round(std::deque<char>& int_rep, std::deque<char>& frac_rep,
 namespace internal {
 
 std::string ToString(absl::int128 value) {
-  std::ostringstream ss;
-  ss << value;
-  return std::move(ss).str();
+  if (value >= 0) return ToString(static_cast<absl::uint128>(value));
+  // Negate in the unsigned domain so that the minimal value is handled.
+  return '-' + ToString(-static_cast<absl::uint128>(value));
 }
 
 std::string ToString(absl::uint128 value) {
-  std::ostringstream ss;
-  ss << value;
-  return std::move(ss).str();
+  // Enough space for the 39 digits of a maximal `absl::uint128`.
+  char buffer[40];
+  char* pos = buffer + sizeof(buffer);
+  while (value >= 100) {
+    auto const pair = static_cast<std::size_t>(value % 100) * 2;
+    value /= 100;
+    *--pos = kDigitPairs[pair + 1];
+    *--pos = kDigitPairs[pair];
+  }
+  auto const last = static_cast<std::size_t>(value);
+  if (last >= 10) {
+    *--pos = kDigitPairs[last * 2 + 1];
+    *--pos = kDigitPairs[last * 2];
+  } else {
+    *--pos = static_cast<char>('0' + last);
+  }
+  return std::string(pos, buffer + sizeof(buffer));
 }
 
 Status DataLoss(std::string message) {
@@ -242,6 +272,12 @@ StatusOr<Numeric> MakeNumeric(std::string s) {
 }
 
 StatusOr<Numeric> MakeNumeric(double d) {
+  // Fast path: integral values that a double represents exactly can be
+  // converted through the integer path, skipping iostream formatting.
+  constexpr double kMaxExact = 9007199254740992.0;  // 2^53
+  if (d >= -kMaxExact && d <= kMaxExact && std::trunc(d) == d) {
+    return MakeNumeric(static_cast<std::int64_t>(d));
+  }
   std::ostringstream ss;
   ss.imbue(std::locale::classic());
   ss << std::setprecision(std::numeric_limits<double>::digits10 + 1) << d;
@@ -250,6 +286,35 @@ StatusOr<Numeric> MakeNumeric(double d) {
   return internal::MakeNumeric(std::move(s));
 }
 
+double ToDouble(Numeric const& n) {
+  std::string const& rep = n.ToString();
+  // Fast path: when all the digits fit in the 53-bit significand of a double
+  // the integer conversion is exact, and as the scale divisor (a power of 10
+  // up to 10^kFracPrec) is also exact, a single division then produces the
+  // correctly rounded result.
+  constexpr auto kMaxExact = std::uint64_t{1} << 53;
+  constexpr double kPow10[] = {1e0, 1e1, 1e2, 1e3, 1e4,
+                               1e5, 1e6, 1e7, 1e8, 1e9};
+  std::uint64_t mantissa = 0;
+  int frac_digits = 0;
+  bool negate = false;
+  bool in_frac = false;
+  for (auto const ch : rep) {
+    if (ch == '-') {
+      negate = true;
+    } else if (ch == '.') {
+      in_frac = true;
+    } else {
+      auto const d = static_cast<std::uint64_t>(ch - '0');
+      if (mantissa > (kMaxExact - d) / 10) return std::atof(rep.c_str());
+      mantissa = mantissa * 10 + d;
+      if (in_frac) ++frac_digits;
+    }
+  }
+  double v = static_cast<double>(mantissa) / kPow10[frac_digits];
+  return negate ? -v : v;
+}
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 }  // namespace cloud
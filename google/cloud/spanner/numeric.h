@@ -19,7 +19,6 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include "absl/numeric/int128.h"
-#include <cstdlib>
 #include <cstring>
 #include <limits>
 #include <ostream>
@@ -179,9 +178,7 @@ StatusOr<Numeric> MakeNumeric(T i, int exponent = 0) {
  * Always succeeds (i.e., can never overflow, assuming a double can hold
  * values up to 10^(kIntPrec+1)).
  */
-inline double ToDouble(Numeric const& n) {
-  return std::atof(n.ToString().c_str());
-}
+double ToDouble(Numeric const& n);
 
 /**
  * Conversion to the nearest integer value, scaled by 10^`exponent`.
@@ -16,6 +16,7 @@
 #include "absl/numeric/int128.h"
 #include <gmock/gmock.h>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -372,6 +373,19 @@ TEST(Numeric, MakeNumericDoubleFail) {
               HasStatus(StatusCode::kOutOfRange, "-inf"));
 }
 
+TEST(Numeric, ToDoubleMatchesStrtod) {
+  // `ToDouble()` has a fast path for values whose digits fit in the 53-bit
+  // significand of a double, and falls back to `std::atof()` otherwise; both
+  // must produce the correctly rounded result.
+  for (auto const* s : {"0", "2", "-2", "0.5", "-19.99", "123456.789",
+                        "9007199254740992", "-9007199254740993.999999999",
+                        "0.000000001", "8999999999999999.999999999",
+                        "99999999999999999999999999999.999999999"}) {
+    auto const n = MakeNumeric(std::string(s)).value();
+    EXPECT_EQ(std::atof(s), ToDouble(n)) << s;
+  }
+}
+
 TEST(Numeric, MakeNumericInteger) {
   // Zero, signed and unsigned.
   EXPECT_EQ(0, ToInteger<int>(MakeNumeric(0).value()).value());
@@ -0,0 +1,211 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/parallel_scan.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+/**
+ * A `ResultSourceInterface` fed by worker threads, each executing partitions
+ * and pushing their rows through a bounded buffer (the backpressure).
+ *
+ * The first error any worker encounters terminates the scan: the error
+ * becomes the stream's final status and the other workers stop at their next
+ * push. Destroying the source also stops the workers and joins the threads.
+ */
+class ParallelScanSource : public internal::ResultSourceInterface {
+ public:
+  ParallelScanSource(std::size_t buffer_size,
+                     ParallelScanOptions::ProgressCallback progress,
+                     std::size_t total_partitions)
+      : buffer_size_((std::max<std::size_t>)(buffer_size, 1)),
+        progress_(std::move(progress)),
+        total_partitions_(total_partitions) {}
+
+  ~ParallelScanSource() override {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cond_push_.notify_all();
+    for (auto& thread : threads_) thread.join();
+  }
+
+  void Start(std::function<RowStream(std::size_t)> scan_partition,
+             std::size_t thread_count) {
+    active_workers_ = static_cast<int>(thread_count);
+    threads_.reserve(thread_count);
+    auto scan = std::make_shared<std::function<RowStream(std::size_t)>>(
+        std::move(scan_partition));
+    for (std::size_t i = 0; i != thread_count; ++i) {
+      threads_.emplace_back([this, scan] { Worker(*scan); });
+    }
+  }
+
+  StatusOr<Row> NextRow() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    cond_pop_.wait(lk, [this] {
+      return !final_status_.ok() || !rows_.empty() || active_workers_ == 0;
+    });
+    if (!final_status_.ok()) return final_status_;
+    if (rows_.empty()) return Row{};  // end of stream
+    auto row = std::move(rows_.front());
+    rows_.pop_front();
+    lk.unlock();
+    cond_push_.notify_one();
+    return {std::move(row)};
+  }
+
+  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return absl::nullopt;
+  }
+
+  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    return absl::nullopt;
+  }
+
+ private:
+  void Worker(std::function<RowStream(std::size_t)> const& scan_partition) {
+    for (;;) {
+      auto const index = next_partition_.fetch_add(1);
+      if (index >= total_partitions_) break;
+      auto stream = scan_partition(index);
+      bool ok = true;
+      for (auto& row : stream) {
+        if (!row) {
+          Abort(std::move(row).status());
+          ok = false;
+          break;
+        }
+        if (!PushRow(*std::move(row))) {
+          ok = false;
+          break;
+        }
+      }
+      if (!ok) break;
+      ReportProgress();
+    }
+    FinishWorker();
+  }
+
+  // Returns false if the scan was shut down instead of accepting the row.
+  bool PushRow(Row row) {
+    std::unique_lock<std::mutex> lk(mu_);
+    cond_push_.wait(
+        lk, [this] { return rows_.size() < buffer_size_ || shutdown_; });
+    if (shutdown_) return false;
+    rows_.push_back(std::move(row));
+    lk.unlock();
+    cond_pop_.notify_one();
+    return true;
+  }
+
+  void Abort(Status status) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      if (final_status_.ok()) final_status_ = std::move(status);
+      shutdown_ = true;
+    }
+    cond_push_.notify_all();
+    cond_pop_.notify_all();
+  }
+
+  void ReportProgress() {
+    // Deliberately not holding `mu_`; the callback may be arbitrarily slow.
+    auto const completed = ++completed_partitions_;
+    if (progress_) progress_(completed, total_partitions_);
+  }
+
+  void FinishWorker() {
+    bool last;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      last = --active_workers_ == 0;
+    }
+    if (last) cond_pop_.notify_all();
+  }
+
+  std::size_t const buffer_size_;
+  ParallelScanOptions::ProgressCallback const progress_;
+  std::size_t const total_partitions_;
+
+  std::atomic<std::size_t> next_partition_{0};
+  std::atomic<std::size_t> completed_partitions_{0};
+
+  std::mutex mu_;
+  std::condition_variable cond_push_;
+  std::condition_variable cond_pop_;
+  std::deque<Row> rows_;    // GUARDED_BY(mu_)
+  Status final_status_;     // GUARDED_BY(mu_)
+  bool shutdown_ = false;   // GUARDED_BY(mu_)
+  int active_workers_ = 0;  // GUARDED_BY(mu_)
+
+  std::vector<std::thread> threads_;
+};
+
+RowStream MakeParallelScan(std::function<RowStream(std::size_t)> scan_partition,
+                           std::size_t total_partitions,
+                           ParallelScanOptions const& options) {
+  auto thread_count = options.thread_count();
+  if (thread_count == 0) {
+    thread_count = std::thread::hardware_concurrency();
+    if (thread_count == 0) thread_count = 1;
+  }
+  thread_count = (std::min)(thread_count, total_partitions);
+  auto source = absl::make_unique<ParallelScanSource>(
+      options.row_buffer_size(), options.progress_callback(), total_partitions);
+  source->Start(std::move(scan_partition), thread_count);
+  return RowStream(std::move(source));
+}
+
+}  // namespace
+
+RowStream ParallelRead(Client client, std::vector<ReadPartition> partitions,
+                       ParallelScanOptions options) {
+  auto shared_partitions =
+      std::make_shared<std::vector<ReadPartition>>(std::move(partitions));
+  auto scan = [client, shared_partitions](std::size_t index) mutable {
+    return client.Read((*shared_partitions)[index]);
+  };
+  return MakeParallelScan(std::move(scan), shared_partitions->size(), options);
+}
+
+RowStream ParallelQuery(Client client, std::vector<QueryPartition> partitions,
+                        ParallelScanOptions options) {
+  auto shared_partitions =
+      std::make_shared<std::vector<QueryPartition>>(std::move(partitions));
+  auto scan = [client, shared_partitions](std::size_t index) mutable {
+    return client.ExecuteQuery((*shared_partitions)[index]);
+  };
+  return MakeParallelScan(std::move(scan), shared_partitions->size(), options);
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
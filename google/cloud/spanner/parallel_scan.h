@@ -0,0 +1,125 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARALLEL_SCAN_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARALLEL_SCAN_H
+
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/query_partition.h"
+#include "google/cloud/spanner/read_partition.h"
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/version.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Controls the execution of `ParallelRead()` and `ParallelQuery()`.
+ */
+class ParallelScanOptions {
+ public:
+  ParallelScanOptions() = default;
+
+  /**
+   * A callback reporting per-partition progress: invoked with the number of
+   * partitions completed so far and the total number of partitions.
+   *
+   * The callback is invoked from the worker threads, so it must be
+   * thread-safe, and it should not block (that would stall a worker).
+   */
+  using ProgressCallback =
+      std::function<void(std::size_t completed, std::size_t total)>;
+
+  /**
+   * The number of threads executing partitions concurrently.
+   *
+   * A value of 0 (the default) uses `std::thread::hardware_concurrency()`.
+   * The value is always clamped to the number of partitions.
+   */
+  ParallelScanOptions& set_thread_count(std::size_t count) {
+    thread_count_ = count;
+    return *this;
+  }
+  std::size_t thread_count() const { return thread_count_; }
+
+  /**
+   * The maximum number of rows buffered between the worker threads and the
+   * consumer of the merged stream.
+   *
+   * Workers that are producing rows faster than the consumer reads them
+   * block once the buffer is full (backpressure). Values less than 1 are
+   * treated as 1.
+   */
+  ParallelScanOptions& set_row_buffer_size(std::size_t size) {
+    row_buffer_size_ = size;
+    return *this;
+  }
+  std::size_t row_buffer_size() const { return row_buffer_size_; }
+
+  /// Sets the (optional) per-partition progress callback.
+  ParallelScanOptions& set_progress_callback(ProgressCallback cb) {
+    progress_callback_ = std::move(cb);
+    return *this;
+  }
+  ProgressCallback const& progress_callback() const {
+    return progress_callback_;
+  }
+
+ private:
+  std::size_t thread_count_ = 0;
+  std::size_t row_buffer_size_ = 1000;
+  ProgressCallback progress_callback_;
+};
+
+/**
+ * Reads all @p partitions concurrently, merging the rows into a single
+ * `RowStream`.
+ *
+ * The partitions, obtained from `Client::PartitionRead()`, are executed on a
+ * pool of worker threads owned by the returned stream; see
+ * `ParallelScanOptions` for the thread count, buffering/backpressure, and
+ * progress reporting knobs. The rows of each partition appear in order, but
+ * rows from different partitions are interleaved arbitrarily.
+ *
+ * If reading any partition fails the stream ends with that error and the
+ * remaining work is abandoned. Destroying the stream before reading it to
+ * the end also stops the workers.
+ *
+ * @note `RowStream::ReadTimestamp()` is not available on the merged stream;
+ *     use the `Transaction` the partitions were created with instead.
+ */
+RowStream ParallelRead(Client client, std::vector<ReadPartition> partitions,
+                       ParallelScanOptions options = ParallelScanOptions());
+
+/**
+ * Executes all @p partitions concurrently, merging the rows into a single
+ * `RowStream`.
+ *
+ * The partitions are obtained from `Client::PartitionQuery()`. See
+ * `ParallelRead()` for the execution, ordering, and error semantics.
+ */
+RowStream ParallelQuery(Client client, std::vector<QueryPartition> partitions,
+                        ParallelScanOptions options = ParallelScanOptions());
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_PARALLEL_SCAN_H
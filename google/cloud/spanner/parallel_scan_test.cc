@@ -0,0 +1,231 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/parallel_scan.h"
+#include "google/cloud/spanner/client.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+using ::google::cloud::spanner_mocks::MockConnection;
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+
+// Build a stream yielding `values`, one INT64 cell per row.
+RowStream MakeRowStream(std::vector<std::int64_t> const& values) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  auto& expectation = EXPECT_CALL(*source, NextRow());
+  for (auto v : values) {
+    expectation.WillOnce(Return(MakeTestRow({{"Id", Value(v)}})));
+  }
+  expectation.WillOnce(Return(Row()));
+  return RowStream(std::move(source));
+}
+
+RowStream MakeErrorStream(Status status) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, NextRow()).WillOnce(Return(std::move(status)));
+  return RowStream(std::move(source));
+}
+
+ReadPartition MakeTestReadPartition(std::string partition_token) {
+  return internal::MakeReadPartition("txn-id", "session-id",
+                                     std::move(partition_token), "table",
+                                     KeySet::All(), {"Id"});
+}
+
+QueryPartition MakeTestQueryPartition(std::string partition_token) {
+  return internal::MakeQueryPartition("txn-id", "session-id",
+                                      std::move(partition_token),
+                                      SqlStatement("SELECT Id FROM table"));
+}
+
+// Collect the INT64 cells of `rows`, preserving the stream order.
+StatusOr<std::vector<std::int64_t>> CollectRows(RowStream& rows) {
+  std::vector<std::int64_t> actual;
+  for (auto& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    if (!row) return std::move(row).status();
+    actual.push_back(std::get<0>(*row));
+  }
+  return actual;
+}
+
+TEST(ParallelScanTest, ParallelReadMergesAllPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillRepeatedly([](Connection::ReadParams const& params) {
+        auto token = params.partition_token.value_or("");
+        if (token == "token-0") return MakeRowStream({1, 2});
+        if (token == "token-1") return MakeRowStream({3});
+        return MakeRowStream({4, 5, 6});
+      });
+
+  std::vector<ReadPartition> partitions;
+  partitions.push_back(MakeTestReadPartition("token-0"));
+  partitions.push_back(MakeTestReadPartition("token-1"));
+  partitions.push_back(MakeTestReadPartition("token-2"));
+
+  auto rows = ParallelRead(Client(conn), std::move(partitions),
+                           ParallelScanOptions().set_thread_count(3));
+  auto actual = CollectRows(rows);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(*actual, UnorderedElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+TEST(ParallelScanTest, ParallelReadPreservesPartitionOrder) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillRepeatedly([](Connection::ReadParams const&) {
+        return MakeRowStream({1, 2, 3});
+      });
+
+  std::vector<ReadPartition> partitions;
+  partitions.push_back(MakeTestReadPartition("token-0"));
+  partitions.push_back(MakeTestReadPartition("token-1"));
+
+  // A single worker thread and a tiny buffer: the rows of each partition must
+  // still arrive in order, and backpressure must not lose or duplicate any.
+  auto rows = ParallelRead(
+      Client(conn), std::move(partitions),
+      ParallelScanOptions().set_thread_count(1).set_row_buffer_size(1));
+  auto actual = CollectRows(rows);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(*actual, ::testing::ElementsAre(1, 2, 3, 1, 2, 3));
+}
+
+TEST(ParallelScanTest, ParallelReadError) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillRepeatedly([](Connection::ReadParams const& params) {
+        if (params.partition_token.value_or("") == "token-1") {
+          return MakeErrorStream(
+              Status(StatusCode::kDeadlineExceeded, "deadline!"));
+        }
+        return MakeRowStream({1});
+      });
+
+  std::vector<ReadPartition> partitions;
+  partitions.push_back(MakeTestReadPartition("token-0"));
+  partitions.push_back(MakeTestReadPartition("token-1"));
+
+  auto rows = ParallelRead(Client(conn), std::move(partitions),
+                           ParallelScanOptions().set_thread_count(1));
+  auto actual = CollectRows(rows);
+  EXPECT_EQ(StatusCode::kDeadlineExceeded, actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("deadline!"));
+}
+
+TEST(ParallelScanTest, ParallelReadEmptyPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_)).Times(0);
+
+  auto rows = ParallelRead(Client(conn), {});
+  auto actual = CollectRows(rows);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_TRUE(actual->empty());
+}
+
+TEST(ParallelScanTest, ParallelReadProgressCallback) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillRepeatedly([](Connection::ReadParams const&) {
+        return MakeRowStream({1});
+      });
+
+  std::vector<ReadPartition> partitions;
+  for (int i = 0; i != 4; ++i) {
+    partitions.push_back(MakeTestReadPartition("token-" + std::to_string(i)));
+  }
+
+  std::mutex mu;
+  std::vector<std::size_t> completed;
+  std::vector<std::size_t> totals;
+  auto options = ParallelScanOptions().set_thread_count(2);
+  options.set_progress_callback([&](std::size_t c, std::size_t total) {
+    std::lock_guard<std::mutex> lk(mu);
+    completed.push_back(c);
+    totals.push_back(total);
+  });
+  auto rows = ParallelRead(Client(conn), std::move(partitions), options);
+  auto actual = CollectRows(rows);
+  ASSERT_STATUS_OK(actual);
+
+  std::lock_guard<std::mutex> lk(mu);
+  std::sort(completed.begin(), completed.end());
+  EXPECT_THAT(completed, ::testing::ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(totals, ::testing::Each(4));
+}
+
+TEST(ParallelScanTest, ParallelQueryMergesAllPartitions) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, ExecuteQuery(_))
+      .WillRepeatedly([](Connection::SqlParams const& params) {
+        auto token = params.partition_token.value_or("");
+        if (token == "token-0") return MakeRowStream({1, 2});
+        return MakeRowStream({3, 4});
+      });
+
+  std::vector<QueryPartition> partitions;
+  partitions.push_back(MakeTestQueryPartition("token-0"));
+  partitions.push_back(MakeTestQueryPartition("token-1"));
+
+  auto rows = ParallelQuery(Client(conn), std::move(partitions),
+                            ParallelScanOptions().set_thread_count(2));
+  auto actual = CollectRows(rows);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(*actual, UnorderedElementsAre(1, 2, 3, 4));
+}
+
+TEST(ParallelScanTest, AbandonedStreamStopsWorkers) {
+  auto conn = std::make_shared<MockConnection>();
+  EXPECT_CALL(*conn, Read(_))
+      .WillRepeatedly([](Connection::ReadParams const&) {
+        return MakeRowStream({1, 2, 3, 4, 5, 6, 7, 8});
+      });
+
+  std::vector<ReadPartition> partitions;
+  partitions.push_back(MakeTestReadPartition("token-0"));
+  partitions.push_back(MakeTestReadPartition("token-1"));
+
+  auto rows = ParallelRead(
+      Client(conn), std::move(partitions),
+      ParallelScanOptions().set_thread_count(2).set_row_buffer_size(1));
+  // Read a single row and then destroy the stream; the destructor must join
+  // the workers even though they are blocked on the (full) row buffer.
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_STATUS_OK(*it);
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
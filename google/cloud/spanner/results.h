@@ -50,6 +50,7 @@ class ResultSourceInterface {
   virtual absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() = 0;
   virtual absl::optional<google::spanner::v1::ResultSetStats> Stats() const = 0;
 };
+struct RowStreamInternals;
 }  // namespace internal
 
 /**
@@ -94,9 +95,28 @@ class RowStream {
   absl::optional<Timestamp> ReadTimestamp() const;
 
  private:
+  friend struct internal::RowStreamInternals;
   std::unique_ptr<internal::ResultSourceInterface> source_;
 };
 
+namespace internal {
+/**
+ * Provides access to a `RowStream`'s `ResultSourceInterface`, which is
+ * otherwise hidden from the public API. Used to wrap one stream in another,
+ * e.g., `MakePrefetchedRowStream()`.
+ */
+struct RowStreamInternals {
+  static std::unique_ptr<ResultSourceInterface> GetSource(RowStream stream) {
+    return std::move(stream.source_);
+  }
+  // Borrows the source without consuming the stream; may return nullptr for
+  // a default-constructed `RowStream`. Used by `NextBatch()`.
+  static ResultSourceInterface* GetSourcePointer(RowStream& stream) {
+    return stream.source_.get();
+  }
+};
+}  // namespace internal
+
 /**
  * Represents the result of a data modifying operation using
  * `spanner::Client::ExecuteDml()`.
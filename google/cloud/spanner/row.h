@@ -38,6 +38,8 @@ class Row;
 namespace internal {
 Row MakeRow(std::vector<Value>,
             std::shared_ptr<const std::vector<std::string>>);
+template <typename Tuple>
+class TupleParser;
 }  // namespace internal
 
 /**
@@ -101,10 +103,16 @@ class Row {
   std::vector<Value>&& values() && { return std::move(values_); }
 
   /// Returns the `Value` at the given @p pos.
-  StatusOr<Value> get(std::size_t pos) const;
+  StatusOr<Value> get(std::size_t pos) const&;
+
+  /// Returns the `Value` at the given @p pos, moving it out of the row.
+  StatusOr<Value> get(std::size_t pos) &&;
 
   /// Returns the `Value` in the column with @p name
-  StatusOr<Value> get(std::string const& name) const;
+  StatusOr<Value> get(std::string const& name) const&;
+
+  /// Returns the `Value` in the column with @p name, moving it out of the row.
+  StatusOr<Value> get(std::string const& name) &&;
 
   /**
    * Returns the native C++ value at the given position or column name.
@@ -113,12 +121,28 @@ class Row {
    * @tparam Arg a deduced parameter convertible to a std::size_t or std::string
    */
   template <typename T, typename Arg>
-  StatusOr<T> get(Arg&& arg) const {
+  StatusOr<T> get(Arg&& arg) const& {
     auto v = get(std::forward<Arg>(arg));
     if (v) return v->template get<T>();
     return v.status();
   }
 
+  /**
+   * Returns the native C++ value at the given position or column name.
+   *
+   * This overload moves the value out of the row, avoiding a copy of (e.g.)
+   * `std::string` or `std::vector` column data.
+   *
+   * @tparam T the native C++ type, e.g., std::int64_t or std::string
+   * @tparam Arg a deduced parameter convertible to a std::size_t or std::string
+   */
+  template <typename T, typename Arg>
+  StatusOr<T> get(Arg&& arg) && {
+    auto v = std::move(*this).get(std::forward<Arg>(arg));
+    if (v) return std::move(*v).template get<T>();
+    return v.status();
+  }
+
   /**
    * Returns all the native C++ values for the whole row in a `std::tuple` with
    * the specified type.
@@ -168,6 +192,8 @@ class Row {
  private:
   friend Row internal::MakeRow(std::vector<Value>,
                                std::shared_ptr<const std::vector<std::string>>);
+  template <typename Tuple>
+  friend class internal::TupleParser;
   struct ExtractValue {
     Status& status;
     template <typename T, typename It>
@@ -227,6 +253,82 @@ Row MakeTestRow(Ts&&... ts) {
   return internal::MakeRow(std::move(v), std::move(columns));
 }
 
+namespace internal {
+
+/**
+ * Parses a sequence of `Row`s that share a schema into `Tuple`s.
+ *
+ * `Row::get<Tuple>()` checks that the type of every column matches the
+ * corresponding tuple element type, on every row. All the rows in a result
+ * set share the same schema, so `TupleParser` performs those checks only once
+ * per result set, and decodes the remaining rows through a check-free path.
+ *
+ * Rows from the same result set are recognized by the identity of their
+ * shared column names; a row with any other provenance is re-validated before
+ * it is decoded, so mixed inputs behave as if `Row::get<Tuple>()` were called
+ * on every row.
+ */
+template <typename Tuple>
+class TupleParser {
+  static_assert(IsTuple<Tuple>::value,
+                "TupleParser<T> requires a std::tuple parameter");
+
+ public:
+  /// Returns the native C++ values for @p row in a `Tuple`.
+  StatusOr<Tuple> Parse(Row row) {
+    if (row.columns_ != validated_columns_) {
+      auto status = Validate(row);
+      if (!status.ok()) return status;
+      validated_columns_ = row.columns_;
+    }
+    Tuple tup;
+    auto it = row.values_.begin();
+    Status status;
+    ForEach(tup, ExtractUnchecked{status}, it);
+    if (!status.ok()) return status;
+    return tup;
+  }
+
+ private:
+  static Status Validate(Row const& row) {
+    if (row.size() != std::tuple_size<Tuple>::value) {
+      auto const msg = "Tuple has the wrong number of elements";
+      return Status(StatusCode::kInvalidArgument, msg);
+    }
+    Tuple tup;
+    bool ok = true;
+    auto it = row.values_.begin();
+    ForEach(tup, CheckColumnType{ok}, it);
+    if (!ok) return Status(StatusCode::kUnknown, "wrong type");
+    return Status();
+  }
+
+  struct CheckColumnType {
+    bool& ok;
+    template <typename T, typename It>
+    void operator()(T const&, It& it) const {
+      ok = ok && ValueInternals::TypeMatches(T{}, *it++);
+    }
+  };
+
+  struct ExtractUnchecked {
+    Status& status;
+    template <typename T, typename It>
+    void operator()(T& t, It& it) const {
+      auto x = ValueInternals::GetUnchecked<T>(std::move(*it++));
+      if (!x) {
+        status = std::move(x).status();
+      } else {
+        t = *std::move(x);
+      }
+    }
+  };
+
+  std::shared_ptr<const std::vector<std::string>> validated_columns_;
+};
+
+}  // namespace internal
+
 /**
  * A `RowStreamIterator` is an _Input Iterator_ (see below) that returns a
  * sequence of `StatusOr<Row>` objects.
@@ -363,9 +465,10 @@ class TupleStreamIterator {
  private:
   void ParseTuple() {
     if (it_ == end_) return;
-    tup_ = *it_ ? std::move(*it_)->template get<Tuple>() : it_->status();
+    tup_ = *it_ ? parser_.Parse(*std::move(*it_)) : it_->status();
   }
 
+  internal::TupleParser<Tuple> parser_;
   value_type tup_;
   RowStreamIterator it_;
   RowStreamIterator end_;
@@ -0,0 +1,143 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/row_prefetch.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+namespace {
+
+/**
+ * A `ResultSourceInterface` whose rows are pulled from a wrapped source by a
+ * single producer thread, through a bounded queue.
+ *
+ * The producer pushes everything the wrapped source yields, including the
+ * terminal element (an error or the end-of-stream marker), and then exits; a
+ * popped terminal element is replayed to any further `NextRow()` calls.
+ * Destroying the source stops the producer and joins the thread.
+ */
+class PrefetchSource : public internal::ResultSourceInterface {
+ public:
+  PrefetchSource(std::unique_ptr<internal::ResultSourceInterface> source,
+                 std::size_t buffer_size)
+      : source_(std::move(source)),
+        buffer_size_((std::max<std::size_t>)(buffer_size, 1)) {}
+
+  ~PrefetchSource() override {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cond_push_.notify_all();
+    if (producer_.joinable()) producer_.join();
+  }
+
+  void Start() {
+    // The metadata is available before the first row, and capturing it here
+    // means `Metadata()` never touches `source_` while the producer owns it.
+    metadata_ = source_->Metadata();
+    producer_ = std::thread([this] { Producer(); });
+  }
+
+  StatusOr<Row> NextRow() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (terminal_) return *terminal_;
+    cond_pop_.wait(lk, [this] { return !queue_.empty(); });
+    auto row = std::move(queue_.front());
+    queue_.pop_front();
+    if (!row || row->size() == 0) {
+      terminal_ = row;
+      return row;
+    }
+    lk.unlock();
+    cond_push_.notify_one();
+    return row;
+  }
+
+  absl::optional<google::spanner::v1::ResultSetMetadata> Metadata() override {
+    return metadata_;
+  }
+
+  absl::optional<google::spanner::v1::ResultSetStats> Stats() const override {
+    // The stats trail the last row, so they are only available (and `source_`
+    // is only safe to share) once the producer has finished.
+    std::unique_lock<std::mutex> lk(mu_);
+    if (!producer_done_) return absl::nullopt;
+    return source_->Stats();
+  }
+
+ private:
+  void Producer() {
+    for (;;) {
+      auto row = source_->NextRow();
+      auto const is_terminal = !row || row->size() == 0;
+      std::unique_lock<std::mutex> lk(mu_);
+      cond_push_.wait(
+          lk, [this] { return queue_.size() < buffer_size_ || shutdown_; });
+      if (shutdown_) break;
+      queue_.push_back(std::move(row));
+      lk.unlock();
+      cond_pop_.notify_one();
+      if (is_terminal) break;
+    }
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      producer_done_ = true;
+    }
+  }
+
+  std::unique_ptr<internal::ResultSourceInterface> source_;
+  std::size_t const buffer_size_;
+  absl::optional<google::spanner::v1::ResultSetMetadata> metadata_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cond_push_;
+  std::condition_variable cond_pop_;
+  std::deque<StatusOr<Row>> queue_;          // GUARDED_BY(mu_)
+  absl::optional<StatusOr<Row>> terminal_;   // GUARDED_BY(mu_)
+  bool shutdown_ = false;                    // GUARDED_BY(mu_)
+  bool producer_done_ = false;               // GUARDED_BY(mu_)
+
+  std::thread producer_;
+};
+
+}  // namespace
+
+RowStream MakePrefetchedRowStream(RowStream stream,
+                                  std::size_t row_buffer_size) {
+  auto inner = internal::RowStreamInternals::GetSource(std::move(stream));
+  // A default-constructed `RowStream` has no source; there is nothing to
+  // prefetch from.
+  if (!inner) return RowStream();
+  auto source =
+      absl::make_unique<PrefetchSource>(std::move(inner), row_buffer_size);
+  source->Start();
+  return RowStream(std::move(source));
+}
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
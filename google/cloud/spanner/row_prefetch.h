@@ -0,0 +1,58 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_ROW_PREFETCH_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_ROW_PREFETCH_H
+
+#include "google/cloud/spanner/results.h"
+#include "google/cloud/spanner/version.h"
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+
+/**
+ * Returns a `RowStream` that prefetches rows from @p stream on a background
+ * thread.
+ *
+ * Ordinarily a `RowStream` reads and decodes each row on the consumer's
+ * thread, between the consumer's own processing steps. The returned stream
+ * instead owns a thread that pulls rows from @p stream ahead of the consumer,
+ * buffering up to @p row_buffer_size of them, so the network reads and the
+ * row decoding overlap with the consumer's processing. This helps
+ * applications that do non-trivial work per row; it adds no value (just a
+ * thread and a small amount of buffering) when the consumer is faster than
+ * the source.
+ *
+ * The returned stream yields exactly the rows (or the error) that iterating
+ * @p stream directly would have yielded, in the same order. Destroying the
+ * returned stream before reading it to the end stops the prefetching and
+ * joins the thread.
+ *
+ * Values of @p row_buffer_size less than 1 are treated as 1.
+ *
+ * @note `RowStream::ReadTimestamp()` remains available on the returned
+ *     stream.
+ */
+RowStream MakePrefetchedRowStream(RowStream stream,
+                                  std::size_t row_buffer_size = 1000);
+
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_SPANNER_ROW_PREFETCH_H
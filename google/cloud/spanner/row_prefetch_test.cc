@@ -0,0 +1,140 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/spanner/row_prefetch.h"
+#include "google/cloud/spanner/mocks/mock_spanner_connection.h"
+#include "google/cloud/spanner/timestamp.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace spanner {
+inline namespace SPANNER_CLIENT_NS {
+namespace {
+
+namespace spanner_proto = ::google::spanner::v1;
+
+using ::google::cloud::spanner_mocks::MockResultSetSource;
+using ::testing::ElementsAre;
+using ::testing::Return;
+
+TEST(RowPrefetchTest, DeliversAllRowsInOrder) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(absl::nullopt));
+  EXPECT_CALL(*source, NextRow())
+      .WillOnce(Return(MakeTestRow(1)))
+      .WillOnce(Return(MakeTestRow(2)))
+      .WillOnce(Return(MakeTestRow(3)))
+      .WillOnce(Return(Row()));
+
+  auto rows = MakePrefetchedRowStream(RowStream(std::move(source)));
+  std::vector<std::int64_t> actual;
+  for (auto const& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    ASSERT_STATUS_OK(row);
+    actual.push_back(std::get<0>(*row));
+  }
+  EXPECT_THAT(actual, ElementsAre(1, 2, 3));
+}
+
+TEST(RowPrefetchTest, BackpressureLosesNothing) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(absl::nullopt));
+  auto& next_row = EXPECT_CALL(*source, NextRow());
+  for (std::int64_t i = 0; i != 100; ++i) {
+    next_row.WillOnce(Return(MakeTestRow(i)));
+  }
+  next_row.WillOnce(Return(Row()));
+
+  // A one-row buffer forces the producer to block on nearly every push.
+  auto rows =
+      MakePrefetchedRowStream(RowStream(std::move(source)), /*buffer=*/1);
+  std::int64_t expected = 0;
+  for (auto const& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    ASSERT_STATUS_OK(row);
+    EXPECT_EQ(std::get<0>(*row), expected++);
+  }
+  EXPECT_EQ(expected, 100);
+}
+
+TEST(RowPrefetchTest, ErrorEndsStream) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(absl::nullopt));
+  EXPECT_CALL(*source, NextRow())
+      .WillOnce(Return(MakeTestRow(1)))
+      .WillOnce(Return(Status(StatusCode::kUnknown, "oops")));
+
+  auto rows = MakePrefetchedRowStream(RowStream(std::move(source)));
+  int num_rows = 0;
+  for (auto const& row : StreamOf<std::tuple<std::int64_t>>(rows)) {
+    switch (num_rows++) {
+      case 0:
+        ASSERT_STATUS_OK(row);
+        EXPECT_EQ(std::get<0>(*row), 1);
+        break;
+
+      case 1:
+        EXPECT_FALSE(row.ok());
+        EXPECT_EQ(row.status().code(), StatusCode::kUnknown);
+        EXPECT_EQ(row.status().message(), "oops");
+        break;
+
+      default:
+        ADD_FAILURE() << "Unexpected row number " << num_rows;
+        break;
+    }
+  }
+  EXPECT_EQ(num_rows, 2);
+}
+
+TEST(RowPrefetchTest, PreservesReadTimestamp) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  spanner_proto::ResultSetMetadata metadata;
+  metadata.mutable_transaction()->set_id("dummy");
+  Timestamp timestamp = MakeTimestamp(std::chrono::system_clock::now()).value();
+  *metadata.mutable_transaction()->mutable_read_timestamp() =
+      internal::TimestampToProto(timestamp);
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(metadata));
+  EXPECT_CALL(*source, NextRow()).WillOnce(Return(Row()));
+
+  auto rows = MakePrefetchedRowStream(RowStream(std::move(source)));
+  EXPECT_EQ(*rows.ReadTimestamp(), timestamp);
+}
+
+TEST(RowPrefetchTest, AbandonedStreamStopsPrefetching) {
+  auto source = absl::make_unique<MockResultSetSource>();
+  EXPECT_CALL(*source, Metadata()).WillRepeatedly(Return(absl::nullopt));
+  EXPECT_CALL(*source, NextRow())
+      .WillRepeatedly(Return(MakeTestRow("unbounded")));
+
+  // Destroying the stream must stop the producer even though the wrapped
+  // source never runs out of rows.
+  auto rows =
+      MakePrefetchedRowStream(RowStream(std::move(source)), /*buffer=*/2);
+  auto it = rows.begin();
+  ASSERT_NE(it, rows.end());
+  EXPECT_STATUS_OK(*it);
+}
+
+}  // namespace
+}  // namespace SPANNER_CLIENT_NS
+}  // namespace spanner
+}  // namespace cloud
+}  // namespace google
@@ -162,6 +162,34 @@ TEST(Row, TemplatedGetByColumnName) {
   EXPECT_EQ(true, *row.get<bool>("c"));
 }
 
+TEST(Row, RvalueGetByPosition) {
+  Row row = MakeTestRow(1, "blah", true);
+
+  Row copy = row;
+  EXPECT_EQ(Value("blah"), *std::move(copy).get(1));
+
+  copy = row;
+  EXPECT_FALSE(std::move(copy).get(3).ok());
+
+  EXPECT_EQ("blah", *std::move(row).get<std::string>(1));
+}
+
+TEST(Row, RvalueGetByColumnName) {
+  Row row = MakeTestRow({
+      {"a", Value(1)},       //
+      {"b", Value("blah")},  //
+      {"c", Value(true)}     //
+  });
+
+  Row copy = row;
+  EXPECT_EQ(Value("blah"), *std::move(copy).get("b"));
+
+  copy = row;
+  EXPECT_FALSE(std::move(copy).get("not a column name").ok());
+
+  EXPECT_EQ("blah", *std::move(row).get<std::string>("b"));
+}
+
 TEST(Row, TemplatedGetAsTuple) {
   Row row = MakeTestRow(1, "blah", true);
 
@@ -187,6 +215,58 @@ TEST(Row, TemplatedGetAsTuple) {
   EXPECT_EQ(std::make_tuple(1, "blah", true), *std::move(row).get<RowType>());
 }
 
+TEST(TupleParser, SharedSchema) {
+  auto columns = std::make_shared<std::vector<std::string>>(
+      std::vector<std::string>{"num", "name"});
+  using RowType = std::tuple<std::int64_t, std::string>;
+  internal::TupleParser<RowType> parser;
+  // All the rows share `columns`, so only the first row is type checked.
+  for (std::int64_t i = 0; i != 3; ++i) {
+    auto name = "row" + std::to_string(i);
+    auto row = internal::MakeRow({Value(i), Value(name)}, columns);
+    auto tup = parser.Parse(std::move(row));
+    EXPECT_STATUS_OK(tup);
+    EXPECT_EQ(std::make_tuple(i, name), *tup);
+  }
+}
+
+TEST(TupleParser, WrongNumberOfElements) {
+  internal::TupleParser<std::tuple<std::int64_t>> parser;
+  auto tup = parser.Parse(MakeTestRow(1, 2));
+  EXPECT_EQ(StatusCode::kInvalidArgument, tup.status().code());
+  EXPECT_THAT(tup.status().message(), HasSubstr("wrong number of elements"));
+}
+
+TEST(TupleParser, WrongType) {
+  internal::TupleParser<std::tuple<std::int64_t>> parser;
+  auto tup = parser.Parse(MakeTestRow("blah"));
+  EXPECT_EQ(StatusCode::kUnknown, tup.status().code());
+  EXPECT_THAT(tup.status().message(), HasSubstr("wrong type"));
+}
+
+TEST(TupleParser, NullValue) {
+  internal::TupleParser<std::tuple<std::int64_t>> parser;
+  auto tup = parser.Parse(MakeTestRow(MakeNullValue<std::int64_t>()));
+  EXPECT_EQ(StatusCode::kUnknown, tup.status().code());
+  EXPECT_THAT(tup.status().message(), HasSubstr("null value"));
+
+  internal::TupleParser<std::tuple<absl::optional<std::int64_t>>> opt_parser;
+  auto opt = opt_parser.Parse(MakeTestRow(MakeNullValue<std::int64_t>()));
+  EXPECT_STATUS_OK(opt);
+  EXPECT_FALSE(std::get<0>(*opt).has_value());
+}
+
+TEST(TupleParser, RevalidatesNewSchemas) {
+  internal::TupleParser<std::tuple<std::int64_t>> parser;
+  // Each `MakeTestRow()` call creates a new set of column names, so every row
+  // here is re-validated, as if `Row::get<Tuple>()` were called.
+  auto tup = parser.Parse(MakeTestRow(42));
+  EXPECT_STATUS_OK(tup);
+  EXPECT_EQ(42, std::get<0>(*tup));
+  auto bad = parser.Parse(MakeTestRow("blah"));
+  EXPECT_EQ(StatusCode::kUnknown, bad.status().code());
+}
+
 TEST(MakeTestRow, ExplicitColumNames) {
   auto row = MakeTestRow({{"a", Value(42)}, {"b", Value(52)}});
   EXPECT_EQ(Value(42), *row.get("a"));
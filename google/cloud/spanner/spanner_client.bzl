@@ -23,6 +23,7 @@ spanner_client_hdrs = [
     "bytes.h",
     "client.h",
     "client_options.h",
+    "columnar_batch.h",
     "commit_result.h",
     "connection.h",
     "connection_options.h",
@@ -31,11 +32,13 @@ spanner_client_hdrs = [
     "database_admin_client.h",
     "database_admin_connection.h",
     "date.h",
+    "dml_batcher.h",
     "iam_updater.h",
     "instance.h",
     "instance_admin_client.h",
     "instance_admin_connection.h",
     "internal/api_client_header.h",
+    "internal/async_row_source.h",
     "internal/channel.h",
     "internal/clock.h",
     "internal/compiler_info.h",
@@ -50,6 +53,7 @@ spanner_client_hdrs = [
     "internal/logging_spanner_stub.h",
     "internal/merge_chunk.h",
     "internal/metadata_spanner_stub.h",
+    "internal/partial_result_set_assembler.h",
     "internal/partial_result_set_reader.h",
     "internal/partial_result_set_resume.h",
     "internal/partial_result_set_source.h",
@@ -58,12 +62,14 @@ spanner_client_hdrs = [
     "internal/session.h",
     "internal/session_pool.h",
     "internal/spanner_stub.h",
+    "internal/sql_statement_cache.h",
     "internal/status_utils.h",
     "internal/transaction_impl.h",
     "internal/tuple_utils.h",
     "keys.h",
     "mutations.h",
     "numeric.h",
+    "parallel_scan.h",
     "partition_options.h",
     "partitioned_dml_result.h",
     "polling_policy.h",
@@ -74,6 +80,7 @@ spanner_client_hdrs = [
     "results.h",
     "retry_policy.h",
     "row.h",
+    "row_prefetch.h",
     "session_pool_options.h",
     "sql_statement.h",
     "timestamp.h",
@@ -89,14 +96,17 @@ spanner_client_srcs = [
     "backup.cc",
     "bytes.cc",
     "client.cc",
+    "columnar_batch.cc",
     "connection_options.cc",
     "database.cc",
     "database_admin_client.cc",
     "database_admin_connection.cc",
+    "dml_batcher.cc",
     "instance.cc",
     "instance_admin_client.cc",
     "instance_admin_connection.cc",
     "internal/api_client_header.cc",
+    "internal/async_row_source.cc",
     "internal/compiler_info.cc",
     "internal/connection_impl.cc",
     "internal/database_admin_logging.cc",
@@ -109,22 +119,26 @@ spanner_client_srcs = [
     "internal/logging_spanner_stub.cc",
     "internal/merge_chunk.cc",
     "internal/metadata_spanner_stub.cc",
+    "internal/partial_result_set_assembler.cc",
     "internal/partial_result_set_resume.cc",
     "internal/partial_result_set_source.cc",
     "internal/retry_loop.cc",
     "internal/session.cc",
     "internal/session_pool.cc",
     "internal/spanner_stub.cc",
+    "internal/sql_statement_cache.cc",
     "internal/status_utils.cc",
     "internal/transaction_impl.cc",
     "keys.cc",
     "mutations.cc",
     "numeric.cc",
+    "parallel_scan.cc",
     "partition_options.cc",
     "query_partition.cc",
     "read_partition.cc",
     "results.cc",
     "row.cc",
+    "row_prefetch.cc",
     "sql_statement.cc",
     "timestamp.cc",
     "transaction.cc",
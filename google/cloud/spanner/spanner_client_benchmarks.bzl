@@ -19,6 +19,7 @@
 spanner_client_benchmarks = [
     "bytes_benchmark.cc",
     "internal/merge_chunk_benchmark.cc",
+    "internal/partial_result_set_source_benchmark.cc",
     "numeric_benchmark.cc",
     "row_benchmark.cc",
 ]
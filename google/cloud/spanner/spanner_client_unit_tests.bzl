@@ -21,15 +21,18 @@ spanner_client_unit_tests = [
     "bytes_test.cc",
     "client_options_test.cc",
     "client_test.cc",
+    "columnar_batch_test.cc",
     "connection_options_test.cc",
     "create_instance_request_builder_test.cc",
     "database_admin_client_test.cc",
     "database_admin_connection_test.cc",
     "database_test.cc",
+    "dml_batcher_test.cc",
     "instance_admin_client_test.cc",
     "instance_admin_connection_test.cc",
     "instance_test.cc",
     "internal/api_client_header_test.cc",
+    "internal/async_row_source_test.cc",
     "internal/clock_test.cc",
     "internal/compiler_info_test.cc",
     "internal/connection_impl_test.cc",
@@ -47,12 +50,14 @@ spanner_client_unit_tests = [
     "internal/retry_loop_test.cc",
     "internal/session_pool_test.cc",
     "internal/spanner_stub_test.cc",
+    "internal/sql_statement_cache_test.cc",
     "internal/status_utils_test.cc",
     "internal/transaction_impl_test.cc",
     "internal/tuple_utils_test.cc",
     "keys_test.cc",
     "mutations_test.cc",
     "numeric_test.cc",
+    "parallel_scan_test.cc",
     "partition_options_test.cc",
     "query_options_test.cc",
     "query_partition_test.cc",
@@ -60,6 +65,7 @@ spanner_client_unit_tests = [
     "read_partition_test.cc",
     "results_test.cc",
     "retry_policy_test.cc",
+    "row_prefetch_test.cc",
     "row_test.cc",
     "session_pool_options_test.cc",
     "spanner_version_test.cc",
@@ -35,6 +35,10 @@ SqlStatementProto ToProto(SqlStatement s) {
   }
   return statement_proto;
 }
+
+SqlStatement::ParamType ExtractParams(SqlStatement s) {
+  return std::move(s.params_);
+}
 }  // namespace internal
 
 std::vector<std::string> SqlStatement::ParameterNames() const {
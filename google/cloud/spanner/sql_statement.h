@@ -36,6 +36,7 @@ namespace internal {
 using SqlStatementProto =
     google::spanner::v1::ExecuteBatchDmlRequest::Statement;
 SqlStatementProto ToProto(SqlStatement s);
+std::unordered_map<std::string, Value> ExtractParams(SqlStatement s);
 }  // namespace internal
 
 /**
@@ -114,6 +115,7 @@ class SqlStatement {
 
  private:
   friend internal::SqlStatementProto internal::ToProto(SqlStatement s);
+  friend SqlStatement::ParamType internal::ExtractParams(SqlStatement s);
 
   std::string statement_;
   ParamType params_;
@@ -81,6 +81,13 @@ class MockSpannerStub : public google::cloud::spanner::internal::SpannerStub {
           grpc::ClientReaderInterface<google::spanner::v1::PartialResultSet>>(
           grpc::ClientContext&, google::spanner::v1::ExecuteSqlRequest const&));
 
+  MOCK_METHOD3(AsyncExecuteStreamingSql,
+               std::unique_ptr<grpc::ClientAsyncReaderInterface<
+                   google::spanner::v1::PartialResultSet>>(
+                   grpc::ClientContext&,
+                   google::spanner::v1::ExecuteSqlRequest const&,
+                   grpc::CompletionQueue*));
+
   MOCK_METHOD2(ExecuteBatchDml,
                StatusOr<google::spanner::v1::ExecuteBatchDmlResponse>(
                    grpc::ClientContext&,
@@ -105,6 +112,13 @@ class MockSpannerStub : public google::cloud::spanner::internal::SpannerStub {
                            grpc::ClientContext&,
                            google::spanner::v1::CommitRequest const&));
 
+  MOCK_METHOD3(AsyncCommit,
+               std::unique_ptr<grpc::ClientAsyncResponseReaderInterface<
+                   google::spanner::v1::CommitResponse>>(
+                   grpc::ClientContext&,
+                   google::spanner::v1::CommitRequest const&,
+                   grpc::CompletionQueue*));
+
   MOCK_METHOD2(Rollback, Status(grpc::ClientContext&,
                                 google::spanner::v1::RollbackRequest const&));
 
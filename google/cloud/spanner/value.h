@@ -46,6 +46,7 @@ class Value;  // Defined later in this file.
 namespace internal {
 Value FromProto(google::spanner::v1::Type t, google::protobuf::Value v);
 std::pair<google::spanner::v1::Type, google::protobuf::Value> ToProto(Value v);
+struct ValueInternals;
 }  // namespace internal
 
 /**
@@ -645,6 +646,7 @@ class Value {
                                    google::protobuf::Value);
   friend std::pair<google::spanner::v1::Type, google::protobuf::Value>
       internal::ToProto(Value);
+  friend struct internal::ValueInternals;
 
   google::spanner::v1::Type type_;
   google::protobuf::Value value_;
@@ -662,6 +664,72 @@ Value MakeNullValue() {
   return Value(absl::optional<T>{});
 }
 
+namespace internal {
+
+/**
+ * Internal access to a `Value` that separates the type check from the
+ * extraction of the C++ value.
+ *
+ * `Value::get<T>()` verifies that `T` matches the value's `Type` proto before
+ * each extraction. When decoding many values known to share a schema (e.g.,
+ * the rows of a single result set) callers can verify the types once with
+ * `TypeMatches()` and then extract each value with `GetUnchecked()`.
+ *
+ * Also exposes `ToValueProto()`, which encodes only the `Value` proto of a
+ * cell, for callers that do not need its `Type` proto (e.g., the mutation
+ * API, where the server derives the types from the table schema).
+ */
+struct ValueInternals {
+  /// Returns the `Type` proto describing the type of @p v.
+  static google::spanner::v1::Type const& GetType(Value const& v) {
+    return v.type_;
+  }
+
+  /// Returns true if the C++ type of @p tag matches the type of @p v.
+  template <typename T>
+  static bool TypeMatches(T const& tag, Value const& v) {
+    return Value::TypeProtoIs(tag, v.type_);
+  }
+
+  /**
+   * Extracts the C++ value of type `T` without checking the value's type.
+   *
+   * The caller must have previously established, with `TypeMatches()`, that
+   * `T` matches the type of @p v; otherwise the behavior is undefined. Nulls
+   * are still handled, as any value may be null regardless of its type.
+   */
+  template <typename T>
+  static StatusOr<T> GetUnchecked(Value v) {
+    if (v.value_.kind_case() == google::protobuf::Value::kNullValue) {
+      if (Value::IsOptional<T>::value) return T{};
+      return Status(StatusCode::kUnknown, "null value");
+    }
+    auto tag = T{};  // Works around an odd msvc issue
+    return Value::GetValue(std::move(tag), std::move(v.value_), v.type_);
+  }
+
+  /**
+   * Encodes @p v as a `Value` proto without building its `Type` proto.
+   *
+   * Equivalent to the value half of `ToProto(Value(v))`, but skips the
+   * construction (and destruction) of the `Type` proto tree for every cell.
+   */
+  template <typename T,
+            typename std::enable_if<
+                !std::is_same<typename std::decay<T>::type, Value>::value,
+                int>::type = 0>
+  static google::protobuf::Value ToValueProto(T&& v) {
+    return Value::MakeValueProto(std::forward<T>(v));
+  }
+
+  /// Moves the `Value` proto out of @p v, discarding its `Type` proto.
+  static google::protobuf::Value ToValueProto(Value v) {
+    return std::move(v.value_);
+  }
+};
+
+}  // namespace internal
+
 }  // namespace SPANNER_CLIENT_NS
 }  // namespace spanner
 }  // namespace cloud
@@ -71,6 +71,19 @@ std::ostream& operator<<(std::ostream& os, StatusCode code) {
   return os << StatusCodeToString(code);
 }
 
+std::string const& Status::message() const {
+  // Allocated on first use and never destroyed to avoid any exit-time races
+  // with threads still holding a reference.
+  static auto const* const kEmpty = new std::string;
+  return rep_ ? rep_->message : *kEmpty;
+}
+
+std::string const& Status::error_details() const {
+  // See the comments in `message()` for the rationale.
+  static auto const* const kEmpty = new std::string;
+  return rep_ ? rep_->error_details : *kEmpty;
+}
+
 RuntimeStatusError::RuntimeStatusError(Status status)
     : std::runtime_error(StatusWhat(status)), status_(std::move(status)) {}
 
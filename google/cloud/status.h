@@ -17,6 +17,7 @@
 
 #include "google/cloud/version.h"
 #include <iostream>
+#include <memory>
 #include <tuple>
 
 namespace google {
@@ -62,19 +63,57 @@ std::ostream& operator<<(std::ostream& os, StatusCode code);
  */
 class Status {
  public:
+  /// Creates an OK status, this is a cheap operation with no allocations.
   Status() = default;
 
-  explicit Status(StatusCode status_code, std::string message)
-      : code_(status_code), message_(std::move(message)) {}
-
-  bool ok() const { return code_ == StatusCode::kOk; }
-
-  StatusCode code() const { return code_; }
-  std::string const& message() const { return message_; }
+  /**
+   * Creates a status with the given @p status_code and @p message.
+   *
+   * An OK status never carries a message: when @p status_code is
+   * `StatusCode::kOk` the @p message (and @p error_details) are discarded and
+   * the result is identical to a default-constructed status.
+   *
+   * @param error_details an opaque blob of error details, e.g. the serialized
+   *     `google.rpc.Status` proto returned by some services. The blob is
+   *     stored as-is, it is never parsed or interpreted by this class.
+   */
+  explicit Status(StatusCode status_code, std::string message,
+                  std::string error_details = {})
+      : rep_(status_code == StatusCode::kOk
+                 ? nullptr
+                 : std::make_shared<Rep const>(
+                       Rep{status_code, std::move(message),
+                           std::move(error_details)})) {}
+
+  bool ok() const { return !rep_; }
+
+  StatusCode code() const { return rep_ ? rep_->code : StatusCode::kOk; }
+  std::string const& message() const;
+
+  /**
+   * The error details attached to this status, if any.
+   *
+   * The value is an opaque blob, typically a serialized `google.rpc.Status`
+   * proto for errors returned by a service. It is empty for OK statuses and
+   * for errors without details. Callers that need the structured form must
+   * parse the blob themselves; the conversion from `grpc::Status` stores it
+   * without any parsing.
+   */
+  std::string const& error_details() const;
 
  private:
-  StatusCode code_{StatusCode::kOk};
-  std::string message_;
+  struct Rep {
+    StatusCode code;
+    std::string message;
+    std::string error_details;
+  };
+
+  // `Status` values are copied through every `StatusOr<T>` return and every
+  // stub decorator layer (retry, logging, metadata). The representation is an
+  // immutable, reference-counted payload so those copies do not copy the
+  // message, and a null payload for OK so the success path has no string (or
+  // any other) members to copy at all.
+  std::shared_ptr<Rep const> rep_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, Status const& rhs) {
@@ -82,7 +121,8 @@ inline std::ostream& operator<<(std::ostream& os, Status const& rhs) {
 }
 
 inline bool operator==(Status const& lhs, Status const& rhs) {
-  return lhs.code() == rhs.code() && lhs.message() == rhs.message();
+  return lhs.code() == rhs.code() && lhs.message() == rhs.message() &&
+         lhs.error_details() == rhs.error_details();
 }
 
 inline bool operator!=(Status const& lhs, Status const& rhs) {
@@ -93,7 +93,7 @@ class StatusOr final {
    *     they are simply integers, usually HTTP status codes. We need to map to
    *     the well-defined set of status codes.
    */
-  StatusOr() : StatusOr(Status(StatusCode::kUnknown, "default")) {}
+  StatusOr() : StatusOr(DefaultStatus()) {}
 
   /**
    * Creates a new `StatusOr<T>` holding the error condition @p rhs.
@@ -123,9 +123,13 @@ class StatusOr final {
     return *this;
   }
 
+  // Note that the status is copied, not moved: a copy is just a reference
+  // count increment, and it preserves the invariant that a moved-from
+  // `StatusOr<T>` holding an error is still `!ok()`. A moved-from `Status`
+  // would be OK, while `rhs.value_` was never constructed.
   // NOLINTNEXTLINE(performance-noexcept-move-constructor)
   StatusOr(StatusOr&& rhs) noexcept(noexcept(T(std::move(*rhs))))
-      : status_(std::move(rhs.status_)) {
+      : status_(rhs.status_) {
     if (status_.ok()) {
       new (&value_) T(std::move(*rhs));
     }
@@ -138,7 +142,8 @@ class StatusOr final {
     // the destination and/or default initializing it unless really needed.
     if (!ok()) {
       if (!rhs.ok()) {
-        status_ = std::move(rhs.status_);
+        // Copying the status preserves `!rhs.ok()`, see the move constructor.
+        status_ = rhs.status_;
         return *this;
       }
       new (&value_) T(std::move(*rhs));
@@ -147,7 +152,7 @@ class StatusOr final {
     }
     if (!rhs.ok()) {
       value_.~T();
-      status_ = std::move(rhs.status_);
+      status_ = rhs.status_;
       return *this;
     }
     **this = *std::move(rhs);
@@ -302,6 +307,22 @@ class StatusOr final {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_CONST_REF_REF
   //@}
 
+  /**
+   * Constructs the value in-place from @p args.
+   *
+   * Destroys any previously held value or error status. Compared to assigning
+   * a `T` this avoids constructing a temporary and moving it into place.
+   *
+   * If the constructor of `T` throws, the object holds a `kUnknown` error.
+   *
+   * @return a reference to the newly constructed value.
+   */
+  template <typename... Args>
+  T& emplace(Args&&... args) {
+    return EmplaceImpl(std::is_nothrow_constructible<T, Args...>{},
+                       std::forward<Args>(args)...);
+  }
+
   //@{
   /**
    * @name Status accessors.
@@ -319,6 +340,34 @@ class StatusOr final {
         //@}
 
  private:
+  // All default-constructed `StatusOr<T>` share one immutable `Status`, so
+  // none of them allocates.
+  static Status const& DefaultStatus() {
+    static Status const kDefault(StatusCode::kUnknown, "default");
+    return kDefault;
+  }
+
+  template <typename... Args>
+  T& EmplaceImpl(std::true_type, Args&&... args) {
+    if (ok()) value_.~T();
+    new (&value_) T(std::forward<Args>(args)...);
+    status_ = Status();
+    return value_;
+  }
+
+  template <typename... Args>
+  T& EmplaceImpl(std::false_type, Args&&... args) {
+    if (ok()) {
+      value_.~T();
+      // The constructor below may throw, and then this object must not claim
+      // to hold a value.
+      status_ = DefaultStatus();
+    }
+    new (&value_) T(std::forward<Args>(args)...);
+    status_ = Status();
+    return value_;
+  }
+
   void CheckHasValue() const& {
     if (!ok()) {
       internal::ThrowStatus(status_);
@@ -358,6 +407,19 @@ StatusOr<T> make_status_or(T rhs) {
   return StatusOr<T>(std::move(rhs));
 }
 
+/**
+ * Creates a `StatusOr<T>` holding a value constructed in-place from @p args.
+ *
+ * Unlike `make_status_or(T)` the value is never moved: it is built directly
+ * inside the result, and the return relies on copy elision.
+ */
+template <typename T, typename... Args>
+StatusOr<T> make_status_or_in_place(Args&&... args) {
+  StatusOr<T> result;
+  result.emplace(std::forward<Args>(args)...);
+  return result;
+}
+
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
 }  // namespace google
@@ -456,6 +456,47 @@ TEST(StatusOrObservableTest, MoveValue) {
   EXPECT_EQ("moved-out", other->str());
 }
 
+/// @test `emplace()` constructs in-place, without temporaries or moves.
+TEST(StatusOrObservableTest, EmplaceOverError) {
+  StatusOr<Observable> sor;
+  EXPECT_FALSE(sor.ok());
+
+  Observable::reset_counters();
+  auto& value = sor.emplace("foo");
+  EXPECT_STATUS_OK(sor);
+  EXPECT_EQ("foo", value.str());
+  EXPECT_EQ(&value, &*sor);
+  EXPECT_EQ(1, Observable::value_constructor());
+  EXPECT_EQ(0, Observable::move_constructor());
+  EXPECT_EQ(0, Observable::copy_constructor());
+  EXPECT_EQ(0, Observable::move_assignment());
+  EXPECT_EQ(0, Observable::copy_assignment());
+}
+
+/// @test `emplace()` destroys any previously held value.
+TEST(StatusOrObservableTest, EmplaceOverValue) {
+  StatusOr<Observable> sor(Observable("foo"));
+
+  Observable::reset_counters();
+  sor.emplace("bar");
+  EXPECT_STATUS_OK(sor);
+  EXPECT_EQ("bar", sor->str());
+  EXPECT_EQ(1, Observable::destructor());
+  EXPECT_EQ(1, Observable::value_constructor());
+  EXPECT_EQ(0, Observable::move_constructor());
+  EXPECT_EQ(0, Observable::copy_constructor());
+}
+
+/// @test `make_status_or_in_place<T>()` never moves the value.
+TEST(StatusOrObservableTest, MakeStatusOrInPlace) {
+  Observable::reset_counters();
+  auto sor = make_status_or_in_place<Observable>("foo");
+  EXPECT_STATUS_OK(sor);
+  EXPECT_EQ("foo", sor->str());
+  EXPECT_EQ(1, Observable::value_constructor());
+  EXPECT_EQ(0, Observable::copy_constructor());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
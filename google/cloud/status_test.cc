@@ -49,6 +49,61 @@ TEST(Status, StatusCodeToString) {
             StatusCodeToString(static_cast<StatusCode>(42)));
 }
 
+TEST(Status, Default) {
+  Status status;
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(StatusCode::kOk, status.code());
+  EXPECT_EQ("", status.message());
+}
+
+TEST(Status, ErrorCodeAndMessage) {
+  Status status(StatusCode::kNotFound, "NOT FOUND");
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(StatusCode::kNotFound, status.code());
+  EXPECT_EQ("NOT FOUND", status.message());
+}
+
+TEST(Status, OkDiscardsMessage) {
+  Status status(StatusCode::kOk, "this message is discarded");
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("", status.message());
+  EXPECT_EQ(Status(), status);
+}
+
+TEST(Status, ErrorDetails) {
+  Status status(StatusCode::kNotFound, "NOT FOUND", "serialized-proto-blob");
+  EXPECT_EQ("NOT FOUND", status.message());
+  EXPECT_EQ("serialized-proto-blob", status.error_details());
+  EXPECT_EQ("", Status(StatusCode::kNotFound, "NOT FOUND").error_details());
+}
+
+TEST(Status, OkDiscardsErrorDetails) {
+  Status status(StatusCode::kOk, "discarded", "also discarded");
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("", status.error_details());
+  EXPECT_EQ(Status(), status);
+}
+
+TEST(Status, Equality) {
+  Status const not_found(StatusCode::kNotFound, "NOT FOUND");
+  EXPECT_EQ(not_found, Status(StatusCode::kNotFound, "NOT FOUND"));
+  EXPECT_NE(not_found, Status(StatusCode::kNotFound, "other message"));
+  EXPECT_NE(not_found, Status(StatusCode::kUnavailable, "NOT FOUND"));
+  EXPECT_NE(not_found, Status(StatusCode::kNotFound, "NOT FOUND", "details"));
+  EXPECT_NE(not_found, Status());
+}
+
+TEST(Status, CopyAndMove) {
+  Status status(StatusCode::kUnavailable, "try-again");
+  Status copy(status);
+  EXPECT_EQ(status, copy);
+  EXPECT_EQ("try-again", copy.message());
+
+  Status moved(std::move(copy));
+  EXPECT_EQ(status, moved);
+  EXPECT_EQ("try-again", moved.message());
+}
+
 }  // namespace
 }  // namespace GOOGLE_CLOUD_CPP_NS
 }  // namespace cloud
@@ -0,0 +1,68 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/async_client.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+AsyncClientThreadPool::AsyncClientThreadPool(std::size_t thread_count) {
+  thread_count = (std::max<std::size_t>)(thread_count, 1);
+  threads_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    threads_.emplace_back([this] { Worker(); });
+  }
+}
+
+AsyncClientThreadPool::~AsyncClientThreadPool() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& t : threads_) t.join();
+}
+
+void AsyncClientThreadPool::Submit(std::function<void()> task) {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    queue_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void AsyncClientThreadPool::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !queue_.empty(); });
+    // Drain any queued work before shutting down, there may be futures
+    // blocked on these tasks.
+    if (queue_.empty()) return;
+    auto task = std::move(queue_.front());
+    queue_.pop_front();
+    lk.unlock();
+    task();
+    lk.lock();
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
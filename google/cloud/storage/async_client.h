@@ -0,0 +1,264 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_ASYNC_CLIENT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_ASYNC_CLIENT_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/internal/tuple.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A bounded pool of threads executing blocking storage operations.
+ *
+ * The pool size is fixed at construction time, so the number of threads (and
+ * thread stacks) is independent of the number of outstanding operations.
+ */
+class AsyncClientThreadPool {
+ public:
+  explicit AsyncClientThreadPool(std::size_t thread_count);
+  ~AsyncClientThreadPool();
+
+  AsyncClientThreadPool(AsyncClientThreadPool const&) = delete;
+  AsyncClientThreadPool& operator=(AsyncClientThreadPool const&) = delete;
+
+  void Submit(std::function<void()> task);
+
+ private:
+  void Worker();
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+  bool shutdown_ = false;
+  std::vector<std::thread> threads_;
+};
+
+struct AsyncInsertObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<ObjectMetadata> operator()(Options... options) {
+    return client.InsertObject(bucket_name, object_name, contents,
+                               std::move(options)...);
+  }
+
+  Client client;
+  std::string bucket_name;
+  std::string object_name;
+  std::string contents;
+};
+
+struct AsyncReadObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<std::string> operator()(Options... options) {
+    auto stream =
+        client.ReadObject(bucket_name, object_name, std::move(options)...);
+    std::string result(std::istreambuf_iterator<char>{stream}, {});
+    stream.Close();
+    if (!stream.status().ok()) return stream.status();
+    return result;
+  }
+
+  Client client;
+  std::string bucket_name;
+  std::string object_name;
+};
+
+struct AsyncGetObjectMetadataApplyHelper {
+  template <typename... Options>
+  StatusOr<ObjectMetadata> operator()(Options... options) {
+    return client.GetObjectMetadata(bucket_name, object_name,
+                                    std::move(options)...);
+  }
+
+  Client client;
+  std::string bucket_name;
+  std::string object_name;
+};
+
+struct AsyncGetBucketMetadataApplyHelper {
+  template <typename... Options>
+  StatusOr<BucketMetadata> operator()(Options... options) {
+    return client.GetBucketMetadata(bucket_name, std::move(options)...);
+  }
+
+  Client client;
+  std::string bucket_name;
+};
+
+struct AsyncDeleteObjectApplyHelper {
+  template <typename... Options>
+  Status operator()(Options... options) {
+    return client.DeleteObject(bucket_name, object_name, std::move(options)...);
+  }
+
+  Client client;
+  std::string bucket_name;
+  std::string object_name;
+};
+}  // namespace internal
+
+/**
+ * A non-blocking interface to Google Cloud Storage.
+ *
+ * The member functions of `storage::Client` block until the operation
+ * completes, so applications with many concurrent transfers need one thread
+ * per transfer. This class runs the same operations on a small, fixed pool of
+ * background threads and returns `google::cloud::future<>` objects, so the
+ * per-operation cost is a queued task instead of a dedicated thread and its
+ * stack.
+ *
+ * The futures are satisfied from the background threads, any continuations
+ * attached via `.then()` run in those threads too.
+ *
+ * @par Example
+ * @code
+ * namespace gcs = google::cloud::storage;
+ * gcs::AsyncClient client(gcs::Client(options));
+ * auto metadata = client.AsyncGetObjectMetadata("my-bucket", "my-object");
+ * // ... do other work ...
+ * std::cout << metadata.get().value() << "\n";
+ * @endcode
+ */
+class AsyncClient {
+ public:
+  /**
+   * Create an `AsyncClient` wrapping @p client.
+   *
+   * @param client the (blocking) client used to perform the operations.
+   * @param thread_count the number of background threads, which bounds the
+   *     number of operations in progress at a time.
+   */
+  explicit AsyncClient(Client client, std::size_t thread_count = 4)
+      : client_(std::move(client)),
+        pool_(std::make_shared<internal::AsyncClientThreadPool>(thread_count)) {
+  }
+
+  /**
+   * Create an object given its name and contents.
+   *
+   * @see `Client::InsertObject()` for the accepted options and the details of
+   *     the operation.
+   */
+  template <typename... Options>
+  future<StatusOr<ObjectMetadata>> AsyncInsertObject(std::string bucket_name,
+                                                     std::string object_name,
+                                                     std::string contents,
+                                                     Options... options) {
+    return Schedule(
+        internal::AsyncInsertObjectApplyHelper{
+            client_, std::move(bucket_name), std::move(object_name),
+            std::move(contents)},
+        std::move(options)...);
+  }
+
+  /**
+   * Read the full contents of an object.
+   *
+   * @see `Client::ReadObject()` for the accepted options. Applications that
+   *     need to stream (rather than accumulate) the object contents should
+   *     use `Client::ReadObject()` directly.
+   */
+  template <typename... Options>
+  future<StatusOr<std::string>> AsyncReadObject(std::string bucket_name,
+                                                std::string object_name,
+                                                Options... options) {
+    return Schedule(
+        internal::AsyncReadObjectApplyHelper{client_, std::move(bucket_name),
+                                             std::move(object_name)},
+        std::move(options)...);
+  }
+
+  /**
+   * Fetch the object metadata.
+   *
+   * @see `Client::GetObjectMetadata()` for the accepted options.
+   */
+  template <typename... Options>
+  future<StatusOr<ObjectMetadata>> AsyncGetObjectMetadata(
+      std::string bucket_name, std::string object_name, Options... options) {
+    return Schedule(
+        internal::AsyncGetObjectMetadataApplyHelper{
+            client_, std::move(bucket_name), std::move(object_name)},
+        std::move(options)...);
+  }
+
+  /**
+   * Fetch the bucket metadata.
+   *
+   * @see `Client::GetBucketMetadata()` for the accepted options.
+   */
+  template <typename... Options>
+  future<StatusOr<BucketMetadata>> AsyncGetBucketMetadata(
+      std::string bucket_name, Options... options) {
+    return Schedule(internal::AsyncGetBucketMetadataApplyHelper{
+                        client_, std::move(bucket_name)},
+                    std::move(options)...);
+  }
+
+  /**
+   * Delete an object.
+   *
+   * @see `Client::DeleteObject()` for the accepted options.
+   */
+  template <typename... Options>
+  future<Status> AsyncDeleteObject(std::string bucket_name,
+                                   std::string object_name,
+                                   Options... options) {
+    return Schedule(
+        internal::AsyncDeleteObjectApplyHelper{client_, std::move(bucket_name),
+                                               std::move(object_name)},
+        std::move(options)...);
+  }
+
+ private:
+  template <typename Helper, typename... Options>
+  future<typename std::result_of<Helper(Options...)>::type> Schedule(
+      Helper helper, Options... options) {
+    using Result = typename std::result_of<Helper(Options...)>::type;
+    auto helper_holder = std::make_shared<Helper>(std::move(helper));
+    auto args = std::make_shared<std::tuple<Options...>>(std::move(options)...);
+    auto done = std::make_shared<promise<Result>>();
+    pool_->Submit([helper_holder, args, done] {
+      done->set_value(google::cloud::internal::apply(
+          std::move(*helper_holder), std::move(*args)));
+    });
+    return done->get_future();
+  }
+
+  Client client_;
+  std::shared_ptr<internal::AsyncClientThreadPool> pool_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_ASYNC_CLIENT_H
@@ -0,0 +1,180 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/async_client.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+class AsyncClientTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock_ = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock_, client_options())
+        .WillRepeatedly(ReturnRef(client_options_));
+    client_.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock_),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client_.reset();
+    raw_client_mock_.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock_;
+  std::unique_ptr<Client> client_;
+  ClientOptions client_options_ =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+ObjectMetadata MockObject(std::string const& object_name) {
+  return internal::ObjectMetadataParser::FromString(
+             R"""({"name": ")""" + object_name +
+             R"""(", "kind": "storage#object"})""")
+      .value();
+}
+
+TEST_F(AsyncClientTest, GetObjectMetadata) {
+  EXPECT_CALL(*raw_client_mock_, GetObjectMetadata(_))
+      .WillOnce([](internal::GetObjectMetadataRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        EXPECT_TRUE(request.HasOption<Generation>());
+        return make_status_or(MockObject("test-object"));
+      });
+
+  AsyncClient client(*client_, /*thread_count=*/2);
+  auto actual =
+      client.AsyncGetObjectMetadata("test-bucket", "test-object", Generation(7))
+          .get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("test-object", actual->name());
+}
+
+TEST_F(AsyncClientTest, InsertObject) {
+  EXPECT_CALL(*raw_client_mock_, InsertObjectMedia(_))
+      .WillOnce([](internal::InsertObjectMediaRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        EXPECT_EQ("test-contents", request.contents());
+        return make_status_or(MockObject("test-object"));
+      });
+
+  AsyncClient client(*client_);
+  auto actual =
+      client.AsyncInsertObject("test-bucket", "test-object", "test-contents")
+          .get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("test-object", actual->name());
+}
+
+TEST_F(AsyncClientTest, ReadObject) {
+  std::string const contents = "object contents";
+  EXPECT_CALL(*raw_client_mock_, ReadObject(_))
+      .WillOnce([&](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        auto source = absl::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, IsOpen())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*source, Read(_, _))
+            .WillOnce([contents](char* buf, std::size_t n) {
+              EXPECT_GE(n, contents.size());
+              std::memcpy(buf, contents.data(), contents.size());
+              return internal::ReadSourceResult{contents.size(), {}};
+            })
+            .WillOnce(Return(internal::ReadSourceResult{0, {}}));
+        EXPECT_CALL(*source, Close())
+            .WillRepeatedly(
+                Return(make_status_or(internal::HttpResponse{200, {}, {}})));
+        return StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
+            std::move(source));
+      });
+
+  AsyncClient client(*client_);
+  auto actual = client.AsyncReadObject("test-bucket", "test-object").get();
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(contents, *actual);
+}
+
+TEST_F(AsyncClientTest, DeleteObject) {
+  EXPECT_CALL(*raw_client_mock_, DeleteObject(_))
+      .WillOnce([](internal::DeleteObjectRequest const& request) {
+        EXPECT_EQ("test-bucket", request.bucket_name());
+        EXPECT_EQ("test-object", request.object_name());
+        return make_status_or(internal::EmptyResponse{});
+      });
+
+  AsyncClient client(*client_);
+  auto status = client.AsyncDeleteObject("test-bucket", "test-object").get();
+  EXPECT_STATUS_OK(status);
+}
+
+TEST_F(AsyncClientTest, ErrorsArePropagated) {
+  EXPECT_CALL(*raw_client_mock_, GetBucketMetadata(_))
+      .WillOnce(Return(StatusOr<BucketMetadata>(PermanentError())));
+
+  AsyncClient client(*client_);
+  auto actual = client.AsyncGetBucketMetadata("test-bucket").get();
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+TEST_F(AsyncClientTest, OperationsOverlap) {
+  std::mutex mu;
+  std::condition_variable cv;
+  int count = 0;
+  EXPECT_CALL(*raw_client_mock_, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly([&](internal::GetObjectMetadataRequest const&) {
+        // Block until both operations are in flight, this deadlocks (and the
+        // test times out) unless the operations run concurrently.
+        std::unique_lock<std::mutex> lk(mu);
+        ++count;
+        cv.notify_all();
+        cv.wait(lk, [&] { return count == 2; });
+        return make_status_or(ObjectMetadata{});
+      });
+
+  AsyncClient client(*client_, /*thread_count=*/2);
+  auto f1 = client.AsyncGetObjectMetadata("test-bucket", "o1");
+  auto f2 = client.AsyncGetObjectMetadata("test-bucket", "o2");
+  EXPECT_STATUS_OK(f1.get());
+  EXPECT_STATUS_OK(f2.get());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
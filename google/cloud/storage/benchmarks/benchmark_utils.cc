@@ -239,6 +239,46 @@ bool SimpleTimer::SupportPerThreadUsage() {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_RUSAGE_THREAD
 }
 
+void LatencyHistogram::Record(std::chrono::microseconds latency) {
+  auto const index = BucketIndex(latency.count());
+  if (index >= buckets_.size()) buckets_.resize(index + 1);
+  ++buckets_[index];
+  ++count_;
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(
+    double percentile) const {
+  if (count_ == 0) return std::chrono::microseconds(0);
+  if (percentile < 0) percentile = 0;
+  if (percentile > 100) percentile = 100;
+  auto target = static_cast<std::int64_t>(percentile / 100.0 *
+                                          static_cast<double>(count_));
+  if (target < 1) target = 1;
+  std::int64_t seen = 0;
+  for (std::size_t i = 0; i != buckets_.size(); ++i) {
+    seen += buckets_[i];
+    if (seen >= target) return std::chrono::microseconds(BucketUpperBound(i));
+  }
+  return std::chrono::microseconds(BucketUpperBound(buckets_.size() - 1));
+}
+
+std::size_t LatencyHistogram::BucketIndex(std::int64_t value) {
+  if (value < 0) value = 0;
+  // Find the smallest shift such that (value >> shift) < 32. Values below 32
+  // are recorded exactly, larger values are recorded with 16 sub-buckets per
+  // power of two.
+  std::size_t shift = 0;
+  while ((value >> shift) >= 32) ++shift;
+  return 16 * shift + static_cast<std::size_t>(value >> shift);
+}
+
+std::int64_t LatencyHistogram::BucketUpperBound(std::size_t index) {
+  if (index < 32) return static_cast<std::int64_t>(index);
+  auto const shift = index / 16 - 1;
+  auto const sub_bucket = static_cast<std::int64_t>(index - 16 * shift);
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
 std::string FormatSize(std::uintmax_t size) {
   struct {
     std::uintmax_t limit;
@@ -318,6 +358,8 @@ char const* ToString(ApiName api) {
       return "XML";
     case ApiName::kApiGrpc:
       return "GRPC";
+    case ApiName::kApiHybrid:
+      return "HYBRID";
     case ApiName::kApiRawJson:
       return "JSON-RAW";
     case ApiName::kApiRawXml:
@@ -328,6 +370,22 @@ char const* ToString(ApiName api) {
   return "";
 }
 
+char const* TransportName(ApiName api) {
+  switch (api) {
+    case ApiName::kApiJson:
+    case ApiName::kApiXml:
+    case ApiName::kApiRawJson:
+    case ApiName::kApiRawXml:
+      return "libcurl";
+    case ApiName::kApiGrpc:
+    case ApiName::kApiRawGrpc:
+      return "grpc";
+    case ApiName::kApiHybrid:
+      return "grpc+libcurl";
+  }
+  return "";
+}
+
 }  // namespace storage_benchmarks
 }  // namespace cloud
 }  // namespace google
@@ -20,9 +20,11 @@
 #include "google/cloud/internal/random.h"
 #include "absl/types/optional.h"
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <sstream>
 #include <string>
+#include <vector>
 #if GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
 #include <sys/resource.h>
 #endif  // GOOGLE_CLOUD_CPP_HAVE_GETRUSAGE
@@ -114,23 +116,65 @@ class SimpleTimer {
   std::string annotations_;
 };
 
+/**
+ * An HDR-style histogram of latency samples.
+ *
+ * The histogram uses power-of-two buckets, each split into 16 linear
+ * sub-buckets, so any recorded value is off by at most ~6% regardless of its
+ * magnitude, and recording a sample is O(1) with no allocations in the steady
+ * state. This is good enough to report latency percentiles without keeping
+ * every sample in memory.
+ */
+class LatencyHistogram {
+ public:
+  LatencyHistogram() = default;
+
+  /// Record one sample, negative values are recorded as zero.
+  void Record(std::chrono::microseconds latency);
+
+  /// The number of samples recorded.
+  std::int64_t count() const { return count_; }
+
+  /**
+   * An upper bound for the given percentile of the recorded samples.
+   *
+   * @param percentile the desired percentile in the [0, 100] range.
+   * @return the upper bound of the bucket containing the requested
+   *     percentile, or zero if no samples have been recorded.
+   */
+  std::chrono::microseconds Percentile(double percentile) const;
+
+ private:
+  static std::size_t BucketIndex(std::int64_t value);
+  static std::int64_t BucketUpperBound(std::size_t index);
+
+  std::vector<std::int64_t> buckets_;
+  std::int64_t count_ = 0;
+};
+
 std::string FormatSize(std::uintmax_t size);
 
 void DeleteAllObjects(google::cloud::storage::Client client,
                       std::string const& bucket_name, int thread_count);
 
 // Technically gRPC is not a different API, just the JSON API over a different
-// protocol, but it is easier to represent it as such in the benchmark.
+// protocol, but it is easier to represent it as such in the benchmark. The
+// "hybrid" arm uses gRPC for media and JSON over libcurl for metadata, so the
+// transports can be compared in a single interleaved run.
 enum class ApiName {
   kApiJson,
   kApiXml,
   kApiGrpc,
+  kApiHybrid,
   kApiRawJson,
   kApiRawXml,
   kApiRawGrpc,
 };
 char const* ToString(ApiName api);
 
+/// The transport(s) behind @p api, to group results by transport.
+char const* TransportName(ApiName api);
+
 }  // namespace storage_benchmarks
 }  // namespace cloud
 }  // namespace google
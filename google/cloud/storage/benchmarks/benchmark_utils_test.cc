@@ -32,6 +32,50 @@ TEST(FormatSize, Basic) {
   EXPECT_EQ("2.0TiB", FormatSize(2 * kTiB));
 }
 
+TEST(LatencyHistogram, Empty) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.Percentile(50).count());
+  EXPECT_EQ(0, histogram.Percentile(99).count());
+}
+
+TEST(LatencyHistogram, SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  for (int i = 1; i != 11; ++i) {
+    histogram.Record(std::chrono::microseconds(i));
+  }
+  EXPECT_EQ(10, histogram.count());
+  EXPECT_EQ(1, histogram.Percentile(0).count());
+  EXPECT_EQ(5, histogram.Percentile(50).count());
+  EXPECT_EQ(9, histogram.Percentile(90).count());
+  EXPECT_EQ(10, histogram.Percentile(100).count());
+}
+
+TEST(LatencyHistogram, BoundedRelativeError) {
+  LatencyHistogram histogram;
+  for (std::int64_t value : {123, 4567, 89012, 3456789, 98765432}) {
+    histogram.Record(std::chrono::microseconds(value));
+    auto const p100 = histogram.Percentile(100).count();
+    EXPECT_LE(value, p100);
+    EXPECT_LE(p100, value + value / 8);
+  }
+}
+
+TEST(LatencyHistogram, PercentilesAreMonotonic) {
+  auto generator = google::cloud::internal::DefaultPRNG(std::random_device{}());
+  std::uniform_int_distribution<std::int64_t> values(0, 10000000);
+  LatencyHistogram histogram;
+  for (int i = 0; i != 1000; ++i) {
+    histogram.Record(std::chrono::microseconds(values(generator)));
+  }
+  auto previous = histogram.Percentile(0);
+  for (double p : {10.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+    auto const current = histogram.Percentile(p);
+    EXPECT_LE(previous.count(), current.count()) << "percentile=" << p;
+    previous = current;
+  }
+}
+
 }  // namespace
 }  // namespace storage_benchmarks
 }  // namespace cloud
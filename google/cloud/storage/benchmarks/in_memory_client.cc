@@ -0,0 +1,545 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/in_memory_client.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace gcs = google::cloud::storage;
+
+namespace {
+
+/// A download stream over an in-memory buffer.
+class InMemoryObjectReadSource : public gcs::internal::ObjectReadSource {
+ public:
+  InMemoryObjectReadSource(std::string contents, std::int64_t generation)
+      : contents_(std::move(contents)), generation_(generation) {}
+
+  bool IsOpen() const override { return open_; }
+
+  StatusOr<gcs::internal::HttpResponse> Close() override {
+    open_ = false;
+    return gcs::internal::HttpResponse{200, {}, {}};
+  }
+
+  StatusOr<gcs::internal::ReadSourceResult> Read(char* buf,
+                                                 std::size_t n) override {
+    n = (std::min)(n, contents_.size() - offset_);
+    std::memcpy(buf, contents_.data() + offset_, n);
+    offset_ += n;
+    auto const done = offset_ == contents_.size();
+    gcs::internal::ReadSourceResult result{
+        n, gcs::internal::HttpResponse{done ? 200 : 100, {}, {}}};
+    result.response.headers.emplace("x-goog-generation",
+                                    std::to_string(generation_));
+    if (done) open_ = false;
+    return result;
+  }
+
+ private:
+  std::string contents_;
+  std::int64_t generation_;
+  std::size_t offset_ = 0;
+  bool open_ = true;
+};
+
+}  // namespace
+
+/// An in-memory resumable upload session.
+class InMemorySession : public gcs::internal::ResumableUploadSession {
+ public:
+  InMemorySession(std::shared_ptr<InMemoryClient> client,
+                  std::shared_ptr<InMemoryClient::SessionState> state)
+      : client_(std::move(client)),
+        state_(std::move(state)),
+        last_response_(InProgress()) {}
+
+  StatusOr<gcs::internal::ResumableUploadResponse> UploadChunk(
+      gcs::internal::ConstBufferSequence const& buffers) override {
+    Append(buffers);
+    last_response_ = InProgress();
+    return last_response_;
+  }
+
+  StatusOr<gcs::internal::ResumableUploadResponse> UploadFinalChunk(
+      gcs::internal::ConstBufferSequence const& buffers,
+      std::uint64_t /*upload_size*/) override {
+    Append(buffers);
+    auto metadata = client_->DoInsert(state_->bucket_name, state_->object_name,
+                                      state_->contents);
+    if (!metadata) {
+      last_response_ = std::move(metadata).status();
+      return last_response_;
+    }
+    done_ = true;
+    auto const size = state_->contents.size();
+    last_response_ = gcs::internal::ResumableUploadResponse{
+        state_->session_id, size == 0 ? 0 : size - 1, *std::move(metadata),
+        gcs::internal::ResumableUploadResponse::kDone, {}};
+    return last_response_;
+  }
+
+  StatusOr<gcs::internal::ResumableUploadResponse> ResetSession() override {
+    last_response_ = InProgress();
+    return last_response_;
+  }
+
+  std::uint64_t next_expected_byte() const override {
+    return state_->contents.size();
+  }
+
+  std::string const& session_id() const override {
+    return state_->session_id;
+  }
+
+  bool done() const override { return done_; }
+
+  StatusOr<gcs::internal::ResumableUploadResponse> const& last_response()
+      const override {
+    return last_response_;
+  }
+
+ private:
+  void Append(gcs::internal::ConstBufferSequence const& buffers) {
+    for (auto const& b : buffers) {
+      state_->contents.append(b.data(), b.size());
+    }
+  }
+
+  gcs::internal::ResumableUploadResponse InProgress() const {
+    auto const size = state_->contents.size();
+    return gcs::internal::ResumableUploadResponse{
+        state_->session_id, size == 0 ? 0 : size - 1, {},
+        gcs::internal::ResumableUploadResponse::kInProgress, {}};
+  }
+
+  std::shared_ptr<InMemoryClient> client_;
+  std::shared_ptr<InMemoryClient::SessionState> state_;
+  bool done_ = false;
+  StatusOr<gcs::internal::ResumableUploadResponse> last_response_;
+};
+
+InMemoryClient::InMemoryClient(gcs::ClientOptions options)
+    : options_(std::move(options)) {}
+
+gcs::ClientOptions const& InMemoryClient::client_options() const {
+  return options_;
+}
+
+StatusOr<gcs::internal::ListBucketsResponse> InMemoryClient::ListBuckets(
+    gcs::internal::ListBucketsRequest const&) {
+  std::unique_lock<std::mutex> lk(mu_);
+  gcs::internal::ListBucketsResponse response;
+  for (auto const& kv : buckets_) response.items.push_back(kv.second);
+  return response;
+}
+
+StatusOr<gcs::BucketMetadata> InMemoryClient::CreateBucket(
+    gcs::internal::CreateBucketRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto metadata = request.metadata();
+  buckets_[metadata.name()] = metadata;
+  return metadata;
+}
+
+StatusOr<gcs::BucketMetadata> InMemoryClient::GetBucketMetadata(
+    gcs::internal::GetBucketMetadataRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto i = buckets_.find(request.bucket_name());
+  if (i == buckets_.end()) {
+    return Status(StatusCode::kNotFound,
+                  "bucket not found: " + request.bucket_name());
+  }
+  return i->second;
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteBucket(
+    gcs::internal::DeleteBucketRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (buckets_.erase(request.bucket_name()) == 0) {
+    return Status(StatusCode::kNotFound,
+                  "bucket not found: " + request.bucket_name());
+  }
+  objects_.erase(request.bucket_name());
+  return gcs::internal::EmptyResponse{};
+}
+
+StatusOr<gcs::BucketMetadata> InMemoryClient::UpdateBucket(
+    gcs::internal::UpdateBucketRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::BucketMetadata> InMemoryClient::PatchBucket(
+    gcs::internal::PatchBucketRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<google::cloud::IamPolicy> InMemoryClient::GetBucketIamPolicy(
+    gcs::internal::GetBucketIamPolicyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::NativeIamPolicy> InMemoryClient::GetNativeBucketIamPolicy(
+    gcs::internal::GetBucketIamPolicyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<google::cloud::IamPolicy> InMemoryClient::SetBucketIamPolicy(
+    gcs::internal::SetBucketIamPolicyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::NativeIamPolicy> InMemoryClient::SetNativeBucketIamPolicy(
+    gcs::internal::SetNativeBucketIamPolicyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::TestBucketIamPermissionsResponse>
+InMemoryClient::TestBucketIamPermissions(
+    gcs::internal::TestBucketIamPermissionsRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::BucketMetadata> InMemoryClient::LockBucketRetentionPolicy(
+    gcs::internal::LockBucketRetentionPolicyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::DoInsert(
+    std::string const& bucket_name, std::string const& object_name,
+    std::string contents) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const generation = ++generation_;
+  nlohmann::json json{
+      {"kind", "storage#object"},
+      {"bucket", bucket_name},
+      {"name", object_name},
+      {"id", bucket_name + "/" + object_name + "/" + std::to_string(generation)},
+      {"generation", std::to_string(generation)},
+      {"size", contents.size()},
+  };
+  auto metadata = gcs::internal::ObjectMetadataParser::FromJson(json);
+  if (!metadata) return std::move(metadata).status();
+  auto& entry = objects_[bucket_name][object_name];
+  entry.metadata = *metadata;
+  entry.contents = std::move(contents);
+  return *std::move(metadata);
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::InsertObjectMedia(
+    gcs::internal::InsertObjectMediaRequest const& request) {
+  return DoInsert(request.bucket_name(), request.object_name(),
+                  request.contents());
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::CopyObject(
+    gcs::internal::CopyObjectRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::GetObjectMetadata(
+    gcs::internal::GetObjectMetadataRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto b = objects_.find(request.bucket_name());
+  if (b != objects_.end()) {
+    auto o = b->second.find(request.object_name());
+    if (o != b->second.end()) return o->second.metadata;
+  }
+  return Status(StatusCode::kNotFound,
+                "object not found: " + request.object_name());
+}
+
+StatusOr<std::unique_ptr<gcs::internal::ObjectReadSource>>
+InMemoryClient::ReadObject(
+    gcs::internal::ReadObjectRangeRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto b = objects_.find(request.bucket_name());
+  if (b == objects_.end()) {
+    return Status(StatusCode::kNotFound,
+                  "bucket not found: " + request.bucket_name());
+  }
+  auto o = b->second.find(request.object_name());
+  if (o == b->second.end()) {
+    return Status(StatusCode::kNotFound,
+                  "object not found: " + request.object_name());
+  }
+  auto const& contents = o->second.contents;
+  auto const size = static_cast<std::int64_t>(contents.size());
+  std::int64_t begin = 0;
+  std::int64_t end = size;
+  if (request.HasOption<gcs::ReadRange>()) {
+    auto const range = request.GetOption<gcs::ReadRange>().value();
+    begin = (std::max)(begin, range.begin);
+    end = (std::min)(end, range.end);
+  }
+  if (request.HasOption<gcs::ReadFromOffset>()) {
+    begin = (std::max)(begin, request.GetOption<gcs::ReadFromOffset>().value());
+  }
+  if (request.HasOption<gcs::ReadLast>()) {
+    begin = (std::max<std::int64_t>)(
+        0, size - request.GetOption<gcs::ReadLast>().value());
+    end = size;
+  }
+  begin = (std::min)(begin, end);
+  return std::unique_ptr<gcs::internal::ObjectReadSource>(
+      new InMemoryObjectReadSource(
+          contents.substr(begin, end - begin),
+          o->second.metadata.generation()));
+}
+
+StatusOr<gcs::internal::ListObjectsResponse> InMemoryClient::ListObjects(
+    gcs::internal::ListObjectsRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  gcs::internal::ListObjectsResponse response;
+  auto b = objects_.find(request.bucket_name());
+  if (b == objects_.end()) return response;
+  for (auto const& kv : b->second) {
+    response.items.push_back(kv.second.metadata);
+  }
+  return response;
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteObject(
+    gcs::internal::DeleteObjectRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  auto b = objects_.find(request.bucket_name());
+  if (b == objects_.end() || b->second.erase(request.object_name()) == 0) {
+    return Status(StatusCode::kNotFound,
+                  "object not found: " + request.object_name());
+  }
+  return gcs::internal::EmptyResponse{};
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::UpdateObject(
+    gcs::internal::UpdateObjectRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::PatchObject(
+    gcs::internal::PatchObjectRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectMetadata> InMemoryClient::ComposeObject(
+    gcs::internal::ComposeObjectRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::RewriteObjectResponse> InMemoryClient::RewriteObject(
+    gcs::internal::RewriteObjectRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<std::unique_ptr<gcs::internal::ResumableUploadSession>>
+InMemoryClient::CreateResumableSession(
+    gcs::internal::ResumableUploadRequest const& request) {
+  auto state = std::make_shared<SessionState>();
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    state->session_id = "in-memory-session-" + std::to_string(++session_counter_);
+    state->bucket_name = request.bucket_name();
+    state->object_name = request.object_name();
+    sessions_[state->session_id] = state;
+  }
+  return std::unique_ptr<gcs::internal::ResumableUploadSession>(
+      new InMemorySession(shared_from_this(), std::move(state)));
+}
+
+StatusOr<std::unique_ptr<gcs::internal::ResumableUploadSession>>
+InMemoryClient::RestoreResumableSession(std::string const& session_id) {
+  std::shared_ptr<SessionState> state;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    auto i = sessions_.find(session_id);
+    if (i == sessions_.end()) {
+      return Status(StatusCode::kNotFound, "session not found: " + session_id);
+    }
+    state = i->second;
+  }
+  return std::unique_ptr<gcs::internal::ResumableUploadSession>(
+      new InMemorySession(shared_from_this(), std::move(state)));
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteResumableUpload(
+    gcs::internal::DeleteResumableUploadRequest const& request) {
+  std::unique_lock<std::mutex> lk(mu_);
+  if (sessions_.erase(request.upload_session_url()) == 0) {
+    return Status(StatusCode::kNotFound,
+                  "session not found: " + request.upload_session_url());
+  }
+  return gcs::internal::EmptyResponse{};
+}
+
+StatusOr<gcs::internal::ListBucketAclResponse> InMemoryClient::ListBucketAcl(
+    gcs::internal::ListBucketAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::BucketAccessControl> InMemoryClient::CreateBucketAcl(
+    gcs::internal::CreateBucketAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteBucketAcl(
+    gcs::internal::DeleteBucketAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::BucketAccessControl> InMemoryClient::GetBucketAcl(
+    gcs::internal::GetBucketAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::BucketAccessControl> InMemoryClient::UpdateBucketAcl(
+    gcs::internal::UpdateBucketAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::BucketAccessControl> InMemoryClient::PatchBucketAcl(
+    gcs::internal::PatchBucketAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::ListObjectAclResponse> InMemoryClient::ListObjectAcl(
+    gcs::internal::ListObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::CreateObjectAcl(
+    gcs::internal::CreateObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteObjectAcl(
+    gcs::internal::DeleteObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::GetObjectAcl(
+    gcs::internal::GetObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::UpdateObjectAcl(
+    gcs::internal::UpdateObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::PatchObjectAcl(
+    gcs::internal::PatchObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::ListDefaultObjectAclResponse>
+InMemoryClient::ListDefaultObjectAcl(
+    gcs::internal::ListDefaultObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::CreateDefaultObjectAcl(
+    gcs::internal::CreateDefaultObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteDefaultObjectAcl(
+    gcs::internal::DeleteDefaultObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::GetDefaultObjectAcl(
+    gcs::internal::GetDefaultObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::UpdateDefaultObjectAcl(
+    gcs::internal::UpdateDefaultObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ObjectAccessControl> InMemoryClient::PatchDefaultObjectAcl(
+    gcs::internal::PatchDefaultObjectAclRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::ServiceAccount> InMemoryClient::GetServiceAccount(
+    gcs::internal::GetProjectServiceAccountRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::ListHmacKeysResponse> InMemoryClient::ListHmacKeys(
+    gcs::internal::ListHmacKeysRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::CreateHmacKeyResponse> InMemoryClient::CreateHmacKey(
+    gcs::internal::CreateHmacKeyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteHmacKey(
+    gcs::internal::DeleteHmacKeyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::HmacKeyMetadata> InMemoryClient::GetHmacKey(
+    gcs::internal::GetHmacKeyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::HmacKeyMetadata> InMemoryClient::UpdateHmacKey(
+    gcs::internal::UpdateHmacKeyRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::SignBlobResponse> InMemoryClient::SignBlob(
+    gcs::internal::SignBlobRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::ListNotificationsResponse>
+InMemoryClient::ListNotifications(
+    gcs::internal::ListNotificationsRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::NotificationMetadata> InMemoryClient::CreateNotification(
+    gcs::internal::CreateNotificationRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::NotificationMetadata> InMemoryClient::GetNotification(
+    gcs::internal::GetNotificationRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+StatusOr<gcs::internal::EmptyResponse> InMemoryClient::DeleteNotification(
+    gcs::internal::DeleteNotificationRequest const&) {
+  return Status(StatusCode::kUnimplemented, __func__);
+}
+
+gcs::Client MakeInMemoryClient() {
+  auto client = std::make_shared<InMemoryClient>(
+      gcs::ClientOptions(gcs::oauth2::CreateAnonymousCredentials()));
+  return gcs::Client(std::move(client));
+}
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,115 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/in_memory_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace {
+
+namespace gcs = google::cloud::storage;
+using ::testing::ElementsAre;
+
+TEST(InMemoryClientTest, InsertAndRead) {
+  auto client = MakeInMemoryClient();
+
+  auto metadata = client.InsertObject("test-bucket", "test-object",
+                                      "The quick brown fox");
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ("test-bucket", metadata->bucket());
+  EXPECT_EQ("test-object", metadata->name());
+  EXPECT_EQ(19, metadata->size());
+
+  auto stream = client.ReadObject("test-bucket", "test-object");
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  EXPECT_STATUS_OK(stream.status());
+  EXPECT_EQ("The quick brown fox", actual);
+}
+
+TEST(InMemoryClientTest, ReadRange) {
+  auto client = MakeInMemoryClient();
+
+  auto metadata =
+      client.InsertObject("test-bucket", "test-object", "0123456789");
+  ASSERT_STATUS_OK(metadata);
+
+  auto stream =
+      client.ReadObject("test-bucket", "test-object", gcs::ReadRange(2, 6));
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  EXPECT_STATUS_OK(stream.status());
+  EXPECT_EQ("2345", actual);
+}
+
+TEST(InMemoryClientTest, ResumableUpload) {
+  auto client = MakeInMemoryClient();
+
+  auto os = client.WriteObject("test-bucket", "test-object");
+  os << "The quick brown fox";
+  os.Close();
+  ASSERT_STATUS_OK(os.metadata());
+  EXPECT_EQ(19, os.metadata()->size());
+
+  auto stream = client.ReadObject("test-bucket", "test-object");
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  EXPECT_EQ("The quick brown fox", actual);
+}
+
+TEST(InMemoryClientTest, ListAndDelete) {
+  auto client = MakeInMemoryClient();
+
+  ASSERT_STATUS_OK(client.InsertObject("test-bucket", "object-a", "a"));
+  ASSERT_STATUS_OK(client.InsertObject("test-bucket", "object-b", "b"));
+
+  std::vector<std::string> names;
+  for (auto const& o : client.ListObjects("test-bucket")) {
+    ASSERT_STATUS_OK(o);
+    names.push_back(o->name());
+  }
+  EXPECT_THAT(names, ElementsAre("object-a", "object-b"));
+
+  ASSERT_STATUS_OK(client.DeleteObject("test-bucket", "object-a"));
+  auto metadata = client.GetObjectMetadata("test-bucket", "object-a");
+  EXPECT_EQ(StatusCode::kNotFound, metadata.status().code());
+}
+
+TEST(InMemoryClientTest, Buckets) {
+  auto client = MakeInMemoryClient();
+
+  auto bucket = client.CreateBucketForProject("test-bucket", "test-project",
+                                              gcs::BucketMetadata{});
+  ASSERT_STATUS_OK(bucket);
+  EXPECT_EQ("test-bucket", bucket->name());
+
+  auto get = client.GetBucketMetadata("test-bucket");
+  ASSERT_STATUS_OK(get);
+
+  ASSERT_STATUS_OK(client.DeleteBucket("test-bucket"));
+  get = client.GetBucketMetadata("test-bucket");
+  EXPECT_EQ(StatusCode::kNotFound, get.status().code());
+}
+
+TEST(InMemoryClientTest, UnimplementedOperations) {
+  auto client = MakeInMemoryClient();
+
+  auto account = client.GetServiceAccountForProject("test-project");
+  EXPECT_EQ(StatusCode::kUnimplemented, account.status().code());
+}
+
+}  // namespace
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,205 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/bucket_requests.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// Parsing JSON metadata dominates the CPU cost of listing workloads, these
+// benchmarks detect regressions in the parsers before a release. The payloads
+// mimic what the JSON API returns: `SmallObject()` is a response with only the
+// always-present fields, `LargeObject()` adds ACLs, custom metadata, and the
+// optional fields, and the list benchmark parses a full page of results.
+
+std::string SmallObject(std::string const& name) {
+  return std::string{R"""({
+      "bucket": "test-bucket",
+      "etag": "XYZ=",
+      "generation": "2384748",
+      "id": "test-bucket/)"""} +
+         name + R"""(/2384748",
+      "kind": "storage#object",
+      "md5Hash": "xa1b2c3==",
+      "metageneration": "4",
+      "name": ")""" +
+         name + R"""(",
+      "selfLink": "https://storage.googleapis.com/storage/v1/b/test-bucket/o/)""" +
+         name + R"""(",
+      "size": 102400,
+      "storageClass": "STANDARD",
+      "timeCreated": "2018-05-19T19:31:14Z",
+      "updated": "2018-05-19T19:31:24Z"
+})""";
+}
+
+std::string LargeObject(std::string const& name) {
+  return std::string{R"""({
+      "acl": [
+        {"kind": "storage#objectAccessControl", "id": "acl-id-0",
+         "entity": "user-test-user-1", "role": "OWNER"},
+        {"kind": "storage#objectAccessControl", "id": "acl-id-1",
+         "entity": "user-test-user-2", "role": "READER"},
+        {"kind": "storage#objectAccessControl", "id": "acl-id-2",
+         "entity": "user-test-user-3", "role": "READER"},
+        {"kind": "storage#objectAccessControl", "id": "acl-id-3",
+         "entity": "project-viewers-123456789", "role": "READER"}
+      ],
+      "bucket": "test-bucket",
+      "cacheControl": "no-cache",
+      "contentDisposition": "attachment; filename=test.txt",
+      "contentEncoding": "identity",
+      "contentLanguage": "en",
+      "contentType": "application/octet-stream",
+      "crc32c": "deadbeef",
+      "customerEncryption": {
+        "encryptionAlgorithm": "AES256",
+        "keySha256": "abc123"
+      },
+      "etag": "XYZ=",
+      "eventBasedHold": true,
+      "generation": "2384748",
+      "id": "test-bucket/)"""} +
+         name + R"""(/2384748",
+      "kind": "storage#object",
+      "kmsKeyName": "/project-test/us-central1/test-ring/test-key",
+      "md5Hash": "xa1b2c3==",
+      "mediaLink": "https://storage.googleapis.com/test-bucket/)""" +
+         name + R"""(?generation=2384748",
+      "metadata": {
+        "label-0": "value-0",
+        "label-1": "value-1",
+        "label-2": "value-2",
+        "label-3": "value-3",
+        "application": "benchmark",
+        "fingerprint": "0123456789abcdef"
+      },
+      "metageneration": "4",
+      "name": ")""" +
+         name + R"""(",
+      "selfLink": "https://storage.googleapis.com/storage/v1/b/test-bucket/o/)""" +
+         name + R"""(",
+      "size": 102400,
+      "storageClass": "STANDARD",
+      "temporaryHold": true,
+      "timeCreated": "2018-05-19T19:31:14Z",
+      "timeStorageClassUpdated": "2018-05-19T19:31:34Z",
+      "updated": "2018-05-19T19:31:24Z"
+})""";
+}
+
+std::string LargeBucket() {
+  return R"""({
+      "acl": [
+        {"kind": "storage#bucketAccessControl", "id": "acl-id-0",
+         "entity": "user-test-user-1", "role": "OWNER"},
+        {"kind": "storage#bucketAccessControl", "id": "acl-id-1",
+         "entity": "user-test-user-2", "role": "READER"}
+      ],
+      "cors": [
+        {"maxAgeSeconds": 3600, "method": ["GET", "HEAD"],
+         "origin": ["*"], "responseHeader": ["Content-Type"]}
+      ],
+      "defaultEventBasedHold": true,
+      "etag": "XYZ=",
+      "id": "test-bucket",
+      "kind": "storage#bucket",
+      "labels": {
+        "label-key-1": "label-value-1",
+        "label-key-2": "label-value-2"
+      },
+      "lifecycle": {
+        "rule": [
+          {"condition": {"age": 30}, "action": {"type": "Delete"}}
+        ]
+      },
+      "location": "US",
+      "locationType": "multi-region",
+      "metageneration": "4",
+      "name": "test-bucket",
+      "projectNumber": "123456789",
+      "selfLink": "https://storage.googleapis.com/storage/v1/b/test-bucket",
+      "storageClass": "STANDARD",
+      "timeCreated": "2018-05-19T19:31:14Z",
+      "updated": "2018-05-19T19:31:24Z",
+      "versioning": {"enabled": true}
+})""";
+}
+
+std::string ListObjectsPage(int object_count) {
+  std::string page = R"""({
+      "kind": "storage#objects",
+      "nextPageToken": "some-page-token",
+      "items": [)""";
+  char const* sep = "";
+  for (int i = 0; i != object_count; ++i) {
+    page += sep;
+    page += LargeObject("test-object-" + std::to_string(i));
+    sep = ",";
+  }
+  page += "]}";
+  return page;
+}
+
+void BM_ObjectMetadataParseSmall(benchmark::State& state) {
+  auto const payload = SmallObject("test-object");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ObjectMetadataParser::FromString(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_ObjectMetadataParseSmall);
+
+void BM_ObjectMetadataParseLarge(benchmark::State& state) {
+  auto const payload = LargeObject("test-object");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ObjectMetadataParser::FromString(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_ObjectMetadataParseLarge);
+
+void BM_BucketMetadataParse(benchmark::State& state) {
+  auto const payload = LargeBucket();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BucketMetadataParser::FromString(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_BucketMetadataParse);
+
+// The JSON API returns up to 1,000 results per page, benchmark both a full
+// page and the smaller pages common in prefix-limited listings.
+void BM_ListObjectsResponseParse(benchmark::State& state) {
+  auto const payload = ListObjectsPage(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ListObjectsResponse::FromHttpResponse(payload));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_ListObjectsResponseParse)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
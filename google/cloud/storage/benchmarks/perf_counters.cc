@@ -0,0 +1,120 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/perf_counters.h"
+#include <cstring>
+#include <utility>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace {
+
+#ifdef __linux__
+int OpenCounter(std::uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  // The group leader is created disabled, the whole group is enabled and
+  // disabled together in `Start()` and `Stop()`.
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd,
+              /*flags=*/0));
+}
+#endif  // __linux__
+
+std::function<void()>& ProfilerStartHook() {
+  static std::function<void()> hook;
+  return hook;
+}
+
+std::function<void()>& ProfilerStopHook() {
+  static std::function<void()> hook;
+  return hook;
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+#ifdef __linux__
+  leader_fd_ = OpenCounter(PERF_COUNT_HW_INSTRUCTIONS, -1);
+  if (leader_fd_ == -1) return;
+  cache_fd_ = OpenCounter(PERF_COUNT_HW_CACHE_MISSES, leader_fd_);
+  if (cache_fd_ == -1) {
+    close(leader_fd_);
+    leader_fd_ = -1;
+  }
+#endif  // __linux__
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  if (cache_fd_ != -1) close(cache_fd_);
+  if (leader_fd_ != -1) close(leader_fd_);
+#endif  // __linux__
+}
+
+void PerfCounters::Start() {
+#ifdef __linux__
+  if (!available()) return;
+  ioctl(leader_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif  // __linux__
+}
+
+void PerfCounters::Stop() {
+#ifdef __linux__
+  if (!available()) return;
+  ioctl(leader_fd_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  // With PERF_FORMAT_GROUP a single read() returns the number of counters
+  // followed by one value per counter, in the order they were opened.
+  std::uint64_t buffer[3] = {0, 0, 0};
+  auto const n = read(leader_fd_, buffer, sizeof(buffer));
+  if (n != static_cast<ssize_t>(sizeof(buffer)) || buffer[0] != 2) return;
+  instructions_ = static_cast<std::int64_t>(buffer[1]);
+  cache_misses_ = static_cast<std::int64_t>(buffer[2]);
+#endif  // __linux__
+}
+
+void SetTransferProfilerHooks(std::function<void()> on_start,
+                              std::function<void()> on_stop) {
+  ProfilerStartHook() = std::move(on_start);
+  ProfilerStopHook() = std::move(on_stop);
+}
+
+void StartTransferProfiler() {
+  auto const& hook = ProfilerStartHook();
+  if (hook) hook();
+}
+
+void StopTransferProfiler() {
+  auto const& hook = ProfilerStopHook();
+  if (hook) hook();
+}
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
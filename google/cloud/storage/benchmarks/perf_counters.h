@@ -0,0 +1,95 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_PERF_COUNTERS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_PERF_COUNTERS_H
+
+#include <cstdint>
+#include <functional>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+
+/**
+ * Capture hardware performance counters around a section of code.
+ *
+ * `SimpleTimer` reports wall and CPU time, but cannot attribute cycles: a
+ * regression in CPU time does not tell us whether we started executing more
+ * instructions or just missing the cache more often. This class captures the
+ * retired instruction and cache miss counts for the calling thread using
+ * `perf_event_open(2)`.
+ *
+ * The counters are best-effort. On platforms without `perf_event_open()`, or
+ * when the kernel restricts it (see `/proc/sys/kernel/perf_event_paranoid`),
+ * `available()` returns `false` and the measured values are zero. The
+ * benchmarks still run, they just produce zero-filled counter columns.
+ */
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(PerfCounters const&) = delete;
+  PerfCounters& operator=(PerfCounters const&) = delete;
+
+  /// Returns true if the hardware counters could be configured.
+  bool available() const { return leader_fd_ != -1; }
+
+  /// Start counting, call before the code being measured.
+  void Start();
+
+  /// Stop counting and capture the results, call after the code measured.
+  void Stop();
+
+  //@{
+  /**
+   * @name Measurement results.
+   *
+   * @note The values are only valid after calling Start() and Stop(), and are
+   *     zero when the counters are not `available()`.
+   */
+  std::int64_t instructions() const { return instructions_; }
+  std::int64_t cache_misses() const { return cache_misses_; }
+  //@}
+
+ private:
+  int leader_fd_ = -1;
+  int cache_fd_ = -1;
+  std::int64_t instructions_ = 0;
+  std::int64_t cache_misses_ = 0;
+};
+
+/**
+ * Register callbacks invoked around each transfer.
+ *
+ * The nightly runs use these hooks to start and stop an external CPU profiler
+ * so its samples cover exactly one transfer, without a manual `perf` session.
+ * Call this (if at all) before creating the experiment threads; the callbacks
+ * themselves may be invoked concurrently from multiple threads.
+ */
+void SetTransferProfilerHooks(std::function<void()> on_start,
+                              std::function<void()> on_stop);
+
+/// Invoke the registered transfer start hook, a no-op if none is registered.
+void StartTransferProfiler();
+
+/// Invoke the registered transfer stop hook, a no-op if none is registered.
+void StopTransferProfiler();
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_PERF_COUNTERS_H
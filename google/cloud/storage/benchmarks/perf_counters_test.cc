@@ -0,0 +1,71 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/perf_counters.h"
+#include <gmock/gmock.h>
+#include <numeric>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace {
+
+TEST(PerfCountersTest, CapturesOrDegradesGracefully) {
+  PerfCounters counters;
+  counters.Start();
+  // Do enough work that the instruction count cannot plausibly be zero.
+  std::vector<int> v(100000);
+  std::iota(v.begin(), v.end(), 0);
+  auto volatile sum = std::accumulate(v.begin(), v.end(), std::int64_t{0});
+  (void)sum;
+  counters.Stop();
+
+  if (counters.available()) {
+    EXPECT_GT(counters.instructions(), 0);
+    EXPECT_GE(counters.cache_misses(), 0);
+  } else {
+    // Not all platforms (or kernel configurations) support perf_event_open(),
+    // the counters must report zero rather than fail.
+    EXPECT_EQ(0, counters.instructions());
+    EXPECT_EQ(0, counters.cache_misses());
+  }
+}
+
+TEST(PerfCountersTest, ProfilerHooksInvoked) {
+  int start_count = 0;
+  int stop_count = 0;
+  SetTransferProfilerHooks([&start_count] { ++start_count; },
+                           [&stop_count] { ++stop_count; });
+  StartTransferProfiler();
+  StopTransferProfiler();
+  StartTransferProfiler();
+  StopTransferProfiler();
+  EXPECT_EQ(2, start_count);
+  EXPECT_EQ(2, stop_count);
+  // Clear the hooks, other tests should not observe them.
+  SetTransferProfilerHooks({}, {});
+}
+
+TEST(PerfCountersTest, ProfilerHooksOptional) {
+  SetTransferProfilerHooks({}, {});
+  // Without registered hooks these calls are no-ops, they must not crash.
+  StartTransferProfiler();
+  StopTransferProfiler();
+}
+
+}  // namespace
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
@@ -19,6 +19,8 @@
 storage_benchmarks_hdrs = [
     "benchmark_utils.h",
     "bounded_queue.h",
+    "in_memory_client.h",
+    "perf_counters.h",
     "throughput_experiment.h",
     "throughput_options.h",
     "throughput_result.h",
@@ -26,6 +28,8 @@ storage_benchmarks_hdrs = [
 
 storage_benchmarks_srcs = [
     "benchmark_utils.cc",
+    "in_memory_client.cc",
+    "perf_counters.cc",
     "throughput_experiment.cc",
     "throughput_options.cc",
     "throughput_result.cc",
@@ -21,6 +21,8 @@ storage_benchmarks_unit_tests = [
     "benchmark_parse_args_test.cc",
     "benchmark_parser_test.cc",
     "benchmark_utils_test.cc",
+    "in_memory_client_test.cc",
+    "perf_counters_test.cc",
     "throughput_options_test.cc",
     "throughput_result_test.cc",
 ]
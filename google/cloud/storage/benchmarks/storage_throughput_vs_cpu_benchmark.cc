@@ -21,6 +21,7 @@
 #include "google/cloud/internal/format_time_point.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/benchmark_result.h"
 // TODO(#4501) - fix by doing #include <absl/...>
 #include "google/cloud/internal/diagnostics_push.inc"
 #if _MSC_VER
@@ -31,6 +32,8 @@
 // TODO(#4501) - end
 #include "google/cloud/internal/diagnostics_pop.inc"
 #include <future>
+#include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 
@@ -113,6 +116,7 @@ using TestResults = std::vector<ThroughputResult>;
 TestResults RunThread(ThroughputOptions const& ThroughputOptions,
                       std::string const& bucket_name);
 void PrintResults(TestResults const& results);
+void PrintLatencySummary();
 
 google::cloud::StatusOr<ThroughputOptions> ParseArgs(int argc, char* argv[]);
 
@@ -220,6 +224,8 @@ int main(int argc, char* argv[]) {
     PrintResults(f.get());
   }
 
+  PrintLatencySummary();
+
   gcs_bm::DeleteAllObjects(client, bucket_name, options->thread_count);
   auto status = client.DeleteBucket(bucket_name);
   if (!status.ok()) {
@@ -233,7 +239,53 @@ int main(int argc, char* argv[]) {
 
 namespace {
 
+// The per-operation latency histograms. Guarded by a mutex because results
+// may be recorded from the test threads (when running with a single thread
+// the results are printed, and recorded, as soon as they are available).
+std::mutex latency_histograms_mu;
+std::map<gcs_bm::OpType, gcs_bm::LatencyHistogram> latency_histograms;
+// The raw per-transfer latencies, kept to emit the machine-readable
+// summary for the benchmark regression harness.
+std::map<gcs_bm::OpType, std::vector<double>> latency_samples;
+
+void UpdateLatencyHistograms(TestResults const& results) {
+  std::lock_guard<std::mutex> lk(latency_histograms_mu);
+  for (auto const& r : results) {
+    if (r.status != google::cloud::StatusCode::kOk) continue;
+    latency_histograms[r.op].Record(r.elapsed_time);
+    latency_samples[r.op].push_back(
+        static_cast<double>(r.elapsed_time.count()));
+  }
+}
+
+void PrintLatencySummary() {
+  std::lock_guard<std::mutex> lk(latency_histograms_mu);
+  for (auto const& kv : latency_histograms) {
+    auto const& histogram = kv.second;
+    std::cout << "# Latency " << gcs_bm::ToString(kv.first)
+              << ": p50=" << histogram.Percentile(50).count() << "us"
+              << " p90=" << histogram.Percentile(90).count() << "us"
+              << " p95=" << histogram.Percentile(95).count() << "us"
+              << " p99=" << histogram.Percentile(99).count() << "us"
+              << " p99.9=" << histogram.Percentile(99.9).count() << "us"
+              << " N=" << histogram.count() << "\n";
+  }
+  for (auto const& kv : latency_samples) {
+    google::cloud::testing_util::BenchmarkResult result;
+    result.benchmark = std::string("storage-throughput-vs-cpu/") +
+                       gcs_bm::ToString(kv.first) + "/Latency";
+    result.unit = "us";
+    result.environment = google::cloud::testing_util::BenchmarkEnvironment();
+    result.samples = kv.second;
+    std::cout << google::cloud::testing_util::FormatBenchmarkResultAsJson(
+                     result)
+              << "\n";
+  }
+  std::cout << std::flush;
+}
+
 void PrintResults(TestResults const& results) {
+  UpdateLatencyHistograms(results);
   for (auto const& r : results) {
     gcs_bm::PrintAsCsv(std::cout, r);
   }
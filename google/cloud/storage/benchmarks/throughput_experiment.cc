@@ -14,10 +14,11 @@
 
 #include "google/cloud/storage/benchmarks/throughput_experiment.h"
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/benchmarks/perf_counters.h"
 #include "google/cloud/storage/client.h"
-#include "google/cloud/storage/grpc_plugin.h"
 #if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
 #include "google/cloud/storage/internal/grpc_client.h"
+#include "google/cloud/storage/internal/hybrid_client.h"
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
 #include "google/cloud/grpc_error_delegate.h"
 #include "absl/memory/memory.h"
@@ -61,6 +62,9 @@ class UploadObject : public ThroughputExperiment {
     if (static_cast<std::size_t>(config.object_size) < random_data_.size() &&
         prefer_insert_) {
       SimpleTimer timer;
+      PerfCounters counters;
+      StartTransferProfiler();
+      counters.Start();
       timer.Start();
       std::string data =
           random_data_.substr(0, static_cast<std::size_t>(config.object_size));
@@ -69,18 +73,27 @@ class UploadObject : public ThroughputExperiment {
           gcs::DisableCrc32cChecksum(!config.enable_crc32c),
           gcs::DisableMD5Hash(!config.enable_md5), api_selector);
       timer.Stop();
-      return ThroughputResult{kOpInsert,
-                              config.object_size,
-                              config.app_buffer_size,
-                              config.lib_buffer_size,
-                              config.enable_crc32c,
-                              config.enable_md5,
-                              api_,
-                              timer.elapsed_time(),
-                              timer.cpu_time(),
-                              object_metadata.status().code()};
+      counters.Stop();
+      StopTransferProfiler();
+      return ThroughputResult{
+          kOpInsert,
+          config.object_size,
+          config.app_buffer_size,
+          config.lib_buffer_size,
+          config.enable_crc32c,
+          config.enable_md5,
+          api_,
+          timer.elapsed_time(),
+          timer.cpu_time(),
+          object_metadata.status().code(),
+          ThroughputPhaseTimings{},
+          ThroughputHardwareCounters{counters.instructions(),
+                                     counters.cache_misses()}};
     }
     SimpleTimer timer;
+    PerfCounters counters;
+    StartTransferProfiler();
+    counters.Start();
     timer.Start();
     auto writer = client_.WriteObject(
         bucket_name, object_name,
@@ -96,17 +109,23 @@ class UploadObject : public ThroughputExperiment {
     }
     writer.Close();
     timer.Stop();
-
-    return ThroughputResult{kOpWrite,
-                            config.object_size,
-                            config.app_buffer_size,
-                            config.lib_buffer_size,
-                            config.enable_crc32c,
-                            config.enable_md5,
-                            api_,
-                            timer.elapsed_time(),
-                            timer.cpu_time(),
-                            writer.metadata().status().code()};
+    counters.Stop();
+    StopTransferProfiler();
+
+    return ThroughputResult{
+        kOpWrite,
+        config.object_size,
+        config.app_buffer_size,
+        config.lib_buffer_size,
+        config.enable_crc32c,
+        config.enable_md5,
+        api_,
+        timer.elapsed_time(),
+        timer.cpu_time(),
+        writer.metadata().status().code(),
+        ThroughputPhaseTimings{},
+        ThroughputHardwareCounters{counters.instructions(),
+                                   counters.cache_misses()}};
   }
 
  private:
@@ -138,6 +157,9 @@ class DownloadObject : public ThroughputExperiment {
     std::vector<char> buffer(config.app_buffer_size);
 
     SimpleTimer timer;
+    PerfCounters counters;
+    StartTransferProfiler();
+    counters.Start();
     timer.Start();
     auto reader = client_.ReadObject(
         bucket_name, object_name,
@@ -147,16 +169,22 @@ class DownloadObject : public ThroughputExperiment {
          num_read += reader.gcount()) {
     }
     timer.Stop();
-    return ThroughputResult{config.op,
-                            config.object_size,
-                            config.app_buffer_size,
-                            config.lib_buffer_size,
-                            config.enable_crc32c,
-                            config.enable_md5,
-                            api_,
-                            timer.elapsed_time(),
-                            timer.cpu_time(),
-                            reader.status().code()};
+    counters.Stop();
+    StopTransferProfiler();
+    return ThroughputResult{
+        config.op,
+        config.object_size,
+        config.app_buffer_size,
+        config.lib_buffer_size,
+        config.enable_crc32c,
+        config.enable_md5,
+        api_,
+        timer.elapsed_time(),
+        timer.cpu_time(),
+        reader.status().code(),
+        ThroughputPhaseTimings{},
+        ThroughputHardwareCounters{counters.instructions(),
+                                   counters.cache_misses()}};
   }
 
  private:
@@ -190,6 +218,9 @@ class DownloadObjectLibcurl : public ThroughputExperiment {
     if (!header) return {};
 
     SimpleTimer timer;
+    PerfCounters counters;
+    StartTransferProfiler();
+    counters.Start();
     timer.Start();
     struct curl_slist* slist1 = nullptr;
     slist1 = curl_slist_append(slist1, header->c_str());
@@ -225,19 +256,44 @@ class DownloadObjectLibcurl : public ThroughputExperiment {
     auto status_code = ret == CURLE_OK ? google::cloud::StatusCode::kOk
                                        : google::cloud::StatusCode::kUnknown;
 
+    auto get_phase = [hnd](CURLINFO info) {
+      double seconds = 0;
+      if (curl_easy_getinfo(hnd, info, &seconds) != CURLE_OK) {
+        return std::chrono::microseconds(0);
+      }
+      return std::chrono::microseconds(
+          static_cast<std::int64_t>(seconds * 1000000));
+    };
+    auto const dns = get_phase(CURLINFO_NAMELOOKUP_TIME);
+    auto const connect = get_phase(CURLINFO_CONNECT_TIME);
+    auto const tls = get_phase(CURLINFO_APPCONNECT_TIME);
+    auto const ttfb = get_phase(CURLINFO_STARTTRANSFER_TIME);
+    // libcurl reports cumulative times since the start of the transfer,
+    // convert them to the incremental cost of each phase. A reused connection
+    // reports (almost) zero for all the setup phases.
+    ThroughputPhaseTimings phases{
+        dns, connect > dns ? connect - dns : std::chrono::microseconds(0),
+        tls > connect ? tls - connect : std::chrono::microseconds(0), ttfb};
+
     curl_easy_cleanup(hnd);
     curl_slist_free_all(slist1);
     timer.Stop();
-    return ThroughputResult{config.op,
-                            config.object_size,
-                            config.app_buffer_size,
-                            config.lib_buffer_size,
-                            config.enable_crc32c,
-                            config.enable_md5,
-                            api_,
-                            timer.elapsed_time(),
-                            timer.cpu_time(),
-                            status_code};
+    counters.Stop();
+    StopTransferProfiler();
+    return ThroughputResult{
+        config.op,
+        config.object_size,
+        config.app_buffer_size,
+        config.lib_buffer_size,
+        config.enable_crc32c,
+        config.enable_md5,
+        api_,
+        timer.elapsed_time(),
+        timer.cpu_time(),
+        status_code,
+        phases,
+        ThroughputHardwareCounters{counters.instructions(),
+                                   counters.cache_misses()}};
   }
 
  private:
@@ -265,7 +321,10 @@ class DownloadObjectRawGrpc : public ThroughputExperiment {
                        std::string const& object_name,
                        ThroughputExperimentConfig const& config) override {
     SimpleTimer timer;
+    PerfCounters counters;
 
+    StartTransferProfiler();
+    counters.Start();
     timer.Start();
     google::storage::v1::GetObjectMediaRequest request;
     request.set_bucket(bucket_name);
@@ -282,17 +341,23 @@ class DownloadObjectRawGrpc : public ThroughputExperiment {
     auto const status =
         ::google::cloud::MakeStatusFromRpcError(stream->Finish());
     timer.Stop();
-
-    return ThroughputResult{config.op,
-                            config.object_size,
-                            config.app_buffer_size,
-                            /*lib_buffer_size=*/0,
-                            /*crc_enabled=*/false,
-                            /*md5_enabled=*/false,
-                            ApiName::kApiRawGrpc,
-                            timer.elapsed_time(),
-                            timer.cpu_time(),
-                            status.code()};
+    counters.Stop();
+    StopTransferProfiler();
+
+    return ThroughputResult{
+        config.op,
+        config.object_size,
+        config.app_buffer_size,
+        /*lib_buffer_size=*/0,
+        /*crc_enabled=*/false,
+        /*md5_enabled=*/false,
+        ApiName::kApiRawGrpc,
+        timer.elapsed_time(),
+        timer.cpu_time(),
+        status.code(),
+        ThroughputPhaseTimings{},
+        ThroughputHardwareCounters{counters.instructions(),
+                                   counters.cache_misses()}};
   }
 
  private:
@@ -314,9 +379,11 @@ std::vector<std::unique_ptr<ThroughputExperiment>> CreateUploadExperiments(
 #if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
       case ApiName::kApiGrpc:
       case ApiName::kApiRawGrpc: {
-        gcs::Client grpc_client =
-            google::cloud::storage_experimental::DefaultGrpcClient(
-                client_options);
+        // Pin the pure gRPC transport, regardless of the value of
+        // GOOGLE_CLOUD_CPP_STORAGE_GRPC_CONFIG, so the arms of the experiment
+        // remain comparable across runs.
+        gcs::Client grpc_client(
+            std::make_shared<gcs::internal::GrpcClient>(client_options));
         result.push_back(
             absl::make_unique<UploadObject>(grpc_client, a, contents, false));
         result.push_back(
@@ -325,8 +392,19 @@ std::vector<std::unique_ptr<ThroughputExperiment>> CreateUploadExperiments(
       // this comment keeps clang-format from merging to previous line
       // we thing `} break;` is just weird.
       break;
+      case ApiName::kApiHybrid: {
+        gcs::Client hybrid_client(
+            std::make_shared<gcs::internal::HybridClient>(client_options));
+        result.push_back(
+            absl::make_unique<UploadObject>(hybrid_client, a, contents, false));
+        result.push_back(
+            absl::make_unique<UploadObject>(hybrid_client, a, contents, true));
+      }
+      // ditto
+      break;
 #else
       case ApiName::kApiGrpc:
+      case ApiName::kApiHybrid:
       case ApiName::kApiRawGrpc:
         break;
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
@@ -355,12 +433,19 @@ std::vector<std::unique_ptr<ThroughputExperiment>> CreateDownloadExperiments(
 #if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
       case ApiName::kApiGrpc:
         result.push_back(absl::make_unique<DownloadObject>(
-            google::cloud::storage_experimental::DefaultGrpcClient(
-                client_options),
+            gcs::Client(
+                std::make_shared<gcs::internal::GrpcClient>(client_options)),
+            a));
+        break;
+      case ApiName::kApiHybrid:
+        result.push_back(absl::make_unique<DownloadObject>(
+            gcs::Client(
+                std::make_shared<gcs::internal::HybridClient>(client_options)),
             a));
         break;
 #else
       case ApiName::kApiGrpc:
+      case ApiName::kApiHybrid:
         break;
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
       case ApiName::kApiXml:
@@ -111,6 +111,7 @@ google::cloud::StatusOr<ThroughputOptions> ParseThroughputOptions(
                     ApiName::kApiJson,
                     ApiName::kApiXml,
                     ApiName::kApiGrpc,
+                    ApiName::kApiHybrid,
                     ApiName::kApiRawJson,
                     ApiName::kApiRawXml,
                     ApiName::kApiRawGrpc,
@@ -45,6 +45,7 @@ struct ThroughputOptions {
       ApiName::kApiXml,
 #if GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
       ApiName::kApiGrpc,
+      ApiName::kApiHybrid,
 #endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_GRPC
   };
   std::vector<bool> enabled_crc32c = {false, true};
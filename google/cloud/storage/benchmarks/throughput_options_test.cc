@@ -119,6 +119,10 @@ TEST(ThroughputOptions, Apis) {
   EXPECT_THAT(options->enabled_apis,
               UnorderedElementsAre(ApiName::kApiJson, ApiName::kApiXml,
                                    ApiName::kApiGrpc));
+  options = ParseThroughputOptions(
+      {"self-test", "--region=r", "--enabled-apis=HYBRID,GRPC-RAW"});
+  EXPECT_THAT(options->enabled_apis,
+              UnorderedElementsAre(ApiName::kApiHybrid, ApiName::kApiRawGrpc));
 }
 
 TEST(ThroughputOptions, Validate) {
@@ -21,14 +21,20 @@ namespace storage_benchmarks {
 void PrintAsCsv(std::ostream& os, ThroughputResult const& r) {
   os << ToString(r.op) << ',' << r.object_size << ',' << r.app_buffer_size
      << ',' << r.lib_buffer_size << ',' << r.crc_enabled << ',' << r.md5_enabled
-     << ',' << ToString(r.api) << ',' << r.elapsed_time.count() << ','
-     << r.cpu_time.count() << ',' << r.status << '\n';
+     << ',' << ToString(r.api) << ',' << TransportName(r.api) << ','
+     << r.elapsed_time.count() << ','
+     << r.cpu_time.count() << ',' << r.status << ',' << r.phases.dns.count()
+     << ',' << r.phases.connect.count() << ',' << r.phases.tls.count() << ','
+     << r.phases.ttfb.count() << ',' << r.counters.instructions << ','
+     << r.counters.cache_misses << '\n';
 }
 
 void PrintThroughputResultHeader(std::ostream& os) {
   os << "Op,ObjectSize,AppBufferSize,LibBufferSize"
-     << ",Crc32cEnabled,MD5Enabled,ApiName"
-     << ",ElapsedTimeUs,CpuTimeUs,Status\n";
+     << ",Crc32cEnabled,MD5Enabled,ApiName,Transport"
+     << ",ElapsedTimeUs,CpuTimeUs,Status"
+     << ",DnsTimeUs,ConnectTimeUs,TlsTimeUs,TtfbTimeUs"
+     << ",InstructionCount,CacheMisses\n";
 }
 
 char const* ToString(OpType op) {
@@ -47,6 +47,41 @@ enum OpType {
   kOpRead2,
 };
 
+/**
+ * The phase-by-phase latency breakdown of a single transfer.
+ *
+ * Only experiments that own the transport handle (e.g. the raw libcurl
+ * downloads) can recover these values, the other experiments leave all the
+ * fields as zero. The analysis uses these fields to attribute regressions to
+ * connection setup vs. data transfer.
+ */
+struct ThroughputPhaseTimings {
+  /// The time to resolve the peer name (CURLINFO_NAMELOOKUP_TIME).
+  std::chrono::microseconds dns;
+  /// The additional time to establish the TCP connection.
+  std::chrono::microseconds connect;
+  /// The additional time to complete the TLS handshake.
+  std::chrono::microseconds tls;
+  /// The time from the start of the transfer to the first byte received.
+  std::chrono::microseconds ttfb;
+};
+
+/**
+ * The hardware counters captured during a single transfer.
+ *
+ * All experiments capture these via `PerfCounters`, but the values are zero
+ * when the platform or the kernel configuration does not support
+ * `perf_event_open(2)`. The analysis uses these fields to distinguish "more
+ * work" regressions (instructions) from "worse locality" regressions (cache
+ * misses) without a manual perf session.
+ */
+struct ThroughputHardwareCounters {
+  /// The number of instructions retired during the transfer.
+  std::int64_t instructions;
+  /// The number of cache misses during the transfer.
+  std::int64_t cache_misses;
+};
+
 /**
  * The result of running a throughput benchmark iteration.
  *
@@ -81,6 +116,13 @@ struct ThroughputResult {
   /// The result of the operation. The analysis may need to discard failed
   /// uploads or downloads.
   google::cloud::StatusCode status;
+  /// The per-phase latency breakdown, all zeroes when not available. This and
+  /// the following members appear last so the (many) aggregate initializers
+  /// that predate them remain valid.
+  ThroughputPhaseTimings phases;
+  /// The hardware counters captured during the transfer, all zeroes when not
+  /// available.
+  ThroughputHardwareCounters counters;
 };
 
 /// Print @p r as a CSV line.
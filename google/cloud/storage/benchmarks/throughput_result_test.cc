@@ -35,7 +35,12 @@ TEST(ThroughtputResult, HeaderMatches) {
                  /*app_buffer_size=*/2 * kMiB, /*lib_buffer_size=*/4 * kMiB,
                  /*crc_enabled=*/true, /*md5_enabled=*/false, ApiName::kApiGrpc,
                  std::chrono::microseconds(234000),
-                 std::chrono::microseconds(345000), StatusCode::kOutOfRange});
+                 std::chrono::microseconds(345000), StatusCode::kOutOfRange,
+                 ThroughputPhaseTimings{std::chrono::microseconds(1001),
+                                        std::chrono::microseconds(2002),
+                                        std::chrono::microseconds(3003),
+                                        std::chrono::microseconds(4004)},
+                 ThroughputHardwareCounters{5005, 6006}});
   EXPECT_TRUE(line_stream);
   auto const line = std::move(line_stream).str();
 
@@ -57,9 +62,16 @@ TEST(ThroughtputResult, HeaderMatches) {
   EXPECT_THAT(line, HasSubstr(",1,"));  // crc_enabled==true
   EXPECT_THAT(line, HasSubstr(",0,"));  // md5_enabled==false
   EXPECT_THAT(line, HasSubstr(ToString(ApiName::kApiGrpc)));
+  EXPECT_THAT(line, HasSubstr(TransportName(ApiName::kApiGrpc)));
   EXPECT_THAT(line, HasSubstr(",234000,"));
   EXPECT_THAT(line, HasSubstr(",345000,"));
   EXPECT_THAT(line, HasSubstr(StatusCodeToString(StatusCode::kOutOfRange)));
+  EXPECT_THAT(line, HasSubstr(",1001,"));
+  EXPECT_THAT(line, HasSubstr(",2002,"));
+  EXPECT_THAT(line, HasSubstr(",3003,"));
+  EXPECT_THAT(line, HasSubstr(",4004,"));
+  EXPECT_THAT(line, HasSubstr(",5005,"));
+  EXPECT_THAT(line, HasSubstr(",6006\n"));
 }
 
 }  // namespace
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/mapped_file_region.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/openssl_util.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
@@ -23,6 +24,10 @@
 #include <openssl/md5.h>
 #include <fstream>
 #include <thread>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif  // _WIN32
 
 namespace google {
 namespace cloud {
@@ -88,7 +93,9 @@ ObjectWriteStream Client::WriteObjectImpl(
   }
   return ObjectWriteStream(absl::make_unique<internal::ObjectWriteStreambuf>(
       *std::move(session), raw_client_->client_options().upload_buffer_size(),
-      internal::CreateHashValidator(request)));
+      internal::CreateHashValidator(request),
+      request.HasOption<EnablePipelinedUploads>() &&
+          request.GetOption<EnablePipelinedUploads>().value()));
 }
 
 bool Client::UseSimpleUpload(std::string const& file_name,
@@ -180,6 +187,15 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
         request.GetOption<UploadLimit>().value_or(file_size - upload_offset),
         file_size - upload_offset);
     request.set_option(UploadContentLength(upload_size));
+
+    // Prefer feeding the transport straight from a memory mapping of the
+    // file, this avoids copying every byte through an application buffer. If
+    // the file cannot be mapped fall back to the stream-based loop below.
+    auto mapped =
+        internal::MappedFileRegion::Map(file_name, upload_offset, upload_size);
+    if (mapped) {
+      return UploadMappedResumable(mapped->data(), mapped->size(), request);
+    }
   }
   std::ifstream source(file_name, std::ios::binary);
   if (!source.is_open()) {
@@ -272,6 +288,81 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
   return *std::move(upload_response->payload);
 }
 
+StatusOr<ObjectMetadata> Client::UploadMappedResumable(
+    char const* data, std::size_t size,
+    internal::ResumableUploadRequest const& request) {
+  StatusOr<std::unique_ptr<internal::ResumableUploadSession>> session_status =
+      raw_client()->CreateResumableSession(request);
+  if (!session_status) {
+    return std::move(session_status).status();
+  }
+
+  auto session = std::move(*session_status);
+  // How many bytes of the mapped region are already on the GCS server, e.g.
+  // because the session was resumed.
+  auto offset = static_cast<std::size_t>(
+      (std::min)(session->next_expected_byte(),
+                 static_cast<std::uint64_t>(size)));
+
+  // GCS requires chunks to be a multiple of 256KiB.
+  auto const chunk_size = internal::UploadChunkRequest::RoundUpToQuantum(
+      raw_client()->client_options().upload_buffer_size());
+
+  StatusOr<internal::ResumableUploadResponse> upload_response(
+      internal::ResumableUploadResponse{});
+  internal::ConstBufferSequence buffers(1);
+  do {
+    // Serve the next chunk directly from the mapping, no copies needed.
+    auto const n = (std::min)(chunk_size, size - offset);
+    bool const final_chunk = (size - offset) <= chunk_size;
+    auto const expected = session->next_expected_byte() + n;
+    buffers[0] = internal::ConstBuffer{data + offset, n};
+    if (final_chunk) {
+      upload_response = session->UploadFinalChunk(buffers, expected);
+    } else {
+      upload_response = session->UploadChunk(buffers);
+    }
+    if (!upload_response) {
+      return std::move(upload_response).status();
+    }
+    if (session->next_expected_byte() != expected) {
+      // Defensive programming: unless there is a bug, this should be dead code.
+      return Status(
+          StatusCode::kInternal,
+          "Unexpected last committed byte expected=" +
+              std::to_string(expected) +
+              " got=" + std::to_string(session->next_expected_byte()) +
+              ". This is a bug, please report it at "
+              "https://github.com/googleapis/google-cloud-cpp/issues/new");
+    }
+    offset += n;
+    if (final_chunk) break;
+  } while (!upload_response->payload.has_value());
+
+  return *std::move(upload_response->payload);
+}
+
+namespace {
+#if !defined(_WIN32)
+// Preallocate the download destination when the transfer size is known. This
+// reduces fragmentation and filesystem metadata updates while restoring large
+// objects. Preallocation is strictly an optimization, failures are ignored.
+void PreallocateDownloadFile(
+    int fd, std::multimap<std::string, std::string> const& headers) {
+#if defined(__linux__)
+  auto it = headers.find("content-length");
+  if (it == headers.end()) return;
+  auto const size = std::strtoll(it->second.c_str(), nullptr, 10);
+  if (size <= 0) return;
+  (void)::posix_fallocate(fd, 0, static_cast<off_t>(size));
+#else
+  (void)fd;
+  (void)headers;
+#endif  // __linux__
+}
+#endif  // _WIN32
+}  // namespace
+
 Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                                 std::string const& file_name) {
   auto report_error = [&request, file_name](char const* func, char const* what,
@@ -288,6 +379,45 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                         stream.status());
   }
 
+#if !defined(_WIN32)
+  // Write the received buffers with unbuffered POSIX I/O, this saves a copy
+  // through the `std::ofstream` internal buffers, and lets us preallocate the
+  // destination once the transfer size is known.
+  int fd = ::open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0) {
+    return report_error(__func__, "cannot open download destination file",
+                        Status(StatusCode::kInvalidArgument, "open()"));
+  }
+  std::vector<char> buffer(raw_client_->client_options().download_buffer_size());
+  Status write_status;
+  bool preallocated = false;
+  do {
+    stream.read(buffer.data(), buffer.size());
+    if (!preallocated) {
+      // The response headers are available after the first read.
+      PreallocateDownloadFile(fd, stream.headers());
+      preallocated = true;
+    }
+    char const* data = buffer.data();
+    auto count = static_cast<std::size_t>(stream.gcount());
+    while (count != 0) {
+      auto const written = ::write(fd, data, count);
+      if (written < 0) {
+        write_status = Status(StatusCode::kUnknown, "write()");
+        break;
+      }
+      data += written;
+      count -= static_cast<std::size_t>(written);
+    }
+  } while (write_status.ok() && stream.good());
+  if (::close(fd) != 0 && write_status.ok()) {
+    write_status = Status(StatusCode::kUnknown, "close()");
+  }
+  if (!write_status.ok()) {
+    return report_error(__func__, "cannot write to download destination file",
+                        write_status);
+  }
+#else   // _WIN32
   // Open the destination file, and immediate raise an exception on failure.
   std::ofstream os(file_name, std::ios::binary);
   if (!os.is_open()) {
@@ -307,6 +437,7 @@ Status Client::DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
     return report_error(__func__, "cannot close download destination file",
                         Status(StatusCode::kUnknown, "ofstream::close()"));
   }
+#endif  // _WIN32
   if (!stream.status().ok()) {
     return report_error(__func__, "error reading download source object",
                         stream.status());
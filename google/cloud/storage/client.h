@@ -891,6 +891,10 @@ class Client {
    *
    * @par Example
    * @snippet storage_object_samples.cc insert object multipart
+   *
+   * @note The @p contents are moved into the request and reach the wire
+   *     without further copies, pass an rvalue (e.g.
+   *     `std::move(contents)`) to avoid copying large payloads.
    */
   template <typename... Options>
   StatusOr<ObjectMetadata> InsertObject(std::string const& bucket_name,
@@ -2853,6 +2857,47 @@ class Client {
     request.set_multiple_options(std::forward<Options>(options)...);
     return SignUrlV4(std::move(request));
   }
+
+  /**
+   * Create V4 signed URLs for multiple objects in a single call.
+   *
+   * This is a convenience function for applications minting signed URLs in
+   * bulk, e.g. to hand a CDN one URL per object. It behaves as-if
+   * `CreateV4SignedUrl()` was called once per object, with the same @p verb,
+   * @p bucket_name and @p options, and stops at the first error.
+   *
+   * @note By default URLs created with this function expire after 7 days.
+   *
+   * @param verb the operation allowed through these signed URLs, `GET`,
+   *     `POST`, `PUT`, `HEAD`, etc. are valid values.
+   * @param bucket_name the name of the bucket.
+   * @param object_names the names of the objects, note that the objects may
+   *     not exist for signed URLs that upload new objects.
+   * @param options a list of optional parameters, applied to every URL, see
+   *     `CreateV4SignedUrl()` for the full list.
+   *
+   * @return the signed URLs, in the same order as @p object_names.
+   *
+   * @see https://cloud.google.com/storage/docs/access-control/signed-urls for
+   *     a general description of signed URLs and how they can be used.
+   */
+  template <typename... Options>
+  StatusOr<std::vector<std::string>> CreateV4SignedUrls(
+      std::string verb, std::string bucket_name,
+      std::vector<std::string> object_names, Options&&... options) {
+    std::vector<std::string> urls;
+    urls.reserve(object_names.size());
+    for (auto& object_name : object_names) {
+      internal::V4SignUrlRequest request(verb, bucket_name,
+                                         std::move(object_name));
+      // Do not forward the options, they are reused in every iteration.
+      request.set_multiple_options(options...);
+      auto url = SignUrlV4(std::move(request));
+      if (!url) return std::move(url).status();
+      urls.push_back(*std::move(url));
+    }
+    return urls;
+  }
   //@}
 
   /**
@@ -3158,6 +3203,10 @@ class Client {
   StatusOr<ObjectMetadata> UploadStreamResumable(
       std::istream& source, internal::ResumableUploadRequest const& request);
 
+  StatusOr<ObjectMetadata> UploadMappedResumable(
+      char const* data, std::size_t size,
+      internal::ResumableUploadRequest const& request);
+
   Status DownloadFileImpl(internal::ReadObjectRangeRequest const& request,
                           std::string const& file_name);
 
@@ -132,6 +132,12 @@ void ClientOptions::SetupFromEnvironment() {
     }
   }
 
+  auto shared_pool =
+      google::cloud::internal::GetEnv("CLOUD_STORAGE_SHARED_CONNECTION_POOL");
+  if (shared_pool.has_value()) {
+    set_enable_shared_connection_pool(true);
+  }
+
   auto project_id = google::cloud::internal::GetEnv("GOOGLE_CLOUD_PROJECT");
   if (project_id.has_value()) {
     project_id_ = std::move(*project_id);
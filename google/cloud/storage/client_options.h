@@ -62,6 +62,9 @@ class ChannelOptions {
  * - `CLOUD_STORAGE_ENABLE_TRACING`: if set, this is the list of components that
  *   will have logging enabled, the component this is:
  *   - `http`: trace all http request / responses.
+ * - `CLOUD_STORAGE_SHARED_CONNECTION_POOL`: if set, all the clients in the
+ *   process share one connection pool (and thus TLS sessions and DNS cache),
+ *   see `set_enable_shared_connection_pool()`.
  */
 class ClientOptions {
  public:
@@ -133,6 +136,59 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * The number of `curl_multi` event-loop threads driving request I/O.
+   *
+   * When non-zero, non-streaming requests are performed by a small pool of
+   * event-loop threads instead of blocking in `curl_easy_perform()`. This
+   * decouples the number of concurrent requests from the number of
+   * application threads: thousands of threads (or a few threads issuing
+   * requests through many clients) can share a handful of I/O threads. The
+   * default (0) preserves the traditional one-thread-per-transfer behavior.
+   */
+  std::size_t curl_multi_io_threads() const { return curl_multi_io_threads_; }
+  ClientOptions& set_curl_multi_io_threads(std::size_t count) {
+    curl_multi_io_threads_ = count;
+    return *this;
+  }
+
+  /**
+   * If true, share the connection pool with all other clients in the process.
+   *
+   * By default each client keeps its own pool of libcurl handles, and
+   * therefore its own connections, TLS session cache, and DNS cache.
+   * Applications that create many clients (e.g. one per tenant) pay a fresh
+   * TCP+TLS handshake per client even when they all talk to the same
+   * endpoint. With this option enabled the client uses a process-wide pool
+   * instead, shared across all clients created with the same
+   * `ChannelOptions`, so those warmed-up resources are reused.
+   */
+  bool enable_shared_connection_pool() const {
+    return enable_shared_connection_pool_;
+  }
+  ClientOptions& set_enable_shared_connection_pool(bool v) {
+    enable_shared_connection_pool_ = v;
+    return *this;
+  }
+
+  /**
+   * The number of connections to pre-establish when the client is created.
+   *
+   * When non-zero, the client performs this many TCP+TLS handshakes to its
+   * endpoint at construction time and keeps the connections in the pool, so
+   * the first requests do not pay connection setup latency. Only has an
+   * effect with a pooling handle factory (the default); best combined with
+   * `set_enable_shared_connection_pool()` so the warm connections outlive
+   * any single client.
+   */
+  std::size_t warmup_connection_count() const {
+    return warmup_connection_count_;
+  }
+  ClientOptions& set_warmup_connection_count(std::size_t count) {
+    warmup_connection_count_ = count;
+    return *this;
+  }
+
   std::size_t download_buffer_size() const { return download_buffer_size_; }
   ClientOptions& SetDownloadBufferSize(std::size_t size);
 
@@ -228,6 +284,9 @@ class ClientOptions {
   bool enable_raw_client_tracing_;
   std::string project_id_;
   std::size_t connection_pool_size_;
+  std::size_t curl_multi_io_threads_ = 0;
+  bool enable_shared_connection_pool_ = false;
+  std::size_t warmup_connection_count_ = 0;
   std::size_t download_buffer_size_;
   std::size_t upload_buffer_size_;
   std::string user_agent_prefix_;
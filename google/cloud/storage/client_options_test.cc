@@ -224,6 +224,27 @@ TEST_F(ClientOptionsTest, SetEnableLockingCallbacks) {
   EXPECT_TRUE(client_options.enable_ssl_locking_callbacks());
 }
 
+TEST_F(ClientOptionsTest, SetEnableSharedConnectionPool) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_FALSE(client_options.enable_shared_connection_pool());
+  client_options.set_enable_shared_connection_pool(true);
+  EXPECT_TRUE(client_options.enable_shared_connection_pool());
+}
+
+TEST_F(ClientOptionsTest, SharedConnectionPoolFromEnvironment) {
+  testing_util::ScopedEnvironment shared_pool(
+      "CLOUD_STORAGE_SHARED_CONNECTION_POOL", "yes");
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  EXPECT_TRUE(options.enable_shared_connection_pool());
+}
+
+TEST_F(ClientOptionsTest, SetWarmupConnectionCount) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.warmup_connection_count());
+  client_options.set_warmup_connection_count(4);
+  EXPECT_EQ(4, client_options.warmup_connection_count());
+}
+
 TEST_F(ClientOptionsTest, SetMaximumSocketRecvSize) {
   ClientOptions client_options(oauth2::CreateAnonymousCredentials());
   auto default_value = client_options.maximum_socket_recv_size();
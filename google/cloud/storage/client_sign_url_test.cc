@@ -210,6 +210,39 @@ TEST_F(CreateSignedUrlTest, V4SignGet) {
   EXPECT_EQ(expected, *actual);
 }
 
+TEST_F(CreateSignedUrlTest, V4SignBatch) {
+  auto creds = oauth2::CreateServiceAccountCredentialsFromJsonContents(
+      kJsonKeyfileContentsForV4);
+  ASSERT_STATUS_OK(creds);
+  Client client(*creds);
+
+  std::string const bucket_name = "test-bucket";
+  std::vector<std::string> const object_names{"test-object-0", "test-object-1",
+                                              "test-object-2"};
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const valid_for = std::chrono::seconds(10);
+
+  auto actual = client.CreateV4SignedUrls(
+      "GET", bucket_name, object_names,
+      SignedUrlTimestamp(google::cloud::internal::ParseRfc3339(date)),
+      SignedUrlDuration(valid_for),
+      AddExtensionHeader("host", "storage.googleapis.com"));
+  ASSERT_STATUS_OK(actual);
+  ASSERT_EQ(object_names.size(), actual->size());
+
+  // The batched API is defined to produce the same URLs as one call per
+  // object.
+  for (std::size_t i = 0; i != object_names.size(); ++i) {
+    auto expected = client.CreateV4SignedUrl(
+        "GET", bucket_name, object_names[i],
+        SignedUrlTimestamp(google::cloud::internal::ParseRfc3339(date)),
+        SignedUrlDuration(valid_for),
+        AddExtensionHeader("host", "storage.googleapis.com"));
+    ASSERT_STATUS_OK(expected);
+    EXPECT_EQ(*expected, (*actual)[i]);
+  }
+}
+
 TEST_F(CreateSignedUrlTest, V4SignPut) {
   // This test uses a disabled key to create a V4 Signed URL for a PUT
   // operation. The bucket name was generated at random too.
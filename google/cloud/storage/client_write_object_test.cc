@@ -363,6 +363,68 @@ TEST_F(WriteObjectTest, UploadFile) {
   EXPECT_EQ(expected, *res);
 }
 
+#if !defined(_WIN32)
+TEST_F(WriteObjectTest, UploadFileMappedMultipleChunks) {
+  auto const quantum = internal::UploadChunkRequest::kChunkSizeQuantum;
+  auto rng = google::cloud::internal::MakeDefaultPRNG();
+  // Larger than the upload buffer, so the upload requires multiple chunks.
+  auto const contents =
+      google::cloud::storage::testing::MakeRandomData(rng, 2 * quantum + 10);
+  google::cloud::storage::testing::TempFile temp_file(contents);
+
+  std::string text = R"""({
+      "name": "test-bucket-name/test-object-name/1"
+})""";
+  auto expected = internal::ObjectMetadataParser::FromString(text).value();
+
+  std::string uploaded;
+  EXPECT_CALL(*mock_, CreateResumableSession(_))
+      .WillOnce([&expected,
+                 &uploaded](internal::ResumableUploadRequest const&) {
+        auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+        using internal::ResumableUploadResponse;
+        EXPECT_CALL(*mock, done()).WillRepeatedly(Return(false));
+        EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly([&uploaded]() {
+          return uploaded.size();
+        });
+        EXPECT_CALL(*mock, UploadChunk(_))
+            .WillOnce([&uploaded](internal::ConstBufferSequence const& data) {
+              for (auto const& b : data) {
+                uploaded.append(b.data(), b.size());
+              }
+              return make_status_or(ResumableUploadResponse{
+                  "fake-url",
+                  uploaded.size() - 1,
+                  {},
+                  ResumableUploadResponse::kInProgress,
+                  {}});
+            });
+        EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+            .WillOnce([expected, &uploaded](
+                          internal::ConstBufferSequence const& data,
+                          std::uint64_t size) {
+              for (auto const& b : data) {
+                uploaded.append(b.data(), b.size());
+              }
+              EXPECT_EQ(uploaded.size(), size);
+              return make_status_or(ResumableUploadResponse{
+                  "fake-url", 0, expected, ResumableUploadResponse::kDone, {}});
+            });
+
+        return make_status_or(
+            std::unique_ptr<internal::ResumableUploadSession>(std::move(mock)));
+      });
+
+  auto res =
+      client_->UploadFile(temp_file.name(), "test-bucket-name",
+                          "test-object-name", UseResumableUploadSession());
+  ASSERT_STATUS_OK(res);
+  EXPECT_EQ(expected, *res);
+  // The transport must receive exactly the file contents, in order.
+  EXPECT_EQ(contents, uploaded);
+}
+#endif  // _WIN32
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
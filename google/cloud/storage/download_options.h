@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/version.h"
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -71,6 +72,46 @@ struct ReadLast : public internal::ComplexOption<ReadLast, std::int64_t> {
   static char const* name() { return "read-last"; }
 };
 
+/**
+ * Keep several download chunks buffered ahead of the reader.
+ *
+ * By default `ObjectReadStream` downloads the next chunk of data only when its
+ * internal buffer is exhausted, so an application that processes the data as
+ * it arrives alternates between CPU work and network round trips. With this
+ * option the library keeps up to N chunks (each of the configured download
+ * buffer size) in flight ahead of the reader, downloading on a separate
+ * thread while the application consumes the previous chunks. The value bounds
+ * the additional memory used by the download. Setting the value to 0 disables
+ * readahead, as does omitting the option.
+ */
+struct ReadAhead : public internal::ComplexOption<ReadAhead, std::size_t> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  ReadAhead() = default;
+  static char const* name() { return "read-ahead"; }
+};
+
+/**
+ * Decompress the object data while it is downloaded.
+ *
+ * Objects stored with `contentEncoding: gzip` are downloaded compressed (the
+ * library requests `Cache-Control: no-transform` for ranged reads, and
+ * applications may store pre-compressed data to reduce storage costs). With
+ * this option the library inflates the data as it arrives, using a bounded
+ * buffer for the compressed bytes, so the stream yields the uncompressed
+ * contents. Note that the service-reported hashes cover the *stored* (that
+ * is, compressed) data, so hash validation is disabled when this option is
+ * set.
+ */
+struct DecompressGzip : public internal::ComplexOption<DecompressGzip, bool> {
+  using ComplexOption::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  DecompressGzip() = default;
+  static char const* name() { return "decompress-gzip"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
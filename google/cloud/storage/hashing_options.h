@@ -114,6 +114,26 @@ struct DisableCrc32cChecksum
   static char const* name() { return "disable-crc32c-checksum"; }
 };
 
+/**
+ * Run hash and checksum computations on a separate pipeline stage.
+ *
+ * By default the client library computes hashes and checksums inline, on the
+ * same thread that sends or receives the data. For high-throughput transfers
+ * the hash computation can become the bottleneck. With this option the hashes
+ * are computed by a dedicated thread, overlapping the hash computation with
+ * the data transfer. This trades an extra copy of the data (into the hashing
+ * queue) for the overlap, which is typically a good trade-off for large
+ * objects on hosts with spare cores.
+ */
+struct EnableHashingPipeline
+    : public internal::ComplexOption<EnableHashingPipeline, bool> {
+  using ComplexOption<EnableHashingPipeline, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  EnableHashingPipeline() : EnableHashingPipeline(true) {}
+  static char const* name() { return "enable-hashing-pipeline"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
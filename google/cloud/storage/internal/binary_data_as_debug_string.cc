@@ -16,14 +16,18 @@
 #include <array>
 #include <cctype>
 #include <limits>
+#include <ostream>
+#include <sstream>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
-std::string BinaryDataAsDebugString(char const* data, std::size_t size,
-                                    std::size_t max_output_bytes) {
+#if !defined(GOOGLE_CLOUD_CPP_STORAGE_DISABLE_PAYLOAD_LOGGING)
+namespace {
+void FormatBinaryData(std::ostream& os, char const* data, std::size_t size,
+                      std::size_t max_output_bytes) {
   // We want about 2/3 of a standard 80 column terminal to be used by the hex
   // representation and the other 1/3 (because it is half as wide) with the
   // text representation. Setting this value to 24 uses 72 columns: 48 for the
@@ -31,7 +35,6 @@ std::string BinaryDataAsDebugString(char const* data, std::size_t size,
   // chose (somewhat arbitrarily) 24 as it is 16 + 8 and thus more "round" in
   // base 2.
   auto constexpr kTextWidth = 24;
-  std::string result;
   std::string text_column(kTextWidth, ' ');
   std::string hex_column(2 * kTextWidth, ' ');
 
@@ -39,10 +42,7 @@ std::string BinaryDataAsDebugString(char const* data, std::size_t size,
   //   - clang-tidy complains if you capture a constexpr or const
   //   - MSVC does not automatically capture constexpr types unless we do this
   auto flush = [&] {
-    result += text_column;
-    result += ' ';
-    result += hex_column;
-    result += '\n';
+    os << text_column << ' ' << hex_column << '\n';
     text_column = std::string(kTextWidth, ' ');
     hex_column = std::string(2 * kTextWidth, ' ');
   };
@@ -78,8 +78,29 @@ std::string BinaryDataAsDebugString(char const* data, std::size_t size,
   if (count != 0) {
     flush();
   }
-  return result;
 }
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, BinaryDataDebugView const& rhs) {
+  FormatBinaryData(os, rhs.data_, rhs.size_, rhs.max_output_bytes_);
+  return os;
+}
+
+std::string BinaryDataAsDebugString(char const* data, std::size_t size,
+                                    std::size_t max_output_bytes) {
+  std::ostringstream os;
+  FormatBinaryData(os, data, size, max_output_bytes);
+  return std::move(os).str();
+}
+#else   // GOOGLE_CLOUD_CPP_STORAGE_DISABLE_PAYLOAD_LOGGING
+std::ostream& operator<<(std::ostream& os, BinaryDataDebugView const&) {
+  return os << "[payload logging disabled]\n";
+}
+
+std::string BinaryDataAsDebugString(char const*, std::size_t, std::size_t) {
+  return "[payload logging disabled]\n";
+}
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_DISABLE_PAYLOAD_LOGGING
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BINARY_DATA_AS_DEBUG_STRING_H
 
 #include "google/cloud/storage/version.h"
+#include <iosfwd>
 #include <string>
 
 namespace google {
@@ -23,14 +24,42 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+/**
+ * A lazily-formatted debug view over a block of binary data.
+ *
+ * Streaming this object formats the data into two columns. The first column
+ * is 24 characters wide and has the non-printable characters replaced by
+ * periods. The second column is 48 characters wide and contains the hexdump
+ * of the data. The columns are separated by a single space.
+ *
+ * No formatting work happens until the object is streamed, so it can be used
+ * in log and error messages that are often discarded. The view does not own
+ * the data, it must not outlive it.
+ *
+ * Compiling with `GOOGLE_CLOUD_CPP_STORAGE_DISABLE_PAYLOAD_LOGGING` elides
+ * the formatting entirely, streaming a short placeholder instead.
+ */
+class BinaryDataDebugView {
+ public:
+  BinaryDataDebugView(char const* data, std::size_t size,
+                      std::size_t max_output_bytes = 0)
+      : data_(data), size_(size), max_output_bytes_(max_output_bytes) {}
+
+  friend std::ostream& operator<<(std::ostream& os,
+                                  BinaryDataDebugView const& rhs);
+
+ private:
+  char const* data_;
+  std::size_t size_;
+  std::size_t max_output_bytes_;
+};
+
 /**
  * Formats a block of data for debug printing.
  *
- * Takes a block of data, possible with non-printable characters and creates
- * a string with two columns.  The first column is 24 characters wide and has
- * the non-printable characters replaced by periods.  The second column is 48
- * characters wide and contains the hexdump of the data.  The columns are
- * separated by a single space.
+ * Renders a `BinaryDataDebugView` into a string, for callers that accumulate
+ * debug output in a buffer. Prefer streaming the view directly when writing
+ * to an `std::ostream`.
  */
 std::string BinaryDataAsDebugString(char const* data, std::size_t size,
                                     std::size_t max_output_bytes = 0);
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/binary_data_as_debug_string.h"
 #include <gmock/gmock.h>
+#include <sstream>
 
 namespace google {
 namespace cloud {
@@ -66,6 +67,20 @@ TEST(BinaryDataAsDebugStringTest, Limit) {
       actual);
 }
 
+TEST(BinaryDataDebugViewTest, StreamsSameOutput) {
+  std::string const data = " 123456789 123456789 123456789 123456789";
+  std::ostringstream os;
+  os << BinaryDataDebugView(data.data(), data.size());
+  EXPECT_EQ(BinaryDataAsDebugString(data.data(), data.size()), os.str());
+}
+
+TEST(BinaryDataDebugViewTest, HonorsLimit) {
+  std::string const data = " 123456789 123456789 123456789 123456789";
+  std::ostringstream os;
+  os << BinaryDataDebugView(data.data(), data.size(), 24);
+  EXPECT_EQ(BinaryDataAsDebugString(data.data(), data.size(), 24), os.str());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -19,6 +19,7 @@
 #include "google/cloud/storage/iam_policy.h"
 #include "google/cloud/storage/internal/generic_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/list_options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/storage/well_known_parameters.h"
 #include "google/cloud/iam_policy.h"
@@ -45,8 +46,8 @@ std::string BucketMetadataToJsonString(BucketMetadata const& meta);
  * Requests the list of buckets for a project.
  */
 class ListBucketsRequest
-    : public GenericRequest<ListBucketsRequest, MaxResults, Prefix, Projection,
-                            UserProject> {
+    : public GenericRequest<ListBucketsRequest, EnablePagePrefetch, MaxResults,
+                            Prefix, Projection, UserProject> {
  public:
   ListBucketsRequest() = default;
   explicit ListBucketsRequest(std::string project_id)
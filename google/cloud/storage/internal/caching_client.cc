@@ -0,0 +1,409 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/caching_client.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/// Returns true if @p request carries an option that makes caching unsafe.
+template <typename Request>
+bool BypassesCache(Request const& request) {
+  return request.template HasOption<IfGenerationMatch>() ||
+         request.template HasOption<IfGenerationNotMatch>() ||
+         request.template HasOption<IfMetagenerationMatch>() ||
+         request.template HasOption<IfMetagenerationNotMatch>() ||
+         request.template HasOption<Projection>();
+}
+
+template <typename Request>
+bool BypassesBucketCache(Request const& request) {
+  return request.template HasOption<IfMetagenerationMatch>() ||
+         request.template HasOption<IfMetagenerationNotMatch>() ||
+         request.template HasOption<Projection>();
+}
+}  // namespace
+
+CachingClient::CachingClient(std::shared_ptr<RawClient> client,
+                             std::size_t max_entries,
+                             std::chrono::milliseconds ttl)
+    : client_(std::move(client)),
+      object_cache_(max_entries, ttl),
+      bucket_cache_(max_entries, ttl) {}
+
+ClientOptions const& CachingClient::client_options() const {
+  return client_->client_options();
+}
+
+std::string CachingClient::ObjectKey(std::string const& bucket_name,
+                                     std::string const& object_name) {
+  return bucket_name + '\n' + object_name;
+}
+
+StatusOr<ObjectMetadata> CachingClient::RecordObjectMutation(
+    StatusOr<ObjectMetadata> result, std::string const& bucket_name,
+    std::string const& object_name) {
+  if (result) {
+    object_cache_.Insert(ObjectKey(bucket_name, object_name), *result);
+  } else {
+    // The state of the object is unknown, do not serve stale metadata.
+    object_cache_.Erase(ObjectKey(bucket_name, object_name));
+  }
+  return result;
+}
+
+StatusOr<BucketMetadata> CachingClient::RecordBucketMutation(
+    StatusOr<BucketMetadata> result, std::string const& bucket_name) {
+  if (result) {
+    bucket_cache_.Insert(bucket_name, *result);
+  } else {
+    bucket_cache_.Erase(bucket_name);
+  }
+  return result;
+}
+
+StatusOr<ListBucketsResponse> CachingClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return client_->ListBuckets(request);
+}
+
+StatusOr<BucketMetadata> CachingClient::CreateBucket(
+    CreateBucketRequest const& request) {
+  return RecordBucketMutation(client_->CreateBucket(request),
+                              request.metadata().name());
+}
+
+StatusOr<BucketMetadata> CachingClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  if (BypassesBucketCache(request)) return client_->GetBucketMetadata(request);
+  auto cached = bucket_cache_.Lookup(request.bucket_name());
+  if (cached) return *std::move(cached);
+  auto result = client_->GetBucketMetadata(request);
+  if (result) bucket_cache_.Insert(request.bucket_name(), *result);
+  return result;
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->DeleteBucket(request);
+}
+
+StatusOr<BucketMetadata> CachingClient::UpdateBucket(
+    UpdateBucketRequest const& request) {
+  return RecordBucketMutation(client_->UpdateBucket(request),
+                              request.metadata().name());
+}
+
+StatusOr<BucketMetadata> CachingClient::PatchBucket(
+    PatchBucketRequest const& request) {
+  return RecordBucketMutation(client_->PatchBucket(request), request.bucket());
+}
+
+StatusOr<IamPolicy> CachingClient::GetBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> CachingClient::GetNativeBucketIamPolicy(
+    GetBucketIamPolicyRequest const& request) {
+  return client_->GetNativeBucketIamPolicy(request);
+}
+
+StatusOr<IamPolicy> CachingClient::SetBucketIamPolicy(
+    SetBucketIamPolicyRequest const& request) {
+  // IAM changes update the bucket metageneration.
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->SetBucketIamPolicy(request);
+}
+
+StatusOr<NativeIamPolicy> CachingClient::SetNativeBucketIamPolicy(
+    SetNativeBucketIamPolicyRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->SetNativeBucketIamPolicy(request);
+}
+
+StatusOr<TestBucketIamPermissionsResponse>
+CachingClient::TestBucketIamPermissions(
+    TestBucketIamPermissionsRequest const& request) {
+  return client_->TestBucketIamPermissions(request);
+}
+
+StatusOr<BucketMetadata> CachingClient::LockBucketRetentionPolicy(
+    LockBucketRetentionPolicyRequest const& request) {
+  return RecordBucketMutation(client_->LockBucketRetentionPolicy(request),
+                              request.bucket_name());
+}
+
+StatusOr<ObjectMetadata> CachingClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return RecordObjectMutation(client_->InsertObjectMedia(request),
+                              request.bucket_name(), request.object_name());
+}
+
+StatusOr<ObjectMetadata> CachingClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return RecordObjectMutation(client_->CopyObject(request),
+                              request.destination_bucket(),
+                              request.destination_object());
+}
+
+StatusOr<ObjectMetadata> CachingClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  if (BypassesCache(request)) return client_->GetObjectMetadata(request);
+  auto const key = ObjectKey(request.bucket_name(), request.object_name());
+  auto cached = object_cache_.Lookup(key);
+  if (cached) {
+    // Serve a generation-pinned request from the cache only when the cached
+    // entry is for that generation.
+    if (!request.HasOption<Generation>() ||
+        request.GetOption<Generation>().value() == cached->generation()) {
+      return *std::move(cached);
+    }
+    return client_->GetObjectMetadata(request);
+  }
+  auto result = client_->GetObjectMetadata(request);
+  // Insert only the current metadata, a generation-pinned request may have
+  // returned an archived generation.
+  if (result && !request.HasOption<Generation>()) {
+    object_cache_.Insert(key, *result);
+  }
+  return result;
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>> CachingClient::ReadObject(
+    ReadObjectRangeRequest const& request) {
+  return client_->ReadObject(request);
+}
+
+StatusOr<ListObjectsResponse> CachingClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return client_->ListObjects(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  object_cache_.Erase(ObjectKey(request.bucket_name(), request.object_name()));
+  return client_->DeleteObject(request);
+}
+
+StatusOr<ObjectMetadata> CachingClient::UpdateObject(
+    UpdateObjectRequest const& request) {
+  return RecordObjectMutation(client_->UpdateObject(request),
+                              request.bucket_name(), request.object_name());
+}
+
+StatusOr<ObjectMetadata> CachingClient::PatchObject(
+    PatchObjectRequest const& request) {
+  return RecordObjectMutation(client_->PatchObject(request),
+                              request.bucket_name(), request.object_name());
+}
+
+StatusOr<ObjectMetadata> CachingClient::ComposeObject(
+    ComposeObjectRequest const& request) {
+  return RecordObjectMutation(client_->ComposeObject(request),
+                              request.bucket_name(), request.object_name());
+}
+
+StatusOr<RewriteObjectResponse> CachingClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  // A rewrite may complete (and so mutate the destination) or remain in
+  // progress, invalidate the destination in either case.
+  object_cache_.Erase(
+      ObjectKey(request.destination_bucket(), request.destination_object()));
+  return client_->RewriteObject(request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+CachingClient::CreateResumableSession(ResumableUploadRequest const& request) {
+  // The upload mutates the object when it is finalized, invalidate eagerly.
+  object_cache_.Erase(ObjectKey(request.bucket_name(), request.object_name()));
+  return client_->CreateResumableSession(request);
+}
+
+StatusOr<std::unique_ptr<ResumableUploadSession>>
+CachingClient::RestoreResumableSession(std::string const& request) {
+  return client_->RestoreResumableSession(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteResumableUpload(
+    DeleteResumableUploadRequest const& request) {
+  return client_->DeleteResumableUpload(request);
+}
+
+StatusOr<ListBucketAclResponse> CachingClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return client_->ListBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> CachingClient::CreateBucketAcl(
+    CreateBucketAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->CreateBucketAcl(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteBucketAcl(
+    DeleteBucketAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->DeleteBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> CachingClient::GetBucketAcl(
+    GetBucketAclRequest const& request) {
+  return client_->GetBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> CachingClient::UpdateBucketAcl(
+    UpdateBucketAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->UpdateBucketAcl(request);
+}
+
+StatusOr<BucketAccessControl> CachingClient::PatchBucketAcl(
+    PatchBucketAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->PatchBucketAcl(request);
+}
+
+StatusOr<ListObjectAclResponse> CachingClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return client_->ListObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  object_cache_.Erase(ObjectKey(request.bucket_name(), request.object_name()));
+  return client_->CreateObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteObjectAcl(
+    DeleteObjectAclRequest const& request) {
+  object_cache_.Erase(ObjectKey(request.bucket_name(), request.object_name()));
+  return client_->DeleteObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::GetObjectAcl(
+    GetObjectAclRequest const& request) {
+  return client_->GetObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  object_cache_.Erase(ObjectKey(request.bucket_name(), request.object_name()));
+  return client_->UpdateObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  object_cache_.Erase(ObjectKey(request.bucket_name(), request.object_name()));
+  return client_->PatchObjectAcl(request);
+}
+
+StatusOr<ListDefaultObjectAclResponse> CachingClient::ListDefaultObjectAcl(
+    ListDefaultObjectAclRequest const& request) {
+  return client_->ListDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::CreateDefaultObjectAcl(
+    CreateDefaultObjectAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->CreateDefaultObjectAcl(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteDefaultObjectAcl(
+    DeleteDefaultObjectAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->DeleteDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::GetDefaultObjectAcl(
+    GetDefaultObjectAclRequest const& request) {
+  return client_->GetDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::UpdateDefaultObjectAcl(
+    UpdateDefaultObjectAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->UpdateDefaultObjectAcl(request);
+}
+
+StatusOr<ObjectAccessControl> CachingClient::PatchDefaultObjectAcl(
+    PatchDefaultObjectAclRequest const& request) {
+  bucket_cache_.Erase(request.bucket_name());
+  return client_->PatchDefaultObjectAcl(request);
+}
+
+StatusOr<ServiceAccount> CachingClient::GetServiceAccount(
+    GetProjectServiceAccountRequest const& request) {
+  return client_->GetServiceAccount(request);
+}
+
+StatusOr<ListHmacKeysResponse> CachingClient::ListHmacKeys(
+    ListHmacKeysRequest const& request) {
+  return client_->ListHmacKeys(request);
+}
+
+StatusOr<CreateHmacKeyResponse> CachingClient::CreateHmacKey(
+    CreateHmacKeyRequest const& request) {
+  return client_->CreateHmacKey(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteHmacKey(
+    DeleteHmacKeyRequest const& request) {
+  return client_->DeleteHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> CachingClient::GetHmacKey(
+    GetHmacKeyRequest const& request) {
+  return client_->GetHmacKey(request);
+}
+
+StatusOr<HmacKeyMetadata> CachingClient::UpdateHmacKey(
+    UpdateHmacKeyRequest const& request) {
+  return client_->UpdateHmacKey(request);
+}
+
+StatusOr<SignBlobResponse> CachingClient::SignBlob(
+    SignBlobRequest const& request) {
+  return client_->SignBlob(request);
+}
+
+StatusOr<ListNotificationsResponse> CachingClient::ListNotifications(
+    ListNotificationsRequest const& request) {
+  return client_->ListNotifications(request);
+}
+
+StatusOr<NotificationMetadata> CachingClient::CreateNotification(
+    CreateNotificationRequest const& request) {
+  return client_->CreateNotification(request);
+}
+
+StatusOr<NotificationMetadata> CachingClient::GetNotification(
+    GetNotificationRequest const& request) {
+  return client_->GetNotification(request);
+}
+
+StatusOr<EmptyResponse> CachingClient::DeleteNotification(
+    DeleteNotificationRequest const& request) {
+  return client_->DeleteNotification(request);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
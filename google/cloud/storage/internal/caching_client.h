@@ -0,0 +1,264 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CACHING_CLIENT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CACHING_CLIENT_H
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/version.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A bounded, TTL-based cache of metadata objects with LRU eviction.
+ *
+ * @tparam Value the metadata type stored in the cache.
+ */
+template <typename Value>
+class MetadataCache {
+ public:
+  MetadataCache(std::size_t max_entries, std::chrono::milliseconds ttl)
+      : max_entries_(max_entries), ttl_(ttl) {}
+
+  absl::optional<Value> Lookup(std::string const& key) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return absl::nullopt;
+    if (std::chrono::steady_clock::now() >= it->second.expiration) {
+      lru_.erase(it->second.lru);
+      entries_.erase(it);
+      return absl::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.value;
+  }
+
+  void Insert(std::string const& key, Value value) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const expiration = std::chrono::steady_clock::now() + ttl_;
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      it->second.value = std::move(value);
+      it->second.expiration = expiration;
+      lru_.splice(lru_.begin(), lru_, it->second.lru);
+      return;
+    }
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{std::move(value), expiration, lru_.begin()});
+    while (entries_.size() > max_entries_) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+
+  void Erase(std::string const& key) {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return;
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lk(mu_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    Value value;
+    std::chrono::steady_clock::time_point expiration;
+    std::list<std::string>::iterator lru;
+  };
+
+  std::size_t max_entries_;
+  std::chrono::milliseconds ttl_;
+  mutable std::mutex mu_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_;
+};
+
+/**
+ * Decorates a `RawClient` to cache object and bucket metadata.
+ *
+ * Applications that poll rarely-changing metadata can layer this decorator
+ * (typically below `RetryClient`, so cache hits skip the retry loop entirely)
+ * to avoid one round-trip per `GetObjectMetadata()` or `GetBucketMetadata()`
+ * call.
+ *
+ * The cache is bounded, entries expire after a TTL, and any mutation routed
+ * through the same client invalidates (or refreshes, when the mutation
+ * returns the new metadata) the affected entry. Requests carrying
+ * pre-conditions (`IfGenerationMatch`, `IfMetagenerationMatch`, etc.) or a
+ * `Projection` always go to the service; requests pinning a `Generation` are
+ * served from the cache only when the cached generation matches. Note that
+ * mutations performed through other clients or processes are not visible
+ * until the TTL expires.
+ */
+class CachingClient : public RawClient {
+ public:
+  explicit CachingClient(
+      std::shared_ptr<RawClient> client, std::size_t max_entries = 2048,
+      std::chrono::milliseconds ttl = std::chrono::minutes(5));
+
+  ~CachingClient() override = default;
+
+  ClientOptions const& client_options() const override;
+
+  StatusOr<ListBucketsResponse> ListBuckets(
+      ListBucketsRequest const& request) override;
+  StatusOr<BucketMetadata> CreateBucket(
+      CreateBucketRequest const& request) override;
+  StatusOr<BucketMetadata> GetBucketMetadata(
+      GetBucketMetadataRequest const& request) override;
+  StatusOr<EmptyResponse> DeleteBucket(DeleteBucketRequest const&) override;
+  StatusOr<BucketMetadata> UpdateBucket(
+      UpdateBucketRequest const& request) override;
+  StatusOr<BucketMetadata> PatchBucket(
+      PatchBucketRequest const& request) override;
+  StatusOr<IamPolicy> GetBucketIamPolicy(
+      GetBucketIamPolicyRequest const& request) override;
+  StatusOr<NativeIamPolicy> GetNativeBucketIamPolicy(
+      GetBucketIamPolicyRequest const& request) override;
+  StatusOr<IamPolicy> SetBucketIamPolicy(
+      SetBucketIamPolicyRequest const& request) override;
+  StatusOr<NativeIamPolicy> SetNativeBucketIamPolicy(
+      SetNativeBucketIamPolicyRequest const& request) override;
+  StatusOr<TestBucketIamPermissionsResponse> TestBucketIamPermissions(
+      TestBucketIamPermissionsRequest const& request) override;
+  StatusOr<BucketMetadata> LockBucketRetentionPolicy(
+      LockBucketRetentionPolicyRequest const& request) override;
+
+  StatusOr<ObjectMetadata> InsertObjectMedia(
+      InsertObjectMediaRequest const& request) override;
+  StatusOr<ObjectMetadata> CopyObject(
+      CopyObjectRequest const& request) override;
+  StatusOr<ObjectMetadata> GetObjectMetadata(
+      GetObjectMetadataRequest const& request) override;
+  StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
+      ReadObjectRangeRequest const&) override;
+  StatusOr<ListObjectsResponse> ListObjects(ListObjectsRequest const&) override;
+  StatusOr<EmptyResponse> DeleteObject(DeleteObjectRequest const&) override;
+  StatusOr<ObjectMetadata> UpdateObject(
+      UpdateObjectRequest const& request) override;
+  StatusOr<ObjectMetadata> PatchObject(
+      PatchObjectRequest const& request) override;
+  StatusOr<ObjectMetadata> ComposeObject(
+      ComposeObjectRequest const& request) override;
+  StatusOr<RewriteObjectResponse> RewriteObject(
+      RewriteObjectRequest const&) override;
+  StatusOr<std::unique_ptr<ResumableUploadSession>> CreateResumableSession(
+      ResumableUploadRequest const& request) override;
+  StatusOr<std::unique_ptr<ResumableUploadSession>> RestoreResumableSession(
+      std::string const& request) override;
+  StatusOr<EmptyResponse> DeleteResumableUpload(
+      DeleteResumableUploadRequest const& request) override;
+
+  StatusOr<ListBucketAclResponse> ListBucketAcl(
+      ListBucketAclRequest const& request) override;
+  StatusOr<BucketAccessControl> CreateBucketAcl(
+      CreateBucketAclRequest const&) override;
+  StatusOr<EmptyResponse> DeleteBucketAcl(
+      DeleteBucketAclRequest const&) override;
+  StatusOr<BucketAccessControl> GetBucketAcl(
+      GetBucketAclRequest const&) override;
+  StatusOr<BucketAccessControl> UpdateBucketAcl(
+      UpdateBucketAclRequest const&) override;
+  StatusOr<BucketAccessControl> PatchBucketAcl(
+      PatchBucketAclRequest const&) override;
+
+  StatusOr<ListObjectAclResponse> ListObjectAcl(
+      ListObjectAclRequest const& request) override;
+  StatusOr<ObjectAccessControl> CreateObjectAcl(
+      CreateObjectAclRequest const&) override;
+  StatusOr<EmptyResponse> DeleteObjectAcl(
+      DeleteObjectAclRequest const&) override;
+  StatusOr<ObjectAccessControl> GetObjectAcl(
+      GetObjectAclRequest const&) override;
+  StatusOr<ObjectAccessControl> UpdateObjectAcl(
+      UpdateObjectAclRequest const&) override;
+  StatusOr<ObjectAccessControl> PatchObjectAcl(
+      PatchObjectAclRequest const&) override;
+
+  StatusOr<ListDefaultObjectAclResponse> ListDefaultObjectAcl(
+      ListDefaultObjectAclRequest const& request) override;
+  StatusOr<ObjectAccessControl> CreateDefaultObjectAcl(
+      CreateDefaultObjectAclRequest const&) override;
+  StatusOr<EmptyResponse> DeleteDefaultObjectAcl(
+      DeleteDefaultObjectAclRequest const&) override;
+  StatusOr<ObjectAccessControl> GetDefaultObjectAcl(
+      GetDefaultObjectAclRequest const&) override;
+  StatusOr<ObjectAccessControl> UpdateDefaultObjectAcl(
+      UpdateDefaultObjectAclRequest const&) override;
+  StatusOr<ObjectAccessControl> PatchDefaultObjectAcl(
+      PatchDefaultObjectAclRequest const&) override;
+
+  StatusOr<ServiceAccount> GetServiceAccount(
+      GetProjectServiceAccountRequest const&) override;
+  StatusOr<ListHmacKeysResponse> ListHmacKeys(
+      ListHmacKeysRequest const&) override;
+  StatusOr<CreateHmacKeyResponse> CreateHmacKey(
+      CreateHmacKeyRequest const&) override;
+  StatusOr<EmptyResponse> DeleteHmacKey(DeleteHmacKeyRequest const&) override;
+  StatusOr<HmacKeyMetadata> GetHmacKey(GetHmacKeyRequest const&) override;
+  StatusOr<HmacKeyMetadata> UpdateHmacKey(UpdateHmacKeyRequest const&) override;
+  StatusOr<SignBlobResponse> SignBlob(SignBlobRequest const&) override;
+
+  StatusOr<ListNotificationsResponse> ListNotifications(
+      ListNotificationsRequest const&) override;
+  StatusOr<NotificationMetadata> CreateNotification(
+      CreateNotificationRequest const&) override;
+  StatusOr<NotificationMetadata> GetNotification(
+      GetNotificationRequest const&) override;
+  StatusOr<EmptyResponse> DeleteNotification(
+      DeleteNotificationRequest const&) override;
+
+  std::shared_ptr<RawClient> client() const { return client_; }
+
+ private:
+  static std::string ObjectKey(std::string const& bucket_name,
+                               std::string const& object_name);
+
+  /// Record the result of an object mutation in the cache.
+  StatusOr<ObjectMetadata> RecordObjectMutation(
+      StatusOr<ObjectMetadata> result, std::string const& bucket_name,
+      std::string const& object_name);
+
+  /// Record the result of a bucket mutation in the cache.
+  StatusOr<BucketMetadata> RecordBucketMutation(
+      StatusOr<BucketMetadata> result, std::string const& bucket_name);
+
+  std::shared_ptr<RawClient> client_;
+  MetadataCache<ObjectMetadata> object_cache_;
+  MetadataCache<BucketMetadata> bucket_cache_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CACHING_CLIENT_H
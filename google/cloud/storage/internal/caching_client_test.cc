@@ -0,0 +1,188 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/caching_client.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Return;
+
+ObjectMetadata MockObject(std::string const& object_name,
+                          std::int64_t generation) {
+  std::ostringstream text;
+  text << R"""({"bucket": "test-bucket", "name": ")""" << object_name
+       << R"""(", "generation": )""" << generation
+       << R"""(, "kind": "storage#object"})""";
+  return ObjectMetadataParser::FromString(text.str()).value();
+}
+
+BucketMetadata MockBucket(std::string const& bucket_name) {
+  return BucketMetadataParser::FromString(R"""({"name": ")""" + bucket_name +
+                                          R"""(", "kind": "storage#bucket"})""")
+      .value();
+}
+
+TEST(MetadataCacheTest, LruEviction) {
+  MetadataCache<int> cache(2, std::chrono::minutes(5));
+  cache.Insert("a", 1);
+  cache.Insert("b", 2);
+  // Touch "a" so "b" is the least recently used entry.
+  EXPECT_TRUE(cache.Lookup("a").has_value());
+  cache.Insert("c", 3);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.Lookup("a").has_value());
+  EXPECT_FALSE(cache.Lookup("b").has_value());
+  EXPECT_TRUE(cache.Lookup("c").has_value());
+}
+
+TEST(MetadataCacheTest, TtlExpiration) {
+  MetadataCache<int> cache(16, std::chrono::milliseconds(0));
+  cache.Insert("a", 1);
+  EXPECT_FALSE(cache.Lookup("a").has_value());
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST(CachingClientTest, GetObjectMetadataCachesResults) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject("test-object", 7))));
+
+  CachingClient client(mock);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  auto first = client.GetObjectMetadata(request);
+  ASSERT_STATUS_OK(first);
+  auto second = client.GetObjectMetadata(request);
+  ASSERT_STATUS_OK(second);
+  EXPECT_EQ(first->generation(), second->generation());
+}
+
+TEST(CachingClientTest, GetObjectMetadataWithPreconditionBypassesCache) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly(Return(make_status_or(MockObject("test-object", 7))));
+
+  CachingClient client(mock);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  request.set_option(IfMetagenerationMatch(1));
+  ASSERT_STATUS_OK(client.GetObjectMetadata(request));
+  ASSERT_STATUS_OK(client.GetObjectMetadata(request));
+}
+
+TEST(CachingClientTest, GetObjectMetadataGenerationAware) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject("test-object", 7))))
+      .WillOnce(Return(make_status_or(MockObject("test-object", 3))));
+
+  CachingClient client(mock);
+  GetObjectMetadataRequest plain("test-bucket", "test-object");
+  ASSERT_STATUS_OK(client.GetObjectMetadata(plain));
+
+  // A request pinning the cached generation is served from the cache.
+  GetObjectMetadataRequest current("test-bucket", "test-object");
+  current.set_option(Generation(7));
+  auto actual = client.GetObjectMetadata(current);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(7, actual->generation());
+
+  // A request pinning an older generation goes to the service, and must not
+  // replace the cached (current) entry.
+  GetObjectMetadataRequest archived("test-bucket", "test-object");
+  archived.set_option(Generation(3));
+  actual = client.GetObjectMetadata(archived);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(3, actual->generation());
+
+  actual = client.GetObjectMetadata(plain);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(7, actual->generation());
+}
+
+TEST(CachingClientTest, DeleteObjectInvalidates) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly(Return(make_status_or(MockObject("test-object", 7))));
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Return(make_status_or(EmptyResponse{})));
+
+  CachingClient client(mock);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  ASSERT_STATUS_OK(client.GetObjectMetadata(request));
+  ASSERT_STATUS_OK(
+      client.DeleteObject(DeleteObjectRequest("test-bucket", "test-object")));
+  ASSERT_STATUS_OK(client.GetObjectMetadata(request));
+}
+
+TEST(CachingClientTest, MutationRefreshesCache) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(make_status_or(MockObject("test-object", 7))));
+  EXPECT_CALL(*mock, PatchObject(_))
+      .WillOnce(Return(make_status_or(MockObject("test-object", 8))));
+
+  CachingClient client(mock);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  ASSERT_STATUS_OK(client.GetObjectMetadata(request));
+  ASSERT_STATUS_OK(client.PatchObject(PatchObjectRequest(
+      "test-bucket", "test-object", ObjectMetadataPatchBuilder())));
+  // The metadata returned by the mutation is served without a new round-trip.
+  auto actual = client.GetObjectMetadata(request);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(8, actual->generation());
+}
+
+TEST(CachingClientTest, GetBucketMetadataCachesResults) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetBucketMetadata(_))
+      .WillOnce(Return(make_status_or(MockBucket("test-bucket"))));
+
+  CachingClient client(mock);
+  GetBucketMetadataRequest request("test-bucket");
+  ASSERT_STATUS_OK(client.GetBucketMetadata(request));
+  ASSERT_STATUS_OK(client.GetBucketMetadata(request));
+}
+
+TEST(CachingClientTest, ErrorsAreNotCached) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())))
+      .WillOnce(Return(make_status_or(MockObject("test-object", 7))));
+
+  CachingClient client(mock);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  EXPECT_EQ(PermanentError().code(),
+            client.GetObjectMetadata(request).status().code());
+  ASSERT_STATUS_OK(client.GetObjectMetadata(request));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
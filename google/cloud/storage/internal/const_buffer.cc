@@ -20,7 +20,9 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
-void PopFrontBytes(ConstBufferSequence& s, std::size_t count) {
+namespace {
+template <typename Buffer>
+void PopFrontBytesImpl(std::vector<Buffer>& s, std::size_t count) {
   auto i = s.begin();
   for (; i != s.end() && i->size() <= count; ++i) {
     count -= i->size();
@@ -35,9 +37,18 @@ void PopFrontBytes(ConstBufferSequence& s, std::size_t count) {
   //     https://godbolt.org/z/jw5VDd
   s.erase(s.begin(), i);
   if (count > 0 && !s.empty()) {
-    s.front() = ConstBuffer(s.front().data() + count, s.front().size() - count);
+    s.front() = Buffer(s.front().data() + count, s.front().size() - count);
   }
 }
+}  // namespace
+
+void PopFrontBytes(ConstBufferSequence& s, std::size_t count) {
+  PopFrontBytesImpl(s, count);
+}
+
+void PopFrontBytes(MutableBufferSequence& s, std::size_t count) {
+  PopFrontBytesImpl(s, count);
+}
 
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -42,6 +42,24 @@ inline std::size_t TotalBytes(ConstBufferSequence const& s) {
 /// Remove @p count bytes at the start of @p s
 void PopFrontBytes(ConstBufferSequence& s, std::size_t count);
 
+/// Represent a caller-owned writable memory range. Use to download with low
+/// copying.
+using MutableBuffer = absl::Span<char>;
+
+/// Represent a sequence of caller-owned writable memory ranges. Use to
+/// download with low copying.
+using MutableBufferSequence = std::vector<MutableBuffer>;
+
+/// The total number of bytes in the buffer sequence.
+inline std::size_t TotalBytes(MutableBufferSequence const& s) {
+  return std::accumulate(
+      s.begin(), s.end(), std::size_t{0},
+      [](std::size_t a, MutableBuffer const& b) { return a + b.size(); });
+}
+
+/// Remove @p count bytes at the start of @p s
+void PopFrontBytes(MutableBufferSequence& s, std::size_t count);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
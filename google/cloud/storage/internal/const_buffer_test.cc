@@ -78,6 +78,36 @@ TEST(ConstBufferTest, PopFrontPartial) {
   EXPECT_THAT(actual, ElementsAre(ConstBuffer{"C", 1}, ConstBuffer{"123", 3}));
 }
 
+TEST(MutableBufferTest, TotalBytes) {
+  std::vector<char> b0(4);
+  std::vector<char> b1(3);
+  MutableBufferSequence const actual{
+      MutableBuffer{b0.data(), b0.size()},
+      MutableBuffer{b1.data(), b1.size()},
+  };
+  EXPECT_EQ(7, TotalBytes(actual));
+}
+
+TEST(MutableBufferTest, PopFrontPartial) {
+  std::vector<char> b0(4);
+  std::vector<char> b1(3);
+  MutableBufferSequence actual{
+      MutableBuffer{b0.data(), b0.size()},
+      MutableBuffer{b1.data(), b1.size()},
+  };
+  PopFrontBytes(actual, 5);
+  ASSERT_EQ(1, actual.size());
+  EXPECT_EQ(b1.data() + 1, actual.front().data());
+  EXPECT_EQ(2, actual.front().size());
+}
+
+TEST(MutableBufferTest, PopFrontAll) {
+  std::vector<char> b0(4);
+  MutableBufferSequence actual{MutableBuffer{b0.data(), b0.size()}};
+  PopFrontBytes(actual, 8);
+  EXPECT_TRUE(actual.empty());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -0,0 +1,109 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/internal/big_endian.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// The CRC32C (Castagnoli) polynomial, in the reflected bit order used by
+// `crc32c::Extend()`.
+std::uint32_t constexpr kCrc32cPolynomial = 0x82f63b78;
+
+// Multiply a GF(2) 32x32 matrix by a GF(2) 32-vector. In this representation
+// addition is XOR, so the product is the XOR of the matrix columns selected by
+// the bits of @p vec.
+std::uint32_t Gf2MatrixTimes(std::uint32_t const* matrix, std::uint32_t vec) {
+  std::uint32_t sum = 0;
+  for (; vec != 0; vec >>= 1, ++matrix) {
+    if ((vec & 1) != 0) sum ^= *matrix;
+  }
+  return sum;
+}
+
+// Square a GF(2) 32x32 matrix, i.e. compute `square = matrix * matrix`.
+void Gf2MatrixSquare(std::uint32_t* square, std::uint32_t const* matrix) {
+  for (int n = 0; n != 32; ++n) {
+    square[n] = Gf2MatrixTimes(matrix, matrix[n]);
+  }
+}
+
+}  // namespace
+
+std::uint32_t Crc32cCombine(std::uint32_t crc_a, std::uint32_t crc_b,
+                            std::uint64_t b_size) {
+  // Appending an empty block does not change the checksum.
+  if (b_size == 0) return crc_a;
+
+  // CRCs are linear over GF(2): Crc32c(a + b) is Crc32c(a) advanced by
+  // b_size zero bytes, XORed with Crc32c(b). Advancing by one zero bit is a
+  // fixed linear operator; advancing by b_size zero bytes is that operator
+  // raised to the (8 * b_size)-th power, computed here by repeated squaring.
+  std::uint32_t even[32];  // operator for 2^{2k} zero bits
+  std::uint32_t odd[32];   // operator for 2^{2k+1} zero bits
+
+  // The operator for one zero bit: shift right and conditionally XOR the
+  // polynomial, expressed column by column.
+  odd[0] = kCrc32cPolynomial;
+  std::uint32_t row = 1;
+  for (int n = 1; n != 32; ++n) {
+    odd[n] = row;
+    row <<= 1;
+  }
+  // Square to get the operators for two and then four zero bits.
+  Gf2MatrixSquare(even, odd);
+  Gf2MatrixSquare(odd, even);
+
+  // Apply the zero-byte operators selected by the bits of b_size. The first
+  // squaring produces the operator for one zero byte (eight zero bits).
+  do {
+    Gf2MatrixSquare(even, odd);
+    if ((b_size & 1) != 0) crc_a = Gf2MatrixTimes(even, crc_a);
+    b_size >>= 1;
+    if (b_size == 0) break;
+    Gf2MatrixSquare(odd, even);
+    if ((b_size & 1) != 0) crc_a = Gf2MatrixTimes(odd, crc_a);
+    b_size >>= 1;
+  } while (b_size != 0);
+
+  return crc_a ^ crc_b;
+}
+
+StatusOr<std::string> Crc32cCombine(std::string const& crc_a,
+                                    std::string const& crc_b,
+                                    std::uint64_t b_size) {
+  auto decode = [](std::string const& value) -> StatusOr<std::uint32_t> {
+    auto bytes = Base64Decode(value);
+    return google::cloud::internal::DecodeBigEndian<std::uint32_t>(
+        std::string(bytes.begin(), bytes.end()));
+  };
+  auto a = decode(crc_a);
+  if (!a) return std::move(a).status();
+  auto b = decode(crc_b);
+  if (!b) return std::move(b).status();
+  auto const combined = Crc32cCombine(*a, *b, b_size);
+  return Base64Encode(google::cloud::internal::EncodeBigEndian(combined));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,61 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_COMBINE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_COMBINE_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Combine the CRC32C checksums of two consecutive blocks.
+ *
+ * Given `Crc32c(a)`, `Crc32c(b)`, and the size of `b`, computes `Crc32c(a+b)`
+ * without touching the payloads. The cost is O(log(b_size)), so shards of a
+ * parallel transfer can checksum their own data concurrently and the results
+ * can be folded into the full object checksum at negligible cost.
+ *
+ * The checksums use the same convention as `crc32c::Extend()`: start from
+ * zero, pre- and post-conditioned with `0xffffffff`.
+ */
+std::uint32_t Crc32cCombine(std::uint32_t crc_a, std::uint32_t crc_b,
+                            std::uint64_t b_size);
+
+/**
+ * Combine two CRC32C checksums in the GCS wire format.
+ *
+ * GCS metadata and headers represent CRC32C values as the base64 encoding of
+ * the checksum in big-endian order, e.g. `ObjectMetadata::crc32c()` or the
+ * result of `ComputeCrc32cChecksum()`. Returns `kInvalidArgument` if either
+ * input does not decode to a 32-bit value.
+ */
+StatusOr<std::string> Crc32cCombine(std::string const& crc_a,
+                                    std::string const& crc_b,
+                                    std::uint64_t b_size);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_COMBINE_H
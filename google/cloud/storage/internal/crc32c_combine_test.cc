@@ -0,0 +1,93 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include "google/cloud/storage/hashing_options.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <crc32c/crc32c.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::uint32_t Crc32c(std::string const& payload) {
+  return crc32c::Extend(
+      0, reinterpret_cast<std::uint8_t const*>(payload.data()),
+      payload.size());
+}
+
+TEST(Crc32cCombineTest, Simple) {
+  std::string const a = "The quick brown fox";
+  std::string const b = " jumps over the lazy dog";
+  EXPECT_EQ(Crc32c(a + b), Crc32cCombine(Crc32c(a), Crc32c(b), b.size()));
+}
+
+TEST(Crc32cCombineTest, EmptyBlocks) {
+  std::string const a = "The quick brown fox";
+  EXPECT_EQ(Crc32c(a), Crc32cCombine(Crc32c(a), Crc32c(""), 0));
+  EXPECT_EQ(Crc32c(a), Crc32cCombine(Crc32c(""), Crc32c(a), a.size()));
+}
+
+TEST(Crc32cCombineTest, ManyShards) {
+  // Simulate a sharded transfer: checksum each shard separately and fold the
+  // results, the combined value must match the checksum of the full payload.
+  std::string const payload(128 * 1024, 'a');
+  auto const shard_size = payload.size() / 8;
+  std::uint32_t combined = 0;
+  for (std::size_t offset = 0; offset != payload.size();
+       offset += shard_size) {
+    auto const shard = payload.substr(offset, shard_size);
+    combined = Crc32cCombine(combined, Crc32c(shard), shard.size());
+  }
+  EXPECT_EQ(Crc32c(payload), combined);
+}
+
+TEST(Crc32cCombineTest, UnevenSizes) {
+  std::string const payload =
+      "How vexingly quick daft zebras jump! Pack my box with five dozen "
+      "liquor jugs.";
+  for (std::size_t split = 0; split != payload.size() + 1; ++split) {
+    auto const a = payload.substr(0, split);
+    auto const b = payload.substr(split);
+    EXPECT_EQ(Crc32c(payload), Crc32cCombine(Crc32c(a), Crc32c(b), b.size()));
+  }
+}
+
+TEST(Crc32cCombineTest, Base64) {
+  std::string const a = "The quick brown fox";
+  std::string const b = " jumps over the lazy dog";
+  auto combined = Crc32cCombine(ComputeCrc32cChecksum(a),
+                                ComputeCrc32cChecksum(b), b.size());
+  ASSERT_STATUS_OK(combined);
+  EXPECT_EQ(ComputeCrc32cChecksum(a + b), *combined);
+}
+
+TEST(Crc32cCombineTest, Base64Invalid) {
+  auto const valid = ComputeCrc32cChecksum("The quick brown fox");
+  auto combined = Crc32cCombine("not-a-checksum", valid, 8);
+  EXPECT_EQ(StatusCode::kInvalidArgument, combined.status().code());
+  combined = Crc32cCombine(valid, "not-a-checksum", 8);
+  EXPECT_EQ(StatusCode::kInvalidArgument, combined.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -13,15 +13,24 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/curl_resumable_upload_session.h"
 #include "google/cloud/storage/internal/generate_message_boundary.h"
+#include "google/cloud/storage/internal/hash_validator_impl.h"
+#include "google/cloud/storage/internal/inflating_source.h"
+#include "google/cloud/storage/internal/json_string_builder.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/readahead_source.h"
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/internal/getenv.h"
 #include "google/cloud/terminate_handler.h"
 #include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <sstream>
 
 namespace google {
@@ -33,6 +42,13 @@ namespace {
 
 std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
     ClientOptions const& options) {
+  if (options.enable_shared_connection_pool()) {
+    auto constexpr kDefaultSharedPoolSize = std::size_t(64);
+    auto const size = options.connection_pool_size() != 0
+                          ? options.connection_pool_size()
+                          : kDefaultSharedPoolSize;
+    return GetSharedCurlHandleFactory(size, options.channel_options());
+  }
   if (options.connection_pool_size() == 0) {
     return std::make_shared<DefaultCurlHandleFactory>(
         options.channel_options());
@@ -46,6 +62,67 @@ std::string UrlEscapeString(std::string const& value) {
   return std::string(handle.MakeEscapedString(value).get());
 }
 
+/// The fixed-shape payload shared by the *Acl operations, serialized without
+/// an intermediate `nlohmann::json` object.
+std::string AclRolePayload(std::string const& entity, std::string const& role) {
+  std::string payload;
+  JsonStringBuilder builder(payload);
+  builder.StartObject();
+  builder.StringField("entity", entity);
+  builder.StringField("role", role);
+  builder.EndObject();
+  return payload;
+}
+
+/// The hashes to apply to an `InsertObject()` upload, either provided by the
+/// application or computed from the payload.
+struct UploadHashes {
+  absl::optional<std::string> md5;
+  absl::optional<std::string> crc32c;
+};
+
+/**
+ * Compute (or copy from the request options) the hashes for an upload.
+ *
+ * When both hashes are needed they are computed in a single chunked pass
+ * over the payload: the second hash reads each chunk while it is still warm
+ * in the cache, instead of making a second full traversal of a (possibly
+ * large) payload whose body is otherwise never copied.
+ */
+UploadHashes ComputeUploadHashes(InsertObjectMediaRequest const& request) {
+  UploadHashes result;
+  bool need_md5 = false;
+  bool need_crc32c = false;
+  if (request.HasOption<MD5HashValue>()) {
+    result.md5 = request.GetOption<MD5HashValue>().value();
+  } else if (!request.GetOption<DisableMD5Hash>().value()) {
+    need_md5 = true;
+  }
+  if (request.HasOption<Crc32cChecksumValue>()) {
+    result.crc32c = request.GetOption<Crc32cChecksumValue>().value();
+  } else if (!request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
+    need_crc32c = true;
+  }
+  if (need_md5 && need_crc32c) {
+    auto constexpr kChunkSize = std::size_t(64 * 1024);
+    MD5HashValidator md5;
+    Crc32cHashValidator crc32c;
+    auto const& payload = request.contents();
+    for (std::size_t offset = 0; offset < payload.size();
+         offset += kChunkSize) {
+      auto const n = (std::min)(kChunkSize, payload.size() - offset);
+      md5.Update(payload.data() + offset, n);
+      crc32c.Update(payload.data() + offset, n);
+    }
+    result.md5 = std::move(md5).Finish().computed;
+    result.crc32c = std::move(crc32c).Finish().computed;
+    return result;
+  }
+  if (need_md5) result.md5 = ComputeMD5Hash(request.contents());
+  if (need_crc32c) result.crc32c = ComputeCrc32cChecksum(request.contents());
+  return result;
+}
+
 template <typename ReturnType>
 StatusOr<ReturnType> ParseFromString(StatusOr<HttpResponse> response) {
   if (!response.ok()) {
@@ -100,8 +177,10 @@ Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
   }
   builder.SetMethod(method)
       .ApplyClientOptions(options_)
+      .SetTransportStats(transport_stats_)
+      .SetMultiEngine(multi_engine_)
       .AddHeader(auth_header.value())
-      .AddHeader("x-goog-api-client: " + x_goog_api_client());
+      .AddHeader(x_goog_api_client_header_);
   return Status();
 }
 
@@ -227,12 +306,20 @@ CurlClient::CreateResumableSessionGeneric(RequestType const& request) {
 
 CurlClient::CurlClient(ClientOptions options)
     : options_(std::move(options)),
+      x_goog_api_client_header_("x-goog-api-client: " + x_goog_api_client()),
       generator_(google::cloud::internal::MakeDefaultPRNG()),
+      transport_stats_(std::make_shared<CurlTransportStats>()),
+      multi_engine_(options_.curl_multi_io_threads() == 0
+                        ? nullptr
+                        : std::make_shared<CurlMultiEngine>(
+                              options_.curl_multi_io_threads())),
       storage_factory_(CreateHandleFactory(options_)),
       upload_factory_(CreateHandleFactory(options_)),
       xml_upload_factory_(CreateHandleFactory(options_)),
       xml_download_factory_(CreateHandleFactory(options_)) {
   storage_endpoint_ = options_.endpoint() + "/storage/" + options_.version();
+  batch_endpoint_ =
+      options_.endpoint() + "/batch/storage/" + options_.version();
   upload_endpoint_ =
       options_.endpoint() + "/upload/storage/" + options_.version();
   iam_endpoint_ = options_.iam_endpoint();
@@ -249,10 +336,23 @@ CurlClient::CurlClient(ClientOptions options)
   }
 
   CurlInitializeOnce(options);
+
+  if (options_.warmup_connection_count() != 0) {
+    // A no-op unless the factory pools handles. With the shared factory the
+    // warmed connections (and their TLS sessions) are visible to every other
+    // client using the same pool.
+    storage_factory_->WarmUp(storage_endpoint_,
+                             options_.warmup_connection_count());
+  }
 }
 
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
     UploadChunkRequest const& request) {
+  // Keep all the chunks of one resumable upload on the same pool shard, so
+  // consecutive chunks reuse the same handle (and connection). Distinct
+  // concurrent uploads hash to distinct keys and stripe across shards.
+  CurlHandleAffinityScope affinity(
+      std::hash<std::string>{}(request.upload_session_url()));
   CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
@@ -279,6 +379,8 @@ StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
 
 StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
     QueryResumableUploadRequest const& request) {
+  CurlHandleAffinityScope affinity(
+      std::hash<std::string>{}(request.upload_session_url()));
   CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
   auto status = SetupBuilder(builder, request, "PUT");
   if (!status.ok()) {
@@ -557,6 +659,70 @@ StatusOr<ObjectMetadata> CurlClient::GetObjectMetadata(
       builder.BuildRequest().MakeRequest(std::string{}));
 }
 
+StatusOr<BatchGetObjectMetadataResponse> CurlClient::BatchGetObjectMetadata(
+    BatchGetObjectMetadataRequest const& request) {
+  // The JSON API rejects batches with more than 100 calls, split larger
+  // requests and concatenate their results.
+  std::size_t const kMaxBatchSize = 100;
+  auto const& names = request.object_names();
+  if (names.size() > kMaxBatchSize) {
+    BatchGetObjectMetadataResponse full;
+    full.results.reserve(names.size());
+    auto shard = request;
+    for (std::size_t offset = 0; offset < names.size();
+         offset += kMaxBatchSize) {
+      auto const count = (std::min)(kMaxBatchSize, names.size() - offset);
+      shard.set_object_names(std::vector<std::string>(
+          names.begin() + offset, names.begin() + offset + count));
+      auto partial = BatchGetObjectMetadata(shard);
+      if (!partial) return partial;
+      std::move(partial->results.begin(), partial->results.end(),
+                std::back_inserter(full.results));
+    }
+    return full;
+  }
+
+  CurlRequestBuilder builder(batch_endpoint_, storage_factory_);
+  auto status = SetupBuilderCommon(builder, "POST");
+  if (!status.ok()) {
+    return status;
+  }
+  auto boundary = PickBoundary();
+  builder.AddHeader("content-type: multipart/mixed; boundary=" + boundary);
+
+  std::string const crlf = "\r\n";
+  std::string const marker = "--" + boundary;
+  std::ostringstream writer;
+  for (auto const& name : names) {
+    std::string target = "/storage/" + options_.version() + "/b/" +
+                         request.bucket_name() + "/o/" + UrlEscapeString(name);
+    char const* sep = "?";
+    if (request.HasOption<Projection>()) {
+      target += sep;
+      target += "projection=" + request.GetOption<Projection>().value();
+      sep = "&";
+    }
+    if (request.HasOption<UserProject>()) {
+      target += sep;
+      target +=
+          "userProject=" +
+          UrlEscapeString(request.GetOption<UserProject>().value());
+    }
+    writer << marker << crlf << "Content-Type: application/http" << crlf
+           << crlf << "GET " << target << " HTTP/1.1" << crlf << crlf;
+  }
+  writer << marker << "--" << crlf;
+
+  auto contents = std::move(writer).str();
+  builder.AddHeader("Content-Length: " + std::to_string(contents.size()));
+  auto response = builder.BuildRequest().MakeRequest(contents);
+  if (!response) {
+    return std::move(response).status();
+  }
+  return BatchGetObjectMetadataResponse::FromHttpResponse(*response,
+                                                          names.size());
+}
+
 StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
     ReadObjectRangeRequest const& request) {
   if (!request.HasOption<IfMetagenerationNotMatch>() &&
@@ -580,8 +746,16 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
     builder.AddHeader("Cache-Control: no-transform");
   }
 
-  return std::unique_ptr<ObjectReadSource>(
-      new CurlDownloadRequest(builder.BuildDownloadRequest(std::string{})));
+  // The inflating source wraps the readahead source (and not the other way
+  // around) so decompression on the application's thread overlaps with the
+  // network transfer on the readahead thread.
+  return CreateInflatingSource(
+      request,
+      CreateReadaheadSource(request, options_.download_buffer_size(),
+                            std::unique_ptr<ObjectReadSource>(
+                                new CurlDownloadRequest(
+                                    builder.BuildDownloadRequest(
+                                        std::string{})))));
 }
 
 StatusOr<ListObjectsResponse> CurlClient::ListObjects(
@@ -765,11 +939,9 @@ StatusOr<BucketAccessControl> CurlClient::CreateBucketAcl(
     return status;
   }
   builder.AddHeader("Content-Type: application/json");
-  nlohmann::json object;
-  object["entity"] = request.entity();
-  object["role"] = request.role();
   return CheckedFromString<internal::BucketAccessControlParser>(
-      builder.BuildRequest().MakeRequest(object.dump()));
+      builder.BuildRequest().MakeRequest(
+          AclRolePayload(request.entity(), request.role())));
 }
 
 StatusOr<EmptyResponse> CurlClient::DeleteBucketAcl(
@@ -794,11 +966,9 @@ StatusOr<BucketAccessControl> CurlClient::UpdateBucketAcl(
     return status;
   }
   builder.AddHeader("Content-Type: application/json");
-  nlohmann::json patch;
-  patch["entity"] = request.entity();
-  patch["role"] = request.role();
   return CheckedFromString<internal::BucketAccessControlParser>(
-      builder.BuildRequest().MakeRequest(patch.dump()));
+      builder.BuildRequest().MakeRequest(
+          AclRolePayload(request.entity(), request.role())));
 }
 
 StatusOr<BucketAccessControl> CurlClient::PatchBucketAcl(
@@ -841,11 +1011,9 @@ StatusOr<ObjectAccessControl> CurlClient::CreateObjectAcl(
     return status;
   }
   builder.AddHeader("Content-Type: application/json");
-  nlohmann::json object;
-  object["entity"] = request.entity();
-  object["role"] = request.role();
   return CheckedFromString<ObjectAccessControlParser>(
-      builder.BuildRequest().MakeRequest(object.dump()));
+      builder.BuildRequest().MakeRequest(
+          AclRolePayload(request.entity(), request.role())));
 }
 
 StatusOr<EmptyResponse> CurlClient::DeleteObjectAcl(
@@ -889,11 +1057,9 @@ StatusOr<ObjectAccessControl> CurlClient::UpdateObjectAcl(
     return status;
   }
   builder.AddHeader("Content-Type: application/json");
-  nlohmann::json object;
-  object["entity"] = request.entity();
-  object["role"] = request.role();
   return CheckedFromString<ObjectAccessControlParser>(
-      builder.BuildRequest().MakeRequest(object.dump()));
+      builder.BuildRequest().MakeRequest(
+          AclRolePayload(request.entity(), request.role())));
 }
 
 StatusOr<ObjectAccessControl> CurlClient::PatchObjectAcl(
@@ -935,12 +1101,10 @@ StatusOr<ObjectAccessControl> CurlClient::CreateDefaultObjectAcl(
   if (!status.ok()) {
     return status;
   }
-  nlohmann::json object;
-  object["entity"] = request.entity();
-  object["role"] = request.role();
   builder.AddHeader("Content-Type: application/json");
   return CheckedFromString<ObjectAccessControlParser>(
-      builder.BuildRequest().MakeRequest(object.dump()));
+      builder.BuildRequest().MakeRequest(
+          AclRolePayload(request.entity(), request.role())));
 }
 
 StatusOr<EmptyResponse> CurlClient::DeleteDefaultObjectAcl(
@@ -981,11 +1145,9 @@ StatusOr<ObjectAccessControl> CurlClient::UpdateDefaultObjectAcl(
     return status;
   }
   builder.AddHeader("Content-Type: application/json");
-  nlohmann::json object;
-  object["entity"] = request.entity();
-  object["role"] = request.role();
   return CheckedFromString<ObjectAccessControlParser>(
-      builder.BuildRequest().MakeRequest(object.dump()));
+      builder.BuildRequest().MakeRequest(
+          AclRolePayload(request.entity(), request.role())));
 }
 
 StatusOr<ObjectAccessControl> CurlClient::PatchDefaultObjectAcl(
@@ -1208,18 +1370,12 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
     builder.AddHeader("x-goog-encryption-kms-key-name: " +
                       request.GetOption<KmsKeyName>().value());
   }
-  if (request.HasOption<MD5HashValue>()) {
-    builder.AddHeader("x-goog-hash: md5=" +
-                      request.GetOption<MD5HashValue>().value());
-  } else if (!request.GetOption<DisableMD5Hash>().value()) {
-    builder.AddHeader("x-goog-hash: md5=" + ComputeMD5Hash(request.contents()));
+  auto hashes = ComputeUploadHashes(request);
+  if (hashes.md5) {
+    builder.AddHeader("x-goog-hash: md5=" + *hashes.md5);
   }
-  if (request.HasOption<Crc32cChecksumValue>()) {
-    builder.AddHeader("x-goog-hash: crc32c=" +
-                      request.GetOption<Crc32cChecksumValue>().value());
-  } else if (!request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
-    builder.AddHeader("x-goog-hash: crc32c=" +
-                      ComputeCrc32cChecksum(request.contents()));
+  if (hashes.crc32c) {
+    builder.AddHeader("x-goog-hash: crc32c=" + *hashes.crc32c);
   }
   if (request.HasOption<PredefinedAcl>()) {
     builder.AddHeader("x-goog-acl: " +
@@ -1302,8 +1458,16 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
     builder.AddHeader("Cache-Control: no-transform");
   }
 
-  return std::unique_ptr<ObjectReadSource>(
-      new CurlDownloadRequest(builder.BuildDownloadRequest(std::string{})));
+  // The inflating source wraps the readahead source (and not the other way
+  // around) so decompression on the application's thread overlaps with the
+  // network transfer on the readahead thread.
+  return CreateInflatingSource(
+      request,
+      CreateReadaheadSource(request, options_.download_buffer_size(),
+                            std::unique_ptr<ObjectReadSource>(
+                                new CurlDownloadRequest(
+                                    builder.BuildDownloadRequest(
+                                        std::string{})))));
 }
 
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
@@ -1320,41 +1484,29 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   }
 
   // 2. Pick a separator that does not conflict with the request contents.
-  auto boundary = PickBoundary(request.contents());
+  auto boundary = PickBoundary();
   builder.AddHeader("content-type: multipart/related; boundary=" + boundary);
   builder.AddQueryParameter("uploadType", "multipart");
   builder.AddQueryParameter("name", request.object_name());
 
-  // 3. Perform a streaming upload because computing the size upfront is more
-  //    complicated than it is worth.
-  std::ostringstream writer;
-
+  // 3. Compute the metadata for the first part.
   nlohmann::json metadata = nlohmann::json::object();
   if (request.HasOption<WithObjectMetadata>()) {
     metadata = ObjectMetadataJsonForInsert(
         request.GetOption<WithObjectMetadata>().value());
   }
-  if (request.HasOption<MD5HashValue>()) {
-    metadata["md5Hash"] = request.GetOption<MD5HashValue>().value();
-  } else if (!request.GetOption<DisableMD5Hash>().value()) {
-    metadata["md5Hash"] = ComputeMD5Hash(request.contents());
-  }
-
-  if (request.HasOption<Crc32cChecksumValue>()) {
-    metadata["crc32c"] = request.GetOption<Crc32cChecksumValue>().value();
-  } else if (!request.GetOption<DisableCrc32cChecksum>().value_or(false)) {
-    metadata["crc32c"] = ComputeCrc32cChecksum(request.contents());
-  }
+  auto hashes = ComputeUploadHashes(request);
+  if (hashes.md5) metadata["md5Hash"] = *hashes.md5;
+  if (hashes.crc32c) metadata["crc32c"] = *hashes.crc32c;
 
   std::string crlf = "\r\n";
   std::string marker = "--" + boundary;
 
-  // 4. Format the first part, including the separators and the headers.
+  // 4. Format everything before the media: the separators, the metadata
+  //    part, and the headers of the media part.
+  std::ostringstream writer;
   writer << marker << crlf << "content-type: application/json; charset=UTF-8"
-         << crlf << crlf << metadata.dump() << crlf << marker << crlf;
-
-  // 5. Format the second part, which includes all the contents and a final
-  //    separator.
+         << crlf << crlf << metadata << crlf << marker << crlf;
   if (request.HasOption<ContentType>()) {
     writer << "content-type: " << request.GetOption<ContentType>().value()
            << crlf;
@@ -1364,32 +1516,35 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
   } else {
     writer << "content-type: application/octet-stream" << crlf;
   }
-  writer << crlf << request.contents() << crlf << marker << "--" << crlf;
+  writer << crlf;
+  auto preamble = std::move(writer).str();
+  auto const trailer = crlf + marker + "--" + crlf;
+
+  // 5. Send the media as a scatter-gather upload. The (possibly large)
+  //    contents go to the wire straight from the request, without being
+  //    copied into a composed body first.
+  ConstBufferSequence payload{
+      ConstBuffer{preamble.data(), preamble.size()},
+      ConstBuffer{request.contents().data(), request.contents().size()},
+      ConstBuffer{trailer.data(), trailer.size()}};
 
   // 6. Return the results as usual.
-  auto contents = std::move(writer).str();
-  builder.AddHeader("Content-Length: " + std::to_string(contents.size()));
+  builder.AddHeader("Content-Length: " + std::to_string(TotalBytes(payload)));
   return CheckedFromString<ObjectMetadataParser>(
-      builder.BuildRequest().MakeRequest(contents));
+      builder.BuildRequest().MakeUploadRequest(std::move(payload)));
 }
 
-std::string CurlClient::PickBoundary(std::string const& text_to_avoid) {
-  // We need to find a string that is *not* found in `text_to_avoid`, we pick
-  // a string at random, and see if it is in `text_to_avoid`, if it is, we grow
-  // the string with random characters and start from where we last found a
-  // the candidate.  Eventually we will find something, though it might be
-  // larger than `text_to_avoid`.  And we only make (approximately) one pass
-  // over `text_to_avoid`.
+std::string CurlClient::PickBoundary() {
+  // The boundary is long enough that the probability of it appearing in the
+  // payload is negligible, so there is no need to scan the payload for
+  // collisions. That scan was pure overhead on every upload.
   auto generate_candidate = [this](int n) {
     static std::string const kChars =
         "abcdefghijklmnopqrstuvwxyz012456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
     std::unique_lock<std::mutex> lk(mu_);
     return google::cloud::internal::Sample(generator_, n, kChars);
   };
-  constexpr int kCandidateInitialSize = 16;
-  constexpr int kCandidateGrowthSize = 4;
-  return GenerateMessageBoundary(text_to_avoid, std::move(generate_candidate),
-                                 kCandidateInitialSize, kCandidateGrowthSize);
+  return GenerateRandomMessageBoundary(std::move(generate_candidate));
 }
 
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaSimple(
@@ -16,6 +16,8 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_CLIENT_H
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include "google/cloud/storage/internal/curl_multi_engine.h"
+#include "google/cloud/storage/internal/curl_transport_stats.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/oauth2/credentials.h"
@@ -69,6 +71,16 @@ class CurlClient : public RawClient,
 
   ClientOptions const& client_options() const override { return options_; }
 
+  /**
+   * The socket-level telemetry accumulated by this client.
+   *
+   * The counters cover all the requests issued through this client, call
+   * `CurlTransportStats::Snapshot()` to read them.
+   */
+  std::shared_ptr<CurlTransportStats const> transport_stats() const {
+    return transport_stats_;
+  }
+
   StatusOr<ListBucketsResponse> ListBuckets(
       ListBucketsRequest const& request) override;
   StatusOr<BucketMetadata> CreateBucket(
@@ -97,6 +109,8 @@ class CurlClient : public RawClient,
       InsertObjectMediaRequest const& request) override;
   StatusOr<ObjectMetadata> GetObjectMetadata(
       GetObjectMetadataRequest const& request) override;
+  StatusOr<BatchGetObjectMetadataResponse> BatchGetObjectMetadata(
+      BatchGetObjectMetadataRequest const& request) override;
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
   StatusOr<ListObjectsResponse> ListObjects(
@@ -204,7 +218,7 @@ class CurlClient : public RawClient,
   /// Insert an object using uploadType=multipart.
   StatusOr<ObjectMetadata> InsertObjectMediaMultipart(
       InsertObjectMediaRequest const& request);
-  std::string PickBoundary(std::string const& text_to_avoid);
+  std::string PickBoundary();
 
   /// Insert an object using uploadType=media.
   StatusOr<ObjectMetadata> InsertObjectMediaSimple(
@@ -215,7 +229,11 @@ class CurlClient : public RawClient,
   CreateResumableSessionGeneric(RequestType const& request);
 
   ClientOptions options_;
+  // This header is the same for all requests, building it once saves several
+  // allocations per request.
+  std::string x_goog_api_client_header_;
   std::string storage_endpoint_;
+  std::string batch_endpoint_;
   std::string upload_endpoint_;
   std::string xml_upload_endpoint_;
   std::string xml_download_endpoint_;
@@ -224,6 +242,8 @@ class CurlClient : public RawClient,
   std::mutex mu_;
   google::cloud::internal::DefaultPRNG generator_;  // GUARDED_BY(mu_);
 
+  std::shared_ptr<CurlTransportStats> transport_stats_;
+  std::shared_ptr<CurlMultiEngine> multi_engine_;
   std::shared_ptr<CurlHandleFactory> storage_factory_;
   std::shared_ptr<CurlHandleFactory> upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_upload_factory_;
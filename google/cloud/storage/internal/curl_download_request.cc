@@ -54,11 +54,17 @@ extern "C" std::size_t CurlDownloadRequestHeader(char* contents,
                  << ", closing=" << closing_ << ", closed=" << curl_closed_ \
                  << ", paused=" << paused_ << ", in_multi=" << in_multi_
 
+// We get better performance using a slightly larger buffer (128KiB) than the
+// default buffer size set by libcurl (16KiB). Note that libcurl may deliver
+// blocks as large as this buffer to `WriteCallback()`, so the spill buffer
+// must be at least this large too.
+auto constexpr kDownloadBufferSize = 128 * 1024L;
+
 CurlDownloadRequest::CurlDownloadRequest()
     : headers_(nullptr, &curl_slist_free_all),
       download_stall_timeout_(0),
       multi_(nullptr, &curl_multi_cleanup),
-      spill_(CURL_MAX_WRITE_SIZE) {}
+      spill_(kDownloadBufferSize) {}
 
 template <typename Predicate>
 Status CurlDownloadRequest::Wait(Predicate predicate) {
@@ -204,16 +210,12 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
 }
 
 void CurlDownloadRequest::SetOptions() {
-  // We get better performance using a slightly larger buffer (128KiB) than the
-  // default buffer size set by libcurl (16KiB)
-  auto constexpr kDefaultBufferSize = 128 * 1024L;
-
   handle_.SetOption(CURLOPT_URL, url_.c_str());
   handle_.SetOption(CURLOPT_HTTPHEADER, headers_.get());
   handle_.SetOption(CURLOPT_USERAGENT, user_agent_.c_str());
   handle_.SetOption(CURLOPT_NOSIGNAL, 1L);
   handle_.SetOption(CURLOPT_NOPROGRESS, 1L);
-  handle_.SetOption(CURLOPT_BUFFERSIZE, kDefaultBufferSize);
+  handle_.SetOption(CURLOPT_BUFFERSIZE, kDownloadBufferSize);
   if (!payload_.empty()) {
     handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload_.length());
     handle_.SetOption(CURLOPT_POSTFIELDS, payload_.c_str());
@@ -267,7 +269,7 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   if (buffer_offset_ >= buffer_size_) {
     TRACE_STATE() << " *** PAUSING HANDLE ***";
     paused_ = true;
-    return CURL_READFUNC_PAUSE;
+    return CURL_WRITEFUNC_PAUSE;
   }
 
   // Use the spill buffer first, if there is any...
@@ -276,7 +278,16 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   if (free == 0) {
     TRACE_STATE() << " *** PAUSING HANDLE ***";
     paused_ = true;
-    return CURL_READFUNC_PAUSE;
+    return CURL_WRITEFUNC_PAUSE;
+  }
+  // The spill buffer is the high watermark for data buffered past the
+  // application buffer. If the incoming block does not fit, pause the transfer
+  // instead of growing the buffers without bound; libcurl re-delivers the same
+  // block when the next `Read()` resumes the transfer and drains the buffers.
+  if (size * nmemb > free + (spill_.size() - spill_offset_)) {
+    TRACE_STATE() << " *** PAUSING HANDLE ***";
+    paused_ = true;
+    return CURL_WRITEFUNC_PAUSE;
   }
   TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
 
@@ -347,6 +358,9 @@ StatusOr<int> CurlDownloadRequest::PerformWork() {
       // Whatever the status is, the transfer is done, we need to remove it
       // from the CURLM* interface.
       curl_closed_ = true;
+      if (transport_stats_) {
+        handle_.RecordTransportStats(*transport_stats_);
+      }
       Status multi_remove_status;
       if (in_multi_) {
         // In the extremely unlikely case that removing the handle from CURLM*
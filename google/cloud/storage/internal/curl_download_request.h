@@ -116,6 +116,7 @@ class CurlDownloadRequest : public ObjectReadSource {
   CurlHandle handle_;
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
+  std::shared_ptr<CurlTransportStats> transport_stats_;
 
   // Explicitly closing the handle happens in two steps.
   // 1. First the application (or higher-level class), calls Close(). This class
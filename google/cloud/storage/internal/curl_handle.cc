@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/binary_data_as_debug_string.h"
+#include "google/cloud/storage/internal/curl_multi_engine.h"
 #include "google/cloud/internal/strerror.h"
 #include "google/cloud/log.h"
 #ifdef _WIN32
@@ -134,6 +135,31 @@ void CurlHandle::ResetSocketCallback() {
   SetOption(CURLOPT_SOCKOPTFUNCTION, nullptr);
 }
 
+void CurlHandle::RecordTransportStats(CurlTransportStats& stats) {
+  auto get_time = [this](CURLINFO info) {
+    double seconds = 0;
+    if (curl_easy_getinfo(handle_.get(), info, &seconds) != CURLE_OK) {
+      return std::chrono::microseconds(0);
+    }
+    return std::chrono::microseconds(
+        static_cast<std::int64_t>(seconds * 1000000));
+  };
+  auto const dns = get_time(CURLINFO_NAMELOOKUP_TIME);
+  auto const connect = get_time(CURLINFO_CONNECT_TIME);
+  auto const tls = get_time(CURLINFO_APPCONNECT_TIME);
+  auto const ttfb = get_time(CURLINFO_STARTTRANSFER_TIME);
+  long new_connections = 0;  // NOLINT(google-runtime-int)
+  (void)curl_easy_getinfo(handle_.get(), CURLINFO_NUM_CONNECTS,
+                          &new_connections);
+  // libcurl reports cumulative times since the start of the transfer, convert
+  // them to the incremental cost of each phase. A reused connection reports
+  // (almost) zero for all the setup phases.
+  stats.RecordRequest(
+      dns, connect > dns ? connect - dns : std::chrono::microseconds(0),
+      tls > connect ? tls - connect : std::chrono::microseconds(0), ttfb,
+      new_connections);
+}
+
 void CurlHandle::EnableLogging(bool enabled) {
   if (enabled) {
     SetOption(CURLOPT_DEBUGDATA, &debug_buffer_);
@@ -146,6 +172,10 @@ void CurlHandle::EnableLogging(bool enabled) {
   }
 }
 
+Status CurlHandle::PerformOn(CurlMultiEngine& engine) {
+  return AsStatus(engine.Perform(handle_.get()), __func__);
+}
+
 void CurlHandle::FlushDebug(char const* where) {
   if (!debug_buffer_.empty()) {
     GCP_LOG(DEBUG) << where << ' ' << debug_buffer_;
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_H
 
 #include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/internal/curl_transport_stats.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
@@ -26,6 +27,8 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+class CurlMultiEngine;
+
 /**
  * Wraps CURL* handles in a safer C++ interface.
  *
@@ -78,6 +81,15 @@ class CurlHandle {
     return AsStatus(e, __func__);
   }
 
+  /**
+   * Runs the transfer on @p engine instead of `curl_easy_perform()`.
+   *
+   * Blocks until the transfer completes, but the I/O is driven by the
+   * engine's event-loop threads, so many calling threads can wait on a few
+   * I/O threads.
+   */
+  Status PerformOn(CurlMultiEngine& engine);
+
   StatusOr<long> GetResponseCode() {  // NOLINT(google-runtime-int)
     long code;                        // NOLINT(google-runtime-int)
     auto e = curl_easy_getinfo(handle_.get(), CURLINFO_RESPONSE_CODE, &code);
@@ -94,6 +106,16 @@ class CurlHandle {
 
   void EnableLogging(bool enabled);
 
+  /**
+   * Harvest the socket-level telemetry for the just-completed request.
+   *
+   * Reads the `CURLINFO_*` counters (DNS, connect, and TLS handshake times,
+   * time-to-first-byte, and connection reuse) and records them in @p stats.
+   * Call after `EasyPerform()` (or after a multi-handle transfer completes),
+   * the counters are only meaningful at that point.
+   */
+  void RecordTransportStats(CurlTransportStats& stats);
+
   /// Flushes any debug data using GCP_LOG().
   void FlushDebug(char const* where);
 
@@ -106,6 +128,7 @@ class CurlHandle {
   friend class CurlDownloadRequest;
   friend class CurlRequestBuilder;
   friend class CurlHandleFactory;
+  friend class PooledCurlHandleFactory;
 
   [[noreturn]] static void ThrowSetOptionError(CURLcode e, CURLoption opt,
                                                std::intmax_t param);
@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_handle_factory.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -50,6 +54,20 @@ std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
   return GetDefaultCurlHandleFactory();
 }
 
+std::shared_ptr<CurlHandleFactory> GetSharedCurlHandleFactory(
+    std::size_t pool_size, ChannelOptions const& options) {
+  static std::mutex mu;
+  // Never destroyed: clients may outlive static destructors.
+  static auto& factories =
+      *new std::map<std::string, std::shared_ptr<CurlHandleFactory>>;
+  std::lock_guard<std::mutex> lk(mu);
+  auto& factory = factories[options.ssl_root_path()];
+  if (!factory) {
+    factory = std::make_shared<PooledCurlHandleFactory>(pool_size, options);
+  }
+  return factory;
+}
+
 CurlPtr DefaultCurlHandleFactory::CreateHandle() {
   CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
   SetCurlOptions(curl.get(), options_);
@@ -72,32 +90,92 @@ CurlMulti DefaultCurlHandleFactory::CreateMultiHandle() {
 
 void DefaultCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) { m.reset(); }
 
+namespace {
+std::size_t DefaultShardCount(std::size_t maximum_size) {
+  auto constexpr kMaxShards = std::size_t(16);
+  std::size_t shards = std::thread::hardware_concurrency();
+  if (shards == 0) shards = 1;
+  shards = (std::min)(shards, kMaxShards);
+  // There is no point in having more shards than pooled handles.
+  return (std::min)(shards, (std::max)(maximum_size, std::size_t(1)));
+}
+}  // namespace
+
 PooledCurlHandleFactory::PooledCurlHandleFactory(std::size_t maximum_size,
                                                  ChannelOptions options)
     : maximum_size_(maximum_size), options_(std::move(options)) {
-  handles_.reserve(maximum_size);
-  multi_handles_.reserve(maximum_size);
+  auto const shard_count = DefaultShardCount(maximum_size);
+  shard_capacity_ = (std::max)(maximum_size_ / shard_count, std::size_t(1));
+  shards_.reserve(shard_count);
+  for (std::size_t i = 0; i != shard_count; ++i) {
+    shards_.emplace_back(new Shard);
+    shards_.back()->handles.reserve(shard_capacity_);
+    shards_.back()->multi_handles.reserve(shard_capacity_);
+  }
 }
 
 PooledCurlHandleFactory::~PooledCurlHandleFactory() {
-  for (auto* h : handles_) {
-    curl_easy_cleanup(h);
-  }
-  for (auto* m : multi_handles_) {
-    curl_multi_cleanup(m);
+  for (auto const& shard : shards_) {
+    for (auto* h : shard->handles) {
+      curl_easy_cleanup(h);
+    }
+    for (auto* m : shard->multi_handles) {
+      curl_multi_cleanup(m);
+    }
   }
 }
 
+CurlHandleAffinityScope::State& CurlHandleAffinityScope::ThreadState() {
+  thread_local State state;
+  return state;
+}
+
+CurlHandleAffinityScope::CurlHandleAffinityScope(std::size_t key)
+    : previous_(ThreadState()) {
+  auto& state = ThreadState();
+  state.active = true;
+  state.key = key;
+}
+
+CurlHandleAffinityScope::~CurlHandleAffinityScope() {
+  ThreadState() = previous_;
+}
+
+PooledCurlHandleFactory::Shard& PooledCurlHandleFactory::PreferredShard() {
+  auto const& affinity = CurlHandleAffinityScope::ThreadState();
+  if (affinity.active) return *shards_[affinity.key % shards_.size()];
+  auto const hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  return *shards_[hash % shards_.size()];
+}
+
 CurlPtr PooledCurlHandleFactory::CreateHandle() {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (!handles_.empty()) {
-    CURL* handle = handles_.back();
-    // Clear all the options in the handle so we do not leak its previous state.
-    (void)curl_easy_reset(handle);
-    handles_.pop_back();
-    CurlPtr curl(handle, &curl_easy_cleanup);
-    SetCurlOptions(curl.get(), options_);
-    return curl;
+  auto& preferred = PreferredShard();
+  {
+    std::unique_lock<std::mutex> lk(preferred.mu);
+    if (!preferred.handles.empty()) {
+      CURL* handle = preferred.handles.back();
+      preferred.handles.pop_back();
+      lk.unlock();
+      pooled_handles_.fetch_sub(1, std::memory_order_relaxed);
+      // Handles are normalized in `CleanupHandle()` before they enter the
+      // pool: all the options are reset and the factory-wide options are
+      // applied. Reuse therefore requires no setopt calls at all, which
+      // matters on the small-object hot path.
+      return CurlPtr(handle, &curl_easy_cleanup);
+    }
+  }
+  // The preferred shard is empty, steal from any other shard before creating
+  // a new handle.
+  for (auto const& shard : shards_) {
+    if (shard.get() == &preferred) continue;
+    std::unique_lock<std::mutex> lk(shard->mu);
+    if (shard->handles.empty()) continue;
+    CURL* handle = shard->handles.back();
+    shard->handles.pop_back();
+    lk.unlock();
+    pooled_handles_.fetch_sub(1, std::memory_order_relaxed);
+    steal_count_.fetch_add(1, std::memory_order_relaxed);
+    return CurlPtr(handle, &curl_easy_cleanup);
   }
   CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
   SetCurlOptions(curl.get(), options_);
@@ -105,41 +183,99 @@ CurlPtr PooledCurlHandleFactory::CreateHandle() {
 }
 
 void PooledCurlHandleFactory::CleanupHandle(CurlHandle&& h) {
-  std::unique_lock<std::mutex> lk(mu_);
   char* ip;
   auto res = curl_easy_getinfo(GetHandle(h), CURLINFO_LOCAL_IP, &ip);
   if (res == CURLE_OK && ip != nullptr) {
+    std::lock_guard<std::mutex> lk(mu_);
     last_client_ip_address_ = ip;
   }
-  if (handles_.size() >= maximum_size_) {
-    CURL* tmp = handles_.front();
-    handles_.erase(handles_.begin());
+  // Normalize the handle before it enters the pool: clear all the options so
+  // the previous request does not leak state, and apply the factory-wide
+  // options. This runs after the response has been delivered, so the cost is
+  // off the request hot path and `CreateHandle()` can reuse pooled handles
+  // without touching their configuration. Note that `curl_easy_reset()`
+  // preserves the live connections, the session ID cache, and the DNS cache.
+  (void)curl_easy_reset(GetHandle(h));
+  SetCurlOptions(GetHandle(h), options_);
+  auto& shard = PreferredShard();
+  std::unique_lock<std::mutex> lk(shard.mu);
+  if (shard.handles.size() >= shard_capacity_) {
+    CURL* tmp = shard.handles.front();
+    shard.handles.erase(shard.handles.begin());
+    lk.unlock();
     curl_easy_cleanup(tmp);
+    lk.lock();
+  } else {
+    pooled_handles_.fetch_add(1, std::memory_order_relaxed);
   }
-  handles_.push_back(GetHandle(h));
-  // The handles_ vector now has ownership, so release it.
+  shard.handles.push_back(GetHandle(h));
+  // The shard now has ownership, so release it.
   ReleaseHandle(h);
 }
 
+std::size_t PooledCurlHandleFactory::WarmUp(std::string const& endpoint,
+                                            std::size_t count) {
+  count = (std::min)(count, maximum_size_);
+  std::size_t established = 0;
+  for (std::size_t i = 0; i != count; ++i) {
+    // Stripe the warmed handles across the shards, so later transfers find a
+    // warm connection regardless of which shard serves them.
+    CurlHandleAffinityScope affinity(i);
+    auto ptr = CreateHandle();
+    curl_easy_setopt(ptr.get(), CURLOPT_URL, endpoint.c_str());
+    curl_easy_setopt(ptr.get(), CURLOPT_CONNECT_ONLY, 1L);
+    curl_easy_setopt(ptr.get(), CURLOPT_NOSIGNAL, 1L);
+    auto e = curl_easy_perform(ptr.get());
+    if (e != CURLE_OK) break;
+    ++established;
+    // `CleanupHandle()` resets the handle, which clears `CURLOPT_CONNECT_ONLY`
+    // but preserves the connection and TLS session caches, and returns the
+    // handle to the pool.
+    CleanupHandle(CurlHandle(std::move(ptr)));
+  }
+  return established;
+}
+
 CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (!multi_handles_.empty()) {
-    CURL* m = multi_handles_.back();
-    multi_handles_.pop_back();
+  auto& preferred = PreferredShard();
+  {
+    std::unique_lock<std::mutex> lk(preferred.mu);
+    if (!preferred.multi_handles.empty()) {
+      CURLM* m = preferred.multi_handles.back();
+      preferred.multi_handles.pop_back();
+      lk.unlock();
+      pooled_multi_handles_.fetch_sub(1, std::memory_order_relaxed);
+      return CurlMulti(m, &curl_multi_cleanup);
+    }
+  }
+  for (auto const& shard : shards_) {
+    if (shard.get() == &preferred) continue;
+    std::unique_lock<std::mutex> lk(shard->mu);
+    if (shard->multi_handles.empty()) continue;
+    CURLM* m = shard->multi_handles.back();
+    shard->multi_handles.pop_back();
+    lk.unlock();
+    pooled_multi_handles_.fetch_sub(1, std::memory_order_relaxed);
+    steal_count_.fetch_add(1, std::memory_order_relaxed);
     return CurlMulti(m, &curl_multi_cleanup);
   }
   return CurlMulti(curl_multi_init(), &curl_multi_cleanup);
 }
 
 void PooledCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) {
-  std::unique_lock<std::mutex> lk(mu_);
-  if (multi_handles_.size() >= maximum_size_) {
-    CURLM* tmp = multi_handles_.front();
-    multi_handles_.erase(multi_handles_.begin());
+  auto& shard = PreferredShard();
+  std::unique_lock<std::mutex> lk(shard.mu);
+  if (shard.multi_handles.size() >= shard_capacity_) {
+    CURLM* tmp = shard.multi_handles.front();
+    shard.multi_handles.erase(shard.multi_handles.begin());
+    lk.unlock();
     curl_multi_cleanup(tmp);
+    lk.lock();
+  } else {
+    pooled_multi_handles_.fetch_add(1, std::memory_order_relaxed);
   }
-  multi_handles_.push_back(m.get());
-  // The multi_handles_ vector now has ownership, so release it.
+  shard.multi_handles.push_back(m.get());
+  // The shard now has ownership, so release it.
   (void)m.release();
 }
 
@@ -18,6 +18,8 @@
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include "google/cloud/storage/version.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -41,6 +43,19 @@ class CurlHandleFactory {
 
   virtual std::string LastClientIpAddress() const = 0;
 
+  /**
+   * Pre-establish up to @p count connections to @p endpoint.
+   *
+   * The default implementation does nothing: a factory that does not keep
+   * handles cannot keep connections warm either. Returns the number of
+   * connections established.
+   */
+  virtual std::size_t WarmUp(std::string const& endpoint, std::size_t count) {
+    (void)endpoint;
+    (void)count;
+    return 0;
+  }
+
  protected:
   // Only virtual for testing purposes.
   virtual void SetCurlStringOption(CURL* handle, CURLoption option_tag,
@@ -56,6 +71,58 @@ std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
     ChannelOptions const& options);
 std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory();
 
+/**
+ * Return a process-wide pooled handle factory shared by all clients.
+ *
+ * Pooled libcurl handles keep their live connections, TLS session IDs, and
+ * DNS cache across `curl_easy_reset()`. Sharing one pool across all the
+ * `storage::Client` objects in a process therefore shares those warmed-up
+ * resources too: a client created later can reuse a connection (and TLS
+ * session) established through any earlier client, instead of paying a
+ * fresh TCP+TLS handshake to the same endpoint.
+ *
+ * One factory is shared per distinct `ChannelOptions` configuration, as the
+ * options change how the handles are set up. @p pool_size only takes effect
+ * when the factory for a configuration is first created.
+ */
+std::shared_ptr<CurlHandleFactory> GetSharedCurlHandleFactory(
+    std::size_t pool_size, ChannelOptions const& options);
+
+/**
+ * Routes pool operations to the shard derived from a transfer-specific key.
+ *
+ * By default `PooledCurlHandleFactory` prefers a shard based on the calling
+ * thread, which gives good connection locality when each transfer stays on
+ * one thread. The chunks of a resumable upload, however, may be issued from
+ * different threads, and two transfers interleaved on the same thread can
+ * ping-pong over each other's handles (and therefore connections). While a
+ * scope is active the pool picks the shard from @p key instead: all the
+ * requests of one transfer land on the same shard, and distinct concurrent
+ * transfers (with distinct keys) are striped across distinct shards
+ * deliberately.
+ *
+ * The scope is thread-local and restores the previous key on destruction, so
+ * scopes nest safely.
+ */
+class CurlHandleAffinityScope {
+ public:
+  explicit CurlHandleAffinityScope(std::size_t key);
+  ~CurlHandleAffinityScope();
+
+  CurlHandleAffinityScope(CurlHandleAffinityScope const&) = delete;
+  CurlHandleAffinityScope& operator=(CurlHandleAffinityScope const&) = delete;
+
+ private:
+  friend class PooledCurlHandleFactory;
+  struct State {
+    bool active = false;
+    std::size_t key = 0;
+  };
+  static State& ThreadState();
+
+  State previous_;
+};
+
 /**
  * Implements the default CurlHandleFactory.
  *
@@ -91,6 +158,16 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
  *
  * This implementation keeps up to N handles in memory, they are only released
  * when the factory is destructed.
+ *
+ * The pool is sharded to reduce mutex contention when many threads create and
+ * release handles concurrently. Each thread has a preferred shard (based on a
+ * hash of its id), and steals handles from other shards only when its
+ * preferred shard is empty. The factory keeps occupancy and steal counters so
+ * applications (and our benchmarks) can size the pool.
+ *
+ * Handles are normalized (all options reset, factory-wide options applied)
+ * when they are returned via `CleanupHandle()`, so `CreateHandle()` can hand
+ * out pooled handles without any setopt calls on the request hot path.
  */
 class PooledCurlHandleFactory : public CurlHandleFactory {
  public:
@@ -110,11 +187,53 @@ class PooledCurlHandleFactory : public CurlHandleFactory {
     return last_client_ip_address_;
   }
 
+  /// The number of easy handles currently in the pool.
+  std::size_t CurrentHandleCount() const {
+    return pooled_handles_.load(std::memory_order_relaxed);
+  }
+
+  /// The number of multi handles currently in the pool.
+  std::size_t CurrentMultiHandleCount() const {
+    return pooled_multi_handles_.load(std::memory_order_relaxed);
+  }
+
+  /// The number of times a handle was taken from a non-preferred shard.
+  std::size_t StealCount() const {
+    return steal_count_.load(std::memory_order_relaxed);
+  }
+
+  /// The number of shards, mostly interesting for tests and tuning.
+  std::size_t shard_count() const { return shards_.size(); }
+
+  /**
+   * Pre-establish up to @p count connections to @p endpoint.
+   *
+   * Each warmed handle performs just the TCP+TLS handshake (no request) and
+   * is then returned to the pool, where `curl_easy_reset()` preserves its
+   * connection and TLS session caches. The handles are striped across the
+   * shards so later transfers find a warm connection regardless of which
+   * shard serves them. Stops at the first connection failure; returns the
+   * number of connections established.
+   */
+  std::size_t WarmUp(std::string const& endpoint, std::size_t count) override;
+
  private:
+  struct Shard {
+    std::mutex mu;
+    std::vector<CURL*> handles;
+    std::vector<CURLM*> multi_handles;
+  };
+
+  /// The shard preferred by the current thread.
+  Shard& PreferredShard();
+
   std::size_t maximum_size_;
+  std::size_t shard_capacity_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<std::size_t> pooled_handles_{0};
+  std::atomic<std::size_t> pooled_multi_handles_{0};
+  std::atomic<std::size_t> steal_count_{0};
   mutable std::mutex mu_;
-  std::vector<CURL*> handles_;
-  std::vector<CURLM*> multi_handles_;
   std::string last_client_ip_address_;
   ChannelOptions options_;
 };
@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include <gmock/gmock.h>
 #include <map>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -110,6 +111,138 @@ TEST(CurlHandleFactoryTest, PooledFactoryChannelOptionsCallsSetOptions) {
   EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
 }
 
+TEST(CurlHandleFactoryTest, PooledFactoryAppliesOptionsOnCleanup) {
+  ChannelOptions options;
+  options.set_ssl_root_path("foo");
+  OverriddenPooledCurlHandleFactory object_under_test(2, options);
+
+  auto const expected = std::make_pair(CURLOPT_CAINFO, std::string("foo"));
+
+  // Handles are normalized when they are returned to the pool, so the
+  // factory-wide options are applied in CleanupHandle() ...
+  CurlHandle handle;
+  object_under_test.set_options_.clear();
+  object_under_test.CleanupHandle(std::move(handle));
+  EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
+
+  // ... and reusing a pooled handle requires no setopt calls at all.
+  object_under_test.set_options_.clear();
+  auto reused = object_under_test.CreateHandle();
+  EXPECT_NE(nullptr, reused.get());
+  EXPECT_THAT(object_under_test.set_options_, IsEmpty());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryReusesHandles) {
+  PooledCurlHandleFactory object_under_test(8);
+  EXPECT_GE(object_under_test.shard_count(), 1);
+  EXPECT_EQ(0, object_under_test.CurrentHandleCount());
+
+  CurlHandle handle;
+  object_under_test.CleanupHandle(std::move(handle));
+  EXPECT_EQ(1, object_under_test.CurrentHandleCount());
+
+  // The same thread releases and acquires, so this comes from the preferred
+  // shard without stealing.
+  auto reused = object_under_test.CreateHandle();
+  EXPECT_NE(nullptr, reused.get());
+  EXPECT_EQ(0, object_under_test.CurrentHandleCount());
+  EXPECT_EQ(0, object_under_test.StealCount());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryReusesMultiHandles) {
+  PooledCurlHandleFactory object_under_test(8);
+  EXPECT_EQ(0, object_under_test.CurrentMultiHandleCount());
+
+  auto m = object_under_test.CreateMultiHandle();
+  object_under_test.CleanupMultiHandle(std::move(m));
+  EXPECT_EQ(1, object_under_test.CurrentMultiHandleCount());
+
+  auto reused = object_under_test.CreateMultiHandle();
+  EXPECT_NE(nullptr, reused.get());
+  EXPECT_EQ(0, object_under_test.CurrentMultiHandleCount());
+}
+
+// Expose the protected `GetHandle()` helper so the affinity tests can track
+// a handle's identity across the pool.
+struct HandleIdentity : public CurlHandleFactory {
+  static CURL* Raw(CurlHandle& h) { return GetHandle(h); }
+};
+
+TEST(CurlHandleFactoryTest, PooledFactoryHonorsAffinityScope) {
+  PooledCurlHandleFactory object_under_test(16);
+
+  // Return a handle to the pool under an affinity key, it lands on the shard
+  // derived from the key, not from the thread.
+  CURL* raw = nullptr;
+  {
+    CurlHandleAffinityScope affinity(42);
+    CurlHandle handle;
+    raw = HandleIdentity::Raw(handle);
+    object_under_test.CleanupHandle(std::move(handle));
+  }
+  EXPECT_EQ(1, object_under_test.CurrentHandleCount());
+
+  // A different thread using the same key finds the same handle, without
+  // stealing from another shard.
+  CurlPtr reused(nullptr, &curl_easy_cleanup);
+  std::thread worker([&object_under_test, &reused] {
+    CurlHandleAffinityScope affinity(42);
+    reused = object_under_test.CreateHandle();
+  });
+  worker.join();
+  EXPECT_EQ(raw, reused.get());
+  EXPECT_EQ(0, object_under_test.StealCount());
+}
+
+TEST(CurlHandleFactoryTest, AffinityScopesNest) {
+  PooledCurlHandleFactory object_under_test(16);
+
+  CURL* raw = nullptr;
+  {
+    CurlHandleAffinityScope affinity(42);
+    CurlHandle handle;
+    raw = HandleIdentity::Raw(handle);
+    object_under_test.CleanupHandle(std::move(handle));
+  }
+
+  // A nested scope restores the outer key on destruction.
+  CurlHandleAffinityScope outer(42);
+  { CurlHandleAffinityScope inner(43); }
+  auto reused = object_under_test.CreateHandle();
+  EXPECT_EQ(raw, reused.get());
+}
+
+TEST(CurlHandleFactoryTest, SharedFactoryIsSharedPerConfiguration) {
+  ChannelOptions options;
+  auto a = GetSharedCurlHandleFactory(8, options);
+  auto b = GetSharedCurlHandleFactory(16, options);
+  // The same configuration maps to the same factory, regardless of the
+  // requested pool size.
+  EXPECT_EQ(a.get(), b.get());
+
+  ChannelOptions other;
+  other.set_ssl_root_path("test-only-root.pem");
+  auto c = GetSharedCurlHandleFactory(8, other);
+  EXPECT_NE(a.get(), c.get());
+}
+
+TEST(CurlHandleFactoryTest, DefaultFactoryWarmUpIsANoOp) {
+  DefaultCurlHandleFactory object_under_test;
+  EXPECT_EQ(0, object_under_test.WarmUp("https://example.com", 4));
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryEnforcesShardCapacity) {
+  // With a maximum size of 1 there is a single shard holding a single handle.
+  PooledCurlHandleFactory object_under_test(1);
+  ASSERT_EQ(1, object_under_test.shard_count());
+
+  CurlHandle h0;
+  CurlHandle h1;
+  object_under_test.CleanupHandle(std::move(h0));
+  object_under_test.CleanupHandle(std::move(h1));
+  EXPECT_EQ(1, object_under_test.CurrentHandleCount());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -0,0 +1,129 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_multi_engine.h"
+#include <chrono>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+// How long the event loop sleeps waiting for socket activity. New work and
+// shutdown are noticed at this granularity when `curl_multi_wakeup()` is not
+// available.
+auto constexpr kPollTimeoutMs = 50;
+
+void WaitForActivity(CURLM* multi, bool has_work) {
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+  (void)has_work;
+  (void)curl_multi_poll(multi, nullptr, 0, kPollTimeoutMs, nullptr);
+#else
+  // `curl_multi_wait()` returns immediately when there are no file
+  // descriptors to wait on, which would turn this loop into a busy-wait both
+  // when idle and while libcurl is still setting up connections.
+  int numfds = 0;
+  (void)curl_multi_wait(multi, nullptr, 0, kPollTimeoutMs, &numfds);
+  if (numfds == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(has_work ? 1 : 10));
+  }
+#endif
+}
+
+}  // namespace
+
+CurlMultiEngine::CurlMultiEngine(std::size_t thread_count) {
+  if (thread_count == 0) thread_count = 1;
+  workers_.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    workers_.emplace_back(new Worker);
+    auto& worker = *workers_.back();
+    worker.multi = curl_multi_init();
+    worker.thread = std::thread([this, &worker] { RunLoop(worker); });
+  }
+}
+
+CurlMultiEngine::~CurlMultiEngine() {
+  for (auto const& worker : workers_) {
+    {
+      std::lock_guard<std::mutex> lk(worker->mu);
+      worker->shutdown = true;
+    }
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+    (void)curl_multi_wakeup(worker->multi);
+#endif
+  }
+  for (auto const& worker : workers_) {
+    if (worker->thread.joinable()) worker->thread.join();
+    curl_multi_cleanup(worker->multi);
+  }
+}
+
+CURLcode CurlMultiEngine::Perform(CURL* handle) {
+  auto const index =
+      next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+  auto& worker = *workers_[index];
+  std::promise<CURLcode> done;
+  auto result = done.get_future();
+  {
+    std::lock_guard<std::mutex> lk(worker.mu);
+    worker.pending.push_back(PendingTransfer{handle, std::move(done)});
+  }
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+  (void)curl_multi_wakeup(worker.multi);
+#endif
+  return result.get();
+}
+
+void CurlMultiEngine::RunLoop(Worker& worker) {
+  std::map<CURL*, std::promise<CURLcode>> active;
+  for (;;) {
+    std::vector<PendingTransfer> pending;
+    {
+      std::lock_guard<std::mutex> lk(worker.mu);
+      pending.swap(worker.pending);
+      if (worker.shutdown && pending.empty() && active.empty()) return;
+    }
+    for (auto& transfer : pending) {
+      auto const status = curl_multi_add_handle(worker.multi, transfer.handle);
+      if (status != CURLM_OK) {
+        transfer.done.set_value(CURLE_FAILED_INIT);
+        continue;
+      }
+      active.emplace(transfer.handle, std::move(transfer.done));
+    }
+    int running = 0;
+    (void)curl_multi_perform(worker.multi, &running);
+    int queued = 0;
+    while (auto const* msg = curl_multi_info_read(worker.multi, &queued)) {
+      if (msg->msg != CURLMSG_DONE) continue;
+      auto* handle = msg->easy_handle;
+      auto const code = msg->data.result;
+      (void)curl_multi_remove_handle(worker.multi, handle);
+      auto it = active.find(handle);
+      if (it == active.end()) continue;
+      it->second.set_value(code);
+      active.erase(it);
+    }
+    WaitForActivity(worker.multi, !active.empty());
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
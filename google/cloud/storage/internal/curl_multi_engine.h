@@ -0,0 +1,97 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_ENGINE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_ENGINE_H
+
+#include "google/cloud/storage/internal/curl_wrappers.h"
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Drives many concurrent transfers over a few `curl_multi` event loops.
+ *
+ * The easy interface (`curl_easy_perform()`) dedicates a thread to each
+ * in-flight transfer, so the number of concurrent requests is capped by the
+ * number of threads the application can afford. This engine decouples the
+ * two: a small number of event-loop threads, each running a `CURLM` handle,
+ * drive an arbitrary number of easy handles. `Perform()` enqueues a fully
+ * configured easy handle on one of the loops (round-robin) and blocks the
+ * *calling* thread until the transfer completes, so the blocking API of
+ * `CurlRequest` is unchanged while thousands of requests (e.g. the DELETE
+ * storms of a TTL sweep) share a handful of threads.
+ *
+ * Handles keep their configuration, connection, and callbacks; only the
+ * `perform` step moves to the event loop.
+ */
+class CurlMultiEngine {
+ public:
+  explicit CurlMultiEngine(std::size_t thread_count);
+  ~CurlMultiEngine();
+
+  CurlMultiEngine(CurlMultiEngine const&) = delete;
+  CurlMultiEngine& operator=(CurlMultiEngine const&) = delete;
+
+  /**
+   * Runs the transfer for @p handle to completion.
+   *
+   * Blocks the calling thread, but does not consume an event-loop thread
+   * while the transfer waits on the network. The handle must be fully
+   * configured and must not be used from other threads until this function
+   * returns.
+   */
+  CURLcode Perform(CURL* handle);
+
+  std::size_t thread_count() const { return workers_.size(); }
+
+ private:
+  struct PendingTransfer {
+    CURL* handle;
+    std::promise<CURLcode> done;
+  };
+
+  struct Worker {
+    CURLM* multi = nullptr;
+    std::mutex mu;
+    std::vector<PendingTransfer> pending;
+    bool shutdown = false;
+    std::thread thread;
+  };
+
+  /// The body of each event-loop thread.
+  void RunLoop(Worker& worker);
+
+  std::atomic<std::size_t> next_worker_{0};
+  std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_MULTI_ENGINE_H
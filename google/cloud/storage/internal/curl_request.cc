@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/internal/metrics.h"
+#include <chrono>
 #include <iostream>
 
 namespace google {
@@ -95,6 +97,22 @@ StatusOr<HttpResponse> CurlRequest::MakeRequestImpl() {
   // default buffer size set by libcurl (16KiB)
   auto constexpr kDefaultBufferSize = 128 * 1024L;
 
+  // All the `CurlClient` operations funnel through this function, so one
+  // emitter here instruments every storage request.
+  auto& registry = google::cloud::internal::MetricsRegistry::Instance();
+  static auto& curl_requests = registry.Counter("storage.curl.requests");
+  static auto& curl_errors = registry.Counter("storage.curl.errors");
+  static auto& curl_latency = registry.Histogram("storage.curl.latency_us");
+  curl_requests.Increment();
+  auto const start = std::chrono::steady_clock::now();
+  // `curl_latency` has static storage duration, lambdas use it without
+  // capturing it.
+  auto record_latency = [start] {
+    curl_latency.Record(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count());
+  };
+
   response_payload_.clear();
   handle_.SetOption(CURLOPT_BUFFERSIZE, kDefaultBufferSize);
   handle_.SetOption(CURLOPT_URL, url_.c_str());
@@ -108,10 +126,16 @@ StatusOr<HttpResponse> CurlRequest::MakeRequestImpl() {
   handle_.SetOption(CURLOPT_WRITEDATA, this);
   handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlRequestOnHeaderData);
   handle_.SetOption(CURLOPT_HEADERDATA, this);
-  auto status = handle_.EasyPerform();
+  auto status =
+      multi_engine_ ? handle_.PerformOn(*multi_engine_) : handle_.EasyPerform();
+  record_latency();
   if (!status.ok()) {
+    curl_errors.Increment();
     return status;
   }
+  if (transport_stats_) {
+    handle_.RecordTransportStats(*transport_stats_);
+  }
   if (logging_enabled_) {
     handle_.FlushDebug(__func__);
   }
@@ -76,6 +76,8 @@ class CurlRequest {
   CurlHandle::SocketOptions socket_options_;
   CurlHandle handle_;
   std::shared_ptr<CurlHandleFactory> factory_;
+  std::shared_ptr<CurlTransportStats> transport_stats_;
+  std::shared_ptr<CurlMultiEngine> multi_engine_;
 };
 
 }  // namespace internal
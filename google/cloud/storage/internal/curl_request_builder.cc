@@ -46,6 +46,8 @@ CurlRequest CurlRequestBuilder::BuildRequest() {
   request.factory_ = std::move(factory_);
   request.logging_enabled_ = logging_enabled_;
   request.socket_options_ = socket_options_;
+  request.transport_stats_ = transport_stats_;
+  request.multi_engine_ = multi_engine_;
   return request;
 }
 
@@ -63,6 +65,7 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.logging_enabled_ = logging_enabled_;
   request.socket_options_ = socket_options_;
   request.download_stall_timeout_ = download_stall_timeout_;
+  request.transport_stats_ = transport_stats_;
   request.SetOptions();
   return request;
 }
@@ -80,9 +83,15 @@ CurlRequestBuilder& CurlRequestBuilder::ApplyClientOptions(
 
 CurlRequestBuilder& CurlRequestBuilder::AddHeader(std::string const& header) {
   ValidateBuilderState(__func__);
-  auto new_header = curl_slist_append(headers_.get(), header.c_str());
-  (void)headers_.release();
-  headers_.reset(new_header);
+  // curl_slist_append() walks the list it receives to find the last node, by
+  // passing the cached tail each append is O(1) instead of O(header count).
+  if (!headers_) {
+    headers_.reset(curl_slist_append(nullptr, header.c_str()));
+    last_header_ = headers_.get();
+    return *this;
+  }
+  auto* appended = curl_slist_append(last_header_, header.c_str());
+  if (appended != nullptr) last_header_ = appended->next;
   return *this;
 }
 
@@ -109,6 +118,20 @@ CurlRequestBuilder& CurlRequestBuilder::SetCurlShare(CURLSH* share) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetTransportStats(
+    std::shared_ptr<CurlTransportStats> stats) {
+  ValidateBuilderState(__func__);
+  transport_stats_ = std::move(stats);
+  return *this;
+}
+
+CurlRequestBuilder& CurlRequestBuilder::SetMultiEngine(
+    std::shared_ptr<CurlMultiEngine> engine) {
+  ValidateBuilderState(__func__);
+  multi_engine_ = std::move(engine);
+  return *this;
+}
+
 std::string CurlRequestBuilder::UserAgentSuffix() const {
   ValidateBuilderState(__func__);
   // Pre-compute and cache the user agent string:
@@ -166,6 +166,13 @@ class CurlRequestBuilder {
   /// Sets the CURLSH* handle to share resources.
   CurlRequestBuilder& SetCurlShare(CURLSH* share);
 
+  /// Sets the per-client telemetry block updated by the built request.
+  CurlRequestBuilder& SetTransportStats(
+      std::shared_ptr<CurlTransportStats> stats);
+
+  /// Sets the `curl_multi` engine that drives the built request's I/O.
+  CurlRequestBuilder& SetMultiEngine(std::shared_ptr<CurlMultiEngine> engine);
+
   /// Gets the user-agent suffix.
   std::string UserAgentSuffix() const;
 
@@ -186,6 +193,7 @@ class CurlRequestBuilder {
 
   CurlHandle handle_;
   CurlHeaders headers_;
+  curl_slist* last_header_ = nullptr;
 
   std::string url_;
   char const* query_parameter_separator_;
@@ -194,6 +202,8 @@ class CurlRequestBuilder {
   bool logging_enabled_;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
+  std::shared_ptr<CurlTransportStats> transport_stats_;
+  std::shared_ptr<CurlMultiEngine> multi_engine_;
 };
 
 }  // namespace internal
@@ -0,0 +1,83 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_transport_stats.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::size_t TtfbBucketIndex(std::chrono::microseconds ttfb) {
+  auto value = ttfb.count();
+  if (value <= 0) return 0;
+  std::size_t index = 0;
+  while (value != 0 && index < kCurlTtfbBucketCount - 1) {
+    value >>= 1;
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace
+
+void CurlTransportStats::RecordRequest(std::chrono::microseconds dns,
+                                       std::chrono::microseconds connect,
+                                       std::chrono::microseconds tls,
+                                       std::chrono::microseconds ttfb,
+                                       std::int64_t new_connections) {
+  request_count_.fetch_add(1, std::memory_order_relaxed);
+  if (new_connections == 0) {
+    reused_connection_count_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    new_connection_count_.fetch_add(new_connections,
+                                    std::memory_order_relaxed);
+  }
+  dns_time_us_.fetch_add(dns.count(), std::memory_order_relaxed);
+  connect_time_us_.fetch_add(connect.count(), std::memory_order_relaxed);
+  tls_time_us_.fetch_add(tls.count(), std::memory_order_relaxed);
+  ttfb_time_us_.fetch_add(ttfb.count(), std::memory_order_relaxed);
+  ttfb_histogram_[TtfbBucketIndex(ttfb)].fetch_add(1,
+                                                   std::memory_order_relaxed);
+}
+
+CurlTransportStatsSnapshot CurlTransportStats::Snapshot() const {
+  CurlTransportStatsSnapshot snapshot;
+  snapshot.request_count = request_count_.load(std::memory_order_relaxed);
+  snapshot.reused_connection_count =
+      reused_connection_count_.load(std::memory_order_relaxed);
+  snapshot.new_connection_count =
+      new_connection_count_.load(std::memory_order_relaxed);
+  snapshot.dns_time =
+      std::chrono::microseconds(dns_time_us_.load(std::memory_order_relaxed));
+  snapshot.connect_time = std::chrono::microseconds(
+      connect_time_us_.load(std::memory_order_relaxed));
+  snapshot.tls_time =
+      std::chrono::microseconds(tls_time_us_.load(std::memory_order_relaxed));
+  snapshot.ttfb_time =
+      std::chrono::microseconds(ttfb_time_us_.load(std::memory_order_relaxed));
+  for (std::size_t i = 0; i != snapshot.ttfb_histogram.size(); ++i) {
+    snapshot.ttfb_histogram[i] =
+        ttfb_histogram_[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
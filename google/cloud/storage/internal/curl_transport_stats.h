@@ -0,0 +1,125 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_TRANSPORT_STATS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_TRANSPORT_STATS_H
+
+#include "google/cloud/storage/version.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// The number of buckets in the time-to-first-byte histogram, see
+/// `CurlTransportStats` for the bucket boundaries.
+std::size_t constexpr kCurlTtfbBucketCount = 32;
+
+/**
+ * A point-in-time copy of the counters in a `CurlTransportStats`.
+ *
+ * The snapshot is a plain struct, applications can diff two snapshots to
+ * compute rates over an interval.
+ */
+struct CurlTransportStatsSnapshot {
+  /// The number of requests completed.
+  std::int64_t request_count;
+  /// The number of requests served over an already established connection.
+  std::int64_t reused_connection_count;
+  /// The number of new connections established.
+  std::int64_t new_connection_count;
+  /// The total time spent on DNS resolution.
+  std::chrono::microseconds dns_time;
+  /// The total time spent establishing TCP connections.
+  std::chrono::microseconds connect_time;
+  /// The total time spent on TLS handshakes.
+  std::chrono::microseconds tls_time;
+  /// The total time from the start of each transfer to its first byte.
+  std::chrono::microseconds ttfb_time;
+  /// The time-to-first-byte histogram, bucket `i` counts requests with a
+  /// time-to-first-byte in the `[2^(i-1), 2^i)` microseconds range.
+  std::array<std::int64_t, kCurlTtfbBucketCount> ttfb_histogram;
+};
+
+/**
+ * Accumulates socket-level telemetry for the requests issued by one client.
+ *
+ * Each `CurlClient` owns one of these blocks and `CurlHandle` harvests the
+ * `CURLINFO_*` counters for every completed request into it. The counters can
+ * distinguish connection churn (low reuse rate, time dominated by connection
+ * setup) from server or network latency (time dominated by time-to-first-byte
+ * on reused connections) without packet captures.
+ *
+ * All the counters are `std::atomic<>`, recording a request is lock-free and
+ * safe to call from any thread. The per-request phase timings are recorded
+ * with relaxed memory order; a `Snapshot()` taken while requests are in flight
+ * may therefore be slightly inconsistent (e.g. a request counted but its
+ * timings not yet added), which is acceptable for monitoring.
+ *
+ * Note that libcurl does not report whether a TLS session was resumed. The
+ * TLS handshake time distribution serves as a proxy: resumed handshakes save
+ * a round trip and cluster well below full handshakes.
+ */
+class CurlTransportStats {
+ public:
+  CurlTransportStats() = default;
+
+  // The counters represent a single client, disable copying.
+  CurlTransportStats(CurlTransportStats const&) = delete;
+  CurlTransportStats& operator=(CurlTransportStats const&) = delete;
+
+  /**
+   * Record the telemetry for one completed request.
+   *
+   * @param dns the time spent on DNS resolution.
+   * @param connect the additional time spent establishing the TCP connection.
+   * @param tls the additional time spent on the TLS handshake.
+   * @param ttfb the time from the start of the transfer to the first byte.
+   * @param new_connections the number of connections created for the request,
+   *     zero when the request was served over a reused connection.
+   */
+  void RecordRequest(std::chrono::microseconds dns,
+                     std::chrono::microseconds connect,
+                     std::chrono::microseconds tls,
+                     std::chrono::microseconds ttfb,
+                     std::int64_t new_connections);
+
+  /// Returns a point-in-time copy of the counters.
+  CurlTransportStatsSnapshot Snapshot() const;
+
+ private:
+  std::atomic<std::int64_t> request_count_{0};
+  std::atomic<std::int64_t> reused_connection_count_{0};
+  std::atomic<std::int64_t> new_connection_count_{0};
+  std::atomic<std::int64_t> dns_time_us_{0};
+  std::atomic<std::int64_t> connect_time_us_{0};
+  std::atomic<std::int64_t> tls_time_us_{0};
+  std::atomic<std::int64_t> ttfb_time_us_{0};
+  std::array<std::atomic<std::int64_t>, kCurlTtfbBucketCount> ttfb_histogram_ =
+      {};
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_TRANSPORT_STATS_H
@@ -0,0 +1,113 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_transport_stats.h"
+#include <gmock/gmock.h>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ms = std::chrono::microseconds;
+
+TEST(CurlTransportStatsTest, InitiallyEmpty) {
+  CurlTransportStats stats;
+  auto snapshot = stats.Snapshot();
+  EXPECT_EQ(0, snapshot.request_count);
+  EXPECT_EQ(0, snapshot.reused_connection_count);
+  EXPECT_EQ(0, snapshot.new_connection_count);
+  EXPECT_EQ(ms(0), snapshot.dns_time);
+  EXPECT_EQ(ms(0), snapshot.connect_time);
+  EXPECT_EQ(ms(0), snapshot.tls_time);
+  EXPECT_EQ(ms(0), snapshot.ttfb_time);
+  auto const total =
+      std::accumulate(snapshot.ttfb_histogram.begin(),
+                      snapshot.ttfb_histogram.end(), std::int64_t{0});
+  EXPECT_EQ(0, total);
+}
+
+TEST(CurlTransportStatsTest, AccumulatesRequests) {
+  CurlTransportStats stats;
+  stats.RecordRequest(ms(100), ms(200), ms(300), ms(5000),
+                      /*new_connections=*/1);
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(4000), /*new_connections=*/0);
+  auto snapshot = stats.Snapshot();
+  EXPECT_EQ(2, snapshot.request_count);
+  EXPECT_EQ(1, snapshot.reused_connection_count);
+  EXPECT_EQ(1, snapshot.new_connection_count);
+  EXPECT_EQ(ms(100), snapshot.dns_time);
+  EXPECT_EQ(ms(200), snapshot.connect_time);
+  EXPECT_EQ(ms(300), snapshot.tls_time);
+  EXPECT_EQ(ms(9000), snapshot.ttfb_time);
+}
+
+TEST(CurlTransportStatsTest, TtfbHistogramBuckets) {
+  CurlTransportStats stats;
+  // Bucket i counts values in [2^(i-1), 2^i), zero lands in bucket 0.
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(0), 0);
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(1), 0);
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(2), 0);
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(3), 0);
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(4), 0);
+  stats.RecordRequest(ms(0), ms(0), ms(0), ms(1024), 0);
+  auto snapshot = stats.Snapshot();
+  EXPECT_EQ(1, snapshot.ttfb_histogram[0]);   // 0
+  EXPECT_EQ(1, snapshot.ttfb_histogram[1]);   // 1
+  EXPECT_EQ(2, snapshot.ttfb_histogram[2]);   // 2, 3
+  EXPECT_EQ(1, snapshot.ttfb_histogram[3]);   // 4
+  EXPECT_EQ(1, snapshot.ttfb_histogram[11]);  // 1024
+}
+
+TEST(CurlTransportStatsTest, TtfbHistogramSaturates) {
+  CurlTransportStats stats;
+  auto const huge = ms((std::numeric_limits<std::int64_t>::max)());
+  stats.RecordRequest(ms(0), ms(0), ms(0), huge, 0);
+  auto snapshot = stats.Snapshot();
+  EXPECT_EQ(1, snapshot.ttfb_histogram[kCurlTtfbBucketCount - 1]);
+}
+
+TEST(CurlTransportStatsTest, ConcurrentRecording) {
+  CurlTransportStats stats;
+  auto constexpr kThreads = 8;
+  auto constexpr kIterations = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kThreads; ++t) {
+    threads.emplace_back([&stats] {
+      for (int i = 0; i != kIterations; ++i) {
+        stats.RecordRequest(ms(1), ms(2), ms(3), ms(4), i % 2);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  auto snapshot = stats.Snapshot();
+  EXPECT_EQ(kThreads * kIterations, snapshot.request_count);
+  EXPECT_EQ(kThreads * kIterations / 2, snapshot.reused_connection_count);
+  EXPECT_EQ(kThreads * kIterations / 2, snapshot.new_connection_count);
+  EXPECT_EQ(ms(kThreads * kIterations), snapshot.dns_time);
+  EXPECT_EQ(ms(4 * kThreads * kIterations), snapshot.ttfb_time);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,146 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_buffer_pool.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#if defined(__linux__)
+#include <sched.h>
+#endif  // __linux__
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::size_t DefaultShardCount() {
+  // NUMA node counts are small, there is no need for one shard per CPU. On
+  // single-socket hosts the extra shards just reduce mutex contention.
+  auto constexpr kMaxShards = std::size_t(8);
+  std::size_t shards = std::thread::hardware_concurrency();
+  if (shards == 0) shards = 1;
+  return (std::min)(shards, kMaxShards);
+}
+
+std::size_t CurrentLocalityHint() {
+#if defined(__linux__)
+  auto const cpu = sched_getcpu();
+  if (cpu >= 0) {
+    // Map blocks of consecutive CPUs to the same shard. CPU numbering varies
+    // across machines, but on the common block-numbered topologies CPUs of
+    // one socket share shards; at worst this degrades to an arbitrary (but
+    // stable) per-CPU assignment, which still keeps a buffer close to the
+    // threads that use it.
+    std::size_t cpus = std::thread::hardware_concurrency();
+    if (cpus == 0) cpus = 1;
+    return static_cast<std::size_t>(cpu) * DefaultShardCount() / cpus;
+  }
+#endif  // __linux__
+  return std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+
+}  // namespace
+
+DownloadBufferPool::DownloadBufferPool(std::size_t max_pooled_bytes) {
+  auto const shard_count = DefaultShardCount();
+  max_shard_bytes_ = (std::max)(max_pooled_bytes / shard_count, std::size_t(1));
+  shards_.reserve(shard_count);
+  for (std::size_t i = 0; i != shard_count; ++i) {
+    shards_.emplace_back(new Shard);
+  }
+}
+
+DownloadBufferPool& DownloadBufferPool::Instance() {
+  // Enough to recycle buffers for hundreds of concurrent read streams, the
+  // get-area buffers are much smaller than the upload buffers.
+  static auto* const kInstance =
+      new DownloadBufferPool(/*max_pooled_bytes=*/64 * 1024 * 1024L);
+  return *kInstance;
+}
+
+DownloadBufferPool::Shard& DownloadBufferPool::PreferredShard() {
+  auto const& locality = DownloadBufferLocalityScope::ThreadState();
+  auto const hint = locality.active ? locality.key : CurrentLocalityHint();
+  return *shards_[hint % shards_.size()];
+}
+
+std::vector<char> DownloadBufferPool::Acquire(std::size_t size) {
+  auto& shard = PreferredShard();
+  {
+    std::lock_guard<std::mutex> lk(shard.mu);
+    // Prefer the smallest pooled buffer that is large enough; with the
+    // expected mix of (mostly identical) buffer sizes this scan is short.
+    auto best = shard.buffers.end();
+    for (auto i = shard.buffers.begin(); i != shard.buffers.end(); ++i) {
+      if (i->capacity() < size) continue;
+      if (best == shard.buffers.end() || i->capacity() < best->capacity()) {
+        best = i;
+      }
+    }
+    if (best != shard.buffers.end()) {
+      auto buffer = std::move(*best);
+      shard.buffers.erase(best);
+      shard.pooled_bytes -= buffer.capacity();
+      buffer.resize(size);
+      return buffer;
+    }
+  }
+  // Deliberately do not steal from other shards: their buffers likely live on
+  // another NUMA node. A fresh buffer is value-initialized here, so its pages
+  // are first touched by this thread and placed on this thread's node.
+  return std::vector<char>(size);
+}
+
+void DownloadBufferPool::Release(std::vector<char> buffer) {
+  if (buffer.capacity() == 0) return;
+  auto& shard = PreferredShard();
+  std::lock_guard<std::mutex> lk(shard.mu);
+  if (shard.pooled_bytes + buffer.capacity() > max_shard_bytes_) return;
+  shard.pooled_bytes += buffer.capacity();
+  shard.buffers.push_back(std::move(buffer));
+}
+
+std::size_t DownloadBufferPool::CurrentPooledBytes() const {
+  std::size_t total = 0;
+  for (auto const& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mu);
+    total += shard->pooled_bytes;
+  }
+  return total;
+}
+
+DownloadBufferLocalityScope::State& DownloadBufferLocalityScope::ThreadState() {
+  thread_local State state;
+  return state;
+}
+
+DownloadBufferLocalityScope::DownloadBufferLocalityScope(std::size_t key)
+    : previous_(ThreadState()) {
+  auto& state = ThreadState();
+  state.active = true;
+  state.key = key;
+}
+
+DownloadBufferLocalityScope::~DownloadBufferLocalityScope() {
+  ThreadState() = previous_;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
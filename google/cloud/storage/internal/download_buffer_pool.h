@@ -0,0 +1,131 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_BUFFER_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_BUFFER_POOL_H
+
+#include "google/cloud/storage/version.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A process-wide, locality-aware pool of download buffers.
+ *
+ * This pool recycles the get-area buffers used by `ObjectReadStreambuf`, for
+ * the same reasons `UploadBufferPool` recycles upload buffers. Unlike the
+ * upload pool it is sharded by a locality hint: a buffer is preferentially
+ * reused by a thread running near the thread that released it.
+ *
+ * The locality aspect matters on multi-socket hosts. Memory pages are placed
+ * on the NUMA node of the thread that first writes them ("first touch"), and
+ * a download buffer repeatedly filled from a remote node costs cross-socket
+ * memory traffic on every transfer. Two properties of this pool mitigate
+ * that without a hard dependency on a NUMA library:
+ *
+ * - A fresh buffer is value-initialized by `Acquire()`, so its pages are
+ *   first touched by the acquiring thread and placed on that thread's node.
+ * - On misses the pool allocates instead of stealing from another shard: a
+ *   fresh local allocation is cheaper over the buffer's lifetime than reusing
+ *   remote pages.
+ *
+ * On Linux the default locality hint is derived from the CPU the calling
+ * thread runs on, which approximates its NUMA node; elsewhere it falls back
+ * to a hash of the thread id. Use `DownloadBufferLocalityScope` to override
+ * the hint, e.g. when acquiring a buffer on behalf of a consumer pinned to a
+ * known node.
+ *
+ * The total number of bytes retained is bounded; buffers released into a
+ * full shard are simply freed.
+ */
+class DownloadBufferPool {
+ public:
+  explicit DownloadBufferPool(std::size_t max_pooled_bytes);
+
+  /// The process-wide pool used by the read streams.
+  static DownloadBufferPool& Instance();
+
+  /// Get a buffer with at least @p size bytes, recycling a local one if
+  /// possible.
+  std::vector<char> Acquire(std::size_t size);
+
+  /// Return @p buffer to the local shard, possibly freeing it if the shard is
+  /// full.
+  void Release(std::vector<char> buffer);
+
+  /// The number of bytes currently retained, mostly useful in tests.
+  std::size_t CurrentPooledBytes() const;
+
+  /// The number of locality shards, mostly useful in tests and tuning.
+  std::size_t shard_count() const { return shards_.size(); }
+
+ private:
+  struct Shard {
+    mutable std::mutex mu;
+    std::vector<std::vector<char>> buffers;
+    std::size_t pooled_bytes = 0;
+  };
+
+  /// The shard for the calling thread's locality hint.
+  Shard& PreferredShard();
+
+  std::size_t max_shard_bytes_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+/**
+ * Overrides the locality hint used by `DownloadBufferPool`.
+ *
+ * While a scope is active the pool picks the shard from @p key instead of
+ * the calling thread's CPU. This is the consumer-hint API: a transport that
+ * knows which application thread (and therefore which NUMA node) will drain
+ * a buffer can acquire it under that consumer's key, so the buffer returns
+ * to — and is reused from — the consumer's shard.
+ *
+ * The scope is thread-local and restores the previous hint on destruction,
+ * so scopes nest safely.
+ */
+class DownloadBufferLocalityScope {
+ public:
+  explicit DownloadBufferLocalityScope(std::size_t key);
+  ~DownloadBufferLocalityScope();
+
+  DownloadBufferLocalityScope(DownloadBufferLocalityScope const&) = delete;
+  DownloadBufferLocalityScope& operator=(DownloadBufferLocalityScope const&) =
+      delete;
+
+ private:
+  friend class DownloadBufferPool;
+  struct State {
+    bool active = false;
+    std::size_t key = 0;
+  };
+  static State& ThreadState();
+
+  State previous_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_DOWNLOAD_BUFFER_POOL_H
@@ -0,0 +1,113 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/download_buffer_pool.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(DownloadBufferPoolTest, ReleaseThenAcquireReuses) {
+  DownloadBufferPool pool(1024 * 1024);
+  auto buffer = pool.Acquire(1024);
+  EXPECT_EQ(1024, buffer.size());
+  auto const* data = buffer.data();
+  // The same thread releases and acquires, so both use the same shard.
+  pool.Release(std::move(buffer));
+  EXPECT_LE(1024, pool.CurrentPooledBytes());
+
+  auto reused = pool.Acquire(512);
+  EXPECT_EQ(512, reused.size());
+  EXPECT_EQ(data, reused.data());
+  EXPECT_EQ(0, pool.CurrentPooledBytes());
+}
+
+TEST(DownloadBufferPoolTest, DoesNotStealAcrossLocalityShards) {
+  DownloadBufferPool pool(1024 * 1024);
+  if (pool.shard_count() < 2) GTEST_SKIP();
+
+  auto buffer = pool.Acquire(1024);
+  auto const* data = buffer.data();
+  {
+    DownloadBufferLocalityScope locality(0);
+    pool.Release(std::move(buffer));
+  }
+  // A different locality hint misses and allocates a fresh buffer, the
+  // pooled one stays in its shard.
+  DownloadBufferLocalityScope locality(1);
+  auto fresh = pool.Acquire(1024);
+  EXPECT_NE(data, fresh.data());
+  EXPECT_LE(1024, pool.CurrentPooledBytes());
+}
+
+TEST(DownloadBufferPoolTest, LocalityScopeRoutesToSameShard) {
+  DownloadBufferPool pool(1024 * 1024);
+
+  char const* data = nullptr;
+  {
+    DownloadBufferLocalityScope locality(42);
+    auto buffer = pool.Acquire(1024);
+    data = buffer.data();
+    pool.Release(std::move(buffer));
+  }
+  // The same hint finds the same buffer, regardless of the calling thread's
+  // CPU.
+  DownloadBufferLocalityScope locality(42);
+  auto reused = pool.Acquire(1024);
+  EXPECT_EQ(data, reused.data());
+}
+
+TEST(DownloadBufferPoolTest, LocalityScopesNest) {
+  DownloadBufferPool pool(1024 * 1024);
+
+  char const* data = nullptr;
+  {
+    DownloadBufferLocalityScope locality(42);
+    auto buffer = pool.Acquire(1024);
+    data = buffer.data();
+    pool.Release(std::move(buffer));
+  }
+  DownloadBufferLocalityScope outer(42);
+  { DownloadBufferLocalityScope inner(43); }
+  auto reused = pool.Acquire(1024);
+  EXPECT_EQ(data, reused.data());
+}
+
+TEST(DownloadBufferPoolTest, RespectsByteBound) {
+  DownloadBufferPool pool(1024);
+  DownloadBufferLocalityScope locality(0);
+  pool.Release(std::vector<char>(128));
+  auto const pooled = pool.CurrentPooledBytes();
+  EXPECT_LE(128, pooled);
+  // The shard is (almost) full, this buffer is simply freed.
+  pool.Release(std::vector<char>(1024));
+  EXPECT_EQ(pooled, pool.CurrentPooledBytes());
+}
+
+TEST(DownloadBufferPoolTest, AcquireWithEmptyPool) {
+  DownloadBufferPool pool(1024);
+  auto buffer = pool.Acquire(2048);
+  EXPECT_EQ(2048, buffer.size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -65,6 +65,32 @@ std::string GenerateMessageBoundary(
   }
   return candidate;
 }
+
+/**
+ * Generate a random string usable as a message boundary without scanning the
+ * payload.
+ *
+ * Searching the payload for a short candidate costs O(payload size) on every
+ * upload. A longer candidate makes the search unnecessary: 22 characters
+ * drawn from a 62-character alphabet carry more than 128 bits of entropy, so
+ * the probability that a given payload contains the boundary is negligible
+ * (below 2^-98 even for a 1 GiB payload).
+ *
+ * @param random_string_generator a callable to generate random strings, as in
+ *     `GenerateMessageBoundary()`.
+ * @return a random string to use as a MIME multipart boundary.
+ */
+template <typename RandomStringGenerator,
+          typename std::enable_if<google::cloud::internal::is_invocable<
+                                      RandomStringGenerator, int>::value,
+                                  int>::type = 0>
+std::string GenerateRandomMessageBoundary(
+    RandomStringGenerator&& random_string_generator) {
+  // ceil(128 / log2(62)) == 22, this stays well below the 70-character limit
+  // for boundaries in RFC 2046.
+  auto constexpr kBoundarySize = 22;
+  return random_string_generator(kBoundarySize);
+}
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -83,6 +83,24 @@ TEST(GenerateMessageBoundaryTest, RequiresGrowth) {
   EXPECT_LT(kMatchedStringLength, boundary.size());
 }
 
+TEST(GenerateMessageBoundaryTest, RandomBoundary) {
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+
+  auto string_generator = [&generator](int n) {
+    static std::string const kChars =
+        "abcdefghijklmnopqrstuvwxyz012456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    return google::cloud::internal::Sample(generator, n, kChars);
+  };
+
+  auto b0 = GenerateRandomMessageBoundary(string_generator);
+  auto b1 = GenerateRandomMessageBoundary(string_generator);
+  // Long enough to make collisions with any payload negligible, but still
+  // within the 70-character limit from RFC 2046.
+  EXPECT_EQ(22U, b0.size());
+  EXPECT_EQ(22U, b1.size());
+  EXPECT_NE(b0, b1);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
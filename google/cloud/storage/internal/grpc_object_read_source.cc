@@ -56,18 +56,18 @@ StatusOr<ReadSourceResult> GrpcObjectReadSource::Read(char* buf,
                                                       std::size_t n) {
   std::multimap<std::string, std::string> headers;
   std::size_t offset = 0;
-  auto update_buf = [&offset, buf, n](std::string source) {
-    if (source.empty()) {
-      return source;
+  auto update_buf = [&offset, buf, n](std::string const& source,
+                                      std::size_t source_offset) {
+    if (source_offset >= source.size()) {
+      return source.size();
     }
-    auto const nbytes = std::min(n - offset, source.size());
-    std::memcpy(buf + offset, source.data(), nbytes);
+    auto const nbytes = std::min(n - offset, source.size() - source_offset);
+    std::memcpy(buf + offset, source.data() + source_offset, nbytes);
     offset += nbytes;
-    source.erase(0, nbytes);
-    return source;
+    return source_offset + nbytes;
   };
 
-  spill_ = update_buf(std::move(spill_));
+  spill_offset_ = update_buf(spill_, spill_offset_);
 
   while (offset < n && stream_) {
     google::storage::v1::GetObjectMediaResponse response;
@@ -75,8 +75,11 @@ StatusOr<ReadSourceResult> GrpcObjectReadSource::Read(char* buf,
 
     // The google.storage.v1.Storage documentation says this field can be empty.
     if (response.has_checksummed_data()) {
-      spill_ = update_buf(
-          std::move(*response.mutable_checksummed_data()->mutable_content()));
+      // Take ownership of the message contents. Any bytes that do not fit in
+      // `buf` are served by later `Read()` calls without additional copies.
+      spill_ =
+          std::move(*response.mutable_checksummed_data()->mutable_content());
+      spill_offset_ = update_buf(spill_, 0);
     }
     if (response.has_object_checksums()) {
       auto& checksums = response.object_checksums();
@@ -65,8 +65,12 @@ class GrpcObjectReadSource : public ObjectReadSource {
       stream_;
 
   // In some cases the gRPC response may contain more data than the buffer
-  // provided by the application. This buffer stores any excess results.
+  // provided by the application. The source takes ownership of the response
+  // contents, and serves any excess bytes in later `Read()` calls directly
+  // from the owned string, tracked by `spill_offset_`, so the excess bytes
+  // are never copied or shifted.
   std::string spill_;
+  std::size_t spill_offset_ = 0;
 
   // The status of the request.
   google::cloud::Status status_;
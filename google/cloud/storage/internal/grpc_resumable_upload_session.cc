@@ -105,8 +105,6 @@ StatusOr<ResumableUploadResponse> GrpcResumableUploadSession::UploadGeneric(
     auto& data = *request.mutable_checksummed_data();
     auto const n = chunk.size();
     data.set_content(std::move(chunk));
-    chunk.clear();
-    chunk.reserve(maximum_chunk_size);
     data.mutable_crc32c()->set_value(crc32c::Crc32c(data.content()));
 
     auto options = grpc::WriteOptions();
@@ -117,6 +115,10 @@ StatusOr<ResumableUploadResponse> GrpcResumableUploadSession::UploadGeneric(
       // TODO(#4157) - compute the MD5 hash value inline
       request.set_finish_write(true);
       options.set_last_message();
+    } else {
+      // Let gRPC coalesce this message with any that follow, instead of
+      // flushing (and pacing on) each InsertObjectRequest separately.
+      options.set_buffer_hint();
     }
 
     if (!upload_writer_->Write(request, options)) return false;
@@ -125,6 +127,11 @@ StatusOr<ResumableUploadResponse> GrpcResumableUploadSession::UploadGeneric(
     request.clear_insert_object_spec();
     request.clear_object_checksums();
 
+    // Recover the content string so its allocation is reused by the next
+    // InsertObjectRequest message.
+    chunk = std::move(*data.mutable_content());
+    chunk.clear();
+
     next_expected_ += n;
     return true;
   };
@@ -73,11 +73,23 @@ std::unique_ptr<HashValidator> CreateHashValidator(
   if (request.RequiresRangeHeader()) {
     return absl::make_unique<NullHashValidator>();
   }
+  // The service-reported hashes cover the stored (compressed) data, they
+  // cannot be validated against the inflated stream.
+  if (request.HasOption<DecompressGzip>() &&
+      request.GetOption<DecompressGzip>().value()) {
+    return absl::make_unique<NullHashValidator>();
+  }
   // `DisableMD5Hash`'s default value is `true`.
   auto disable_md5 = request.GetOption<DisableMD5Hash>().value();
   auto disable_crc32c = request.HasOption<DisableCrc32cChecksum>() &&
                         request.GetOption<DisableCrc32cChecksum>().value();
-  return CreateHashValidator(disable_md5, disable_crc32c);
+  auto validator = CreateHashValidator(disable_md5, disable_crc32c);
+  if (!(disable_md5 && disable_crc32c) &&
+      request.HasOption<EnableHashingPipeline>() &&
+      request.GetOption<EnableHashingPipeline>().value()) {
+    validator = absl::make_unique<PipelinedHashValidator>(std::move(validator));
+  }
+  return validator;
 }
 
 std::unique_ptr<HashValidator> CreateHashValidator(
@@ -86,7 +98,17 @@ std::unique_ptr<HashValidator> CreateHashValidator(
   auto disable_md5 = request.GetOption<DisableMD5Hash>().value();
   auto disable_crc32c = request.HasOption<DisableCrc32cChecksum>() &&
                         request.GetOption<DisableCrc32cChecksum>().value();
-  return CreateHashValidator(disable_md5, disable_crc32c);
+  auto validator = CreateHashValidator(disable_md5, disable_crc32c);
+  if (!(disable_md5 && disable_crc32c) &&
+      request.HasOption<EnableHashingPipeline>() &&
+      request.GetOption<EnableHashingPipeline>().value()) {
+    // The pipelined validator copies each buffer into a bounded queue and
+    // hashes on a dedicated thread, so `ObjectWriteStreambuf` overlaps the
+    // hash computation with the upload of the same bytes. The final
+    // `Finish()` call, made when the stream closes, drains the queue.
+    validator = absl::make_unique<PipelinedHashValidator>(std::move(validator));
+  }
+  return validator;
 }
 
 }  // namespace internal
@@ -107,6 +107,75 @@ HashValidator::Result Crc32cHashValidator::Finish() && {
   return Result{std::move(received_hash_), std::move(computed), is_mismatch};
 }
 
+PipelinedHashValidator::PipelinedHashValidator(
+    std::unique_ptr<HashValidator> impl)
+    : impl_(std::move(impl)), worker_([this] { WorkerLoop(); }) {}
+
+PipelinedHashValidator::~PipelinedHashValidator() { Shutdown(); }
+
+void PipelinedHashValidator::Update(char const* buf, std::size_t n) {
+  if (n == 0) return;
+  std::string copy(buf, n);
+  auto* impl = impl_.get();
+  // NOLINTNEXTLINE(bugprone-exception-escape) - Update() does not throw.
+  Push([impl, copy]() { impl->Update(copy.data(), copy.size()); }, n);
+}
+
+void PipelinedHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
+  auto* impl = impl_.get();
+  ObjectMetadata copy = meta;
+  Push([impl, copy]() { impl->ProcessMetadata(copy); }, 0);
+}
+
+void PipelinedHashValidator::ProcessHeader(std::string const& key,
+                                           std::string const& value) {
+  auto* impl = impl_.get();
+  Push([impl, key, value]() { impl->ProcessHeader(key, value); }, 0);
+}
+
+HashValidator::Result PipelinedHashValidator::Finish() && {
+  Shutdown();
+  return std::move(*impl_).Finish();
+}
+
+void PipelinedHashValidator::Push(std::function<void()> task,
+                                  std::size_t size) {
+  // Allow roughly two maximum-sized libcurl buffers in flight, enough to
+  // overlap the stages without unbounded growth.
+  auto constexpr kMaxQueuedBytes = std::size_t(32 * 1024 * 1024);
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return queued_bytes_ < kMaxQueuedBytes; });
+  queue_.emplace_back(std::move(task), size);
+  queued_bytes_ += size;
+  cv_.notify_all();
+}
+
+void PipelinedHashValidator::Shutdown() {
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    if (shutdown_) return;
+    shutdown_ = true;
+    cv_.notify_all();
+  }
+  if (worker_.joinable()) worker_.join();
+}
+
+void PipelinedHashValidator::WorkerLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return !queue_.empty() || shutdown_; });
+    if (queue_.empty() && shutdown_) return;
+    if (queue_.empty()) continue;
+    auto item = std::move(queue_.front());
+    queue_.pop_front();
+    lk.unlock();
+    item.first();
+    lk.lock();
+    queued_bytes_ -= item.second;
+    cv_.notify_all();
+  }
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
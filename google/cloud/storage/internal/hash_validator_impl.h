@@ -18,6 +18,12 @@
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/version.h"
 #include <openssl/md5.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 namespace google {
 namespace cloud {
@@ -67,6 +73,48 @@ class Crc32cHashValidator : public HashValidator {
   std::string received_hash_;
 };
 
+/**
+ * A decorator that runs another validator on a separate pipeline stage.
+ *
+ * Hashing large downloads (or uploads) on the transfer thread serializes
+ * network receive and hash computation. This decorator copies each buffer to
+ * a bounded queue and applies the wrapped validator's `Update()` calls on a
+ * dedicated thread, so both stages overlap. The queue is bounded to limit
+ * memory growth; when it fills up the transfer thread blocks, effectively
+ * falling back to the serialized behavior.
+ */
+class PipelinedHashValidator : public HashValidator {
+ public:
+  explicit PipelinedHashValidator(std::unique_ptr<HashValidator> impl);
+  ~PipelinedHashValidator() override;
+
+  PipelinedHashValidator(PipelinedHashValidator const&) = delete;
+  PipelinedHashValidator& operator=(PipelinedHashValidator const&) = delete;
+
+  std::string Name() const override { return impl_->Name(); }
+  void Update(char const* buf, std::size_t n) override;
+  void ProcessMetadata(ObjectMetadata const& meta) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  Result Finish() && override;
+
+ private:
+  /// Enqueue @p task, blocking while the queue is over its byte budget.
+  void Push(std::function<void()> task, std::size_t size);
+
+  /// Drain the queue and stop the worker thread.
+  void Shutdown();
+
+  void WorkerLoop();
+
+  std::unique_ptr<HashValidator> impl_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::pair<std::function<void()>, std::size_t>> queue_;
+  std::size_t queued_bytes_ = 0;
+  bool shutdown_ = false;
+  std::thread worker_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
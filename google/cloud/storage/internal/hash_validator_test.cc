@@ -380,6 +380,54 @@ TEST(CreateHashValidator, WriteDisableMD5DefaultConstructor) {
   auto result = std::move(*validator).Finish();
   EXPECT_EQ(kQuickFoxCrc32cChecksum, result.computed);
 }
+
+TEST(PipelinedHashValidator, Simple) {
+  PipelinedHashValidator validator(absl::make_unique<Crc32cHashValidator>());
+  EXPECT_EQ("crc32c", validator.Name());
+  UpdateValidator(validator, "The quick");
+  UpdateValidator(validator, " brown");
+  UpdateValidator(validator, " fox jumps over the lazy dog");
+  validator.ProcessHeader("x-goog-hash", "crc32c=<invalid-value-for-test>");
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ("<invalid-value-for-test>", result.received);
+  EXPECT_EQ(kQuickFoxCrc32cChecksum, result.computed);
+  EXPECT_TRUE(result.is_mismatch);
+}
+
+TEST(PipelinedHashValidator, ManyBuffers) {
+  PipelinedHashValidator validator(absl::make_unique<Crc32cHashValidator>());
+  Crc32cHashValidator expected;
+  std::string const buffer(128 * 1024, 'a');
+  for (int i = 0; i != 64; ++i) {
+    UpdateValidator(validator, buffer);
+    UpdateValidator(expected, buffer);
+  }
+  auto result = std::move(validator).Finish();
+  auto expected_result = std::move(expected).Finish();
+  EXPECT_EQ(expected_result.computed, result.computed);
+}
+
+TEST(PipelinedHashValidator, CreatedByFactory) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(DisableMD5Hash(false),
+                               EnableHashingPipeline(true));
+  auto validator = CreateHashValidator(request);
+  UpdateValidator(*validator, "The quick brown fox jumps over the lazy dog");
+  auto result = std::move(*validator).Finish();
+  EXPECT_EQ("crc32c=" + kQuickFoxCrc32cChecksum + ",md5=" + kQuickFoxMD5Hash,
+            result.computed);
+}
+
+TEST(PipelinedHashValidator, CreatedByFactoryForUploads) {
+  ResumableUploadRequest request("test-bucket", "test-object");
+  request.set_multiple_options(DisableMD5Hash(false),
+                               EnableHashingPipeline(true));
+  auto validator = CreateHashValidator(request);
+  UpdateValidator(*validator, "The quick brown fox jumps over the lazy dog");
+  auto result = std::move(*validator).Finish();
+  EXPECT_EQ("crc32c=" + kQuickFoxCrc32cChecksum + ",md5=" + kQuickFoxMD5Hash,
+            result.computed);
+}
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -18,6 +18,7 @@
 #include "google/cloud/storage/hmac_key_metadata.h"
 #include "google/cloud/storage/internal/generic_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/list_options.h"
 #include "google/cloud/storage/override_default_project.h"
 #include "google/cloud/storage/version.h"
 #include <nlohmann/json.hpp>
@@ -100,7 +101,8 @@ std::ostream& operator<<(std::ostream& os, CreateHmacKeyResponse const& r);
 
 /// Represents a request to call the `HmacKeys: list` API.
 class ListHmacKeysRequest
-    : public GenericHmacKeyRequest<ListHmacKeysRequest, Deleted, MaxResults,
+    : public GenericHmacKeyRequest<ListHmacKeysRequest, Deleted,
+                                   EnablePagePrefetch, MaxResults,
                                    ServiceAccountFilter, UserProject> {
  public:
   explicit ListHmacKeysRequest(std::string project_id)
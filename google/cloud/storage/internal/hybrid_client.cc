@@ -13,16 +13,95 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/hybrid_client.h"
+#include "google/cloud/internal/getenv.h"
+#include "absl/memory/memory.h"
+#include <chrono>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+namespace {
+
+bool UseAdaptiveRouting() {
+  auto v =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_CPP_STORAGE_GRPC_CONFIG")
+          .value_or("");
+  return v.find("adaptive") != std::string::npos;
+}
+
+std::chrono::microseconds ElapsedSince(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
+/**
+ * Reports the duration and size of a download to a `TransportSelector`.
+ *
+ * The cost of a download is only known once the application drains (or
+ * abandons) the stream, so the measurement cannot happen in
+ * `HybridClient::ReadObject()` itself.
+ */
+class TimedObjectReadSource : public ObjectReadSource {
+ public:
+  TimedObjectReadSource(std::unique_ptr<ObjectReadSource> child,
+                        TransportSelector& selector,
+                        TransportSelector::Transport transport)
+      : child_(std::move(child)),
+        selector_(selector),
+        transport_(transport),
+        start_(std::chrono::steady_clock::now()) {}
+  ~TimedObjectReadSource() override { RecordOnce(ok_); }
+
+  bool IsOpen() const override { return child_->IsOpen(); }
+
+  StatusOr<HttpResponse> Close() override {
+    auto response = child_->Close();
+    RecordOnce(ok_ && response.ok());
+    return response;
+  }
+
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    auto result = child_->Read(buf, n);
+    if (result) {
+      bytes_ += result->bytes_received;
+    } else {
+      ok_ = false;
+    }
+    return result;
+  }
+
+ private:
+  void RecordOnce(bool ok) {
+    if (recorded_) return;
+    recorded_ = true;
+    selector_.Record(transport_, ElapsedSince(start_), bytes_, ok);
+  }
+
+  std::unique_ptr<ObjectReadSource> child_;
+  TransportSelector& selector_;
+  TransportSelector::Transport transport_;
+  std::chrono::steady_clock::time_point start_;
+  std::int64_t bytes_ = 0;
+  bool ok_ = true;
+  bool recorded_ = false;
+};
+
+}  // namespace
 
 HybridClient::HybridClient(ClientOptions options)
     : grpc_(std::make_shared<GrpcClient>(options)),
-      curl_(CurlClient::Create(std::move(options))) {}
+      curl_(CurlClient::Create(std::move(options))),
+      adaptive_(UseAdaptiveRouting()),
+      upload_selector_(TransportSelector::Transport::kGrpc),
+      download_selector_(TransportSelector::Transport::kGrpc) {}
+
+RawClient& HybridClient::SelectClient(TransportSelector::Transport transport) {
+  if (transport == TransportSelector::Transport::kGrpc) return *grpc_;
+  return *curl_;
+}
 
 ClientOptions const& HybridClient::client_options() const {
   return curl_->client_options();
@@ -91,7 +170,14 @@ StatusOr<BucketMetadata> HybridClient::LockBucketRetentionPolicy(
 
 StatusOr<ObjectMetadata> HybridClient::InsertObjectMedia(
     InsertObjectMediaRequest const& request) {
-  return grpc_->InsertObjectMedia(request);
+  if (!adaptive_) return grpc_->InsertObjectMedia(request);
+  auto const transport = upload_selector_.Pick();
+  auto const start = std::chrono::steady_clock::now();
+  auto result = SelectClient(transport).InsertObjectMedia(request);
+  upload_selector_.Record(
+      transport, ElapsedSince(start),
+      static_cast<std::int64_t>(request.contents().size()), result.ok());
+  return result;
 }
 
 StatusOr<ObjectMetadata> HybridClient::CopyObject(
@@ -106,7 +192,17 @@ StatusOr<ObjectMetadata> HybridClient::GetObjectMetadata(
 
 StatusOr<std::unique_ptr<ObjectReadSource>> HybridClient::ReadObject(
     ReadObjectRangeRequest const& request) {
-  return grpc_->ReadObject(request);
+  if (!adaptive_) return grpc_->ReadObject(request);
+  auto const transport = download_selector_.Pick();
+  auto source = SelectClient(transport).ReadObject(request);
+  if (!source) {
+    download_selector_.Record(transport, std::chrono::microseconds(0), 0,
+                              false);
+    return source;
+  }
+  return StatusOr<std::unique_ptr<ObjectReadSource>>(
+      absl::make_unique<TimedObjectReadSource>(
+          *std::move(source), download_selector_, transport));
 }
 
 StatusOr<ListObjectsResponse> HybridClient::ListObjects(
@@ -18,6 +18,7 @@
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/grpc_client.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/internal/transport_selector.h"
 #include "google/cloud/storage/version.h"
 
 namespace google {
@@ -144,8 +145,16 @@ class HybridClient : public RawClient {
       DeleteNotificationRequest const&) override;
 
  private:
+  RawClient& SelectClient(TransportSelector::Transport transport);
+
   std::shared_ptr<GrpcClient> grpc_;
   std::shared_ptr<CurlClient> curl_;
+  // When `GOOGLE_CLOUD_CPP_STORAGE_GRPC_CONFIG` contains "adaptive" the media
+  // operations are routed to whichever transport has measured faster lately,
+  // instead of the static gRPC assignment.
+  bool adaptive_;
+  TransportSelector upload_selector_;
+  TransportSelector download_selector_;
 };
 
 }  // namespace internal
@@ -0,0 +1,166 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/inflating_source.h"
+#include "absl/memory/memory.h"
+#include <zlib.h>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+// Accept both gzip (the encoding GCS stores) and raw zlib wrappers.
+auto constexpr kGzipOrZlibWindowBits = 15 + 32;
+
+class ZlibInflater {
+ public:
+  ZlibInflater() {
+    std::memset(&stream_, 0, sizeof(stream_));
+    (void)inflateInit2(&stream_, kGzipOrZlibWindowBits);
+  }
+  ~ZlibInflater() { (void)inflateEnd(&stream_); }
+
+  ZlibInflater(ZlibInflater const&) = delete;
+  ZlibInflater& operator=(ZlibInflater const&) = delete;
+
+  /// Prepare a (possibly pooled) stream for a new download.
+  void Reset() { (void)inflateReset2(&stream_, kGzipOrZlibWindowBits); }
+
+  z_stream& stream() { return stream_; }
+
+ private:
+  z_stream stream_;
+};
+
+namespace {
+
+// The size of the buffer for compressed bytes. This bounds the extra memory
+// used by each download, the inflated bytes go directly into the caller's
+// buffer.
+auto constexpr kInputBufferSize = std::size_t(128 * 1024);
+
+// `inflateInit2()` allocates the (sizable) sliding window, keep a small pool
+// of initialized streams so back-to-back downloads reuse them.
+auto constexpr kInflaterPoolSize = std::size_t(16);
+
+std::unique_ptr<ZlibInflater> AcquireInflater() {
+  static std::mutex mu;
+  static auto& pool = *new std::vector<std::unique_ptr<ZlibInflater>>;
+  std::unique_lock<std::mutex> lk(mu);
+  if (pool.empty()) {
+    lk.unlock();
+    return absl::make_unique<ZlibInflater>();
+  }
+  auto inflater = std::move(pool.back());
+  pool.pop_back();
+  lk.unlock();
+  inflater->Reset();
+  return inflater;
+}
+
+void ReleaseInflater(std::unique_ptr<ZlibInflater> inflater) {
+  static std::mutex mu;
+  static auto& pool = *new std::vector<std::unique_ptr<ZlibInflater>>;
+  std::lock_guard<std::mutex> lk(mu);
+  if (pool.size() >= kInflaterPoolSize) return;
+  pool.push_back(std::move(inflater));
+}
+
+}  // namespace
+
+InflatingSource::InflatingSource(std::unique_ptr<ObjectReadSource> child)
+    : child_(std::move(child)),
+      inflater_(AcquireInflater()),
+      input_(kInputBufferSize) {}
+
+InflatingSource::~InflatingSource() {
+  if (inflater_) ReleaseInflater(std::move(inflater_));
+}
+
+bool InflatingSource::IsOpen() const { return !stream_end_; }
+
+StatusOr<HttpResponse> InflatingSource::Close() {
+  stream_end_ = true;
+  return child_->Close();
+}
+
+StatusOr<ReadSourceResult> InflatingSource::Read(char* buf, std::size_t n) {
+  if (stream_end_) {
+    return ReadSourceResult{0, HttpResponse{HttpStatusCode::kOk, {}, {}}};
+  }
+  auto& zs = inflater_->stream();
+  zs.next_out = reinterpret_cast<Bytef*>(buf);
+  zs.avail_out = static_cast<uInt>(n);
+  ReadSourceResult result{0, HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+  while (zs.avail_out != 0 && !stream_end_) {
+    if (zs.avail_in == 0) {
+      if (child_done_) {
+        return Status(StatusCode::kDataLoss,
+                      "compressed download ended prematurely");
+      }
+      auto chunk = child_->Read(input_.data(), input_.size());
+      if (!chunk) return std::move(chunk).status();
+      if (chunk->response.status_code >= HttpStatusCode::kMinNotSuccess) {
+        // HTTP errors carry an error payload, not compressed data, pass them
+        // through unchanged.
+        return chunk;
+      }
+      result.response.headers.insert(chunk->response.headers.begin(),
+                                     chunk->response.headers.end());
+      if (chunk->response.status_code != HttpStatusCode::kContinue) {
+        child_done_ = true;
+        final_response_.status_code = chunk->response.status_code;
+      }
+      zs.next_in = reinterpret_cast<Bytef*>(input_.data());
+      zs.avail_in = static_cast<uInt>(chunk->bytes_received);
+      if (zs.avail_in == 0) continue;
+    }
+    auto const code = inflate(&zs, Z_NO_FLUSH);
+    if (code == Z_STREAM_END) {
+      stream_end_ = true;
+      break;
+    }
+    if (code != Z_OK && code != Z_BUF_ERROR) {
+      return Status(StatusCode::kDataLoss,
+                    std::string("cannot inflate compressed download: ") +
+                        zError(code));
+    }
+  }
+  result.bytes_received = n - zs.avail_out;
+  if (stream_end_) {
+    result.response.status_code = final_response_.status_code != 0
+                                      ? final_response_.status_code
+                                      : HttpStatusCode::kOk;
+  }
+  return result;
+}
+
+std::unique_ptr<ObjectReadSource> CreateInflatingSource(
+    ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> source) {
+  if (!request.HasOption<DecompressGzip>()) return source;
+  if (!request.GetOption<DecompressGzip>().value()) return source;
+  return absl::make_unique<InflatingSource>(std::move(source));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
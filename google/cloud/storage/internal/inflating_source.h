@@ -0,0 +1,86 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_INFLATING_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_INFLATING_SOURCE_H
+
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/version.h"
+#include <memory>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+// Defined in the .cc file, wraps a zlib inflate stream. The streams are
+// pooled so repeated downloads do not pay for `inflateInit2()` each time.
+class ZlibInflater;
+
+/**
+ * Decompresses gzip data as it is downloaded.
+ *
+ * Objects stored with `contentEncoding: gzip` (and downloaded with
+ * `Cache-Control: no-transform`) arrive compressed. This source wraps the
+ * network source and inflates the data on each `Read()` call, writing
+ * directly into the caller's buffer, so the memory overhead is a single
+ * bounded input buffer for compressed bytes. Combined with `ReadAhead` the
+ * decompression overlaps with the network transfer: the readahead thread
+ * downloads compressed chunks while the application's thread inflates them.
+ *
+ * The `ReadSourceResult` headers and status codes from the wrapped source are
+ * preserved, but the download is only reported complete when the compressed
+ * stream has been fully inflated.
+ */
+class InflatingSource : public ObjectReadSource {
+ public:
+  explicit InflatingSource(std::unique_ptr<ObjectReadSource> child);
+  ~InflatingSource() override;
+
+  bool IsOpen() const override;
+  StatusOr<HttpResponse> Close() override;
+  using ObjectReadSource::Read;
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+ private:
+  std::unique_ptr<ObjectReadSource> child_;
+  std::unique_ptr<ZlibInflater> inflater_;
+  std::vector<char> input_;
+  // The last response received from the wrapped source, delivered with the
+  // bytes that complete the inflated stream.
+  HttpResponse final_response_{0, {}, {}};
+  bool child_done_ = false;
+  bool stream_end_ = false;
+};
+
+/**
+ * Wrap @p source in an `InflatingSource` when requested.
+ *
+ * Returns @p source unchanged unless the request carries a `DecompressGzip`
+ * option set to `true`.
+ */
+std::unique_ptr<ObjectReadSource> CreateInflatingSource(
+    ReadObjectRangeRequest const& request,
+    std::unique_ptr<ObjectReadSource> source);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_INFLATING_SOURCE_H
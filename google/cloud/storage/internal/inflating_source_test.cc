@@ -0,0 +1,189 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/inflating_source.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <zlib.h>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+
+/// Compress @p data with a gzip wrapper, as the service stores it.
+std::string GzipCompress(std::string const& data) {
+  z_stream zs;
+  std::memset(&zs, 0, sizeof(zs));
+  // 15 + 16 requests a gzip (instead of zlib) wrapper.
+  EXPECT_EQ(Z_OK, deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16,
+                               8, Z_DEFAULT_STRATEGY));
+  std::string result(deflateBound(&zs, data.size()), '\0');
+  zs.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  zs.avail_in = static_cast<uInt>(data.size());
+  zs.next_out = reinterpret_cast<Bytef*>(&result[0]);
+  zs.avail_out = static_cast<uInt>(result.size());
+  EXPECT_EQ(Z_STREAM_END, deflate(&zs, Z_FINISH));
+  result.resize(result.size() - zs.avail_out);
+  EXPECT_EQ(Z_OK, deflateEnd(&zs));
+  return result;
+}
+
+/// Create an action that fills the buffer with @p data and returns @p code.
+std::function<StatusOr<ReadSourceResult>(char*, std::size_t)> MakeChunk(
+    std::string data, long code) {  // NOLINT(google-runtime-int)
+  return [data, code](char* buf, std::size_t n) {
+    EXPECT_GE(n, data.size());
+    std::memcpy(buf, data.data(), data.size());
+    return StatusOr<ReadSourceResult>(
+        ReadSourceResult{data.size(), HttpResponse{code, {}, {}}});
+  };
+}
+
+TEST(InflatingSourceTest, InflatesSingleChunk) {
+  std::string const expected = "The quick brown fox jumps over the lazy dog";
+  auto const compressed = GzipCompress(expected);
+
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk(compressed, HttpStatusCode::kOk)));
+
+  InflatingSource source(std::move(mock));
+  char buf[1024];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(expected, std::string(buf, result->bytes_received));
+  EXPECT_EQ(HttpStatusCode::kOk, result->response.status_code);
+  EXPECT_FALSE(source.IsOpen());
+}
+
+TEST(InflatingSourceTest, InflatesAcrossChunks) {
+  std::string expected;
+  for (int i = 0; i != 1000; ++i) {
+    expected += "A fairly compressible line of text, repeated often.\n";
+  }
+  auto const compressed = GzipCompress(expected);
+  auto const half = compressed.size() / 2;
+
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(
+          MakeChunk(compressed.substr(0, half), HttpStatusCode::kContinue)))
+      .WillOnce(
+          Invoke(MakeChunk(compressed.substr(half), HttpStatusCode::kOk)));
+
+  InflatingSource source(std::move(mock));
+  std::string actual;
+  std::vector<char> buf(4096);
+  while (source.IsOpen()) {
+    auto result = source.Read(buf.data(), buf.size());
+    ASSERT_STATUS_OK(result);
+    actual.append(buf.data(), result->bytes_received);
+  }
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(InflatingSourceTest, SmallReadBuffers) {
+  std::string const expected = "The quick brown fox jumps over the lazy dog";
+  auto const compressed = GzipCompress(expected);
+
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk(compressed, HttpStatusCode::kOk)));
+
+  InflatingSource source(std::move(mock));
+  std::string actual;
+  char buf[7];
+  while (source.IsOpen()) {
+    auto result = source.Read(buf, sizeof(buf));
+    ASSERT_STATUS_OK(result);
+    actual.append(buf, result->bytes_received);
+  }
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(InflatingSourceTest, TruncatedStreamIsAnError) {
+  std::string const expected = "The quick brown fox jumps over the lazy dog";
+  auto const compressed = GzipCompress(expected);
+  auto const truncated = compressed.substr(0, compressed.size() / 2);
+
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk(truncated, HttpStatusCode::kOk)));
+
+  InflatingSource source(std::move(mock));
+  char buf[1024];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_FALSE(result.ok());
+  EXPECT_EQ(StatusCode::kDataLoss, result.status().code());
+}
+
+TEST(InflatingSourceTest, CorruptStreamIsAnError) {
+  std::string const garbage = "this is not compressed data at all";
+
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk(garbage, HttpStatusCode::kOk)));
+
+  InflatingSource source(std::move(mock));
+  char buf[1024];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_FALSE(result.ok());
+  EXPECT_EQ(StatusCode::kDataLoss, result.status().code());
+  EXPECT_THAT(result.status().message(), HasSubstr("inflate"));
+}
+
+TEST(InflatingSourceTest, PassesThroughHttpErrors) {
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk("uh oh", HttpStatusCode::kNotFound)));
+
+  InflatingSource source(std::move(mock));
+  char buf[1024];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(HttpStatusCode::kNotFound, result->response.status_code);
+}
+
+TEST(InflatingSourceTest, CreateHonorsOption) {
+  ReadObjectRangeRequest plain("test-bucket", "test-object");
+  auto raw = absl::make_unique<MockObjectReadSource>();
+  auto* expected = raw.get();
+  auto source = CreateInflatingSource(plain, std::move(raw));
+  EXPECT_EQ(expected, source.get());
+
+  ReadObjectRangeRequest decompress("test-bucket", "test-object");
+  decompress.set_multiple_options(DecompressGzip(true));
+  source = CreateInflatingSource(decompress, std::move(source));
+  EXPECT_NE(expected, source.get());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,131 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/json_string_builder.h"
+#include <cstdio>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+void JsonStringBuilder::StartObject() {
+  MaybeComma();
+  buffer_.push_back('{');
+  first_ = true;
+}
+
+void JsonStringBuilder::EndObject() {
+  buffer_.push_back('}');
+  first_ = false;
+}
+
+void JsonStringBuilder::StartObjectField(char const* name) {
+  AppendKey(name);
+  buffer_.push_back('{');
+  first_ = true;
+}
+
+void JsonStringBuilder::StartArrayField(char const* name) {
+  AppendKey(name);
+  buffer_.push_back('[');
+  first_ = true;
+}
+
+void JsonStringBuilder::EndArray() {
+  buffer_.push_back(']');
+  first_ = false;
+}
+
+void JsonStringBuilder::StringField(char const* name,
+                                    std::string const& value) {
+  AppendKey(name);
+  buffer_.push_back('"');
+  AppendEscaped(buffer_, value);
+  buffer_.push_back('"');
+}
+
+void JsonStringBuilder::IntField(char const* name, std::int64_t value) {
+  AppendKey(name);
+  buffer_.append(std::to_string(value));
+}
+
+void JsonStringBuilder::BoolField(char const* name, bool value) {
+  AppendKey(name);
+  buffer_.append(value ? "true" : "false");
+}
+
+void JsonStringBuilder::RawField(char const* name, std::string const& json) {
+  AppendKey(name);
+  buffer_.append(json);
+}
+
+void JsonStringBuilder::AppendEscaped(std::string& buffer,
+                                      std::string const& value) {
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        buffer.append("\\\"");
+        break;
+      case '\\':
+        buffer.append("\\\\");
+        break;
+      case '\b':
+        buffer.append("\\b");
+        break;
+      case '\f':
+        buffer.append("\\f");
+        break;
+      case '\n':
+        buffer.append("\\n");
+        break;
+      case '\r':
+        buffer.append("\\r");
+        break;
+      case '\t':
+        buffer.append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                        static_cast<unsigned int>(c));
+          buffer.append(escaped);
+        } else {
+          // Multi-byte UTF-8 sequences are passed through unchanged.
+          buffer.push_back(c);
+        }
+        break;
+    }
+  }
+}
+
+void JsonStringBuilder::MaybeComma() {
+  if (!first_) buffer_.push_back(',');
+  first_ = false;
+}
+
+void JsonStringBuilder::AppendKey(char const* name) {
+  MaybeComma();
+  buffer_.push_back('"');
+  buffer_.append(name);
+  buffer_.append("\":");
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,82 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_JSON_STRING_BUILDER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_JSON_STRING_BUILDER_H
+
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Serializes small fixed-shape JSON payloads into a caller-provided buffer.
+ *
+ * Building a request payload through `nlohmann::json` constructs a full DOM
+ * and `dump()` allocates a fresh string per call. For the payloads whose
+ * shape is known at compile time (ACL entity/role bodies, compose source
+ * lists, and similar) this class appends the serialized text directly into a
+ * buffer the caller owns, which can be reused across requests. The output is
+ * compact (no whitespace), the same format produced by `dump()`.
+ *
+ * The caller is responsible for well-formedness: fields must be added inside
+ * a `StartObject()` / `EndObject()` pair and array elements inside a
+ * `StartArrayField()` / `EndArray()` pair. This is not a general purpose
+ * serializer, payloads with dynamic shape should continue to use
+ * `nlohmann::json`.
+ */
+class JsonStringBuilder {
+ public:
+  explicit JsonStringBuilder(std::string& buffer) : buffer_(buffer) {}
+
+  void StartObject();
+  void EndObject();
+
+  /// Start a nested `"name": {` object field.
+  void StartObjectField(char const* name);
+
+  /// Start a `"name": [` array field; elements are added with `StartObject()`.
+  void StartArrayField(char const* name);
+  void EndArray();
+
+  void StringField(char const* name, std::string const& value);
+  void IntField(char const* name, std::int64_t value);
+  void BoolField(char const* name, bool value);
+
+  /// Append @p json verbatim; it must be a valid JSON document.
+  void RawField(char const* name, std::string const& json);
+
+  /// Append @p value to @p buffer applying JSON string escaping.
+  static void AppendEscaped(std::string& buffer, std::string const& value);
+
+ private:
+  void MaybeComma();
+  void AppendKey(char const* name);
+
+  std::string& buffer_;
+  bool first_ = true;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_JSON_STRING_BUILDER_H
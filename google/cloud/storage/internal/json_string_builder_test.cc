@@ -0,0 +1,138 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/json_string_builder.h"
+#include <gmock/gmock.h>
+#include <nlohmann/json.hpp>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(JsonStringBuilderTest, EmptyObject) {
+  std::string actual;
+  JsonStringBuilder builder(actual);
+  builder.StartObject();
+  builder.EndObject();
+  EXPECT_EQ("{}", actual);
+}
+
+TEST(JsonStringBuilderTest, FlatObject) {
+  std::string actual;
+  JsonStringBuilder builder(actual);
+  builder.StartObject();
+  builder.StringField("entity", "user-test");
+  builder.StringField("role", "READER");
+  builder.IntField("generation", 12345);
+  builder.BoolField("eventBasedHold", true);
+  builder.EndObject();
+  EXPECT_EQ(
+      R"({"entity":"user-test","role":"READER",)"
+      R"("generation":12345,"eventBasedHold":true})",
+      actual);
+}
+
+TEST(JsonStringBuilderTest, NestedFields) {
+  std::string actual;
+  JsonStringBuilder builder(actual);
+  builder.StartObject();
+  builder.StringField("kind", "storage#composeRequest");
+  builder.StartArrayField("sourceObjects");
+  builder.StartObject();
+  builder.IntField("generation", 1);
+  builder.StringField("name", "object-1");
+  builder.EndObject();
+  builder.StartObject();
+  builder.StringField("name", "object-2");
+  builder.EndObject();
+  builder.EndArray();
+  builder.StartObjectField("destination");
+  builder.StringField("contentType", "text/plain");
+  builder.EndObject();
+  builder.EndObject();
+  EXPECT_EQ(
+      R"({"kind":"storage#composeRequest",)"
+      R"("sourceObjects":[{"generation":1,"name":"object-1"},)"
+      R"({"name":"object-2"}],)"
+      R"("destination":{"contentType":"text/plain"}})",
+      actual);
+}
+
+TEST(JsonStringBuilderTest, RawField) {
+  std::string actual;
+  JsonStringBuilder builder(actual);
+  builder.StartObject();
+  builder.RawField("metadata", R"({"label":"test-label"})");
+  builder.StringField("name", "object-name");
+  builder.EndObject();
+  EXPECT_EQ(R"({"metadata":{"label":"test-label"},"name":"object-name"})",
+            actual);
+}
+
+TEST(JsonStringBuilderTest, ReusesBuffer) {
+  std::string buffer;
+  {
+    JsonStringBuilder builder(buffer);
+    builder.StartObject();
+    builder.StringField("role", "OWNER");
+    builder.EndObject();
+  }
+  EXPECT_EQ(R"({"role":"OWNER"})", buffer);
+  buffer.clear();
+  {
+    JsonStringBuilder builder(buffer);
+    builder.StartObject();
+    builder.StringField("role", "READER");
+    builder.EndObject();
+  }
+  EXPECT_EQ(R"({"role":"READER"})", buffer);
+}
+
+TEST(JsonStringBuilderTest, StringEscaping) {
+  std::string actual;
+  JsonStringBuilder builder(actual);
+  builder.StartObject();
+  builder.StringField("value", "quote=\" backslash=\\ tab=\t newline=\n");
+  builder.StringField("control", std::string("\x01\x1f", 2));
+  builder.StringField("utf8", "caf\xC3\xA9");
+  builder.EndObject();
+  // The output must be parseable and round-trip the original values.
+  auto parsed = nlohmann::json::parse(actual);
+  EXPECT_EQ("quote=\" backslash=\\ tab=\t newline=\n",
+            parsed.value("value", ""));
+  EXPECT_EQ(std::string("\x01\x1f", 2), parsed.value("control", ""));
+  EXPECT_EQ("caf\xC3\xA9", parsed.value("utf8", ""));
+}
+
+TEST(JsonStringBuilderTest, MatchesDumpFormat) {
+  std::string actual;
+  JsonStringBuilder builder(actual);
+  builder.StartObject();
+  builder.StringField("entity", "user-test");
+  builder.StringField("role", "READER");
+  builder.EndObject();
+
+  nlohmann::json expected{{"entity", "user-test"}, {"role", "READER"}};
+  EXPECT_EQ(expected.dump(), actual);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -164,6 +164,12 @@ StatusOr<ObjectMetadata> LoggingClient::GetObjectMetadata(
   return MakeCall(*client_, &RawClient::GetObjectMetadata, request, __func__);
 }
 
+StatusOr<BatchGetObjectMetadataResponse> LoggingClient::BatchGetObjectMetadata(
+    BatchGetObjectMetadataRequest const& request) {
+  return MakeCall(*client_, &RawClient::BatchGetObjectMetadata, request,
+                  __func__);
+}
+
 StatusOr<std::unique_ptr<ObjectReadSource>> LoggingClient::ReadObject(
     ReadObjectRangeRequest const& request) {
   return MakeCallNoResponseLogging(*client_, &RawClient::ReadObject, request,
@@ -63,6 +63,8 @@ class LoggingClient : public RawClient {
       CopyObjectRequest const& request) override;
   StatusOr<ObjectMetadata> GetObjectMetadata(
       GetObjectMetadataRequest const& request) override;
+  StatusOr<BatchGetObjectMetadataResponse> BatchGetObjectMetadata(
+      BatchGetObjectMetadataRequest const& request) override;
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
   StatusOr<ListObjectsResponse> ListObjects(ListObjectsRequest const&) override;
@@ -0,0 +1,121 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file_region.h"
+#include <limits>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+MappedFileRegion::MappedFileRegion(MappedFileRegion&& rhs) noexcept
+    : base_(rhs.base_),
+      base_size_(rhs.base_size_),
+      data_offset_(rhs.data_offset_),
+      size_(rhs.size_) {
+  rhs.base_ = nullptr;
+  rhs.base_size_ = 0;
+  rhs.data_offset_ = 0;
+  rhs.size_ = 0;
+}
+
+MappedFileRegion& MappedFileRegion::operator=(MappedFileRegion&& rhs) noexcept {
+  if (this == &rhs) return *this;
+  Unmap();
+  base_ = rhs.base_;
+  base_size_ = rhs.base_size_;
+  data_offset_ = rhs.data_offset_;
+  size_ = rhs.size_;
+  rhs.base_ = nullptr;
+  rhs.base_size_ = 0;
+  rhs.data_offset_ = 0;
+  rhs.size_ = 0;
+  return *this;
+}
+
+MappedFileRegion::~MappedFileRegion() { Unmap(); }
+
+#if !defined(_WIN32)
+
+StatusOr<MappedFileRegion> MappedFileRegion::Map(std::string const& file_name,
+                                                 std::uint64_t offset,
+                                                 std::uint64_t length) {
+  if (length == 0) return MappedFileRegion{};
+  if (length > (std::numeric_limits<std::size_t>::max)()) {
+    return Status(StatusCode::kOutOfRange,
+                  "mapping length does not fit in std::size_t");
+  }
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Status(StatusCode::kNotFound,
+                  "cannot open <" + file_name + "> for mapping");
+  }
+  // `mmap()` requires a page-aligned offset, align down and remember how far
+  // into the mapping the requested range starts.
+  auto const page_size =
+      static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+  auto const aligned_offset = offset - offset % page_size;
+  auto const data_offset = static_cast<std::size_t>(offset - aligned_offset);
+  auto const base_size = static_cast<std::size_t>(length) + data_offset;
+  void* base = ::mmap(nullptr, base_size, PROT_READ, MAP_PRIVATE, fd,
+                      static_cast<off_t>(aligned_offset));
+  // The mapping keeps its own reference to the file, the descriptor is no
+  // longer needed.
+  ::close(fd);
+  if (base == MAP_FAILED) {
+    return Status(StatusCode::kUnavailable,
+                  "cannot map <" + file_name + "> into memory");
+  }
+  // Uploads consume the file front to back, let the kernel prefetch
+  // accordingly. This is only a hint, failures are harmless.
+  (void)::madvise(base, base_size, MADV_SEQUENTIAL);
+  return MappedFileRegion(base, base_size, data_offset,
+                          static_cast<std::size_t>(length));
+}
+
+void MappedFileRegion::Unmap() {
+  if (base_ == nullptr) return;
+  ::munmap(base_, base_size_);
+  base_ = nullptr;
+  base_size_ = 0;
+  data_offset_ = 0;
+  size_ = 0;
+}
+
+#else  // _WIN32
+
+StatusOr<MappedFileRegion> MappedFileRegion::Map(std::string const&,
+                                                 std::uint64_t,
+                                                 std::uint64_t length) {
+  if (length == 0) return MappedFileRegion{};
+  return Status(StatusCode::kUnimplemented,
+                "memory-mapped files are not supported on this platform");
+}
+
+void MappedFileRegion::Unmap() {}
+
+#endif  // _WIN32
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,92 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_REGION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_REGION_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A read-only, memory-mapped view over a range of a file.
+ *
+ * Uploading a large file copies every byte from the kernel page cache into an
+ * application buffer before handing it to the transport. Mapping the file
+ * avoids that copy: the transport reads straight from the page cache, and the
+ * mapping is advised for sequential access so the kernel prefetches ahead of
+ * the upload.
+ *
+ * On platforms without `mmap()` (e.g. Windows) `Map()` returns an error and
+ * the callers fall back to their stream-based code paths.
+ */
+class MappedFileRegion {
+ public:
+  /**
+   * Map @p length bytes of @p file_name starting at @p offset.
+   *
+   * The @p offset does not need to be page-aligned, the implementation aligns
+   * the mapping as needed. Mapping an empty range succeeds and yields a region
+   * with `data() == nullptr` and `size() == 0`.
+   */
+  static StatusOr<MappedFileRegion> Map(std::string const& file_name,
+                                        std::uint64_t offset,
+                                        std::uint64_t length);
+
+  MappedFileRegion() = default;
+  MappedFileRegion(MappedFileRegion&& rhs) noexcept;
+  MappedFileRegion& operator=(MappedFileRegion&& rhs) noexcept;
+  MappedFileRegion(MappedFileRegion const&) = delete;
+  MappedFileRegion& operator=(MappedFileRegion const&) = delete;
+  ~MappedFileRegion();
+
+  /// The first byte of the requested range, `nullptr` for empty regions.
+  char const* data() const {
+    return static_cast<char const*>(base_) == nullptr
+               ? nullptr
+               : static_cast<char const*>(base_) + data_offset_;
+  }
+  /// The number of bytes in the requested range.
+  std::size_t size() const { return size_; }
+
+ private:
+  MappedFileRegion(void* base, std::size_t base_size, std::size_t data_offset,
+                   std::size_t size)
+      : base_(base),
+        base_size_(base_size),
+        data_offset_(data_offset),
+        size_(size) {}
+
+  void Unmap();
+
+  void* base_ = nullptr;
+  std::size_t base_size_ = 0;
+  std::size_t data_offset_ = 0;
+  std::size_t size_ = 0;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_REGION_H
@@ -0,0 +1,83 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file_region.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(MappedFileRegionTest, EmptyRange) {
+  google::cloud::storage::testing::TempFile temp_file("unused");
+  auto region = MappedFileRegion::Map(temp_file.name(), 0, 0);
+  ASSERT_STATUS_OK(region);
+  EXPECT_EQ(nullptr, region->data());
+  EXPECT_EQ(0, region->size());
+}
+
+TEST(MappedFileRegionTest, MissingFile) {
+  auto region =
+      MappedFileRegion::Map("/no/such/directory/no-such-file.txt", 0, 16);
+  EXPECT_FALSE(region.ok());
+}
+
+// The remaining tests require a working `mmap()`.
+#if !defined(_WIN32)
+
+TEST(MappedFileRegionTest, MapWholeFile) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  google::cloud::storage::testing::TempFile temp_file(contents);
+
+  auto region = MappedFileRegion::Map(temp_file.name(), 0, contents.size());
+  ASSERT_STATUS_OK(region);
+  ASSERT_EQ(contents.size(), region->size());
+  EXPECT_EQ(contents, std::string(region->data(), region->size()));
+}
+
+TEST(MappedFileRegionTest, MapUnalignedOffset) {
+  std::string const contents = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  google::cloud::storage::testing::TempFile temp_file(contents);
+
+  // Any small offset is almost certainly not page-aligned.
+  auto region = MappedFileRegion::Map(temp_file.name(), 3, 8);
+  ASSERT_STATUS_OK(region);
+  ASSERT_EQ(8, region->size());
+  EXPECT_EQ(contents.substr(3, 8), std::string(region->data(), region->size()));
+}
+
+TEST(MappedFileRegionTest, MoveTransfersOwnership) {
+  std::string const contents = "move me";
+  google::cloud::storage::testing::TempFile temp_file(contents);
+
+  auto region = MappedFileRegion::Map(temp_file.name(), 0, contents.size());
+  ASSERT_STATUS_OK(region);
+  MappedFileRegion moved(std::move(*region));
+  ASSERT_EQ(contents.size(), moved.size());
+  EXPECT_EQ(contents, std::string(moved.data(), moved.size()));
+}
+
+#endif  // _WIN32
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
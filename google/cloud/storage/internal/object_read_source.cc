@@ -0,0 +1,56 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_read_source.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+StatusOr<ReadSourceResult> ObjectReadSource::Read(
+    MutableBufferSequence const& buffers) {
+  ReadSourceResult result{
+      0, HttpResponse{HttpStatusCode::kContinue, std::string{}, {}}};
+  for (auto const& b : buffers) {
+    if (b.empty()) continue;
+    auto partial = Read(b.data(), b.size());
+    if (!partial) {
+      // Errors are fatal for the full download, any data deposited in
+      // previous buffers will be discarded by the caller.
+      return std::move(partial).status();
+    }
+    result.bytes_received += partial->bytes_received;
+    result.response.status_code = partial->response.status_code;
+    for (auto& kv : partial->response.headers) {
+      result.response.headers.emplace(std::move(kv.first),
+                                      std::move(kv.second));
+    }
+    if (!partial->response.payload.empty()) {
+      result.response.payload = std::move(partial->response.payload);
+    }
+    if (partial->response.status_code >= HttpStatusCode::kMinNotSuccess) break;
+    // A short read indicates the download completed (or stalled), let the
+    // caller decide whether to issue another read.
+    if (partial->bytes_received < b.size()) break;
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_READ_SOURCE_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_READ_SOURCE_H
 
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
@@ -69,6 +70,16 @@ class ObjectReadSource {
   /// Read more data from the download, returning any HTTP headers and error
   /// codes.
   virtual StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) = 0;
+
+  /**
+   * Read more data from the download into a sequence of caller-owned buffers.
+   *
+   * The data is deposited directly into the provided buffers, without going
+   * through any intermediate buffer owned by this class. The default
+   * implementation issues one `Read()` call per buffer, stopping early if the
+   * download completes or stalls.
+   */
+  virtual StatusOr<ReadSourceResult> Read(MutableBufferSequence const& buffers);
 };
 
 /**
@@ -80,6 +91,7 @@ class ObjectReadErrorSource : public ObjectReadSource {
 
   bool IsOpen() const override { return false; }
   StatusOr<HttpResponse> Close() override { return status_; }
+  using ObjectReadSource::Read;
   StatusOr<ReadSourceResult> Read(char*, std::size_t) override {
     return status_;
   }
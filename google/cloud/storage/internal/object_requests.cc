@@ -14,11 +14,13 @@
 
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/internal/binary_data_as_debug_string.h"
+#include "google/cloud/storage/internal/json_string_builder.h"
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/storage/internal/object_acl_requests.h"
 #include "google/cloud/storage/object_metadata.h"
 #include <nlohmann/json.hpp>
 #include <cinttypes>
+#include <cstdlib>
 #include <sstream>
 
 namespace google {
@@ -40,10 +42,38 @@ void SetIfNotEmpty(nlohmann::json& json, char const* key,
   }
   json[key] = value;
 }
+
+/**
+ * Extracts (or copies) the string field @p name from @p json.
+ *
+ * `FromString()` owns its `nlohmann::json` tree and discards it wholesale
+ * once the metadata object is built, so the strings can be stolen from the
+ * tree instead of copied. A dozen string members per `ObjectMetadata` makes
+ * this visible on metadata-heavy workloads. The `const` overload preserves
+ * copy semantics for callers that keep their tree.
+ */
+std::string GetString(nlohmann::json& json, char const* name) {
+  auto i = json.find(name);
+  if (i == json.end()) return std::string{};
+  return std::move(i->get_ref<std::string&>());
+}
+
+std::string GetString(nlohmann::json const& json, char const* name) {
+  return json.value(name, "");
+}
+
+/// @copydoc GetString()
+std::string StringValue(nlohmann::json& value) {
+  return std::move(value.get_ref<std::string&>());
+}
+
+std::string StringValue(nlohmann::json const& value) {
+  return value.get<std::string>();
+}
 }  // namespace
 
-StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
-    nlohmann::json const& json) {
+template <typename Json>
+StatusOr<ObjectMetadata> ObjectMetadataParser::FromJsonImpl(Json& json) {
   if (!json.is_object()) {
     return Status(StatusCode::kInvalidArgument, __func__);
   }
@@ -54,6 +84,7 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
   }
 
   if (json.count("acl") != 0) {
+    result.acl_.reserve(json["acl"].size());
     for (auto const& kv : json["acl"].items()) {
       auto parsed = ObjectAccessControlParser::FromJson(kv.value());
       if (!parsed.ok()) {
@@ -63,29 +94,29 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
     }
   }
 
-  result.bucket_ = json.value("bucket", "");
-  result.cache_control_ = json.value("cacheControl", "");
+  result.bucket_ = GetString(json, "bucket");
+  result.cache_control_ = GetString(json, "cacheControl");
   result.component_count_ = internal::ParseIntField(json, "componentCount");
-  result.content_disposition_ = json.value("contentDisposition", "");
-  result.content_encoding_ = json.value("contentEncoding", "");
-  result.content_language_ = json.value("contentLanguage", "");
-  result.content_type_ = json.value("contentType", "");
-  result.crc32c_ = json.value("crc32c", "");
+  result.content_disposition_ = GetString(json, "contentDisposition");
+  result.content_encoding_ = GetString(json, "contentEncoding");
+  result.content_language_ = GetString(json, "contentLanguage");
+  result.content_type_ = GetString(json, "contentType");
+  result.crc32c_ = GetString(json, "crc32c");
   if (json.count("customerEncryption") != 0) {
-    auto field = json["customerEncryption"];
+    auto& field = json["customerEncryption"];
     CustomerEncryption e;
-    e.encryption_algorithm = field.value("encryptionAlgorithm", "");
-    e.key_sha256 = field.value("keySha256", "");
+    e.encryption_algorithm = GetString(field, "encryptionAlgorithm");
+    e.key_sha256 = GetString(field, "keySha256");
     result.customer_encryption_ = std::move(e);
   }
   result.event_based_hold_ = internal::ParseBoolField(json, "eventBasedHold");
   result.generation_ = internal::ParseLongField(json, "generation");
-  result.kms_key_name_ = json.value("kmsKeyName", "");
-  result.md5_hash_ = json.value("md5Hash", "");
-  result.media_link_ = json.value("mediaLink", "");
+  result.kms_key_name_ = GetString(json, "kmsKeyName");
+  result.md5_hash_ = GetString(json, "md5Hash");
+  result.media_link_ = GetString(json, "mediaLink");
   if (json.count("metadata") > 0) {
-    for (auto const& kv : json["metadata"].items()) {
-      result.metadata_.emplace(kv.key(), kv.value().get<std::string>());
+    for (auto&& kv : json["metadata"].items()) {
+      result.metadata_.emplace(kv.key(), StringValue(kv.value()));
     }
   }
   result.retention_expiration_time_ =
@@ -98,10 +129,17 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
   return result;
 }
 
+StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
+    nlohmann::json const& json) {
+  return FromJsonImpl(json);
+}
+
 StatusOr<ObjectMetadata> ObjectMetadataParser::FromString(
     std::string const& payload) {
   auto json = nlohmann::json::parse(payload, nullptr, false);
-  return FromJson(json);
+  // The tree is released wholesale when this function returns, so the parser
+  // can move the strings out of it instead of copying them.
+  return FromJsonImpl(json);
 }
 
 nlohmann::json ObjectMetadataJsonForCompose(ObjectMetadata const& meta) {
@@ -192,33 +230,219 @@ std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r) {
   return os << "}";
 }
 
-StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
-    std::string const& payload) {
-  auto json = nlohmann::json::parse(payload, nullptr, false);
-  if (!json.is_object()) {
-    return Status(StatusCode::kInvalidArgument, __func__);
+namespace {
+/**
+ * A SAX event handler to decode list objects responses incrementally.
+ *
+ * Large list pages are a CPU hotspot when parsed into a full DOM: the
+ * intermediate tree for the whole page is built, traversed, and discarded.
+ * This handler materializes each element of `items` as soon as it is complete
+ * and never holds more than one element in memory, while the uninteresting
+ * parts of the response are skipped without allocating anything.
+ */
+class ListObjectsResponseSaxHandler : public nlohmann::json::json_sax_t {
+ public:
+  explicit ListObjectsResponseSaxHandler(ListObjectsResponse& result)
+      : result_(result) {}
+
+  Status const& status() const { return status_; }
+
+  bool null() override { return Scalar(nullptr); }
+  bool boolean(bool v) override { return Scalar(v); }
+  bool number_integer(number_integer_t v) override { return Scalar(v); }
+  bool number_unsigned(number_unsigned_t v) override { return Scalar(v); }
+  bool number_float(number_float_t v, string_t const&) override {
+    return Scalar(v);
+  }
+
+  bool string(string_t& v) override {
+    switch (context_) {
+      case Context::kRoot:
+        if (root_key_ == "nextPageToken") result_.next_page_token = v;
+        return true;
+      case Context::kPrefixes:
+        result_.prefixes.emplace_back(std::move(v));
+        return true;
+      default:
+        return Scalar(std::move(v));
+    }
   }
 
-  ListObjectsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
+  bool binary(binary_t& v) override {
+    return Scalar(nlohmann::json::binary(std::move(v)));
+  }
 
-  for (auto const& kv : json["items"].items()) {
-    auto parsed = internal::ObjectMetadataParser::FromJson(kv.value());
-    if (!parsed.ok()) {
-      return std::move(parsed).status();
+  bool start_object(std::size_t) override {
+    if (!seen_root_) {
+      seen_root_ = true;
+      return true;
+    }
+    switch (context_) {
+      case Context::kRoot:
+        context_ = Context::kSkip;
+        skip_depth_ = 1;
+        return true;
+      case Context::kItems:
+        return StartContainer(nlohmann::json::object());
+      case Context::kPrefixes:
+        return PrefixTypeError();
+      case Context::kSkip:
+        ++skip_depth_;
+        return true;
+    }
+    return true;
+  }
+
+  bool key(string_t& v) override {
+    if (context_ == Context::kRoot) {
+      root_key_ = v;
+    } else if (context_ == Context::kItems) {
+      item_key_ = std::move(v);
+    }
+    return true;
+  }
+
+  bool end_object() override { return EndContainer(); }
+
+  bool start_array(std::size_t) override {
+    if (!seen_root_) {
+      // The top-level value must be an object.
+      status_ = Status(StatusCode::kInvalidArgument, "FromHttpResponse");
+      return false;
+    }
+    switch (context_) {
+      case Context::kRoot:
+        if (root_key_ == "items") {
+          context_ = Context::kItems;
+        } else if (root_key_ == "prefixes") {
+          context_ = Context::kPrefixes;
+        } else {
+          context_ = Context::kSkip;
+          skip_depth_ = 1;
+        }
+        return true;
+      case Context::kItems:
+        return StartContainer(nlohmann::json::array());
+      case Context::kPrefixes:
+        return PrefixTypeError();
+      case Context::kSkip:
+        ++skip_depth_;
+        return true;
+    }
+    return true;
+  }
+
+  bool end_array() override {
+    switch (context_) {
+      case Context::kItems:
+        if (stack_.empty()) {
+          // This is the end of the `items` array itself.
+          context_ = Context::kRoot;
+          return true;
+        }
+        return EndContainer();
+      case Context::kPrefixes:
+        context_ = Context::kRoot;
+        return true;
+      case Context::kSkip:
+        if (--skip_depth_ == 0) context_ = Context::kRoot;
+        return true;
+      default:
+        return true;
+    }
+  }
+
+  bool parse_error(std::size_t, std::string const&,
+                   nlohmann::detail::exception const&) override {
+    status_ = Status(StatusCode::kInvalidArgument, "FromHttpResponse");
+    return false;
+  }
+
+ private:
+  enum class Context { kRoot, kItems, kPrefixes, kSkip };
+
+  template <typename T>
+  bool Scalar(T&& v) {
+    switch (context_) {
+      case Context::kItems:
+        if (stack_.empty()) return FinishItem(std::forward<T>(v));
+        Insert(std::forward<T>(v));
+        return true;
+      case Context::kPrefixes:
+        return PrefixTypeError();
+      default:
+        return true;
     }
-    result.items.emplace_back(std::move(*parsed));
   }
 
-  for (auto const& prefix_iterator : json["prefixes"].items()) {
-    auto const& prefix = prefix_iterator.value();
-    if (!prefix.is_string()) {
-      return Status(StatusCode::kInternal,
-                    "List Objects Response's 'prefix' is not a string.");
+  bool StartContainer(nlohmann::json v) {
+    if (stack_.empty()) {
+      item_ = std::move(v);
+      stack_.push_back(&item_);
+      return true;
     }
-    result.prefixes.emplace_back(prefix.get<std::string>());
+    stack_.push_back(Insert(std::move(v)));
+    return true;
   }
 
+  bool EndContainer() {
+    if (context_ == Context::kSkip) {
+      if (--skip_depth_ == 0) context_ = Context::kRoot;
+      return true;
+    }
+    if (context_ != Context::kItems) return true;
+    stack_.pop_back();
+    if (!stack_.empty()) return true;
+    return FinishItem(std::move(item_));
+  }
+
+  nlohmann::json* Insert(nlohmann::json v) {
+    auto* parent = stack_.back();
+    if (parent->is_array()) {
+      parent->push_back(std::move(v));
+      return &parent->back();
+    }
+    auto& slot = (*parent)[item_key_];
+    slot = std::move(v);
+    return &slot;
+  }
+
+  bool FinishItem(nlohmann::json v) {
+    auto parsed = ObjectMetadataParser::FromJson(v);
+    if (!parsed.ok()) {
+      status_ = std::move(parsed).status();
+      return false;
+    }
+    result_.items.emplace_back(std::move(*parsed));
+    return true;
+  }
+
+  bool PrefixTypeError() {
+    status_ = Status(StatusCode::kInternal,
+                     "List Objects Response's 'prefix' is not a string.");
+    return false;
+  }
+
+  ListObjectsResponse& result_;
+  Status status_;
+  bool seen_root_ = false;
+  Context context_ = Context::kRoot;
+  std::size_t skip_depth_ = 0;
+  std::string root_key_;
+  std::string item_key_;
+  nlohmann::json item_;
+  std::vector<nlohmann::json*> stack_;
+};
+}  // namespace
+
+StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
+    std::string const& payload) {
+  ListObjectsResponse result;
+  ListObjectsResponseSaxHandler handler(result);
+  if (!nlohmann::json::sax_parse(payload, &handler)) {
+    if (!handler.status().ok()) return handler.status();
+    return Status(StatusCode::kInvalidArgument, __func__);
+  }
   return result;
 }
 
@@ -240,6 +464,121 @@ std::ostream& operator<<(std::ostream& os, GetObjectMetadataRequest const& r) {
   return os << "}";
 }
 
+std::ostream& operator<<(std::ostream& os,
+                         BatchGetObjectMetadataRequest const& r) {
+  os << "BatchGetObjectMetadataRequest={bucket_name=" << r.bucket_name()
+     << ", object_names=[";
+  char const* sep = "";
+  for (auto const& name : r.object_names()) {
+    os << sep << name;
+    sep = ", ";
+  }
+  os << "]";
+  r.DumpOptions(os, ", ");
+  return os << "}";
+}
+
+namespace {
+/// Extract the part boundary from the `Content-Type` header, if any.
+StatusOr<std::string> ExtractMultipartBoundary(
+    std::multimap<std::string, std::string> const& headers) {
+  // Header names are normalized to lowercase when the response is parsed.
+  for (auto loc = headers.equal_range("content-type");
+       loc.first != loc.second; ++loc.first) {
+    auto const& kv = *loc.first;
+    auto pos = kv.second.find("boundary=");
+    if (pos == std::string::npos) continue;
+    auto value = kv.second.substr(pos + (sizeof("boundary=") - 1));
+    if (!value.empty() && value.front() == '"') {
+      return value.substr(1, value.find('"', 1) - 1);
+    }
+    return value.substr(0, value.find_first_of("; \t\r\n"));
+  }
+  return Status(StatusCode::kInvalidArgument,
+                "batch response missing multipart boundary");
+}
+
+/// Parse one `application/http` part of a batch response.
+StatusOr<ObjectMetadata> ParseBatchPart(std::string const& part) {
+  // The part headers (Content-Type, Content-ID) end at the first empty line,
+  // the embedded HTTP response starts right after it.
+  auto const http_pos = part.find("\r\n\r\n");
+  if (http_pos == std::string::npos ||
+      part.compare(http_pos + 4, 5, "HTTP/") != 0) {
+    return Status(StatusCode::kInternal, "malformed batch response part");
+  }
+  auto const status_pos = part.find(' ', http_pos + 4);
+  if (status_pos == std::string::npos) {
+    return Status(StatusCode::kInternal, "malformed batch response part");
+  }
+  char* end = nullptr;
+  auto const code = std::strtol(part.c_str() + status_pos + 1, &end, 10);
+  if (code < HttpStatusCode::kMinContinue ||
+      code >= HttpStatusCode::kMinInvalidCode) {
+    return Status(StatusCode::kInternal, "malformed batch response part");
+  }
+  auto const body_pos = part.find("\r\n\r\n", status_pos);
+  std::string body =
+      body_pos == std::string::npos ? std::string{} : part.substr(body_pos + 4);
+  while (!body.empty() && (body.back() == '\n' || body.back() == '\r')) {
+    body.pop_back();
+  }
+  if (code >= HttpStatusCode::kMinNotSuccess) {
+    return AsStatus(HttpResponse{code, std::move(body), {}});
+  }
+  return ObjectMetadataParser::FromString(body);
+}
+}  // namespace
+
+StatusOr<BatchGetObjectMetadataResponse>
+BatchGetObjectMetadataResponse::FromHttpResponse(HttpResponse const& response,
+                                                 std::size_t expected_count) {
+  if (response.status_code >= HttpStatusCode::kMinNotSuccess) {
+    return AsStatus(response);
+  }
+  auto boundary = ExtractMultipartBoundary(response.headers);
+  if (!boundary) return std::move(boundary).status();
+  auto const marker = "--" + *boundary;
+
+  BatchGetObjectMetadataResponse result;
+  result.results.reserve(expected_count);
+  // The service preserves the request order, so the parts can be matched to
+  // the object names by position.
+  auto pos = response.payload.find(marker);
+  while (pos != std::string::npos) {
+    pos += marker.size();
+    if (response.payload.compare(pos, 2, "--") == 0) break;
+    auto part_end = response.payload.find(marker, pos);
+    if (part_end == std::string::npos) break;
+    result.results.push_back(
+        ParseBatchPart(response.payload.substr(pos, part_end - pos)));
+    pos = part_end;
+  }
+  if (result.results.size() != expected_count) {
+    std::ostringstream os;
+    os << "batch response contained " << result.results.size()
+       << " parts, expected " << expected_count;
+    return Status(StatusCode::kInternal, std::move(os).str());
+  }
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& os,
+                         BatchGetObjectMetadataResponse const& r) {
+  os << "BatchGetObjectMetadataResponse={";
+  char const* sep = "";
+  for (auto const& result : r.results) {
+    os << sep;
+    if (result) {
+      os << *result;
+    } else {
+      os << "status=" << result.status();
+    }
+    sep = ", ";
+  }
+  return os << "}";
+}
+
 std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r) {
   os << "InsertObjectMediaRequest={bucket_name=" << r.bucket_name()
      << ", object_name=" << r.object_name();
@@ -247,10 +586,10 @@ std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r) {
   std::size_t constexpr kMaxDumpSize = 1024;
   if (r.contents().size() > kMaxDumpSize) {
     os << ", contents[0..1024]=\n"
-       << BinaryDataAsDebugString(r.contents().data(), kMaxDumpSize);
+       << BinaryDataDebugView(r.contents().data(), kMaxDumpSize);
   } else {
     os << ", contents=\n"
-       << BinaryDataAsDebugString(r.contents().data(), r.contents().size());
+       << BinaryDataDebugView(r.contents().data(), r.contents().size());
   }
   return os << "}";
 }
@@ -265,6 +604,15 @@ std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r) {
 }
 
 bool ReadObjectRangeRequest::RequiresNoCache() const {
+  // Client-side decompression needs the stored (compressed) bytes, so the
+  // service must not apply decompressive transcoding.
+  if (HasOption<DecompressGzip>() && GetOption<DecompressGzip>().value()) {
+    return true;
+  }
+  return RequiresRangeHeader();
+}
+
+bool ReadObjectRangeRequest::RequiresRangeHeader() const {
   if (HasOption<ReadRange>()) {
     return true;
   }
@@ -274,10 +622,6 @@ bool ReadObjectRangeRequest::RequiresNoCache() const {
   return HasOption<ReadLast>();
 }
 
-bool ReadObjectRangeRequest::RequiresRangeHeader() const {
-  return RequiresNoCache();
-}
-
 std::string ReadObjectRangeRequest::RangeHeader() const {
   if (HasOption<ReadRange>() && HasOption<ReadFromOffset>()) {
     auto range = GetOption<ReadRange>().value();
@@ -386,7 +730,7 @@ ReadObjectRangeResponse ReadObjectRangeResponse::FromHttpResponse(
 std::ostream& operator<<(std::ostream& os, ReadObjectRangeResponse const& r) {
   return os << "ReadObjectRangeResponse={range=" << r.first_byte << "-"
             << r.last_byte << "/" << r.object_size << ", contents=\n"
-            << BinaryDataAsDebugString(r.contents.data(), r.contents.size())
+            << BinaryDataDebugView(r.contents.data(), r.contents.size())
             << "}";
 }
 
@@ -412,32 +756,36 @@ ComposeObjectRequest::ComposeObjectRequest(
       source_objects_(std::move(source_objects)) {}
 
 std::string ComposeObjectRequest::JsonPayload() const {
-  nlohmann::json compose_object_payload_json;
-  compose_object_payload_json["kind"] = "storage#composeRequest";
-  nlohmann::json destination_metadata_payload;
+  // The payload has a fixed shape, serialize it directly instead of building
+  // a `nlohmann::json` object just to `dump()` it. Fields are emitted in
+  // alphabetical order, the same order `dump()` produces.
+  std::string payload;
+  JsonStringBuilder builder(payload);
+  builder.StartObject();
   if (HasOption<WithObjectMetadata>()) {
-    destination_metadata_payload =
+    auto destination =
         ObjectMetadataJsonForCompose(GetOption<WithObjectMetadata>().value());
+    if (!destination.is_null()) {
+      builder.RawField("destination", destination.dump());
+    }
   }
-  if (!destination_metadata_payload.is_null()) {
-    compose_object_payload_json["destination"] = destination_metadata_payload;
-  }
-  nlohmann::json source_object_list;
+  builder.StringField("kind", "storage#composeRequest");
+  builder.StartArrayField("sourceObjects");
   for (auto const& source_object : source_objects_) {
-    nlohmann::json source_object_json;
-    source_object_json["name"] = source_object.object_name;
+    builder.StartObject();
     if (source_object.generation.has_value()) {
-      source_object_json["generation"] = source_object.generation.value();
+      builder.IntField("generation", source_object.generation.value());
     }
     if (source_object.if_generation_match.has_value()) {
-      source_object_json["ifGenerationMatch"] =
-          source_object.if_generation_match.value();
+      builder.IntField("ifGenerationMatch",
+                       source_object.if_generation_match.value());
     }
-    source_object_list.emplace_back(std::move(source_object_json));
+    builder.StringField("name", source_object.object_name);
+    builder.EndObject();
   }
-  compose_object_payload_json["sourceObjects"] = source_object_list;
-
-  return compose_object_payload_json.dump();
+  builder.EndArray();
+  builder.EndObject();
+  return payload;
 }
 
 std::ostream& operator<<(std::ostream& os, ComposeObjectRequest const& r) {
@@ -616,7 +964,7 @@ std::ostream& operator<<(std::ostream& os, UploadChunkRequest const& r) {
   char const* sep = "";
   for (auto const& b : r.payload()) {
     os << sep << "{"
-       << BinaryDataAsDebugString(b.data(), b.size(), kMaxOutputBytes) << "}";
+       << BinaryDataDebugView(b.data(), b.size(), kMaxOutputBytes) << "}";
     sep = ", ";
   }
   return os << "}}";
@@ -20,6 +20,7 @@
 #include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/generic_object_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/list_options.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
@@ -36,6 +37,13 @@ namespace internal {
 struct ObjectMetadataParser {
   static StatusOr<ObjectMetadata> FromJson(nlohmann::json const& json);
   static StatusOr<ObjectMetadata> FromString(std::string const& payload);
+
+ private:
+  // The shared implementation of `FromJson()` and `FromString()`. When the
+  // parser owns the tree (`Json` is non-const) the strings are moved out of
+  // it instead of copied.
+  template <typename Json>
+  static StatusOr<ObjectMetadata> FromJsonImpl(Json& json);
 };
 
 //@{
@@ -58,9 +66,9 @@ nlohmann::json ObjectMetadataJsonForUpdate(ObjectMetadata const& meta);
  * Represents a request to the `Objects: list` API.
  */
 class ListObjectsRequest
-    : public GenericRequest<ListObjectsRequest, MaxResults, Prefix, Delimiter,
-                            StartOffset, EndOffset, Projection, UserProject,
-                            Versions> {
+    : public GenericRequest<ListObjectsRequest, EnablePagePrefetch, MaxResults,
+                            Prefix, Delimiter, StartOffset, EndOffset,
+                            Projection, UserProject, Versions> {
  public:
   ListObjectsRequest() = default;
   explicit ListObjectsRequest(std::string bucket_name)
@@ -105,6 +113,66 @@ class GetObjectMetadataRequest
 
 std::ostream& operator<<(std::ostream& os, GetObjectMetadataRequest const& r);
 
+/**
+ * Represents a batched request for the metadata of several objects.
+ *
+ * Fetching the metadata of many objects one `Objects: get` call at a time
+ * costs one HTTPS round trip per object. The JSON API can multiplex up to 100
+ * such calls over a single HTTP request using the `/batch` endpoint, which
+ * collapses the round trips for metadata-heavy workloads.
+ */
+class BatchGetObjectMetadataRequest
+    : public GenericRequest<BatchGetObjectMetadataRequest, Projection,
+                            UserProject> {
+ public:
+  BatchGetObjectMetadataRequest() = default;
+  BatchGetObjectMetadataRequest(std::string bucket_name,
+                                std::vector<std::string> object_names)
+      : bucket_name_(std::move(bucket_name)),
+        object_names_(std::move(object_names)) {}
+
+  std::string const& bucket_name() const { return bucket_name_; }
+  std::vector<std::string> const& object_names() const {
+    return object_names_;
+  }
+  BatchGetObjectMetadataRequest& set_object_names(
+      std::vector<std::string> object_names) {
+    object_names_ = std::move(object_names);
+    return *this;
+  }
+
+ private:
+  std::string bucket_name_;
+  std::vector<std::string> object_names_;
+};
+
+std::ostream& operator<<(std::ostream& os,
+                         BatchGetObjectMetadataRequest const& r);
+
+/**
+ * The result of a `BatchGetObjectMetadataRequest`.
+ *
+ * Each element corresponds, in order, to one of the requested object names.
+ * The outer request can succeed while individual entries fail, e.g. because
+ * one of the objects does not exist.
+ */
+struct BatchGetObjectMetadataResponse {
+  /**
+   * Parse a `multipart/mixed` batch response.
+   *
+   * The part boundary is taken from the `Content-Type` header of @p response.
+   * Returns an error if the payload does not contain exactly
+   * @p expected_count parts.
+   */
+  static StatusOr<BatchGetObjectMetadataResponse> FromHttpResponse(
+      HttpResponse const& response, std::size_t expected_count);
+
+  std::vector<StatusOr<ObjectMetadata>> results;
+};
+
+std::ostream& operator<<(std::ostream& os,
+                         BatchGetObjectMetadataResponse const& r);
+
 /**
  * Represents a request to the `Objects: insert` API with a string for the
  * media.
@@ -182,10 +250,11 @@ std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r);
  */
 class ReadObjectRangeRequest
     : public GenericObjectRequest<
-          ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadFromOffset,
-          ReadRange, ReadLast, UserProject> {
+          ReadObjectRangeRequest, DecompressGzip, DisableCrc32cChecksum,
+          DisableMD5Hash, EnableHashingPipeline, EncryptionKey, Generation,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetagenerationMatch,
+          IfMetagenerationNotMatch, ReadAhead, ReadFromOffset, ReadRange,
+          ReadLast, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 
@@ -364,11 +433,12 @@ class ResumableUploadRequest
     : public GenericObjectRequest<
           ResumableUploadRequest, ContentEncoding, ContentType,
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
-          UserProject, UploadFromOffset, UploadLimit, WithObjectMetadata,
-          UploadContentLength> {
+          EnableHashingPipeline, EnablePipelinedUploads, EncryptionKey,
+          IfGenerationMatch,
+          IfGenerationNotMatch, IfMetagenerationMatch, IfMetagenerationNotMatch,
+          KmsKeyName, MD5HashValue, PredefinedAcl, Projection,
+          UseResumableUploadSession, UserProject, UploadFromOffset, UploadLimit,
+          WithObjectMetadata, UploadContentLength> {
  public:
   ResumableUploadRequest() = default;
 
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/internal/object_acl_requests.h"
+#include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -49,6 +50,52 @@ TEST(ObjectRequestsTest, ParseAclListFailure) {
   EXPECT_FALSE(actual.ok());
 }
 
+/// @test `FromString()` moves strings out of its tree, verify the results are
+/// identical to `FromJson()`, which cannot.
+TEST(ObjectRequestsTest, ParseFromStringMatchesFromJson) {
+  std::string text = R"""({
+      "acl": [{
+        "kind": "storage#objectAccessControl",
+        "id": "acl-id-0",
+        "entity": "user-qux",
+        "role": "OWNER"
+      }],
+      "bucket": "foo-bar",
+      "cacheControl": "no-cache",
+      "contentDisposition": "attachment; filename=test.txt",
+      "contentEncoding": "identity",
+      "contentLanguage": "en",
+      "contentType": "text/plain",
+      "crc32c": "deadbeef",
+      "customerEncryption": {
+        "encryptionAlgorithm": "AES256",
+        "keySha256": "abc123"
+      },
+      "etag": "XYZ=",
+      "generation": "12345",
+      "id": "foo-bar/baz/12345",
+      "kind": "storage#object",
+      "kmsKeyName": "/project-test/us-central1/test-ring/test-key",
+      "md5Hash": "xa1b2c3==",
+      "mediaLink": "https://storage.googleapis.com/foo-bar/baz?generation=1",
+      "metadata": {
+        "foo": "bar",
+        "baz": "qux"
+      },
+      "name": "baz",
+      "size": 102400,
+      "storageClass": "STANDARD",
+      "timeCreated": "2018-05-19T19:31:14Z",
+      "updated": "2018-05-19T19:31:24Z"
+})""";
+  auto from_string = internal::ObjectMetadataParser::FromString(text);
+  ASSERT_STATUS_OK(from_string);
+  auto from_json =
+      internal::ObjectMetadataParser::FromJson(nlohmann::json::parse(text));
+  ASSERT_STATUS_OK(from_json);
+  EXPECT_EQ(*from_json, *from_string);
+}
+
 TEST(ObjectRequestsTest, List) {
   ListObjectsRequest request("my-bucket");
   EXPECT_EQ("my-bucket", request.bucket_name());
@@ -134,6 +181,36 @@ TEST(ObjectRequestsTest, ParseListResponseFailureInItems) {
   EXPECT_FALSE(actual.ok());
 }
 
+TEST(ObjectRequestsTest, ParseListResponseSkipsUnknownFields) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "unknown-object": {"nested": {"deeply": [1, 2, 3]}},
+      "unknown-array": [{"a": 1}, [2], "3"],
+      "nextPageToken": "a-token",
+      "items": [{
+        "bucket": "foo-bar",
+        "name": "baz",
+        "metadata": {"key": "value"}
+      }],
+      "prefixes": ["p/"]
+    })""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text).value();
+  EXPECT_EQ("a-token", actual.next_page_token);
+  ASSERT_EQ(1, actual.items.size());
+  EXPECT_EQ("baz", actual.items[0].name());
+  EXPECT_EQ("value", actual.items[0].metadata("key"));
+  EXPECT_THAT(actual.prefixes, ::testing::ElementsAre("p/"));
+}
+
+TEST(ObjectRequestsTest, ParseListResponseFailureInPrefixes) {
+  std::string text = R"""({"prefixes": [ {"not": "a string"} ]})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text);
+  EXPECT_FALSE(actual.ok());
+  EXPECT_EQ(StatusCode::kInternal, actual.status().code());
+}
+
 TEST(ObjectRequestsTest, Get) {
   GetObjectMetadataRequest request("my-bucket", "my-object");
   request.set_multiple_options(Generation(1), IfMetagenerationMatch(3));
@@ -146,6 +223,77 @@ TEST(ObjectRequestsTest, Get) {
   EXPECT_THAT(str, HasSubstr("ifMetagenerationMatch=3"));
 }
 
+TEST(ObjectRequestsTest, BatchGet) {
+  BatchGetObjectMetadataRequest request("my-bucket",
+                                        {"object-1", "object-2", "object-3"});
+  request.set_multiple_options(Projection("full"),
+                               UserProject("my-billed-project"));
+  std::ostringstream os;
+  os << request;
+  auto str = os.str();
+  EXPECT_THAT(str, HasSubstr("my-bucket"));
+  EXPECT_THAT(str, HasSubstr("object-1"));
+  EXPECT_THAT(str, HasSubstr("object-3"));
+  EXPECT_THAT(str, HasSubstr("projection=full"));
+  EXPECT_THAT(str, HasSubstr("userProject=my-billed-project"));
+}
+
+TEST(ObjectRequestsTest, BatchGetResponseParse) {
+  std::string const crlf = "\r\n";
+  std::string const marker = "--batch_foo";
+  std::string payload =
+      marker + crlf +                                                    //
+      "Content-Type: application/http" + crlf +                          //
+      "Content-ID: <response-item-0>" + crlf + crlf +                    //
+      "HTTP/1.1 200 OK" + crlf +                                         //
+      "Content-Type: application/json; charset=UTF-8" + crlf + crlf +    //
+      R"""({"bucket": "my-bucket", "name": "object-1"})""" + crlf +      //
+      marker + crlf +                                                    //
+      "Content-Type: application/http" + crlf +                          //
+      "Content-ID: <response-item-1>" + crlf + crlf +                    //
+      "HTTP/1.1 404 Not Found" + crlf +                                  //
+      "Content-Type: application/json; charset=UTF-8" + crlf + crlf +    //
+      R"""({"error": {"message": "object-2 not found"}})""" + crlf +     //
+      marker + "--" + crlf;
+  HttpResponse response{
+      200,
+      std::move(payload),
+      {{"content-type", "multipart/mixed; boundary=batch_foo"}}};
+  auto actual =
+      BatchGetObjectMetadataResponse::FromHttpResponse(response, 2);
+  ASSERT_STATUS_OK(actual);
+  ASSERT_EQ(2, actual->results.size());
+  ASSERT_STATUS_OK(actual->results[0]);
+  EXPECT_EQ("object-1", actual->results[0]->name());
+  EXPECT_EQ(StatusCode::kNotFound, actual->results[1].status().code());
+}
+
+TEST(ObjectRequestsTest, BatchGetResponseParseMissingBoundary) {
+  HttpResponse response{200, "", {{"content-type", "application/json"}}};
+  auto actual = BatchGetObjectMetadataResponse::FromHttpResponse(response, 1);
+  EXPECT_EQ(StatusCode::kInvalidArgument, actual.status().code());
+}
+
+TEST(ObjectRequestsTest, BatchGetResponseParseTruncated) {
+  std::string const crlf = "\r\n";
+  std::string payload =
+      "--b" + crlf +                                     //
+      "Content-Type: application/http" + crlf + crlf +   //
+      "HTTP/1.1 200 OK" + crlf + crlf +                  //
+      R"""({"name": "object-1"})""" + crlf +             //
+      "--b--" + crlf;
+  HttpResponse response{
+      200, std::move(payload), {{"content-type", "multipart/mixed; boundary=b"}}};
+  auto actual = BatchGetObjectMetadataResponse::FromHttpResponse(response, 2);
+  EXPECT_EQ(StatusCode::kInternal, actual.status().code());
+}
+
+TEST(ObjectRequestsTest, BatchGetResponseParseHttpError) {
+  HttpResponse response{403, "uh-oh", {}};
+  auto actual = BatchGetObjectMetadataResponse::FromHttpResponse(response, 1);
+  EXPECT_EQ(StatusCode::kPermissionDenied, actual.status().code());
+}
+
 TEST(ObjectRequestsTest, InsertObjectMedia) {
   InsertObjectMediaRequest request("my-bucket", "my-object", "object contents");
   request.set_multiple_options(
@@ -13,7 +13,9 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/internal/download_buffer_pool.h"
 #include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/upload_buffer_pool.h"
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/log.h"
 #include "absl/memory/memory.h"
@@ -39,6 +41,10 @@ ObjectReadStreambuf::ObjectReadStreambuf(ReadObjectRangeRequest const& request,
   status_ = std::move(status);
 }
 
+ObjectReadStreambuf::~ObjectReadStreambuf() {
+  DownloadBufferPool::Instance().Release(std::move(current_ios_buffer_));
+}
+
 bool ObjectReadStreambuf::IsOpen() const { return source_->IsOpen(); }
 
 void ObjectReadStreambuf::Close() {
@@ -58,6 +64,13 @@ StatusOr<ObjectReadStreambuf::int_type> ObjectReadStreambuf::Peek() {
   }
 
   auto constexpr kInitialPeekRead = 128 * 1024;
+  if (current_ios_buffer_.capacity() < kInitialPeekRead) {
+    // A pooled buffer was released (and its pages first-touched) by a thread
+    // with the same locality hint, typically on the same NUMA node as this
+    // one, so refilling it avoids cross-socket memory traffic.
+    current_ios_buffer_ = DownloadBufferPool::Instance().Acquire(
+        static_cast<std::size_t>(kInitialPeekRead));
+  }
   current_ios_buffer_.resize(kInitialPeekRead);
   std::size_t n = current_ios_buffer_.size();
   StatusOr<ReadSourceResult> read_result =
@@ -218,6 +231,79 @@ std::streamsize ObjectReadStreambuf::xsgetn(char* s, std::streamsize count) {
   return run_validator_if_closed(Status());
 }
 
+StatusOr<std::size_t> ObjectReadStreambuf::Read(MutableBufferSequence buffers) {
+  if (!status_.ok()) return status_;
+
+  // Consume any data already buffered in the get area first.
+  std::size_t offset = 0;
+  auto const avail = in_avail();
+  if (avail > 0) {
+    auto from_internal =
+        (std::min)(static_cast<std::size_t>(avail), TotalBytes(buffers));
+    std::size_t copied = 0;
+    for (auto const& b : buffers) {
+      if (copied >= from_internal) break;
+      auto const n = (std::min)(b.size(), from_internal - copied);
+      std::memcpy(b.data(), gptr() + copied, n);
+      copied += n;
+    }
+    gbump(static_cast<int>(from_internal));
+    offset = from_internal;
+    PopFrontBytes(buffers, from_internal);
+  }
+  if (TotalBytes(buffers) == 0) return offset;
+
+  StatusOr<ReadSourceResult> read_result = source_->Read(buffers);
+  if (!read_result) {
+    status_ = std::move(read_result).status();
+    return status_;
+  }
+
+  // The received bytes were deposited directly into `buffers`, update the
+  // hashes in place.
+  std::size_t remaining = read_result->bytes_received;
+  for (auto const& b : buffers) {
+    if (remaining == 0) break;
+    auto const n = (std::min)(b.size(), remaining);
+    hash_validator_->Update(b.data(), n);
+    remaining -= n;
+  }
+  offset += read_result->bytes_received;
+  source_pos_ += read_result->bytes_received;
+
+  for (auto const& kv : read_result->response.headers) {
+    hash_validator_->ProcessHeader(kv.first, kv.second);
+    headers_.emplace(kv.first, kv.second);
+  }
+  if (read_result->response.status_code >= HttpStatusCode::kMinNotSuccess) {
+    status_ = AsStatus(read_result->response);
+    return status_;
+  }
+
+  // Only validate the checksums once the stream is closed.
+  if (!IsOpen()) {
+    hash_validator_result_ = std::move(*hash_validator_).Finish();
+    if (hash_validator_result_.is_mismatch) {
+      std::string msg;
+      msg += __func__;
+      msg += "(): mismatched hashes in download";
+      msg += ", computed=";
+      msg += hash_validator_result_.computed;
+      msg += ", received=";
+      msg += hash_validator_result_.received;
+      if (status_.ok()) {
+        // If there is an existing error, we should report that instead because
+        // it is more specific, for example, every permanent network error will
+        // produce invalid checksums, but that is not the interesting
+        // information.
+        status_ = Status(StatusCode::kDataLoss, msg);
+      }
+      return status_;
+    }
+  }
+  return offset;
+}
+
 ObjectReadStreambuf::int_type ObjectReadStreambuf::ReportError(Status status) {
   // The only way to report errors from a std::basic_streambuf<> (which this
   // class derives from) is to throw exceptions:
@@ -247,13 +333,15 @@ void ObjectReadStreambuf::SetEmptyRegion() {
 
 ObjectWriteStreambuf::ObjectWriteStreambuf(
     std::unique_ptr<ResumableUploadSession> upload_session,
-    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator)
+    std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator,
+    bool pipelined_uploads)
     : upload_session_(std::move(upload_session)),
       max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
       hash_validator_(std::move(hash_validator)),
       last_response_(ResumableUploadResponse{
-          {}, 0, {}, ResumableUploadResponse::kInProgress, {}}) {
-  current_ios_buffer_.resize(max_buffer_size_);
+          {}, 0, {}, ResumableUploadResponse::kInProgress, {}}),
+      pipelined_uploads_(pipelined_uploads) {
+  current_ios_buffer_ = UploadBufferPool::Instance().Acquire(max_buffer_size_);
   auto pbeg = current_ios_buffer_.data();
   auto pend = pbeg + current_ios_buffer_.size();
   setp(pbeg, pend);
@@ -264,6 +352,14 @@ ObjectWriteStreambuf::ObjectWriteStreambuf(
   }
 }
 
+ObjectWriteStreambuf::~ObjectWriteStreambuf() {
+  // An abandoned stream may still have a chunk on the wire, wait for it, the
+  // background task writes into members of this class.
+  if (pending_upload_.valid()) pending_upload_.wait();
+  UploadBufferPool::Instance().Release(std::move(pending_buffer_));
+  UploadBufferPool::Instance().Release(std::move(current_ios_buffer_));
+}
+
 ObjectReadStreambuf::pos_type ObjectReadStreambuf::seekpos(
     pos_type /*pos*/, std::ios_base::openmode /*which*/) {
   // TODO(4013): Implement proper seeking.
@@ -339,6 +435,7 @@ ObjectWriteStreambuf::int_type ObjectWriteStreambuf::overflow(int_type ch) {
 
 void ObjectWriteStreambuf::FlushFinal() {
   if (!IsOpen()) return;
+  if (!WaitForPendingUpload()) return;
 
   // Calculate the portion of the buffer that needs to be uploaded, if any.
   auto const actual_size = put_area_size();
@@ -386,6 +483,38 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
     hash_validator_->Update(b.data(), b.size());
   }
 
+  if (pipelined_uploads_) {
+    // At most one chunk is on the wire at a time, wait for the previous one.
+    if (!WaitForPendingUpload()) return;
+    // Copy the payload to a (pooled) buffer owned by the background task, so
+    // the application can keep filling the put area while the chunk uploads.
+    pending_buffer_ = UploadBufferPool::Instance().Acquire(rounded_size);
+    std::size_t offset = 0;
+    for (auto const& b : payload) {
+      std::memcpy(pending_buffer_.data() + offset, b.data(), b.size());
+      offset += b.size();
+    }
+    pending_first_byte_ = upload_session_->next_expected_byte();
+    pending_expected_next_byte_ = pending_first_byte_ + rounded_size;
+    auto* session = upload_session_.get();
+    auto* data = pending_buffer_.data();
+    pending_upload_ =
+        std::async(std::launch::async, [session, data, rounded_size] {
+          return session->UploadChunk({ConstBuffer(data, rounded_size)});
+        });
+
+    // Reset the internal buffer and copy any trailing bytes from `buffers` to
+    // it.
+    auto pbeg = current_ios_buffer_.data();
+    setp(pbeg, pbeg + current_ios_buffer_.size());
+    PopFrontBytes(buffers, rounded_size);
+    for (auto const& b : buffers) {
+      std::copy(b.begin(), b.end(), pptr());
+      pbump(static_cast<int>(b.size()));
+    }
+    return;
+  }
+
   // GCS upload returns an updated range header that sets the next expected
   // byte. Check to make sure it remains consistent with the bytes stored in the
   // buffer.
@@ -435,6 +564,39 @@ void ObjectWriteStreambuf::FlushRoundChunk(ConstBufferSequence buffers) {
   }
 }
 
+bool ObjectWriteStreambuf::WaitForPendingUpload() {
+  if (!pending_upload_.valid()) return true;
+  last_response_ = pending_upload_.get();
+  UploadBufferPool::Instance().Release(std::move(pending_buffer_));
+
+  if (last_response_) {
+    // The same consistency checks as in the synchronous path, against the
+    // range recorded when the chunk was dispatched.
+    auto actual_next_byte = upload_session_->next_expected_byte();
+    if (actual_next_byte < pending_expected_next_byte_ &&
+        actual_next_byte < pending_first_byte_) {
+      std::ostringstream error_message;
+      error_message << "Could not continue upload stream. GCS requested byte "
+                    << actual_next_byte << " which has already been uploaded.";
+      last_response_ = Status(StatusCode::kAborted, error_message.str());
+    } else if (actual_next_byte > pending_expected_next_byte_) {
+      std::ostringstream error_message;
+      error_message << "Could not continue upload stream. "
+                    << "GCS requested unexpected byte. (expected: "
+                    << pending_expected_next_byte_
+                    << ", actual: " << actual_next_byte << ")";
+      last_response_ = Status(StatusCode::kAborted, error_message.str());
+    }
+  }
+
+  if (!last_response_) {
+    upload_session_ = absl::make_unique<ResumableUploadSessionError>(
+        last_response_.status(), next_expected_byte(), resumable_session_id());
+    return false;
+  }
+  return true;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
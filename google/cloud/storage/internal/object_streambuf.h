@@ -15,12 +15,14 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
+#include <future>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -48,7 +50,7 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
   /// Create a streambuf in a permanent error status.
   ObjectReadStreambuf(ReadObjectRangeRequest const& request, Status status);
 
-  ~ObjectReadStreambuf() override = default;
+  ~ObjectReadStreambuf() override;
 
   ObjectReadStreambuf(ObjectReadStreambuf&&) noexcept = delete;
   ObjectReadStreambuf& operator=(ObjectReadStreambuf&&) noexcept = delete;
@@ -61,6 +63,19 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
 
   bool IsOpen() const;
   void Close();
+
+  /**
+   * Scatter/gather read into a sequence of caller-owned buffers.
+   *
+   * Any data already buffered in the get area is consumed first, then the
+   * remaining bytes are deposited by the data source (typically libcurl)
+   * directly into @p buffers, without an intermediate copy.
+   *
+   * @return the total number of bytes placed in @p buffers, which may be less
+   *     than their total capacity if the download completed.
+   */
+  StatusOr<std::size_t> Read(MutableBufferSequence buffers);
+
   Status const& status() const { return status_; }
   std::string const& received_hash() const {
     return hash_validator_result_.received;
@@ -102,9 +117,10 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
 
   ObjectWriteStreambuf(std::unique_ptr<ResumableUploadSession> upload_session,
                        std::size_t max_buffer_size,
-                       std::unique_ptr<HashValidator> hash_validator);
+                       std::unique_ptr<HashValidator> hash_validator,
+                       bool pipelined_uploads = false);
 
-  ~ObjectWriteStreambuf() override = default;
+  ~ObjectWriteStreambuf() override;
 
   ObjectWriteStreambuf(ObjectWriteStreambuf&& rhs) noexcept = delete;
   ObjectWriteStreambuf& operator=(ObjectWriteStreambuf&& rhs) noexcept = delete;
@@ -149,6 +165,14 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   /// Upload a round chunk
   void FlushRoundChunk(ConstBufferSequence buffers);
 
+  /**
+   * Wait for the previous pipelined chunk (if any) to complete.
+   *
+   * Returns `false` if the chunk failed, in which case `last_response_` holds
+   * the error and the session has been replaced with an error session.
+   */
+  bool WaitForPendingUpload();
+
   /// The current used bytes in the put area (aka current_ios_buffer_)
   std::size_t put_area_size() const { return pptr() - pbase(); }
 
@@ -161,6 +185,14 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   HashValidator::Result hash_validator_result_;
 
   StatusOr<ResumableUploadResponse> last_response_;
+
+  // State for pipelined uploads: one chunk may be on the wire while the
+  // application fills the put area.
+  bool pipelined_uploads_ = false;
+  std::future<StatusOr<ResumableUploadResponse>> pending_upload_;
+  std::vector<char> pending_buffer_;
+  std::uint64_t pending_first_byte_ = 0;
+  std::uint64_t pending_expected_next_byte_ = 0;
 };
 
 }  // namespace internal
@@ -19,6 +19,7 @@
 #include "google/cloud/testing_util/assert_ok.h"
 #include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <cstring>
 
 namespace google {
 namespace cloud {
@@ -649,6 +650,76 @@ TEST(ObjectWriteStreambufTest, PubsyncTooSmall) {
   EXPECT_EQ(0, streambuf.pubsync());
 }
 
+/// @test Verify that pipelined uploads send the same chunks as the
+/// synchronous mode.
+TEST(ObjectWriteStreambufTest, PipelinedUpload) {
+  auto mock = absl::make_unique<testing::MockResumableUploadSession>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload_1(3 * quantum, '*');
+  std::string const payload_2("trailer");
+  std::size_t next_byte = 0;
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce([&](ConstBufferSequence const& p) {
+        // In pipelined mode the chunk is copied to a single buffer owned by
+        // the background task.
+        EXPECT_THAT(p, ElementsAre(ConstBuffer{payload_1}));
+        next_byte += TotalBytes(p);
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      });
+  EXPECT_CALL(*mock, UploadFinalChunk({{payload_2}},
+                                      payload_1.size() + payload_2.size()))
+      .WillOnce(Return(make_status_or(
+          ResumableUploadResponse{"{}",
+                                  payload_1.size() + payload_2.size() - 1,
+                                  {},
+                                  ResumableUploadResponse::kInProgress,
+                                  {}})));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly([&]() {
+    return next_byte;
+  });
+
+  ObjectWriteStreambuf streambuf(std::move(mock), 3 * quantum,
+                                 absl::make_unique<NullHashValidator>(),
+                                 /*pipelined_uploads=*/true);
+
+  streambuf.sputn(payload_1.data(), payload_1.size());
+  streambuf.sputn(payload_2.data(), payload_2.size());
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+}
+
+/// @test Verify that errors from a pipelined chunk surface on Close().
+TEST(ObjectWriteStreambufTest, PipelinedUploadErrorSurfacesOnClose) {
+  auto mock =
+      absl::make_unique<NiceMock<testing::MockResumableUploadSession>>();
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload(3 * quantum, '*');
+  std::string const session_id = "upload_id";
+
+  ON_CALL(*mock, next_expected_byte()).WillByDefault(Return(0));
+  EXPECT_CALL(*mock, UploadChunk(_)).WillOnce([](ConstBufferSequence const&) {
+    return Status(StatusCode::kInvalidArgument, "Invalid Argument");
+  });
+  EXPECT_CALL(*mock, session_id).WillOnce(ReturnRef(session_id));
+  ObjectWriteStreambuf streambuf(std::move(mock), quantum,
+                                 absl::make_unique<NullHashValidator>(),
+                                 /*pipelined_uploads=*/true);
+
+  // The error is reported on the next flush (or Close()), not on the write
+  // that triggered the upload.
+  streambuf.sputn(payload.data(), payload.size());
+
+  auto response = streambuf.Close();
+  EXPECT_EQ(StatusCode::kInvalidArgument, response.status().code())
+      << ", status=" << response.status();
+  EXPECT_EQ(streambuf.resumable_session_id(), session_id);
+}
+
 TEST(ObjectReadStreambufTest, FailedTellg) {
   ObjectReadStreambuf buf(ReadObjectRangeRequest{},
                           Status(StatusCode::kInvalidArgument, "some error"));
@@ -688,6 +759,75 @@ TEST(ObjectReadStreambufTest, Success) {
   EXPECT_EQ(128 * 1024 + 15 + 15 + 10, stream.tellg());
 }
 
+TEST(ObjectReadStreambufTest, ScatterGatherRead) {
+  auto read_source = absl::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read(_, _))
+      .WillOnce([](char* buf, std::size_t n) {
+        EXPECT_GE(n, 4);
+        std::memcpy(buf, "abcd", 4);
+        return ReadSourceResult{4, {}};
+      })
+      .WillOnce([](char* buf, std::size_t n) {
+        EXPECT_EQ(3, n);
+        std::memcpy(buf, "efg", 3);
+        return ReadSourceResult{3, {}};
+      });
+  ObjectReadStreambuf buf(ReadObjectRangeRequest{}, std::move(read_source), 0);
+
+  std::vector<char> b0(4);
+  std::vector<char> b1(3);
+  auto actual = buf.Read({
+      MutableBuffer{b0.data(), b0.size()},
+      MutableBuffer{b1.data(), b1.size()},
+  });
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(7, *actual);
+  EXPECT_EQ("abcd", std::string(b0.begin(), b0.end()));
+  EXPECT_EQ("efg", std::string(b1.begin(), b1.end()));
+}
+
+TEST(ObjectReadStreambufTest, ScatterGatherReadDrainsGetArea) {
+  auto read_source = absl::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read(_, _))
+      .WillOnce([](char* buf, std::size_t n) {
+        EXPECT_GE(n, 8);
+        std::memcpy(buf, "abcdefgh", 8);
+        return ReadSourceResult{8, {}};
+      })
+      .WillOnce([](char* buf, std::size_t n) {
+        EXPECT_EQ(2, n);
+        std::memcpy(buf, "ij", 2);
+        return ReadSourceResult{2, {}};
+      });
+  ObjectReadStreambuf buf(ReadObjectRangeRequest{}, std::move(read_source), 0);
+
+  std::istream stream(&buf);
+  // Trigger an underflow() so the get area holds buffered data.
+  EXPECT_EQ('a', stream.get());
+
+  std::vector<char> b0(9);
+  auto actual = buf.Read({MutableBuffer{b0.data(), b0.size()}});
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(9, *actual);
+  EXPECT_EQ("bcdefghij", std::string(b0.begin(), b0.end()));
+}
+
+TEST(ObjectReadStreambufTest, ScatterGatherReadError) {
+  auto read_source = absl::make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*read_source, Read(_, _))
+      .WillOnce(
+          Return(Status(StatusCode::kUnavailable, "simulated failure")));
+  ObjectReadStreambuf buf(ReadObjectRangeRequest{}, std::move(read_source), 0);
+
+  std::vector<char> b0(8);
+  auto actual = buf.Read({MutableBuffer{b0.data(), b0.size()}});
+  EXPECT_EQ(StatusCode::kUnavailable, actual.status().code());
+  EXPECT_EQ(StatusCode::kUnavailable, buf.status().code());
+}
+
 TEST(ObjectReadStreambufTest, WrongSeek) {
   auto read_source = absl::make_unique<testing::MockObjectReadSource>();
   EXPECT_CALL(*read_source, IsOpen()).WillRepeatedly(Return(true));
@@ -15,9 +15,11 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RANGE_FROM_PAGINATION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RANGE_FROM_PAGINATION_H
 
+#include "google/cloud/storage/list_options.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
 #include <functional>
+#include <future>
 #include <iterator>
 #include <string>
 #include <utility>
@@ -111,7 +113,9 @@ class PaginationRange {
       : request_(std::move(request)),
         next_page_loader_(std::move(loader)),
         get_items_(std::move(get_items)),
-        on_last_page_(false) {
+        on_last_page_(false),
+        prefetch_(request_.template HasOption<EnablePagePrefetch>() &&
+                  request_.template GetOption<EnablePagePrefetch>().value()) {
     current_ = current_page_.begin();
   }
 
@@ -150,8 +154,13 @@ class PaginationRange {
       if (on_last_page_) {
         return iterator(nullptr, kPastTheEndError);
       }
-      request_.set_page_token(std::move(next_page_token_));
-      auto response = next_page_loader_(request_);
+      StatusOr<Response> response = [this] {
+        // With `EnablePagePrefetch` the request for this page started as soon
+        // as the previous page arrived, just collect its result.
+        if (prefetched_page_.valid()) return prefetched_page_.get();
+        request_.set_page_token(std::move(next_page_token_));
+        return next_page_loader_(request_);
+      }();
       if (!response.ok()) {
         next_page_token_.clear();
         current_page_.clear();
@@ -164,6 +173,15 @@ class PaginationRange {
       current_ = current_page_.begin();
       if (next_page_token_.empty()) {
         on_last_page_ = true;
+      } else if (prefetch_) {
+        // Start fetching the next page in the background. The loader and a
+        // copy of the request are captured by value because `request_` may be
+        // mutated before the background call completes.
+        request_.set_page_token(std::move(next_page_token_));
+        auto loader = next_page_loader_;
+        auto request = request_;
+        prefetched_page_ = std::async(
+            std::launch::async, [loader, request] { return loader(request); });
       }
       if (current_page_.end() == current_) {
         return iterator(nullptr, kPastTheEndError);
@@ -180,6 +198,8 @@ class PaginationRange {
   typename std::vector<T>::iterator current_;
   std::string next_page_token_;
   bool on_last_page_;
+  bool prefetch_;
+  std::future<StatusOr<Response>> prefetched_page_;
 };
 
 }  // namespace internal
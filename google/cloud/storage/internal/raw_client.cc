@@ -0,0 +1,44 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/raw_client.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+StatusOr<BatchGetObjectMetadataResponse> RawClient::BatchGetObjectMetadata(
+    BatchGetObjectMetadataRequest const& request) {
+  BatchGetObjectMetadataResponse response;
+  response.results.reserve(request.object_names().size());
+  for (auto const& name : request.object_names()) {
+    GetObjectMetadataRequest get(request.bucket_name(), name);
+    if (request.HasOption<Projection>()) {
+      get.set_option(request.GetOption<Projection>());
+    }
+    if (request.HasOption<UserProject>()) {
+      get.set_option(request.GetOption<UserProject>());
+    }
+    response.results.push_back(GetObjectMetadata(get));
+  }
+  return response;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -85,6 +85,16 @@ class RawClient {
   virtual StatusOr<ObjectMetadata> CopyObject(CopyObjectRequest const&) = 0;
   virtual StatusOr<ObjectMetadata> GetObjectMetadata(
       GetObjectMetadataRequest const& request) = 0;
+  /**
+   * Fetch the metadata for many objects in a single batch.
+   *
+   * The default implementation issues one `GetObjectMetadata()` call per
+   * object, so decorators and mocks keep working without changes.
+   * `CurlClient` overrides it to multiplex the calls over a single HTTP
+   * request using the JSON API `/batch` endpoint.
+   */
+  virtual StatusOr<BatchGetObjectMetadataResponse> BatchGetObjectMetadata(
+      BatchGetObjectMetadataRequest const& request);
   virtual StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) = 0;
   virtual StatusOr<ListObjectsResponse> ListObjects(
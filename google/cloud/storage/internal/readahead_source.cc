@@ -0,0 +1,135 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/readahead_source.h"
+#include "absl/memory/memory.h"
+#include <algorithm>
+#include <cstring>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+ReadaheadSource::ReadaheadSource(std::unique_ptr<ObjectReadSource> child,
+                                 std::size_t chunk_count,
+                                 std::size_t chunk_size)
+    : child_(std::move(child)),
+      chunk_count_(chunk_count),
+      chunk_size_(chunk_size),
+      reader_([this] { RunReader(); }) {}
+
+ReadaheadSource::~ReadaheadSource() { StopReader(); }
+
+bool ReadaheadSource::IsOpen() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return !delivered_final_chunk_;
+}
+
+StatusOr<HttpResponse> ReadaheadSource::Close() {
+  StopReader();
+  return child_->Close();
+}
+
+StatusOr<ReadSourceResult> ReadaheadSource::Read(char* buf, std::size_t n) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return !chunks_.empty() || producer_done_; });
+  if (chunks_.empty()) {
+    // Only reachable by reading past the end of the download.
+    return ReadSourceResult{0, HttpResponse{HttpStatusCode::kOk, {}, {}}};
+  }
+  auto& front = chunks_.front();
+  if (!front.result) {
+    // Do not pop the chunk, any further reads should see the same error.
+    return front.result;
+  }
+  auto const available = front.data.size() - front_offset_;
+  auto const copied = (std::min)(n, available);
+  std::memcpy(buf, front.data.data() + front_offset_, copied);
+  front_offset_ += copied;
+  if (front_offset_ < front.data.size()) {
+    // The chunk was only partially delivered, report an in-progress download
+    // and save the headers for the read that delivers the last bytes.
+    return ReadSourceResult{copied,
+                            HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+  }
+  auto result = *std::move(front.result);
+  result.bytes_received = copied;
+  if (result.response.status_code != HttpStatusCode::kContinue) {
+    delivered_final_chunk_ = true;
+  }
+  chunks_.pop_front();
+  front_offset_ = 0;
+  lk.unlock();
+  // There is room in the queue again, wake up the readahead thread.
+  cv_.notify_all();
+  return result;
+}
+
+void ReadaheadSource::RunReader() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk,
+               [this] { return shutdown_ || chunks_.size() < chunk_count_; });
+      if (shutdown_) return;
+    }
+    // Perform the read without holding the lock, this is the whole point of
+    // the class: the consumer drains previous chunks during this transfer.
+    Chunk chunk;
+    chunk.data.resize(chunk_size_);
+    auto result = child_->Read(&chunk.data[0], chunk_size_);
+    bool done = true;
+    if (result) {
+      chunk.data.resize(result->bytes_received);
+      done = result->response.status_code != HttpStatusCode::kContinue;
+    } else {
+      chunk.data.clear();
+    }
+    chunk.result = std::move(result);
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      chunks_.push_back(std::move(chunk));
+      if (done) producer_done_ = true;
+    }
+    cv_.notify_all();
+    if (done) return;
+  }
+}
+
+void ReadaheadSource::StopReader() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  if (reader_.joinable()) reader_.join();
+}
+
+std::unique_ptr<ObjectReadSource> CreateReadaheadSource(
+    ReadObjectRangeRequest const& request, std::size_t chunk_size,
+    std::unique_ptr<ObjectReadSource> source) {
+  if (!request.HasOption<ReadAhead>()) return source;
+  auto const chunk_count = request.GetOption<ReadAhead>().value();
+  if (chunk_count == 0) return source;
+  return absl::make_unique<ReadaheadSource>(std::move(source), chunk_count,
+                                            chunk_size);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,102 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READAHEAD_SOURCE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READAHEAD_SOURCE_H
+
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Keeps several download chunks in flight ahead of the reader.
+ *
+ * The wrapped source is drained by a dedicated thread into a bounded queue of
+ * chunks, so the network transfer for chunk N+1 overlaps with the
+ * application's processing of chunk N. `Read()` only copies data out of the
+ * queue, blocking when the download falls behind the reader, and the thread
+ * blocks when the queue is full, so the memory used is bounded by the number
+ * of chunks.
+ *
+ * Each chunk preserves the `ReadSourceResult` returned by the wrapped source,
+ * delivered with the last bytes of the chunk, so headers (and therefore hash
+ * validation) behave exactly as they do without readahead.
+ */
+class ReadaheadSource : public ObjectReadSource {
+ public:
+  ReadaheadSource(std::unique_ptr<ObjectReadSource> child,
+                  std::size_t chunk_count, std::size_t chunk_size);
+  ~ReadaheadSource() override;
+
+  bool IsOpen() const override;
+  StatusOr<HttpResponse> Close() override;
+  using ObjectReadSource::Read;
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+ private:
+  struct Chunk {
+    StatusOr<ReadSourceResult> result;
+    std::string data;
+  };
+
+  /// The body of the readahead thread.
+  void RunReader();
+
+  /// Stop the readahead thread and wait for it to exit.
+  void StopReader();
+
+  std::unique_ptr<ObjectReadSource> child_;
+  std::size_t const chunk_count_;
+  std::size_t const chunk_size_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Chunk> chunks_;
+  // How many bytes of `chunks_.front()` were already delivered.
+  std::size_t front_offset_ = 0;
+  bool shutdown_ = false;
+  bool producer_done_ = false;
+  bool delivered_final_chunk_ = false;
+  std::thread reader_;
+};
+
+/**
+ * Wrap @p source in a `ReadaheadSource` when requested.
+ *
+ * Returns @p source unchanged unless the request carries a `ReadAhead` option
+ * with a non-zero chunk count.
+ */
+std::unique_ptr<ObjectReadSource> CreateReadaheadSource(
+    ReadObjectRangeRequest const& request, std::size_t chunk_size,
+    std::unique_ptr<ObjectReadSource> source);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READAHEAD_SOURCE_H
@@ -0,0 +1,170 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/readahead_source.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+/// Create an action that fills the buffer with @p data and returns @p code.
+std::function<StatusOr<ReadSourceResult>(char*, std::size_t)> MakeChunk(
+    std::string data, long code) {  // NOLINT(google-runtime-int)
+  return [data, code](char* buf, std::size_t n) {
+    EXPECT_GE(n, data.size());
+    std::memcpy(buf, data.data(), data.size());
+    return StatusOr<ReadSourceResult>(
+        ReadSourceResult{data.size(), HttpResponse{code, {}, {}}});
+  };
+}
+
+TEST(ReadaheadSourceTest, DeliversDataInOrder) {
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk("abc", HttpStatusCode::kContinue)))
+      .WillOnce(Invoke(MakeChunk("def", HttpStatusCode::kContinue)))
+      .WillOnce(Invoke(MakeChunk("ghi", HttpStatusCode::kOk)));
+
+  ReadaheadSource source(std::move(mock), 2, 3);
+  std::string actual;
+  char buf[16];
+  while (source.IsOpen()) {
+    auto result = source.Read(buf, sizeof(buf));
+    ASSERT_STATUS_OK(result);
+    actual.append(buf, result->bytes_received);
+  }
+  EXPECT_EQ("abcdefghi", actual);
+}
+
+TEST(ReadaheadSourceTest, PartialReads) {
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk("abcd", HttpStatusCode::kContinue)))
+      .WillOnce(Invoke(MakeChunk("ef", HttpStatusCode::kOk)));
+
+  ReadaheadSource source(std::move(mock), 2, 4);
+  std::string actual;
+  char buf[3];
+  while (source.IsOpen()) {
+    auto result = source.Read(buf, sizeof(buf));
+    ASSERT_STATUS_OK(result);
+    actual.append(buf, result->bytes_received);
+    // Reads that drain only part of a chunk report an in-progress download.
+    if (source.IsOpen()) {
+      EXPECT_EQ(HttpStatusCode::kContinue, result->response.status_code);
+    }
+  }
+  EXPECT_EQ("abcdef", actual);
+}
+
+TEST(ReadaheadSourceTest, HeadersDeliveredWithChunk) {
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke([](char* buf, std::size_t) {
+        std::memcpy(buf, "abc", 3);
+        return StatusOr<ReadSourceResult>(ReadSourceResult{
+            3, HttpResponse{HttpStatusCode::kOk,
+                            {},
+                            {{"x-goog-hash", "crc32c=abcd"}}}});
+      }));
+
+  ReadaheadSource source(std::move(mock), 2, 3);
+  char buf[16];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(3, result->bytes_received);
+  EXPECT_EQ(1, result->response.headers.count("x-goog-hash"));
+  EXPECT_FALSE(source.IsOpen());
+}
+
+TEST(ReadaheadSourceTest, ErrorsPropagate) {
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillOnce(Invoke(MakeChunk("abc", HttpStatusCode::kContinue)))
+      .WillOnce(
+          Return(StatusOr<ReadSourceResult>(Status(StatusCode::kUnavailable,
+                                                   "broken connection"))));
+
+  ReadaheadSource source(std::move(mock), 2, 3);
+  char buf[3];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ("abc", std::string(buf, result->bytes_received));
+  auto error = source.Read(buf, sizeof(buf));
+  EXPECT_EQ(StatusCode::kUnavailable, error.status().code());
+  // The error is sticky, just like reading from the wrapped source.
+  error = source.Read(buf, sizeof(buf));
+  EXPECT_EQ(StatusCode::kUnavailable, error.status().code());
+}
+
+TEST(ReadaheadSourceTest, CloseStopsReader) {
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillRepeatedly(Invoke(MakeChunk("abc", HttpStatusCode::kContinue)));
+  EXPECT_CALL(*mock, Close())
+      .WillOnce(Return(StatusOr<HttpResponse>(
+          HttpResponse{HttpStatusCode::kOk, {}, {}})));
+
+  ReadaheadSource source(std::move(mock), 2, 3);
+  char buf[3];
+  auto result = source.Read(buf, sizeof(buf));
+  ASSERT_STATUS_OK(result);
+  auto response = source.Close();
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(HttpStatusCode::kOk, response->status_code);
+}
+
+TEST(ReadaheadSourceTest, FactoryHonorsOption) {
+  ReadObjectRangeRequest plain("test-bucket", "test-object");
+  auto source = CreateReadaheadSource(
+      plain, 1024, absl::make_unique<MockObjectReadSource>());
+  EXPECT_EQ(nullptr, dynamic_cast<ReadaheadSource*>(source.get()));
+
+  ReadObjectRangeRequest disabled("test-bucket", "test-object");
+  disabled.set_multiple_options(ReadAhead(0));
+  source = CreateReadaheadSource(disabled, 1024,
+                                 absl::make_unique<MockObjectReadSource>());
+  EXPECT_EQ(nullptr, dynamic_cast<ReadaheadSource*>(source.get()));
+
+  ReadObjectRangeRequest enabled("test-bucket", "test-object");
+  enabled.set_multiple_options(ReadAhead(4));
+  auto mock = absl::make_unique<MockObjectReadSource>();
+  // The readahead thread may or may not get to issue a read before the source
+  // is destroyed.
+  EXPECT_CALL(*mock, Read(_, _))
+      .WillRepeatedly(Invoke(MakeChunk("", HttpStatusCode::kOk)));
+  source = CreateReadaheadSource(enabled, 1024, std::move(mock));
+  EXPECT_NE(nullptr, dynamic_cast<ReadaheadSource*>(source.get()));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -261,6 +261,17 @@ StatusOr<ObjectMetadata> RetryClient::GetObjectMetadata(
                   &RawClient::GetObjectMetadata, request, __func__);
 }
 
+StatusOr<BatchGetObjectMetadataResponse> RetryClient::BatchGetObjectMetadata(
+    BatchGetObjectMetadataRequest const& request) {
+  auto retry_policy = retry_policy_prototype_->clone();
+  auto backoff_policy = backoff_policy_prototype_->clone();
+  // Metadata reads are always idempotent, there is no need to consult the
+  // idempotency policy. Note that only transport-level failures are retried;
+  // the batch as a whole succeeds even if some of its entries failed.
+  return MakeCall(*retry_policy, *backoff_policy, true, *client_,
+                  &RawClient::BatchGetObjectMetadata, request, __func__);
+}
+
 StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObjectNotWrapped(
     ReadObjectRangeRequest const& request, RetryPolicy& retry_policy,
     BackoffPolicy& backoff_policy) {
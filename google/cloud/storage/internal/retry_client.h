@@ -79,6 +79,8 @@ class RetryClient : public RawClient,
       CopyObjectRequest const& request) override;
   StatusOr<ObjectMetadata> GetObjectMetadata(
       GetObjectMetadataRequest const& request) override;
+  StatusOr<BatchGetObjectMetadataResponse> BatchGetObjectMetadata(
+      BatchGetObjectMetadataRequest const& request) override;
 
   /// Call ReadObject() but do not wrap the result in a RetryObjectReadSource.
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectNotWrapped(
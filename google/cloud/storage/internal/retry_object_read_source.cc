@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/retry_object_read_source.h"
 #include "google/cloud/log.h"
+#include <chrono>
 #include <thread>
 
 namespace google {
@@ -82,15 +83,23 @@ StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
   // Start a new retry loop to get the data.
   auto backoff_policy = backoff_policy_prototype_->clone();
   auto retry_policy = retry_policy_prototype_->clone();
+  auto const resume_start = std::chrono::steady_clock::now();
   int counter = 0;
-  for (; !result && retry_policy->OnFailure(result.status());
-       std::this_thread::sleep_for(backoff_policy->OnCompletion()),
-       result = child_->Read(buf, n)) {
+  bool first_resume_attempt = true;
+  while (!result && retry_policy->OnFailure(result.status())) {
     // A Read() request failed, most likely that means the connection failed or
     // stalled. The current child might no longer be usable, so we will try to
     // create a new one and replace it. Should that fail, the retry policy would
-    // already be exhausted, so we should fail this operation too.
+    // already be exhausted, so we should fail this operation too. Destroy the
+    // child *before* creating its replacement: that returns its easy handle
+    // (and any established connection) to the handle pool, so the replacement
+    // can reuse the connection and its TLS session instead of paying for a
+    // fresh handshake.
     child_.reset();
+    if (!first_resume_attempt) {
+      std::this_thread::sleep_for(backoff_policy->OnCompletion());
+    }
+    first_resume_attempt = false;
 
     if (has_testbench_instructions) {
       request_.set_multiple_options(
@@ -111,11 +120,23 @@ StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
     if (!new_child) {
       // We've exhausted the retry policy while trying to create the child, so
       // return right away.
-      return new_child.status();
+      return std::move(new_child).status();
     }
     child_ = std::move(*new_child);
+    // Issue the ranged re-read immediately. In the common case (one dropped
+    // connection) the replacement stream reuses a warm connection, delaying
+    // the read would only add latency. The backoff still applies before any
+    // further attempts.
+    result = child_->Read(buf, n);
   }
   if (handle_result(result)) {
+    auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - resume_start);
+    ++resume_count_;
+    resume_time_ += elapsed;
+    GCP_LOG(INFO) << __func__ << "() resumed download at offset="
+                  << current_offset_ << " in " << elapsed.count()
+                  << "us, resume_count=" << resume_count_;
     return result;
   }
   // We have exhausted the retry policy, return an error.
@@ -19,6 +19,8 @@
 #include "google/cloud/storage/internal/retry_client.h"
 #include "google/cloud/storage/version.h"
 #include "absl/types/optional.h"
+#include <chrono>
+#include <cstdint>
 
 namespace google {
 namespace cloud {
@@ -48,6 +50,13 @@ class RetryObjectReadSource : public ObjectReadSource {
   StatusOr<HttpResponse> Close() override { return child_->Close(); }
   StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
 
+  /// The number of times this download was resumed after a transient failure.
+  std::int64_t resume_count() const { return resume_count_; }
+
+  /// The total time spent resuming the download, measured from the failed
+  /// `Read()` to the first successful read on the replacement stream.
+  std::chrono::microseconds resume_time() const { return resume_time_; }
+
  private:
   std::shared_ptr<RetryClient> client_;
   ReadObjectRangeRequest request_;
@@ -57,6 +66,8 @@ class RetryObjectReadSource : public ObjectReadSource {
   std::unique_ptr<BackoffPolicy const> backoff_policy_prototype_;
   OffsetDirection offset_direction_;
   std::int64_t current_offset_;
+  std::int64_t resume_count_ = 0;
+  std::chrono::microseconds resume_time_{0};
 };
 
 }  // namespace internal
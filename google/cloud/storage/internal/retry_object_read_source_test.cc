@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/retry_object_read_source.h"
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
@@ -219,21 +220,23 @@ TEST(RetryObjectReadSourceTest, BackoffPolicyResetOnSuccess) {
 
   // raw_source1 and raw_source2 fail, then a success
   ASSERT_STATUS_OK((*source)->Read(nullptr, 1024));
-  // Two retries, so the backoff policy was called twice.
-  EXPECT_EQ(2, num_backoff_policy_called);
+  // Two retries, the first resume attempt is immediate, so the backoff policy
+  // was called only before the second attempt.
+  EXPECT_EQ(1, num_backoff_policy_called);
   // The backoff should have been cloned during the read.
   EXPECT_EQ(3, backoff_policy_mock.NumClones());
-  // The backoff policy was used twice in the first retry.
-  EXPECT_EQ(2, backoff_policy_mock.NumCallsFromLastClone());
+  // The backoff policy was used once in the first retry.
+  EXPECT_EQ(1, backoff_policy_mock.NumCallsFromLastClone());
 
   // raw_source3 fails, then a success
   ASSERT_STATUS_OK((*source)->Read(nullptr, 1024));
-  // This read caused a third retry.
-  EXPECT_EQ(3, num_backoff_policy_called);
+  // The resume succeeded on the immediate attempt, so the backoff policy was
+  // not called again.
+  EXPECT_EQ(1, num_backoff_policy_called);
   // The backoff should have been cloned during the read.
   EXPECT_EQ(4, backoff_policy_mock.NumClones());
-  // The backoff policy was only once in the second retry.
-  EXPECT_EQ(1, backoff_policy_mock.NumCallsFromLastClone());
+  // The backoff policy was not used in the second retry.
+  EXPECT_EQ(0, backoff_policy_mock.NumCallsFromLastClone());
 }
 
 /// @test Check that retry policy is shared between reads and resetting session
@@ -268,6 +271,35 @@ TEST(RetryObjectReadSourceTest, RetryPolicyExhaustedOnResetSession) {
   EXPECT_THAT(res.status().message(), HasSubstr("Retry policy exhausted"));
 }
 
+/// @test The resume counters are updated when a download is resumed
+TEST(RetryObjectReadSourceTest, ResumeCounters) {
+  auto raw_client = std::make_shared<testing::MockClient>();
+  auto raw_source1 = new MockObjectReadSource;
+  auto raw_source2 = new MockObjectReadSource;
+  auto client = std::make_shared<RetryClient>(
+      std::shared_ptr<internal::RawClient>(raw_client),
+      LimitedErrorCountRetryPolicy(3), StrictIdempotencyPolicy(),
+      ExponentialBackoffPolicy(1_us, 2_us, 2));
+
+  EXPECT_CALL(*raw_source1, Read(_, _)).WillOnce(Return(TransientError()));
+  EXPECT_CALL(*raw_client, ReadObject(_))
+      .WillOnce([raw_source2](ReadObjectRangeRequest const&) {
+        return std::unique_ptr<ObjectReadSource>(raw_source2);
+      });
+  EXPECT_CALL(*raw_source2, Read(_, _)).WillOnce(Return(ReadSourceResult{}));
+
+  RetryObjectReadSource source(
+      client, ReadObjectRangeRequest{},
+      std::unique_ptr<ObjectReadSource>(raw_source1),
+      LimitedErrorCountRetryPolicy(3).clone(),
+      ExponentialBackoffPolicy(1_us, 2_us, 2).clone());
+  EXPECT_EQ(0, source.resume_count());
+  EXPECT_EQ(std::chrono::microseconds(0), source.resume_time());
+  ASSERT_STATUS_OK(source.Read(nullptr, 1024));
+  EXPECT_EQ(1, source.resume_count());
+  EXPECT_LE(std::chrono::microseconds(0), source.resume_time());
+}
+
 /// @test `ReadLast` behaviour after a transient failure
 TEST(RetryObjectReadSourceTest, TransientFailureWithReadLastOption) {
   auto raw_client = std::make_shared<testing::MockClient>();
@@ -16,6 +16,7 @@
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 #include <array>
+#include <memory>
 
 namespace google {
 namespace cloud {
@@ -24,20 +25,44 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
 namespace {
+struct DigestCtxDeleter {
+  void operator()(EVP_MD_CTX* ctx) {
+#if OPENSSL_VERSION_NUMBER < 0x10100000L  // Older than version 1.1.0
+    EVP_MD_CTX_destroy(ctx);
+#else
+    EVP_MD_CTX_free(ctx);
+#endif
+  }
+};
+
+std::unique_ptr<EVP_MD_CTX, DigestCtxDeleter> CreateDigestCtx() {
+#if OPENSSL_VERSION_NUMBER < 0x10100000L  // Older than version 1.1.0
+  return std::unique_ptr<EVP_MD_CTX, DigestCtxDeleter>(EVP_MD_CTX_create());
+#else
+  return std::unique_ptr<EVP_MD_CTX, DigestCtxDeleter>(EVP_MD_CTX_new());
+#endif
+}
+
 template <typename Byte,
           typename std::enable_if<sizeof(Byte) == 1, int>::type = 0>
 std::vector<std::uint8_t> Sha256Hash(Byte const* data, std::size_t count) {
-  SHA256_CTX sha256;
-  SHA256_Init(&sha256);
-  SHA256_Update(&sha256, data, count);
+  // Use the EVP interface rather than the deprecated `SHA256_*` entry points:
+  // OpenSSL dispatches EVP digests to the fastest implementation for the
+  // running CPU (the x86 SHA extensions, the ARMv8 cryptography extensions,
+  // or vectorized generic code). Cache the context per thread, creating one
+  // dominates the cost of hashing the small payloads used in V4 signing.
+  static thread_local auto const ctx = CreateDigestCtx();
+  EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr);
+  EVP_DigestUpdate(ctx.get(), data, count);
 
-  std::array<unsigned char, SHA256_DIGEST_LENGTH> hash{};
-  SHA256_Final(hash.data(), &sha256);
+  std::array<unsigned char, EVP_MAX_MD_SIZE> hash{};
+  unsigned int size = 0;
+  EVP_DigestFinal_ex(ctx.get(), hash.data(), &size);
   // Note that this constructor (from a range) converts the `unsigned char` to
   // `std::uint8_t` if needed, this should work because (a) the values returned
-  // by `SHA256_Final()` are 8-bit values, and (b) because if `std::uint8_t`
-  // exists it must be large enough to fit an `unsigned char`.
-  return {hash.begin(), hash.end()};
+  // by `EVP_DigestFinal_ex()` are 8-bit values, and (b) because if
+  // `std::uint8_t` exists it must be large enough to fit an `unsigned char`.
+  return {hash.begin(), hash.begin() + size};
 }
 }  // namespace
 
@@ -49,6 +74,16 @@ std::vector<std::uint8_t> Sha256Hash(std::vector<std::uint8_t> const& bytes) {
   return Sha256Hash(bytes.data(), bytes.size());
 }
 
+std::vector<std::vector<std::uint8_t>> Sha256HashBatch(
+    std::vector<std::string> const& payloads) {
+  std::vector<std::vector<std::uint8_t>> result;
+  result.reserve(payloads.size());
+  for (auto const& payload : payloads) {
+    result.push_back(Sha256Hash(payload.data(), payload.size()));
+  }
+  return result;
+}
+
 std::string HexEncode(std::vector<std::uint8_t> const& bytes) {
   std::string result;
   std::array<char, sizeof("ff")> buf{};
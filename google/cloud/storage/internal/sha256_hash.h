@@ -32,6 +32,16 @@ std::vector<std::uint8_t> Sha256Hash(std::string const& str);
 /// Return the SHA256 hash (as raw bytes) of @p bytes.
 std::vector<std::uint8_t> Sha256Hash(std::vector<std::uint8_t> const& bytes);
 
+/**
+ * Return the SHA256 hashes (as raw bytes) of each element of @p payloads.
+ *
+ * Prefer this function when hashing many small payloads, e.g. the canonical
+ * requests of a batch of V4 signed URLs, it amortizes the per-call setup over
+ * the whole batch.
+ */
+std::vector<std::vector<std::uint8_t>> Sha256HashBatch(
+    std::vector<std::string> const& payloads);
+
 /// Return @p bytes encoded as a lowercase hexadecimal string.
 std::string HexEncode(std::vector<std::uint8_t> const& bytes);
 
@@ -56,6 +56,18 @@ TEST(Sha256Hash, Simple) {
       HexEncode(Sha256Hash("The quick brown fox jumps over the lazy dog"));
 }
 
+TEST(Sha256Hash, BatchEmpty) { EXPECT_TRUE(Sha256HashBatch({}).empty()); }
+
+TEST(Sha256Hash, BatchMatchesSingle) {
+  std::vector<std::string> payloads{
+      "", "The quick brown fox jumps over the lazy dog", "GET\n/test-object\n"};
+  auto const actual = Sha256HashBatch(payloads);
+  ASSERT_EQ(payloads.size(), actual.size());
+  for (std::size_t i = 0; i != payloads.size(); ++i) {
+    EXPECT_EQ(Sha256Hash(payloads[i]), actual[i]) << "payload=" << payloads[i];
+  }
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -321,6 +321,76 @@ std::ostream& operator<<(std::ostream& os, V4SignUrlRequest const& r) {
             << r.StringToSign("placeholder-client-id") << "}";
 }
 
+V4SignUrlPreparedSigner::V4SignUrlPreparedSigner(
+    std::string const& client_id, std::string verb, std::string bucket_name,
+    std::chrono::system_clock::time_point timestamp,
+    std::chrono::seconds expires)
+    : verb_(std::move(verb)), bucket_name_(std::move(bucket_name)) {
+  x_goog_date_ = google::cloud::internal::FormatV4SignedUrlTimestamp(timestamp);
+  scope_ = google::cloud::internal::FormatV4SignedUrlScope(timestamp) +
+           "/auto/storage/goog4_request";
+  signed_headers_ = "host";
+  canonical_headers_ = "host:storage.googleapis.com\n";
+  CurlHandle curl;
+  std::multimap<std::string, std::string> const parameters{
+      {"X-Goog-Algorithm", "GOOG4-RSA-SHA256"},
+      {"X-Goog-Credential", client_id + "/" + scope_},
+      {"X-Goog-Date", x_goog_date_},
+      {"X-Goog-Expires", std::to_string(expires.count())},
+      {"X-Goog-SignedHeaders", signed_headers_},
+  };
+  canonical_query_string_ = QueryStringFromParameters(curl, parameters);
+}
+
+std::string V4SignUrlPreparedSigner::EscapedObjectPath(
+    std::string const& object_name) const {
+  CurlHandle curl;
+  std::string path;
+  std::istringstream is(object_name);
+  std::string part;
+  do {
+    std::getline(is, part, '/');
+    path += '/';
+    path += curl.MakeEscapedString(part).get();
+    is.tellg();
+  } while (is);
+  return path;
+}
+
+std::string V4SignUrlPreparedSigner::CanonicalRequest(
+    std::string const& object_name) const {
+  std::string result = verb_;
+  result += "\n/";
+  result += bucket_name_;
+  result += EscapedObjectPath(object_name);
+  result += '\n';
+  result += canonical_query_string_;
+  result += '\n';
+  result += canonical_headers_;
+  result += '\n';
+  result += signed_headers_;
+  result += "\nUNSIGNED-PAYLOAD";
+  return result;
+}
+
+std::string V4SignUrlPreparedSigner::StringToSign(
+    std::string const& object_name) const {
+  return "GOOG4-RSA-SHA256\n" + x_goog_date_ + "\n" + scope_ + "\n" +
+         HexEncode(Sha256Hash(CanonicalRequest(object_name)));
+}
+
+std::string V4SignUrlPreparedSigner::SignedUrl(
+    std::string const& object_name, std::string const& signature) const {
+  std::string url = "https://storage.googleapis.com/";
+  url += bucket_name_;
+  url += EscapedObjectPath(object_name);
+  url += '?';
+  url += canonical_query_string_;
+  url += "&X-Goog-Signature=";
+  url += signature;
+  return url;
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -330,6 +330,59 @@ class V4SignUrlRequest {
 
 std::ostream& operator<<(std::ostream& os, V4SignUrlRequest const& r);
 
+/**
+ * Precomputes the invariant parts of V4 signed URL creation.
+ *
+ * `V4SignUrlRequest` rebuilds the canonical request from scratch for each
+ * URL: the credential scope, the `X-Goog-*` canonical query parameters, and
+ * the canonical host header are formatted (and URL-escaped) again even though
+ * they only depend on the client id, the signing timestamp, and the
+ * expiration. Applications that mint URLs in bulk — one per object for the
+ * same bucket, verb, and timestamp — pay that cost once per URL.
+ *
+ * This class computes the invariant strings once and only splices the
+ * per-object fields. Use `StringToSign()` to obtain the document to sign for
+ * each object, and `SignedUrl()` to assemble the final URL from the
+ * hex-encoded signature.
+ *
+ * The signer covers the common bulk-minting case: no sub-resource, no
+ * extension headers beyond `host`, unsigned payload, and path-style
+ * addressing. Requests outside that shape should continue to use
+ * `V4SignUrlRequest`.
+ */
+class V4SignUrlPreparedSigner {
+ public:
+  V4SignUrlPreparedSigner(std::string const& client_id, std::string verb,
+                          std::string bucket_name,
+                          std::chrono::system_clock::time_point timestamp,
+                          std::chrono::seconds expires);
+
+  /// Creates the V4 string to sign for @p object_name.
+  std::string StringToSign(std::string const& object_name) const;
+
+  /// Assembles the signed URL from the hex-encoded @p signature.
+  std::string SignedUrl(std::string const& object_name,
+                        std::string const& signature) const;
+
+  /**
+   * Creates the "canonical request" document for @p object_name.
+   *
+   * This member function is mostly used for testing.
+   */
+  std::string CanonicalRequest(std::string const& object_name) const;
+
+ private:
+  std::string EscapedObjectPath(std::string const& object_name) const;
+
+  std::string verb_;
+  std::string bucket_name_;
+  std::string x_goog_date_;
+  std::string scope_;
+  std::string canonical_query_string_;
+  std::string canonical_headers_;
+  std::string signed_headers_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
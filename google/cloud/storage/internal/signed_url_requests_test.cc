@@ -635,6 +635,57 @@ TEST(V4SignedUrlRequests, BucketBoundHostnameReset) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST(V4SignedUrlRequests, PreparedSignerMatchesCanonicalRequest) {
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const timestamp = google::cloud::internal::ParseRfc3339(date);
+  auto const valid_for = std::chrono::seconds(10);
+
+  V4SignUrlRequest request("GET", "test-bucket", "test-object");
+  request.set_multiple_options(SignedUrlTimestamp(timestamp),
+                               SignedUrlDuration(valid_for));
+  request.AddMissingRequiredHeaders();
+
+  V4SignUrlPreparedSigner signer("fake-client-id", "GET", "test-bucket",
+                                 timestamp, valid_for);
+  EXPECT_EQ(request.CanonicalRequest("fake-client-id"),
+            signer.CanonicalRequest("test-object"));
+  EXPECT_EQ(request.StringToSign("fake-client-id"),
+            signer.StringToSign("test-object"));
+}
+
+TEST(V4SignedUrlRequests, PreparedSignerMatchesWithSlashesAndEscapes) {
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const timestamp = google::cloud::internal::ParseRfc3339(date);
+  auto const valid_for = std::chrono::seconds(10);
+  std::string const object_name = "path/to/object name/with spaces";
+
+  V4SignUrlRequest request("GET", "test-bucket", object_name);
+  request.set_multiple_options(SignedUrlTimestamp(timestamp),
+                               SignedUrlDuration(valid_for));
+  request.AddMissingRequiredHeaders();
+
+  V4SignUrlPreparedSigner signer("fake-client-id", "GET", "test-bucket",
+                                 timestamp, valid_for);
+  EXPECT_EQ(request.CanonicalRequest("fake-client-id"),
+            signer.CanonicalRequest(object_name));
+  EXPECT_EQ(request.StringToSign("fake-client-id"),
+            signer.StringToSign(object_name));
+}
+
+TEST(V4SignedUrlRequests, PreparedSignerSignedUrl) {
+  std::string const date = "2019-02-01T09:00:00Z";
+  auto const timestamp = google::cloud::internal::ParseRfc3339(date);
+  auto const valid_for = std::chrono::seconds(10);
+
+  V4SignUrlPreparedSigner signer("fake-client-id", "GET", "test-bucket",
+                                 timestamp, valid_for);
+  auto const url = signer.SignedUrl("test object", "deadbeef");
+  EXPECT_THAT(
+      url, HasSubstr("https://storage.googleapis.com/test-bucket/test%20object?"
+                     "X-Goog-Algorithm=GOOG4-RSA-SHA256"));
+  EXPECT_THAT(url, HasSubstr("&X-Goog-Signature=deadbeef"));
+}
+
 TEST(DefaultCtorsWork, Trivial) {
   EXPECT_FALSE(ExpirationTime().has_value());
   EXPECT_FALSE(AddExtensionHeaderOption().has_value());
@@ -0,0 +1,87 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/transport_selector.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+double constexpr TransportSelector::kDecay;
+double constexpr TransportSelector::kHysteresis;
+std::int64_t constexpr TransportSelector::kProbePeriod;
+
+namespace {
+TransportSelector::Transport Other(TransportSelector::Transport transport) {
+  return transport == TransportSelector::Transport::kGrpc
+             ? TransportSelector::Transport::kCurl
+             : TransportSelector::Transport::kGrpc;
+}
+}  // namespace
+
+TransportSelector::Transport TransportSelector::Pick() {
+  std::lock_guard<std::mutex> lk(mu_);
+  ++picks_;
+  auto const challenger = Other(preferred_);
+  // Route a probe to the challenger, either to build its initial estimate or
+  // to keep an existing estimate from going stale.
+  if (!EstimateFor(challenger).valid || picks_ % kProbePeriod == 0) {
+    return challenger;
+  }
+  return preferred_;
+}
+
+void TransportSelector::Record(Transport transport,
+                               std::chrono::microseconds elapsed,
+                               std::int64_t bytes, bool ok) {
+  // Use bytes per second as the score, for operations without a payload this
+  // degenerates to the operation rate, which is also a sensible metric.
+  double score = 0;
+  if (ok) {
+    auto const seconds =
+        std::chrono::duration_cast<std::chrono::duration<double>>(elapsed)
+            .count();
+    score = seconds <= 0 ? 0 : static_cast<double>(bytes + 1) / seconds;
+  }
+
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& estimate = EstimateFor(transport);
+  if (!estimate.valid) {
+    estimate.score = score;
+    estimate.valid = true;
+  } else {
+    estimate.score = kDecay * score + (1.0 - kDecay) * estimate.score;
+  }
+
+  auto const challenger = Other(preferred_);
+  auto const& current = EstimateFor(preferred_);
+  auto const& candidate = EstimateFor(challenger);
+  if (current.valid && candidate.valid &&
+      candidate.score > kHysteresis * current.score) {
+    preferred_ = challenger;
+  }
+}
+
+TransportSelector::Transport TransportSelector::preferred() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return preferred_;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
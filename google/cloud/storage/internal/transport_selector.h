@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRANSPORT_SELECTOR_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRANSPORT_SELECTOR_H
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Picks the faster of two transports based on recent measurements.
+ *
+ * `HybridClient` routes media operations to gRPC and everything else to
+ * libcurl, but which transport is faster depends on the deployment (region,
+ * object sizes, proxies). This class tracks an exponentially-weighted moving
+ * average of the observed throughput for each transport and routes traffic to
+ * whichever is currently faster.
+ *
+ * Two mechanisms keep the selection stable and fresh:
+ * - Hysteresis: the challenger must beat the preferred transport by a margin
+ *   (`kHysteresis`) before traffic shifts, so close races do not flap.
+ * - Probing: a small fraction of operations (one in `kProbePeriod`) is routed
+ *   to the non-preferred transport, so its estimate does not go stale.
+ *
+ * All member functions are thread-safe.
+ */
+class TransportSelector {
+ public:
+  enum class Transport { kGrpc, kCurl };
+
+  /// The weight of the newest sample in the moving average.
+  static double constexpr kDecay = 0.25;
+  /// The challenger must be this much faster before traffic shifts.
+  static double constexpr kHysteresis = 1.25;
+  /// One in this many operations probes the non-preferred transport.
+  static std::int64_t constexpr kProbePeriod = 16;
+
+  explicit TransportSelector(Transport initial) : preferred_(initial) {}
+
+  /// Returns the transport the next operation should use.
+  Transport Pick();
+
+  /**
+   * Record the observed performance of one operation.
+   *
+   * @param transport the transport that served the operation.
+   * @param elapsed the elapsed time for the operation.
+   * @param bytes the payload size, zero for operations without a payload, in
+   *     which case the operation rate serves as the score.
+   * @param ok false if the operation failed, failures drive the estimate
+   *     towards zero so an unhealthy transport sheds its traffic.
+   */
+  void Record(Transport transport, std::chrono::microseconds elapsed,
+              std::int64_t bytes, bool ok);
+
+  /// The transport currently preferred, mostly useful in tests.
+  Transport preferred() const;
+
+ private:
+  struct Estimate {
+    double score = 0;
+    bool valid = false;
+  };
+
+  Estimate& EstimateFor(Transport transport) {
+    return transport == Transport::kGrpc ? grpc_ : curl_;
+  }
+
+  mutable std::mutex mu_;
+  Transport preferred_;
+  Estimate grpc_;
+  Estimate curl_;
+  std::int64_t picks_ = 0;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_TRANSPORT_SELECTOR_H
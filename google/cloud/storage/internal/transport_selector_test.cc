@@ -0,0 +1,85 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/transport_selector.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using Transport = TransportSelector::Transport;
+
+auto constexpr kMiB = 1024 * 1024L;
+std::chrono::microseconds const kOneSecond(1000 * 1000);
+
+TEST(TransportSelectorTest, ProbesUnknownChallenger) {
+  TransportSelector selector(Transport::kGrpc);
+  EXPECT_EQ(Transport::kGrpc, selector.preferred());
+  // Without an estimate for the challenger every pick is a probe.
+  EXPECT_EQ(Transport::kCurl, selector.Pick());
+  selector.Record(Transport::kCurl, kOneSecond, 8 * kMiB, true);
+  // Once the challenger has an estimate the preferred transport is used, even
+  // before it has an estimate of its own.
+  EXPECT_EQ(Transport::kGrpc, selector.Pick());
+}
+
+TEST(TransportSelectorTest, SwitchesToFasterChallenger) {
+  TransportSelector selector(Transport::kGrpc);
+  selector.Record(Transport::kGrpc, kOneSecond, 8 * kMiB, true);
+  selector.Record(Transport::kCurl, kOneSecond, 64 * kMiB, true);
+  EXPECT_EQ(Transport::kCurl, selector.preferred());
+}
+
+TEST(TransportSelectorTest, HysteresisPreventsFlapping) {
+  TransportSelector selector(Transport::kGrpc);
+  selector.Record(Transport::kGrpc, kOneSecond, 80 * kMiB, true);
+  // 10% faster is within the hysteresis margin, the preference is unchanged.
+  selector.Record(Transport::kCurl, kOneSecond, 88 * kMiB, true);
+  EXPECT_EQ(Transport::kGrpc, selector.preferred());
+}
+
+TEST(TransportSelectorTest, PeriodicProbes) {
+  TransportSelector selector(Transport::kGrpc);
+  selector.Record(Transport::kGrpc, kOneSecond, 64 * kMiB, true);
+  selector.Record(Transport::kCurl, kOneSecond, 8 * kMiB, true);
+
+  int probes = 0;
+  for (std::int64_t i = 0; i != 2 * TransportSelector::kProbePeriod; ++i) {
+    if (selector.Pick() == Transport::kCurl) ++probes;
+  }
+  EXPECT_EQ(2, probes);
+}
+
+TEST(TransportSelectorTest, FailuresShedTraffic) {
+  TransportSelector selector(Transport::kGrpc);
+  selector.Record(Transport::kGrpc, kOneSecond, 64 * kMiB, true);
+  selector.Record(Transport::kCurl, kOneSecond, 8 * kMiB, true);
+  EXPECT_EQ(Transport::kGrpc, selector.preferred());
+
+  for (int i = 0; i != 10 && selector.preferred() == Transport::kGrpc; ++i) {
+    selector.Record(Transport::kGrpc, kOneSecond, 0, false);
+  }
+  EXPECT_EQ(Transport::kCurl, selector.preferred());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
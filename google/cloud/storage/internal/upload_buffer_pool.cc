@@ -0,0 +1,70 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/upload_buffer_pool.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+UploadBufferPool& UploadBufferPool::Instance() {
+  // Enough to recycle buffers for dozens of concurrent default-sized streams
+  // without retaining an unreasonable amount of memory.
+  static auto* const kInstance =
+      new UploadBufferPool(/*max_pooled_bytes=*/256 * 1024 * 1024L);
+  return *kInstance;
+}
+
+std::vector<char> UploadBufferPool::Acquire(std::size_t size) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    // Prefer the smallest pooled buffer that is large enough; with the
+    // expected mix of (mostly identical) buffer sizes this scan is short.
+    auto best = buffers_.end();
+    for (auto i = buffers_.begin(); i != buffers_.end(); ++i) {
+      if (i->capacity() < size) continue;
+      if (best == buffers_.end() || i->capacity() < best->capacity()) best = i;
+    }
+    if (best != buffers_.end()) {
+      auto buffer = std::move(*best);
+      buffers_.erase(best);
+      pooled_bytes_ -= buffer.capacity();
+      buffer.resize(size);
+      return buffer;
+    }
+  }
+  return std::vector<char>(size);
+}
+
+void UploadBufferPool::Release(std::vector<char> buffer) {
+  if (buffer.capacity() == 0) return;
+  std::lock_guard<std::mutex> lk(mu_);
+  if (pooled_bytes_ + buffer.capacity() > max_pooled_bytes_) return;
+  pooled_bytes_ += buffer.capacity();
+  buffers_.push_back(std::move(buffer));
+}
+
+std::size_t UploadBufferPool::CurrentPooledBytes() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return pooled_bytes_;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
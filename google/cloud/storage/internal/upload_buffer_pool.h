@@ -0,0 +1,66 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_BUFFER_POOL_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_BUFFER_POOL_H
+
+#include "google/cloud/storage/version.h"
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * A process-wide pool of upload buffers.
+ *
+ * Applications that open many short-lived write streams pay for a multi-MiB
+ * buffer allocation (and the associated page faults) on each stream. This
+ * pool recycles those buffers. The total number of bytes retained by the pool
+ * is bounded; buffers returned when the pool is full are simply freed.
+ */
+class UploadBufferPool {
+ public:
+  explicit UploadBufferPool(std::size_t max_pooled_bytes)
+      : max_pooled_bytes_(max_pooled_bytes) {}
+
+  /// The process-wide pool used by the write streams.
+  static UploadBufferPool& Instance();
+
+  /// Get a buffer with at least @p size bytes, recycling one if possible.
+  std::vector<char> Acquire(std::size_t size);
+
+  /// Return @p buffer to the pool, possibly freeing it if the pool is full.
+  void Release(std::vector<char> buffer);
+
+  /// The number of bytes currently retained, mostly useful in tests.
+  std::size_t CurrentPooledBytes() const;
+
+ private:
+  std::size_t max_pooled_bytes_;
+  mutable std::mutex mu_;
+  std::vector<std::vector<char>> buffers_;
+  std::size_t pooled_bytes_ = 0;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_UPLOAD_BUFFER_POOL_H
@@ -0,0 +1,75 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/upload_buffer_pool.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(UploadBufferPoolTest, ReleaseThenAcquireReuses) {
+  UploadBufferPool pool(1024 * 1024);
+  auto buffer = pool.Acquire(1024);
+  EXPECT_EQ(1024, buffer.size());
+  auto const* data = buffer.data();
+  pool.Release(std::move(buffer));
+  EXPECT_LE(1024, pool.CurrentPooledBytes());
+
+  auto reused = pool.Acquire(512);
+  EXPECT_EQ(512, reused.size());
+  EXPECT_EQ(data, reused.data());
+  EXPECT_EQ(0, pool.CurrentPooledBytes());
+}
+
+TEST(UploadBufferPoolTest, PrefersSmallestSufficientBuffer) {
+  UploadBufferPool pool(1024 * 1024);
+  auto small = pool.Acquire(256);
+  auto large = pool.Acquire(4096);
+  auto const* small_data = small.data();
+  auto const* large_data = large.data();
+  pool.Release(std::move(large));
+  pool.Release(std::move(small));
+
+  auto reused = pool.Acquire(128);
+  EXPECT_EQ(small_data, reused.data());
+  reused = pool.Acquire(1024);
+  EXPECT_EQ(large_data, reused.data());
+}
+
+TEST(UploadBufferPoolTest, RespectsByteBound) {
+  UploadBufferPool pool(1024);
+  pool.Release(std::vector<char>(1000));
+  auto const pooled = pool.CurrentPooledBytes();
+  EXPECT_LE(1000, pooled);
+  // The pool is (almost) full, this buffer is simply freed.
+  pool.Release(std::vector<char>(512));
+  EXPECT_EQ(pooled, pool.CurrentPooledBytes());
+}
+
+TEST(UploadBufferPoolTest, AcquireWithEmptyPool) {
+  UploadBufferPool pool(1024);
+  auto buffer = pool.Acquire(2048);
+  EXPECT_EQ(2048, buffer.size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
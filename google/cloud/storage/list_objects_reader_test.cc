@@ -18,6 +18,8 @@
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
 #include <nlohmann/json.hpp>
+#include <chrono>
+#include <future>
 
 namespace google {
 namespace cloud {
@@ -203,6 +205,101 @@ TEST(ListObjectsReaderTest, IteratorCompare) {
   EXPECT_NE(a1, a2);
 }
 
+TEST(ListObjectsReaderTest, Prefetch) {
+  // Create a synthetic list of ObjectMetadata elements, each request will
+  // return 2 of them.
+  std::vector<ObjectMetadata> expected;
+
+  int const page_count = 3;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  std::promise<void> second_page_requested;
+  auto create_mock = [page_count](int i) {
+    ListObjectsResponse response;
+    if (i < page_count) {
+      if (i != page_count - 1) {
+        response.next_page_token = "page-" + std::to_string(i);
+      }
+      response.items.emplace_back(CreateElement(2 * i));
+      response.items.emplace_back(CreateElement(2 * i + 1));
+    }
+    return [response](ListObjectsRequest const&) {
+      return StatusOr<ListObjectsResponse>(response);
+    };
+  };
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(create_mock(0))
+      .WillOnce([&second_page_requested,
+                 create_mock](ListObjectsRequest const& r) {
+        EXPECT_EQ("page-0", r.page_token());
+        second_page_requested.set_value();
+        return create_mock(1)(r);
+      })
+      .WillOnce(create_mock(2));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("foo-bar-baz")
+          .set_multiple_options(EnablePagePrefetch(true)),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); });
+
+  // The request for the second page is issued as soon as the first page
+  // arrives, before the application iterates past the first element.
+  auto it = reader.begin();
+  auto second_page = second_page_requested.get_future();
+  EXPECT_EQ(std::future_status::ready,
+            second_page.wait_for(std::chrono::seconds(30)));
+
+  std::vector<ObjectMetadata> actual;
+  for (; it != reader.end(); ++it) {
+    ASSERT_STATUS_OK(*it);
+    actual.emplace_back(*std::move(*it));
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
+TEST(ListObjectsReaderTest, PrefetchPermanentFailure) {
+  std::vector<ObjectMetadata> expected;
+  expected.emplace_back(CreateElement(0));
+  expected.emplace_back(CreateElement(1));
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce([](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.next_page_token = "page-0";
+        response.items.emplace_back(CreateElement(0));
+        response.items.emplace_back(CreateElement(1));
+        return StatusOr<ListObjectsResponse>(response);
+      })
+      .WillOnce([](ListObjectsRequest const&) {
+        return StatusOr<ListObjectsResponse>(PermanentError());
+      });
+
+  ListObjectsReader reader(
+      ListObjectsRequest("test-bucket")
+          .set_multiple_options(EnablePagePrefetch(true)),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); });
+  std::vector<ObjectMetadata> actual;
+  bool has_status_or_error = false;
+  for (auto&& object : reader) {
+    if (object.ok()) {
+      actual.emplace_back(*std::move(object));
+      continue;
+    }
+    EXPECT_FALSE(has_status_or_error);
+    has_status_or_error = true;
+    Status status = std::move(object).status();
+    EXPECT_EQ(PermanentError().code(), status.code());
+  }
+  // Errors from a prefetched page surface exactly like synchronous errors.
+  EXPECT_TRUE(has_status_or_error);
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
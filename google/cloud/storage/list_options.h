@@ -0,0 +1,49 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OPTIONS_H
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/version.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Prefetch the next page of results while the current page is consumed.
+ *
+ * By default `ListObjects()` (and the other `List*()` functions) request page
+ * N+1 only after the application iterates past the last element of page N,
+ * stalling the loop for a full round-trip on every page boundary. With this
+ * option the request for the next page is issued in the background as soon as
+ * a page arrives, so applications that spend time on each element rarely wait
+ * for the next page.
+ */
+struct EnablePagePrefetch
+    : public internal::ComplexOption<EnablePagePrefetch, bool> {
+  using ComplexOption<EnablePagePrefetch, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  EnablePagePrefetch() : EnablePagePrefetch(true) {}
+  static char const* name() { return "enable-page-prefetch"; }
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OPTIONS_H
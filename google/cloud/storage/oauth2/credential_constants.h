@@ -51,6 +51,18 @@ constexpr std::chrono::seconds GoogleOAuthAccessTokenExpirationSlack() {
   return std::chrono::seconds(500);
 }
 
+/**
+ * Returns how long before its effective expiration a token refresh starts.
+ *
+ * When a token is this close to its expiration (already adjusted by
+ * `GoogleOAuthAccessTokenExpirationSlack()`) the library starts a refresh in
+ * the background, serving the current token until the new one is available.
+ * This avoids stalling request threads when the token expires.
+ */
+constexpr std::chrono::seconds GoogleOAuthAccessTokenRefreshAhead() {
+  return std::chrono::seconds(150);
+}
+
 /// The endpoint to fetch an OAuth 2.0 access token from.
 inline char const* GoogleOAuthRefreshEndpoint() {
   static constexpr char kEndpoint[] = "https://oauth2.googleapis.com/token";
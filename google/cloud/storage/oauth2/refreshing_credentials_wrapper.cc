@@ -32,6 +32,13 @@ bool RefreshingCredentialsWrapper::IsValid(
   return !temporary_token_.token.empty() && !IsExpired(now);
 }
 
+bool RefreshingCredentialsWrapper::NeedsRefreshAhead(
+    std::chrono::system_clock::time_point now) const {
+  return now > (temporary_token_.expiration_time -
+                GoogleOAuthAccessTokenExpirationSlack() -
+                GoogleOAuthAccessTokenRefreshAhead());
+}
+
 }  // namespace oauth2
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
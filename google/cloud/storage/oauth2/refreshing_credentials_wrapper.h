@@ -19,6 +19,7 @@
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 #include <chrono>
+#include <future>
 #include <string>
 #include <utility>
 
@@ -38,14 +39,53 @@ class RefreshingCredentialsWrapper {
     std::chrono::system_clock::time_point expiration_time;
   };
 
+  /**
+   * Returns the authorization header, refreshing the token as needed.
+   *
+   * When the current token approaches its expiration this function schedules
+   * a refresh on a background thread, and keeps serving the current token
+   * until the new one is available. Only when the token is (effectively)
+   * expired does the calling thread block on a refresh.
+   *
+   * The caller must serialize calls into this function, typically with the
+   * mutex protecting its credentials. @p refresh_fn may run on a background
+   * thread, but never concurrently with another invocation of itself.
+   */
   template <typename RefreshFunctor>
   StatusOr<std::string> AuthorizationHeader(
       std::chrono::system_clock::time_point now,
       RefreshFunctor refresh_fn) const {
+    // Adopt the result of a completed background refresh, if any.
+    if (pending_refresh_.valid() &&
+        pending_refresh_.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready) {
+      auto refreshed = pending_refresh_.get();
+      // A failed background refresh is not an error yet: the current token
+      // may still be valid, and the refresh is retried once it expires.
+      if (refreshed) {
+        temporary_token_ = *std::move(refreshed);
+      }
+    }
+
     if (IsValid(now)) {
+      if (NeedsRefreshAhead(now) && !pending_refresh_.valid()) {
+        pending_refresh_ =
+            std::async(std::launch::async, std::move(refresh_fn));
+      }
       return temporary_token_.token;
     }
 
+    // The token expired with a background refresh still in flight, use its
+    // result rather than issuing a second request.
+    if (pending_refresh_.valid()) {
+      auto refreshed = pending_refresh_.get();
+      if (refreshed) {
+        temporary_token_ = *std::move(refreshed);
+        return temporary_token_.token;
+      }
+      // The background refresh failed, fall through and retry synchronously.
+    }
+
     StatusOr<TemporaryToken> new_token = refresh_fn();
     if (new_token) {
       temporary_token_ = *std::move(new_token);
@@ -76,7 +116,16 @@ class RefreshingCredentialsWrapper {
   bool IsValid(std::chrono::system_clock::time_point now) const;
 
  private:
+  /**
+   * Returns whether a background refresh should start.
+   *
+   * This is the case when the current token is close enough to its effective
+   * expiration that a refresh should start, but the token is still valid.
+   */
+  bool NeedsRefreshAhead(std::chrono::system_clock::time_point now) const;
+
   mutable TemporaryToken temporary_token_;
+  mutable std::future<StatusOr<TemporaryToken>> pending_refresh_;
 };
 
 }  // namespace oauth2
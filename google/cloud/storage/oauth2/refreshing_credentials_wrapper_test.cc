@@ -0,0 +1,136 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/oauth2/refreshing_credentials_wrapper.h"
+#include "google/cloud/storage/oauth2/credential_constants.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+namespace {
+
+using TemporaryToken = RefreshingCredentialsWrapper::TemporaryToken;
+
+TEST(RefreshingCredentialsWrapperTest, RefreshesWhenInvalid) {
+  RefreshingCredentialsWrapper wrapper;
+  auto const now = std::chrono::system_clock::now();
+  int calls = 0;
+  auto refresh = [&calls, now] {
+    ++calls;
+    return make_status_or(
+        TemporaryToken{"token-1", now + GoogleOAuthAccessTokenLifetime()});
+  };
+
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("token-1", *header);
+  EXPECT_EQ(1, calls);
+
+  // A valid token far from expiration is served without a new refresh.
+  header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("token-1", *header);
+  EXPECT_EQ(1, calls);
+}
+
+TEST(RefreshingCredentialsWrapperTest, RefreshErrorsArePropagated) {
+  RefreshingCredentialsWrapper wrapper;
+  auto const now = std::chrono::system_clock::now();
+  auto refresh = [] {
+    return StatusOr<TemporaryToken>(
+        Status(StatusCode::kUnavailable, "cannot refresh"));
+  };
+
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  EXPECT_EQ(StatusCode::kUnavailable, header.status().code());
+}
+
+TEST(RefreshingCredentialsWrapperTest, RefreshAheadServesCurrentToken) {
+  RefreshingCredentialsWrapper wrapper;
+  auto const now = std::chrono::system_clock::now();
+  auto const expiration = now + GoogleOAuthAccessTokenLifetime();
+  std::atomic<int> calls(0);
+  auto refresh = [&calls, expiration] {
+    auto count = ++calls;
+    auto token_expiration =
+        count == 1 ? expiration : expiration + GoogleOAuthAccessTokenLifetime();
+    return make_status_or(
+        TemporaryToken{"token-" + std::to_string(count), token_expiration});
+  };
+
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("token-1", *header);
+
+  // Within the refresh-ahead window the current token is served immediately,
+  // and a background refresh is scheduled.
+  auto const in_window = expiration -
+                         GoogleOAuthAccessTokenExpirationSlack() -
+                         GoogleOAuthAccessTokenRefreshAhead() / 2;
+  header = wrapper.AuthorizationHeader(in_window, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("token-1", *header);
+
+  // The background refresh eventually lands and its token is adopted.
+  for (int i = 0; i != 100 && *header == "token-1"; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    header = wrapper.AuthorizationHeader(in_window, refresh);
+    ASSERT_STATUS_OK(header);
+  }
+  EXPECT_EQ("token-2", *header);
+  EXPECT_EQ(2, calls.load());
+}
+
+TEST(RefreshingCredentialsWrapperTest, ExpiredTokenUsesPendingRefresh) {
+  RefreshingCredentialsWrapper wrapper;
+  auto const now = std::chrono::system_clock::now();
+  auto const expiration = now + GoogleOAuthAccessTokenLifetime();
+  std::atomic<int> calls(0);
+  auto refresh = [&calls, expiration] {
+    auto count = ++calls;
+    auto token_expiration =
+        count == 1 ? expiration : expiration + GoogleOAuthAccessTokenLifetime();
+    return make_status_or(
+        TemporaryToken{"token-" + std::to_string(count), token_expiration});
+  };
+
+  auto header = wrapper.AuthorizationHeader(now, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("token-1", *header);
+
+  // Schedule a background refresh, then expire the token before it completes.
+  auto const in_window = expiration -
+                         GoogleOAuthAccessTokenExpirationSlack() -
+                         GoogleOAuthAccessTokenRefreshAhead() / 2;
+  header = wrapper.AuthorizationHeader(in_window, refresh);
+  ASSERT_STATUS_OK(header);
+
+  header = wrapper.AuthorizationHeader(expiration, refresh);
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("token-2", *header);
+  EXPECT_EQ(2, calls.load());
+}
+
+}  // namespace
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
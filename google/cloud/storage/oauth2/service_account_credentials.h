@@ -21,6 +21,7 @@
 #include "google/cloud/storage/oauth2/credential_constants.h"
 #include "google/cloud/storage/oauth2/credentials.h"
 #include "google/cloud/storage/oauth2/refreshing_credentials_wrapper.h"
+#include "google/cloud/storage/oauth2/token_file_cache.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/optional.h"
 #include "absl/types/optional.h"
@@ -114,6 +115,11 @@ std::string CreateServiceAccountRefreshPayload(
  * access token is invalid or nearing expiration, this will class will first
  * obtain a new access token before returning the Authorization header string.
 
+ * When the `GOOGLE_CLOUD_CPP_STORAGE_TOKEN_CACHE_DIR` environment variable
+ * names an existing directory, access tokens are also cached in (and reused
+ * from) that directory, so multiple processes on a host can share warm
+ * tokens. See `TokenFileCache` for the caveats around this opt-in feature.
+ *
  * @see https://developers.google.com/identity/protocols/OAuth2ServiceAccount
  * for an overview of using service accounts with Google's OAuth 2.0 system.
  *
@@ -151,6 +157,9 @@ class ServiceAccountCredentials : public Credentials {
             .get();
     grant_type_ = std::move(grant_type);
     request_ = request_builder.BuildRequest();
+    if (token_cache_.enabled()) {
+      token_cache_key_ = TokenCacheKey(CacheKeyMaterial());
+    }
   }
 
   StatusOr<std::string> AuthorizationHeader() override {
@@ -188,6 +197,9 @@ class ServiceAccountCredentials : public Credentials {
 
  private:
   StatusOr<RefreshingCredentialsWrapper::TemporaryToken> Refresh() {
+    auto cached = token_cache_.Load(token_cache_key_, clock_.now());
+    if (cached) return *std::move(cached);
+
     auto payload =
         CreateServiceAccountRefreshPayload(info_, grant_type_, clock_.now());
 
@@ -199,7 +211,28 @@ class ServiceAccountCredentials : public Credentials {
       return AsStatus(*response);
     }
 
-    return ParseServiceAccountRefreshResponse(*response, clock_.now());
+    auto token = ParseServiceAccountRefreshResponse(*response, clock_.now());
+    if (token) token_cache_.Store(token_cache_key_, *token);
+    return token;
+  }
+
+  /// The attributes that make a cached token reusable by this credential.
+  std::string CacheKeyMaterial() const {
+    std::string material = info_.client_email;
+    material += '\n';
+    material += info_.private_key_id;
+    material += '\n';
+    material += info_.token_uri;
+    material += '\n';
+    if (info_.scopes) {
+      for (auto const& scope : *info_.scopes) {
+        material += scope;
+        material += ',';
+      }
+    }
+    material += '\n';
+    if (info_.subject) material += *info_.subject;
+    return material;
   }
 
   typename HttpRequestBuilderType::RequestType request_;
@@ -208,6 +241,8 @@ class ServiceAccountCredentials : public Credentials {
   mutable std::mutex mu_;
   RefreshingCredentialsWrapper refreshing_creds_;
   ClockType clock_;
+  TokenFileCache token_cache_ = TokenFileCache::Default();
+  std::string token_cache_key_;
 };
 
 }  // namespace oauth2
@@ -0,0 +1,118 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/oauth2/token_file_cache.h"
+#include "google/cloud/storage/internal/sha256_hash.h"
+#include "google/cloud/storage/oauth2/credential_constants.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#if _WIN32
+#else
+#include <sys/stat.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+namespace {
+
+// A cache file contains one line with the expiration time, in seconds since
+// the Unix epoch, followed by one line with the authorization header. The
+// format is an implementation detail, it may change from release to release.
+std::string CachePath(std::string const& directory, std::string const& key) {
+  return directory + '/' + key + ".token";
+}
+
+}  // namespace
+
+std::string TokenCacheKey(std::string const& key_material) {
+  return storage::internal::HexEncode(
+      storage::internal::Sha256Hash(key_material));
+}
+
+TokenFileCache TokenFileCache::Default() {
+  auto directory = google::cloud::internal::GetEnv(
+      "GOOGLE_CLOUD_CPP_STORAGE_TOKEN_CACHE_DIR");
+  if (!directory || directory->empty()) return TokenFileCache{};
+  return TokenFileCache(*std::move(directory));
+}
+
+absl::optional<RefreshingCredentialsWrapper::TemporaryToken>
+TokenFileCache::Load(std::string const& key,
+                     std::chrono::system_clock::time_point now) const {
+  if (!enabled()) return absl::nullopt;
+  std::ifstream is(CachePath(directory_, key));
+  if (!is.is_open()) return absl::nullopt;
+  std::string line;
+  if (!std::getline(is, line)) return absl::nullopt;
+  char* end = nullptr;
+  auto const expiration_seconds = std::strtoll(line.c_str(), &end, 10);
+  if (end == line.c_str() || *end != '\0') return absl::nullopt;
+  auto const expiration = std::chrono::system_clock::from_time_t(
+      static_cast<std::time_t>(expiration_seconds));
+  if (now > expiration - GoogleOAuthAccessTokenExpirationSlack()) {
+    return absl::nullopt;
+  }
+  std::string token;
+  if (!std::getline(is, token) || token.empty()) return absl::nullopt;
+  return RefreshingCredentialsWrapper::TemporaryToken{std::move(token),
+                                                      expiration};
+}
+
+void TokenFileCache::Store(
+    std::string const& key,
+    RefreshingCredentialsWrapper::TemporaryToken const& token) const {
+  if (!enabled()) return;
+  auto const path = CachePath(directory_, key);
+  auto generator = google::cloud::internal::MakeDefaultPRNG();
+  auto const tmp = path + ".tmp." +
+                   google::cloud::internal::Sample(
+                       generator, 16, "abcdefghijklmnopqrstuvwxyz0123456789");
+  std::ofstream os(tmp, std::ios::trunc);
+  if (!os.is_open()) return;
+#if _WIN32
+#else
+  // Tokens are sensitive, restrict the file to its owner. The cache directory
+  // should itself be restricted, this is only a second line of defense.
+  (void)::chmod(tmp.c_str(), S_IRUSR | S_IWUSR);
+#endif  // _WIN32
+  auto const expiration_seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(
+          token.expiration_time.time_since_epoch())
+          .count();
+  os << expiration_seconds << "\n" << token.token << "\n";
+  os.close();
+  if (!os) {
+    (void)std::remove(tmp.c_str());
+    return;
+  }
+  // On POSIX systems the rename atomically replaces any existing cache file.
+  // On other systems it may fail when the target exists, in which case the
+  // existing entry remains in place and this write is discarded.
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    (void)std::remove(tmp.c_str());
+  }
+}
+
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,103 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OAUTH2_TOKEN_FILE_CACHE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OAUTH2_TOKEN_FILE_CACHE_H
+
+#include "google/cloud/storage/oauth2/refreshing_credentials_wrapper.h"
+#include "google/cloud/storage/version.h"
+#include "absl/types/optional.h"
+#include <chrono>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+
+/// Returns the cache file name (a filename-safe digest) for @p key_material.
+std::string TokenCacheKey(std::string const& key_material);
+
+/**
+ * A file-backed cache of access tokens, shared across processes on a host.
+ *
+ * Short-lived processes pay a full token exchange before their first request.
+ * This cache lets such processes reuse a warm token obtained by any other
+ * process on the same host, reducing both startup latency and the number of
+ * calls against the token endpoint.
+ *
+ * The cache is opt-in: it is disabled unless the
+ * `GOOGLE_CLOUD_CPP_STORAGE_TOKEN_CACHE_DIR` environment variable names an
+ * existing directory. Access tokens grant access to Google Cloud resources,
+ * so this directory should be readable and writable only by the operating
+ * system users that are allowed to share tokens, typically it is owned by a
+ * single user with `0700` permissions.
+ *
+ * Writers never update a cache file in place: they write a temporary file in
+ * the same directory and then rename it over the cache file. On POSIX systems
+ * the rename is atomic, so readers observe either the old token or the new
+ * one, never a partial write. Concurrent writers may race, but each writes a
+ * complete, valid token, so the last writer simply wins. Expired entries are
+ * ignored by readers and eventually overwritten.
+ */
+class TokenFileCache {
+ public:
+  /**
+   * Returns a cache rooted at `GOOGLE_CLOUD_CPP_STORAGE_TOKEN_CACHE_DIR`.
+   *
+   * Returns a disabled cache when the environment variable is unset or empty.
+   */
+  static TokenFileCache Default();
+
+  /// Creates a disabled cache, `Load()` and `Store()` become no-ops.
+  TokenFileCache() = default;
+
+  /// Creates a cache rooted at @p directory, which must already exist.
+  explicit TokenFileCache(std::string directory)
+      : directory_(std::move(directory)) {}
+
+  bool enabled() const { return !directory_.empty(); }
+
+  /**
+   * Returns the token cached under @p key, if present and not expired.
+   *
+   * A token within `GoogleOAuthAccessTokenExpirationSlack()` of its
+   * expiration is treated as expired, just as it would be when held in
+   * memory. Unreadable or malformed cache files are treated as a cache miss.
+   */
+  absl::optional<RefreshingCredentialsWrapper::TemporaryToken> Load(
+      std::string const& key, std::chrono::system_clock::time_point now) const;
+
+  /**
+   * Caches @p token under @p key.
+   *
+   * This is a best-effort operation, failures to write the cache file are
+   * ignored: the caller already holds a valid token, the only cost of a
+   * failed write is that other processes cannot reuse it.
+   */
+  void Store(std::string const& key,
+             RefreshingCredentialsWrapper::TemporaryToken const& token) const;
+
+ private:
+  std::string directory_;
+};
+
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OAUTH2_TOKEN_FILE_CACHE_H
@@ -0,0 +1,120 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/oauth2/token_file_cache.h"
+#include "google/cloud/storage/oauth2/credential_constants.h"
+#include "google/cloud/testing_util/scoped_environment.h"
+#include <gmock/gmock.h>
+#include <fstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+namespace {
+
+using ::google::cloud::testing_util::ScopedEnvironment;
+using ::testing::Not;
+
+constexpr char kEnvVarName[] = "GOOGLE_CLOUD_CPP_STORAGE_TOKEN_CACHE_DIR";
+
+RefreshingCredentialsWrapper::TemporaryToken MakeToken(
+    std::string token, std::chrono::system_clock::time_point expiration) {
+  return RefreshingCredentialsWrapper::TemporaryToken{std::move(token),
+                                                      expiration};
+}
+
+TEST(TokenFileCacheTest, DisabledByDefault) {
+  ScopedEnvironment env(kEnvVarName, {});
+  auto cache = TokenFileCache::Default();
+  EXPECT_FALSE(cache.enabled());
+  EXPECT_FALSE(
+      cache.Load(TokenCacheKey("test-key"), std::chrono::system_clock::now()));
+}
+
+TEST(TokenFileCacheTest, EnabledByEnvironment) {
+  ScopedEnvironment env(kEnvVarName, ::testing::TempDir());
+  auto cache = TokenFileCache::Default();
+  EXPECT_TRUE(cache.enabled());
+}
+
+TEST(TokenFileCacheTest, RoundTrip) {
+  TokenFileCache cache(::testing::TempDir());
+  auto const key = TokenCacheKey("round-trip-key");
+  // The cache stores the expiration with one second granularity, use a value
+  // that round trips exactly.
+  auto const now = std::chrono::system_clock::from_time_t(
+      std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+  auto const expiration = now + GoogleOAuthAccessTokenLifetime();
+
+  cache.Store(key, MakeToken("Authorization: Bearer test-token", expiration));
+  auto actual = cache.Load(key, now);
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_EQ("Authorization: Bearer test-token", actual->token);
+  EXPECT_EQ(expiration, actual->expiration_time);
+}
+
+TEST(TokenFileCacheTest, MissingEntryIsACacheMiss) {
+  TokenFileCache cache(::testing::TempDir());
+  EXPECT_FALSE(cache.Load(TokenCacheKey("no-such-key"),
+                          std::chrono::system_clock::now()));
+}
+
+TEST(TokenFileCacheTest, ExpiredEntryIsACacheMiss) {
+  TokenFileCache cache(::testing::TempDir());
+  auto const key = TokenCacheKey("expired-key");
+  auto const now = std::chrono::system_clock::now();
+
+  // A token within the expiration slack is as good as expired.
+  cache.Store(key, MakeToken("Authorization: Bearer stale-token",
+                             now + GoogleOAuthAccessTokenExpirationSlack() -
+                                 std::chrono::seconds(5)));
+  EXPECT_FALSE(cache.Load(key, now));
+}
+
+TEST(TokenFileCacheTest, MalformedEntryIsACacheMiss) {
+  TokenFileCache cache(::testing::TempDir());
+  auto const key = TokenCacheKey("malformed-key");
+  std::ofstream(::testing::TempDir() + "/" + key + ".token")
+      << "not-a-timestamp\nAuthorization: Bearer token\n";
+  EXPECT_FALSE(cache.Load(key, std::chrono::system_clock::now()));
+}
+
+TEST(TokenFileCacheTest, StoreReplacesExistingEntry) {
+  TokenFileCache cache(::testing::TempDir());
+  auto const key = TokenCacheKey("replace-key");
+  auto const now = std::chrono::system_clock::now();
+  auto const expiration = now + GoogleOAuthAccessTokenLifetime();
+
+  cache.Store(key, MakeToken("Authorization: Bearer token-1", expiration));
+  cache.Store(key, MakeToken("Authorization: Bearer token-2", expiration));
+  auto actual = cache.Load(key, now);
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_EQ("Authorization: Bearer token-2", actual->token);
+}
+
+TEST(TokenFileCacheTest, KeysAreFilenameSafeDigests) {
+  auto const key = TokenCacheKey("some/material\nwith odd characters");
+  EXPECT_EQ(64U, key.size());
+  EXPECT_EQ(std::string::npos, key.find_first_not_of("0123456789abcdef"));
+  EXPECT_THAT(TokenCacheKey("different material"), Not(key));
+}
+
+}  // namespace
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
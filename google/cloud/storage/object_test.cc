@@ -18,8 +18,11 @@
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/storage/testing/retry_tests.h"
+#include "google/cloud/storage/testing/temp_file.h"
 #include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
 #include <gmock/gmock.h>
+#include <fstream>
 
 namespace google {
 namespace cloud {
@@ -420,6 +423,63 @@ TEST_F(ObjectTest, ReadObjectPermanentFailure) {
   EXPECT_THAT(status.message(), HasSubstr("ReadObject"));
 }
 
+TEST_F(ObjectTest, DownloadToFile) {
+  std::string const contents = "The quick brown fox jumps over the lazy dog";
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce([&contents](internal::ReadObjectRangeRequest const& request) {
+        EXPECT_EQ("test-bucket-name", request.bucket_name());
+        EXPECT_EQ("test-object-name", request.object_name());
+        auto source = absl::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*source, Read(_, _))
+            .WillOnce([&contents](char* buf, std::size_t n) {
+              EXPECT_GE(n, contents.size());
+              std::copy(contents.begin(), contents.end(), buf);
+              return make_status_or(internal::ReadSourceResult{
+                  contents.size(),
+                  internal::HttpResponse{
+                      200,
+                      {},
+                      {{"content-length",
+                        std::to_string(contents.size())}}}});
+            })
+            .WillOnce(Return(make_status_or(internal::ReadSourceResult{
+                0, internal::HttpResponse{200, {}, {}}})));
+        return make_status_or(
+            std::unique_ptr<internal::ObjectReadSource>(std::move(source)));
+      });
+
+  google::cloud::storage::testing::TempFile destination("");
+  auto status = client_->DownloadToFile("test-bucket-name", "test-object-name",
+                                        destination.name());
+  ASSERT_STATUS_OK(status);
+
+  std::ifstream is(destination.name(), std::ios::binary);
+  std::string actual(std::istreambuf_iterator<char>{is},
+                     std::istreambuf_iterator<char>{});
+  EXPECT_EQ(contents, actual);
+}
+
+TEST_F(ObjectTest, DownloadToFileCannotOpenDestination) {
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce([](internal::ReadObjectRangeRequest const&) {
+        auto source = absl::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*source, Read(_, _))
+            .WillRepeatedly(Return(make_status_or(internal::ReadSourceResult{
+                0, internal::HttpResponse{200, {}, {}}})));
+        return make_status_or(
+            std::unique_ptr<internal::ObjectReadSource>(std::move(source)));
+      });
+
+  auto status =
+      client_->DownloadToFile("test-bucket-name", "test-object-name",
+                              "/no/such/directory/no-such-file.txt");
+  EXPECT_FALSE(status.ok());
+  EXPECT_THAT(status.message(),
+              HasSubstr("cannot open download destination file"));
+}
+
 ObjectMetadata CreateObject(int index) {
   std::string id = "object-" + std::to_string(index);
   std::string name = id;
@@ -0,0 +1,66 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include <fstream>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+Status DownloadShard(ObjectReadStream stream, std::string const& file_name,
+                     std::int64_t offset) {
+  if (!stream.status().ok()) {
+    return Status(stream.status().code(),
+                  "DownloadShard(): cannot open download source object"
+                  " - status.message=" +
+                      stream.status().message());
+  }
+  std::fstream os(file_name,
+                  std::ios::binary | std::ios::in | std::ios::out);
+  if (!os.is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "DownloadShard(): cannot open download destination file " +
+                      file_name);
+  }
+  os.seekp(offset);
+
+  std::vector<char> buffer(1024 * 1024L);
+  do {
+    stream.read(buffer.data(), buffer.size());
+    os.write(buffer.data(), stream.gcount());
+  } while (os.good() && stream.good());
+  os.close();
+  if (!os.good()) {
+    return Status(StatusCode::kUnknown,
+                  "DownloadShard(): cannot write download destination file " +
+                      file_name);
+  }
+  if (!stream.status().ok()) {
+    return Status(stream.status().code(),
+                  "DownloadShard(): error reading download source object"
+                  " - status.message=" +
+                      stream.status().message());
+  }
+  return Status();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,165 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "absl/memory/memory.h"
+#include <gmock/gmock.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+std::string const kBucketName = "test-bucket";
+std::string const kObjectName = "test-object";
+std::int64_t const kGeneration = 42;
+
+ObjectMetadata MockObject(std::string const& object_name, std::uint64_t size) {
+  std::stringstream text;
+  text << R"""({
+        "bucket": ")""" +
+              kBucketName + R"""(",
+        "name": ")""" +
+              object_name + R"""(",
+        "generation": )""" << kGeneration
+       << R"""(,
+        "size": )""" << size
+       << R"""(,
+        "kind": "storage#object"
+      })""";
+  return ObjectMetadataParser::FromString(text.str()).value();
+}
+
+class ParallelDownloadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    raw_client_mock_ = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*raw_client_mock_, client_options())
+        .WillRepeatedly(ReturnRef(client_options_));
+    client_.reset(new Client{
+        std::shared_ptr<internal::RawClient>(raw_client_mock_),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+  void TearDown() override {
+    client_.reset();
+    raw_client_mock_.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> raw_client_mock_;
+  std::unique_ptr<Client> client_;
+  ClientOptions client_options_ =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(is), {});
+}
+
+TEST_F(ParallelDownloadTest, Success) {
+  std::string const expected = "0123456789abcdef";
+  EXPECT_CALL(*raw_client_mock_, GetObjectMetadata(_))
+      .WillOnce([&](GetObjectMetadataRequest const& request) {
+        EXPECT_EQ(kBucketName, request.bucket_name());
+        EXPECT_EQ(kObjectName, request.object_name());
+        return make_status_or(MockObject(kObjectName, expected.size()));
+      });
+  EXPECT_CALL(*raw_client_mock_, ReadObject(_))
+      .Times(4)
+      .WillRepeatedly([&](ReadObjectRangeRequest const& request) {
+        EXPECT_TRUE(request.HasOption<ReadRange>());
+        EXPECT_TRUE(request.HasOption<Generation>());
+        EXPECT_EQ(kGeneration, request.GetOption<Generation>().value());
+        auto const range = request.GetOption<ReadRange>().value();
+        auto const contents = expected.substr(
+            static_cast<std::size_t>(range.begin),
+            static_cast<std::size_t>(range.end - range.begin));
+        auto source = absl::make_unique<testing::MockObjectReadSource>();
+        EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(true));
+        EXPECT_CALL(*source, Read(_, _))
+            .WillOnce([contents](char* buf, std::size_t n) {
+              EXPECT_GE(n, contents.size());
+              std::memcpy(buf, contents.data(), contents.size());
+              return ReadSourceResult{contents.size(), {}};
+            })
+            .WillRepeatedly(Return(ReadSourceResult{0, {}}));
+        return StatusOr<std::unique_ptr<ObjectReadSource>>(std::move(source));
+      });
+
+  testing::TempFile dest("");
+  auto actual = ParallelDownloadFile(*client_, kBucketName, kObjectName,
+                                     dest.name(), 4);
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(kObjectName, actual->name());
+  EXPECT_EQ(expected, ReadFile(dest.name()));
+}
+
+TEST_F(ParallelDownloadTest, ZeroShardsIsAnError) {
+  testing::TempFile dest("");
+  auto actual = ParallelDownloadFile(*client_, kBucketName, kObjectName,
+                                     dest.name(), 0);
+  EXPECT_EQ(StatusCode::kInvalidArgument, actual.status().code());
+}
+
+TEST_F(ParallelDownloadTest, GetMetadataFailurePropagates) {
+  EXPECT_CALL(*raw_client_mock_, GetObjectMetadata(_))
+      .WillOnce(Return(StatusOr<ObjectMetadata>(PermanentError())));
+
+  testing::TempFile dest("");
+  auto actual = ParallelDownloadFile(*client_, kBucketName, kObjectName,
+                                     dest.name(), 2);
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+TEST_F(ParallelDownloadTest, ShardFailurePropagates) {
+  std::string const expected = "0123456789abcdef";
+  EXPECT_CALL(*raw_client_mock_, GetObjectMetadata(_))
+      .WillOnce([&](GetObjectMetadataRequest const&) {
+        return make_status_or(MockObject(kObjectName, expected.size()));
+      });
+  EXPECT_CALL(*raw_client_mock_, ReadObject(_))
+      .WillRepeatedly([&](ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<ObjectReadSource>>(PermanentError());
+      });
+
+  testing::TempFile dest("");
+  auto actual = ParallelDownloadFile(*client_, kBucketName, kObjectName,
+                                     dest.name(), 2);
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
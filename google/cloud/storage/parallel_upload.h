@@ -24,6 +24,7 @@
 #include "google/cloud/status_or.h"
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
@@ -68,6 +69,27 @@ class MinStreamSize {
   std::uintmax_t value_;
 };
 
+/**
+ * A parameter type indicating the maximum number of upload threads to
+ * `ParallelUploadFile`.
+ *
+ * By default `ParallelUploadFile` starts one thread per shard. With this
+ * option it starts at most this many threads, and each thread picks up the
+ * next pending shard as soon as it finishes its current one. Combine it with
+ * a small `MinStreamSize` to create many shards, smaller than a static
+ * partition would use: a slow connection then delays the upload by (at most)
+ * one small shard, instead of a full thread-sized slice of the file.
+ */
+class MaxThreads {
+ public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  MaxThreads(std::size_t value) : value_(value) {}
+  std::size_t value() const { return value_; }
+
+ private:
+  std::size_t value_;
+};
+
 namespace internal {
 
 class ParallelUploadFileShard;
@@ -1058,9 +1080,9 @@ struct CreateParallelUploadShards {
             std::tie(options...));
     bool const new_session = !resumable_session_id_arg ||
                              resumable_session_id_arg.value().value().empty();
-    auto upload_options =
-        StaticTupleFilter<NotAmong<MaxStreams, MinStreamSize>::TPred>(
-            std::tie(options...));
+    auto upload_options = StaticTupleFilter<
+        NotAmong<MaxStreams, MinStreamSize, MaxThreads>::TPred>(
+        std::tie(options...));
 
     std::vector<uintmax_t> file_split_points;
     std::size_t num_shards = 0;
@@ -1155,8 +1177,9 @@ StatusOr<std::vector<ParallelUploadFileShard>> CreateUploadShards(
  * @param options a list of optional query parameters and/or request headers.
  *     Valid types for this operation include `DestinationPredefinedAcl`,
  *     `EncryptionKey`, `IfGenerationMatch`, `IfMetagenerationMatch`,
- *     `KmsKeyName`, `MaxStreams, `MinStreamSize`, `QuotaUser`, `UserIp`,
- *     `UserProject`, `WithObjectMetadata`, `UseResumableUploadSession`.
+ *     `KmsKeyName`, `MaxStreams, `MaxThreads`, `MinStreamSize`, `QuotaUser`,
+ *     `UserIp`, `UserProject`, `WithObjectMetadata`,
+ *     `UseResumableUploadSession`.
  *
  * @return the metadata of the object created by the upload.
  *
@@ -1181,13 +1204,27 @@ StatusOr<ObjectMetadata> ParallelUploadFile(
     return shards.status();
   }
 
+  auto const max_threads =
+      internal::ExtractFirstOccurenceOfType<MaxThreads>(std::tie(options...))
+          .value_or(MaxThreads(shards->size()))
+          .value();
+  auto const thread_count = (std::max<std::size_t>)(
+      1, (std::min<std::size_t>)(max_threads, shards->size()));
+
+  // The threads claim shards from a shared counter. A thread that finishes a
+  // fast shard picks up the next pending one instead of idling, so a slow
+  // stream delays the upload by at most one shard.
+  std::atomic<std::size_t> next_shard(0);
   std::vector<std::thread> threads;
-  threads.reserve(shards->size());
-  for (auto& shard : *shards) {
-    threads.emplace_back([&shard] {
-      // We can safely ignore the status - if something fails we'll know
-      // when obtaining final metadata.
-      shard.Upload();
+  threads.reserve(thread_count);
+  for (std::size_t i = 0; i != thread_count; ++i) {
+    threads.emplace_back([&shards, &next_shard] {
+      auto const num_shards = shards->size();
+      for (auto idx = next_shard++; idx < num_shards; idx = next_shard++) {
+        // We can safely ignore the status - if something fails we'll know
+        // when obtaining final metadata.
+        (*shards)[idx].Upload();
+      }
     });
   }
   for (auto& thread : threads) {
@@ -937,6 +937,52 @@ TEST_F(ParallelUploadTest, FileSuccessBasic) {
   EXPECT_EQ(kBucketName, res->bucket());
 }
 
+TEST_F(ParallelUploadTest, FileSuccessWithMaxThreads) {
+  // The expectations need to be reversed.
+  ExpectCreateSession(kPrefix + ".upload_shard_2", 333, "c");
+  ExpectCreateSession(kPrefix + ".upload_shard_1", 222, "b");
+  ExpectCreateSession(kPrefix + ".upload_shard_0", 111, "a");
+
+  testing::TempFile temp_file("abc");
+
+  EXPECT_CALL(*raw_client_mock_, InsertObjectMedia(_))
+      .WillOnce(expect_new_object(kPrefix, kUploadMarkerGeneration))
+      .WillOnce(expect_new_object(kPrefix + ".compose_many",
+                                  kComposeMarkerGeneration));
+  EXPECT_CALL(*raw_client_mock_, ComposeObject(_))
+      .WillOnce(create_composition_check(
+          {{kPrefix + ".upload_shard_0", 111},
+           {kPrefix + ".upload_shard_1", 222},
+           {kPrefix + ".upload_shard_2", 333}},
+          kDestObjectName, MockObject(kDestObjectName, kDestGeneration)));
+
+  ExpectedDeletions deletions({{{kPrefix + ".upload_shard_0", 111}, Status()},
+                               {{kPrefix + ".upload_shard_1", 222}, Status()},
+                               {{kPrefix + ".upload_shard_2", 333}, Status()}});
+  EXPECT_CALL(*raw_client_mock_, DeleteObject(_))
+      .WillOnce(
+          expect_deletion(kPrefix + ".compose_many", kComposeMarkerGeneration))
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce([&deletions](internal::DeleteObjectRequest const& r) {
+        return deletions(r);
+      })
+      .WillOnce(expect_deletion(kPrefix, kUploadMarkerGeneration));
+
+  // Fewer threads than shards: the two threads drain the three shards from a
+  // shared queue.
+  auto res = ParallelUploadFile(*client_, temp_file.name(), kBucketName,
+                                kDestObjectName, kPrefix, false,
+                                MinStreamSize(1), MaxThreads(2));
+  EXPECT_STATUS_OK(res);
+  EXPECT_EQ(kDestObjectName, res->name());
+  EXPECT_EQ(kBucketName, res->bucket());
+}
+
 TEST_F(ParallelUploadTest, UploadNonExistentFile) {
   auto res =
       ParallelUploadFile(*client_, "nonexistent", kBucketName, kDestObjectName,
@@ -17,6 +17,7 @@
 """Automatically generated source lists for storage_client - DO NOT EDIT."""
 
 storage_client_hdrs = [
+    "async_client.h",
     "bucket_access_control.h",
     "bucket_metadata.h",
     "client.h",
@@ -30,19 +31,24 @@ storage_client_hdrs = [
     "internal/binary_data_as_debug_string.h",
     "internal/bucket_acl_requests.h",
     "internal/bucket_requests.h",
+    "internal/caching_client.h",
     "internal/common_metadata.h",
     "internal/complex_option.h",
     "internal/compute_engine_util.h",
     "internal/const_buffer.h",
+    "internal/crc32c_combine.h",
     "internal/curl_client.h",
     "internal/curl_download_request.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
+    "internal/curl_multi_engine.h",
     "internal/curl_request.h",
     "internal/curl_request_builder.h",
     "internal/curl_resumable_upload_session.h",
+    "internal/curl_transport_stats.h",
     "internal/curl_wrappers.h",
     "internal/default_object_acl_requests.h",
+    "internal/download_buffer_pool.h",
     "internal/empty_response.h",
     "internal/generate_message_boundary.h",
     "internal/generic_object_request.h",
@@ -51,8 +57,11 @@ storage_client_hdrs = [
     "internal/hash_validator_impl.h",
     "internal/hmac_key_requests.h",
     "internal/http_response.h",
+    "internal/inflating_source.h",
+    "internal/json_string_builder.h",
     "internal/logging_client.h",
     "internal/logging_resumable_upload_session.h",
+    "internal/mapped_file_region.h",
     "internal/metadata_parser.h",
     "internal/notification_requests.h",
     "internal/object_acl_requests.h",
@@ -66,6 +75,7 @@ storage_client_hdrs = [
     "internal/range_from_pagination.h",
     "internal/raw_client.h",
     "internal/raw_client_wrapper_utils.h",
+    "internal/readahead_source.h",
     "internal/resumable_upload_session.h",
     "internal/retry_client.h",
     "internal/retry_object_read_source.h",
@@ -74,12 +84,15 @@ storage_client_hdrs = [
     "internal/sha256_hash.h",
     "internal/sign_blob_requests.h",
     "internal/signed_url_requests.h",
+    "internal/transport_selector.h",
     "internal/tuple_filter.h",
+    "internal/upload_buffer_pool.h",
     "lifecycle_rule.h",
     "list_buckets_reader.h",
     "list_hmac_keys_reader.h",
     "list_objects_and_prefixes_reader.h",
     "list_objects_reader.h",
+    "list_options.h",
     "notification_event_type.h",
     "notification_metadata.h",
     "notification_payload_format.h",
@@ -92,11 +105,13 @@ storage_client_hdrs = [
     "oauth2/google_credentials.h",
     "oauth2/refreshing_credentials_wrapper.h",
     "oauth2/service_account_credentials.h",
+    "oauth2/token_file_cache.h",
     "object_access_control.h",
     "object_metadata.h",
     "object_rewriter.h",
     "object_stream.h",
     "override_default_project.h",
+    "parallel_download.h",
     "parallel_upload.h",
     "policy_document.h",
     "retry_policy.h",
@@ -111,6 +126,7 @@ storage_client_hdrs = [
 ]
 
 storage_client_srcs = [
+    "async_client.cc",
     "bucket_access_control.cc",
     "bucket_metadata.cc",
     "client.cc",
@@ -123,31 +139,42 @@ storage_client_srcs = [
     "internal/binary_data_as_debug_string.cc",
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
+    "internal/caching_client.cc",
     "internal/compute_engine_util.cc",
     "internal/const_buffer.cc",
+    "internal/crc32c_combine.cc",
     "internal/curl_client.cc",
     "internal/curl_download_request.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
+    "internal/curl_multi_engine.cc",
     "internal/curl_request.cc",
     "internal/curl_request_builder.cc",
     "internal/curl_resumable_upload_session.cc",
+    "internal/curl_transport_stats.cc",
     "internal/curl_wrappers.cc",
     "internal/default_object_acl_requests.cc",
+    "internal/download_buffer_pool.cc",
     "internal/empty_response.cc",
     "internal/hash_validator.cc",
     "internal/hash_validator_impl.cc",
     "internal/hmac_key_requests.cc",
     "internal/http_response.cc",
+    "internal/inflating_source.cc",
+    "internal/json_string_builder.cc",
     "internal/logging_client.cc",
     "internal/logging_resumable_upload_session.cc",
+    "internal/mapped_file_region.cc",
     "internal/metadata_parser.cc",
     "internal/notification_requests.cc",
     "internal/object_acl_requests.cc",
+    "internal/object_read_source.cc",
     "internal/object_requests.cc",
     "internal/object_streambuf.cc",
     "internal/openssl_util.cc",
     "internal/policy_document_request.cc",
+    "internal/raw_client.cc",
+    "internal/readahead_source.cc",
     "internal/resumable_upload_session.cc",
     "internal/retry_client.cc",
     "internal/retry_object_read_source.cc",
@@ -156,6 +183,8 @@ storage_client_srcs = [
     "internal/sha256_hash.cc",
     "internal/sign_blob_requests.cc",
     "internal/signed_url_requests.cc",
+    "internal/transport_selector.cc",
+    "internal/upload_buffer_pool.cc",
     "lifecycle_rule.cc",
     "list_buckets_reader.cc",
     "list_hmac_keys_reader.cc",
@@ -169,10 +198,12 @@ storage_client_srcs = [
     "oauth2/google_credentials.cc",
     "oauth2/refreshing_credentials_wrapper.cc",
     "oauth2/service_account_credentials.cc",
+    "oauth2/token_file_cache.cc",
     "object_access_control.cc",
     "object_metadata.cc",
     "object_rewriter.cc",
     "object_stream.cc",
+    "parallel_download.cc",
     "parallel_upload.cc",
     "policy_document.cc",
     "service_account.cc",
@@ -17,6 +17,7 @@
 """Automatically generated unit tests list - DO NOT EDIT."""
 
 storage_client_unit_tests = [
+    "async_client_test.cc",
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
@@ -38,26 +39,34 @@ storage_client_unit_tests = [
     "internal/binary_data_as_debug_string_test.cc",
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
+    "internal/caching_client_test.cc",
     "internal/complex_option_test.cc",
     "internal/compute_engine_util_test.cc",
     "internal/const_buffer_test.cc",
+    "internal/crc32c_combine_test.cc",
     "internal/curl_client_test.cc",
     "internal/curl_handle_factory_test.cc",
+    "internal/curl_multi_engine_test.cc",
     "internal/curl_handle_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
+    "internal/curl_transport_stats_test.cc",
     "internal/curl_wrappers_disable_sigpipe_handler_test.cc",
     "internal/curl_wrappers_enable_sigpipe_handler_test.cc",
     "internal/curl_wrappers_locking_already_present_test.cc",
     "internal/curl_wrappers_locking_disabled_test.cc",
     "internal/curl_wrappers_locking_enabled_test.cc",
     "internal/default_object_acl_requests_test.cc",
+    "internal/download_buffer_pool_test.cc",
     "internal/generate_message_boundary_test.cc",
     "internal/generic_request_test.cc",
     "internal/hash_validator_test.cc",
     "internal/hmac_key_requests_test.cc",
     "internal/http_response_test.cc",
+    "internal/inflating_source_test.cc",
+    "internal/json_string_builder_test.cc",
     "internal/logging_client_test.cc",
     "internal/logging_resumable_upload_session_test.cc",
+    "internal/mapped_file_region_test.cc",
     "internal/metadata_parser_test.cc",
     "internal/notification_requests_test.cc",
     "internal/object_acl_requests_test.cc",
@@ -67,6 +76,7 @@ storage_client_unit_tests = [
     "internal/parameter_pack_validation_test.cc",
     "internal/patch_builder_test.cc",
     "internal/policy_document_request_test.cc",
+    "internal/readahead_source_test.cc",
     "internal/resumable_upload_session_test.cc",
     "internal/retry_client_test.cc",
     "internal/retry_object_read_source_test.cc",
@@ -75,7 +85,9 @@ storage_client_unit_tests = [
     "internal/sha256_hash_test.cc",
     "internal/sign_blob_requests_test.cc",
     "internal/signed_url_requests_test.cc",
+    "internal/transport_selector_test.cc",
     "internal/tuple_filter_test.cc",
+    "internal/upload_buffer_pool_test.cc",
     "lifecycle_rule_test.cc",
     "list_buckets_reader_test.cc",
     "list_hmac_keys_reader_test.cc",
@@ -87,11 +99,14 @@ storage_client_unit_tests = [
     "oauth2/compute_engine_credentials_test.cc",
     "oauth2/google_application_default_credentials_file_test.cc",
     "oauth2/google_credentials_test.cc",
+    "oauth2/refreshing_credentials_wrapper_test.cc",
     "oauth2/service_account_credentials_test.cc",
+    "oauth2/token_file_cache_test.cc",
     "object_access_control_test.cc",
     "object_metadata_test.cc",
     "object_stream_test.cc",
     "object_test.cc",
+    "parallel_download_test.cc",
     "parallel_uploads_test.cc",
     "policy_document_test.cc",
     "retry_policy_test.cc",
@@ -65,6 +65,9 @@ class MockClient : public google::cloud::storage::internal::RawClient {
   MOCK_METHOD1(GetObjectMetadata,
                StatusOr<storage::ObjectMetadata>(
                    internal::GetObjectMetadataRequest const&));
+  MOCK_METHOD1(BatchGetObjectMetadata,
+               StatusOr<internal::BatchGetObjectMetadataResponse>(
+                   internal::BatchGetObjectMetadataRequest const&));
   MOCK_METHOD1(ReadObject,
                StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
                    internal::ReadObjectRangeRequest const&));
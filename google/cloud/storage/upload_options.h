@@ -81,6 +81,24 @@ struct UploadFromOffset
   static char const* name() { return "upload-offset"; }
 };
 
+/**
+ * Overlap chunk uploads with the application filling the next buffer.
+ *
+ * By default `WriteObject()` blocks the writer while each chunk is on the
+ * wire. With this option the full buffer is handed to a background task and
+ * the application keeps filling a second buffer while the previous chunk
+ * uploads. Errors from a pipelined chunk are reported on the next flush or
+ * on `Close()`, rather than on the write that triggered the upload.
+ */
+struct EnablePipelinedUploads
+    : public internal::ComplexOption<EnablePipelinedUploads, bool> {
+  using ComplexOption<EnablePipelinedUploads, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  EnablePipelinedUploads() : EnablePipelinedUploads(true) {}
+  static char const* name() { return "enable-pipelined-uploads"; }
+};
+
 /**
  * The maximum length of the local file to upload to GCS server.
  */
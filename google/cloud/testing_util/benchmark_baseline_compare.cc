@@ -0,0 +1,100 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file
+ *
+ * Compare a benchmark run against a baseline run.
+ *
+ * Both inputs are files with one JSON line per benchmark result, as
+ * emitted by `FormatBenchmarkResultAsJson()`; lines that do not start
+ * with `{` (human-readable output, CSV, comments) are ignored. Exits
+ * with a non-zero status if any benchmark regressed significantly, so
+ * the nightly runs can fail instead of waiting for a human to notice.
+ */
+
+#include "google/cloud/testing_util/benchmark_result.h"
+#include <fstream>
+#include <iostream>
+#include <map>
+
+namespace {
+
+using ::google::cloud::testing_util::BenchmarkResult;
+using ::google::cloud::testing_util::CompareBenchmarks;
+using ::google::cloud::testing_util::ParseBenchmarkResultJson;
+
+std::map<std::string, BenchmarkResult> LoadResults(std::string const& path) {
+  std::map<std::string, BenchmarkResult> results;
+  std::ifstream is(path);
+  if (!is.is_open()) {
+    std::cerr << "cannot open " << path << "\n";
+    std::exit(1);
+  }
+  std::string line;
+  while (std::getline(is, line)) {
+    if (line.empty() || line[0] != '{') continue;
+    auto result = ParseBenchmarkResultJson(line);
+    if (!result) {
+      std::cerr << path << ": skipping malformed line: " << line << "\n";
+      continue;
+    }
+    // Merge repeated results for the same benchmark into one sample set.
+    auto ins = results.emplace(result->benchmark, *result);
+    if (!ins.second) {
+      auto& samples = ins.first->second.samples;
+      samples.insert(samples.end(), result->samples.begin(),
+                     result->samples.end());
+    }
+  }
+  return results;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 3 && argc != 4) {
+    std::cerr << "Usage: " << argv[0]
+              << " <baseline-file> <candidate-file> [t-threshold]\n";
+    return 1;
+  }
+  auto const t_threshold = argc == 4 ? std::stod(argv[3]) : 3.0;
+  auto const baseline = LoadResults(argv[1]);
+  auto const candidate = LoadResults(argv[2]);
+
+  int regressions = 0;
+  for (auto const& kv : candidate) {
+    auto loc = baseline.find(kv.first);
+    if (loc == baseline.end()) {
+      std::cout << kv.first << ": NEW (no baseline)\n";
+      continue;
+    }
+    auto const cmp = CompareBenchmarks(loc->second, kv.second, t_threshold);
+    char const* verdict = "ok";
+    if (cmp.significant) {
+      verdict = cmp.relative_change > 0 ? "REGRESSION" : "improvement";
+      if (cmp.relative_change > 0) ++regressions;
+    }
+    std::cout << kv.first << ": baseline=" << cmp.baseline_mean
+              << " candidate=" << cmp.candidate_mean
+              << " change=" << 100 * cmp.relative_change << "%"
+              << " t=" << cmp.t_statistic << " " << verdict << "\n";
+  }
+  for (auto const& kv : baseline) {
+    if (candidate.count(kv.first) == 0) {
+      std::cout << kv.first << ": MISSING from candidate\n";
+    }
+  }
+  return regressions == 0 ? 0 : 2;
+}
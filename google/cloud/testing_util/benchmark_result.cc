@@ -0,0 +1,304 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/benchmark_result.h"
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/compiler_info.h"
+#include "google/cloud/version.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace testing_util {
+
+namespace {
+
+void AppendJsonString(std::ostream& os, std::string const& value) {
+  os << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << static_cast<int>(static_cast<unsigned char>(c)) << std::dec
+             << std::setfill(' ');
+        } else {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+double Mean(std::vector<double> const& samples) {
+  if (samples.empty()) return 0;
+  return std::accumulate(samples.begin(), samples.end(), 0.0) /
+         static_cast<double>(samples.size());
+}
+
+/// The (unbiased) sample variance; 0 with fewer than two samples.
+double Variance(std::vector<double> const& samples, double mean) {
+  if (samples.size() < 2) return 0;
+  double sum = 0;
+  for (auto s : samples) sum += (s - mean) * (s - mean);
+  return sum / static_cast<double>(samples.size() - 1);
+}
+
+/**
+ * A minimal cursor over the JSON subset emitted by
+ * `FormatBenchmarkResultAsJson()`: objects, strings with simple escapes,
+ * numbers, and arrays of numbers. Every member returns false (and stops)
+ * on malformed input, the caller converts that into a `Status`.
+ */
+class JsonCursor {
+ public:
+  explicit JsonCursor(std::string const& input)
+      : pos_(input.data()), end_(input.data() + input.size()) {}
+
+  void SkipWhitespace() {
+    while (pos_ != end_ && std::isspace(static_cast<unsigned char>(*pos_))) {
+      ++pos_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (pos_ == end_ || *pos_ != c) return false;
+    ++pos_;
+    return true;
+  }
+
+  bool Peek(char c) {
+    SkipWhitespace();
+    return pos_ != end_ && *pos_ == c;
+  }
+
+  bool AtEnd() {
+    SkipWhitespace();
+    return pos_ == end_;
+  }
+
+  bool ParseString(std::string& value) {
+    value.clear();
+    if (!Consume('"')) return false;
+    while (pos_ != end_ && *pos_ != '"') {
+      if (*pos_ == '\\') {
+        if (++pos_ == end_) return false;
+        switch (*pos_) {
+          case '"':
+          case '\\':
+          case '/':
+            value.push_back(*pos_);
+            break;
+          case 'n':
+            value.push_back('\n');
+            break;
+          case 't':
+            value.push_back('\t');
+            break;
+          default:
+            return false;  // \uXXXX and friends are not emitted
+        }
+        ++pos_;
+        continue;
+      }
+      value.push_back(*pos_++);
+    }
+    return Consume('"');
+  }
+
+  bool ParseNumber(double& value) {
+    SkipWhitespace();
+    char* parse_end = nullptr;
+    value = std::strtod(pos_, &parse_end);
+    if (parse_end == pos_ || parse_end > end_) return false;
+    pos_ = parse_end;
+    return true;
+  }
+
+ private:
+  char const* pos_;
+  char const* end_;
+};
+
+Status MalformedError() {
+  return Status(StatusCode::kInvalidArgument,
+                "malformed benchmark result JSON");
+}
+
+}  // namespace
+
+std::map<std::string, std::string> BenchmarkEnvironment() {
+  return {{"version", version_string()},
+          {"compiler", google::cloud::internal::CompilerId() + "-" +
+                           google::cloud::internal::CompilerVersion()},
+          {"compiler-flags", google::cloud::internal::compiler_flags()}};
+}
+
+double Percentile(std::vector<double> samples, double percentile) {
+  if (samples.empty()) return 0;
+  std::sort(samples.begin(), samples.end());
+  auto rank = static_cast<std::size_t>(
+      std::ceil(percentile / 100.0 * static_cast<double>(samples.size())));
+  if (rank > 0) --rank;
+  if (rank >= samples.size()) rank = samples.size() - 1;
+  return samples[rank];
+}
+
+std::string FormatBenchmarkResultAsJson(BenchmarkResult const& result) {
+  std::ostringstream os;
+  os << std::setprecision(15);
+  os << "{\"benchmark\":";
+  AppendJsonString(os, result.benchmark);
+  os << ",\"unit\":";
+  AppendJsonString(os, result.unit);
+  os << ",\"environment\":{";
+  char const* sep = "";
+  for (auto const& kv : result.environment) {
+    os << sep;
+    AppendJsonString(os, kv.first);
+    os << ':';
+    AppendJsonString(os, kv.second);
+    sep = ",";
+  }
+  os << '}';
+  auto const mean = Mean(result.samples);
+  auto const minmax =
+      std::minmax_element(result.samples.begin(), result.samples.end());
+  os << ",\"count\":" << result.samples.size();
+  os << ",\"min\":"
+     << (result.samples.empty() ? 0 : *minmax.first);
+  os << ",\"max\":"
+     << (result.samples.empty() ? 0 : *minmax.second);
+  os << ",\"mean\":" << mean;
+  os << ",\"stddev\":" << std::sqrt(Variance(result.samples, mean));
+  for (auto p : {50, 90, 95, 99}) {
+    os << ",\"p" << p << "\":" << Percentile(result.samples, p);
+  }
+  os << ",\"throughput\":" << result.throughput;
+  os << ",\"samples\":[";
+  sep = "";
+  for (auto s : result.samples) {
+    os << sep << s;
+    sep = ",";
+  }
+  os << "]}";
+  return os.str();
+}
+
+StatusOr<BenchmarkResult> ParseBenchmarkResultJson(std::string const& line) {
+  BenchmarkResult result;
+  JsonCursor cursor(line);
+  if (!cursor.Consume('{')) return MalformedError();
+  bool first = true;
+  while (!cursor.Peek('}')) {
+    if (!first && !cursor.Consume(',')) return MalformedError();
+    first = false;
+    std::string key;
+    if (!cursor.ParseString(key) || !cursor.Consume(':')) {
+      return MalformedError();
+    }
+    if (key == "benchmark") {
+      if (!cursor.ParseString(result.benchmark)) return MalformedError();
+    } else if (key == "unit") {
+      if (!cursor.ParseString(result.unit)) return MalformedError();
+    } else if (key == "environment") {
+      if (!cursor.Consume('{')) return MalformedError();
+      bool first_entry = true;
+      while (!cursor.Peek('}')) {
+        if (!first_entry && !cursor.Consume(',')) return MalformedError();
+        first_entry = false;
+        std::string name;
+        std::string value;
+        if (!cursor.ParseString(name) || !cursor.Consume(':') ||
+            !cursor.ParseString(value)) {
+          return MalformedError();
+        }
+        result.environment.emplace(std::move(name), std::move(value));
+      }
+      if (!cursor.Consume('}')) return MalformedError();
+    } else if (key == "samples") {
+      if (!cursor.Consume('[')) return MalformedError();
+      bool first_entry = true;
+      while (!cursor.Peek(']')) {
+        if (!first_entry && !cursor.Consume(',')) return MalformedError();
+        first_entry = false;
+        double value;
+        if (!cursor.ParseNumber(value)) return MalformedError();
+        result.samples.push_back(value);
+      }
+      if (!cursor.Consume(']')) return MalformedError();
+    } else if (key == "throughput") {
+      if (!cursor.ParseNumber(result.throughput)) return MalformedError();
+    } else {
+      // One of the pre-computed statistics, re-derived from the samples.
+      double ignored;
+      if (!cursor.ParseNumber(ignored)) return MalformedError();
+    }
+  }
+  if (!cursor.Consume('}') || !cursor.AtEnd()) return MalformedError();
+  return result;
+}
+
+BenchmarkComparison CompareBenchmarks(BenchmarkResult const& baseline,
+                                      BenchmarkResult const& candidate,
+                                      double t_threshold,
+                                      double minimum_relative_change) {
+  BenchmarkComparison cmp{};
+  cmp.baseline_mean = Mean(baseline.samples);
+  cmp.candidate_mean = Mean(candidate.samples);
+  cmp.relative_change =
+      cmp.baseline_mean == 0
+          ? 0
+          : (cmp.candidate_mean - cmp.baseline_mean) / cmp.baseline_mean;
+  auto const baseline_n = static_cast<double>(baseline.samples.size());
+  auto const candidate_n = static_cast<double>(candidate.samples.size());
+  auto const pooled_error =
+      std::sqrt(Variance(baseline.samples, cmp.baseline_mean) / baseline_n +
+                Variance(candidate.samples, cmp.candidate_mean) / candidate_n);
+  if (pooled_error == 0) {
+    // Degenerate distributions: fall back to the relative change alone.
+    cmp.t_statistic = 0;
+    cmp.significant =
+        std::abs(cmp.relative_change) >= minimum_relative_change &&
+        cmp.candidate_mean != cmp.baseline_mean;
+    return cmp;
+  }
+  cmp.t_statistic = (cmp.candidate_mean - cmp.baseline_mean) / pooled_error;
+  cmp.significant = std::abs(cmp.t_statistic) >= t_threshold &&
+                    std::abs(cmp.relative_change) >= minimum_relative_change;
+  return cmp;
+}
+
+}  // namespace testing_util
+}  // namespace cloud
+}  // namespace google
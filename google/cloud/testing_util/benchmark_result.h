@@ -0,0 +1,114 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_BENCHMARK_RESULT_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_BENCHMARK_RESULT_H
+
+#include "google/cloud/status_or.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace testing_util {
+
+/**
+ * The machine-readable result of one benchmark.
+ *
+ * All the benchmarks emit (in addition to their human-readable and CSV
+ * output) one JSON line per result in this schema, so nightly runs can be
+ * diffed against a baseline by `benchmark_baseline_compare` instead of
+ * being eyeballed.
+ *
+ * The samples are one value per operation, in `unit`, where smaller is
+ * better (typically a latency). Throughput-style measurements go in the
+ * separate `throughput` field.
+ */
+struct BenchmarkResult {
+  /// The name of the benchmark, used to match results against a baseline.
+  std::string benchmark;
+  /// The unit of `samples`, e.g. "us".
+  std::string unit;
+  /// Environment metadata: library version, compiler, flags, and any
+  /// benchmark-specific configuration worth recording.
+  std::map<std::string, std::string> environment;
+  /// One value per operation, smaller is better.
+  std::vector<double> samples;
+  /// Operations (or bytes) per second, when the benchmark measures one.
+  double throughput = 0;
+};
+
+/// Environment metadata common to all benchmarks: library version,
+/// compiler, and compiler flags.
+std::map<std::string, std::string> BenchmarkEnvironment();
+
+/**
+ * Return the @p percentile (in [0, 100]) of @p samples using the
+ * nearest-rank method. Returns 0 for empty input.
+ */
+double Percentile(std::vector<double> samples, double percentile);
+
+/**
+ * Format @p result as a single JSON line.
+ *
+ * The line contains the name, unit, environment, the raw samples, and
+ * pre-computed summary statistics (count, min, max, mean, stddev, p50,
+ * p90, p95, p99, throughput) so downstream consumers do not need to
+ * recompute them.
+ */
+std::string FormatBenchmarkResultAsJson(BenchmarkResult const& result);
+
+/**
+ * Parse a JSON line produced by `FormatBenchmarkResultAsJson()`.
+ *
+ * Only the fields of `BenchmarkResult` are recovered, the pre-computed
+ * statistics are ignored (they are re-derived from the samples). Returns
+ * `kInvalidArgument` if @p line is not in the expected schema.
+ */
+StatusOr<BenchmarkResult> ParseBenchmarkResultJson(std::string const& line);
+
+/// The outcome of comparing a candidate run against a baseline run.
+struct BenchmarkComparison {
+  double baseline_mean;
+  double candidate_mean;
+  /// `(candidate_mean - baseline_mean) / baseline_mean`; positive values
+  /// are regressions because smaller samples are better.
+  double relative_change;
+  /// Welch's t-statistic for the difference of the means.
+  double t_statistic;
+  /// Whether the difference is both statistically significant and large
+  /// enough to matter.
+  bool significant;
+};
+
+/**
+ * Compare two runs of the same benchmark.
+ *
+ * Uses Welch's unequal-variances t-test on the sample means. The
+ * difference is reported as significant only when the t-statistic exceeds
+ * @p t_threshold *and* the relative change exceeds
+ * @p minimum_relative_change; the second condition keeps microsecond-level
+ * jitter on very tight distributions from paging anyone.
+ */
+BenchmarkComparison CompareBenchmarks(BenchmarkResult const& baseline,
+                                      BenchmarkResult const& candidate,
+                                      double t_threshold = 3.0,
+                                      double minimum_relative_change = 0.02);
+
+}  // namespace testing_util
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_TESTING_UTIL_BENCHMARK_RESULT_H
@@ -0,0 +1,131 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/testing_util/benchmark_result.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace testing_util {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+TEST(BenchmarkResult, PercentileNearestRank) {
+  std::vector<double> samples{50, 10, 40, 30, 20};
+  EXPECT_EQ(10, Percentile(samples, 0));
+  EXPECT_EQ(30, Percentile(samples, 50));
+  EXPECT_EQ(50, Percentile(samples, 99));
+  EXPECT_EQ(50, Percentile(samples, 100));
+  EXPECT_EQ(0, Percentile({}, 50));
+}
+
+TEST(BenchmarkResult, FormatIncludesSummary) {
+  BenchmarkResult result;
+  result.benchmark = "apply-latency";
+  result.unit = "us";
+  result.environment["version"] = "1.17.0";
+  result.samples = {1, 2, 3, 4};
+  result.throughput = 1000.5;
+
+  auto const json = FormatBenchmarkResultAsJson(result);
+  EXPECT_THAT(json, HasSubstr("\"benchmark\":\"apply-latency\""));
+  EXPECT_THAT(json, HasSubstr("\"unit\":\"us\""));
+  EXPECT_THAT(json, HasSubstr("\"version\":\"1.17.0\""));
+  EXPECT_THAT(json, HasSubstr("\"count\":4"));
+  EXPECT_THAT(json, HasSubstr("\"min\":1"));
+  EXPECT_THAT(json, HasSubstr("\"max\":4"));
+  EXPECT_THAT(json, HasSubstr("\"mean\":2.5"));
+  EXPECT_THAT(json, HasSubstr("\"p50\":2"));
+  EXPECT_THAT(json, HasSubstr("\"throughput\":1000.5"));
+  EXPECT_THAT(json, HasSubstr("\"samples\":[1,2,3,4]"));
+}
+
+TEST(BenchmarkResult, RoundTrip) {
+  BenchmarkResult result;
+  result.benchmark = "scan \"quoted\"";
+  result.unit = "us";
+  result.environment["compiler"] = "GNU-10.1\nextra";
+  result.samples = {1.5, -2.25, 1e6};
+  result.throughput = 42;
+
+  auto parsed = ParseBenchmarkResultJson(FormatBenchmarkResultAsJson(result));
+  ASSERT_TRUE(parsed.ok()) << parsed.status();
+  EXPECT_EQ(result.benchmark, parsed->benchmark);
+  EXPECT_EQ(result.unit, parsed->unit);
+  EXPECT_EQ(result.environment, parsed->environment);
+  EXPECT_THAT(parsed->samples, ElementsAre(1.5, -2.25, 1e6));
+  EXPECT_EQ(42, parsed->throughput);
+}
+
+TEST(BenchmarkResult, ParseRejectsMalformed) {
+  for (std::string input :
+       {"", "{", "{\"benchmark\":}", "[1,2]", "{\"samples\":[1,}",
+        "{\"benchmark\":\"x\"} junk"}) {
+    auto parsed = ParseBenchmarkResultJson(input);
+    EXPECT_EQ(StatusCode::kInvalidArgument, parsed.status().code())
+        << "input=" << input;
+  }
+}
+
+TEST(BenchmarkResult, CompareFlagsLargeShift) {
+  BenchmarkResult baseline;
+  BenchmarkResult candidate;
+  for (int i = 0; i != 100; ++i) {
+    baseline.samples.push_back(100.0 + (i % 5));
+    candidate.samples.push_back(150.0 + (i % 5));
+  }
+  auto const cmp = CompareBenchmarks(baseline, candidate);
+  EXPECT_TRUE(cmp.significant);
+  EXPECT_GT(cmp.relative_change, 0.4);
+  EXPECT_GT(cmp.t_statistic, 3.0);
+}
+
+TEST(BenchmarkResult, CompareIgnoresTinyShift) {
+  // A 1% shift is statistically significant on tight distributions, but
+  // below the relative-change floor.
+  BenchmarkResult baseline;
+  BenchmarkResult candidate;
+  for (int i = 0; i != 100; ++i) {
+    baseline.samples.push_back(100.0);
+    candidate.samples.push_back(101.0);
+  }
+  auto const cmp = CompareBenchmarks(baseline, candidate);
+  EXPECT_FALSE(cmp.significant);
+}
+
+TEST(BenchmarkResult, CompareIgnoresNoise) {
+  // Two noisy distributions with the same mean should not be flagged.
+  BenchmarkResult baseline;
+  BenchmarkResult candidate;
+  for (int i = 0; i != 100; ++i) {
+    baseline.samples.push_back(100.0 + 50.0 * ((i % 7) - 3));
+    candidate.samples.push_back(100.0 + 50.0 * ((i % 5) - 2));
+  }
+  auto const cmp = CompareBenchmarks(baseline, candidate);
+  EXPECT_FALSE(cmp.significant);
+}
+
+TEST(BenchmarkResult, EnvironmentHasBuildInfo) {
+  auto const environment = BenchmarkEnvironment();
+  EXPECT_EQ(1, environment.count("version"));
+  EXPECT_EQ(1, environment.count("compiler"));
+  EXPECT_EQ(1, environment.count("compiler-flags"));
+}
+
+}  // namespace
+}  // namespace testing_util
+}  // namespace cloud
+}  // namespace google
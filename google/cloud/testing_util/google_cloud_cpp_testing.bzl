@@ -18,6 +18,7 @@
 
 google_cloud_cpp_testing_hdrs = [
     "assert_ok.h",
+    "benchmark_result.h",
     "capture_log_lines_backend.h",
     "check_predicate_becomes_false.h",
     "chrono_literals.h",
@@ -33,6 +34,7 @@ google_cloud_cpp_testing_hdrs = [
 
 google_cloud_cpp_testing_srcs = [
     "assert_ok.cc",
+    "benchmark_result.cc",
     "capture_log_lines_backend.cc",
     "crash_handler.cc",
     "example_driver.cc",